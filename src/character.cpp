@@ -22,7 +22,7 @@ static void characterGenerateStats() {
     } while (total <= 42 || total >= 54);
 
     for (auto i = 0; i < 6; i++) {
-        py.stats.max[i] = uint8_t(5 + dice[3 * i] + dice[3 * i + 1] + dice[3 * i + 2]);
+        session->py.stats.max[i] = uint8_t(5 + dice[3 * i] + dice[3 * i + 1] + dice[3 * i + 2]);
     }
 }
 
@@ -74,36 +74,36 @@ static uint8_t createModifyPlayerStat(uint8_t const stat, int16_t const adjustme
 // generate all stats and modify for race. needed in a separate
 // module so looping of character selection would be allowed -RGM-
 static void characterGenerateStatsAndRace() {
-    Race_t const &race = character_races[py.misc.race_id];
+    Race_t const &race = character_races[session->py.misc.race_id];
 
     characterGenerateStats();
-    py.stats.max[PlayerAttr::A_STR] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_STR], race.str_adjustment);
-    py.stats.max[PlayerAttr::A_INT] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_INT], race.int_adjustment);
-    py.stats.max[PlayerAttr::A_WIS] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_WIS], race.wis_adjustment);
-    py.stats.max[PlayerAttr::A_DEX] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_DEX], race.dex_adjustment);
-    py.stats.max[PlayerAttr::A_CON] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_CON], race.con_adjustment);
-    py.stats.max[PlayerAttr::A_CHR] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_CHR], race.chr_adjustment);
+    session->py.stats.max[PlayerAttr::A_STR] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_STR], race.str_adjustment);
+    session->py.stats.max[PlayerAttr::A_INT] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_INT], race.int_adjustment);
+    session->py.stats.max[PlayerAttr::A_WIS] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_WIS], race.wis_adjustment);
+    session->py.stats.max[PlayerAttr::A_DEX] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_DEX], race.dex_adjustment);
+    session->py.stats.max[PlayerAttr::A_CON] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_CON], race.con_adjustment);
+    session->py.stats.max[PlayerAttr::A_CHR] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_CHR], race.chr_adjustment);
 
-    py.misc.level = 1;
+    session->py.misc.level = 1;
 
     for (auto i = 0; i < 6; i++) {
-        py.stats.current[i] = py.stats.max[i];
+        session->py.stats.current[i] = session->py.stats.max[i];
         playerSetAndUseStat(i);
     }
 
-    py.misc.chance_in_search = race.search_chance_base;
-    py.misc.bth = race.base_to_hit;
-    py.misc.bth_with_bows = race.base_to_hit_bows;
-    py.misc.fos = race.fos;
-    py.misc.stealth_factor = race.stealth;
-    py.misc.saving_throw = race.saving_throw_base;
-    py.misc.hit_die = race.hit_points_base;
-    py.misc.plusses_to_damage = playerDamageAdjustment();
-    py.misc.plusses_to_hit = playerToHitAdjustment();
-    py.misc.magical_ac = 0;
-    py.misc.ac = playerArmorClassAdjustment();
-    py.misc.experience_factor = race.exp_factor_base;
-    py.flags.see_infra = race.infra_vision;
+    session->py.misc.chance_in_search = race.search_chance_base;
+    session->py.misc.bth = race.base_to_hit;
+    session->py.misc.bth_with_bows = race.base_to_hit_bows;
+    session->py.misc.fos = race.fos;
+    session->py.misc.stealth_factor = race.stealth;
+    session->py.misc.saving_throw = race.saving_throw_base;
+    session->py.misc.hit_die = race.hit_points_base;
+    session->py.misc.plusses_to_damage = playerDamageAdjustment();
+    session->py.misc.plusses_to_hit = playerToHitAdjustment();
+    session->py.misc.magical_ac = 0;
+    session->py.misc.ac = playerArmorClassAdjustment();
+    session->py.misc.experience_factor = race.exp_factor_base;
+    session->py.flags.see_infra = race.infra_vision;
 }
 
 // Prints a list of the available races: Human, Elf, etc.,
@@ -146,7 +146,7 @@ static void characterChooseRace() {
             terminalBellSound();
         }
     }
-    py.misc.race_id = (uint8_t) id;
+    session->py.misc.race_id = (uint8_t) id;
 
     putString(character_races[id].name, Coord_t{3, 15});
 }
@@ -156,13 +156,13 @@ static void displayCharacterHistory() {
     putString("Character Background", Coord_t{14, 27});
 
     for (int i = 0; i < 4; i++) {
-        putStringClearToEOL(py.misc.history[i], Coord_t{i + 15, 10});
+        putStringClearToEOL(session->py.misc.history[i], Coord_t{i + 15, 10});
     }
 }
 
 // Clear the previous history strings
 static void playerClearHistory() {
-    for (auto &entry : py.misc.history) {
+    for (auto &entry : session->py.misc.history) {
         entry[0] = '\0';
     }
 }
@@ -173,7 +173,7 @@ static void playerClearHistory() {
 //   - Each race has init history beginning at (race-1)*3+1
 //   - All history parts are in ascending order
 static void characterGetHistory() {
-    auto history_id = py.misc.race_id * 3 + 1;
+    auto history_id = session->py.misc.race_id * 3 + 1;
     auto social_class = randomNumber(4);
 
     char history_block[240];
@@ -246,8 +246,8 @@ static void characterGetHistory() {
             flag = true;
         }
 
-        (void) strncpy(py.misc.history[line_number], &history_block[cursor_start], (size_t) current_cursor_position);
-        py.misc.history[line_number][current_cursor_position] = '\0';
+        (void) strncpy(session->py.misc.history[line_number], &history_block[cursor_start], (size_t) current_cursor_position);
+        session->py.misc.history[line_number][current_cursor_position] = '\0';
 
         line_number++;
         cursor_start = new_cursor_start;
@@ -260,7 +260,7 @@ static void characterGetHistory() {
         social_class = 1;
     }
 
-    py.misc.social_class = (int16_t) social_class;
+    session->py.misc.social_class = (int16_t) social_class;
 }
 
 // Gets the character's gender -JWT-
@@ -291,9 +291,9 @@ static void characterSetGender() {
 
 // Computes character's age, height, and weight -JWT-
 static void characterSetAgeHeightWeight() {
-    Race_t const &race = character_races[py.misc.race_id];
+    Race_t const &race = character_races[session->py.misc.race_id];
 
-    py.misc.age = uint16_t(race.base_age + randomNumber(race.max_age));
+    session->py.misc.age = uint16_t(race.base_age + randomNumber(race.max_age));
 
     int height_base, height_mod, weight_base, weight_mod;
     if (playerIsMale()) {
@@ -308,9 +308,9 @@ static void characterSetAgeHeightWeight() {
         weight_mod = race.female_weight_mod;
     }
 
-    py.misc.height = (uint16_t) randomNumberNormalDistribution(height_base, height_mod);
-    py.misc.weight = (uint16_t) randomNumberNormalDistribution(weight_base, weight_mod);
-    py.misc.disarm = race.disarm_chance_base + playerDisarmAdjustment();
+    session->py.misc.height = (uint16_t) randomNumberNormalDistribution(height_base, height_mod);
+    session->py.misc.weight = (uint16_t) randomNumberNormalDistribution(weight_base, weight_mod);
+    session->py.misc.disarm = race.disarm_chance_base + playerDisarmAdjustment();
 }
 
 // Prints the classes for a given race: Rogue, Mage, Priest, etc.,
@@ -346,66 +346,66 @@ static int displayRaceClasses(uint8_t const race_id, uint8_t *class_list) {
 }
 
 static void generateCharacterClass(uint8_t const class_id) {
-    py.misc.class_id = class_id;
+    session->py.misc.class_id = class_id;
 
-    Class_t const &klass = classes[py.misc.class_id];
+    Class_t const &klass = classes[session->py.misc.class_id];
 
     clearToBottom(20);
     putString(klass.title, Coord_t{5, 15});
 
     // Adjust the stats for the class adjustment -RAK-
-    py.stats.max[PlayerAttr::A_STR] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_STR], klass.strength);
-    py.stats.max[PlayerAttr::A_INT] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_INT], klass.intelligence);
-    py.stats.max[PlayerAttr::A_WIS] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_WIS], klass.wisdom);
-    py.stats.max[PlayerAttr::A_DEX] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_DEX], klass.dexterity);
-    py.stats.max[PlayerAttr::A_CON] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_CON], klass.constitution);
-    py.stats.max[PlayerAttr::A_CHR] = createModifyPlayerStat(py.stats.max[PlayerAttr::A_CHR], klass.charisma);
+    session->py.stats.max[PlayerAttr::A_STR] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_STR], klass.strength);
+    session->py.stats.max[PlayerAttr::A_INT] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_INT], klass.intelligence);
+    session->py.stats.max[PlayerAttr::A_WIS] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_WIS], klass.wisdom);
+    session->py.stats.max[PlayerAttr::A_DEX] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_DEX], klass.dexterity);
+    session->py.stats.max[PlayerAttr::A_CON] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_CON], klass.constitution);
+    session->py.stats.max[PlayerAttr::A_CHR] = createModifyPlayerStat(session->py.stats.max[PlayerAttr::A_CHR], klass.charisma);
 
     for (auto i = 0; i < 6; i++) {
-        py.stats.current[i] = py.stats.max[i];
+        session->py.stats.current[i] = session->py.stats.max[i];
         playerSetAndUseStat(i);
     }
 
     // Real values
-    py.misc.plusses_to_damage = playerDamageAdjustment();
-    py.misc.plusses_to_hit = playerToHitAdjustment();
-    py.misc.magical_ac = playerArmorClassAdjustment();
-    py.misc.ac = 0;
+    session->py.misc.plusses_to_damage = playerDamageAdjustment();
+    session->py.misc.plusses_to_hit = playerToHitAdjustment();
+    session->py.misc.magical_ac = playerArmorClassAdjustment();
+    session->py.misc.ac = 0;
 
     // Displayed values
-    py.misc.display_to_damage = py.misc.plusses_to_damage;
-    py.misc.display_to_hit = py.misc.plusses_to_hit;
-    py.misc.display_to_ac = py.misc.magical_ac;
-    py.misc.display_ac = py.misc.ac + py.misc.display_to_ac;
+    session->py.misc.display_to_damage = session->py.misc.plusses_to_damage;
+    session->py.misc.display_to_hit = session->py.misc.plusses_to_hit;
+    session->py.misc.display_to_ac = session->py.misc.magical_ac;
+    session->py.misc.display_ac = session->py.misc.ac + session->py.misc.display_to_ac;
 
     // now set misc stats, do this after setting stats because of playerStatAdjustmentConstitution() for hit-points
-    py.misc.hit_die += klass.hit_points;
-    py.misc.max_hp = (int16_t) (playerStatAdjustmentConstitution() + py.misc.hit_die);
-    py.misc.current_hp = py.misc.max_hp;
-    py.misc.current_hp_fraction = 0;
+    session->py.misc.hit_die += klass.hit_points;
+    session->py.misc.max_hp = (int16_t) (playerStatAdjustmentConstitution() + session->py.misc.hit_die);
+    session->py.misc.current_hp = session->py.misc.max_hp;
+    session->py.misc.current_hp_fraction = 0;
 
     // Initialize hit_points array.
     // Put bounds on total possible hp, only succeed
     // if it is within 1/8 of average value.
-    auto min_value = (PLAYER_MAX_LEVEL * 3 / 8 * (py.misc.hit_die - 1)) + PLAYER_MAX_LEVEL;
-    auto max_value = (PLAYER_MAX_LEVEL * 5 / 8 * (py.misc.hit_die - 1)) + PLAYER_MAX_LEVEL;
-    py.base_hp_levels[0] = py.misc.hit_die;
+    auto min_value = (PLAYER_MAX_LEVEL * 3 / 8 * (session->py.misc.hit_die - 1)) + PLAYER_MAX_LEVEL;
+    auto max_value = (PLAYER_MAX_LEVEL * 5 / 8 * (session->py.misc.hit_die - 1)) + PLAYER_MAX_LEVEL;
+    session->py.base_hp_levels[0] = session->py.misc.hit_die;
 
     do {
         for (auto i = 1; i < PLAYER_MAX_LEVEL; i++) {
-            py.base_hp_levels[i] = (uint16_t) randomNumber(py.misc.hit_die);
-            py.base_hp_levels[i] += py.base_hp_levels[i - 1];
+            session->py.base_hp_levels[i] = (uint16_t) randomNumber(session->py.misc.hit_die);
+            session->py.base_hp_levels[i] += session->py.base_hp_levels[i - 1];
         }
-    } while (py.base_hp_levels[PLAYER_MAX_LEVEL - 1] < min_value || py.base_hp_levels[PLAYER_MAX_LEVEL - 1] > max_value);
-
-    py.misc.bth += klass.base_to_hit;
-    py.misc.bth_with_bows += klass.base_to_hit_with_bows; // RAK
-    py.misc.chance_in_search += klass.searching;
-    py.misc.disarm += klass.disarm_traps;
-    py.misc.fos += klass.fos;
-    py.misc.stealth_factor += klass.stealth;
-    py.misc.saving_throw += klass.saving_throw;
-    py.misc.experience_factor += klass.experience_factor;
+    } while (session->py.base_hp_levels[PLAYER_MAX_LEVEL - 1] < min_value || session->py.base_hp_levels[PLAYER_MAX_LEVEL - 1] > max_value);
+
+    session->py.misc.bth += klass.base_to_hit;
+    session->py.misc.bth_with_bows += klass.base_to_hit_with_bows; // RAK
+    session->py.misc.chance_in_search += klass.searching;
+    session->py.misc.disarm += klass.disarm_traps;
+    session->py.misc.fos += klass.fos;
+    session->py.misc.stealth_factor += klass.stealth;
+    session->py.misc.saving_throw += klass.saving_throw;
+    session->py.misc.experience_factor += klass.experience_factor;
 }
 
 // Gets a character class -JWT-
@@ -414,10 +414,10 @@ static void characterGetClass() {
     for (auto &entry : class_list) {
         entry = 0;
     }
-    auto class_count = displayRaceClasses(py.misc.race_id, class_list);
+    auto class_count = displayRaceClasses(session->py.misc.race_id, class_list);
 
     // Reset the class ID
-    py.misc.class_id = 0;
+    session->py.misc.class_id = 0;
 
     while (true) {
         moveCursor(Coord_t{20, 31});
@@ -442,20 +442,20 @@ static int monetaryValueCalculatedFromStat(uint8_t const stat) {
 }
 
 static void playerCalculateStartGold() {
-    auto value = monetaryValueCalculatedFromStat(py.stats.max[PlayerAttr::A_STR]);
-    value += monetaryValueCalculatedFromStat(py.stats.max[PlayerAttr::A_INT]);
-    value += monetaryValueCalculatedFromStat(py.stats.max[PlayerAttr::A_WIS]);
-    value += monetaryValueCalculatedFromStat(py.stats.max[PlayerAttr::A_CON]);
-    value += monetaryValueCalculatedFromStat(py.stats.max[PlayerAttr::A_DEX]);
+    auto value = monetaryValueCalculatedFromStat(session->py.stats.max[PlayerAttr::A_STR]);
+    value += monetaryValueCalculatedFromStat(session->py.stats.max[PlayerAttr::A_INT]);
+    value += monetaryValueCalculatedFromStat(session->py.stats.max[PlayerAttr::A_WIS]);
+    value += monetaryValueCalculatedFromStat(session->py.stats.max[PlayerAttr::A_CON]);
+    value += monetaryValueCalculatedFromStat(session->py.stats.max[PlayerAttr::A_DEX]);
 
     // Social Class adjustment
-    auto new_gold = py.misc.social_class * 6 + randomNumber(25) + 325;
+    auto new_gold = session->py.misc.social_class * 6 + randomNumber(25) + 325;
 
     // Stat adjustment
     new_gold -= value;
 
     // Charisma adjustment
-    new_gold += monetaryValueCalculatedFromStat(py.stats.max[PlayerAttr::A_CHR]);
+    new_gold += monetaryValueCalculatedFromStat(session->py.stats.max[PlayerAttr::A_CHR]);
 
     // She charmed the banker into it! -CJS-
     if (!playerIsMale()) {
@@ -467,7 +467,7 @@ static void playerCalculateStartGold() {
         new_gold = 80;
     }
 
-    py.misc.au = new_gold;
+    session->py.misc.au = new_gold;
 }
 
 // Main Character Creation Routine -JWT-
@@ -21,24 +21,8 @@ namespace config {
         const std::string death_tomb = "data/death_tomb.txt";
         const std::string death_royal = "data/death_royal.txt";
         const std::string scores = "scores.dat";
-        std::string save_game = "game.sav";
     } // namespace files
 
-    // Game options as set on startup and with `=` set options command -CJS-
-    namespace options {
-        bool display_counts = true;          // Display rest/repeat counts
-        bool find_bound = false;             // Print yourself on a run (slower)
-        bool run_cut_corners = true;         // Cut corners while running
-        bool run_examine_corners = true;     // Check corners while running
-        bool run_ignore_doors = false;       // Run through open doors
-        bool run_print_self = false;         // Stop running when the map shifts
-        bool highlight_seams = false;        // Highlight magma and quartz veins
-        bool prompt_to_pickup = false;       // Prompt to pick something up
-        bool use_roguelike_keys = false;     // Use classic Roguelike keys
-        bool show_inventory_weights = false; // Display weights in inventory
-        bool error_beep_sound = true;        // Beep for invalid characters
-    } // namespace options
-
     // Dungeon generation values
     // Note: The entire design of dungeon can be changed by only slight adjustments here.
     namespace dungeon {
@@ -162,7 +146,6 @@ namespace config {
         const uint8_t MON_MIN_PER_LEVEL = 14;             // Minimum number of monsters/level
         const uint8_t MON_MIN_TOWNSFOLK_DAY = 4;          // Number of people on town level (day)
         const uint8_t MON_MIN_TOWNSFOLK_NIGHT = 8;        // Number of people on town level (night)
-        const uint8_t MON_ENDGAME_MONSTERS = 2;           // Total number of "win" creatures
         const uint8_t MON_ENDGAME_LEVEL = 50;             // Level where winning creatures begin
         const uint8_t MON_SUMMONED_LEVEL_ADJUST = 2;      // Adjust level of summoned creatures
         const uint8_t MON_PLAYER_EXP_DRAINED_PER_HIT = 2; // Percent of player exp drained per hit
@@ -20,21 +20,6 @@ namespace config {
         extern const std::string death_tomb;
         extern const std::string death_royal;
         extern const std::string scores;
-        extern std::string save_game;
-    }
-
-    namespace options {
-        extern bool display_counts;
-        extern bool find_bound;
-        extern bool run_cut_corners;
-        extern bool run_examine_corners;
-        extern bool run_ignore_doors;
-        extern bool run_print_self;
-        extern bool highlight_seams;
-        extern bool prompt_to_pickup;
-        extern bool use_roguelike_keys;
-        extern bool show_inventory_weights;
-        extern bool error_beep_sound;
     }
 
     namespace dungeon {
@@ -152,7 +137,7 @@ namespace config {
         extern const uint8_t MON_MIN_PER_LEVEL;
         extern const uint8_t MON_MIN_TOWNSFOLK_DAY;
         extern const uint8_t MON_MIN_TOWNSFOLK_NIGHT;
-        extern const uint8_t MON_ENDGAME_MONSTERS;
+        constexpr uint8_t MON_ENDGAME_MONSTERS = 2; // Total number of "win" creatures, needed when compiling monster_levels[]
         extern const uint8_t MON_ENDGAME_LEVEL;
         extern const uint8_t MON_SUMMONED_LEVEL_ADJUST;
         extern const uint8_t MON_PLAYER_EXP_DRAINED_PER_HIT;
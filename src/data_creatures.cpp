@@ -142,7 +142,7 @@
 //  Area of affect (area_affect_radius) :  Max range that creature is able to
 //                          "notice" the player.
 
-Creature_t creatures_list[MON_MAX_CREATURES] = {
+extern constexpr Creature_t creatures_list[MON_MAX_CREATURES] = {
     {"Filthy Street Urchin",      0x0012000AL, 0x00000000L, 0x2034,     0,  40,  4,   1, 11, 'p', {  1,  4}, { 72, 148,   0,   0},   0},
     {"Blubbering Idiot",          0x0012000AL, 0x00000000L, 0x2030,     0,   0,  6,   1, 11, 'p', {  1,  2}, { 79,   0,   0,   0},   0},
     {"Pitiful-Looking Beggar",    0x0012000AL, 0x00000000L, 0x2030,     0,  40, 10,   1, 11, 'p', {  1,  4}, { 72,   0,   0,   0},   0},
@@ -433,6 +433,131 @@ Creature_t creatures_list[MON_MAX_CREATURES] = {
     {"Balrog",                    0xFF1F0002L, 0x0081C743L, 0x5004, 55000L,  0, 40, 125, 13, 'B', { 75, 40}, {104,  78, 214,   0}, 100},
 };
 
+static constexpr CreatureTraitsTable_t creatureTraitsTable() {
+    CreatureTraitsTable_t table{};
+
+    for (int i = 0; i < MON_MAX_CREATURES; i++) {
+        Creature_t const &creature = creatures_list[i];
+        CreatureTraits_t &traits = table.list[i];
+
+        traits.movement = creature.movement;
+        traits.spells = creature.spells;
+        traits.defenses = creature.defenses;
+        traits.speed = creature.speed;
+        traits.level = creature.level;
+        traits.sleep_counter = creature.sleep_counter;
+        traits.area_affect_radius = creature.area_affect_radius;
+    }
+
+    return table;
+}
+
+extern constexpr CreatureTraitsTable_t creature_traits = creatureTraitsTable();
+
+// The number of creatures up to each level, not counting the winning
+// creatures at the end, for picking monsters by level.
+typedef struct {
+    int16_t levels[MON_MAX_LEVELS + 1];
+} MonsterLevelsTable_t;
+
+static constexpr MonsterLevelsTable_t monsterLevelsTable() {
+    MonsterLevelsTable_t table{};
+
+    for (int i = 0; i < MON_MAX_CREATURES - config::monsters::MON_ENDGAME_MONSTERS; i++) {
+        table.levels[creatures_list[i].level]++;
+    }
+
+    for (int i = 1; i <= MON_MAX_LEVELS; i++) {
+        table.levels[i] += table.levels[i - 1];
+    }
+
+    return table;
+}
+
+static constexpr MonsterLevelsTable_t monster_levels_table = monsterLevelsTable();
+int16_t const (&monster_levels)[MON_MAX_LEVELS + 1] = monster_levels_table.levels;
+
+typedef struct {
+    MonsterLevelSampler_t list[MON_MAX_LEVELS + 1];
+} MonsterLevelSamplersTable_t;
+
+// Builds the alias table for the monster levels at one dungeon depth, using
+// integer weights so the distribution is exactly that of the original code.
+static constexpr void monsterBuildLevelSampler(MonsterLevelSampler_t &sampler, int depth) {
+    int16_t const *levels = monster_levels_table.levels;
+    int num = levels[depth] - levels[0];
+
+    // The original picks the highest of two random monsters, i.e. index
+    // `k` with a chance of (2k + 1) / (num * num), and then uses its level.
+    int32_t weights[MON_MAX_LEVELS] = {0};
+    for (int k = 0; k < num; k++) {
+        weights[creatures_list[k + levels[0]].level - 1] += 2 * k + 1;
+    }
+
+    int count = depth;
+    int32_t column_weight = num * num;
+
+    int small[MON_MAX_LEVELS] = {0};
+    int large[MON_MAX_LEVELS] = {0};
+    int small_count = 0;
+    int large_count = 0;
+
+    for (int i = 0; i < count; i++) {
+        weights[i] *= count;
+
+        if (weights[i] < column_weight) {
+            small[small_count++] = i;
+        } else {
+            large[large_count++] = i;
+        }
+    }
+
+    while (small_count > 0 && large_count > 0) {
+        int lesser = small[--small_count];
+        int greater = large[--large_count];
+
+        sampler.threshold[lesser] = weights[lesser];
+        sampler.alias[lesser] = (uint8_t) greater;
+
+        weights[greater] -= column_weight - weights[lesser];
+
+        if (weights[greater] < column_weight) {
+            small[small_count++] = greater;
+        } else {
+            large[large_count++] = greater;
+        }
+    }
+
+    // Whatever is left fills its column entirely
+    while (large_count > 0) {
+        int id = large[--large_count];
+        sampler.threshold[id] = column_weight;
+        sampler.alias[id] = (uint8_t) id;
+    }
+    while (small_count > 0) {
+        int id = small[--small_count];
+        sampler.threshold[id] = column_weight;
+        sampler.alias[id] = (uint8_t) id;
+    }
+
+    sampler.count = count;
+    sampler.column_weight = column_weight;
+}
+
+// The monster level sampling tables for every dungeon depth
+static constexpr MonsterLevelSamplersTable_t monsterLevelSamplersTable() {
+    MonsterLevelSamplersTable_t table{};
+
+    for (int depth = 1; depth <= MON_MAX_LEVELS; depth++) {
+        monsterBuildLevelSampler(table.list[depth], depth);
+    }
+
+    return table;
+}
+
+static constexpr MonsterLevelSamplersTable_t monster_level_samplers_table = monsterLevelSamplersTable();
+MonsterLevelSampler_t const (&monster_level_samplers)[MON_MAX_LEVELS + 1] = monster_level_samplers_table.list;
+
 // ERROR: attack #35 is no longer used
 MonsterAttack_t monster_attacks[MON_ATTACK_TYPES] = {
     // 0
@@ -9,7 +9,7 @@
 #include "headers.h"
 
 // Following are arrays for descriptive pieces
-const char *colors[MAX_COLORS] = {
+const char *const colors[MAX_COLORS] = {
     // Do not move the first three
     "Icky Green",  "Light Brown",  "Clear",
     "Azure", "Blue", "Blue Speckled", "Black", "Brown", "Brown Speckled", "Bubbling",
@@ -22,27 +22,27 @@ const char *colors[MAX_COLORS] = {
     "Tangerine", "Violet", "Vermilion", "White", "Yellow",
 };
 
-const char *mushrooms[MAX_MUSHROOMS] = {
+const char *const mushrooms[MAX_MUSHROOMS] = {
     "Blue", "Black", "Black Spotted", "Brown", "Dark Blue", "Dark Green", "Dark Red",
     "Ecru", "Furry", "Green", "Grey", "Light Blue", "Light Green", "Plaid", "Red",
     "Slimy", "Tan", "White", "White Spotted", "Wooden", "Wrinkled", "Yellow",
 };
 
-const char *woods[MAX_WOODS] = {
+const char *const woods[MAX_WOODS] = {
     "Aspen", "Balsa", "Banyan", "Birch", "Cedar", "Cottonwood", "Cypress", "Dogwood",
     "Elm", "Eucalyptus", "Hemlock", "Hickory", "Ironwood", "Locust", "Mahogany",
     "Maple", "Mulberry", "Oak", "Pine", "Redwood", "Rosewood", "Spruce", "Sycamore",
     "Teak", "Walnut",
 };
 
-const char *metals[MAX_METALS] = {
+const char *const metals[MAX_METALS] = {
     "Aluminum", "Cast Iron", "Chromium", "Copper", "Gold", "Iron", "Magnesium",
     "Molybdenum", "Nickel", "Rusty", "Silver", "Steel", "Tin", "Titanium", "Tungsten",
     "Zirconium", "Zinc", "Aluminum-Plated", "Copper-Plated", "Gold-Plated",
     "Nickel-Plated", "Silver-Plated", "Steel-Plated", "Tin-Plated", "Zinc-Plated",
 };
 
-const char *rocks[MAX_ROCKS] = {
+const char *const rocks[MAX_ROCKS] = {
     "Alexandrite", "Amethyst", "Aquamarine", "Azurite", "Beryl", "Bloodstone",
     "Calcite", "Carnelian", "Corundum", "Diamond", "Emerald", "Fluorite", "Garnet",
     "Granite", "Jade", "Jasper", "Lapis Lazuli", "Malachite", "Marble", "Moonstone",
@@ -50,7 +50,7 @@ const char *rocks[MAX_ROCKS] = {
     "Tiger Eye", "Topaz", "Turquoise", "Zircon",
 };
 
-const char *amulets[MAX_AMULETS] = {
+const char *const amulets[MAX_AMULETS] = {
     "Amber", "Driftwood", "Coral", "Agate", "Ivory", "Obsidian",
     "Bone", "Brass", "Bronze", "Pewter", "Tortoise Shell",
 };
@@ -90,7 +90,7 @@ uint8_t blows_table[7][6] = {
 // this table is used to generate a pseudo-normal distribution.  See
 // the function randomNumberNormalDistribution() in misc1.c, this is much faster than calling
 // transcendental function to calculate a true normal distribution.
-uint16_t normal_table[NORMAL_TABLE_SIZE] = {
+constexpr uint16_t normal_table[NORMAL_TABLE_SIZE] = {
     206,     613,    1022,    1430,    1838,    2245,    2652,    3058,
     3463,    3867,    4271,    4673,    5075,    5475,    5874,    6271,
     6667,    7061,    7454,    7845,    8234,    8621,    9006,    9389,
@@ -124,3 +124,53 @@ uint16_t normal_table[NORMAL_TABLE_SIZE] = {
     32763,   32763,   32763,   32764,   32764,   32764,   32764,   32765,
     32765,   32765,   32765,   32766,   32766,   32766,   32766,   32766,
 };
+
+// Index into normal_table[] for every value of randomNumber(SHRT_MAX),
+// except the off scale SHRT_MAX itself, so a draw costs a single lookup.
+typedef struct {
+    uint8_t list[SHRT_MAX];
+} NormalTableLookup_t;
+
+// Binary search normal_table[] to get the index that matches `value`,
+// this takes up to 8 iterations. The lookup table is built from this
+// search, so it gives the same index - including for runs of duplicate
+// values in normal_table[], where it may not return the first of them.
+static constexpr int normalTableSearch(int value) {
+    int low = 0;
+    int iindex = NORMAL_TABLE_SIZE >> 1;
+    int high = NORMAL_TABLE_SIZE;
+
+    while (true) {
+        if (normal_table[iindex] == value || high == low + 1) {
+            break;
+        }
+
+        if (normal_table[iindex] > value) {
+            high = iindex;
+            iindex = low + ((iindex - low) >> 1);
+        } else {
+            low = iindex;
+            iindex = iindex + ((high - iindex) >> 1);
+        }
+    }
+
+    // might end up one below target, check that here
+    if (normal_table[iindex] < value) {
+        iindex = iindex + 1;
+    }
+
+    return iindex;
+}
+
+static constexpr NormalTableLookup_t normalTableLookup() {
+    NormalTableLookup_t lookup{};
+
+    for (int value = 1; value < SHRT_MAX; value++) {
+        lookup.list[value] = (uint8_t) normalTableSearch(value);
+    }
+
+    return lookup;
+}
+
+static constexpr NormalTableLookup_t normal_table_lookup_table = normalTableLookup();
+uint8_t const (&normal_table_lookup)[SHRT_MAX] = normal_table_lookup_table.list;
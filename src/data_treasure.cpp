@@ -61,7 +61,7 @@
 // Object list (All objects must be defined here)
 
 // Dungeon items from 0 to MAX_DUNGEON_OBJECTS
-DungeonObject_t game_objects[MAX_OBJECTS_IN_GAME] = {
+static constexpr DungeonObject_t object_list[MAX_OBJECTS_IN_GAME] = {
     {"Poison",                          0x00000001L, TV_FOOD,        ',', 500,  0,    64,  1, 1,    0,  0, 0,   0, {0, 0}, 7}, // 0
     {"Blindness",                       0x00000002L, TV_FOOD,        ',', 500,  0,    65,  1, 1,    0,  0, 0,   0, {0, 0}, 9}, // 1
     {"Paranoia",                        0x00000004L, TV_FOOD,        ',', 500,  0,    66,  1, 1,    0,  0, 0,   0, {0, 0}, 9}, // 2
@@ -521,6 +521,206 @@ DungeonObject_t game_objects[MAX_OBJECTS_IN_GAME] = {
     {"",                              0x00000000L, TV_NOTHING,  ' ', 0, 0, 0, 0,   0, 0, 0, 0, 0, {0, 0}, 0}, // 419
 };
 
+// The tables below are built from the object list when compiling, so
+// nothing is left for startMoria() to do with them at every start.
+
+typedef struct {
+    DungeonObject_t list[MAX_OBJECTS_IN_GAME];
+} GameObjectsTable_t;
+
+// Adjust prices of objects -RAK-
+static constexpr GameObjectsTable_t gameObjectsTable() {
+    GameObjectsTable_t table{};
+
+    for (int i = 0; i < MAX_OBJECTS_IN_GAME; i++) {
+        table.list[i] = object_list[i];
+
+        // round half-way cases up
+        table.list[i].cost = ((object_list[i].cost * COST_ADJUSTMENT) + 50) / 100;
+    }
+
+    return table;
+}
+
+static constexpr GameObjectsTable_t game_objects_table = gameObjectsTable();
+DungeonObject_t const (&game_objects)[MAX_OBJECTS_IN_GAME] = game_objects_table.list;
+
+// The number of dungeon objects up to each level, and the objects sorted
+// by the level they are first found on, for use with PLACE_OBJECT -RAK-
+typedef struct {
+    int16_t levels[TREASURE_MAX_LEVELS + 1];
+    int16_t sorted[MAX_DUNGEON_OBJECTS];
+} TreasureLevelsTable_t;
+
+static constexpr TreasureLevelsTable_t treasureLevelsTable() {
+    TreasureLevelsTable_t table{};
+
+    for (int i = 0; i < MAX_DUNGEON_OBJECTS; i++) {
+        table.levels[object_list[i].depth_first_found]++;
+    }
+
+    for (int i = 1; i <= TREASURE_MAX_LEVELS; i++) {
+        table.levels[i] += table.levels[i - 1];
+    }
+
+    // now produce an array with object indexes sorted by level,
+    // by using the info in levels, this is an O(n) sort!
+    // this is not a stable sort, but that does not matter
+    int indexes[TREASURE_MAX_LEVELS + 1] = {};
+    for (auto &i : indexes) {
+        i = 1;
+    }
+
+    for (int i = 0; i < MAX_DUNGEON_OBJECTS; i++) {
+        int level = object_list[i].depth_first_found;
+        int object_id = table.levels[level] - indexes[level];
+
+        table.sorted[object_id] = (int16_t) i;
+
+        indexes[level]++;
+    }
+
+    return table;
+}
+
+static constexpr TreasureLevelsTable_t treasure_levels_table = treasureLevelsTable();
+int16_t const (&treasure_levels)[TREASURE_MAX_LEVELS + 1] = treasure_levels_table.levels;
+int16_t const (&sorted_objects)[MAX_DUNGEON_OBJECTS] = treasure_levels_table.sorted;
+
+typedef struct {
+    ObjectSampler_t all[TREASURE_MAX_LEVELS + 1];
+    ObjectSampler_t small[TREASURE_MAX_LEVELS + 1];
+} ObjectSamplersTable_t;
+
+// Item too large to fit in chest? -DJG-
+// Use a DungeonObject_t since the item has not yet been created
+static constexpr bool itemBiggerThanChest(DungeonObject_t const &obj) {
+    switch (obj.category_id) {
+        case TV_CHEST:
+        case TV_BOW:
+        case TV_POLEARM:
+        case TV_HARD_ARMOR:
+        case TV_SOFT_ARMOR:
+        case TV_STAFF:
+            return true;
+        case TV_HAFTED:
+        case TV_SWORD:
+        case TV_DIGGING:
+            return (obj.weight > 150);
+        default:
+            return false;
+    }
+}
+
+// Chance of each sorted object at a given level, as chosen by the
+// original -RAK- code: half the time uniformly from all objects up to the
+// level, otherwise the highest of three such objects decides on the level
+// the object is then uniformly taken from.
+static constexpr void itemObjectLevelChances(int level, double *chances) {
+    int16_t const *levels = treasure_levels_table.levels;
+    int16_t const *sorted = treasure_levels_table.sorted;
+
+    int num = levels[level];
+    double cubed = (double) num * num * num;
+
+    for (int i = 0; i < num; i++) {
+        chances[i] = 0.5 / num;
+    }
+
+    for (int k = 0; k < num; k++) {
+        // Chance the highest of three draws is `k`
+        double highest = (3.0 * k * k + 3.0 * k + 1.0) / cubed;
+
+        int found_level = object_list[sorted[k]].depth_first_found;
+        int first = found_level == 0 ? 0 : levels[found_level - 1];
+        int last = levels[found_level];
+
+        for (int i = first; i < last; i++) {
+            chances[i] += 0.5 * highest / (last - first);
+        }
+    }
+}
+
+// Vose's alias method, the chances do not need to be normalized.
+static constexpr void itemBuildObjectSampler(ObjectSampler_t &sampler, double const *chances, int num) {
+    double total = 0;
+    for (int i = 0; i < num; i++) {
+        total += chances[i];
+    }
+
+    double scaled[MAX_DUNGEON_OBJECTS] = {0};
+    int small[MAX_DUNGEON_OBJECTS] = {0};
+    int large[MAX_DUNGEON_OBJECTS] = {0};
+    int small_count = 0;
+    int large_count = 0;
+
+    for (int i = 0; i < num; i++) {
+        scaled[i] = chances[i] * num / total;
+
+        if (scaled[i] < 1.0) {
+            small[small_count++] = i;
+        } else {
+            large[large_count++] = i;
+        }
+    }
+
+    while (small_count > 0 && large_count > 0) {
+        int lesser = small[--small_count];
+        int greater = large[--large_count];
+
+        sampler.threshold[lesser] = (int32_t)(scaled[lesser] * OBJECT_SAMPLER_SCALE);
+        sampler.alias[lesser] = (int16_t) greater;
+
+        scaled[greater] -= 1.0 - scaled[lesser];
+
+        if (scaled[greater] < 1.0) {
+            small[small_count++] = greater;
+        } else {
+            large[large_count++] = greater;
+        }
+    }
+
+    // Whatever is left (only rounding errors) fills its column entirely
+    while (large_count > 0) {
+        int id = large[--large_count];
+        sampler.threshold[id] = OBJECT_SAMPLER_SCALE;
+        sampler.alias[id] = (int16_t) id;
+    }
+    while (small_count > 0) {
+        int id = small[--small_count];
+        sampler.threshold[id] = chances[id] > 0 ? OBJECT_SAMPLER_SCALE : 0;
+        sampler.alias[id] = (int16_t) id;
+    }
+}
+
+// The object sampling tables for every dungeon level
+static constexpr ObjectSamplersTable_t objectSamplersTable() {
+    ObjectSamplersTable_t table{};
+    double chances[MAX_DUNGEON_OBJECTS] = {0};
+
+    for (int level = 1; level <= TREASURE_MAX_LEVELS; level++) {
+        int num = treasure_levels_table.levels[level];
+
+        itemObjectLevelChances(level, chances);
+        itemBuildObjectSampler(table.all[level], chances, num);
+
+        // Objects too big for a chest were rejected and drawn again,
+        // which is the same as never choosing them in the first place.
+        for (int i = 0; i < num; i++) {
+            if (itemBiggerThanChest(object_list[treasure_levels_table.sorted[i]])) {
+                chances[i] = 0;
+            }
+        }
+        itemBuildObjectSampler(table.small[level], chances, num);
+    }
+
+    return table;
+}
+
+static constexpr ObjectSamplersTable_t object_samplers_table = objectSamplersTable();
+ObjectSampler_t const (&object_samplers)[TREASURE_MAX_LEVELS + 1] = object_samplers_table.all;
+ObjectSampler_t const (&small_object_samplers)[TREASURE_MAX_LEVELS + 1] = object_samplers_table.small;
+
 const char *special_item_names[SpecialNameIds::SN_ARRAY_SIZE] = {
     CNIL,                "(R)",              "(RA)",
     "(RF)",              "(RC)",             "(RL)",
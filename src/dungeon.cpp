@@ -7,9 +7,92 @@
 
 #include "headers.h"
 
-// The Dungeon global
-// Yup, this initialization is ugly, we'll fix...eventually! -MRC-
-Dungeon_t dg = Dungeon_t{0, 0, {}, -1, 0, true, {}};
+// Some tile of this block may look different now
+void dungeonOverviewTouch(Coord_t const &coord) {
+    if (coord.y < 0 || coord.y >= MAX_HEIGHT || coord.x < 0 || coord.x >= MAX_WIDTH) {
+        return;
+    }
+
+    session->overview_stale[coord.y / RATIO][coord.x / RATIO] = true;
+
+    // The same goes for the travel map, which is built from what the player sees
+    playerTravelTileChanged(coord);
+}
+
+// Every block must be looked at again, e.g. on a new level
+void dungeonOverviewForget() {
+    session->overview_all_stale = true;
+}
+
+// The symbol with the highest priority stands for the whole block
+static int overviewPriority(char symbol) {
+    switch (symbol) {
+        case '@':
+            return 10;
+        case '<':
+        case '>':
+            return 5;
+        case '\\':
+            return -3;
+        case '#':
+            return -5;
+        case '.':
+            return -10;
+        case ' ':
+            return -15;
+        default:
+            return 0;
+    }
+}
+
+static void overviewUpdateBlock(int row, int col) {
+    char symbol = ' ';
+
+    for (int y = row * RATIO; y < (row + 1) * RATIO; y++) {
+        for (int x = col * RATIO; x < (col + 1) * RATIO; x++) {
+            char cave_char = caveGetTileSymbol(Coord_t{y, x});
+            if (overviewPriority(symbol) < overviewPriority(cave_char)) {
+                symbol = cave_char;
+            }
+        }
+    }
+
+    session->overview.rows[row][col] = symbol;
+}
+
+// The overview map of the level as the player knows it. This is what the
+// map command shows, and is also here for anything else wanting to draw
+// the level small, e.g. an external map viewer.
+Overview_t const &dungeonOverview() {
+    // Blindness hides everything, and seams show differently with the
+    // option set, so a change of either means starting again.
+    int view = ((session->py.flags.status & config::player::status::PY_BLIND) != 0u ? 1 : 0) | (session->options.highlight_seams ? 2 : 0);
+    if (view != session->overview_view) {
+        session->overview_view = view;
+        session->overview_all_stale = true;
+    }
+
+    for (int row = 0; row < OVERVIEW_HEIGHT; row++) {
+        for (int col = 0; col < OVERVIEW_WIDTH; col++) {
+            if (session->overview_all_stale || session->overview_stale[row][col]) {
+                overviewUpdateBlock(row, col);
+                session->overview_stale[row][col] = false;
+            }
+        }
+        session->overview.rows[row][OVERVIEW_WIDTH] = '\0';
+    }
+
+    session->overview_all_stale = false;
+
+    // Hallucinations are never the same twice
+    if (session->py.flags.image > 0) {
+        session->overview_all_stale = true;
+    }
+
+    session->overview.player = Coord_t{session->py.pos.y / RATIO, session->py.pos.x / RATIO};
+
+    return session->overview;
+}
 
 // dungeonDisplayMap shrinks the dungeon to a single screen
 void dungeonDisplayMap() {
@@ -17,20 +100,9 @@ void dungeonDisplayMap() {
     terminalSaveScreen();
     clearScreen();
 
-    int16_t priority[256] = {0};
-    priority[60] = 5;   // char '<'
-    priority[62] = 5;   // char '>'
-    priority[64] = 10;  // char '@'
-    priority[35] = -5;  // char '#'
-    priority[46] = -10; // char '.'
-    priority[92] = -3;  // char '\'
-    priority[32] = -15; // char ' '
-
-    // Display highest priority object in the RATIO, by RATIO area
-    uint8_t panel_width = MAX_WIDTH / RATIO;
-    uint8_t panel_height = MAX_HEIGHT / RATIO;
+    uint8_t panel_width = OVERVIEW_WIDTH;
+    uint8_t panel_height = OVERVIEW_HEIGHT;
 
-    char map[MAX_WIDTH / RATIO + 1] = {'\0'};
     char line_buffer[80];
 
     // Add screen border
@@ -48,45 +120,15 @@ void dungeonDisplayMap() {
     addChar('+', Coord_t{panel_height + 1, panel_width + 1});
     putString("Hit any key to continue", Coord_t{23, 23});
 
-    int player_y = 0;
-    int player_x = 0;
-    int line = -1;
-
-    // Shrink the dungeon!
-    for (uint8_t y = 0; y < MAX_HEIGHT; y++) {
-        uint8_t row = y / RATIO;
-        if (row != line) {
-            if (line >= 0) {
-                sprintf(line_buffer, "|%s|", map);
-                putString(line_buffer, Coord_t{line + 1, 0});
-            }
-            for (uint8_t j = 0; j < panel_width; j++) {
-                map[j] = ' ';
-            }
-            line = row;
-        }
+    Overview_t const &map = dungeonOverview();
 
-        for (uint8_t x = 0; x < MAX_WIDTH; x++) {
-            uint8_t col = x / RATIO;
-            char cave_char = caveGetTileSymbol(Coord_t{y, x});
-            if (priority[(uint8_t) map[col]] < priority[(uint8_t) cave_char]) {
-                map[col] = cave_char;
-            }
-            if (map[col] == '@') {
-                // +1 to account for border
-                player_x = col + 1;
-                player_y = row + 1;
-            }
-        }
-    }
-
-    if (line >= 0) {
-        sprintf(line_buffer, "|%s|", map);
-        putString(line_buffer, Coord_t{line + 1, 0});
+    for (int row = 0; row < OVERVIEW_HEIGHT; row++) {
+        sprintf(line_buffer, "|%s|", map.rows[row]);
+        putString(line_buffer, Coord_t{row + 1, 0});
     }
 
-    // Move cursor onto player character
-    moveCursor(Coord_t{player_y, player_x});
+    // Move cursor onto player character, +1 to account for border
+    moveCursor(Coord_t{map.player.y + 1, map.player.x + 1});
 
     // wait for any keypress
     (void) getKeyInput();
@@ -97,8 +139,8 @@ void dungeonDisplayMap() {
 
 // Checks a co-ordinate for in bounds status -RAK-
 bool coordInBounds(Coord_t const &coord) {
-    bool y = coord.y > 0 && coord.y < dg.height - 1;
-    bool x = coord.x > 0 && coord.x < dg.width - 1;
+    bool y = coord.y > 0 && coord.y < session->dg.height - 1;
+    bool x = coord.x > 0 && coord.x < session->dg.width - 1;
 
     return y && x;
 }
@@ -127,19 +169,19 @@ int coordDistanceBetween(Coord_t const &from, Coord_t const &to) {
 int coordWallsNextTo(Coord_t const &coord) {
     int walls = 0;
 
-    if (dg.floor[coord.y - 1][coord.x].feature_id >= MIN_CAVE_WALL) {
+    if (session->dg.floor[coord.y - 1][coord.x].feature_id >= MIN_CAVE_WALL) {
         walls++;
     }
 
-    if (dg.floor[coord.y + 1][coord.x].feature_id >= MIN_CAVE_WALL) {
+    if (session->dg.floor[coord.y + 1][coord.x].feature_id >= MIN_CAVE_WALL) {
         walls++;
     }
 
-    if (dg.floor[coord.y][coord.x - 1].feature_id >= MIN_CAVE_WALL) {
+    if (session->dg.floor[coord.y][coord.x - 1].feature_id >= MIN_CAVE_WALL) {
         walls++;
     }
 
-    if (dg.floor[coord.y][coord.x + 1].feature_id >= MIN_CAVE_WALL) {
+    if (session->dg.floor[coord.y][coord.x + 1].feature_id >= MIN_CAVE_WALL) {
         walls++;
     }
 
@@ -154,11 +196,11 @@ int coordCorridorWallsNextTo(Coord_t const &coord) {
 
     for (int y = coord.y - 1; y <= coord.y + 1; y++) {
         for (int x = coord.x - 1; x <= coord.x + 1; x++) {
-            int tile_id = dg.floor[y][x].feature_id;
-            int treasure_id = dg.floor[y][x].treasure_id;
+            int tile_id = session->dg.floor[y][x].feature_id;
+            int treasure_id = session->dg.floor[y][x].treasure_id;
 
             // should fail if there is already a door present
-            if (tile_id == TILE_CORR_FLOOR && (treasure_id == 0 || game.treasure.list[treasure_id].category_id < TV_MIN_DOORS)) {
+            if (tile_id == TILE_CORR_FLOOR && (treasure_id == 0 || session->game.treasure.list[treasure_id].category_id < TV_MIN_DOORS)) {
                 walls++;
             }
         }
@@ -169,37 +211,37 @@ int coordCorridorWallsNextTo(Coord_t const &coord) {
 
 // Returns symbol for given row, column -RAK-
 char caveGetTileSymbol(Coord_t const &coord) {
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
-    if (tile.creature_id == 1 && ((py.running_tracker == 0) || config::options::run_print_self)) {
+    if (tile.creature_id == 1 && ((session->py.running_tracker == 0) || session->options.run_print_self)) {
         return '@';
     }
 
-    if ((py.flags.status & config::player::status::PY_BLIND) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_BLIND) != 0u) {
         return ' ';
     }
 
-    if (py.flags.image > 0 && randomNumber(12) == 1) {
+    if (session->py.flags.image > 0 && randomNumber(12) == 1) {
         return (uint8_t)(randomNumber(95) + 31);
     }
 
-    if (tile.creature_id > 1 && monsters[tile.creature_id].lit) {
-        return creatures_list[monsters[tile.creature_id].creature_id].sprite;
+    if (tile.creature_id > 1 && session->monsters[tile.creature_id].lit) {
+        return creatures_list[session->monsters[tile.creature_id].creature_id].sprite;
     }
 
     if (!tile.permanent_light && !tile.temporary_light && !tile.field_mark) {
         return ' ';
     }
 
-    if (tile.treasure_id != 0 && game.treasure.list[tile.treasure_id].category_id != TV_INVIS_TRAP) {
-        return game.treasure.list[tile.treasure_id].sprite;
+    if (tile.treasure_id != 0 && session->game.treasure.list[tile.treasure_id].category_id != TV_INVIS_TRAP) {
+        return session->game.treasure.list[tile.treasure_id].sprite;
     }
 
     if (tile.feature_id <= MAX_CAVE_FLOOR) {
         return '.';
     }
 
-    if (tile.feature_id == TILE_GRANITE_WALL || tile.feature_id == TILE_BOUNDARY_WALL || !config::options::highlight_seams) {
+    if (tile.feature_id == TILE_GRANITE_WALL || tile.feature_id == TILE_BOUNDARY_WALL || !session->options.highlight_seams) {
         return '#';
     }
 
@@ -210,22 +252,22 @@ char caveGetTileSymbol(Coord_t const &coord) {
 
 // Tests a spot for light or field mark status -RAK-
 bool caveTileVisible(Coord_t const &coord) {
-    return dg.floor[coord.y][coord.x].permanent_light || dg.floor[coord.y][coord.x].temporary_light || dg.floor[coord.y][coord.x].field_mark;
+    return session->dg.floor[coord.y][coord.x].permanent_light || session->dg.floor[coord.y][coord.x].temporary_light || session->dg.floor[coord.y][coord.x].field_mark;
 }
 
 // Places a particular trap at location y, x -RAK-
 void dungeonSetTrap(Coord_t const &coord, int sub_type_id) {
     int free_treasure_id = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_TRAP_LIST + sub_type_id, game.treasure.list[free_treasure_id]);
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_TRAP_LIST + sub_type_id, session->game.treasure.list[free_treasure_id]);
 }
 
 // Change a trap from invisible to visible -RAK-
 // Note: Secret doors are handled here
 void trapChangeVisibility(Coord_t const &coord) {
-    uint8_t treasure_id = dg.floor[coord.y][coord.x].treasure_id;
+    uint8_t treasure_id = session->dg.floor[coord.y][coord.x].treasure_id;
 
-    Inventory_t &item = game.treasure.list[treasure_id];
+    Inventory_t &item = session->game.treasure.list[treasure_id];
 
     if (item.category_id == TV_INVIS_TRAP) {
         item.category_id = TV_VIS_TRAP;
@@ -245,30 +287,31 @@ void trapChangeVisibility(Coord_t const &coord) {
 // Places rubble at location y, x -RAK-
 void dungeonPlaceRubble(Coord_t const &coord) {
     int free_treasure_id = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
-    dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_RUBBLE, game.treasure.list[free_treasure_id]);
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
+    session->dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
+    dungeonFloorTileChanged(coord);
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_RUBBLE, session->game.treasure.list[free_treasure_id]);
 }
 
 // Places a treasure (Gold or Gems) at given row, column -RAK-
 void dungeonPlaceGold(Coord_t const &coord) {
     int free_treasure_id = popt();
 
-    int gold_type_id = ((randomNumber(dg.current_level + 2) + 2) / 2) - 1;
+    int gold_type_id = ((randomNumber(session->dg.current_level + 2) + 2) / 2) - 1;
 
     if (randomNumber(config::treasure::TREASURE_CHANCE_OF_GREAT_ITEM) == 1) {
-        gold_type_id += randomNumber(dg.current_level + 1);
+        gold_type_id += randomNumber(session->dg.current_level + 1);
     }
 
     if (gold_type_id >= config::dungeon::objects::MAX_GOLD_TYPES) {
         gold_type_id = config::dungeon::objects::MAX_GOLD_TYPES - 1;
     }
 
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_GOLD_LIST + gold_type_id, game.treasure.list[free_treasure_id]);
-    game.treasure.list[free_treasure_id].cost += (8L * (int32_t) randomNumber((int) game.treasure.list[free_treasure_id].cost)) + randomNumber(8);
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_GOLD_LIST + gold_type_id, session->game.treasure.list[free_treasure_id]);
+    session->game.treasure.list[free_treasure_id].cost += (8L * (int32_t) randomNumber((int) session->game.treasure.list[free_treasure_id].cost)) + randomNumber(8);
 
-    if (dg.floor[coord.y][coord.x].creature_id == 1) {
+    if (session->dg.floor[coord.y][coord.x].creature_id == 1) {
         printMessage("You feel something roll beneath your feet.");
     }
 }
@@ -277,29 +320,185 @@ void dungeonPlaceGold(Coord_t const &coord) {
 void dungeonPlaceRandomObjectAt(Coord_t const &coord, bool must_be_small) {
     int free_treasure_id = popt();
 
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
 
-    int object_id = itemGetRandomObjectId(dg.current_level, must_be_small);
-    inventoryItemCopyTo(sorted_objects[object_id], game.treasure.list[free_treasure_id]);
+    int object_id = itemGetRandomObjectId(session->dg.current_level, must_be_small);
+    inventoryItemCopyTo(sorted_objects[object_id], session->game.treasure.list[free_treasure_id]);
 
-    magicTreasureMagicalAbility(free_treasure_id, dg.current_level);
+    magicTreasureMagicalAbility(free_treasure_id, session->dg.current_level);
 
-    if (dg.floor[coord.y][coord.x].creature_id == 1) {
+    if (session->dg.floor[coord.y][coord.x].creature_id == 1) {
         printMessage("You feel something roll beneath your feet."); // -CJS-
     }
 }
 
+// Which list a tile with this feature belongs to: room floors (0),
+// corridor floors (1), any other floors (2), or none (-1).
+static int floorTileKind(uint8_t feature_id) {
+    switch (feature_id) {
+        case TILE_DARK_FLOOR:
+        case TILE_LIGHT_FLOOR:
+            return 0;
+        case TILE_CORR_FLOOR:
+        case TILE_BLOCKED_FLOOR:
+            return 1;
+        case TILE_NULL_WALL:
+            return 2;
+        default:
+            return -1;
+    }
+}
+
+static void floorTilePut(int id, Coord_t const &coord) {
+    session->floor_tiles[id] = coord;
+    session->floor_tile_ids[coord.y][coord.x] = (int16_t)(id + 1);
+}
+
+static void floorTilesSwap(int a, int b) {
+    Coord_t coord = session->floor_tiles[a];
+    floorTilePut(a, session->floor_tiles[b]);
+    floorTilePut(b, coord);
+}
+
+// Collect the floor tiles of the level, once it has been generated or
+// loaded. From then on dungeonFloorTileChanged() keeps them up to date.
+void dungeonFindFloorTiles() {
+    int *ends[FLOOR_TILE_LISTS] = {&session->floor_rooms_end, &session->floor_corridors_end, &session->floor_tiles_end};
+
+    for (auto &row : session->floor_tile_ids) {
+        for (auto &id : row) {
+            id = 0;
+        }
+    }
+
+    int count = 0;
+
+    for (int kind = 0; kind < FLOOR_TILE_LISTS; kind++) {
+        for (int y = 1; y < session->dg.height - 1; y++) {
+            for (int x = 1; x < session->dg.width - 1; x++) {
+                if (floorTileKind(session->dg.floor[y][x].feature_id) == kind) {
+                    floorTilePut(count++, Coord_t{y, x});
+                }
+            }
+        }
+        *ends[kind] = count;
+    }
+}
+
+// Moves a tile to the list for its feature, after the feature has changed,
+// e.g. by tunnelling or a wall being built. The lists sit one after the
+// other, so a tile passes through the lists between its old and new place
+// by swapping with the first or last tile of each. The corridor graph
+// runs follow is brought up to date too.
+void dungeonFloorTileChanged(Coord_t const &coord) {
+    playerRunTileChanged(coord);
+
+    int *ends[FLOOR_TILE_LISTS] = {&session->floor_rooms_end, &session->floor_corridors_end, &session->floor_tiles_end};
+
+    int kind = floorTileKind(session->dg.floor[coord.y][coord.x].feature_id);
+    int id = session->floor_tile_ids[coord.y][coord.x] - 1;
+
+    int listed = -1;
+    if (id >= 0) {
+        listed = 0;
+        while (id >= *ends[listed]) {
+            listed++;
+        }
+    }
+
+    if (kind == listed) {
+        return;
+    }
+
+    if (listed >= 0) {
+        for (int list = listed; list < FLOOR_TILE_LISTS; list++) {
+            floorTilesSwap(id, *ends[list] - 1);
+            id = --*ends[list];
+        }
+        session->floor_tile_ids[coord.y][coord.x] = 0;
+    }
+
+    if (kind >= 0) {
+        id = (*ends[FLOOR_TILE_LISTS - 1])++;
+        floorTilePut(id, coord);
+
+        for (int list = FLOOR_TILE_LISTS - 1; list > kind; list--) {
+            floorTilesSwap(id, *ends[list - 1]);
+            id = (*ends[list - 1])++;
+        }
+    }
+}
+
+FloorTileSearch_t dungeonSearchFloorTiles(FloorTiles kind) {
+    int const ends[FLOOR_TILE_LISTS] = {session->floor_rooms_end, session->floor_corridors_end, session->floor_tiles_end};
+
+    FloorTileSearch_t search{};
+    int start = 0;
+
+    for (int list = 0; list < FLOOR_TILE_LISTS; list++) {
+        bool wanted = kind == FloorTiles::Any || (kind == FloorTiles::Room && list == 0) || (kind == FloorTiles::Corridor && list == 1);
+
+        search.next[list] = wanted ? start : ends[list];
+        search.end[list] = ends[list];
+        start = ends[list];
+    }
+
+    return search;
+}
+
+// Gets the next random tile of the search, each tile is returned at most
+// once so the first one a caller accepts is a uniform choice among all the
+// acceptable tiles. Returns false once all tiles have been tried.
+bool dungeonNextFloorTile(FloorTileSearch_t &search, Coord_t &coord) {
+    int remaining = 0;
+    for (int list = 0; list < FLOOR_TILE_LISTS; list++) {
+        remaining += search.end[list] - search.next[list];
+    }
+
+    if (remaining == 0) {
+        return false;
+    }
+
+    // A step of a Fisher-Yates shuffle over the lists searched. The tiles
+    // are only ever swapped within their own list, so the lists stay apart.
+    int pick = randomNumber(remaining) - 1;
+
+    int list = 0;
+    while (pick >= search.end[list] - search.next[list]) {
+        pick -= search.end[list] - search.next[list];
+        list++;
+    }
+
+    floorTilesSwap(search.next[list] + pick, search.next[list]);
+    coord = session->floor_tiles[search.next[list]];
+
+    search.next[list]++;
+
+    return true;
+}
+
 // Allocates an object for tunnels and rooms -RAK-
-void dungeonAllocateAndPlaceObject(bool (*set_function)(int), int object_type, int number) {
+void dungeonAllocateAndPlaceObject(FloorTiles kind, int object_type, int number) {
     Coord_t coord = Coord_t{0, 0};
 
     for (int i = 0; i < number; i++) {
+        FloorTileSearch_t search = dungeonSearchFloorTiles(kind);
+
+        bool found = false;
+
         // don't put an object beneath the player, this could cause
         // problems if player is standing under rubble, or on a trap.
-        do {
-            coord.y = randomNumber(dg.height) - 1;
-            coord.x = randomNumber(dg.width) - 1;
-        } while (!(*set_function)(dg.floor[coord.y][coord.x].feature_id) || dg.floor[coord.y][coord.x].treasure_id != 0 || (coord.y == py.pos.y && coord.x == py.pos.x));
+        while (dungeonNextFloorTile(search, coord)) {
+            if (session->dg.floor[coord.y][coord.x].treasure_id == 0 && (coord.y != session->py.pos.y || coord.x != session->py.pos.x)) {
+                found = true;
+                break;
+            }
+        }
+
+        // The level is full, there is nowhere left to put anything
+        if (!found) {
+            return;
+        }
 
         switch (object_type) {
             case 1:
@@ -332,7 +531,7 @@ void dungeonPlaceRandomObjectNear(Coord_t coord, int tries) {
                 coord.x - 4 + randomNumber(7),
             };
 
-            if (coordInBounds(at) && dg.floor[at.y][at.x].feature_id <= MAX_CAVE_FLOOR && dg.floor[at.y][at.x].treasure_id == 0) {
+            if (coordInBounds(at) && session->dg.floor[at.y][at.x].feature_id <= MAX_CAVE_FLOOR && session->dg.floor[at.y][at.x].treasure_id == 0) {
                 if (randomNumber(100) < 75) {
                     dungeonPlaceRandomObjectAt(at, false);
                 } else {
@@ -349,151 +548,128 @@ void dungeonPlaceRandomObjectNear(Coord_t coord, int tries) {
 // Moves creature record from one space to another -RAK-
 // this always works correctly, even if y1==y2 and x1==x2
 void dungeonMoveCreatureRecord(Coord_t const &from, Coord_t const &to) {
-    int id = dg.floor[from.y][from.x].creature_id;
-    dg.floor[from.y][from.x].creature_id = 0;
-    dg.floor[to.y][to.x].creature_id = (uint8_t) id;
+    int id = session->dg.floor[from.y][from.x].creature_id;
+    session->dg.floor[from.y][from.x].creature_id = 0;
+    session->dg.floor[to.y][to.x].creature_id = (uint8_t) id;
 }
 
-// Room is lit, make it appear -RAK-
-void dungeonLightRoom(Coord_t const &coord) {
-    int height_middle = (SCREEN_HEIGHT / 2);
-    int width_middle = (SCREEN_WIDTH / 2);
+// Gives every room tile touching the first the same id, and records
+// the span of them all
+static void dungeonNumberRoom(Coord_t const &start, uint8_t id) {
+    static thread_local int fill[MAX_HEIGHT * MAX_WIDTH];
+    int count = 0;
 
-    int top = (coord.y / height_middle) * height_middle;
-    int left = (coord.x / width_middle) * width_middle;
-    int bottom = top + height_middle - 1;
-    int right = left + width_middle - 1;
+    Room_t &room = session->rooms[id];
+    room.top_left = start;
+    room.bottom_right = start;
 
-    Coord_t location = Coord_t{0, 0};
+    session->room_ids[start.y][start.x] = id;
+    fill[count++] = start.y * MAX_WIDTH + start.x;
 
-    for (location.y = top; location.y <= bottom; location.y++) {
-        for (location.x = left; location.x <= right; location.x++) {
-            Tile_t &tile = dg.floor[location.y][location.x];
+    while (count > 0) {
+        count--;
+        Coord_t coord = Coord_t{fill[count] / MAX_WIDTH, fill[count] % MAX_WIDTH};
 
-            if (tile.perma_lit_room && !tile.permanent_light) {
-                tile.permanent_light = true;
+        room.top_left.y = std::min(room.top_left.y, coord.y);
+        room.top_left.x = std::min(room.top_left.x, coord.x);
+        room.bottom_right.y = std::max(room.bottom_right.y, coord.y);
+        room.bottom_right.x = std::max(room.bottom_right.x, coord.x);
 
-                if (tile.feature_id == TILE_DARK_FLOOR) {
-                    tile.feature_id = TILE_LIGHT_FLOOR;
+        for (int y = coord.y - 1; y <= coord.y + 1; y++) {
+            for (int x = coord.x - 1; x <= coord.x + 1; x++) {
+                if (y < 0 || y >= session->dg.height || x < 0 || x >= session->dg.width) {
+                    continue;
                 }
-                if (!tile.field_mark && tile.treasure_id != 0) {
-                    int treasure_id = game.treasure.list[tile.treasure_id].category_id;
-                    if (treasure_id >= TV_MIN_VISIBLE && treasure_id <= TV_MAX_VISIBLE) {
-                        tile.field_mark = true;
-                    }
+
+                if (session->dg.floor[y][x].perma_lit_room && session->room_ids[y][x] == 0) {
+                    session->room_ids[y][x] = id;
+                    fill[count++] = y * MAX_WIDTH + x;
                 }
-                panelPutTile(caveGetTileSymbol(location), location);
             }
         }
     }
 }
 
-// Lights up given location -RAK-
-void dungeonLiteSpot(Coord_t const &coord) {
-    if (!coordInsidePanel(coord)) {
-        return;
-    }
-
-    char symbol = caveGetTileSymbol(coord);
-    panelPutTile(symbol, coord);
-}
-
-// Normal movement
-// When FIND_FLAG,  light only permanent features
-static void sub1MoveLight(Coord_t const &from, Coord_t const &to) {
-    if (py.temporary_light_only) {
-        // Turn off lamp light
-        for (int y = from.y - 1; y <= from.y + 1; y++) {
-            for (int x = from.x - 1; x <= from.x + 1; x++) {
-                dg.floor[y][x].temporary_light = false;
+// Number the rooms of the level and record the tiles each one spans. A
+// room is a group of touching room tiles, walls included. The room tiles
+// do not change after generation, so this is only needed when a new level
+// is generated or loaded.
+void dungeonFindRooms() {
+    memset((char *) &session->room_ids[0][0], 0, sizeof(session->room_ids));
+    session->rooms_count = 0;
+
+    for (int y = 0; y < session->dg.height; y++) {
+        for (int x = 0; x < session->dg.width; x++) {
+            if (!session->dg.floor[y][x].perma_lit_room || session->room_ids[y][x] != 0 || session->rooms_count == MAX_ROOMS) {
+                continue;
             }
+
+            session->rooms_count++;
+            dungeonNumberRoom(Coord_t{y, x}, (uint8_t) session->rooms_count);
         }
-        if ((py.running_tracker != 0) && !config::options::run_print_self) {
-            py.temporary_light_only = false;
-        }
-    } else if ((py.running_tracker == 0) || config::options::run_print_self) {
-        py.temporary_light_only = true;
     }
+}
 
-    for (int y = to.y - 1; y <= to.y + 1; y++) {
-        for (int x = to.x - 1; x <= to.x + 1; x++) {
-            Tile_t &tile = dg.floor[y][x];
+// Returns the id of the room a tile is in, or 0 when not in a room.
+// An earthquake can take a tile out of its room.
+int dungeonRoomId(Coord_t const &coord) {
+    if (!session->dg.floor[coord.y][coord.x].perma_lit_room) {
+        return 0;
+    }
 
-            // only light up if normal movement
-            if (py.temporary_light_only) {
-                tile.temporary_light = true;
-            }
+    return session->room_ids[coord.y][coord.x];
+}
 
-            if (tile.feature_id >= MIN_CAVE_WALL) {
-                tile.permanent_light = true;
-            } else if (!tile.field_mark && tile.treasure_id != 0) {
-                int tval = game.treasure.list[tile.treasure_id].category_id;
+// Returns the span of the room a tile is in. It is empty (bottom right
+// before top left) when the tile is not in a room.
+Room_t dungeonRoomAt(Coord_t const &coord) {
+    int id = dungeonRoomId(coord);
 
-                if (tval >= TV_MIN_VISIBLE && tval <= TV_MAX_VISIBLE) {
-                    tile.field_mark = true;
-                }
-            }
-        }
+    if (id == 0) {
+        return Room_t{Coord_t{0, 0}, Coord_t{-1, -1}};
     }
 
-    // From uppermost to bottom most lines player was on.
-    int top, left, bottom, right;
+    return session->rooms[id];
+}
 
-    if (from.y < to.y) {
-        top = from.y - 1;
-        bottom = to.y + 1;
-    } else {
-        top = to.y - 1;
-        bottom = from.y + 1;
-    }
-    if (from.x < to.x) {
-        left = from.x - 1;
-        right = to.x + 1;
-    } else {
-        left = to.x - 1;
-        right = from.x + 1;
-    }
+// Room is lit, make it appear -RAK-
+void dungeonLightRoom(Coord_t const &coord) {
+    Room_t room = dungeonRoomAt(coord);
 
-    Coord_t coord = Coord_t{0, 0};
-    for (coord.y = top; coord.y <= bottom; coord.y++) {
-        // Leftmost to rightmost do
-        for (coord.x = left; coord.x <= right; coord.x++) {
-            panelPutTile(caveGetTileSymbol(coord), coord);
-        }
-    }
-}
+    Coord_t location = Coord_t{0, 0};
 
-// When blinded,  move only the player symbol.
-// With no light,  movement becomes involved.
-static void sub3MoveLight(Coord_t const &from, Coord_t const &to) {
-    if (py.temporary_light_only) {
-        Coord_t coord = Coord_t{0, 0};
+    for (location.y = room.top_left.y; location.y <= room.bottom_right.y; location.y++) {
+        for (location.x = room.top_left.x; location.x <= room.bottom_right.x; location.x++) {
+            TileRef_t tile = session->dg.floor[location.y][location.x];
 
-        for (coord.y = from.y - 1; coord.y <= from.y + 1; coord.y++) {
-            for (coord.x = from.x - 1; coord.x <= from.x + 1; coord.x++) {
-                dg.floor[coord.y][coord.x].temporary_light = false;
-                panelPutTile(caveGetTileSymbol(coord), coord);
+            if (tile.perma_lit_room && !tile.permanent_light) {
+                tile.permanent_light = true;
+
+                if (tile.feature_id == TILE_DARK_FLOOR) {
+                    tile.feature_id = TILE_LIGHT_FLOOR;
+                }
+                if (!tile.field_mark && tile.treasure_id != 0) {
+                    int treasure_id = session->game.treasure.list[tile.treasure_id].category_id;
+                    if (treasure_id >= TV_MIN_VISIBLE && treasure_id <= TV_MAX_VISIBLE) {
+                        tile.field_mark = true;
+                    }
+                }
+                panelPutTile(caveGetTileSymbol(location), location);
             }
         }
-
-        py.temporary_light_only = false;
-    } else if ((py.running_tracker == 0) || config::options::run_print_self) {
-        panelPutTile(caveGetTileSymbol(from), from);
-    }
-
-    if ((py.running_tracker == 0) || config::options::run_print_self) {
-        panelPutTile('@', to);
     }
 }
 
-// Package for moving the character's light about the screen
-// Four cases : Normal, Finding, Blind, and No light -RAK-
-void dungeonMoveCharacterLight(Coord_t const &from, Coord_t const &to) {
-    if (py.flags.blind > 0 || !py.carrying_light) {
-        sub3MoveLight(from, to);
-    } else {
-        sub1MoveLight(from, to);
+// Lights up given location -RAK-
+void dungeonLiteSpot(Coord_t const &coord) {
+    dungeonOverviewTouch(coord);
+
+    if (!coordInsidePanel(coord)) {
+        return;
     }
+
+    char symbol = caveGetTileSymbol(coord);
+    panelPutTile(symbol, coord);
 }
 
 // Deletes a monster entry from the level -RAK-
@@ -512,36 +688,36 @@ void dungeonDeleteMonster(int id) {
 // its ID from the dungeon level.
 // This is called in breath(), and a couple of places in creatures.c.
 void dungeonRemoveMonsterFromLevel(int id) {
-    Monster_t &monster = monsters[id];
+    Monster_t &monster = session->monsters[id];
 
     // Force the HP negative to ensure that the monster is dead. For example, if the
     // monster was just eaten by another, it will still have positive hit points.
     monster.hp = -1;
 
-    dg.floor[monster.pos.y][monster.pos.x].creature_id = 0;
+    session->dg.floor[monster.pos.y][monster.pos.x].creature_id = 0;
 
     if (monster.lit) {
         dungeonLiteSpot(Coord_t{monster.pos.y, monster.pos.x});
     }
 
-    if (monster_multiply_total > 0) {
-        monster_multiply_total--;
+    if (session->monster_multiply_total > 0) {
+        session->monster_multiply_total--;
     }
 }
 
 // dungeonDeleteMonsterRecord delete the monster record from the monsters list.
 // Called by updateMonsters() and dungeonDeleteMonster() only.
 void dungeonDeleteMonsterRecord(int id) {
-    int last_id = next_free_monster_id - 1;
-    Monster_t &monster = monsters[last_id];
+    int last_id = session->next_free_monster_id - 1;
+    Monster_t &monster = session->monsters[last_id];
 
     if (id != last_id) {
-        dg.floor[monster.pos.y][monster.pos.x].creature_id = (uint8_t) id;
-        monsters[id] = monsters[last_id];
+        session->dg.floor[monster.pos.y][monster.pos.x].creature_id = (uint8_t) id;
+        session->monsters[id] = session->monsters[last_id];
     }
 
-    monsters[last_id] = blank_monster;
-    next_free_monster_id--;
+    session->monsters[last_id] = blank_monster;
+    session->next_free_monster_id--;
 }
 
 // Creates objects nearby the coordinates given -RAK-
@@ -564,7 +740,7 @@ int dungeonSummonObject(Coord_t coord, int amount, int object_type) {
             };
 
             if (coordInBounds(at) && los(coord, at)) {
-                if (dg.floor[at.y][at.x].feature_id <= MAX_OPEN_SPACE && dg.floor[at.y][at.x].treasure_id == 0) {
+                if (session->dg.floor[at.y][at.x].feature_id <= MAX_OPEN_SPACE && session->dg.floor[at.y][at.x].treasure_id == 0) {
                     // object_type == 3 -> 50% objects, 50% gold
                     if (object_type == 3 || object_type == 7) {
                         if (randomNumber(100) < 50) {
@@ -599,10 +775,11 @@ int dungeonSummonObject(Coord_t coord, int amount, int object_type) {
 
 // Deletes object from given location -RAK-
 bool dungeonDeleteObject(Coord_t const &coord) {
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
     if (tile.feature_id == TILE_BLOCKED_FLOOR) {
         tile.feature_id = TILE_CORR_FLOOR;
+        dungeonFloorTileChanged(coord);
     }
 
     pusht(tile.treasure_id);
@@ -35,6 +35,38 @@ typedef struct {
     uint8_t depth_first_found; // Dungeon level item first found
 } DungeonObject_t;
 
+#ifdef TILE_PLANES
+
+class TileRow_t;
+
+// The tiles of the map, one plane per field
+typedef struct TilePlanes_t {
+    uint8_t creature_ids[MAX_HEIGHT][MAX_WIDTH];
+    uint8_t treasure_ids[MAX_HEIGHT][MAX_WIDTH];
+    uint8_t feature_ids[MAX_HEIGHT][MAX_WIDTH];
+    uint8_t flags[MAX_HEIGHT][MAX_WIDTH];
+
+    TileRow_t operator[](int y);
+} TilePlanes_t;
+
+// A row of the planes, indexing it gives the tile
+class TileRow_t {
+  public:
+    TileRow_t(TilePlanes_t &planes, int row) : floor(planes), y(row) {}
+
+    TileRef_t operator[](int x) const { return TileRef_t(floor.creature_ids[y][x], floor.treasure_ids[y][x], floor.feature_ids[y][x], floor.flags[y][x]); }
+
+  private:
+    TilePlanes_t &floor;
+    int y;
+};
+
+inline TileRow_t TilePlanes_t::operator[](int y) {
+    return TileRow_t(*this, y);
+}
+
+#endif
+
 typedef struct {
     // Dungeon size is either just big enough for town level, or the whole dungeon itself
     int16_t height;
@@ -52,13 +84,51 @@ typedef struct {
     bool generate_new_level;
 
     // Floor definitions
+#ifdef TILE_PLANES
+    TilePlanes_t floor;
+#else
     Tile_t floor[MAX_HEIGHT][MAX_WIDTH];
+#endif
 } Dungeon_t;
 
-extern Dungeon_t dg;
-extern DungeonObject_t game_objects[MAX_OBJECTS_IN_GAME];
+// Rooms are numbered from 1 when a level is generated or loaded, 0 being
+// "not in a room". See dungeonFindRooms().
+constexpr int MAX_ROOMS = UINT8_MAX;
+
+// Room_t holds the span of the tiles of a room, see dungeonFindRooms()
+typedef struct {
+    Coord_t top_left;
+    Coord_t bottom_right;
+} Room_t;
+
+// Kinds of floor tile that new objects and monsters are placed on
+enum class FloorTiles { Room, Corridor, Any };
+
+// The floor tiles are kept in three lists: room floors, corridor floors,
+// and any other floors. See dungeonFindFloorTiles().
+constexpr int FLOOR_TILE_LISTS = 3;
+
+// Walks over the floor tiles of one kind in random order, see dungeonNextFloorTile()
+typedef struct {
+    int next[FLOOR_TILE_LISTS];
+    int end[FLOOR_TILE_LISTS];
+} FloorTileSearch_t;
+extern DungeonObject_t const (&game_objects)[MAX_OBJECTS_IN_GAME];
+
+// The reduced size map of the level, one symbol for each RATIO by RATIO
+// block of tiles. See dungeonOverview().
+constexpr uint8_t OVERVIEW_HEIGHT = MAX_HEIGHT / RATIO;
+constexpr uint8_t OVERVIEW_WIDTH = MAX_WIDTH / RATIO;
+
+typedef struct {
+    char rows[OVERVIEW_HEIGHT][OVERVIEW_WIDTH + 1]; // A NUL terminated string for each row
+    Coord_t player;                                  // The block the player is in
+} Overview_t;
 
 void dungeonDisplayMap();
+Overview_t const &dungeonOverview();
+void dungeonOverviewTouch(Coord_t const &coord);
+void dungeonOverviewForget();
 
 bool coordInBounds(Coord_t const &coord);
 int coordDistanceBetween(Coord_t const &from, Coord_t const &to);
@@ -74,13 +144,19 @@ void dungeonPlaceRubble(Coord_t const &coord);
 void dungeonPlaceGold(Coord_t const &coord);
 
 void dungeonPlaceRandomObjectAt(Coord_t const &coord, bool must_be_small);
-void dungeonAllocateAndPlaceObject(bool (*set_function)(int), int object_type, int number);
+void dungeonFindFloorTiles();
+void dungeonFloorTileChanged(Coord_t const &coord);
+FloorTileSearch_t dungeonSearchFloorTiles(FloorTiles kind);
+bool dungeonNextFloorTile(FloorTileSearch_t &search, Coord_t &coord);
+void dungeonAllocateAndPlaceObject(FloorTiles kind, int object_type, int number);
 void dungeonPlaceRandomObjectNear(Coord_t coord, int tries);
 
 void dungeonMoveCreatureRecord(Coord_t const &from, Coord_t const &to);
+void dungeonFindRooms();
+int dungeonRoomId(Coord_t const &coord);
+Room_t dungeonRoomAt(Coord_t const &coord);
 void dungeonLightRoom(Coord_t const &coord);
 void dungeonLiteSpot(Coord_t const &coord);
-void dungeonMoveCharacterLight(Coord_t const &from, Coord_t const &to);
 
 void dungeonDeleteMonster(int id);
 void dungeonRemoveMonsterFromLevel(int id);
@@ -91,6 +167,10 @@ bool dungeonDeleteObject(Coord_t const &coord);
 // generate the dungeon
 void generateCave();
 
+// Lamp light
+void dungeonLampLightOff(Coord_t const &coord);
+void dungeonMoveCharacterLight(Coord_t const &from, Coord_t const &to);
+
 // Line of Sight
 bool los(Coord_t from, Coord_t to);
 void look();
@@ -7,12 +7,13 @@
 
 #include "headers.h"
 
-static Coord_t doors_tk[100];
-static int door_index;
+// Doors of the level being generated
+static thread_local Coord_t doors_tk[100];
+static thread_local int door_index;
 
 // Returns a Dark/Light floor tile based on dg.current_level, and random number
 static uint8_t dungeonFloorTileForLevel() {
-    if (dg.current_level <= randomNumber(25)) {
+    if (session->dg.current_level <= randomNumber(25)) {
         return TILE_LIGHT_FLOOR;
     }
     return TILE_DARK_FLOOR;
@@ -60,65 +61,37 @@ static void chanceOfRandomDirection(int &vertical, int &horizontal) {
 
 // Blanks out entire cave -RAK-
 static void dungeonBlankEntireCave() {
-    memset((char *) &dg.floor[0][0], 0, sizeof(dg.floor));
+    memset((char *) &session->dg.floor, 0, sizeof(session->dg.floor));
 }
 
 // Fills in empty spots with desired rock -RAK-
 // Note: 9 is a temporary value.
 static void dungeonFillEmptyTilesWith(uint8_t rock_type) {
     // no need to check the border of the cave
-    for (int y = dg.height - 2; y > 0; y--) {
+    for (int y = session->dg.height - 2; y > 0; y--) {
         int x = 1;
 
-        for (int j = dg.width - 2; j > 0; j--) {
-            if (dg.floor[y][x].feature_id == TILE_NULL_WALL || dg.floor[y][x].feature_id == TMP1_WALL || dg.floor[y][x].feature_id == TMP2_WALL) {
-                dg.floor[y][x].feature_id = rock_type;
+        for (int j = session->dg.width - 2; j > 0; j--) {
+            if (session->dg.floor[y][x].feature_id == TILE_NULL_WALL || session->dg.floor[y][x].feature_id == TMP1_WALL || session->dg.floor[y][x].feature_id == TMP2_WALL) {
+                session->dg.floor[y][x].feature_id = rock_type;
             }
             x++;
         }
     }
 }
 
-#ifdef DEBUG
-#include <assert.h>
-#endif
-
 // Places indestructible rock around edges of dungeon -RAK-
 static void dungeonPlaceBoundaryWalls() {
-    Tile_t(*left_ptr)[MAX_WIDTH];
-    Tile_t(*right_ptr)[MAX_WIDTH];
-
     // put permanent wall on leftmost row and rightmost row
-    left_ptr = (Tile_t(*)[MAX_WIDTH]) & dg.floor[0][0];
-    right_ptr = (Tile_t(*)[MAX_WIDTH]) & dg.floor[0][dg.width - 1];
-
-    for (int i = 0; i < dg.height; i++) {
-#ifdef DEBUG
-        assert((Tile_t *) left_ptr == &floor[i][0]);
-        assert((Tile_t *) right_ptr == &floor[i][dg.width - 1]);
-#endif
-
-        ((Tile_t *) left_ptr)->feature_id = TILE_BOUNDARY_WALL;
-        left_ptr++;
-
-        ((Tile_t *) right_ptr)->feature_id = TILE_BOUNDARY_WALL;
-        right_ptr++;
+    for (int y = 0; y < session->dg.height; y++) {
+        session->dg.floor[y][0].feature_id = TILE_BOUNDARY_WALL;
+        session->dg.floor[y][session->dg.width - 1].feature_id = TILE_BOUNDARY_WALL;
     }
 
     // put permanent wall on top row and bottom row
-    Tile_t *top_ptr = &dg.floor[0][0];
-    Tile_t *bottom_ptr = &dg.floor[dg.height - 1][0];
-
-    for (int i = 0; i < dg.width; i++) {
-#ifdef DEBUG
-        assert(top_ptr == &floor[0][i]);
-        assert(bottom_ptr == &floor[dg.height - 1][i]);
-#endif
-        top_ptr->feature_id = TILE_BOUNDARY_WALL;
-        top_ptr++;
-
-        bottom_ptr->feature_id = TILE_BOUNDARY_WALL;
-        bottom_ptr++;
+    for (int x = 0; x < session->dg.width; x++) {
+        session->dg.floor[0][x].feature_id = TILE_BOUNDARY_WALL;
+        session->dg.floor[session->dg.height - 1][x].feature_id = TILE_BOUNDARY_WALL;
     }
 }
 
@@ -126,8 +99,8 @@ static void dungeonPlaceBoundaryWalls() {
 static void dungeonPlaceStreamerRock(uint8_t rock_type, int chance_of_treasure) {
     // Choose starting point and direction
     Coord_t coord = Coord_t{
-        (dg.height / 2) + 11 - randomNumber(23),
-        (dg.width / 2) + 16 - randomNumber(33),
+        (session->dg.height / 2) + 11 - randomNumber(23),
+        (session->dg.width / 2) + 16 - randomNumber(33),
     };
 
     // Get random direction. Numbers 1-4, 6-9
@@ -148,8 +121,8 @@ static void dungeonPlaceStreamerRock(uint8_t rock_type, int chance_of_treasure)
             };
 
             if (coordInBounds(spot)) {
-                if (dg.floor[spot.y][spot.x].feature_id == TILE_GRANITE_WALL) {
-                    dg.floor[spot.y][spot.x].feature_id = rock_type;
+                if (session->dg.floor[spot.y][spot.x].feature_id == TILE_GRANITE_WALL) {
+                    session->dg.floor[spot.y][spot.x].feature_id = rock_type;
 
                     if (randomNumber(chance_of_treasure) == 1) {
                         dungeonPlaceGold(spot);
@@ -162,47 +135,47 @@ static void dungeonPlaceStreamerRock(uint8_t rock_type, int chance_of_treasure)
 
 static void dungeonPlaceOpenDoor(Coord_t coord) {
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, game.treasure.list[cur_pos]);
-    dg.floor[coord.y][coord.x].feature_id = TILE_CORR_FLOOR;
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, session->game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].feature_id = TILE_CORR_FLOOR;
 }
 
 static void dungeonPlaceBrokenDoor(Coord_t coord) {
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, game.treasure.list[cur_pos]);
-    dg.floor[coord.y][coord.x].feature_id = TILE_CORR_FLOOR;
-    game.treasure.list[cur_pos].misc_use = 1;
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, session->game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].feature_id = TILE_CORR_FLOOR;
+    session->game.treasure.list[cur_pos].misc_use = 1;
 }
 
 static void dungeonPlaceClosedDoor(Coord_t coord) {
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, game.treasure.list[cur_pos]);
-    dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, session->game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
 }
 
 static void dungeonPlaceLockedDoor(Coord_t coord) {
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, game.treasure.list[cur_pos]);
-    dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
-    game.treasure.list[cur_pos].misc_use = (int16_t)(randomNumber(10) + 10);
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, session->game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
+    session->game.treasure.list[cur_pos].misc_use = (int16_t)(randomNumber(10) + 10);
 }
 
 static void dungeonPlaceStuckDoor(Coord_t coord) {
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, game.treasure.list[cur_pos]);
-    dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
-    game.treasure.list[cur_pos].misc_use = (int16_t)(-randomNumber(10) - 10);
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, session->game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
+    session->game.treasure.list[cur_pos].misc_use = (int16_t)(-randomNumber(10) - 10);
 }
 
 static void dungeonPlaceSecretDoor(Coord_t coord) {
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_SECRET_DOOR, game.treasure.list[cur_pos]);
-    dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_SECRET_DOOR, session->game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].feature_id = TILE_BLOCKED_FLOOR;
 }
 
 static void dungeonPlaceDoor(Coord_t coord) {
@@ -231,24 +204,24 @@ static void dungeonPlaceDoor(Coord_t coord) {
 
 // Place an up staircase at given y, x -RAK-
 static void dungeonPlaceUpStairs(Coord_t coord) {
-    if (dg.floor[coord.y][coord.x].treasure_id != 0) {
+    if (session->dg.floor[coord.y][coord.x].treasure_id != 0) {
         (void) dungeonDeleteObject(coord);
     }
 
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_UP_STAIR, game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_UP_STAIR, session->game.treasure.list[cur_pos]);
 }
 
 // Place a down staircase at given y, x -RAK-
 static void dungeonPlaceDownStairs(Coord_t coord) {
-    if (dg.floor[coord.y][coord.x].treasure_id != 0) {
+    if (session->dg.floor[coord.y][coord.x].treasure_id != 0) {
         (void) dungeonDeleteObject(coord);
     }
 
     int cur_pos = popt();
-    dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_DOWN_STAIR, game.treasure.list[cur_pos]);
+    session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) cur_pos;
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_DOWN_STAIR, session->game.treasure.list[cur_pos]);
 }
 
 // Places a staircase 1=up, 2=down -RAK-
@@ -267,14 +240,15 @@ static void dungeonPlaceStairs(int stair_type, int number, int walls) {
                 // don't let y1/x1 be zero,
                 // don't let y2/x2 be equal to dg.height-1/dg.width-1,
                 // these values are always BOUNDARY_ROCK.
-                coord1.y = randomNumber(dg.height - 14);
-                coord1.x = randomNumber(dg.width - 14);
+                coord1.y = randomNumber(session->dg.height - 14);
+                coord1.x = randomNumber(session->dg.width - 14);
                 coord2.y = coord1.y + 12;
                 coord2.x = coord1.x + 12;
 
                 do {
                     do {
-                        if (dg.floor[coord1.y][coord1.x].feature_id <= MAX_OPEN_SPACE && dg.floor[coord1.y][coord1.x].treasure_id == 0 && coordWallsNextTo(coord1) >= walls) {
+                        if (session->dg.floor[coord1.y][coord1.x].feature_id <= MAX_OPEN_SPACE && session->dg.floor[coord1.y][coord1.x].treasure_id == 0 &&
+                            coordWallsNextTo(coord1) >= walls) {
                             placed = true;
                             if (stair_type == 1) {
                                 dungeonPlaceUpStairs(coord1);
@@ -308,7 +282,8 @@ static void dungeonPlaceVaultTrap(Coord_t coord, Coord_t displacement, int numbe
             spot.y = coord.y - displacement.y - 1 + randomNumber(2 * displacement.y + 1);
             spot.x = coord.x - displacement.x - 1 + randomNumber(2 * displacement.x + 1);
 
-            if (dg.floor[spot.y][spot.x].feature_id != TILE_NULL_WALL && dg.floor[spot.y][spot.x].feature_id <= MAX_CAVE_FLOOR && dg.floor[spot.y][spot.x].treasure_id == 0) {
+            if (session->dg.floor[spot.y][spot.x].feature_id != TILE_NULL_WALL && session->dg.floor[spot.y][spot.x].feature_id <= MAX_CAVE_FLOOR &&
+                session->dg.floor[spot.y][spot.x].treasure_id == 0) {
                 dungeonSetTrap(spot, randomNumber(config::dungeon::objects::MAX_TRAPS) - 1);
                 placed = true;
             }
@@ -343,25 +318,25 @@ static void dungeonBuildRoom(Coord_t coord) {
 
     for (y = height; y <= depth; y++) {
         for (x = left; x <= right; x++) {
-            dg.floor[y][x].feature_id = floor;
-            dg.floor[y][x].perma_lit_room = true;
+            session->dg.floor[y][x].feature_id = floor;
+            session->dg.floor[y][x].perma_lit_room = true;
         }
     }
 
     for (y = height - 1; y <= depth + 1; y++) {
-        dg.floor[y][left - 1].feature_id = TILE_GRANITE_WALL;
-        dg.floor[y][left - 1].perma_lit_room = true;
+        session->dg.floor[y][left - 1].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[y][left - 1].perma_lit_room = true;
 
-        dg.floor[y][right + 1].feature_id = TILE_GRANITE_WALL;
-        dg.floor[y][right + 1].perma_lit_room = true;
+        session->dg.floor[y][right + 1].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[y][right + 1].perma_lit_room = true;
     }
 
     for (x = left; x <= right; x++) {
-        dg.floor[height - 1][x].feature_id = TILE_GRANITE_WALL;
-        dg.floor[height - 1][x].perma_lit_room = true;
+        session->dg.floor[height - 1][x].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[height - 1][x].perma_lit_room = true;
 
-        dg.floor[depth + 1][x].feature_id = TILE_GRANITE_WALL;
-        dg.floor[depth + 1][x].perma_lit_room = true;
+        session->dg.floor[depth + 1][x].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[depth + 1][x].perma_lit_room = true;
     }
 }
 
@@ -385,31 +360,31 @@ static void dungeonBuildRoomOverlappingRectangles(Coord_t coord) {
 
         for (y = height; y <= depth; y++) {
             for (x = left; x <= right; x++) {
-                dg.floor[y][x].feature_id = floor;
-                dg.floor[y][x].perma_lit_room = true;
+                session->dg.floor[y][x].feature_id = floor;
+                session->dg.floor[y][x].perma_lit_room = true;
             }
         }
         for (y = (height - 1); y <= (depth + 1); y++) {
-            if (dg.floor[y][left - 1].feature_id != floor) {
-                dg.floor[y][left - 1].feature_id = TILE_GRANITE_WALL;
-                dg.floor[y][left - 1].perma_lit_room = true;
+            if (session->dg.floor[y][left - 1].feature_id != floor) {
+                session->dg.floor[y][left - 1].feature_id = TILE_GRANITE_WALL;
+                session->dg.floor[y][left - 1].perma_lit_room = true;
             }
 
-            if (dg.floor[y][right + 1].feature_id != floor) {
-                dg.floor[y][right + 1].feature_id = TILE_GRANITE_WALL;
-                dg.floor[y][right + 1].perma_lit_room = true;
+            if (session->dg.floor[y][right + 1].feature_id != floor) {
+                session->dg.floor[y][right + 1].feature_id = TILE_GRANITE_WALL;
+                session->dg.floor[y][right + 1].perma_lit_room = true;
             }
         }
 
         for (x = left; x <= right; x++) {
-            if (dg.floor[height - 1][x].feature_id != floor) {
-                dg.floor[height - 1][x].feature_id = TILE_GRANITE_WALL;
-                dg.floor[height - 1][x].perma_lit_room = true;
+            if (session->dg.floor[height - 1][x].feature_id != floor) {
+                session->dg.floor[height - 1][x].feature_id = TILE_GRANITE_WALL;
+                session->dg.floor[height - 1][x].perma_lit_room = true;
             }
 
-            if (dg.floor[depth + 1][x].feature_id != floor) {
-                dg.floor[depth + 1][x].feature_id = TILE_GRANITE_WALL;
-                dg.floor[depth + 1][x].perma_lit_room = true;
+            if (session->dg.floor[depth + 1][x].feature_id != floor) {
+                session->dg.floor[depth + 1][x].feature_id = TILE_GRANITE_WALL;
+                session->dg.floor[depth + 1][x].perma_lit_room = true;
             }
         }
     }
@@ -434,12 +409,12 @@ static void dungeonPlaceRandomSecretDoor(Coord_t coord, int depth, int height, i
 
 static void dungeonPlaceVault(Coord_t coord) {
     for (int y = coord.y - 1; y <= coord.y + 1; y++) {
-        dg.floor[y][coord.x - 1].feature_id = TMP1_WALL;
-        dg.floor[y][coord.x + 1].feature_id = TMP1_WALL;
+        session->dg.floor[y][coord.x - 1].feature_id = TMP1_WALL;
+        session->dg.floor[y][coord.x + 1].feature_id = TMP1_WALL;
     }
 
-    dg.floor[coord.y - 1][coord.x].feature_id = TMP1_WALL;
-    dg.floor[coord.y + 1][coord.x].feature_id = TMP1_WALL;
+    session->dg.floor[coord.y - 1][coord.x].feature_id = TMP1_WALL;
+    session->dg.floor[coord.y + 1][coord.x].feature_id = TMP1_WALL;
 }
 
 static void dungeonPlaceTreasureVault(Coord_t coord, int depth, int height, int left, int right) {
@@ -461,7 +436,7 @@ static void dungeonPlaceInnerPillars(Coord_t coord) {
 
     for (y = coord.y - 1; y <= coord.y + 1; y++) {
         for (x = coord.x - 1; x <= coord.x + 1; x++) {
-            dg.floor[y][x].feature_id = TMP1_WALL;
+            session->dg.floor[y][x].feature_id = TMP1_WALL;
         }
     }
 
@@ -473,13 +448,13 @@ static void dungeonPlaceInnerPillars(Coord_t coord) {
 
     for (y = coord.y - 1; y <= coord.y + 1; y++) {
         for (x = coord.x - 5 - offset; x <= coord.x - 3 - offset; x++) {
-            dg.floor[y][x].feature_id = TMP1_WALL;
+            session->dg.floor[y][x].feature_id = TMP1_WALL;
         }
     }
 
     for (y = coord.y - 1; y <= coord.y + 1; y++) {
         for (x = coord.x + 3 + offset; x <= coord.x + 5 + offset; x++) {
-            dg.floor[y][x].feature_id = TMP1_WALL;
+            session->dg.floor[y][x].feature_id = TMP1_WALL;
         }
     }
 }
@@ -488,7 +463,7 @@ static void dungeonPlaceMazeInsideRoom(int depth, int height, int left, int righ
     for (int y = height; y <= depth; y++) {
         for (int x = left; x <= right; x++) {
             if ((0x1 & (x + y)) != 0) {
-                dg.floor[y][x].feature_id = TMP1_WALL;
+                session->dg.floor[y][x].feature_id = TMP1_WALL;
             }
         }
     }
@@ -496,11 +471,11 @@ static void dungeonPlaceMazeInsideRoom(int depth, int height, int left, int righ
 
 static void dungeonPlaceFourSmallRooms(Coord_t coord, int depth, int height, int left, int right) {
     for (int y = height; y <= depth; y++) {
-        dg.floor[y][coord.x].feature_id = TMP1_WALL;
+        session->dg.floor[y][coord.x].feature_id = TMP1_WALL;
     }
 
     for (int x = left; x <= right; x++) {
-        dg.floor[coord.y][x].feature_id = TMP1_WALL;
+        session->dg.floor[coord.y][x].feature_id = TMP1_WALL;
     }
 
     // place random secret door
@@ -547,25 +522,25 @@ static void dungeonBuildRoomWithInnerRooms(Coord_t coord) {
 
     for (int i = height; i <= depth; i++) {
         for (int j = left; j <= right; j++) {
-            dg.floor[i][j].feature_id = floor;
-            dg.floor[i][j].perma_lit_room = true;
+            session->dg.floor[i][j].feature_id = floor;
+            session->dg.floor[i][j].perma_lit_room = true;
         }
     }
 
     for (int i = (height - 1); i <= (depth + 1); i++) {
-        dg.floor[i][left - 1].feature_id = TILE_GRANITE_WALL;
-        dg.floor[i][left - 1].perma_lit_room = true;
+        session->dg.floor[i][left - 1].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[i][left - 1].perma_lit_room = true;
 
-        dg.floor[i][right + 1].feature_id = TILE_GRANITE_WALL;
-        dg.floor[i][right + 1].perma_lit_room = true;
+        session->dg.floor[i][right + 1].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[i][right + 1].perma_lit_room = true;
     }
 
     for (int i = left; i <= right; i++) {
-        dg.floor[height - 1][i].feature_id = TILE_GRANITE_WALL;
-        dg.floor[height - 1][i].perma_lit_room = true;
+        session->dg.floor[height - 1][i].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[height - 1][i].perma_lit_room = true;
 
-        dg.floor[depth + 1][i].feature_id = TILE_GRANITE_WALL;
-        dg.floor[depth + 1][i].perma_lit_room = true;
+        session->dg.floor[depth + 1][i].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[depth + 1][i].perma_lit_room = true;
     }
 
     // The inner room
@@ -575,13 +550,13 @@ static void dungeonBuildRoomWithInnerRooms(Coord_t coord) {
     right = right - 2;
 
     for (int i = (height - 1); i <= (depth + 1); i++) {
-        dg.floor[i][left - 1].feature_id = TMP1_WALL;
-        dg.floor[i][right + 1].feature_id = TMP1_WALL;
+        session->dg.floor[i][left - 1].feature_id = TMP1_WALL;
+        session->dg.floor[i][right + 1].feature_id = TMP1_WALL;
     }
 
     for (int i = left; i <= right; i++) {
-        dg.floor[height - 1][i].feature_id = TMP1_WALL;
-        dg.floor[depth + 1][i].feature_id = TMP1_WALL;
+        session->dg.floor[height - 1][i].feature_id = TMP1_WALL;
+        session->dg.floor[depth + 1][i].feature_id = TMP1_WALL;
     }
 
     // Inner room variations
@@ -610,11 +585,11 @@ static void dungeonBuildRoomWithInnerRooms(Coord_t coord) {
 
             // Inner rooms
             for (int i = coord.x - 5; i <= coord.x + 5; i++) {
-                dg.floor[coord.y - 1][i].feature_id = TMP1_WALL;
-                dg.floor[coord.y + 1][i].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y - 1][i].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y + 1][i].feature_id = TMP1_WALL;
             }
-            dg.floor[coord.y][coord.x - 5].feature_id = TMP1_WALL;
-            dg.floor[coord.y][coord.x + 5].feature_id = TMP1_WALL;
+            session->dg.floor[coord.y][coord.x - 5].feature_id = TMP1_WALL;
+            session->dg.floor[coord.y][coord.x + 5].feature_id = TMP1_WALL;
 
             dungeonPlaceSecretDoor(Coord_t{coord.y - 3 + (randomNumber(2) << 1), coord.x - 3});
             dungeonPlaceSecretDoor(Coord_t{coord.y - 3 + (randomNumber(2) << 1), coord.x + 3});
@@ -669,7 +644,7 @@ static void dungeonBuildRoomWithInnerRooms(Coord_t coord) {
 static void dungeonPlaceLargeMiddlePillar(Coord_t coord) {
     for (int y = coord.y - 1; y <= coord.y + 1; y++) {
         for (int x = coord.x - 1; x <= coord.x + 1; x++) {
-            dg.floor[y][x].feature_id = TMP1_WALL;
+            session->dg.floor[y][x].feature_id = TMP1_WALL;
         }
     }
 }
@@ -688,25 +663,25 @@ static void dungeonBuildRoomCrossShaped(Coord_t coord) {
 
     for (int i = height; i <= depth; i++) {
         for (int j = left; j <= right; j++) {
-            dg.floor[i][j].feature_id = floor;
-            dg.floor[i][j].perma_lit_room = true;
+            session->dg.floor[i][j].feature_id = floor;
+            session->dg.floor[i][j].perma_lit_room = true;
         }
     }
 
     for (int i = height - 1; i <= depth + 1; i++) {
-        dg.floor[i][left - 1].feature_id = TILE_GRANITE_WALL;
-        dg.floor[i][left - 1].perma_lit_room = true;
+        session->dg.floor[i][left - 1].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[i][left - 1].perma_lit_room = true;
 
-        dg.floor[i][right + 1].feature_id = TILE_GRANITE_WALL;
-        dg.floor[i][right + 1].perma_lit_room = true;
+        session->dg.floor[i][right + 1].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[i][right + 1].perma_lit_room = true;
     }
 
     for (int i = left; i <= right; i++) {
-        dg.floor[height - 1][i].feature_id = TILE_GRANITE_WALL;
-        dg.floor[height - 1][i].perma_lit_room = true;
+        session->dg.floor[height - 1][i].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[height - 1][i].perma_lit_room = true;
 
-        dg.floor[depth + 1][i].feature_id = TILE_GRANITE_WALL;
-        dg.floor[depth + 1][i].perma_lit_room = true;
+        session->dg.floor[depth + 1][i].feature_id = TILE_GRANITE_WALL;
+        session->dg.floor[depth + 1][i].perma_lit_room = true;
     }
 
     random_offset = 2 + randomNumber(9);
@@ -718,32 +693,32 @@ static void dungeonBuildRoomCrossShaped(Coord_t coord) {
 
     for (int i = height; i <= depth; i++) {
         for (int j = left; j <= right; j++) {
-            dg.floor[i][j].feature_id = floor;
-            dg.floor[i][j].perma_lit_room = true;
+            session->dg.floor[i][j].feature_id = floor;
+            session->dg.floor[i][j].perma_lit_room = true;
         }
     }
 
     for (int i = height - 1; i <= depth + 1; i++) {
-        if (dg.floor[i][left - 1].feature_id != floor) {
-            dg.floor[i][left - 1].feature_id = TILE_GRANITE_WALL;
-            dg.floor[i][left - 1].perma_lit_room = true;
+        if (session->dg.floor[i][left - 1].feature_id != floor) {
+            session->dg.floor[i][left - 1].feature_id = TILE_GRANITE_WALL;
+            session->dg.floor[i][left - 1].perma_lit_room = true;
         }
 
-        if (dg.floor[i][right + 1].feature_id != floor) {
-            dg.floor[i][right + 1].feature_id = TILE_GRANITE_WALL;
-            dg.floor[i][right + 1].perma_lit_room = true;
+        if (session->dg.floor[i][right + 1].feature_id != floor) {
+            session->dg.floor[i][right + 1].feature_id = TILE_GRANITE_WALL;
+            session->dg.floor[i][right + 1].perma_lit_room = true;
         }
     }
 
     for (int i = left; i <= right; i++) {
-        if (dg.floor[height - 1][i].feature_id != floor) {
-            dg.floor[height - 1][i].feature_id = TILE_GRANITE_WALL;
-            dg.floor[height - 1][i].perma_lit_room = true;
+        if (session->dg.floor[height - 1][i].feature_id != floor) {
+            session->dg.floor[height - 1][i].feature_id = TILE_GRANITE_WALL;
+            session->dg.floor[height - 1][i].perma_lit_room = true;
         }
 
-        if (dg.floor[depth + 1][i].feature_id != floor) {
-            dg.floor[depth + 1][i].feature_id = TILE_GRANITE_WALL;
-            dg.floor[depth + 1][i].perma_lit_room = true;
+        if (session->dg.floor[depth + 1][i].feature_id != floor) {
+            session->dg.floor[depth + 1][i].feature_id = TILE_GRANITE_WALL;
+            session->dg.floor[depth + 1][i].perma_lit_room = true;
         }
     }
 
@@ -774,14 +749,14 @@ static void dungeonBuildRoomCrossShaped(Coord_t coord) {
             break;
         case 3:
             if (randomNumber(3) == 1) {
-                dg.floor[coord.y - 1][coord.x - 2].feature_id = TMP1_WALL;
-                dg.floor[coord.y + 1][coord.x - 2].feature_id = TMP1_WALL;
-                dg.floor[coord.y - 1][coord.x + 2].feature_id = TMP1_WALL;
-                dg.floor[coord.y + 1][coord.x + 2].feature_id = TMP1_WALL;
-                dg.floor[coord.y - 2][coord.x - 1].feature_id = TMP1_WALL;
-                dg.floor[coord.y - 2][coord.x + 1].feature_id = TMP1_WALL;
-                dg.floor[coord.y + 2][coord.x - 1].feature_id = TMP1_WALL;
-                dg.floor[coord.y + 2][coord.x + 1].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y - 1][coord.x - 2].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y + 1][coord.x - 2].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y - 1][coord.x + 2].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y + 1][coord.x + 2].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y - 2][coord.x - 1].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y - 2][coord.x + 1].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y + 2][coord.x - 1].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y + 2][coord.x + 1].feature_id = TMP1_WALL;
                 if (randomNumber(3) == 1) {
                     dungeonPlaceSecretDoor(Coord_t{coord.y, coord.x - 2});
                     dungeonPlaceSecretDoor(Coord_t{coord.y, coord.x + 2});
@@ -789,13 +764,13 @@ static void dungeonBuildRoomCrossShaped(Coord_t coord) {
                     dungeonPlaceSecretDoor(Coord_t{coord.y + 2, coord.x});
                 }
             } else if (randomNumber(3) == 1) {
-                dg.floor[coord.y][coord.x].feature_id = TMP1_WALL;
-                dg.floor[coord.y - 1][coord.x].feature_id = TMP1_WALL;
-                dg.floor[coord.y + 1][coord.x].feature_id = TMP1_WALL;
-                dg.floor[coord.y][coord.x - 1].feature_id = TMP1_WALL;
-                dg.floor[coord.y][coord.x + 1].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y][coord.x].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y - 1][coord.x].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y + 1][coord.x].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y][coord.x - 1].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y][coord.x + 1].feature_id = TMP1_WALL;
             } else if (randomNumber(3) == 1) {
-                dg.floor[coord.y][coord.x].feature_id = TMP1_WALL;
+                session->dg.floor[coord.y][coord.x].feature_id = TMP1_WALL;
             }
             break;
         // handled by the default case
@@ -852,7 +827,7 @@ static void dungeonBuildTunnel(Coord_t start, Coord_t end) {
             tmp_col = start.x + x_direction;
         }
 
-        switch (dg.floor[tmp_row][tmp_col].feature_id) {
+        switch (session->dg.floor[tmp_row][tmp_col].feature_id) {
             case TILE_NULL_WALL:
                 start.y = tmp_row;
                 start.x = tmp_col;
@@ -881,8 +856,8 @@ static void dungeonBuildTunnel(Coord_t start, Coord_t end) {
                         if (coordInBounds(Coord_t{y, x})) {
                             // values 11 and 12 are impossible here, dungeonPlaceStreamerRock
                             // is never run before dungeonBuildTunnel
-                            if (dg.floor[y][x].feature_id == TILE_GRANITE_WALL) {
-                                dg.floor[y][x].feature_id = TMP2_WALL;
+                            if (session->dg.floor[y][x].feature_id == TILE_GRANITE_WALL) {
+                                session->dg.floor[y][x].feature_id = TMP2_WALL;
                             }
                         }
                     }
@@ -928,11 +903,11 @@ static void dungeonBuildTunnel(Coord_t start, Coord_t end) {
     } while ((start.y != end.y || start.x != end.x) && !stop_flag);
 
     for (int i = 0; i < tunnel_index; i++) {
-        dg.floor[tunnels_tk[i].y][tunnels_tk[i].x].feature_id = TILE_CORR_FLOOR;
+        session->dg.floor[tunnels_tk[i].y][tunnels_tk[i].x].feature_id = TILE_CORR_FLOOR;
     }
 
     for (int i = 0; i < wall_index; i++) {
-        Tile_t &tile = dg.floor[walls_tk[i].y][walls_tk[i].x];
+        TileRef_t tile = session->dg.floor[walls_tk[i].y][walls_tk[i].x];
 
         if (tile.feature_id == TMP2_WALL) {
             if (randomNumber(100) < config::dungeon::DUN_ROOM_DOORS) {
@@ -947,8 +922,8 @@ static void dungeonBuildTunnel(Coord_t start, Coord_t end) {
 
 static bool dungeonIsNextTo(Coord_t coord) {
     if (coordCorridorWallsNextTo(coord) > 2) {
-        bool vertical = dg.floor[coord.y - 1][coord.x].feature_id >= MIN_CAVE_WALL && dg.floor[coord.y + 1][coord.x].feature_id >= MIN_CAVE_WALL;
-        bool horizontal = dg.floor[coord.y][coord.x - 1].feature_id >= MIN_CAVE_WALL && dg.floor[coord.y][coord.x + 1].feature_id >= MIN_CAVE_WALL;
+        bool vertical = session->dg.floor[coord.y - 1][coord.x].feature_id >= MIN_CAVE_WALL && session->dg.floor[coord.y + 1][coord.x].feature_id >= MIN_CAVE_WALL;
+        bool horizontal = session->dg.floor[coord.y][coord.x - 1].feature_id >= MIN_CAVE_WALL && session->dg.floor[coord.y][coord.x + 1].feature_id >= MIN_CAVE_WALL;
 
         return vertical || horizontal;
     }
@@ -958,44 +933,34 @@ static bool dungeonIsNextTo(Coord_t coord) {
 
 // Places door at y, x position if at least 2 walls found
 static void dungeonPlaceDoorIfNextToTwoWalls(Coord_t coord) {
-    if (dg.floor[coord.y][coord.x].feature_id == TILE_CORR_FLOOR && randomNumber(100) > config::dungeon::DUN_TUNNEL_DOORS && dungeonIsNextTo(coord)) {
+    if (session->dg.floor[coord.y][coord.x].feature_id == TILE_CORR_FLOOR && randomNumber(100) > config::dungeon::DUN_TUNNEL_DOORS && dungeonIsNextTo(coord)) {
         dungeonPlaceDoor(coord);
     }
 }
 
 // Returns random co-ordinates -RAK-
 static void dungeonNewSpot(Coord_t &coord) {
-    Tile_t *tile = nullptr;
     Coord_t position = Coord_t{0, 0};
+    bool occupied;
 
     do {
-        position.y = (int32_t) randomNumber(dg.height - 2);
-        position.x = (int32_t) randomNumber(dg.width - 2);
-        tile = &dg.floor[position.y][position.x];
-    } while (tile->feature_id >= MIN_CLOSED_SPACE || tile->creature_id != 0 || tile->treasure_id != 0);
+        position.y = (int32_t) randomNumber(session->dg.height - 2);
+        position.x = (int32_t) randomNumber(session->dg.width - 2);
+
+        TileConstRef_t tile = session->dg.floor[position.y][position.x];
+        occupied = tile.feature_id >= MIN_CLOSED_SPACE || tile.creature_id != 0 || tile.treasure_id != 0;
+    } while (occupied);
 
     coord.y = position.y;
     coord.x = position.x;
 }
 
 // Functions to emulate the original Pascal sets
-static bool setRooms(int tile_id) {
-    return (tile_id == TILE_DARK_FLOOR || tile_id == TILE_LIGHT_FLOOR);
-}
-
-static bool setCorridors(int tile_id) {
-    return (tile_id == TILE_CORR_FLOOR || tile_id == TILE_BLOCKED_FLOOR);
-}
-
-static bool setFloors(int tile_id) {
-    return (tile_id <= MAX_CAVE_FLOOR);
-}
-
 // Cave logic flow for generation of new dungeon
 static void dungeonGenerate() {
     // Room initialization
-    int row_rooms = 2 * (dg.height / SCREEN_HEIGHT);
-    int col_rooms = 2 * (dg.width / SCREEN_WIDTH);
+    int row_rooms = 2 * (session->dg.height / SCREEN_HEIGHT);
+    int col_rooms = 2 * (session->dg.width / SCREEN_WIDTH);
 
     bool room_map[20][20];
     for (int row = 0; row < row_rooms; row++) {
@@ -1018,7 +983,7 @@ static void dungeonGenerate() {
             if (room_map[row][col]) {
                 locations[location_id].y = (int32_t)(row * (SCREEN_HEIGHT >> 1) + QUART_HEIGHT);
                 locations[location_id].x = (int32_t)(col * (SCREEN_WIDTH >> 1) + QUART_WIDTH);
-                if (dg.current_level > randomNumber(config::dungeon::DUN_UNUSUAL_ROOMS)) {
+                if (session->dg.current_level > randomNumber(config::dungeon::DUN_UNUSUAL_ROOMS)) {
                     int room_type = randomNumber(3);
 
                     if (room_type == 1) {
@@ -1076,7 +1041,7 @@ static void dungeonGenerate() {
         dungeonPlaceDoorIfNextToTwoWalls(Coord_t{doors_tk[i].y + 1, doors_tk[i].x});
     }
 
-    int alloc_level = (dg.current_level / 3);
+    int alloc_level = (session->dg.current_level / 3);
     if (alloc_level < 2) {
         alloc_level = 2;
     } else if (alloc_level > 10) {
@@ -1089,17 +1054,20 @@ static void dungeonGenerate() {
     // Set up the character coords, used by monsterPlaceNewWithinDistance, monsterPlaceWinning
     Coord_t coord = Coord_t{0, 0};
     dungeonNewSpot(coord);
-    py.pos.y = coord.y;
-    py.pos.x = coord.x;
+    session->py.pos.y = coord.y;
+    session->py.pos.x = coord.x;
+
+    // The floor plan is final, rubble only turns corridor floors into blocked floors
+    dungeonFindFloorTiles();
 
     monsterPlaceNewWithinDistance((randomNumber(8) + config::monsters::MON_MIN_PER_LEVEL + alloc_level), 0, true);
-    dungeonAllocateAndPlaceObject(setCorridors, 3, randomNumber(alloc_level));
-    dungeonAllocateAndPlaceObject(setRooms, 5, randomNumberNormalDistribution(config::dungeon::objects::LEVEL_OBJECTS_PER_ROOM, 3));
-    dungeonAllocateAndPlaceObject(setFloors, 5, randomNumberNormalDistribution(config::dungeon::objects::LEVEL_OBJECTS_PER_CORRIDOR, 3));
-    dungeonAllocateAndPlaceObject(setFloors, 4, randomNumberNormalDistribution(config::dungeon::objects::LEVEL_TOTAL_GOLD_AND_GEMS, 3));
-    dungeonAllocateAndPlaceObject(setFloors, 1, randomNumber(alloc_level));
+    dungeonAllocateAndPlaceObject(FloorTiles::Corridor, 3, randomNumber(alloc_level));
+    dungeonAllocateAndPlaceObject(FloorTiles::Room, 5, randomNumberNormalDistribution(config::dungeon::objects::LEVEL_OBJECTS_PER_ROOM, 3));
+    dungeonAllocateAndPlaceObject(FloorTiles::Any, 5, randomNumberNormalDistribution(config::dungeon::objects::LEVEL_OBJECTS_PER_CORRIDOR, 3));
+    dungeonAllocateAndPlaceObject(FloorTiles::Any, 4, randomNumberNormalDistribution(config::dungeon::objects::LEVEL_TOTAL_GOLD_AND_GEMS, 3));
+    dungeonAllocateAndPlaceObject(FloorTiles::Any, 1, randomNumber(alloc_level));
 
-    if (dg.current_level >= config::monsters::MON_ENDGAME_LEVEL) {
+    if (session->dg.current_level >= config::monsters::MON_ENDGAME_LEVEL) {
         monsterPlaceWinning();
     }
 }
@@ -1117,7 +1085,7 @@ static void dungeonBuildStore(int store_id, Coord_t coord) {
 
     for (y = height; y <= depth; y++) {
         for (x = left; x <= right; x++) {
-            dg.floor[y][x].feature_id = TILE_BOUNDARY_WALL;
+            session->dg.floor[y][x].feature_id = TILE_BOUNDARY_WALL;
         }
     }
 
@@ -1140,28 +1108,28 @@ static void dungeonBuildStore(int store_id, Coord_t coord) {
         }
     }
 
-    dg.floor[y][x].feature_id = TILE_CORR_FLOOR;
+    session->dg.floor[y][x].feature_id = TILE_CORR_FLOOR;
 
     int cur_pos = popt();
-    dg.floor[y][x].treasure_id = (uint8_t) cur_pos;
+    session->dg.floor[y][x].treasure_id = (uint8_t) cur_pos;
 
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_STORE_DOOR + store_id, game.treasure.list[cur_pos]);
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_STORE_DOOR + store_id, session->game.treasure.list[cur_pos]);
 }
 
 // Link all free space in treasure list together
 static void treasureLinker() {
-    for (auto &item : game.treasure.list) {
+    for (auto &item : session->game.treasure.list) {
         inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, item);
     }
-    game.treasure.current_id = config::treasure::MIN_TREASURE_LIST_ID;
+    session->game.treasure.current_id = config::treasure::MIN_TREASURE_LIST_ID;
 }
 
 // Link all free space in monster list together
 static void monsterLinker() {
-    for (auto &monster : monsters) {
+    for (auto &monster : session->monsters) {
         monster = blank_monster;
     }
-    next_free_monster_id = config::monsters::MON_MIN_INDEX_ID;
+    session->next_free_monster_id = config::monsters::MON_MIN_INDEX_ID;
 }
 
 static void dungeonPlaceTownStores() {
@@ -1187,25 +1155,25 @@ static void dungeonPlaceTownStores() {
 }
 
 static bool isNighTime() {
-    return (0x1 & (dg.game_turn / 5000)) != 0;
+    return (0x1 & (session->dg.game_turn / 5000)) != 0;
 }
 
 // Light town based on whether it is Night time, or day time.
 static void lightTown() {
     if (isNighTime()) {
-        for (int y = 0; y < dg.height; y++) {
-            for (int x = 0; x < dg.width; x++) {
-                if (dg.floor[y][x].feature_id != TILE_DARK_FLOOR) {
-                    dg.floor[y][x].permanent_light = true;
+        for (int y = 0; y < session->dg.height; y++) {
+            for (int x = 0; x < session->dg.width; x++) {
+                if (session->dg.floor[y][x].feature_id != TILE_DARK_FLOOR) {
+                    session->dg.floor[y][x].permanent_light = true;
                 }
             }
         }
         monsterPlaceNewWithinDistance(config::monsters::MON_MIN_TOWNSFOLK_NIGHT, 3, true);
     } else {
         // ...it is day time
-        for (int y = 0; y < dg.height; y++) {
-            for (int x = 0; x < dg.width; x++) {
-                dg.floor[y][x].permanent_light = true;
+        for (int y = 0; y < session->dg.height; y++) {
+            for (int x = 0; x < session->dg.width; x++) {
+                session->dg.floor[y][x].permanent_light = true;
             }
         }
         monsterPlaceNewWithinDistance(config::monsters::MON_MIN_TOWNSFOLK_DAY, 3, true);
@@ -1218,7 +1186,7 @@ static void lightTown() {
 
 // Town logic flow for generation of new town
 static void townGeneration() {
-    seedSet(game.town_seed);
+    seedSet(session->game.town_seed);
 
     dungeonPlaceTownStores();
 
@@ -1233,8 +1201,10 @@ static void townGeneration() {
     // Set up the character coords, used by monsterPlaceNewWithinDistance below
     Coord_t coord = Coord_t{0, 0};
     dungeonNewSpot(coord);
-    py.pos.y = coord.y;
-    py.pos.x = coord.x;
+    session->py.pos.y = coord.y;
+    session->py.pos.x = coord.x;
+
+    dungeonFindFloorTiles();
 
     lightTown();
 
@@ -1243,36 +1213,41 @@ static void townGeneration() {
 
 // Generates a random dungeon level -RAK-
 void generateCave() {
-    dg.panel.top = 0;
-    dg.panel.bottom = 0;
-    dg.panel.left = 0;
-    dg.panel.right = 0;
+    session->dg.panel.top = 0;
+    session->dg.panel.bottom = 0;
+    session->dg.panel.left = 0;
+    session->dg.panel.right = 0;
 
-    py.pos.y = -1;
-    py.pos.x = -1;
+    session->py.pos.y = -1;
+    session->py.pos.x = -1;
 
     treasureLinker();
     monsterLinker();
     dungeonBlankEntireCave();
 
     // We're in the dungeon more than the town, so let's default to that -MRC-
-    dg.height = MAX_HEIGHT;
-    dg.width = MAX_WIDTH;
+    session->dg.height = MAX_HEIGHT;
+    session->dg.width = MAX_WIDTH;
 
-    if (dg.current_level == 0) {
-        dg.height = SCREEN_HEIGHT;
-        dg.width = SCREEN_WIDTH;
+    if (session->dg.current_level == 0) {
+        session->dg.height = SCREEN_HEIGHT;
+        session->dg.width = SCREEN_WIDTH;
     }
 
-    dg.panel.max_rows = (int16_t)((dg.height / SCREEN_HEIGHT) * 2 - 2);
-    dg.panel.max_cols = (int16_t)((dg.width / SCREEN_WIDTH) * 2 - 2);
+    session->dg.panel.max_rows = (int16_t)((session->dg.height / SCREEN_HEIGHT) * 2 - 2);
+    session->dg.panel.max_cols = (int16_t)((session->dg.width / SCREEN_WIDTH) * 2 - 2);
 
-    dg.panel.row = dg.panel.max_rows;
-    dg.panel.col = dg.panel.max_cols;
+    session->dg.panel.row = session->dg.panel.max_rows;
+    session->dg.panel.col = session->dg.panel.max_cols;
 
-    if (dg.current_level == 0) {
+    if (session->dg.current_level == 0) {
         townGeneration();
     } else {
         dungeonGenerate();
     }
+
+    dungeonFindRooms();
+    playerRunFindCorridors();
+    dungeonOverviewForget();
+    playerTravelForgetMap();
 }
@@ -0,0 +1,181 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Light from the player's lamp
+
+#include "headers.h"
+
+// Radius of the player's lamp, the original 3x3 square of light
+constexpr int LAMP_RADIUS = 1;
+constexpr int LAMP_MAX_RADIUS = 3;
+
+// The tile offsets a light of each radius can reach. Tiles further out
+// than the adjacent ones are only lit when in line of sight.
+typedef struct {
+    int count;
+    Coord_t offsets[(2 * LAMP_MAX_RADIUS + 1) * (2 * LAMP_MAX_RADIUS + 1)];
+} LightMask_t;
+
+typedef struct {
+    LightMask_t radius[LAMP_MAX_RADIUS + 1];
+} LightMasks_t;
+
+static constexpr LightMasks_t lightMasks() {
+    LightMasks_t masks{};
+
+    for (int r = 0; r <= LAMP_MAX_RADIUS; r++) {
+        LightMask_t &mask = masks.radius[r];
+
+        for (int y = -r; y <= r; y++) {
+            for (int x = -r; x <= r; x++) {
+                mask.offsets[mask.count].y = y;
+                mask.offsets[mask.count].x = x;
+                mask.count++;
+            }
+        }
+    }
+
+    return masks;
+}
+
+static constexpr LightMasks_t light_masks = lightMasks();
+
+static_assert(LAMP_RADIUS <= LAMP_MAX_RADIUS, "lamp radius has no light mask");
+
+// Does a lamp at the center light up the given tile?
+static bool lampReaches(Coord_t const &center, Coord_t const &coord) {
+    int dy = std::abs(coord.y - center.y);
+    int dx = std::abs(coord.x - center.x);
+
+    if (dy > LAMP_RADIUS || dx > LAMP_RADIUS) {
+        return false;
+    }
+
+    if (dy > 1 || dx > 1) {
+        return coordInBounds(coord) && los(center, coord);
+    }
+
+    return true;
+}
+
+// Bits of a tile that decide how it is drawn by caveGetTileSymbol()
+static int tileLightState(TileConstRef_t tile) {
+    return (int) tile.temporary_light | ((int) tile.permanent_light << 1) | ((int) tile.field_mark << 2);
+}
+
+// Turns off the lamp light around a location, except for the tiles still
+// lit from `keep_lit`. Only tiles that were lit are redrawn.
+static void lampLightOff(Coord_t const &center, Coord_t const *keep_lit) {
+    LightMask_t const &mask = light_masks.radius[LAMP_RADIUS];
+
+    for (int i = 0; i < mask.count; i++) {
+        Coord_t coord = Coord_t{center.y + mask.offsets[i].y, center.x + mask.offsets[i].x};
+
+        if (!lampReaches(center, coord)) {
+            continue;
+        }
+
+        if (keep_lit != nullptr && lampReaches(*keep_lit, coord)) {
+            continue;
+        }
+
+        TileRef_t tile = session->dg.floor[coord.y][coord.x];
+
+        if (tile.temporary_light) {
+            tile.temporary_light = false;
+            dungeonLiteSpot(coord);
+        }
+    }
+}
+
+// Turn off the light of the player's lamp, e.g. before being teleported away
+void dungeonLampLightOff(Coord_t const &coord) {
+    lampLightOff(coord, nullptr);
+}
+
+// Normal movement
+// When FIND_FLAG,  light only permanent features
+static void sub1MoveLight(Coord_t const &from, Coord_t const &to) {
+    bool was_lit = session->py.temporary_light_only;
+
+    if (session->py.temporary_light_only) {
+        if ((session->py.running_tracker != 0) && !session->options.run_print_self) {
+            session->py.temporary_light_only = false;
+        }
+    } else if ((session->py.running_tracker == 0) || session->options.run_print_self) {
+        session->py.temporary_light_only = true;
+    }
+
+    // Turn off the lamp light only where it no longer reaches
+    if (was_lit) {
+        lampLightOff(from, session->py.temporary_light_only ? &to : nullptr);
+    }
+
+    LightMask_t const &mask = light_masks.radius[LAMP_RADIUS];
+
+    for (int i = 0; i < mask.count; i++) {
+        Coord_t coord = Coord_t{to.y + mask.offsets[i].y, to.x + mask.offsets[i].x};
+
+        if (!lampReaches(to, coord)) {
+            continue;
+        }
+
+        playerTravelSeeTile(coord);
+
+        TileRef_t tile = session->dg.floor[coord.y][coord.x];
+        int old_state = tileLightState(tile);
+
+        // only light up if normal movement
+        if (session->py.temporary_light_only) {
+            tile.temporary_light = true;
+        }
+
+        if (tile.feature_id >= MIN_CAVE_WALL) {
+            tile.permanent_light = true;
+        } else if (!tile.field_mark && tile.treasure_id != 0) {
+            int tval = session->game.treasure.list[tile.treasure_id].category_id;
+
+            if (tval >= TV_MIN_VISIBLE && tval <= TV_MAX_VISIBLE) {
+                tile.field_mark = true;
+            }
+        }
+
+        // Only redraw the tiles that look different now
+        if (tileLightState(tile) != old_state) {
+            dungeonLiteSpot(coord);
+        }
+    }
+
+    // The player has moved from one to the other
+    dungeonLiteSpot(from);
+    dungeonLiteSpot(to);
+}
+
+// When blinded,  move only the player symbol.
+// With no light,  movement becomes involved.
+static void sub3MoveLight(Coord_t const &from, Coord_t const &to) {
+    if (session->py.temporary_light_only) {
+        lampLightOff(from, nullptr);
+        dungeonLiteSpot(from);
+
+        session->py.temporary_light_only = false;
+    } else if ((session->py.running_tracker == 0) || session->options.run_print_self) {
+        panelPutTile(caveGetTileSymbol(from), from);
+    }
+
+    if ((session->py.running_tracker == 0) || session->options.run_print_self) {
+        panelPutTile('@', to);
+    }
+}
+
+// Package for moving the character's light about the screen
+// Four cases : Normal, Finding, Blind, and No light -RAK-
+void dungeonMoveCharacterLight(Coord_t const &from, Coord_t const &to) {
+    if (session->py.flags.blind > 0 || !session->py.carrying_light) {
+        sub3MoveLight(from, to);
+    } else {
+        sub1MoveLight(from, to);
+    }
+}
@@ -40,7 +40,7 @@ bool los(Coord_t from, Coord_t to) {
         }
 
         for (int yy = from.y + 1; yy < to.y; yy++) {
-            if (dg.floor[yy][from.x].feature_id >= MIN_CLOSED_SPACE) {
+            if (session->dg.floor[yy][from.x].feature_id >= MIN_CLOSED_SPACE) {
                 return false;
             }
         }
@@ -56,7 +56,7 @@ bool los(Coord_t from, Coord_t to) {
         }
 
         for (int xx = from.x + 1; xx < to.x; xx++) {
-            if (dg.floor[from.y][xx].feature_id >= MIN_CLOSED_SPACE) {
+            if (session->dg.floor[from.y][xx].feature_id >= MIN_CLOSED_SPACE) {
                 return false;
             }
         }
@@ -109,7 +109,7 @@ bool los(Coord_t from, Coord_t to) {
             }
 
             while ((to.x - xx) != 0) {
-                if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+                if (session->dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
                     return false;
                 }
 
@@ -119,7 +119,7 @@ bool los(Coord_t from, Coord_t to) {
                     xx += x_sign;
                 } else if (dy > scale_half) {
                     yy += y_sign;
-                    if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+                    if (session->dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
                         return false;
                     }
                     xx += x_sign;
@@ -150,7 +150,7 @@ bool los(Coord_t from, Coord_t to) {
         }
 
         while ((to.y - yy) != 0) {
-            if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+            if (session->dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
                 return false;
             }
 
@@ -160,7 +160,7 @@ bool los(Coord_t from, Coord_t to) {
                 yy += y_sign;
             } else if (dx > scale_half) {
                 xx += x_sign;
-                if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+                if (session->dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
                     return false;
                 }
                 yy += y_sign;
@@ -208,26 +208,56 @@ bool los(Coord_t from, Coord_t to) {
          transparent, it would be visible.
        - Location 4 is completely obscured by a single #.
 
-  The function which does the work is lookRay(). It sets up its own co-ordinate
-  frame (global variables map back to the dungeon frame) and looks for
-  everything between two angles specified from a central line. It is recursive,
-  and each call looks at stuff visible along a line parallel to the center line,
-  and a set distance away from it. A diagonal look uses more extreme peripheral
-  vision from the closest horizontal and vertical directions; horizontal or
-  vertical looks take a call for each side of the central line.
+  The function which does the work is lookRow(). It works in its own co-ordinate
+  frame (a LookFrame_t maps back to the dungeon frame) and looks for everything
+  between two angles specified from a central line, along a line parallel to
+  the center line and a set distance away from it. Each window of visibility it
+  finds on that line is queued to be looked down on the next line out. A
+  diagonal look uses more extreme peripheral vision from the closest horizontal
+  and vertical directions; horizontal or vertical looks take a cone for each
+  side of the central line.
 
-  Globally accessed variables: los_num_places_seen counts the number of places where
-  something is seen. los_rocks_and_objects indicates a look for rock or objects.
+  Everything of interest is gathered in this one pass, and only then shown to
+  the player, nearest first.
 
-  The others map coords in the ray frame to dungeon coords.
+  The frame maps coords in the ray frame to dungeon coords.
 
-  dungeon y = py.pos.y + los_fyx * (ray x) + los_fyy * (ray y)
-  dungeon x = py.pos.x + los_fxx * (ray x) + los_fxy * (ray y)
+  dungeon y = py.pos.y + fyx * (ray x) + fyy * (ray y)
+  dungeon x = py.pos.x + fxx * (ray x) + fxy * (ray y)
 */
-static int los_fxx, los_fxy, los_fyx, los_fyy;
-static int los_num_places_seen;
-static bool los_hack_no_query;
-static int los_rocks_and_objects;
+typedef struct {
+    int fxx;
+    int fxy;
+    int fyx;
+    int fyy;
+} LookFrame_t;
+
+// A part of a line of view, between two angles, still to be looked down.
+typedef struct {
+    int y;
+    int from;
+    int to;
+} LookWindow_t;
+
+// A place which has something worth looking at.
+typedef struct {
+    Coord_t coord;
+    int distance;
+} LookPlace_t;
+
+// Looking never goes outside the current panel, which bounds everything.
+constexpr int LOOK_MAX_PLACES = SCREEN_HEIGHT * SCREEN_WIDTH;
+
+typedef struct {
+    bool visited[SCREEN_HEIGHT][SCREEN_WIDTH];
+    int count;
+    LookPlace_t places[LOOK_MAX_PLACES];
+} LookPlaces_t;
+
+typedef struct {
+    int count;
+    LookWindow_t windows[LOOK_MAX_PLACES];
+} LookWindows_t;
 
 // Intended to be indexed by dir/2, since is only
 // relevant to horizontal or vertical directions.
@@ -242,8 +272,8 @@ static int los_map_diagonals2[] = {2, 1, 0, 4, 3};
 
 #define GRADF 10000 // Any sufficiently big number will do
 
-static bool lookRay(int y, int from, int to);
-static bool lookSee(Coord_t coord, bool &transparent);
+static void lookFindPlaces(int dir, LookPlaces_t &found);
+static bool lookAtPlace(Coord_t coord, bool look_at_rocks, int &places_seen);
 
 // Look at what we can see. This is a free move.
 //
@@ -253,15 +283,15 @@ static bool lookSee(Coord_t coord, bool &transparent);
 // ESCAPE will abort the entire look.
 //
 // Looks first at real objects and monsters, and looks at rock types only after all
-// other things have been seen.  Only looks at rock types if the config::options::highlight_seams
+// other things have been seen.  Only looks at rock types if the session->options.highlight_seams
 // option is set.
 void look() {
-    if (py.flags.blind > 0) {
+    if (session->py.flags.blind > 0) {
         printMessage("You can't see a damn thing!");
         return;
     }
 
-    if (py.flags.image > 0) {
+    if (session->py.flags.image > 0) {
         printMessage("You can't believe what you are seeing! It's like a dream!");
         return;
     }
@@ -271,79 +301,33 @@ void look() {
         return;
     }
 
-    los_num_places_seen = 0;
-    los_rocks_and_objects = 0;
+    LookPlaces_t found{};
+    lookFindPlaces(dir, found);
 
-    // Have to set this up for the lookSee
-    los_hack_no_query = false;
+    int places_seen = 0;
+    bool abort = false;
 
-    bool dummy;
-    if (lookSee(Coord_t{0, 0}, dummy)) {
-        return;
-    }
+    for (int pass = 0; pass < 2 && !abort; pass++) {
+        bool look_at_rocks = pass == 1;
 
-    bool abort;
-    do {
-        abort = false;
-        if (dir == 5) {
-            for (int i = 1; i <= 4; i++) {
-                los_fxx = los_dir_set_fxx[i];
-                los_fyx = los_dir_set_fyx[i];
-                los_fxy = los_dir_set_fxy[i];
-                los_fyy = los_dir_set_fyy[i];
-                if (lookRay(0, 2 * GRADF - 1, 1)) {
-                    abort = true;
-                    break;
-                }
-                los_fxy = -los_fxy;
-                los_fyy = -los_fyy;
-                if (lookRay(0, 2 * GRADF, 2)) {
-                    abort = true;
-                    break;
-                }
-            }
-        } else if ((dir & 1) == 0) {
-            // Straight directions
-
-            int i = dir >> 1;
-            los_fxx = los_dir_set_fxx[i];
-            los_fyx = los_dir_set_fyx[i];
-            los_fxy = los_dir_set_fxy[i];
-            los_fyy = los_dir_set_fyy[i];
-            if (lookRay(0, GRADF, 1)) {
-                abort = true;
-            } else {
-                los_fxy = -los_fxy;
-                los_fyy = -los_fyy;
-                abort = lookRay(0, GRADF, 2);
-            }
-        } else {
-            int i = los_map_diagonals1[dir >> 1];
-            los_fxx = los_dir_set_fxx[i];
-            los_fyx = los_dir_set_fyx[i];
-            los_fxy = -los_dir_set_fxy[i];
-            los_fyy = -los_dir_set_fyy[i];
-            if (lookRay(1, 2 * GRADF, GRADF)) {
+        if (look_at_rocks && !session->options.highlight_seams) {
+            break;
+        }
+
+        for (int i = 0; i < found.count; i++) {
+            if (lookAtPlace(found.places[i].coord, look_at_rocks, places_seen)) {
                 abort = true;
-            } else {
-                i = los_map_diagonals2[dir >> 1];
-                los_fxx = los_dir_set_fxx[i];
-                los_fyx = los_dir_set_fyx[i];
-                los_fxy = los_dir_set_fxy[i];
-                los_fyy = los_dir_set_fyy[i];
-                abort = lookRay(1, 2 * GRADF - 1, GRADF);
+                break;
             }
         }
-
-        los_rocks_and_objects++;
-    } while (!abort && config::options::highlight_seams && (los_rocks_and_objects < 2));
+    }
 
     if (abort) {
         printMessage("--Aborting look--");
         return;
     }
 
-    if (los_num_places_seen != 0) {
+    if (places_seen != 0) {
         if (dir == 5) {
             printMessage("That's all you see.");
         } else {
@@ -356,9 +340,55 @@ void look() {
     }
 }
 
+// Could looking at this place show the player anything?
+static bool lookPlaceIsInteresting(Coord_t const &coord) {
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+
+    if (tile.creature_id > 1 && session->monsters[tile.creature_id].lit) {
+        return true;
+    }
+
+    if (!tile.temporary_light && !tile.permanent_light && !tile.field_mark) {
+        return false;
+    }
+
+    if (tile.treasure_id != 0) {
+        uint8_t category_id = session->game.treasure.list[tile.treasure_id].category_id;
+        return category_id != TV_SECRET_DOOR && category_id != TV_INVIS_TRAP;
+    }
+
+    return tile.feature_id == TILE_MAGMA_WALL || tile.feature_id == TILE_QUARTZ_WALL;
+}
+
+// Note a place seen while looking, and return whether it can be seen through.
+static bool lookSee(LookFrame_t const &frame, LookPlaces_t &found, Coord_t coord) {
+    int x = session->py.pos.x + frame.fxx * coord.x + frame.fxy * coord.y;
+    coord.y = session->py.pos.y + frame.fyx * coord.x + frame.fyy * coord.y;
+    coord.x = x;
+
+    if (!coordInsidePanel(coord)) {
+        return false;
+    }
+
+    // Cones overlap along their edges, so only list each place once.
+    bool &visited = found.visited[coord.y - session->dg.panel.top][coord.x - session->dg.panel.left];
+
+    if (!visited) {
+        visited = true;
+
+        if (lookPlaceIsInteresting(coord)) {
+            found.places[found.count].coord = coord;
+            found.places[found.count].distance = coordDistanceBetween(session->py.pos, coord);
+            found.count++;
+        }
+    }
+
+    return session->dg.floor[coord.y][coord.x].feature_id <= MAX_OPEN_SPACE;
+}
+
 // Look at everything within a cone of vision between two ray lines emanating
-// from  the player, and y or more places away from the direct line of view.
-// This is recursive.
+// from  the player, on the line y places away from the direct line of view.
+// The windows of visibility found on this line are left to be looked down.
 //
 // Rays are specified by gradients, y over x, multiplied by 2*GRADF. This is ONLY
 // called with gradients between 2*GRADF (45 degrees) and 1 (almost horizontal).
@@ -367,16 +397,20 @@ void look() {
 //     ^    /      ___ angle to
 //     |   /   ___
 //  ...|../.....___.................... parameter y (look at things in the
-//     | /   ___                        cone, and on or above this line)
+//     | /   ___                        cone, and on this line)
 //     |/ ___
 //     @-------------------->   direction in which you are looking. (x axis)
 //     |
 //     |
-static bool lookRay(int y, int from, int to) {
+static void lookRow(LookFrame_t const &frame, LookPlaces_t &found, LookWindows_t &pending, LookWindow_t window) {
+    int y = window.y;
+    int from = window.from;
+    int to = window.to;
+
     // from is the larger angle of the ray, since we scan towards the
     // center line. If from is smaller, then the ray does not exist.
     if (from <= to || y > config::monsters::MON_MAX_SIGHT) {
-        return false;
+        return;
     }
 
     // Find first visible location along this line. Minimum x such
@@ -395,24 +429,10 @@ static bool lookRay(int y, int from, int to) {
         max_x = config::monsters::MON_MAX_SIGHT;
     }
     if (max_x < x) {
-        return false;
-    }
-
-    // los_hack_no_query is a HACK to prevent doubling up on direct lines of
-    // sight. If 'to' is  greater than 1, we do not really look at
-    // stuff along the direct line of sight, but we do have to see
-    // what is opaque for the purposes of obscuring other objects.
-    los_hack_no_query = (y == 0 && to > 1) || (y == x && from < GRADF * 2);
-
-    bool transparent;
-
-    if (lookSee(Coord_t{y, x}, transparent)) {
-        return true;
+        return;
     }
 
-    if (y == x) {
-        los_hack_no_query = false;
-    }
+    bool transparent = lookSee(frame, found, Coord_t{y, x});
 
     if (transparent) {
         goto init_transparent;
@@ -420,28 +440,24 @@ static bool lookRay(int y, int from, int to) {
 
     while (true) {
         // Look down the window we've found.
-        if (lookRay(y + 1, from, ((2 * y + 1) * (int32_t) GRADF / x))) {
-            return true;
-        }
+        pending.windows[pending.count++] = LookWindow_t{y + 1, from, (int) ((2 * y + 1) * (int32_t) GRADF / x)};
 
         // Find the start of next window.
         do {
             if (x == max_x) {
-                return false;
+                return;
             }
 
             // See if this seals off the scan. (If y is zero, then it will.)
             from = ((2 * y - 1) * (int32_t) GRADF / x);
 
             if (from <= to) {
-                return false;
+                return;
             }
 
             x++;
 
-            if (lookSee(Coord_t{y, x}, transparent)) {
-                return true;
-            }
+            transparent = lookSee(frame, found, Coord_t{y, x});
         } while (!transparent);
 
     init_transparent:
@@ -450,53 +466,97 @@ static bool lookRay(int y, int from, int to) {
         do {
             if (x == max_x) {
                 // The window is trimmed by an earlier limit.
-                return lookRay(y + 1, from, to);
+                pending.windows[pending.count++] = LookWindow_t{y + 1, from, to};
+                return;
             }
 
             x++;
 
-            if (lookSee(Coord_t{y, x}, transparent)) {
-                return true;
-            }
+            transparent = lookSee(frame, found, Coord_t{y, x});
         } while (transparent);
     }
 }
 
-static bool lookSee(Coord_t coord, bool &transparent) {
-    if (coord.x < 0 || coord.y < 0 || coord.y > coord.x) {
-        obj_desc_t error_message = {'\0'};
-        (void) sprintf(error_message, "Illegal call to lookSee(%d, %d)", coord.y, coord.x);
-        printMessage(error_message);
+// Look over a whole cone, one line and window at a time.
+static void lookCone(LookFrame_t const &frame, LookPlaces_t &found, LookWindow_t window) {
+    LookWindows_t pending{};
+    pending.windows[pending.count++] = window;
+
+    while (pending.count > 0) {
+        pending.count--;
+        lookRow(frame, found, pending, pending.windows[pending.count]);
     }
+}
 
-    const char *description = nullptr;
-    if (coord.x == 0 && coord.y == 0) {
-        description = "You are on";
-    } else {
-        description = "You see";
+static LookFrame_t lookFrame(int i, bool mirrored) {
+    LookFrame_t frame{los_dir_set_fxx[i], los_dir_set_fxy[i], los_dir_set_fyx[i], los_dir_set_fyy[i]};
+
+    if (mirrored) {
+        frame.fxy = -frame.fxy;
+        frame.fyy = -frame.fyy;
     }
 
-    int j = py.pos.x + los_fxx * coord.x + los_fxy * coord.y;
-    coord.y = py.pos.y + los_fyx * coord.x + los_fyy * coord.y;
-    coord.x = j;
+    return frame;
+}
 
-    if (!coordInsidePanel(coord)) {
-        transparent = false;
-        return false;
+// Find every place worth looking at in the given direction, with the
+// player's own place first, and the rest nearest first.
+static void lookFindPlaces(int dir, LookPlaces_t &found) {
+    found.count = 0;
+
+    if (lookPlaceIsInteresting(session->py.pos)) {
+        found.places[found.count].coord = session->py.pos;
+        found.places[found.count].distance = 0;
+        found.count++;
+    }
+    found.visited[session->py.pos.y - session->dg.panel.top][session->py.pos.x - session->dg.panel.left] = true;
+
+    if (dir == 5) {
+        for (int i = 1; i <= 4; i++) {
+            lookCone(lookFrame(i, false), found, LookWindow_t{0, 2 * GRADF - 1, 1});
+            lookCone(lookFrame(i, true), found, LookWindow_t{0, 2 * GRADF, 2});
+        }
+    } else if ((dir & 1) == 0) {
+        // Straight directions
+
+        int i = dir >> 1;
+        lookCone(lookFrame(i, false), found, LookWindow_t{0, GRADF, 1});
+        lookCone(lookFrame(i, true), found, LookWindow_t{0, GRADF, 2});
+    } else {
+        lookCone(lookFrame(los_map_diagonals1[dir >> 1], true), found, LookWindow_t{1, 2 * GRADF, GRADF});
+        lookCone(lookFrame(los_map_diagonals2[dir >> 1], false), found, LookWindow_t{1, 2 * GRADF - 1, GRADF});
     }
 
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
-    transparent = tile.feature_id <= MAX_OPEN_SPACE;
+    // Insertion sort, so places at the same distance keep the order they were seen in
+    for (int i = 1; i < found.count; i++) {
+        LookPlace_t place = found.places[i];
+
+        int j = i;
+        while (j > 0 && found.places[j - 1].distance > place.distance) {
+            found.places[j] = found.places[j - 1];
+            j--;
+        }
+        found.places[j] = place;
+    }
+}
 
-    if (los_hack_no_query) {
-        return false; // Don't look at a direct line of sight. A hack.
+// Describe what is at a place, waiting for a key after each description.
+// Returns true if the player aborted the look with ESCAPE.
+static bool lookAtPlace(Coord_t coord, bool look_at_rocks, int &places_seen) {
+    const char *description = nullptr;
+    if (coord.y == session->py.pos.y && coord.x == session->py.pos.x) {
+        description = "You are on";
+    } else {
+        description = "You see";
     }
 
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+
     char key = ESCAPE;
     obj_desc_t msg = {'\0'};
 
-    if (los_rocks_and_objects == 0 && tile.creature_id > 1 && monsters[tile.creature_id].lit) {
-        j = monsters[tile.creature_id].creature_id;
+    if (!look_at_rocks && tile.creature_id > 1 && session->monsters[tile.creature_id].lit) {
+        int j = session->monsters[tile.creature_id].creature_id;
         (void) sprintf(msg, "%s %s %s. [(r)ecall]", description, isVowel(creatures_list[j].name[0]) ? "an" : "a", creatures_list[j].name);
         description = "It is on";
         putStringClearToEOL(msg, Coord_t{0, 0});
@@ -515,13 +575,13 @@ static bool lookSee(Coord_t coord, bool &transparent) {
         const char *wall_description;
 
         if (tile.treasure_id != 0) {
-            if (game.treasure.list[tile.treasure_id].category_id == TV_SECRET_DOOR) {
+            if (session->game.treasure.list[tile.treasure_id].category_id == TV_SECRET_DOOR) {
                 goto granite;
             }
 
-            if (los_rocks_and_objects == 0 && game.treasure.list[tile.treasure_id].category_id != TV_INVIS_TRAP) {
+            if (!look_at_rocks && session->game.treasure.list[tile.treasure_id].category_id != TV_INVIS_TRAP) {
                 obj_desc_t obj_string = {'\0'};
-                itemDescription(obj_string, game.treasure.list[tile.treasure_id], true);
+                itemDescription(obj_string, session->game.treasure.list[tile.treasure_id], true);
 
                 (void) sprintf(msg, "%s %s ---pause---", description, obj_string);
                 description = "It is in";
@@ -532,7 +592,7 @@ static bool lookSee(Coord_t coord, bool &transparent) {
             }
         }
 
-        if (((los_rocks_and_objects != 0) || (msg[0] != 0)) && tile.feature_id >= MIN_CLOSED_SPACE) {
+        if ((look_at_rocks || (msg[0] != 0)) && tile.feature_id >= MIN_CLOSED_SPACE) {
             switch (tile.feature_id) {
                 case TILE_BOUNDARY_WALL:
                 case TILE_GRANITE_WALL:
@@ -565,7 +625,7 @@ static bool lookSee(Coord_t coord, bool &transparent) {
     }
 
     if (msg[0] != 0) {
-        los_num_places_seen++;
+        places_seen++;
         if (key == ESCAPE) {
             return true;
         }
@@ -17,6 +17,93 @@ typedef struct {
     bool temporary_light : 1; // Temporary light, used for player's lamp light,etc.
 } Tile_t;
 
+// Whole map passes (object compaction, detection spells, the map display)
+// read every tile, so keep them packed: the full dungeon is only ~52KB.
+static_assert(sizeof(Tile_t) == 4, "Tile_t should stay four bytes");
+
+// Code reaches the tiles of the map through `session->dg.floor[y][x]`,
+// holding on to one with a TileRef_t. When built with TILE_PLANES the
+// fields are kept in separate planes instead (see TilePlanes_t), so that a
+// pass over the whole map reading a single field only touches its plane.
+#ifndef TILE_PLANES
+
+typedef Tile_t &TileRef_t;
+typedef Tile_t const &TileConstRef_t;
+
+#else
+
+// Bits of the flags plane
+constexpr uint8_t TILE_PERMA_LIT_ROOM = 1u << 0u;
+constexpr uint8_t TILE_FIELD_MARK = 1u << 1u;
+constexpr uint8_t TILE_PERMANENT_LIGHT = 1u << 2u;
+constexpr uint8_t TILE_TEMPORARY_LIGHT = 1u << 3u;
+
+// A field of a tile kept in its own plane
+class TileByte_t {
+  public:
+    explicit TileByte_t(uint8_t &value) : byte(value) {}
+    TileByte_t(TileByte_t const &other) = default;
+
+    TileByte_t &operator=(TileByte_t const &other) {
+        byte = other.byte;
+        return *this;
+    }
+
+    TileByte_t &operator=(uint8_t value) {
+        byte = value;
+        return *this;
+    }
+
+    operator uint8_t() const { return byte; }
+
+  private:
+    uint8_t &byte;
+};
+
+// A flag of a tile kept in the flags plane
+template <uint8_t FLAG>
+class TileFlag_t {
+  public:
+    explicit TileFlag_t(uint8_t &value) : flags(value) {}
+    TileFlag_t(TileFlag_t const &other) = default;
+
+    TileFlag_t &operator=(TileFlag_t const &other) { return *this = (bool) other; }
+
+    TileFlag_t &operator=(bool value) {
+        if (value) {
+            flags |= FLAG;
+        } else {
+            flags &= (uint8_t) ~FLAG;
+        }
+        return *this;
+    }
+
+    operator bool() const { return (flags & FLAG) != 0; }
+
+  private:
+    uint8_t &flags;
+};
+
+// A tile of the planes, with the same fields as Tile_t
+class TileRef_t {
+  public:
+    TileRef_t(uint8_t &creature, uint8_t &treasure, uint8_t &feature, uint8_t &flags)
+        : creature_id(creature), treasure_id(treasure), feature_id(feature), perma_lit_room(flags), field_mark(flags), permanent_light(flags), temporary_light(flags) {}
+
+    TileByte_t creature_id;
+    TileByte_t treasure_id;
+    TileByte_t feature_id;
+
+    TileFlag_t<TILE_PERMA_LIT_ROOM> perma_lit_room;
+    TileFlag_t<TILE_FIELD_MARK> field_mark;
+    TileFlag_t<TILE_PERMANENT_LIGHT> permanent_light;
+    TileFlag_t<TILE_TEMPORARY_LIGHT> temporary_light;
+};
+
+typedef TileRef_t const TileConstRef_t;
+
+#endif
+
 // `fval` definitions: these describe the various types of dungeon floors and
 // walls, if numbers above 15 are ever used, then the test against MIN_CAVE_WALL
 // will have to be changed, also the save routines will have to be changed.
@@ -9,9 +9,8 @@
 #include "version.h"
 
 // holds the previous rnd state
-static uint32_t old_seed;
+static thread_local RandomState_t old_state;
 
-Game_t game = Game_t{};
 
 // gets a new random seed for the random number generator
 void seedsInitialize(uint32_t seed) {
@@ -23,10 +22,10 @@ void seedsInitialize(uint32_t seed) {
         clock_var = seed;
     }
 
-    game.magic_seed = (int32_t) clock_var;
+    session->game.magic_seed = (int32_t) clock_var;
 
     clock_var += 8762;
-    game.town_seed = (int32_t) clock_var;
+    session->game.town_seed = (int32_t) clock_var;
 
     clock_var += 113452L;
     setRandomSeed(clock_var);
@@ -39,7 +38,7 @@ void seedsInitialize(uint32_t seed) {
 
 // change to different random number generator state
 void seedSet(uint32_t seed) {
-    old_seed = getRandomSeed();
+    old_state = getRandomState();
 
     // want reproducible state here
     setRandomSeed(seed);
@@ -47,7 +46,14 @@ void seedSet(uint32_t seed) {
 
 // restore the normal random generator state
 void seedResetToOldSeed() {
-    setRandomSeed(old_seed);
+    if (getRandomEngine() == RandomEngine::ParkMiller) {
+        // Moria has always restored by reseeding, which also steps the
+        // seed on by one, keep doing so to give the same game sequences.
+        setRandomSeed(old_state.s[0]);
+        return;
+    }
+
+    setRandomState(old_state);
 }
 
 // Generates a random integer x where 1<=X<=MAXVAL -RAK-
@@ -78,30 +84,7 @@ int randomNumberNormalDistribution(int mean, int standard) {
         return mean + offset;
     }
 
-    // binary search normal normal_table to get index that
-    // matches tmp this takes up to 8 iterations.
-    int low = 0;
-    int iindex = NORMAL_TABLE_SIZE >> 1;
-    int high = NORMAL_TABLE_SIZE;
-
-    while (true) {
-        if (normal_table[iindex] == tmp || high == low + 1) {
-            break;
-        }
-
-        if (normal_table[iindex] > tmp) {
-            high = iindex;
-            iindex = low + ((iindex - low) >> 1);
-        } else {
-            low = iindex;
-            iindex = iindex + ((high - iindex) >> 1);
-        }
-    }
-
-    // might end up one below target, check that here
-    if (normal_table[iindex] < tmp) {
-        iindex = iindex + 1;
-    }
+    int iindex = normal_table_lookup[tmp];
 
     // normal_table is based on SD of 64, so adjust the
     // index value here, round the half way case up.
@@ -117,30 +100,30 @@ int randomNumberNormalDistribution(int mean, int standard) {
 
 static struct {
     const char *o_prompt;
-    bool *o_var;
+    bool Options_t::*o_var;
 } game_options[] = {
-    {"Running: cut known corners", &config::options::run_cut_corners},
-    {"Running: examine potential corners", &config::options::run_examine_corners},
-    {"Running: print self during run", &config::options::run_print_self},
-    {"Running: stop when map sector changes", &config::options::find_bound},
-    {"Running: run through open doors", &config::options::run_ignore_doors},
-    {"Prompt to pick up objects", &config::options::prompt_to_pickup},
-    {"Rogue like commands", &config::options::use_roguelike_keys},
-    {"Show weights in inventory", &config::options::show_inventory_weights},
-    {"Highlight and notice mineral seams", &config::options::highlight_seams},
-    {"Beep for invalid character", &config::options::error_beep_sound},
-    {"Display rest/repeat counts", &config::options::display_counts},
+    {"Running: cut known corners", &Options_t::run_cut_corners},
+    {"Running: examine potential corners", &Options_t::run_examine_corners},
+    {"Running: print self during run", &Options_t::run_print_self},
+    {"Running: stop when map sector changes", &Options_t::find_bound},
+    {"Running: run through open doors", &Options_t::run_ignore_doors},
+    {"Prompt to pick up objects", &Options_t::prompt_to_pickup},
+    {"Rogue like commands", &Options_t::use_roguelike_keys},
+    {"Show weights in inventory", &Options_t::show_inventory_weights},
+    {"Highlight and notice mineral seams", &Options_t::highlight_seams},
+    {"Beep for invalid character", &Options_t::error_beep_sound},
+    {"Display rest/repeat counts", &Options_t::display_counts},
     {nullptr, nullptr},
 };
 
-// Set or unset various boolean config::options::display_counts -CJS-
+// Set or unset various boolean options -CJS-
 void setGameOptions() {
     putStringClearToEOL("  ESC when finished, y/n to set options, <return> or - to move cursor", Coord_t{0, 0});
 
     int max;
     for (max = 0; game_options[max].o_prompt != nullptr; max++) {
         vtype_t str = {'\0'};
-        (void) sprintf(str, "%-38s: %s", game_options[max].o_prompt, (*game_options[max].o_var ? "yes" : "no "));
+        (void) sprintf(str, "%-38s: %s", game_options[max].o_prompt, (session->options.*game_options[max].o_var ? "yes" : "no "));
         putStringClearToEOL(str, Coord_t{max + 1, 0});
     }
     eraseLine(Coord_t{max + 1, 0});
@@ -172,7 +155,7 @@ void setGameOptions() {
             case 'Y':
                 putString("yes", Coord_t{option_id + 1, 40});
 
-                *game_options[option_id].o_var = true;
+                session->options.*game_options[option_id].o_var = true;
 
                 if (option_id + 1 < max) {
                     option_id++;
@@ -184,7 +167,7 @@ void setGameOptions() {
             case 'N':
                 putString("no ", Coord_t{option_id + 1, 40});
 
-                *game_options[option_id].o_var = false;
+                session->options.*game_options[option_id].o_var = false;
 
                 if (option_id + 1 < max) {
                     option_id++;
@@ -261,8 +244,8 @@ static char mapRoguelikeKeysToKeypad(char command) {
 // Direction memory added, for repeated commands.  -CJS
 bool getDirectionWithMemory(char *prompt, int &direction) {
     // used in counted commands. -CJS-
-    if (game.use_last_direction) {
-        direction = py.prev_dir;
+    if (session->game.use_last_direction) {
+        direction = session->py.prev_dir;
         return true;
     }
 
@@ -274,20 +257,20 @@ bool getDirectionWithMemory(char *prompt, int &direction) {
 
     while (true) {
         // Don't end a counted command. -CJS-
-        int oldCount = game.command_count;
+        int oldCount = session->game.command_count;
         if (!getCommand(prompt, command)) {
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             return false;
         }
-        game.command_count = oldCount;
+        session->game.command_count = oldCount;
 
-        if (config::options::use_roguelike_keys) {
+        if (session->options.use_roguelike_keys) {
             command = mapRoguelikeKeysToKeypad(command);
         }
 
         if (command >= '1' && command <= '9' && command != '5') {
-            py.prev_dir = command - '0';
-            direction = py.prev_dir;
+            session->py.prev_dir = command - '0';
+            direction = session->py.prev_dir;
             return true;
         }
 
@@ -302,11 +285,11 @@ bool getAllDirections(const char *prompt, int &direction) {
 
     while (true) {
         if (!getCommand(prompt, command)) {
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             return false;
         }
 
-        if (config::options::use_roguelike_keys) {
+        if (session->options.use_roguelike_keys) {
             command = mapRoguelikeKeysToKeypad(command);
         }
 
@@ -319,10 +302,21 @@ bool getAllDirections(const char *prompt, int &direction) {
     }
 }
 
+// Ends the game played over a connection, leaving the other
+// games in the process to carry on. See server.cpp.
+static void hangUpLink() {
+    TerminalLink_t const *link = session->terminal_link;
+    if (link != nullptr) {
+        link->hang_up(link->context);
+    }
+}
+
 // Restore the terminal and exit
 void exitProgram() {
     flushInputBuffer();
     terminalRestore();
+    hangUpLink();
+    recordingFinishAll();
     exit(0);
 }
 
@@ -334,5 +328,7 @@ void abortProgram(const char *msg) {
     printf("Program was manually aborted with the message:\n");
     printf("%s\n", msg);
 
+    hangUpLink();
+    recordingFinishAll();
     exit(0);
 }
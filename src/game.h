@@ -71,11 +71,24 @@ typedef struct Game_t {
     } screen;
 } Game_t;
 
-extern Game_t game;
+extern int16_t const (&sorted_objects)[MAX_DUNGEON_OBJECTS];
+extern uint16_t const normal_table[NORMAL_TABLE_SIZE];
+extern uint8_t const (&normal_table_lookup)[SHRT_MAX];
+extern int16_t const (&treasure_levels)[TREASURE_MAX_LEVELS + 1];
 
-extern int16_t sorted_objects[MAX_DUNGEON_OBJECTS];
-extern uint16_t normal_table[NORMAL_TABLE_SIZE];
-extern int16_t treasure_levels[TREASURE_MAX_LEVELS + 1];
+// Alias tables over the sorted objects for each dungeon level, one for all
+// objects and one for only those that fit in a chest. Column `c` is object
+// `c` itself with a chance of `threshold[c] / OBJECT_SAMPLER_SCALE`, or else
+// object `alias[c]`.
+constexpr int32_t OBJECT_SAMPLER_SCALE = 1L << 30;
+
+typedef struct {
+    int32_t threshold[MAX_DUNGEON_OBJECTS];
+    int16_t alias[MAX_DUNGEON_OBJECTS];
+} ObjectSampler_t;
+
+extern ObjectSampler_t const (&object_samplers)[TREASURE_MAX_LEVELS + 1];
+extern ObjectSampler_t const (&small_object_samplers)[TREASURE_MAX_LEVELS + 1];
 
 void seedsInitialize(uint32_t seed);
 void seedSet(uint32_t seed);
@@ -98,8 +111,19 @@ int popt();
 void pusht(uint8_t treasure_id);
 int itemGetRandomObjectId(int level, bool must_be_small);
 
+// A data file built into the executable, see CMakeLists.txt
+typedef struct {
+    const char *name;
+    const unsigned char *data;
+    size_t size;
+} EmbeddedFile_t;
+
+extern EmbeddedFile_t const embedded_files[];
+extern size_t const embedded_files_count;
+
 // game files
 bool initializeScoreFile();
+void initializeTextFiles();
 void displaySplashScreen();
 void displayTextHelpFile(const std::string &filename);
 void displayDeathFile(const std::string &filename);
@@ -110,10 +134,27 @@ bool outputPlayerCharacterToFile(char *filename);
 void endGame();
 
 // save/load
+
+// Who a save file is for, read from its preview section alone
+typedef struct SavePreview_t {
+    std::string name{};
+    uint8_t race_id = 0;
+    uint8_t class_id = 0;
+    uint16_t level = 0;
+    uint16_t dungeon_depth = 0;
+    int32_t game_turn = 0;
+    bool dead = false;
+    bool total_winner = false;
+} SavePreview_t;
+
 bool saveGame();
 bool loadGame(bool &generate);
+bool readSavePreview(std::string const &filename, SavePreview_t &preview);
 void setFileptr(FILE *file);
 
 // game_run.cpp
 // (includes the playDungeon() main game loop)
+void startupTimerStart();
+void startupTimerStop();
+void startupTimerReport();
 void startMoria(int seed, bool start_new_game);
@@ -13,18 +13,18 @@ static void printTomb() {
 
     std::string text;
 
-    text = std::string(py.misc.name);
+    text = std::string(session->py.misc.name);
     putString(text.c_str(), Coord_t{6, (int) (26 - text.length() / 2)});
 
-    if (!game.total_winner) {
+    if (!session->game.total_winner) {
         text = playerRankTitle();
     } else {
         text = "Magnificent";
     }
     putString(text.c_str(), Coord_t{8, (int) (26 - text.length() / 2)});
 
-    if (!game.total_winner) {
-        text = classes[py.misc.class_id].title;
+    if (!session->game.total_winner) {
+        text = classes[session->py.misc.class_id].title;
     } else if (playerIsMale()) {
         text = "*King*";
     } else {
@@ -32,19 +32,19 @@ static void printTomb() {
     }
     putString(text.c_str(), Coord_t{10, (int) (26 - text.length() / 2)});
 
-    text = std::to_string(py.misc.level);
+    text = std::to_string(session->py.misc.level);
     putString(text.c_str(), Coord_t{11, 30});
 
-    text = std::to_string(py.misc.exp) + " Exp";
+    text = std::to_string(session->py.misc.exp) + " Exp";
     putString(text.c_str(), Coord_t{12, (int) (26 - text.length() / 2)});
 
-    text = std::to_string(py.misc.au) + " Au";
+    text = std::to_string(session->py.misc.au) + " Au";
     putString(text.c_str(), Coord_t{13, (int) (26 - text.length() / 2)});
 
-    text = std::to_string(dg.current_level);
+    text = std::to_string(session->dg.current_level);
     putString(text.c_str(), Coord_t{14, 34});
 
-    text = std::string(game.character_died_from);
+    text = std::string(session->game.character_died_from);
     putString(text.c_str(), Coord_t{16, (int) (26 - text.length() / 2)});
 
     char day[11];
@@ -55,12 +55,19 @@ static void printTomb() {
 retry:
     flushInputBuffer();
 
-    putString("(ESC to abort, return to print on screen, or file name)", Coord_t{23, 0});
+    // Someone playing over a connection has no say in the server's files
+    bool can_file = session->terminal_link == nullptr;
+
+    if (can_file) {
+        putString("(ESC to abort, return to print on screen, or file name)", Coord_t{23, 0});
+    } else {
+        putString("(ESC to abort, or return to print on screen)", Coord_t{23, 0});
+    }
     putString("Character record?", Coord_t{22, 0});
 
     vtype_t str = {'\0'};
-    if (getStringInput(str, Coord_t{22, 18}, 60)) {
-        for (auto &item : py.inventory) {
+    if (getStringInput(str, Coord_t{22, 18}, can_file ? 60 : 0)) {
+        for (auto &item : session->py.inventory) {
             itemSetAsIdentified(item.category_id, item.sub_category_id);
             spellItemIdentifyAndRemoveRandomInscription(item);
         }
@@ -82,7 +89,7 @@ retry:
                 printMessage(CNIL);
                 printMessage("You are carrying:");
                 clearToBottom(1);
-                (void) displayInventoryItems(0, py.pack.unique_items - 1, true, 0, CNIL);
+                (void) displayInventoryItems(0, session->py.pack.unique_items - 1, true, 0, CNIL);
                 printMessage(CNIL);
             }
         }
@@ -104,15 +111,15 @@ static void printCrown() {
 // Change the player into a King! -RAK-
 static void kingly() {
     // Change the character attributes.
-    dg.current_level = 0;
-    (void) strcpy(game.character_died_from, "Ripe Old Age");
+    session->dg.current_level = 0;
+    (void) strcpy(session->game.character_died_from, "Ripe Old Age");
 
     (void) spellRestorePlayerLevels();
 
-    py.misc.level += PLAYER_MAX_LEVEL;
-    py.misc.au += 250000L;
-    py.misc.max_exp += 5000000L;
-    py.misc.exp = py.misc.max_exp;
+    session->py.misc.level += PLAYER_MAX_LEVEL;
+    session->py.misc.au += 250000L;
+    session->py.misc.max_exp += 5000000L;
+    session->py.misc.exp = session->py.misc.max_exp;
 
     printCrown();
 }
@@ -127,24 +134,24 @@ void endGame() {
 
     // If the game has been saved, then save sets turn back to -1,
     // which inhibits the printing of the tomb.
-    if (dg.game_turn >= 0) {
-        if (game.total_winner) {
+    if (session->dg.game_turn >= 0) {
+        if (session->game.total_winner) {
             kingly();
         }
         printTomb();
     }
 
     // Save the memory at least.
-    if (game.character_generated && !game.character_saved) {
+    if (session->game.character_generated && !session->game.character_saved) {
         (void) saveGame();
     }
 
     // add score to score file if applicable
-    if (game.character_generated) {
+    if (session->game.character_generated) {
         // Clear `game.character_saved`, strange thing to do, but it prevents
         // getKeyInput() from recursively calling endGame() when there has
         // been an eof on stdin detected.
-        game.character_saved = false;
+        session->game.character_saved = false;
         recordNewHighScore();
         showScoresScreen();
     }
@@ -7,6 +7,8 @@
 
 #include "headers.h"
 
+#include <map>
+
 // This must be included after fcntl.h, which has a prototype for `open' on some
 // systems.  Otherwise, the `open' prototype conflicts with the `topen' declaration.
 
@@ -21,27 +23,135 @@ bool initializeScoreFile() {
     return highscore_fp != nullptr;
 }
 
+// The text files shown by the game are read once, before the game starts,
+// and every page is then shown from memory, so a missing or slow data
+// directory can't hold up the screen, and the games of a server share the
+// one copy. Built with EMBED_DATA_FILES, the files are part of the
+// executable and never read at all, see CMakeLists.txt.
+typedef struct {
+    const char *text;
+    size_t length;
+} TextFile_t;
+
+static std::map<std::string, TextFile_t> text_files;
+
+// Reads through a text file as fgets() and feof() would a FILE
+typedef struct {
+    TextFile_t const *file;
+    size_t position;
+    bool at_end;
+} TextFileReader_t;
+
+#ifndef EMBED_DATA_FILES
+static std::map<std::string, std::string> text_file_contents;
+
+static bool readTextFile(const std::string &filename, std::string &contents) {
+    FILE *file = fopen(filename.c_str(), "r");
+    if (file == nullptr) {
+        return false;
+    }
+
+    char buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.append(buffer, length);
+    }
+
+    bool ok = ferror(file) == 0;
+    (void) fclose(file);
+
+    return ok;
+}
+#endif
+
+// Gets the text files ready to be shown. A file that can't be read is
+// left out, and reported as missing when it is asked for.
+void initializeTextFiles() {
+#ifdef EMBED_DATA_FILES
+    for (size_t i = 0; i < embedded_files_count; i++) {
+        EmbeddedFile_t const &file = embedded_files[i];
+        text_files[file.name] = TextFile_t{(const char *) file.data, file.size};
+    }
+#else
+    std::string const *filenames[] = {
+        &config::files::splash_screen,
+        &config::files::welcome_screen,
+        &config::files::license,
+        &config::files::versions_history,
+        &config::files::help,
+        &config::files::help_wizard,
+        &config::files::help_roguelike,
+        &config::files::help_roguelike_wizard,
+        &config::files::death_tomb,
+        &config::files::death_royal,
+    };
+
+    for (auto const *filename : filenames) {
+        std::string contents;
+        if (!readTextFile(*filename, contents)) {
+            continue;
+        }
+
+        std::string const &stored = text_file_contents[*filename] = std::move(contents);
+        text_files[*filename] = TextFile_t{stored.data(), stored.size()};
+    }
+#endif
+}
+
+static bool openTextFile(const std::string &filename, TextFileReader_t &reader) {
+    auto found = text_files.find(filename);
+    if (found == text_files.end()) {
+        return false;
+    }
+
+    reader = TextFileReader_t{&found->second, 0, false};
+    return true;
+}
+
+// Reads up to `size - 1` characters into `buffer`, stopping after a newline.
+// Returns false at the end of the text, which is only noticed by a read.
+static bool textFileGetLine(TextFileReader_t &reader, char *buffer, int size) {
+    TextFile_t const &file = *reader.file;
+
+    int length = 0;
+    while (length < size - 1) {
+        if (reader.position == file.length) {
+            reader.at_end = true;
+            break;
+        }
+
+        char ch = file.text[reader.position++];
+        buffer[length++] = ch;
+
+        if (ch == '\n') {
+            break;
+        }
+    }
+    buffer[length] = '\0';
+
+    return length > 0;
+}
+
 // Attempt to open and print the file containing the intro splash screen text -RAK-
 void displaySplashScreen() {
     vtype_t in_line = {'\0'};
 
-    FILE *screen_file = fopen(config::files::splash_screen.c_str(), "r");
-    if (screen_file != nullptr) {
+    TextFileReader_t screen_file{};
+    if (openTextFile(config::files::splash_screen, screen_file)) {
         clearScreen();
-        for (int i = 0; fgets(in_line, 80, screen_file) != CNIL; i++) {
+        for (int i = 0; textFileGetLine(screen_file, in_line, 80); i++) {
             putString(in_line, Coord_t{i, 0});
         }
+        startupTimerStop();
         waitForContinueKey(23);
-
-        (void) fclose(screen_file);
     }
 }
 
 // Open and display a text help file
 // File perusal, primitive, but portable -CJS-
 void displayTextHelpFile(const std::string &filename) {
-    FILE *file = fopen(filename.c_str(), "r");
-    if (file == nullptr) {
+    TextFileReader_t file{};
+    if (!openTextFile(filename, file)) {
         putStringClearToEOL("Can not find help file '" + filename + "'.", Coord_t{0, 0});
         return;
     }
@@ -51,11 +161,11 @@ void displayTextHelpFile(const std::string &filename) {
     constexpr uint8_t max_line_length = 80;
     char line_buffer[max_line_length];
 
-    while (feof(file) == 0) {
+    while (!file.at_end) {
         clearScreen();
 
         for (int i = 0; i < 23; i++) {
-            if (fgets(line_buffer, max_line_length - 1, file) != CNIL) {
+            if (textFileGetLine(file, line_buffer, max_line_length - 1)) {
                 putString(line_buffer, Coord_t{i, 0});
             }
         }
@@ -66,15 +176,13 @@ void displayTextHelpFile(const std::string &filename) {
         }
     }
 
-    (void) fclose(file);
-
     terminalRestoreScreen();
 }
 
 // Open and display a "death" text file
 void displayDeathFile(const std::string &filename) {
-    FILE *file = fopen(filename.c_str(), "r");
-    if (file == nullptr) {
+    TextFileReader_t file{};
+    if (!openTextFile(filename, file)) {
         putStringClearToEOL("Can not find help file '" + filename + "'.", Coord_t{0, 0});
         return;
     }
@@ -84,18 +192,22 @@ void displayDeathFile(const std::string &filename) {
     constexpr uint8_t max_line_length = 80;
     char line_buffer[max_line_length];
 
-    for (int i = 0; i < 23 && feof(file) == 0; i++) {
-        if (fgets(line_buffer, max_line_length - 1, file) != CNIL) {
+    for (int i = 0; i < 23 && !file.at_end; i++) {
+        if (textFileGetLine(file, line_buffer, max_line_length - 1)) {
             putString(line_buffer, Coord_t{i, 0});
         }
     }
-    (void) fclose(file);
 }
 
 // Prints a list of random objects to a file. -RAK-
 // Note that the objects produced is a sampling of objects
 // which be expected to appear on that level.
 void outputRandomLevelObjectsToFile() {
+    // Someone playing over a connection has no say in the server's files
+    if (session->terminal_link != nullptr) {
+        return;
+    }
+
     obj_desc_t input = {0};
 
     putStringClearToEOL("Produce objects on what level?: ", Coord_t{0, 0});
@@ -161,11 +273,11 @@ void outputRandomLevelObjectsToFile() {
 
     for (int i = 0; i < count; i++) {
         int object_id = itemGetRandomObjectId(level, small_objects);
-        inventoryItemCopyTo(sorted_objects[object_id], game.treasure.list[treasure_id]);
+        inventoryItemCopyTo(sorted_objects[object_id], session->game.treasure.list[treasure_id]);
 
         magicTreasureMagicalAbility(treasure_id, level);
 
-        Inventory_t &item = game.treasure.list[treasure_id];
+        Inventory_t &item = session->game.treasure.list[treasure_id];
         itemIdentifyAsStoreBought(item);
 
         if (inventoryItemIsCursed(item)) {
@@ -195,72 +307,72 @@ static void writeCharacterSheetToFile(FILE *char_file) {
 
     (void) fprintf(char_file, "%c\n\n", CTRL_KEY('L'));
 
-    (void) fprintf(char_file, " Name%9s %-23s", colon, py.misc.name);
-    (void) fprintf(char_file, " Age%11s %6d", colon, (int) py.misc.age);
-    statsAsString(py.stats.used[PlayerAttr::A_STR], stat_description);
+    (void) fprintf(char_file, " Name%9s %-23s", colon, session->py.misc.name);
+    (void) fprintf(char_file, " Age%11s %6d", colon, (int) session->py.misc.age);
+    statsAsString(session->py.stats.used[PlayerAttr::A_STR], stat_description);
     (void) fprintf(char_file, "   STR : %s\n", stat_description);
-    (void) fprintf(char_file, " Race%9s %-23s", colon, character_races[py.misc.race_id].name);
-    (void) fprintf(char_file, " Height%8s %6d", colon, (int) py.misc.height);
-    statsAsString(py.stats.used[PlayerAttr::A_INT], stat_description);
+    (void) fprintf(char_file, " Race%9s %-23s", colon, character_races[session->py.misc.race_id].name);
+    (void) fprintf(char_file, " Height%8s %6d", colon, (int) session->py.misc.height);
+    statsAsString(session->py.stats.used[PlayerAttr::A_INT], stat_description);
     (void) fprintf(char_file, "   INT : %s\n", stat_description);
     (void) fprintf(char_file, " Sex%10s %-23s", colon, (playerGetGenderLabel()));
-    (void) fprintf(char_file, " Weight%8s %6d", colon, (int) py.misc.weight);
-    statsAsString(py.stats.used[PlayerAttr::A_WIS], stat_description);
+    (void) fprintf(char_file, " Weight%8s %6d", colon, (int) session->py.misc.weight);
+    statsAsString(session->py.stats.used[PlayerAttr::A_WIS], stat_description);
     (void) fprintf(char_file, "   WIS : %s\n", stat_description);
-    (void) fprintf(char_file, " Class%8s %-23s", colon, classes[py.misc.class_id].title);
-    (void) fprintf(char_file, " Social Class : %6d", py.misc.social_class);
-    statsAsString(py.stats.used[PlayerAttr::A_DEX], stat_description);
+    (void) fprintf(char_file, " Class%8s %-23s", colon, classes[session->py.misc.class_id].title);
+    (void) fprintf(char_file, " Social Class : %6d", session->py.misc.social_class);
+    statsAsString(session->py.stats.used[PlayerAttr::A_DEX], stat_description);
     (void) fprintf(char_file, "   DEX : %s\n", stat_description);
     (void) fprintf(char_file, " Title%8s %-23s", colon, playerRankTitle());
     (void) fprintf(char_file, "%22s", blank);
-    statsAsString(py.stats.used[PlayerAttr::A_CON], stat_description);
+    statsAsString(session->py.stats.used[PlayerAttr::A_CON], stat_description);
     (void) fprintf(char_file, "   CON : %s\n", stat_description);
     (void) fprintf(char_file, "%34s", blank);
     (void) fprintf(char_file, "%26s", blank);
-    statsAsString(py.stats.used[PlayerAttr::A_CHR], stat_description);
+    statsAsString(session->py.stats.used[PlayerAttr::A_CHR], stat_description);
     (void) fprintf(char_file, "   CHR : %s\n\n", stat_description);
 
-    (void) fprintf(char_file, " + To Hit    : %6d", py.misc.display_to_hit);
-    (void) fprintf(char_file, "%7sLevel      : %7d", blank, (int) py.misc.level);
-    (void) fprintf(char_file, "    Max Hit Points : %6d\n", py.misc.max_hp);
-    (void) fprintf(char_file, " + To Damage : %6d", py.misc.display_to_damage);
-    (void) fprintf(char_file, "%7sExperience : %7d", blank, py.misc.exp);
-    (void) fprintf(char_file, "    Cur Hit Points : %6d\n", py.misc.current_hp);
-    (void) fprintf(char_file, " + To AC     : %6d", py.misc.display_to_ac);
-    (void) fprintf(char_file, "%7sMax Exp    : %7d", blank, py.misc.max_exp);
-    (void) fprintf(char_file, "    Max Mana%8s %6d\n", colon, py.misc.mana);
-    (void) fprintf(char_file, "   Total AC  : %6d", py.misc.display_ac);
-    if (py.misc.level >= PLAYER_MAX_LEVEL) {
+    (void) fprintf(char_file, " + To Hit    : %6d", session->py.misc.display_to_hit);
+    (void) fprintf(char_file, "%7sLevel      : %7d", blank, (int) session->py.misc.level);
+    (void) fprintf(char_file, "    Max Hit Points : %6d\n", session->py.misc.max_hp);
+    (void) fprintf(char_file, " + To Damage : %6d", session->py.misc.display_to_damage);
+    (void) fprintf(char_file, "%7sExperience : %7d", blank, session->py.misc.exp);
+    (void) fprintf(char_file, "    Cur Hit Points : %6d\n", session->py.misc.current_hp);
+    (void) fprintf(char_file, " + To AC     : %6d", session->py.misc.display_to_ac);
+    (void) fprintf(char_file, "%7sMax Exp    : %7d", blank, session->py.misc.max_exp);
+    (void) fprintf(char_file, "    Max Mana%8s %6d\n", colon, session->py.misc.mana);
+    (void) fprintf(char_file, "   Total AC  : %6d", session->py.misc.display_ac);
+    if (session->py.misc.level >= PLAYER_MAX_LEVEL) {
         (void) fprintf(char_file, "%7sExp to Adv : *******", blank);
     } else {
-        (void) fprintf(char_file, "%7sExp to Adv : %7d", blank, (int32_t)(py.base_exp_levels[py.misc.level - 1] * py.misc.experience_factor / 100));
+        (void) fprintf(char_file, "%7sExp to Adv : %7d", blank, (int32_t)(session->py.base_exp_levels[session->py.misc.level - 1] * session->py.misc.experience_factor / 100));
     }
-    (void) fprintf(char_file, "    Cur Mana%8s %6d\n", colon, py.misc.current_mana);
-    (void) fprintf(char_file, "%28sGold%8s %7d\n\n", blank, colon, py.misc.au);
+    (void) fprintf(char_file, "    Cur Mana%8s %6d\n", colon, session->py.misc.current_mana);
+    (void) fprintf(char_file, "%28sGold%8s %7d\n\n", blank, colon, session->py.misc.au);
 
-    int xbth = py.misc.bth + py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + //
-               (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::BTH] * py.misc.level);
-    int xbthb = py.misc.bth_with_bows + py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + //
-                (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::BTHB] * py.misc.level);
+    int xbth = session->py.misc.bth + session->py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + //
+               (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::BTH] * session->py.misc.level);
+    int xbthb = session->py.misc.bth_with_bows + session->py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + //
+                (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::BTHB] * session->py.misc.level);
 
     // this results in a range from 0 to 29
-    int xfos = 40 - py.misc.fos;
+    int xfos = 40 - session->py.misc.fos;
     if (xfos < 0) {
         xfos = 0;
     }
-    int xsrh = py.misc.chance_in_search;
+    int xsrh = session->py.misc.chance_in_search;
 
     // this results in a range from 0 to 9
-    int xstl = py.misc.stealth_factor + 1;
-    int xdis = py.misc.disarm + 2 * playerDisarmAdjustment() + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) + //
-               (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DISARM] * py.misc.level / 3);
-    int xsave = py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_WIS) + //
-                (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::SAVE] * py.misc.level / 3);
-    int xdev = py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) + //
-               (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DEVICE] * py.misc.level / 3);
+    int xstl = session->py.misc.stealth_factor + 1;
+    int xdis = session->py.misc.disarm + 2 * playerDisarmAdjustment() + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) + //
+               (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DISARM] * session->py.misc.level / 3);
+    int xsave = session->py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_WIS) + //
+                (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::SAVE] * session->py.misc.level / 3);
+    int xdev = session->py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) + //
+               (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DEVICE] * session->py.misc.level / 3);
 
     vtype_t xinfra = {'\0'};
-    (void) sprintf(xinfra, "%d feet", py.flags.see_infra * 10);
+    (void) sprintf(xinfra, "%d feet", session->py.flags.see_infra * 10);
 
     (void) fprintf(char_file, "(Miscellaneous Abilities)\n\n");
     (void) fprintf(char_file, " Fighting    : %-10s", statRating(Coord_t{12, xbth}));
@@ -275,7 +387,7 @@ static void writeCharacterSheetToFile(FILE *char_file) {
 
     // Write out the character's history
     (void) fprintf(char_file, "Character Background\n");
-    for (auto &entry : py.misc.history) {
+    for (auto &entry : session->py.misc.history) {
         (void) fprintf(char_file, " %s\n", entry);
     }
 }
@@ -315,7 +427,7 @@ static const char *equipmentPlacementDescription(int item_id) {
 static void writeEquipmentListToFile(FILE *equip_file) {
     (void) fprintf(equip_file, "\n  [Character's Equipment List]\n\n");
 
-    if (py.equipment_count == 0) {
+    if (session->py.equipment_count == 0) {
         (void) fprintf(equip_file, "  Character has no equipment in use.\n");
         return;
     }
@@ -324,11 +436,11 @@ static void writeEquipmentListToFile(FILE *equip_file) {
     int item_slot_id = 0;
 
     for (int i = PlayerEquipment::Wield; i < PLAYER_INVENTORY_SIZE; i++) {
-        if (py.inventory[i].category_id == TV_NOTHING) {
+        if (session->py.inventory[i].category_id == TV_NOTHING) {
             continue;
         }
 
-        itemDescription(description, py.inventory[i], true);
+        itemDescription(description, session->py.inventory[i], true);
         (void) fprintf(equip_file, "  %c) %-19s: %s\n", item_slot_id + 'a', equipmentPlacementDescription(i), description);
 
         item_slot_id++;
@@ -341,15 +453,15 @@ static void writeEquipmentListToFile(FILE *equip_file) {
 static void writeInventoryToFile(FILE *inv_file) {
     (void) fprintf(inv_file, "  [General Inventory List]\n\n");
 
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         (void) fprintf(inv_file, "  Character has no objects in inventory.\n");
         return;
     }
 
     obj_desc_t description = {'\0'};
 
-    for (int i = 0; i < py.pack.unique_items; i++) {
-        itemDescription(description, py.inventory[i], true);
+    for (int i = 0; i < session->py.pack.unique_items; i++) {
+        itemDescription(description, session->py.inventory[i], true);
         (void) fprintf(inv_file, "%c) %s\n", i + 'a', description);
     }
 
@@ -358,6 +470,12 @@ static void writeInventoryToFile(FILE *inv_file) {
 
 // Print the character to a file or device -RAK-
 bool outputPlayerCharacterToFile(char *filename) {
+    // Someone playing over a connection has no say in the server's files
+    if (session->terminal_link != nullptr) {
+        printMessage("The character can't be saved to a file here.");
+        return false;
+    }
+
     int fd = open(filename, O_WRONLY | O_CREAT | O_EXCL, 0644);
     if (fd < 0 && errno == EEXIST) {
         if (getInputConfirmation("Replace existing file " + std::string(filename) + "?")) {
@@ -7,12 +7,12 @@
 
 #include "headers.h"
 
+#include <atomic>
+#include <chrono>
+
 static void playDungeon();
 
 static void initializeCharacterInventory();
-static void initializeMonsterLevels();
-static void initializeTreasureLevels();
-static void priceAdjust();
 static char originalCommands(char command);
 static void doCommand(char command);
 static bool validCountCommand(char command);
@@ -25,23 +25,47 @@ static void dungeonGoDownLevel();
 static void dungeonJamDoor();
 static void inventoryRefillLamp();
 
+// How long the process took to show its first screen, for the report
+// asked for with -T. The tables the game needs are built when compiling,
+// see the data_*.cpp files, so there is little left to do before then.
+static std::chrono::steady_clock::time_point startup_began;
+static std::atomic<int64_t> startup_microseconds{-1};
+
+// Called first thing in main()
+void startupTimerStart() {
+    startup_began = std::chrono::steady_clock::now();
+}
+
+// Called once the first screen is up, only the first call counts
+void startupTimerStop() {
+    auto elapsed = std::chrono::steady_clock::now() - startup_began;
+    auto microseconds = (int64_t) std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+    int64_t unset = -1;
+    (void) startup_microseconds.compare_exchange_strong(unset, microseconds);
+}
+
+void startupTimerReport() {
+    int64_t microseconds = startup_microseconds;
+    if (microseconds < 0) {
+        return;
+    }
+
+    std::cerr << "Startup: " << microseconds << " microseconds to the first screen\n";
+}
+
 void startMoria(int seed, bool start_new_game) {
     // Roguelike keys are disabled by default.
     // This will be overridden by the setting in the game save file.
-    config::options::use_roguelike_keys = false;
-
-    priceAdjust();
+    session->options.use_roguelike_keys = false;
 
     // Show the game splash screen
     displaySplashScreen();
+    startupTimerStop();
 
     // Grab a random seed from the clock
     seedsInitialize(static_cast<uint32_t>(seed));
 
-    // Init monster and treasure levels for allocate
-    initializeMonsterLevels();
-    initializeTreasureLevels();
-
     // Init the store inventories
     storeInitializeOwners();
 
@@ -49,9 +73,9 @@ void startMoria(int seed, bool start_new_game) {
     playerInitializeBaseExperienceLevels();
 
     // initialize some player fields - may or may not be needed -MRC-
-    py.flags.spells_learnt = 0;
-    py.flags.spells_worked = 0;
-    py.flags.spells_forgotten = 0;
+    session->py.flags.spells_learnt = 0;
+    session->py.flags.spells_worked = 0;
+    session->py.flags.spells_forgotten = 0;
 
     // If -n is not passed, the calling routine will know
     // save file name, hence, this code is not necessary.
@@ -64,13 +88,13 @@ void startMoria(int seed, bool start_new_game) {
     bool result = false;
     bool generate = false;
 
-    if (!start_new_game && (access(config::files::save_game.c_str(), 0) == 0) && loadGame(generate)) {
+    if (!start_new_game && (access(session->save_game.c_str(), 0) == 0) && loadGame(generate)) {
         result = true;
     }
 
     // enter wizard mode before showing the character display, but must wait
     // until after loadGame() in case it was just a resurrection
-    if (game.to_be_wizard) {
+    if (session->game.to_be_wizard) {
         if (!enterWizardMode()) {
             endGame();
         }
@@ -80,39 +104,39 @@ void startMoria(int seed, bool start_new_game) {
         changeCharacterName();
 
         // could be restoring a dead character after a signal or HANGUP
-        if (py.misc.current_hp < 0) {
-            game.character_is_dead = true;
+        if (session->py.misc.current_hp < 0) {
+            session->game.character_is_dead = true;
         }
     } else {
         // Create character
         characterCreate();
 
-        py.misc.date_of_birth = getCurrentUnixTime();
+        session->py.misc.date_of_birth = getCurrentUnixTime();
 
         initializeCharacterInventory();
-        py.flags.food = 7500;
-        py.flags.food_digested = 2;
+        session->py.flags.food = 7500;
+        session->py.flags.food_digested = 2;
 
         // Spell and Mana based on class: Mage or Clerical realm.
-        if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+        if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
             clearScreen(); // makes spell list easier to read
             playerCalculateAllowedSpellsCount(PlayerAttr::A_INT);
             playerGainMana(PlayerAttr::A_INT);
-        } else if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
+        } else if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
             playerCalculateAllowedSpellsCount(PlayerAttr::A_WIS);
             clearScreen(); // force out the 'learn prayer' message
             playerGainMana(PlayerAttr::A_WIS);
         }
 
         // Set some default values -MRC-
-        py.temporary_light_only = false;
-        py.weapon_is_heavy = false;
-        py.pack.heaviness = 0;
+        session->py.temporary_light_only = false;
+        session->py.weapon_is_heavy = false;
+        session->py.pack.heaviness = 0;
 
         // prevent ^c quit from entering score into scoreboard,
         // and prevent signal from creating panic save until this
         // point, all info needed for save file is now valid.
-        game.character_generated = true;
+        session->game.character_generated = true;
         generate = true;
     }
 
@@ -130,24 +154,24 @@ void startMoria(int seed, bool start_new_game) {
     }
 
     // Loop till dead, or exit
-    while (!game.character_is_dead) {
+    while (!session->game.character_is_dead) {
         // Dungeon logic
         playDungeon();
 
         // check for eof here, see getKeyInput() in io.c
         // eof can occur if the process gets a HANGUP signal
-        if (eof_flag != 0) {
-            (void) strcpy(game.character_died_from, "(end of input: saved)");
+        if (session->eof_flag != 0) {
+            (void) strcpy(session->game.character_died_from, "(end of input: saved)");
             if (!saveGame()) {
-                (void) strcpy(game.character_died_from, "unexpected eof");
+                (void) strcpy(session->game.character_died_from, "unexpected eof");
             }
 
             // should not reach here, but if we do, this guarantees exit
-            game.character_is_dead = true;
+            session->game.character_is_dead = true;
         }
 
         // New level if not dead
-        if (!game.character_is_dead) {
+        if (!session->game.character_is_dead) {
             generateCave();
         }
     }
@@ -161,11 +185,11 @@ static void initializeCharacterInventory() {
     Inventory_t item{};
 
     // this is needed for bash to work right, it can't hurt anyway
-    for (auto &entry : py.inventory) {
+    for (auto &entry : session->py.inventory) {
         inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, entry);
     }
 
-    for (auto item_id : class_base_provisions[py.misc.class_id]) {
+    for (auto item_id : class_base_provisions[session->py.misc.class_id]) {
         inventoryItemCopyTo(item_id, item);
 
         // this makes it spellItemIdentifyAndRemoveRandomInscription and itemSetAsIdentified
@@ -180,68 +204,11 @@ static void initializeCharacterInventory() {
     }
 
     // weird place for it, but why not?
-    for (uint8_t &id : py.flags.spells_learned_order) {
+    for (uint8_t &id : session->py.flags.spells_learned_order) {
         id = 99;
     }
 }
 
-// Initializes M_LEVEL array for use with PLACE_MONSTER -RAK-
-static void initializeMonsterLevels() {
-    for (auto &level : monster_levels) {
-        level = 0;
-    }
-
-    for (int i = 0; i < MON_MAX_CREATURES - config::monsters::MON_ENDGAME_MONSTERS; i++) {
-        monster_levels[creatures_list[i].level]++;
-    }
-
-    for (int i = 1; i <= MON_MAX_LEVELS; i++) {
-        monster_levels[i] += monster_levels[i - 1];
-    }
-}
-
-// Initializes T_LEVEL array for use with PLACE_OBJECT -RAK-
-static void initializeTreasureLevels() {
-    for (auto &level : treasure_levels) {
-        level = 0;
-    }
-
-    for (int i = 0; i < MAX_DUNGEON_OBJECTS; i++) {
-        treasure_levels[game_objects[i].depth_first_found]++;
-    }
-
-    for (int i = 1; i <= TREASURE_MAX_LEVELS; i++) {
-        treasure_levels[i] += treasure_levels[i - 1];
-    }
-
-    // now produce an array with object indexes sorted by level,
-    // by using the info in treasure_levels, this is an O(n) sort!
-    // this is not a stable sort, but that does not matter
-    int indexes[TREASURE_MAX_LEVELS + 1] = {};
-    for (auto &i : indexes) {
-        i = 1;
-    }
-
-    for (int i = 0; i < MAX_DUNGEON_OBJECTS; i++) {
-        int level = game_objects[i].depth_first_found;
-        int object_id = treasure_levels[level] - indexes[level];
-
-        sorted_objects[object_id] = (int16_t) i;
-
-        indexes[level]++;
-    }
-}
-
-// Adjust prices of objects -RAK-
-static void priceAdjust() {
-#if (COST_ADJUSTMENT != 100)
-    // round half-way cases up
-    for (auto &item : game_objects) {
-        item.cost = ((item.cost * COST_ADJUSTMENT) + 50) / 100;
-    }
-#endif
-}
-
 // Moria game module -RAK-
 // The code in this section has gone through many revisions, and
 // some of it could stand some more hard work. -RAK-
@@ -250,47 +217,47 @@ static void priceAdjust() {
 
 // Reset flags and initialize variables
 static void resetDungeonFlags() {
-    game.command_count = 0;
-    dg.generate_new_level = false;
-    py.running_tracker = 0;
-    game.teleport_player = false;
-    monster_multiply_total = 0;
-    dg.floor[py.pos.y][py.pos.x].creature_id = 1;
+    session->game.command_count = 0;
+    session->dg.generate_new_level = false;
+    session->py.running_tracker = 0;
+    session->game.teleport_player = false;
+    session->monster_multiply_total = 0;
+    session->dg.floor[session->py.pos.y][session->py.pos.x].creature_id = 1;
 }
 
 // Check light status for dungeon setup
 static void playerInitializePlayerLight() {
-    py.carrying_light = (py.inventory[PlayerEquipment::Light].misc_use > 0);
+    session->py.carrying_light = (session->py.inventory[PlayerEquipment::Light].misc_use > 0);
 }
 
 // Check for a maximum level
 static void playerUpdateMaxDungeonDepth() {
-    if (dg.current_level > py.misc.max_dungeon_depth) {
-        py.misc.max_dungeon_depth = (uint16_t) dg.current_level;
+    if (session->dg.current_level > session->py.misc.max_dungeon_depth) {
+        session->py.misc.max_dungeon_depth = (uint16_t) session->dg.current_level;
     }
 }
 
 // Check light status
 static void playerUpdateLightStatus() {
-    Inventory_t &item = py.inventory[PlayerEquipment::Light];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Light];
 
-    if (py.carrying_light) {
+    if (session->py.carrying_light) {
         if (item.misc_use > 0) {
             item.misc_use--;
 
             if (item.misc_use == 0) {
-                py.carrying_light = false;
+                session->py.carrying_light = false;
                 printMessage("Your light has gone out!");
                 playerDisturb(0, 1);
 
                 // unlight creatures
                 updateMonsters(false);
-            } else if (item.misc_use < 40 && randomNumber(5) == 1 && py.flags.blind < 1) {
+            } else if (item.misc_use < 40 && randomNumber(5) == 1 && session->py.flags.blind < 1) {
                 playerDisturb(0, 0);
                 printMessage("Your light is growing faint.");
             }
         } else {
-            py.carrying_light = false;
+            session->py.carrying_light = false;
             playerDisturb(0, 1);
 
             // unlight creatures
@@ -298,7 +265,7 @@ static void playerUpdateLightStatus() {
         }
     } else if (item.misc_use > 0) {
         item.misc_use--;
-        py.carrying_light = true;
+        session->py.carrying_light = true;
         playerDisturb(0, 1);
 
         // light creatures
@@ -307,13 +274,13 @@ static void playerUpdateLightStatus() {
 }
 
 static void playerActivateHeroism() {
-    py.flags.status |= config::player::status::PY_HERO;
+    session->py.flags.status |= config::player::status::PY_HERO;
     playerDisturb(0, 0);
 
-    py.misc.max_hp += 10;
-    py.misc.current_hp += 10;
-    py.misc.bth += 12;
-    py.misc.bth_with_bows += 12;
+    session->py.misc.max_hp += 10;
+    session->py.misc.current_hp += 10;
+    session->py.misc.bth += 12;
+    session->py.misc.bth_with_bows += 12;
 
     printMessage("You feel like a HERO!");
     printCharacterMaxHitPoints();
@@ -321,30 +288,30 @@ static void playerActivateHeroism() {
 }
 
 static void playerDisableHeroism() {
-    py.flags.status &= ~config::player::status::PY_HERO;
+    session->py.flags.status &= ~config::player::status::PY_HERO;
     playerDisturb(0, 0);
 
-    py.misc.max_hp -= 10;
-    if (py.misc.current_hp > py.misc.max_hp) {
-        py.misc.current_hp = py.misc.max_hp;
-        py.misc.current_hp_fraction = 0;
+    session->py.misc.max_hp -= 10;
+    if (session->py.misc.current_hp > session->py.misc.max_hp) {
+        session->py.misc.current_hp = session->py.misc.max_hp;
+        session->py.misc.current_hp_fraction = 0;
         printCharacterCurrentHitPoints();
     }
-    py.misc.bth -= 12;
-    py.misc.bth_with_bows -= 12;
+    session->py.misc.bth -= 12;
+    session->py.misc.bth_with_bows -= 12;
 
     printMessage("The heroism wears off.");
     printCharacterMaxHitPoints();
 }
 
 static void playerActivateSuperHeroism() {
-    py.flags.status |= config::player::status::PY_SHERO;
+    session->py.flags.status |= config::player::status::PY_SHERO;
     playerDisturb(0, 0);
 
-    py.misc.max_hp += 20;
-    py.misc.current_hp += 20;
-    py.misc.bth += 24;
-    py.misc.bth_with_bows += 24;
+    session->py.misc.max_hp += 20;
+    session->py.misc.current_hp += 20;
+    session->py.misc.bth += 24;
+    session->py.misc.bth_with_bows += 24;
 
     printMessage("You feel like a SUPER HERO!");
     printCharacterMaxHitPoints();
@@ -352,17 +319,17 @@ static void playerActivateSuperHeroism() {
 }
 
 static void playerDisableSuperHeroism() {
-    py.flags.status &= ~config::player::status::PY_SHERO;
+    session->py.flags.status &= ~config::player::status::PY_SHERO;
     playerDisturb(0, 0);
 
-    py.misc.max_hp -= 20;
-    if (py.misc.current_hp > py.misc.max_hp) {
-        py.misc.current_hp = py.misc.max_hp;
-        py.misc.current_hp_fraction = 0;
+    session->py.misc.max_hp -= 20;
+    if (session->py.misc.current_hp > session->py.misc.max_hp) {
+        session->py.misc.current_hp = session->py.misc.max_hp;
+        session->py.misc.current_hp_fraction = 0;
         printCharacterCurrentHitPoints();
     }
-    py.misc.bth -= 24;
-    py.misc.bth_with_bows -= 24;
+    session->py.misc.bth -= 24;
+    session->py.misc.bth_with_bows -= 24;
 
     printMessage("The super heroism wears off.");
     printCharacterMaxHitPoints();
@@ -370,27 +337,27 @@ static void playerDisableSuperHeroism() {
 
 static void playerUpdateHeroStatus() {
     // Heroism
-    if (py.flags.heroism > 0) {
-        if ((py.flags.status & config::player::status::PY_HERO) == 0) {
+    if (session->py.flags.heroism > 0) {
+        if ((session->py.flags.status & config::player::status::PY_HERO) == 0) {
             playerActivateHeroism();
         }
 
-        py.flags.heroism--;
+        session->py.flags.heroism--;
 
-        if (py.flags.heroism == 0) {
+        if (session->py.flags.heroism == 0) {
             playerDisableHeroism();
         }
     }
 
     // Super Heroism
-    if (py.flags.super_heroism > 0) {
-        if ((py.flags.status & config::player::status::PY_SHERO) == 0) {
+    if (session->py.flags.super_heroism > 0) {
+        if ((session->py.flags.status & config::player::status::PY_SHERO) == 0) {
             playerActivateSuperHeroism();
         }
 
-        py.flags.super_heroism--;
+        session->py.flags.super_heroism--;
 
-        if (py.flags.super_heroism == 0) {
+        if (session->py.flags.super_heroism == 0) {
             playerDisableSuperHeroism();
         }
     }
@@ -400,30 +367,30 @@ static int playerFoodConsumption() {
     // Regenerate hp and mana
     int regen_amount = config::player::PLAYER_REGEN_NORMAL;
 
-    if (py.flags.food < config::player::PLAYER_FOOD_ALERT) {
-        if (py.flags.food < config::player::PLAYER_FOOD_WEAK) {
-            if (py.flags.food < 0) {
+    if (session->py.flags.food < config::player::PLAYER_FOOD_ALERT) {
+        if (session->py.flags.food < config::player::PLAYER_FOOD_WEAK) {
+            if (session->py.flags.food < 0) {
                 regen_amount = 0;
-            } else if (py.flags.food < config::player::PLAYER_FOOD_FAINT) {
+            } else if (session->py.flags.food < config::player::PLAYER_FOOD_FAINT) {
                 regen_amount = config::player::PLAYER_REGEN_FAINT;
-            } else if (py.flags.food < config::player::PLAYER_FOOD_WEAK) {
+            } else if (session->py.flags.food < config::player::PLAYER_FOOD_WEAK) {
                 regen_amount = config::player::PLAYER_REGEN_WEAK;
             }
 
-            if ((py.flags.status & config::player::status::PY_WEAK) == 0) {
-                py.flags.status |= config::player::status::PY_WEAK;
+            if ((session->py.flags.status & config::player::status::PY_WEAK) == 0) {
+                session->py.flags.status |= config::player::status::PY_WEAK;
                 printMessage("You are getting weak from hunger.");
                 playerDisturb(0, 0);
                 printCharacterHungerStatus();
             }
 
-            if (py.flags.food < config::player::PLAYER_FOOD_FAINT && randomNumber(8) == 1) {
-                py.flags.paralysis += randomNumber(5);
+            if (session->py.flags.food < config::player::PLAYER_FOOD_FAINT && randomNumber(8) == 1) {
+                session->py.flags.paralysis += randomNumber(5);
                 printMessage("You faint from the lack of food.");
                 playerDisturb(1, 0);
             }
-        } else if ((py.flags.status & config::player::status::PY_HUNGRY) == 0) {
-            py.flags.status |= config::player::status::PY_HUNGRY;
+        } else if ((session->py.flags.status & config::player::status::PY_HUNGRY) == 0) {
+            session->py.flags.status |= config::player::status::PY_HUNGRY;
             printMessage("You are getting hungry.");
             playerDisturb(0, 0);
             printCharacterHungerStatus();
@@ -432,14 +399,14 @@ static int playerFoodConsumption() {
 
     // Food consumption
     // Note: Sped up characters really burn up the food!
-    if (py.flags.speed < 0) {
-        py.flags.food -= py.flags.speed * py.flags.speed;
+    if (session->py.flags.speed < 0) {
+        session->py.flags.food -= session->py.flags.speed * session->py.flags.speed;
     }
 
-    py.flags.food -= py.flags.food_digested;
+    session->py.flags.food -= session->py.flags.food_digested;
 
-    if (py.flags.food < 0) {
-        playerTakesHit(-py.flags.food / 16, "starvation"); // -CJS-
+    if (session->py.flags.food < 0) {
+        playerTakesHit(-session->py.flags.food / 16, "starvation"); // -CJS-
         playerDisturb(1, 0);
     }
 
@@ -447,30 +414,30 @@ static int playerFoodConsumption() {
 }
 
 static void playerUpdateRegeneration(int amount) {
-    if (py.flags.regenerate_hp) {
+    if (session->py.flags.regenerate_hp) {
         amount = amount * 3 / 2;
     }
 
-    if (((py.flags.status & config::player::status::PY_SEARCH) != 0u) || py.flags.rest != 0) {
+    if (((session->py.flags.status & config::player::status::PY_SEARCH) != 0u) || session->py.flags.rest != 0) {
         amount = amount * 2;
     }
 
-    if (py.flags.poisoned < 1 && py.misc.current_hp < py.misc.max_hp) {
+    if (session->py.flags.poisoned < 1 && session->py.misc.current_hp < session->py.misc.max_hp) {
         playerRegenerateHitPoints(amount);
     }
 
-    if (py.misc.current_mana < py.misc.mana) {
+    if (session->py.misc.current_mana < session->py.misc.mana) {
         playerRegenerateMana(amount);
     }
 }
 
 static void playerUpdateBlindness() {
-    if (py.flags.blind <= 0) {
+    if (session->py.flags.blind <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_BLIND) == 0) {
-        py.flags.status |= config::player::status::PY_BLIND;
+    if ((session->py.flags.status & config::player::status::PY_BLIND) == 0) {
+        session->py.flags.status |= config::player::status::PY_BLIND;
 
         drawDungeonPanel();
         printCharacterBlindStatus();
@@ -480,10 +447,10 @@ static void playerUpdateBlindness() {
         updateMonsters(false);
     }
 
-    py.flags.blind--;
+    session->py.flags.blind--;
 
-    if (py.flags.blind == 0) {
-        py.flags.status &= ~config::player::status::PY_BLIND;
+    if (session->py.flags.blind == 0) {
+        session->py.flags.status &= ~config::player::status::PY_BLIND;
 
         printCharacterBlindStatus();
         drawDungeonPanel();
@@ -497,49 +464,49 @@ static void playerUpdateBlindness() {
 }
 
 static void playerUpdateConfusion() {
-    if (py.flags.confused <= 0) {
+    if (session->py.flags.confused <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_CONFUSED) == 0) {
-        py.flags.status |= config::player::status::PY_CONFUSED;
+    if ((session->py.flags.status & config::player::status::PY_CONFUSED) == 0) {
+        session->py.flags.status |= config::player::status::PY_CONFUSED;
         printCharacterConfusedState();
     }
 
-    py.flags.confused--;
+    session->py.flags.confused--;
 
-    if (py.flags.confused == 0) {
-        py.flags.status &= ~config::player::status::PY_CONFUSED;
+    if (session->py.flags.confused == 0) {
+        session->py.flags.status &= ~config::player::status::PY_CONFUSED;
 
         printCharacterConfusedState();
         printMessage("You feel less confused now.");
 
-        if (py.flags.rest != 0) {
+        if (session->py.flags.rest != 0) {
             playerRestOff();
         }
     }
 }
 
 static void playerUpdateFearState() {
-    if (py.flags.afraid <= 0) {
+    if (session->py.flags.afraid <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_FEAR) == 0) {
-        if (py.flags.super_heroism + py.flags.heroism > 0) {
-            py.flags.afraid = 0;
+    if ((session->py.flags.status & config::player::status::PY_FEAR) == 0) {
+        if (session->py.flags.super_heroism + session->py.flags.heroism > 0) {
+            session->py.flags.afraid = 0;
         } else {
-            py.flags.status |= config::player::status::PY_FEAR;
+            session->py.flags.status |= config::player::status::PY_FEAR;
             printCharacterFearState();
         }
-    } else if (py.flags.super_heroism + py.flags.heroism > 0) {
-        py.flags.afraid = 1;
+    } else if (session->py.flags.super_heroism + session->py.flags.heroism > 0) {
+        session->py.flags.afraid = 1;
     }
 
-    py.flags.afraid--;
+    session->py.flags.afraid--;
 
-    if (py.flags.afraid == 0) {
-        py.flags.status &= ~config::player::status::PY_FEAR;
+    if (session->py.flags.afraid == 0) {
+        session->py.flags.status &= ~config::player::status::PY_FEAR;
 
         printCharacterFearState();
         printMessage("You feel bolder now.");
@@ -548,19 +515,19 @@ static void playerUpdateFearState() {
 }
 
 static void playerUpdatePoisonedState() {
-    if (py.flags.poisoned <= 0) {
+    if (session->py.flags.poisoned <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_POISONED) == 0) {
-        py.flags.status |= config::player::status::PY_POISONED;
+    if ((session->py.flags.status & config::player::status::PY_POISONED) == 0) {
+        session->py.flags.status |= config::player::status::PY_POISONED;
         printCharacterPoisonedState();
     }
 
-    py.flags.poisoned--;
+    session->py.flags.poisoned--;
 
-    if (py.flags.poisoned == 0) {
-        py.flags.status &= ~config::player::status::PY_POISONED;
+    if (session->py.flags.poisoned == 0) {
+        session->py.flags.status &= ~config::player::status::PY_POISONED;
 
         printCharacterPoisonedState();
         printMessage("You feel better.");
@@ -588,14 +555,14 @@ static void playerUpdatePoisonedState() {
         case 1:
         case 2:
         case 3:
-            damage = ((dg.game_turn % 2) == 0 ? 1 : 0);
+            damage = ((session->dg.game_turn % 2) == 0 ? 1 : 0);
             break;
         case 4:
         case 5:
-            damage = ((dg.game_turn % 3) == 0 ? 1 : 0);
+            damage = ((session->dg.game_turn % 3) == 0 ? 1 : 0);
             break;
         case 6:
-            damage = ((dg.game_turn % 4) == 0 ? 1 : 0);
+            damage = ((session->dg.game_turn % 4) == 0 ? 1 : 0);
             break;
         default:
             damage = 0;
@@ -607,22 +574,22 @@ static void playerUpdatePoisonedState() {
 }
 
 static void playerUpdateFastness() {
-    if (py.flags.fast <= 0) {
+    if (session->py.flags.fast <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_FAST) == 0) {
-        py.flags.status |= config::player::status::PY_FAST;
+    if ((session->py.flags.status & config::player::status::PY_FAST) == 0) {
+        session->py.flags.status |= config::player::status::PY_FAST;
         playerChangeSpeed(-1);
 
         printMessage("You feel yourself moving faster.");
         playerDisturb(0, 0);
     }
 
-    py.flags.fast--;
+    session->py.flags.fast--;
 
-    if (py.flags.fast == 0) {
-        py.flags.status &= ~config::player::status::PY_FAST;
+    if (session->py.flags.fast == 0) {
+        session->py.flags.status &= ~config::player::status::PY_FAST;
         playerChangeSpeed(1);
 
         printMessage("You feel yourself slow down.");
@@ -631,22 +598,22 @@ static void playerUpdateFastness() {
 }
 
 static void playerUpdateSlowness() {
-    if (py.flags.slow <= 0) {
+    if (session->py.flags.slow <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_SLOW) == 0) {
-        py.flags.status |= config::player::status::PY_SLOW;
+    if ((session->py.flags.status & config::player::status::PY_SLOW) == 0) {
+        session->py.flags.status |= config::player::status::PY_SLOW;
         playerChangeSpeed(1);
 
         printMessage("You feel yourself moving slower.");
         playerDisturb(0, 0);
     }
 
-    py.flags.slow--;
+    session->py.flags.slow--;
 
-    if (py.flags.slow == 0) {
-        py.flags.status &= ~config::player::status::PY_SLOW;
+    if (session->py.flags.slow == 0) {
+        session->py.flags.status &= ~config::player::status::PY_SLOW;
         playerChangeSpeed(-1);
 
         printMessage("You feel yourself speed up.");
@@ -661,18 +628,18 @@ static void playerUpdateSpeed() {
 
 // Resting is over?
 static void playerUpdateRestingState() {
-    if (py.flags.rest > 0) {
-        py.flags.rest--;
+    if (session->py.flags.rest > 0) {
+        session->py.flags.rest--;
 
         // Resting over
-        if (py.flags.rest == 0) {
+        if (session->py.flags.rest == 0) {
             playerRestOff();
         }
-    } else if (py.flags.rest < 0) {
+    } else if (session->py.flags.rest < 0) {
         // Rest until reach max mana and max hit points.
-        py.flags.rest++;
+        session->py.flags.rest++;
 
-        if ((py.misc.current_hp == py.misc.max_hp && py.misc.current_mana == py.misc.mana) || py.flags.rest == 0) {
+        if ((session->py.misc.current_hp == session->py.misc.max_hp && session->py.misc.current_mana == session->py.misc.mana) || session->py.flags.rest == 0) {
             playerRestOff();
         }
     }
@@ -680,68 +647,68 @@ static void playerUpdateRestingState() {
 
 // Hallucinating?   (Random characters appear!)
 static void playerUpdateHallucination() {
-    if (py.flags.image <= 0) {
+    if (session->py.flags.image <= 0) {
         return;
     }
 
     playerEndRunning();
 
-    py.flags.image--;
+    session->py.flags.image--;
 
-    if (py.flags.image == 0) {
+    if (session->py.flags.image == 0) {
         // Used to draw entire screen! -CJS-
         drawDungeonPanel();
     }
 }
 
 static void playerUpdateParalysis() {
-    if (py.flags.paralysis <= 0) {
+    if (session->py.flags.paralysis <= 0) {
         return;
     }
 
     // when paralysis true, you can not see any movement that occurs
-    py.flags.paralysis--;
+    session->py.flags.paralysis--;
 
     playerDisturb(1, 0);
 }
 
 // Protection from evil counter
 static void playerUpdateEvilProtection() {
-    if (py.flags.protect_evil <= 0) {
+    if (session->py.flags.protect_evil <= 0) {
         return;
     }
 
-    py.flags.protect_evil--;
+    session->py.flags.protect_evil--;
 
-    if (py.flags.protect_evil == 0) {
+    if (session->py.flags.protect_evil == 0) {
         printMessage("You no longer feel safe from evil.");
     }
 }
 
 static void playerUpdateInvulnerability() {
-    if (py.flags.invulnerability <= 0) {
+    if (session->py.flags.invulnerability <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_INVULN) == 0) {
-        py.flags.status |= config::player::status::PY_INVULN;
+    if ((session->py.flags.status & config::player::status::PY_INVULN) == 0) {
+        session->py.flags.status |= config::player::status::PY_INVULN;
         playerDisturb(0, 0);
 
-        py.misc.ac += 100;
-        py.misc.display_ac += 100;
+        session->py.misc.ac += 100;
+        session->py.misc.display_ac += 100;
 
         printCharacterCurrentArmorClass();
         printMessage("Your skin turns into steel!");
     }
 
-    py.flags.invulnerability--;
+    session->py.flags.invulnerability--;
 
-    if (py.flags.invulnerability == 0) {
-        py.flags.status &= ~config::player::status::PY_INVULN;
+    if (session->py.flags.invulnerability == 0) {
+        session->py.flags.status &= ~config::player::status::PY_INVULN;
         playerDisturb(0, 0);
 
-        py.misc.ac -= 100;
-        py.misc.display_ac -= 100;
+        session->py.misc.ac -= 100;
+        session->py.misc.display_ac -= 100;
 
         printCharacterCurrentArmorClass();
         printMessage("Your skin returns to normal.");
@@ -749,33 +716,33 @@ static void playerUpdateInvulnerability() {
 }
 
 static void playerUpdateBlessedness() {
-    if (py.flags.blessed <= 0) {
+    if (session->py.flags.blessed <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_BLESSED) == 0) {
-        py.flags.status |= config::player::status::PY_BLESSED;
+    if ((session->py.flags.status & config::player::status::PY_BLESSED) == 0) {
+        session->py.flags.status |= config::player::status::PY_BLESSED;
         playerDisturb(0, 0);
 
-        py.misc.bth += 5;
-        py.misc.bth_with_bows += 5;
-        py.misc.ac += 2;
-        py.misc.display_ac += 2;
+        session->py.misc.bth += 5;
+        session->py.misc.bth_with_bows += 5;
+        session->py.misc.ac += 2;
+        session->py.misc.display_ac += 2;
 
         printMessage("You feel righteous!");
         printCharacterCurrentArmorClass();
     }
 
-    py.flags.blessed--;
+    session->py.flags.blessed--;
 
-    if (py.flags.blessed == 0) {
-        py.flags.status &= ~config::player::status::PY_BLESSED;
+    if (session->py.flags.blessed == 0) {
+        session->py.flags.status &= ~config::player::status::PY_BLESSED;
         playerDisturb(0, 0);
 
-        py.misc.bth -= 5;
-        py.misc.bth_with_bows -= 5;
-        py.misc.ac -= 2;
-        py.misc.display_ac -= 2;
+        session->py.misc.bth -= 5;
+        session->py.misc.bth_with_bows -= 5;
+        session->py.misc.ac -= 2;
+        session->py.misc.display_ac -= 2;
 
         printMessage("The prayer has expired.");
         printCharacterCurrentArmorClass();
@@ -784,46 +751,46 @@ static void playerUpdateBlessedness() {
 
 // Resist Heat
 static void playerUpdateHeatResistance() {
-    if (py.flags.heat_resistance <= 0) {
+    if (session->py.flags.heat_resistance <= 0) {
         return;
     }
 
-    py.flags.heat_resistance--;
+    session->py.flags.heat_resistance--;
 
-    if (py.flags.heat_resistance == 0) {
+    if (session->py.flags.heat_resistance == 0) {
         printMessage("You no longer feel safe from flame.");
     }
 }
 
 static void playerUpdateColdResistance() {
-    if (py.flags.cold_resistance <= 0) {
+    if (session->py.flags.cold_resistance <= 0) {
         return;
     }
 
-    py.flags.cold_resistance--;
+    session->py.flags.cold_resistance--;
 
-    if (py.flags.cold_resistance == 0) {
+    if (session->py.flags.cold_resistance == 0) {
         printMessage("You no longer feel safe from cold.");
     }
 }
 
 static void playerUpdateDetectInvisible() {
-    if (py.flags.detect_invisible <= 0) {
+    if (session->py.flags.detect_invisible <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_DET_INV) == 0) {
-        py.flags.status |= config::player::status::PY_DET_INV;
-        py.flags.see_invisible = true;
+    if ((session->py.flags.status & config::player::status::PY_DET_INV) == 0) {
+        session->py.flags.status |= config::player::status::PY_DET_INV;
+        session->py.flags.see_invisible = true;
 
         // light but don't move creatures
         updateMonsters(false);
     }
 
-    py.flags.detect_invisible--;
+    session->py.flags.detect_invisible--;
 
-    if (py.flags.detect_invisible == 0) {
-        py.flags.status &= ~config::player::status::PY_DET_INV;
+    if (session->py.flags.detect_invisible == 0) {
+        session->py.flags.status &= ~config::player::status::PY_DET_INV;
 
         // may still be able to see_invisible if wearing magic item
         playerRecalculateBonuses();
@@ -835,23 +802,23 @@ static void playerUpdateDetectInvisible() {
 
 // Timed infra-vision
 static void playerUpdateInfraVision() {
-    if (py.flags.timed_infra <= 0) {
+    if (session->py.flags.timed_infra <= 0) {
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_TIM_INFRA) == 0) {
-        py.flags.status |= config::player::status::PY_TIM_INFRA;
-        py.flags.see_infra++;
+    if ((session->py.flags.status & config::player::status::PY_TIM_INFRA) == 0) {
+        session->py.flags.status |= config::player::status::PY_TIM_INFRA;
+        session->py.flags.see_infra++;
 
         // light but don't move creatures
         updateMonsters(false);
     }
 
-    py.flags.timed_infra--;
+    session->py.flags.timed_infra--;
 
-    if (py.flags.timed_infra == 0) {
-        py.flags.status &= ~config::player::status::PY_TIM_INFRA;
-        py.flags.see_infra--;
+    if (session->py.flags.timed_infra == 0) {
+        session->py.flags.status &= ~config::player::status::PY_TIM_INFRA;
+        session->py.flags.see_infra--;
 
         // unlight but don't move creatures
         updateMonsters(false);
@@ -860,79 +827,79 @@ static void playerUpdateInfraVision() {
 
 // Word-of-Recall  Note: Word-of-Recall is a delayed action
 static void playerUpdateWordOfRecall() {
-    if (py.flags.word_of_recall <= 0) {
+    if (session->py.flags.word_of_recall <= 0) {
         return;
     }
 
-    if (py.flags.word_of_recall == 1) {
-        dg.generate_new_level = true;
+    if (session->py.flags.word_of_recall == 1) {
+        session->dg.generate_new_level = true;
 
-        py.flags.paralysis++;
-        py.flags.word_of_recall = 0;
+        session->py.flags.paralysis++;
+        session->py.flags.word_of_recall = 0;
 
-        if (dg.current_level > 0) {
-            dg.current_level = 0;
+        if (session->dg.current_level > 0) {
+            session->dg.current_level = 0;
             printMessage("You feel yourself yanked upwards!");
-        } else if (py.misc.max_dungeon_depth != 0) {
-            dg.current_level = py.misc.max_dungeon_depth;
+        } else if (session->py.misc.max_dungeon_depth != 0) {
+            session->dg.current_level = session->py.misc.max_dungeon_depth;
             printMessage("You feel yourself yanked downwards!");
         }
     } else {
-        py.flags.word_of_recall--;
+        session->py.flags.word_of_recall--;
     }
 }
 
 static void playerUpdateStatusFlags() {
-    if ((py.flags.status & config::player::status::PY_SPEED) != 0u) {
-        py.flags.status &= ~config::player::status::PY_SPEED;
+    if ((session->py.flags.status & config::player::status::PY_SPEED) != 0u) {
+        session->py.flags.status &= ~config::player::status::PY_SPEED;
         printCharacterSpeed();
     }
 
-    if (((py.flags.status & config::player::status::PY_PARALYSED) != 0u) && py.flags.paralysis < 1) {
+    if (((session->py.flags.status & config::player::status::PY_PARALYSED) != 0u) && session->py.flags.paralysis < 1) {
         printCharacterMovementState();
-        py.flags.status &= ~config::player::status::PY_PARALYSED;
-    } else if (py.flags.paralysis > 0) {
+        session->py.flags.status &= ~config::player::status::PY_PARALYSED;
+    } else if (session->py.flags.paralysis > 0) {
         printCharacterMovementState();
-        py.flags.status |= config::player::status::PY_PARALYSED;
-    } else if (py.flags.rest != 0) {
+        session->py.flags.status |= config::player::status::PY_PARALYSED;
+    } else if (session->py.flags.rest != 0) {
         printCharacterMovementState();
     }
 
-    if ((py.flags.status & config::player::status::PY_ARMOR) != 0) {
+    if ((session->py.flags.status & config::player::status::PY_ARMOR) != 0) {
         printCharacterCurrentArmorClass();
-        py.flags.status &= ~config::player::status::PY_ARMOR;
+        session->py.flags.status &= ~config::player::status::PY_ARMOR;
     }
 
-    if ((py.flags.status & config::player::status::PY_STATS) != 0) {
+    if ((session->py.flags.status & config::player::status::PY_STATS) != 0) {
         for (int n = 0; n < 6; n++) {
-            if (((config::player::status::PY_STR << n) & py.flags.status) != 0u) {
+            if (((config::player::status::PY_STR << n) & session->py.flags.status) != 0u) {
                 displayCharacterStats(n);
             }
         }
 
-        py.flags.status &= ~config::player::status::PY_STATS;
+        session->py.flags.status &= ~config::player::status::PY_STATS;
     }
 
-    if ((py.flags.status & config::player::status::PY_HP) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_HP) != 0u) {
         printCharacterMaxHitPoints();
         printCharacterCurrentHitPoints();
-        py.flags.status &= ~config::player::status::PY_HP;
+        session->py.flags.status &= ~config::player::status::PY_HP;
     }
 
-    if ((py.flags.status & config::player::status::PY_MANA) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_MANA) != 0u) {
         printCharacterCurrentMana();
-        py.flags.status &= ~config::player::status::PY_MANA;
+        session->py.flags.status &= ~config::player::status::PY_MANA;
     }
 }
 
 // Allow for a slim chance of detect enchantment -CJS-
 static void playerDetectEnchantment() {
     for (int i = 0; i < PLAYER_INVENTORY_SIZE; i++) {
-        if (i == py.pack.unique_items) {
+        if (i == session->py.pack.unique_items) {
             i = 22;
         }
 
-        Inventory_t &item = py.inventory[i];
+        Inventory_t &item = session->py.inventory[i];
 
         // if in inventory, succeed 1 out of 50 times,
         // if in equipment list, success 1 out of 10 times
@@ -993,7 +960,7 @@ static int getCommandRepeatCount(char &last_input_command) {
 }
 
 static char parseAlternateCtrlInput(char last_input_command) {
-    if (game.command_count > 0) {
+    if (session->game.command_count > 0) {
         printCharacterMovementState();
     }
 
@@ -1019,14 +986,14 @@ static void executeInputCommands(char &command, int &find_count) {
 
     // Accept a command and execute it
     do {
-        if ((py.flags.status & config::player::status::PY_REPEAT) != 0u) {
+        if ((session->py.flags.status & config::player::status::PY_REPEAT) != 0u) {
             printCharacterMovementState();
         }
 
-        game.use_last_direction = false;
-        game.player_free_turn = false;
+        session->game.use_last_direction = false;
+        session->game.player_free_turn = false;
 
-        if (py.running_tracker != 0) {
+        if (session->py.running_tracker != 0) {
             playerRunAndFind();
             find_count -= 1;
 
@@ -1034,28 +1001,34 @@ static void executeInputCommands(char &command, int &find_count) {
                 playerEndRunning();
             }
 
-            putQIO();
+            // The screen is only brought up to date once the run has ended,
+            // either here or when disturbed, not after every step. Unless
+            // the player asked to be shown at each step of the run.
+            if (session->py.running_tracker == 0 || session->options.run_print_self) {
+                putQIO();
+            }
             continue;
         }
 
-        if (game.doing_inventory_command != 0) {
-            inventoryExecuteCommand(game.doing_inventory_command);
+        if (session->game.doing_inventory_command != 0) {
+            inventoryExecuteCommand(session->game.doing_inventory_command);
             continue;
         }
 
         // move the cursor to the players character
-        panelMoveCursor(py.pos);
+        panelMoveCursor(session->py.pos);
 
-        message_ready_to_print = false;
+        session->message_ready_to_print = false;
 
-        if (game.command_count > 0) {
-            game.use_last_direction = true;
+        if (session->game.command_count > 0) {
+            session->game.use_last_direction = true;
         } else {
             last_input_command = getKeyInput();
 
             // Get a count for a command.
             int repeat_count = 0;
-            if ((config::options::use_roguelike_keys && last_input_command >= '0' && last_input_command <= '9') || (!config::options::use_roguelike_keys && last_input_command == '#')) {
+            if ((session->options.use_roguelike_keys && last_input_command >= '0' && last_input_command <= '9') || (!session->options.use_roguelike_keys &&
+                                                                                                                    last_input_command == '#')) {
                 repeat_count = getCommandRepeatCount(last_input_command);
             }
 
@@ -1065,20 +1038,20 @@ static void executeInputCommands(char &command, int &find_count) {
             }
 
             // move cursor to player char again, in case it moved
-            panelMoveCursor(py.pos);
+            panelMoveCursor(session->py.pos);
 
             // Commands are always converted to rogue form. -CJS-
-            if (!config::options::use_roguelike_keys) {
+            if (!session->options.use_roguelike_keys) {
                 last_input_command = originalCommands(last_input_command);
             }
 
             if (repeat_count > 0) {
                 if (!validCountCommand(last_input_command)) {
-                    game.player_free_turn = true;
+                    session->game.player_free_turn = true;
                     last_input_command = ' ';
                     printMessage("Invalid command with a count.");
                 } else {
-                    game.command_count = repeat_count;
+                    session->game.command_count = repeat_count;
                     printCharacterMovementState();
                 }
             }
@@ -1086,21 +1059,21 @@ static void executeInputCommands(char &command, int &find_count) {
 
         // Flash the message line.
         messageLineClear();
-        panelMoveCursor(py.pos);
+        panelMoveCursor(session->py.pos);
         putQIO();
 
         doCommand(last_input_command);
 
         // Find is counted differently, as the command changes.
-        if (py.running_tracker != 0) {
-            find_count = game.command_count - 1;
-            game.command_count = 0;
-        } else if (game.player_free_turn) {
-            game.command_count = 0;
-        } else if (game.command_count != 0) {
-            game.command_count--;
+        if (session->py.running_tracker != 0) {
+            find_count = session->game.command_count - 1;
+            session->game.command_count = 0;
+        } else if (session->game.player_free_turn) {
+            session->game.command_count = 0;
+        } else if (session->game.command_count != 0) {
+            session->game.command_count--;
         }
-    } while (game.player_free_turn && !dg.generate_new_level && (eof_flag == 0));
+    } while (session->game.player_free_turn && !session->dg.generate_new_level && (session->eof_flag == 0));
 
     command = last_input_command;
 }
@@ -1167,6 +1140,7 @@ static char originalCommands(char command) {
         case '{':
         case '?':
         case 'A':
+        case '_':
             break;
         case '1':
             command = 'b';
@@ -1307,6 +1281,8 @@ static char originalCommands(char command) {
             break;
         case CTRL_KEY('I'): // ^I = identify
             break;
+        case CTRL_KEY('S'): // ^S = combat simulation
+            break;
         case CTRL_KEY('L'): // ^L = wizlight
             command = '*';
             break;
@@ -1340,11 +1316,11 @@ static bool moveWithoutPickup(char *command) {
     int direction;
 
     // Save current game.command_count as getDirectionWithMemory() may change it
-    int count_save = game.command_count;
+    int count_save = session->game.command_count;
 
     if (getDirectionWithMemory(CNIL, direction)) {
         // Restore game.command_count
-        game.command_count = count_save;
+        session->game.command_count = count_save;
 
         switch (direction) {
             case 1:
@@ -1388,22 +1364,22 @@ static void commandQuit() {
     flushInputBuffer();
 
     if (getInputConfirmation("Do you really want to quit?")) {
-        game.character_is_dead = true;
-        dg.generate_new_level = true;
+        session->game.character_is_dead = true;
+        session->dg.generate_new_level = true;
 
-        (void) strcpy(game.character_died_from, "Quitting");
+        (void) strcpy(session->game.character_died_from, "Quitting");
     }
 }
 
 static uint8_t calculateMaxMessageCount() {
     uint8_t max_messages = MESSAGE_HISTORY_SIZE;
 
-    if (game.command_count > 0) {
-        if (game.command_count < MESSAGE_HISTORY_SIZE) {
-            max_messages = (uint8_t) game.command_count;
+    if (session->game.command_count > 0) {
+        if (session->game.command_count < MESSAGE_HISTORY_SIZE) {
+            max_messages = (uint8_t) session->game.command_count;
         }
-        game.command_count = 0;
-    } else if (game.last_command != CTRL_KEY('P')) {
+        session->game.command_count = 0;
+    } else if (session->game.last_command != CTRL_KEY('P')) {
         max_messages = 1;
     }
 
@@ -1416,19 +1392,19 @@ static void commandPreviousMessage() {
     if (max_messages <= 1) {
         // Distinguish real and recovered messages with a '>'. -CJS-
         putString(">", Coord_t{0, 0});
-        putStringClearToEOL(messages[last_message_id], Coord_t{0, 1});
+        putStringClearToEOL(session->messages[session->last_message_id], Coord_t{0, 1});
         return;
     }
 
     terminalSaveScreen();
 
     uint8_t line_number = max_messages;
-    int16_t msg_id = last_message_id;
+    int16_t msg_id = session->last_message_id;
 
     while (max_messages > 0) {
         max_messages--;
 
-        putStringClearToEOL(messages[msg_id], Coord_t{max_messages, 0});
+        putStringClearToEOL(session->messages[msg_id], Coord_t{max_messages, 0});
 
         if (msg_id == 0) {
             msg_id = MESSAGE_HISTORY_SIZE - 1;
@@ -1443,8 +1419,8 @@ static void commandPreviousMessage() {
 }
 
 static void commandFlipWizardMode() {
-    if (game.wizard_mode) {
-        game.wizard_mode = false;
+    if (session->game.wizard_mode) {
+        session->game.wizard_mode = false;
         printMessage("Wizard mode off.");
     } else if (enterWizardMode()) {
         printMessage("Wizard mode on.");
@@ -1454,33 +1430,33 @@ static void commandFlipWizardMode() {
 }
 
 static void commandSaveAndExit() {
-    if (game.total_winner) {
+    if (session->game.total_winner) {
         printMessage("You are a Total Winner,  your character must be retired.");
 
-        if (config::options::use_roguelike_keys) {
+        if (session->options.use_roguelike_keys) {
             printMessage("Use 'Q' to when you are ready to quit.");
         } else {
             printMessage("Use <Control>-K when you are ready to quit.");
         }
     } else {
-        (void) strcpy(game.character_died_from, "(saved)");
+        (void) strcpy(session->game.character_died_from, "(saved)");
         printMessage("Saving game...");
 
         if (saveGame()) {
             endGame();
         }
 
-        (void) strcpy(game.character_died_from, "(alive and well)");
+        (void) strcpy(session->game.character_died_from, "(alive and well)");
     }
 }
 
 static void commandLocateOnMap() {
-    if (py.flags.blind > 0 || playerNoLight()) {
+    if (session->py.flags.blind > 0 || playerNoLight()) {
         printMessage("You can't see your map.");
         return;
     }
 
-    Coord_t player_coord = py.pos;
+    Coord_t player_coord = session->py.pos;
     if (coordOutsidePanel(player_coord, true)) {
         drawDungeonPanel();
     }
@@ -1489,12 +1465,12 @@ static void commandLocateOnMap() {
     vtype_t out_val = {'\0'};
     vtype_t tmp_str = {'\0'};
 
-    Coord_t old_panel = Coord_t{dg.panel.row, dg.panel.col};
+    Coord_t old_panel = Coord_t{session->dg.panel.row, session->dg.panel.col};
     Coord_t panel = Coord_t{0, 0};
 
     while (true) {
-        panel.y = dg.panel.row;
-        panel.x = dg.panel.col;
+        panel.y = session->dg.panel.row;
+        panel.x = session->dg.panel.col;
 
         if (panel.y == old_panel.y && panel.x == old_panel.x) {
             tmp_str[0] = '\0';
@@ -1520,7 +1496,7 @@ static void commandLocateOnMap() {
             player_coord.x += ((dir_val - 1) % 3 - 1) * SCREEN_WIDTH / 2;
             player_coord.y -= ((dir_val - 1) / 3 - 1) * SCREEN_HEIGHT / 2;
 
-            if (player_coord.x < 0 || player_coord.y < 0 || player_coord.x >= dg.width || player_coord.y >= dg.width) {
+            if (player_coord.x < 0 || player_coord.y < 0 || player_coord.x >= session->dg.width || player_coord.y >= session->dg.width) {
                 printMessage("You've gone past the end of your map.");
 
                 player_coord.x -= ((dir_val - 1) % 3 - 1) * SCREEN_WIDTH / 2;
@@ -1537,13 +1513,27 @@ static void commandLocateOnMap() {
     }
 
     // Move to a new panel - but only if really necessary.
-    if (coordOutsidePanel(py.pos, false)) {
+    if (coordOutsidePanel(session->py.pos, false)) {
         drawDungeonPanel();
     }
 }
 
+// Travel to a symbol on the map, or go exploring
+static void commandTravel() {
+    if (session->py.flags.blind > 0 || playerNoLight()) {
+        printMessage("You can't see your map.");
+        session->game.player_free_turn = true;
+        return;
+    }
+
+    char symbol;
+    if (!getCommand("Travel to which symbol? ('_' to explore)", symbol) || !playerTravelInitialize(symbol)) {
+        session->game.player_free_turn = true;
+    }
+}
+
 static void commandToggleSearch() {
-    if ((py.flags.status & config::player::status::PY_SEARCH) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u) {
         playerSearchOff();
     } else {
         playerSearchOn();
@@ -1577,9 +1567,13 @@ static void doWizardCommands(char command) {
             // Print random level object to a file
             outputRandomLevelObjectsToFile();
             break;
+        case CTRL_KEY('S'):
+            // Simulate combat against all creatures, results to a file
+            wizardCombatSimulation();
+            break;
         case '\\':
             // Display wizard help
-            if (config::options::use_roguelike_keys) {
+            if (session->options.use_roguelike_keys) {
                 displayTextHelpFile(config::files::help_roguelike_wizard);
             } else {
                 displayTextHelpFile(config::files::help_wizard);
@@ -1620,7 +1614,7 @@ static void doWizardCommands(char command) {
             wizardCreateObjects();
             break;
         default:
-            if (config::options::use_roguelike_keys) {
+            if (session->options.use_roguelike_keys) {
                 putStringClearToEOL("Type '?' or '\\' for help.", Coord_t{0, 0});
             } else {
                 putStringClearToEOL("Type '?' or ^H for help.", Coord_t{0, 0});
@@ -1638,39 +1632,39 @@ static void doCommand(char command) {
     switch (command) {
         case 'Q': // (Q)uit    (^K)ill
             commandQuit();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case CTRL_KEY('P'): // (^P)revious message.
             commandPreviousMessage();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case CTRL_KEY('V'): // (^V)iew license
             displayTextHelpFile(config::files::license);
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case CTRL_KEY('W'): // (^W)izard mode
             commandFlipWizardMode();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case CTRL_KEY('X'): // e(^X)it and save
             commandSaveAndExit();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case '=': // (=) set options
             terminalSaveScreen();
             setGameOptions();
             terminalRestoreScreen();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case '{': // ({) inscribe an object
             itemInscribe();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case '!':    // (!) escape to the shell
         case '$':    // escaping to shell disabled -MRC-
         case ESCAPE: // (ESC)   do nothing.
         case ' ':    // (space) do nothing.
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'b': // (b) down, left  (1)
             playerMove(1, do_pickup);
@@ -1722,13 +1716,13 @@ static void doCommand(char command) {
             break;
         case '/': // (/) identify a symbol
             identifyGameObject();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case '.': // (.) stay in one place (5)
             playerMove(5, do_pickup);
 
-            if (game.command_count > 1) {
-                game.command_count--;
+            if (session->game.command_count > 1) {
+                session->game.command_count--;
                 playerRestOn();
             }
             break;
@@ -1739,12 +1733,12 @@ static void doCommand(char command) {
             dungeonGoDownLevel();
             break;
         case '?': // (?) help with commands
-            if (config::options::use_roguelike_keys) {
+            if (session->options.use_roguelike_keys) {
                 displayTextHelpFile(config::files::help_roguelike);
             } else {
                 displayTextHelpFile(config::files::help);
             }
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'f': // (f)orce    (B)ash
             playerBash();
@@ -1753,7 +1747,7 @@ static void doCommand(char command) {
             terminalSaveScreen();
             changeCharacterName();
             terminalRestoreScreen();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'D': // (D)isarm trap
             playerDisarmTrap();
@@ -1771,18 +1765,21 @@ static void doCommand(char command) {
             terminalSaveScreen();
             showScoresScreen();
             terminalRestoreScreen();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'W': // (W)here are we on the map  (L)ocate on map
             commandLocateOnMap();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'R': // (R)est a while
             playerRestOn();
             break;
+        case '_': // (_) travel to a symbol, (_ _) explore
+            commandTravel();
+            break;
         case '#': // (#) search toggle  (S)earch toggle
             commandToggleSearch();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case CTRL_KEY('B'): // (^B) tunnel down left  (T 1)
             playerTunnel(1);
@@ -1814,11 +1811,11 @@ static void doCommand(char command) {
             break;
         case 'M':
             dungeonDisplayMap();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'P': // (P)eruse a book  (B)rowse in a book
             examineBook();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'c': // (c)lose an object
             playerCloseDoor();
@@ -1840,7 +1837,7 @@ static void doCommand(char command) {
             break;
         case 'x': // e(x)amine surrounds  (l)ook about
             look();
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'm': // (m)agic spells
             getAndCastMagicSpell();
@@ -1858,7 +1855,7 @@ static void doCommand(char command) {
             scrollRead();
             break;
         case 's': // (s)earch for a turn
-            playerSearch(py.pos, py.misc.chance_in_search);
+            playerSearch(session->py.pos, session->py.misc.chance_in_search);
             break;
         case 'T': // (T)ake off something  (t)ake off
             inventoryExecuteCommand('t');
@@ -1868,7 +1865,7 @@ static void doCommand(char command) {
             break;
         case 'v': // (v)ersion of game
             displayTextHelpFile(config::files::versions_history);
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
             break;
         case 'w': // (w)ear or wield
             inventoryExecuteCommand('w');
@@ -1878,15 +1875,15 @@ static void doCommand(char command) {
             break;
         default:
             // Wizard commands are free moves
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
 
-            if (game.wizard_mode) {
+            if (session->game.wizard_mode) {
                 doWizardCommands(command);
             } else {
                 putStringClearToEOL("Type '?' for help.", Coord_t{0, 0});
             }
     }
-    game.last_command = command;
+    session->game.last_command = command;
 }
 
 // Check whether this command will accept a count. -CJS-
@@ -1982,68 +1979,68 @@ static bool validCountCommand(char command) {
 
 // Regenerate hit points -RAK-
 static void playerRegenerateHitPoints(int percent) {
-    int old_chp = py.misc.current_hp;
-    int32_t new_chp = (int32_t) py.misc.max_hp * percent + config::player::PLAYER_REGEN_HPBASE;
+    int old_chp = session->py.misc.current_hp;
+    int32_t new_chp = (int32_t) session->py.misc.max_hp * percent + config::player::PLAYER_REGEN_HPBASE;
 
     // div 65536
-    py.misc.current_hp += new_chp >> 16;
+    session->py.misc.current_hp += new_chp >> 16;
 
     // check for overflow
-    if (py.misc.current_hp < 0 && old_chp > 0) {
-        py.misc.current_hp = SHRT_MAX;
+    if (session->py.misc.current_hp < 0 && old_chp > 0) {
+        session->py.misc.current_hp = SHRT_MAX;
     }
 
     // mod 65536
-    int32_t new_chp_fraction = (new_chp & 0xFFFF) + py.misc.current_hp_fraction;
+    int32_t new_chp_fraction = (new_chp & 0xFFFF) + session->py.misc.current_hp_fraction;
 
     if (new_chp_fraction >= 0x10000L) {
-        py.misc.current_hp_fraction = (uint16_t)(new_chp_fraction - 0x10000L);
-        py.misc.current_hp++;
+        session->py.misc.current_hp_fraction = (uint16_t)(new_chp_fraction - 0x10000L);
+        session->py.misc.current_hp++;
     } else {
-        py.misc.current_hp_fraction = (uint16_t) new_chp_fraction;
+        session->py.misc.current_hp_fraction = (uint16_t) new_chp_fraction;
     }
 
     // must set frac to zero even if equal
-    if (py.misc.current_hp >= py.misc.max_hp) {
-        py.misc.current_hp = py.misc.max_hp;
-        py.misc.current_hp_fraction = 0;
+    if (session->py.misc.current_hp >= session->py.misc.max_hp) {
+        session->py.misc.current_hp = session->py.misc.max_hp;
+        session->py.misc.current_hp_fraction = 0;
     }
 
-    if (old_chp != py.misc.current_hp) {
+    if (old_chp != session->py.misc.current_hp) {
         printCharacterCurrentHitPoints();
     }
 }
 
 // Regenerate mana points -RAK-
 static void playerRegenerateMana(int percent) {
-    int old_cmana = py.misc.current_mana;
-    int32_t new_mana = (int32_t) py.misc.mana * percent + config::player::PLAYER_REGEN_MNBASE;
+    int old_cmana = session->py.misc.current_mana;
+    int32_t new_mana = (int32_t) session->py.misc.mana * percent + config::player::PLAYER_REGEN_MNBASE;
 
     // div 65536
-    py.misc.current_mana += new_mana >> 16;
+    session->py.misc.current_mana += new_mana >> 16;
 
     // check for overflow
-    if (py.misc.current_mana < 0 && old_cmana > 0) {
-        py.misc.current_mana = SHRT_MAX;
+    if (session->py.misc.current_mana < 0 && old_cmana > 0) {
+        session->py.misc.current_mana = SHRT_MAX;
     }
 
     // mod 65536
-    int32_t new_mana_fraction = (new_mana & 0xFFFF) + py.misc.current_mana_fraction;
+    int32_t new_mana_fraction = (new_mana & 0xFFFF) + session->py.misc.current_mana_fraction;
 
     if (new_mana_fraction >= 0x10000L) {
-        py.misc.current_mana_fraction = (uint16_t)(new_mana_fraction - 0x10000L);
-        py.misc.current_mana++;
+        session->py.misc.current_mana_fraction = (uint16_t)(new_mana_fraction - 0x10000L);
+        session->py.misc.current_mana++;
     } else {
-        py.misc.current_mana_fraction = (uint16_t) new_mana_fraction;
+        session->py.misc.current_mana_fraction = (uint16_t) new_mana_fraction;
     }
 
     // must set frac to zero even if equal
-    if (py.misc.current_mana >= py.misc.mana) {
-        py.misc.current_mana = py.misc.mana;
-        py.misc.current_mana_fraction = 0;
+    if (session->py.misc.current_mana >= session->py.misc.mana) {
+        session->py.misc.current_mana = session->py.misc.mana;
+        session->py.misc.current_mana_fraction = 0;
     }
 
-    if (old_cmana != py.misc.current_mana) {
+    if (old_cmana != session->py.misc.current_mana) {
         printCharacterCurrentMana();
     }
 }
@@ -2082,7 +2079,7 @@ static void examineBook() {
         return;
     }
 
-    if (py.flags.blind > 0) {
+    if (session->py.flags.blind > 0) {
         printMessage("You can't see to read your spell book!");
         return;
     }
@@ -2092,7 +2089,7 @@ static void examineBook() {
         return;
     }
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are too confused.");
         return;
     }
@@ -2102,13 +2099,13 @@ static void examineBook() {
         int spell_index[31];
         bool can_read = true;
 
-        uint8_t treasure_type = py.inventory[item_id].category_id;
+        uint8_t treasure_type = session->py.inventory[item_id].category_id;
 
-        if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+        if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
             if (treasure_type != TV_MAGIC_BOOK) {
                 can_read = false;
             }
-        } else if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
+        } else if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
             if (treasure_type != TV_PRAYER_BOOK) {
                 can_read = false;
             }
@@ -2121,13 +2118,13 @@ static void examineBook() {
             return;
         }
 
-        uint32_t item_flags = py.inventory[item_id].flags;
+        uint32_t item_flags = session->py.inventory[item_id].flags;
 
         int spell_id = 0;
         while (item_flags != 0u) {
             item_pos_end = getAndClearFirstBit(item_flags);
 
-            if (magic_spells[py.misc.class_id - 1][item_pos_end].level_required < 99) {
+            if (magic_spells[session->py.misc.class_id - 1][item_pos_end].level_required < 99) {
                 spell_index[spell_id] = item_pos_end;
                 spell_id++;
             }
@@ -2142,43 +2139,43 @@ static void examineBook() {
 
 // Go up one level -RAK-
 static void dungeonGoUpLevel() {
-    uint8_t tile_id = dg.floor[py.pos.y][py.pos.x].treasure_id;
+    uint8_t tile_id = session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id;
 
-    if (tile_id != 0 && game.treasure.list[tile_id].category_id == TV_UP_STAIR) {
-        dg.current_level--;
+    if (tile_id != 0 && session->game.treasure.list[tile_id].category_id == TV_UP_STAIR) {
+        session->dg.current_level--;
 
         printMessage("You enter a maze of up staircases.");
         printMessage("You pass through a one-way door.");
 
-        dg.generate_new_level = true;
+        session->dg.generate_new_level = true;
     } else {
         printMessage("I see no up staircase here.");
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
     }
 }
 
 // Go down one level -RAK-
 static void dungeonGoDownLevel() {
-    uint8_t tile_id = dg.floor[py.pos.y][py.pos.x].treasure_id;
+    uint8_t tile_id = session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id;
 
-    if (tile_id != 0 && game.treasure.list[tile_id].category_id == TV_DOWN_STAIR) {
-        dg.current_level++;
+    if (tile_id != 0 && session->game.treasure.list[tile_id].category_id == TV_DOWN_STAIR) {
+        session->dg.current_level++;
 
         printMessage("You enter a maze of down staircases.");
         printMessage("You pass through a one-way door.");
 
-        dg.generate_new_level = true;
+        session->dg.generate_new_level = true;
     } else {
         printMessage("I see no down staircase here.");
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
     }
 }
 
 // Jam a closed door -RAK-
 static void dungeonJamDoor() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
-    Coord_t coord = py.pos;
+    Coord_t coord = session->py.pos;
 
     int direction;
     if (!getDirectionWithMemory(CNIL, direction)) {
@@ -2186,14 +2183,14 @@ static void dungeonJamDoor() {
     }
     (void) playerMovePosition(direction, coord);
 
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
     if (tile.treasure_id == 0) {
         printMessage("That isn't a door!");
         return;
     }
 
-    Inventory_t &item = game.treasure.list[tile.treasure_id];
+    Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
     uint8_t item_id = item.category_id;
     if (item_id != TV_CLOSED_DOOR && item_id != TV_OPEN_DOOR) {
@@ -2211,7 +2208,7 @@ static void dungeonJamDoor() {
     if (tile.creature_id == 0) {
         int item_pos_start, item_pos_end;
         if (inventoryFindRange(TV_SPIKE, TV_NEVER, item_pos_start, item_pos_end)) {
-            game.player_free_turn = false;
+            session->game.player_free_turn = false;
 
             printMessageNoCommandInterrupt("You jam the door with a spike.");
 
@@ -2224,9 +2221,9 @@ static void dungeonJamDoor() {
             // Series is: 0 20 30 37 43 48 52 56 60 64 67 70 ...
             item.misc_use -= 1 + 190 / (10 - item.misc_use);
 
-            if (py.inventory[item_pos_start].items_count > 1) {
-                py.inventory[item_pos_start].items_count--;
-                py.pack.weight -= py.inventory[item_pos_start].weight;
+            if (session->py.inventory[item_pos_start].items_count > 1) {
+                session->py.inventory[item_pos_start].items_count--;
+                session->py.pack.weight -= session->py.inventory[item_pos_start].weight;
             } else {
                 inventoryDestroyItem(item_pos_start);
             }
@@ -2234,19 +2231,19 @@ static void dungeonJamDoor() {
             printMessage("But you have no spikes.");
         }
     } else {
-        game.player_free_turn = false;
+        session->game.player_free_turn = false;
 
         vtype_t msg = {'\0'};
-        (void) sprintf(msg, "The %s is in your way!", creatures_list[monsters[tile.creature_id].creature_id].name);
+        (void) sprintf(msg, "The %s is in your way!", creatures_list[session->monsters[tile.creature_id].creature_id].name);
         printMessage(msg);
     }
 }
 
 // Refill the players lamp -RAK-
 static void inventoryRefillLamp() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
-    if (py.inventory[PlayerEquipment::Light].sub_category_id != 0) {
+    if (session->py.inventory[PlayerEquipment::Light].sub_category_id != 0) {
         printMessage("But you are not using a lamp.");
         return;
     }
@@ -2257,10 +2254,10 @@ static void inventoryRefillLamp() {
         return;
     }
 
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
-    Inventory_t &item = py.inventory[PlayerEquipment::Light];
-    item.misc_use += py.inventory[item_pos_start].misc_use;
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Light];
+    item.misc_use += session->py.inventory[item_pos_start].misc_use;
 
     if (item.misc_use > config::treasure::OBJECT_LAMP_MAX_CAPACITY) {
         item.misc_use = config::treasure::OBJECT_LAMP_MAX_CAPACITY;
@@ -2289,7 +2286,7 @@ static void playDungeon() {
     int find_count = 0;
 
     // Ensure we display the panel. Used to do this with a global var. -CJS-
-    dg.panel.row = dg.panel.col = -1;
+    session->dg.panel.row = session->dg.panel.col = -1;
 
     // Light up the area around character
     dungeonResetView();
@@ -2297,7 +2294,7 @@ static void playDungeon() {
     // must do this after `dg.panel.row` / `dg.panel.col` set to -1, because playerSearchOff() will
     // call dungeonResetView(), and so the panel_* variables must be valid before
     // playerSearchOff() is called
-    if ((py.flags.status & config::player::status::PY_SEARCH) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u) {
         playerSearchOff();
     }
 
@@ -2315,10 +2312,10 @@ static void playDungeon() {
     // Exit when `dg.generate_new_level` and `eof_flag` are both set
     do {
         // Increment turn counter
-        dg.game_turn++;
+        session->dg.game_turn++;
 
         // turn over the store contents every, say, 1000 turns
-        if (dg.current_level != 0 && dg.game_turn % 1000 == 0) {
+        if (session->dg.current_level != 0 && session->dg.game_turn % 1000 == 0) {
             storeMaintenance();
         }
 
@@ -2347,8 +2344,8 @@ static void playDungeon() {
         playerUpdateRestingState();
 
         // Check for interrupts to find or rest.
-        int microseconds = (py.running_tracker != 0 ? 0 : 10000);
-        if ((game.command_count > 0 || (py.running_tracker != 0) || py.flags.rest != 0) && checkForNonBlockingKeyPress(microseconds)) {
+        int microseconds = (session->py.running_tracker != 0 ? 0 : 10000);
+        if ((session->game.command_count > 0 || (session->py.running_tracker != 0) || session->py.flags.rest != 0) && checkForNonBlockingKeyPress(microseconds)) {
             playerDisturb(0, 0);
         }
 
@@ -2364,17 +2361,17 @@ static void playDungeon() {
         playerUpdateWordOfRecall();
 
         // Random teleportation
-        if (py.flags.teleport && randomNumber(100) == 1) {
+        if (session->py.flags.teleport && randomNumber(100) == 1) {
             playerDisturb(0, 0);
             playerTeleport(40);
         }
 
         // See if we are too weak to handle the weapon or pack. -CJS-
-        if ((py.flags.status & config::player::status::PY_STR_WGT) != 0u) {
+        if ((session->py.flags.status & config::player::status::PY_STR_WGT) != 0u) {
             playerStrength();
         }
 
-        if ((py.flags.status & config::player::status::PY_STUDY) != 0u) {
+        if ((session->py.flags.status & config::player::status::PY_STUDY) != 0u) {
             printCharacterStudyInstruction();
         }
 
@@ -2383,8 +2380,8 @@ static void playDungeon() {
         // Allow for a slim chance of detect enchantment -CJS-
         // for 1st level char, check once every 2160 turns
         // for 40th level char, check once every 416 turns
-        int chance = 10 + 750 / (5 + py.misc.level);
-        if ((dg.game_turn & 0xF) == 0 && py.flags.confused == 0 && randomNumber(chance) == 1) {
+        int chance = 10 + 750 / (5 + session->py.misc.level);
+        if ((session->dg.game_turn & 0xF) == 0 && session->py.flags.confused == 0 && randomNumber(chance) == 1) {
             playerDetectEnchantment();
         }
 
@@ -2393,28 +2390,28 @@ static void playDungeon() {
         // creature.c when monsters try to multiply.  Compact_monsters() is
         // much more likely to succeed if called from here, than if called
         // from within updateMonsters().
-        if (MON_TOTAL_ALLOCATIONS - next_free_monster_id < 10) {
+        if (MON_TOTAL_ALLOCATIONS - session->next_free_monster_id < 10) {
             (void) compactMonsters();
         }
 
         // Accept a command?
-        if (py.flags.paralysis < 1 && py.flags.rest == 0 && !game.character_is_dead) {
+        if (session->py.flags.paralysis < 1 && session->py.flags.rest == 0 && !session->game.character_is_dead) {
             executeInputCommands(last_input_command, find_count);
         } else {
             // if paralyzed, resting, or dead, flush output
             // but first move the cursor onto the player, for aesthetics
-            panelMoveCursor(py.pos);
+            panelMoveCursor(session->py.pos);
             putQIO();
         }
 
         // Teleport?
-        if (game.teleport_player) {
+        if (session->game.teleport_player) {
             playerTeleport(100);
         }
 
         // Move the creatures
-        if (!dg.generate_new_level) {
+        if (!session->dg.generate_new_level) {
             updateMonsters(true);
         }
-    } while (!dg.generate_new_level && (eof_flag == 0));
+    } while (!session->dg.generate_new_level && (session->eof_flag == 0));
 }
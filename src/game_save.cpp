@@ -29,6 +29,9 @@ static void wrShorts(uint16_t *value, int count);
 static void wrItem(Inventory_t &item);
 static void wrMonster(Monster_t const &monster);
 
+static long wrSectionStart();
+static bool wrSectionEnd(long start);
+
 static uint8_t getByte();
 
 static bool rdBool();
@@ -42,11 +45,22 @@ static void rdShorts(uint16_t *value, int count);
 static void rdItem(Inventory_t &item);
 static void rdMonster(Monster_t &monster);
 
-// these are used for the save file, to avoid having to pass them to every procedure
-static FILE *fileptr;
-static uint8_t xor_byte;
-static int from_save_file;   // can overwrite old save file when save
-static uint32_t start_time; // time that play started
+static bool rdSectionStart(long &end);
+
+// The save file being read or written, and its xor_byte, are kept in the
+// session: restoring a game can stop part way to wait for a key.
+
+// After the version and first xor_byte, a save is laid out in sections:
+//
+//   preview    who the character is, for listing saves without restoring them
+//   character  monster memory, options, the player, and the stores
+//   level      the dungeon level being played, left out for a dead character
+//
+// Each section starts with its length and a fresh xor_byte, so any one of
+// them can be read, or skipped, without decoding those before it. Older
+// saves have no sections and start with the monster memory, whose first
+// short can never be SAVE_SECTIONED.
+constexpr uint16_t SAVE_SECTIONED = 0xFFFE;
 
 // This save package was brought to by                -JWT-
 // and                                                -RAK-
@@ -59,14 +73,19 @@ bool saveGame() {
     vtype_t input = {'\0'};
     std::string output;
 
-    while (!saveChar(config::files::save_game)) {
-        output = "Save file '" + config::files::save_game + "' fails.";
+    while (!saveChar(session->save_game)) {
+        output = "Save file '" + session->save_game + "' fails.";
         printMessage(output.c_str());
 
+        // Someone playing over a connection has no say in the server's files
+        if (session->terminal_link != nullptr) {
+            return false;
+        }
+
         int i = 0;
-        if (access(config::files::save_game.c_str(), 0) < 0 || !getInputConfirmation("File exists. Delete old save file?") || (i = unlink(config::files::save_game.c_str())) < 0) {
+        if (access(session->save_game.c_str(), 0) < 0 || !getInputConfirmation("File exists. Delete old save file?") || (i = unlink(session->save_game.c_str())) < 0) {
             if (i < 0) {
-                output = "Can't delete '" + config::files::save_game + "'";
+                output = "Can't delete '" + session->save_game + "'";
                 printMessage(output.c_str());
             }
             putStringClearToEOL("New Save file [ESC to give up]:", Coord_t{0, 0});
@@ -74,11 +93,11 @@ bool saveGame() {
                 return false;
             }
             if (input[0] != 0) {
-                // (void) strcpy(config::files::save_game, input);
-                config::files::save_game = input;
+                // (void) strcpy(session->save_game, input);
+                session->save_game = input;
             }
         }
-        output = "Saving with '" + config::files::save_game + "'...";
+        output = "Saving with '" + session->save_game + "'...";
         putStringClearToEOL(output, Coord_t{0, 0});
     }
 
@@ -88,55 +107,76 @@ bool saveGame() {
 static bool svWrite() {
     // clear the game.character_is_dead flag when creating a HANGUP save file,
     // so that player can see tombstone when restart
-    if (eof_flag != 0) {
-        game.character_is_dead = false;
+    if (session->eof_flag != 0) {
+        session->game.character_is_dead = false;
     }
 
     uint32_t l = 0;
 
-    if (config::options::run_cut_corners) {
+    if (session->options.run_cut_corners) {
         l |= 0x1;
     }
-    if (config::options::run_examine_corners) {
+    if (session->options.run_examine_corners) {
         l |= 0x2;
     }
-    if (config::options::run_print_self) {
+    if (session->options.run_print_self) {
         l |= 0x4;
     }
-    if (config::options::find_bound) {
+    if (session->options.find_bound) {
         l |= 0x8;
     }
-    if (config::options::prompt_to_pickup) {
+    if (session->options.prompt_to_pickup) {
         l |= 0x10;
     }
-    if (config::options::use_roguelike_keys) {
+    if (session->options.use_roguelike_keys) {
         l |= 0x20;
     }
-    if (config::options::show_inventory_weights) {
+    if (session->options.show_inventory_weights) {
         l |= 0x40;
     }
-    if (config::options::highlight_seams) {
+    if (session->options.highlight_seams) {
         l |= 0x80;
     }
-    if (config::options::run_ignore_doors) {
+    if (session->options.run_ignore_doors) {
         l |= 0x100;
     }
-    if (config::options::error_beep_sound) {
+    if (session->options.error_beep_sound) {
         l |= 0x200;
     }
-    if (config::options::display_counts) {
+    if (session->options.display_counts) {
         l |= 0x400;
     }
-    if (game.character_is_dead) {
+    // the random number engine must be known before the magic item
+    // names and town can be rebuilt from their seeds
+    l |= (uint32_t) getRandomEngine() << 16;
+
+    if (session->game.character_is_dead) {
         // Sign bit
         l |= 0x80000000L;
     }
-    if (game.total_winner) {
+    if (session->game.total_winner) {
         l |= 0x40000000L;
     }
 
+    wrShort(SAVE_SECTIONED);
+
+    long section = wrSectionStart();
+    wrString(session->py.misc.name);
+    wrByte(session->py.misc.race_id);
+    wrByte(session->py.misc.class_id);
+    wrShort(session->py.misc.level);
+    wrShort((uint16_t) session->dg.current_level);
+    wrLong((uint32_t) session->dg.game_turn);
+    wrBool(session->game.character_is_dead);
+    wrBool(session->game.total_winner);
+    if (!wrSectionEnd(section)) {
+        return false;
+    }
+
+    section = wrSectionStart();
+
     for (int i = 0; i < MON_MAX_CREATURES; i++) {
-        Recall_t &r = creature_recall[i];
+        Recall_t &r = session->creature_recall[i];
         if (r.movement || r.defenses || r.kills || r.spells || r.deaths || r.attacks[0] || r.attacks[1] || r.attacks[2] || r.attacks[3]) {
             wrShort((uint16_t) i);
             wrLong(r.movement);
@@ -155,127 +195,127 @@ static bool svWrite() {
 
     wrLong(l);
 
-    wrString(py.misc.name);
-    wrBool(py.misc.gender);
-    wrLong((uint32_t) py.misc.au);
-    wrLong((uint32_t) py.misc.max_exp);
-    wrLong((uint32_t) py.misc.exp);
-    wrShort(py.misc.exp_fraction);
-    wrShort(py.misc.age);
-    wrShort(py.misc.height);
-    wrShort(py.misc.weight);
-    wrShort(py.misc.level);
-    wrShort(py.misc.max_dungeon_depth);
-    wrShort((uint16_t) py.misc.chance_in_search);
-    wrShort((uint16_t) py.misc.fos);
-    wrShort((uint16_t) py.misc.bth);
-    wrShort((uint16_t) py.misc.bth_with_bows);
-    wrShort((uint16_t) py.misc.mana);
-    wrShort((uint16_t) py.misc.max_hp);
-    wrShort((uint16_t) py.misc.plusses_to_hit);
-    wrShort((uint16_t) py.misc.plusses_to_damage);
-    wrShort((uint16_t) py.misc.ac);
-    wrShort((uint16_t) py.misc.magical_ac);
-    wrShort((uint16_t) py.misc.display_to_hit);
-    wrShort((uint16_t) py.misc.display_to_damage);
-    wrShort((uint16_t) py.misc.display_ac);
-    wrShort((uint16_t) py.misc.display_to_ac);
-    wrShort((uint16_t) py.misc.disarm);
-    wrShort((uint16_t) py.misc.saving_throw);
-    wrShort((uint16_t) py.misc.social_class);
-    wrShort((uint16_t) py.misc.stealth_factor);
-    wrByte(py.misc.class_id);
-    wrByte(py.misc.race_id);
-    wrByte(py.misc.hit_die);
-    wrByte(py.misc.experience_factor);
-    wrShort((uint16_t) py.misc.current_mana);
-    wrShort(py.misc.current_mana_fraction);
-    wrShort((uint16_t) py.misc.current_hp);
-    wrShort(py.misc.current_hp_fraction);
-    for (auto &entry : py.misc.history) {
+    wrString(session->py.misc.name);
+    wrBool(session->py.misc.gender);
+    wrLong((uint32_t) session->py.misc.au);
+    wrLong((uint32_t) session->py.misc.max_exp);
+    wrLong((uint32_t) session->py.misc.exp);
+    wrShort(session->py.misc.exp_fraction);
+    wrShort(session->py.misc.age);
+    wrShort(session->py.misc.height);
+    wrShort(session->py.misc.weight);
+    wrShort(session->py.misc.level);
+    wrShort(session->py.misc.max_dungeon_depth);
+    wrShort((uint16_t) session->py.misc.chance_in_search);
+    wrShort((uint16_t) session->py.misc.fos);
+    wrShort((uint16_t) session->py.misc.bth);
+    wrShort((uint16_t) session->py.misc.bth_with_bows);
+    wrShort((uint16_t) session->py.misc.mana);
+    wrShort((uint16_t) session->py.misc.max_hp);
+    wrShort((uint16_t) session->py.misc.plusses_to_hit);
+    wrShort((uint16_t) session->py.misc.plusses_to_damage);
+    wrShort((uint16_t) session->py.misc.ac);
+    wrShort((uint16_t) session->py.misc.magical_ac);
+    wrShort((uint16_t) session->py.misc.display_to_hit);
+    wrShort((uint16_t) session->py.misc.display_to_damage);
+    wrShort((uint16_t) session->py.misc.display_ac);
+    wrShort((uint16_t) session->py.misc.display_to_ac);
+    wrShort((uint16_t) session->py.misc.disarm);
+    wrShort((uint16_t) session->py.misc.saving_throw);
+    wrShort((uint16_t) session->py.misc.social_class);
+    wrShort((uint16_t) session->py.misc.stealth_factor);
+    wrByte(session->py.misc.class_id);
+    wrByte(session->py.misc.race_id);
+    wrByte(session->py.misc.hit_die);
+    wrByte(session->py.misc.experience_factor);
+    wrShort((uint16_t) session->py.misc.current_mana);
+    wrShort(session->py.misc.current_mana_fraction);
+    wrShort((uint16_t) session->py.misc.current_hp);
+    wrShort(session->py.misc.current_hp_fraction);
+    for (auto &entry : session->py.misc.history) {
         wrString(entry);
     }
 
-    wrBytes(py.stats.max, 6);
-    wrBytes(py.stats.current, 6);
-    wrShorts((uint16_t *) py.stats.modified, 6);
-    wrBytes(py.stats.used, 6);
-
-    wrLong(py.flags.status);
-    wrShort((uint16_t) py.flags.rest);
-    wrShort((uint16_t) py.flags.blind);
-    wrShort((uint16_t) py.flags.paralysis);
-    wrShort((uint16_t) py.flags.confused);
-    wrShort((uint16_t) py.flags.food);
-    wrShort((uint16_t) py.flags.food_digested);
-    wrShort((uint16_t) py.flags.protection);
-    wrShort((uint16_t) py.flags.speed);
-    wrShort((uint16_t) py.flags.fast);
-    wrShort((uint16_t) py.flags.slow);
-    wrShort((uint16_t) py.flags.afraid);
-    wrShort((uint16_t) py.flags.poisoned);
-    wrShort((uint16_t) py.flags.image);
-    wrShort((uint16_t) py.flags.protect_evil);
-    wrShort((uint16_t) py.flags.invulnerability);
-    wrShort((uint16_t) py.flags.heroism);
-    wrShort((uint16_t) py.flags.super_heroism);
-    wrShort((uint16_t) py.flags.blessed);
-    wrShort((uint16_t) py.flags.heat_resistance);
-    wrShort((uint16_t) py.flags.cold_resistance);
-    wrShort((uint16_t) py.flags.detect_invisible);
-    wrShort((uint16_t) py.flags.word_of_recall);
-    wrShort((uint16_t) py.flags.see_infra);
-    wrShort((uint16_t) py.flags.timed_infra);
-    wrBool(py.flags.see_invisible);
-    wrBool(py.flags.teleport);
-    wrBool(py.flags.free_action);
-    wrBool(py.flags.slow_digest);
-    wrBool(py.flags.aggravate);
-    wrBool(py.flags.resistant_to_fire);
-    wrBool(py.flags.resistant_to_cold);
-    wrBool(py.flags.resistant_to_acid);
-    wrBool(py.flags.regenerate_hp);
-    wrBool(py.flags.resistant_to_light);
-    wrBool(py.flags.free_fall);
-    wrBool(py.flags.sustain_str);
-    wrBool(py.flags.sustain_int);
-    wrBool(py.flags.sustain_wis);
-    wrBool(py.flags.sustain_con);
-    wrBool(py.flags.sustain_dex);
-    wrBool(py.flags.sustain_chr);
-    wrBool(py.flags.confuse_monster);
-    wrByte(py.flags.new_spells_to_learn);
-
-    wrShort((uint16_t) missiles_counter);
-    wrLong((uint32_t) dg.game_turn);
-    wrShort((uint16_t) py.pack.unique_items);
-    for (int i = 0; i < py.pack.unique_items; i++) {
-        wrItem(py.inventory[i]);
+    wrBytes(session->py.stats.max, 6);
+    wrBytes(session->py.stats.current, 6);
+    wrShorts((uint16_t *) session->py.stats.modified, 6);
+    wrBytes(session->py.stats.used, 6);
+
+    wrLong(session->py.flags.status);
+    wrShort((uint16_t) session->py.flags.rest);
+    wrShort((uint16_t) session->py.flags.blind);
+    wrShort((uint16_t) session->py.flags.paralysis);
+    wrShort((uint16_t) session->py.flags.confused);
+    wrShort((uint16_t) session->py.flags.food);
+    wrShort((uint16_t) session->py.flags.food_digested);
+    wrShort((uint16_t) session->py.flags.protection);
+    wrShort((uint16_t) session->py.flags.speed);
+    wrShort((uint16_t) session->py.flags.fast);
+    wrShort((uint16_t) session->py.flags.slow);
+    wrShort((uint16_t) session->py.flags.afraid);
+    wrShort((uint16_t) session->py.flags.poisoned);
+    wrShort((uint16_t) session->py.flags.image);
+    wrShort((uint16_t) session->py.flags.protect_evil);
+    wrShort((uint16_t) session->py.flags.invulnerability);
+    wrShort((uint16_t) session->py.flags.heroism);
+    wrShort((uint16_t) session->py.flags.super_heroism);
+    wrShort((uint16_t) session->py.flags.blessed);
+    wrShort((uint16_t) session->py.flags.heat_resistance);
+    wrShort((uint16_t) session->py.flags.cold_resistance);
+    wrShort((uint16_t) session->py.flags.detect_invisible);
+    wrShort((uint16_t) session->py.flags.word_of_recall);
+    wrShort((uint16_t) session->py.flags.see_infra);
+    wrShort((uint16_t) session->py.flags.timed_infra);
+    wrBool(session->py.flags.see_invisible);
+    wrBool(session->py.flags.teleport);
+    wrBool(session->py.flags.free_action);
+    wrBool(session->py.flags.slow_digest);
+    wrBool(session->py.flags.aggravate);
+    wrBool(session->py.flags.resistant_to_fire);
+    wrBool(session->py.flags.resistant_to_cold);
+    wrBool(session->py.flags.resistant_to_acid);
+    wrBool(session->py.flags.regenerate_hp);
+    wrBool(session->py.flags.resistant_to_light);
+    wrBool(session->py.flags.free_fall);
+    wrBool(session->py.flags.sustain_str);
+    wrBool(session->py.flags.sustain_int);
+    wrBool(session->py.flags.sustain_wis);
+    wrBool(session->py.flags.sustain_con);
+    wrBool(session->py.flags.sustain_dex);
+    wrBool(session->py.flags.sustain_chr);
+    wrBool(session->py.flags.confuse_monster);
+    wrByte(session->py.flags.new_spells_to_learn);
+
+    wrShort((uint16_t) session->missiles_counter);
+    wrLong((uint32_t) session->dg.game_turn);
+    wrShort((uint16_t) session->py.pack.unique_items);
+    for (int i = 0; i < session->py.pack.unique_items; i++) {
+        wrItem(session->py.inventory[i]);
     }
     for (int i = PlayerEquipment::Wield; i < PLAYER_INVENTORY_SIZE; i++) {
-        wrItem(py.inventory[i]);
+        wrItem(session->py.inventory[i]);
     }
-    wrShort((uint16_t) py.pack.weight);
-    wrShort((uint16_t) py.equipment_count);
-    wrLong(py.flags.spells_learnt);
-    wrLong(py.flags.spells_worked);
-    wrLong(py.flags.spells_forgotten);
-    wrBytes(py.flags.spells_learned_order, 32);
-    wrBytes(objects_identified, OBJECT_IDENT_SIZE);
-    wrLong(game.magic_seed);
-    wrLong(game.town_seed);
-    wrShort((uint16_t) last_message_id);
-    for (auto &message : messages) {
+    wrShort((uint16_t) session->py.pack.weight);
+    wrShort((uint16_t) session->py.equipment_count);
+    wrLong(session->py.flags.spells_learnt);
+    wrLong(session->py.flags.spells_worked);
+    wrLong(session->py.flags.spells_forgotten);
+    wrBytes(session->py.flags.spells_learned_order, 32);
+    wrBytes(session->objects_identified, OBJECT_IDENT_SIZE);
+    wrLong(session->game.magic_seed);
+    wrLong(session->game.town_seed);
+    wrShort((uint16_t) session->last_message_id);
+    for (auto &message : session->messages) {
         wrString(message);
     }
 
     // this indicates 'cheating' if it is a one
-    wrShort((uint16_t) panic_save);
-    wrShort((uint16_t) game.total_winner);
-    wrShort((uint16_t) game.noscore);
-    wrShorts(py.base_hp_levels, PLAYER_MAX_LEVEL);
+    wrShort((uint16_t) session->panic_save);
+    wrShort((uint16_t) session->game.total_winner);
+    wrShort((uint16_t) session->game.noscore);
+    wrShorts(session->py.base_hp_levels, PLAYER_MAX_LEVEL);
 
-    for (auto &store : stores) {
+    for (auto &store : session->stores) {
         wrLong((uint32_t) store.turns_left_before_closing);
         wrShort((uint16_t) store.insults_counter);
         wrByte(store.owner_id);
@@ -291,44 +331,50 @@ static bool svWrite() {
     // save the current time in the save file
     l = getCurrentUnixTime();
 
-    if (l < start_time) {
+    if (l < session->start_time) {
         // someone is messing with the clock!,
         // assume that we have been playing for 1 day
-        l = (uint32_t)(start_time + 86400L);
+        l = (uint32_t)(session->start_time + 86400L);
     }
     wrLong(l);
 
     // put game.character_died_from string in save file
-    wrString(game.character_died_from);
+    wrString(session->game.character_died_from);
 
     // put the max_score in the save file
     l = (uint32_t)(playerCalculateTotalPoints());
     wrLong(l);
 
     // put the date_of_birth in the save file
-    wrLong((uint32_t) py.misc.date_of_birth);
+    wrLong((uint32_t) session->py.misc.date_of_birth);
+
+    if (!wrSectionEnd(section)) {
+        return false;
+    }
 
     // only level specific info follows, this allows characters to be
     // resurrected, the dungeon level info is not needed for a resurrection
-    if (game.character_is_dead) {
-        return !((ferror(fileptr) != 0) || fflush(fileptr) == EOF);
+    if (session->game.character_is_dead) {
+        return !((ferror(session->fileptr) != 0) || fflush(session->fileptr) == EOF);
     }
 
-    wrShort((uint16_t) dg.current_level);
-    wrShort((uint16_t) py.pos.y);
-    wrShort((uint16_t) py.pos.x);
-    wrShort((uint16_t) monster_multiply_total);
-    wrShort((uint16_t) dg.height);
-    wrShort((uint16_t) dg.width);
-    wrShort((uint16_t) dg.panel.max_rows);
-    wrShort((uint16_t) dg.panel.max_cols);
+    section = wrSectionStart();
+
+    wrShort((uint16_t) session->dg.current_level);
+    wrShort((uint16_t) session->py.pos.y);
+    wrShort((uint16_t) session->py.pos.x);
+    wrShort((uint16_t) session->monster_multiply_total);
+    wrShort((uint16_t) session->dg.height);
+    wrShort((uint16_t) session->dg.width);
+    wrShort((uint16_t) session->dg.panel.max_rows);
+    wrShort((uint16_t) session->dg.panel.max_cols);
 
     for (int i = 0; i < MAX_HEIGHT; i++) {
         for (int j = 0; j < MAX_WIDTH; j++) {
-            if (dg.floor[i][j].creature_id != 0) {
+            if (session->dg.floor[i][j].creature_id != 0) {
                 wrByte((uint8_t) i);
                 wrByte((uint8_t) j);
-                wrByte(dg.floor[i][j].creature_id);
+                wrByte(session->dg.floor[i][j].creature_id);
             }
         }
     }
@@ -338,10 +384,10 @@ static bool svWrite() {
 
     for (int i = 0; i < MAX_HEIGHT; i++) {
         for (int j = 0; j < MAX_WIDTH; j++) {
-            if (dg.floor[i][j].treasure_id != 0) {
+            if (session->dg.floor[i][j].treasure_id != 0) {
                 wrByte((uint8_t) i);
                 wrByte((uint8_t) j);
-                wrByte(dg.floor[i][j].treasure_id);
+                wrByte(session->dg.floor[i][j].treasure_id);
             }
         }
     }
@@ -353,8 +399,9 @@ static bool svWrite() {
     int count = 0;
     uint8_t prev_char = 0;
 
-    for (auto &row : dg.floor) {
-        for (auto tile : row) {
+    for (int y = 0; y < MAX_HEIGHT; y++) {
+        for (int x = 0; x < MAX_WIDTH; x++) {
+            TileConstRef_t tile = session->dg.floor[y][x];
             auto char_tmp = (uint8_t)(tile.feature_id | (tile.perma_lit_room << 4) | (tile.field_mark << 5) | (tile.permanent_light << 6) | (tile.temporary_light << 7));
 
             if (char_tmp != prev_char || count == UCHAR_MAX) {
@@ -372,64 +419,69 @@ static bool svWrite() {
     wrByte((uint8_t) count);
     wrByte(prev_char);
 
-    wrShort((uint16_t) game.treasure.current_id);
-    for (int i = config::treasure::MIN_TREASURE_LIST_ID; i < game.treasure.current_id; i++) {
-        wrItem(game.treasure.list[i]);
+    wrShort((uint16_t) session->game.treasure.current_id);
+    for (int i = config::treasure::MIN_TREASURE_LIST_ID; i < session->game.treasure.current_id; i++) {
+        wrItem(session->game.treasure.list[i]);
     }
-    wrShort((uint16_t) next_free_monster_id);
-    for (int i = config::monsters::MON_MIN_INDEX_ID; i < next_free_monster_id; i++) {
-        wrMonster(monsters[i]);
+    wrShort((uint16_t) session->next_free_monster_id);
+    for (int i = config::monsters::MON_MIN_INDEX_ID; i < session->next_free_monster_id; i++) {
+        wrMonster(session->monsters[i]);
     }
 
-    return !((ferror(fileptr) != 0) || fflush(fileptr) == EOF);
+    if (!wrSectionEnd(section)) {
+        return false;
+    }
+
+    return !((ferror(session->fileptr) != 0) || fflush(session->fileptr) == EOF);
 }
 
 static bool saveChar(const std::string &filename) {
-    if (game.character_saved) {
+    if (session->game.character_saved) {
         return true; // Nothing to save.
     }
 
     putQIO();
     playerDisturb(1, 0);                   // Turn off resting and searching.
-    playerChangeSpeed(-py.pack.heaviness); // Fix the speed
-    py.pack.heaviness = 0;
+    playerChangeSpeed(-session->py.pack.heaviness); // Fix the speed
+    session->py.pack.heaviness = 0;
     bool ok = false;
 
-    fileptr = nullptr; // Do not assume it has been init'ed
+    session->fileptr = nullptr; // Do not assume it has been init'ed
 
     int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
 
-    if (fd < 0 && access(filename.c_str(), 0) >= 0 && ((from_save_file != 0) || (game.wizard_mode && getInputConfirmation("Can't make new save file. Overwrite old?")))) {
+    if (fd < 0 && access(filename.c_str(), 0) >= 0 && ((session->from_save_file != 0) || (session->game.wizard_mode &&
+                                                                                          getInputConfirmation("Can't make new save file. Overwrite old?")))) {
         (void) chmod(filename.c_str(), 0600);
         fd = open(filename.c_str(), O_RDWR | O_TRUNC, 0600);
     }
 
     if (fd >= 0) {
         (void) close(fd);
-        fileptr = fopen(config::files::save_game.c_str(), "wb");
+        session->fileptr = fopen(session->save_game.c_str(), "wb");
     }
 
     DEBUG(logfile = fopen("IO_LOG", "a"))
-    DEBUG(fprintf(logfile, "Saving data to %s\n", config::files::save_game))
+    DEBUG(fprintf(logfile, "Saving data to %s\n", session->save_game))
 
-    if (fileptr != nullptr) {
-        xor_byte = 0;
+    if (session->fileptr != nullptr) {
+        session->xor_byte = 0;
         wrByte(CURRENT_VERSION_MAJOR);
-        xor_byte = 0;
+        session->xor_byte = 0;
         wrByte(CURRENT_VERSION_MINOR);
-        xor_byte = 0;
+        session->xor_byte = 0;
         wrByte(CURRENT_VERSION_PATCH);
-        xor_byte = 0;
+        session->xor_byte = 0;
 
         auto char_tmp = (uint8_t)(randomNumber(256) - 1);
         wrByte(char_tmp);
-        // Note that xor_byte is now equal to char_tmp
+        // Note that session->xor_byte is now equal to char_tmp
 
         ok = svWrite();
 
         DEBUG(fclose(logfile))
 
-        if (fclose(fileptr) == EOF) {
+        if (fclose(session->fileptr) == EOF) {
             ok = false;
         }
     }
@@ -450,15 +502,14 @@ static bool saveChar(const std::string &filename) {
         return false;
     }
 
-    game.character_saved = true;
-    dg.game_turn = -1;
+    session->game.character_saved = true;
+    session->dg.game_turn = -1;
 
     return true;
 }
 
 // Certain checks are omitted for the wizard. -CJS-
 bool loadGame(bool &generate) {
-    Tile_t *tile = nullptr;
     int c;
     uint32_t time_saved = 0;
     uint8_t version_maj = 0;
@@ -468,37 +519,39 @@ bool loadGame(bool &generate) {
     generate = true;
     int fd = -1;
     int total_count = 0;
+    bool sectioned = false;
+    long section_end = 0;
 
     // Not required for Mac, because the file name is obtained through a dialog.
     // There is no way for a nonexistent file to be specified. -BS-
-    if (access(config::files::save_game.c_str(), 0) != 0) {
+    if (access(session->save_game.c_str(), 0) != 0) {
         printMessage("Save file does not exist.");
         return false; // Don't bother with messages here. File absent.
     }
 
     clearScreen();
 
-    std::string filename = "Save file '" + config::files::save_game + "' present. Attempting restore.";
+    std::string filename = "Save file '" + session->save_game + "' present. Attempting restore.";
     putString(filename.c_str(), Coord_t{23, 0});
 
     // FIXME: check this if/else logic! -- MRC
-    if (dg.game_turn >= 0) {
+    if (session->dg.game_turn >= 0) {
         printMessage("IMPOSSIBLE! Attempt to restore while still alive!");
-    } else if ((fd = open(config::files::save_game.c_str(), O_RDONLY, 0)) < 0 &&
-               (chmod(config::files::save_game.c_str(), 0400) < 0 || (fd = open(config::files::save_game.c_str(), O_RDONLY, 0)) < 0)) {
+    } else if ((fd = open(session->save_game.c_str(), O_RDONLY, 0)) < 0 &&
+               (chmod(session->save_game.c_str(), 0400) < 0 || (fd = open(session->save_game.c_str(), O_RDONLY, 0)) < 0)) {
         // Allow restoring a file belonging to someone else, if we can delete it.
         // Hence first try to read without doing a chmod.
 
         printMessage("Can't open file for reading.");
     } else {
-        dg.game_turn = -1;
+        session->dg.game_turn = -1;
         bool ok = true;
 
         (void) close(fd);
         fd = -1; // Make sure it isn't closed again
-        fileptr = fopen(config::files::save_game.c_str(), "rb");
+        session->fileptr = fopen(session->save_game.c_str(), "rb");
 
-        if (fileptr == nullptr) {
+        if (session->fileptr == nullptr) {
             goto error;
         }
 
@@ -506,17 +559,17 @@ bool loadGame(bool &generate) {
         putQIO();
 
         DEBUG(logfile = fopen("IO_LOG", "a"))
-        DEBUG(fprintf(logfile, "Reading data from %s\n", config::files::save_game))
+        DEBUG(fprintf(logfile, "Reading data from %s\n", session->save_game))
 
-        // Note: setting these xor_byte is correct!
-        xor_byte = 0;
+        // Note: setting these session->xor_byte is correct!
+        session->xor_byte = 0;
         version_maj = rdByte();
-        xor_byte = 0;
+        session->xor_byte = 0;
         version_min = rdByte();
-        xor_byte = 0;
+        session->xor_byte = 0;
         patch_level = rdByte();
 
-        xor_byte = getByte();
+        session->xor_byte = getByte();
 
         if (!validGameVersion(version_maj, version_min, patch_level)) {
             putStringClearToEOL("Sorry. This save file is from a different version of umoria.", Coord_t{2, 0});
@@ -527,11 +580,21 @@ bool loadGame(bool &generate) {
         uint32_t l;
 
         uint_16_t_tmp = rdShort();
+
+        // The preview is only for listing saves, everything in it is read again below
+        sectioned = uint_16_t_tmp == SAVE_SECTIONED;
+        if (sectioned) {
+            if (!rdSectionStart(section_end) || fseek(session->fileptr, section_end, SEEK_SET) != 0 || !rdSectionStart(section_end)) {
+                goto error;
+            }
+            uint_16_t_tmp = rdShort();
+        }
+
         while (uint_16_t_tmp != 0xFFFF) {
             if (uint_16_t_tmp >= MON_MAX_CREATURES) {
                 goto error;
             }
-            Recall_t &memory = creature_recall[uint_16_t_tmp];
+            Recall_t &memory = session->creature_recall[uint_16_t_tmp];
             memory.movement = rdLong();
             memory.spells = rdLong();
             memory.kills = rdShort();
@@ -545,142 +608,152 @@ bool loadGame(bool &generate) {
 
         l = rdLong();
 
-        config::options::run_cut_corners = (l & 0x1) != 0;
-        config::options::run_examine_corners = (l & 0x2) != 0;
-        config::options::run_print_self = (l & 0x4) != 0;
-        config::options::find_bound = (l & 0x8) != 0;
-        config::options::prompt_to_pickup = (l & 0x10) != 0;
-        config::options::use_roguelike_keys = (l & 0x20) != 0;
-        config::options::show_inventory_weights = (l & 0x40) != 0;
-        config::options::highlight_seams = (l & 0x80) != 0;
-        config::options::run_ignore_doors = (l & 0x100) != 0;
-        config::options::error_beep_sound = (l & 0x200) != 0;
-        config::options::display_counts = (l & 0x400) != 0;
+        session->options.run_cut_corners = (l & 0x1) != 0;
+        session->options.run_examine_corners = (l & 0x2) != 0;
+        session->options.run_print_self = (l & 0x4) != 0;
+        session->options.find_bound = (l & 0x8) != 0;
+        session->options.prompt_to_pickup = (l & 0x10) != 0;
+        session->options.use_roguelike_keys = (l & 0x20) != 0;
+        session->options.show_inventory_weights = (l & 0x40) != 0;
+        session->options.highlight_seams = (l & 0x80) != 0;
+        session->options.run_ignore_doors = (l & 0x100) != 0;
+        session->options.error_beep_sound = (l & 0x200) != 0;
+        session->options.display_counts = (l & 0x400) != 0;
+
+        // Saves from before the engine was recorded are all Park-Miller (0)
+        switch ((l >> 16) & 0xF) {
+            case (uint32_t) RandomEngine::Xoshiro128:
+                setRandomEngine(RandomEngine::Xoshiro128);
+                break;
+            default:
+                setRandomEngine(RandomEngine::ParkMiller);
+                break;
+        }
 
         // Don't allow resurrection of game.total_winner characters.  It causes
         // problems because the character level is out of the allowed range.
-        if (game.to_be_wizard && ((l & 0x40000000L) != 0)) {
+        if (session->game.to_be_wizard && ((l & 0x40000000L) != 0)) {
             printMessage("Sorry, this character is retired from moria.");
             printMessage("You can not resurrect a retired character.");
-        } else if (game.to_be_wizard && ((l & 0x80000000L) != 0) && getInputConfirmation("Resurrect a dead character?")) {
+        } else if (session->game.to_be_wizard && ((l & 0x80000000L) != 0) && getInputConfirmation("Resurrect a dead character?")) {
             l &= ~0x80000000L;
         }
 
         if ((l & 0x80000000L) == 0) {
-            rdString(py.misc.name);
-            py.misc.gender = rdBool();
-            py.misc.au = rdLong();
-            py.misc.max_exp = rdLong();
-            py.misc.exp = rdLong();
-            py.misc.exp_fraction = rdShort();
-            py.misc.age = rdShort();
-            py.misc.height = rdShort();
-            py.misc.weight = rdShort();
-            py.misc.level = rdShort();
-            py.misc.max_dungeon_depth = rdShort();
-            py.misc.chance_in_search = rdShort();
-            py.misc.fos = rdShort();
-            py.misc.bth = rdShort();
-            py.misc.bth_with_bows = rdShort();
-            py.misc.mana = rdShort();
-            py.misc.max_hp = rdShort();
-            py.misc.plusses_to_hit = rdShort();
-            py.misc.plusses_to_damage = rdShort();
-            py.misc.ac = rdShort();
-            py.misc.magical_ac = rdShort();
-            py.misc.display_to_hit = rdShort();
-            py.misc.display_to_damage = rdShort();
-            py.misc.display_ac = rdShort();
-            py.misc.display_to_ac = rdShort();
-            py.misc.disarm = rdShort();
-            py.misc.saving_throw = rdShort();
-            py.misc.social_class = rdShort();
-            py.misc.stealth_factor = rdShort();
-            py.misc.class_id = rdByte();
-            py.misc.race_id = rdByte();
-            py.misc.hit_die = rdByte();
-            py.misc.experience_factor = rdByte();
-            py.misc.current_mana = rdShort();
-            py.misc.current_mana_fraction = rdShort();
-            py.misc.current_hp = rdShort();
-            py.misc.current_hp_fraction = rdShort();
-            for (auto &entry : py.misc.history) {
+            rdString(session->py.misc.name);
+            session->py.misc.gender = rdBool();
+            session->py.misc.au = rdLong();
+            session->py.misc.max_exp = rdLong();
+            session->py.misc.exp = rdLong();
+            session->py.misc.exp_fraction = rdShort();
+            session->py.misc.age = rdShort();
+            session->py.misc.height = rdShort();
+            session->py.misc.weight = rdShort();
+            session->py.misc.level = rdShort();
+            session->py.misc.max_dungeon_depth = rdShort();
+            session->py.misc.chance_in_search = rdShort();
+            session->py.misc.fos = rdShort();
+            session->py.misc.bth = rdShort();
+            session->py.misc.bth_with_bows = rdShort();
+            session->py.misc.mana = rdShort();
+            session->py.misc.max_hp = rdShort();
+            session->py.misc.plusses_to_hit = rdShort();
+            session->py.misc.plusses_to_damage = rdShort();
+            session->py.misc.ac = rdShort();
+            session->py.misc.magical_ac = rdShort();
+            session->py.misc.display_to_hit = rdShort();
+            session->py.misc.display_to_damage = rdShort();
+            session->py.misc.display_ac = rdShort();
+            session->py.misc.display_to_ac = rdShort();
+            session->py.misc.disarm = rdShort();
+            session->py.misc.saving_throw = rdShort();
+            session->py.misc.social_class = rdShort();
+            session->py.misc.stealth_factor = rdShort();
+            session->py.misc.class_id = rdByte();
+            session->py.misc.race_id = rdByte();
+            session->py.misc.hit_die = rdByte();
+            session->py.misc.experience_factor = rdByte();
+            session->py.misc.current_mana = rdShort();
+            session->py.misc.current_mana_fraction = rdShort();
+            session->py.misc.current_hp = rdShort();
+            session->py.misc.current_hp_fraction = rdShort();
+            for (auto &entry : session->py.misc.history) {
                 rdString(entry);
             }
 
-            rdBytes(py.stats.max, 6);
-            rdBytes(py.stats.current, 6);
-            rdShorts((uint16_t *) py.stats.modified, 6);
-            rdBytes(py.stats.used, 6);
-
-            py.flags.status = rdLong();
-            py.flags.rest = rdShort();
-            py.flags.blind = rdShort();
-            py.flags.paralysis = rdShort();
-            py.flags.confused = rdShort();
-            py.flags.food = rdShort();
-            py.flags.food_digested = rdShort();
-            py.flags.protection = rdShort();
-            py.flags.speed = rdShort();
-            py.flags.fast = rdShort();
-            py.flags.slow = rdShort();
-            py.flags.afraid = rdShort();
-            py.flags.poisoned = rdShort();
-            py.flags.image = rdShort();
-            py.flags.protect_evil = rdShort();
-            py.flags.invulnerability = rdShort();
-            py.flags.heroism = rdShort();
-            py.flags.super_heroism = rdShort();
-            py.flags.blessed = rdShort();
-            py.flags.heat_resistance = rdShort();
-            py.flags.cold_resistance = rdShort();
-            py.flags.detect_invisible = rdShort();
-            py.flags.word_of_recall = rdShort();
-            py.flags.see_infra = rdShort();
-            py.flags.timed_infra = rdShort();
-            py.flags.see_invisible = rdBool();
-            py.flags.teleport = rdBool();
-            py.flags.free_action = rdBool();
-            py.flags.slow_digest = rdBool();
-            py.flags.aggravate = rdBool();
-            py.flags.resistant_to_fire = rdBool();
-            py.flags.resistant_to_cold = rdBool();
-            py.flags.resistant_to_acid = rdBool();
-            py.flags.regenerate_hp = rdBool();
-            py.flags.resistant_to_light = rdBool();
-            py.flags.free_fall = rdBool();
-            py.flags.sustain_str = rdBool();
-            py.flags.sustain_int = rdBool();
-            py.flags.sustain_wis = rdBool();
-            py.flags.sustain_con = rdBool();
-            py.flags.sustain_dex = rdBool();
-            py.flags.sustain_chr = rdBool();
-            py.flags.confuse_monster = rdBool();
-            py.flags.new_spells_to_learn = rdByte();
-
-            missiles_counter = rdShort();
-            dg.game_turn = rdLong();
-            py.pack.unique_items = rdShort();
-            if (py.pack.unique_items > PlayerEquipment::Wield) {
+            rdBytes(session->py.stats.max, 6);
+            rdBytes(session->py.stats.current, 6);
+            rdShorts((uint16_t *) session->py.stats.modified, 6);
+            rdBytes(session->py.stats.used, 6);
+
+            session->py.flags.status = rdLong();
+            session->py.flags.rest = rdShort();
+            session->py.flags.blind = rdShort();
+            session->py.flags.paralysis = rdShort();
+            session->py.flags.confused = rdShort();
+            session->py.flags.food = rdShort();
+            session->py.flags.food_digested = rdShort();
+            session->py.flags.protection = rdShort();
+            session->py.flags.speed = rdShort();
+            session->py.flags.fast = rdShort();
+            session->py.flags.slow = rdShort();
+            session->py.flags.afraid = rdShort();
+            session->py.flags.poisoned = rdShort();
+            session->py.flags.image = rdShort();
+            session->py.flags.protect_evil = rdShort();
+            session->py.flags.invulnerability = rdShort();
+            session->py.flags.heroism = rdShort();
+            session->py.flags.super_heroism = rdShort();
+            session->py.flags.blessed = rdShort();
+            session->py.flags.heat_resistance = rdShort();
+            session->py.flags.cold_resistance = rdShort();
+            session->py.flags.detect_invisible = rdShort();
+            session->py.flags.word_of_recall = rdShort();
+            session->py.flags.see_infra = rdShort();
+            session->py.flags.timed_infra = rdShort();
+            session->py.flags.see_invisible = rdBool();
+            session->py.flags.teleport = rdBool();
+            session->py.flags.free_action = rdBool();
+            session->py.flags.slow_digest = rdBool();
+            session->py.flags.aggravate = rdBool();
+            session->py.flags.resistant_to_fire = rdBool();
+            session->py.flags.resistant_to_cold = rdBool();
+            session->py.flags.resistant_to_acid = rdBool();
+            session->py.flags.regenerate_hp = rdBool();
+            session->py.flags.resistant_to_light = rdBool();
+            session->py.flags.free_fall = rdBool();
+            session->py.flags.sustain_str = rdBool();
+            session->py.flags.sustain_int = rdBool();
+            session->py.flags.sustain_wis = rdBool();
+            session->py.flags.sustain_con = rdBool();
+            session->py.flags.sustain_dex = rdBool();
+            session->py.flags.sustain_chr = rdBool();
+            session->py.flags.confuse_monster = rdBool();
+            session->py.flags.new_spells_to_learn = rdByte();
+
+            session->missiles_counter = rdShort();
+            session->dg.game_turn = rdLong();
+            session->py.pack.unique_items = rdShort();
+            if (session->py.pack.unique_items > PlayerEquipment::Wield) {
                 goto error;
             }
-            for (int i = 0; i < py.pack.unique_items; i++) {
-                rdItem(py.inventory[i]);
+            for (int i = 0; i < session->py.pack.unique_items; i++) {
+                rdItem(session->py.inventory[i]);
             }
             for (int i = PlayerEquipment::Wield; i < PLAYER_INVENTORY_SIZE; i++) {
-                rdItem(py.inventory[i]);
+                rdItem(session->py.inventory[i]);
             }
-            py.pack.weight = rdShort();
-            py.equipment_count = rdShort();
-            py.flags.spells_learnt = rdLong();
-            py.flags.spells_worked = rdLong();
-            py.flags.spells_forgotten = rdLong();
-            rdBytes(py.flags.spells_learned_order, 32);
-            rdBytes(objects_identified, OBJECT_IDENT_SIZE);
-            game.magic_seed = rdLong();
-            game.town_seed = rdLong();
-            last_message_id = rdShort();
-            for (auto &message : messages) {
+            session->py.pack.weight = rdShort();
+            session->py.equipment_count = rdShort();
+            session->py.flags.spells_learnt = rdLong();
+            session->py.flags.spells_worked = rdLong();
+            session->py.flags.spells_forgotten = rdLong();
+            rdBytes(session->py.flags.spells_learned_order, 32);
+            rdBytes(session->objects_identified, OBJECT_IDENT_SIZE);
+            session->game.magic_seed = rdLong();
+            session->game.town_seed = rdLong();
+            session->last_message_id = rdShort();
+            for (auto &message : session->messages) {
                 rdString(message);
             }
 
@@ -688,13 +761,13 @@ bool loadGame(bool &generate) {
             uint16_t total_winner_short;
             panic_save_short = rdShort();
             total_winner_short = rdShort();
-            panic_save = panic_save_short != 0;
-            game.total_winner = total_winner_short != 0;
+            session->panic_save = panic_save_short != 0;
+            session->game.total_winner = total_winner_short != 0;
 
-            game.noscore = rdShort();
-            rdShorts(py.base_hp_levels, PLAYER_MAX_LEVEL);
+            session->game.noscore = rdShort();
+            rdShorts(session->py.base_hp_levels, PLAYER_MAX_LEVEL);
 
-            for (auto &store : stores) {
+            for (auto &store : session->stores) {
                 store.turns_left_before_closing = rdLong();
                 store.insults_counter = rdShort();
                 store.owner_id = rdByte();
@@ -711,49 +784,56 @@ bool loadGame(bool &generate) {
             }
 
             time_saved = rdLong();
-            rdString(game.character_died_from);
-            py.max_score = rdLong();
-            py.misc.date_of_birth = rdLong();
+            rdString(session->game.character_died_from);
+            session->py.max_score = rdLong();
+            session->py.misc.date_of_birth = rdLong();
+
+            if (sectioned && ftell(session->fileptr) != section_end) {
+                goto error;
+            }
         }
 
-        c = getc(fileptr);
+        c = getc(session->fileptr);
         if (c == EOF || ((l & 0x80000000L) != 0)) {
             if ((l & 0x80000000L) == 0) {
-                if (!game.to_be_wizard || dg.game_turn < 0) {
+                if (!session->game.to_be_wizard || session->dg.game_turn < 0) {
                     goto error;
                 }
                 putStringClearToEOL("Attempting a resurrection!", Coord_t{0, 0});
-                if (py.misc.current_hp < 0) {
-                    py.misc.current_hp = 0;
-                    py.misc.current_hp_fraction = 0;
+                if (session->py.misc.current_hp < 0) {
+                    session->py.misc.current_hp = 0;
+                    session->py.misc.current_hp_fraction = 0;
                 }
 
                 // don't let them starve to death immediately
-                if (py.flags.food < 0) {
-                    py.flags.food = 0;
+                if (session->py.flags.food < 0) {
+                    session->py.flags.food = 0;
                 }
 
                 // don't let them immediately die of poison again
-                if (py.flags.poisoned > 1) {
-                    py.flags.poisoned = 1;
+                if (session->py.flags.poisoned > 1) {
+                    session->py.flags.poisoned = 1;
                 }
 
-                dg.current_level = 0; // Resurrect on the town level.
-                game.character_generated = true;
+                session->dg.current_level = 0; // Resurrect on the town level.
+                session->game.character_generated = true;
 
                 // set `noscore` to indicate a resurrection, and don't enter wizard mode
-                game.to_be_wizard = false;
-                game.noscore |= 0x1;
+                session->game.to_be_wizard = false;
+                session->game.noscore |= 0x1;
             } else {
                 // Make sure that this message is seen, since it is a bit
                 // more interesting than the other messages.
                 printMessage("Restoring Memory of a departed spirit...");
-                dg.game_turn = -1;
+                session->dg.game_turn = -1;
             }
             putQIO();
             goto closefiles;
         }
-        if (ungetc(c, fileptr) == EOF) {
+        if (ungetc(c, session->fileptr) == EOF) {
+            goto error;
+        }
+        if (sectioned && (fseek(session->fileptr, section_end, SEEK_SET) != 0 || !rdSectionStart(section_end))) {
             goto error;
         }
 
@@ -763,14 +843,14 @@ bool loadGame(bool &generate) {
         // only level specific info should follow,
         // not present for dead characters
 
-        dg.current_level = rdShort();
-        py.pos.y = rdShort();
-        py.pos.x = rdShort();
-        monster_multiply_total = rdShort();
-        dg.height = rdShort();
-        dg.width = rdShort();
-        dg.panel.max_rows = rdShort();
-        dg.panel.max_cols = rdShort();
+        session->dg.current_level = rdShort();
+        session->py.pos.y = rdShort();
+        session->py.pos.x = rdShort();
+        session->monster_multiply_total = rdShort();
+        session->dg.height = rdShort();
+        session->dg.width = rdShort();
+        session->dg.panel.max_rows = rdShort();
+        session->dg.panel.max_cols = rdShort();
 
         uint8_t char_tmp, ychar, xchar, count;
 
@@ -783,7 +863,7 @@ bool loadGame(bool &generate) {
             if (xchar > MAX_WIDTH || ychar > MAX_HEIGHT) {
                 goto error;
             }
-            dg.floor[ychar][xchar].creature_id = char_tmp;
+            session->dg.floor[ychar][xchar].creature_id = char_tmp;
             char_tmp = rdByte();
         }
 
@@ -796,68 +876,76 @@ bool loadGame(bool &generate) {
             if (xchar > MAX_WIDTH || ychar > MAX_HEIGHT) {
                 goto error;
             }
-            dg.floor[ychar][xchar].treasure_id = char_tmp;
+            session->dg.floor[ychar][xchar].treasure_id = char_tmp;
             char_tmp = rdByte();
         }
 
         // read in the rest of the cave info
-        tile = &dg.floor[0][0];
         total_count = 0;
         while (total_count != MAX_HEIGHT * MAX_WIDTH) {
             count = rdByte();
             char_tmp = rdByte();
-            for (int i = count; i > 0; i--) {
-                if (tile > &dg.floor[MAX_HEIGHT-1][MAX_WIDTH-1]) {
-                    goto error;
-                }
-                tile->feature_id = (uint8_t)(char_tmp & 0xF);
-                tile->perma_lit_room = (bool) ((char_tmp >> 4) & 0x1);
-                tile->field_mark = (bool) ((char_tmp >> 5) & 0x1);
-                tile->permanent_light = (bool) ((char_tmp >> 6) & 0x1);
-                tile->temporary_light = (bool) ((char_tmp >> 7) & 0x1);
-                tile++;
+            if (count > MAX_HEIGHT * MAX_WIDTH - total_count) {
+                goto error;
+            }
+            for (int i = total_count; i < total_count + count; i++) {
+                TileRef_t tile = session->dg.floor[i / MAX_WIDTH][i % MAX_WIDTH];
+                tile.feature_id = (uint8_t)(char_tmp & 0xF);
+                tile.perma_lit_room = (bool) ((char_tmp >> 4) & 0x1);
+                tile.field_mark = (bool) ((char_tmp >> 5) & 0x1);
+                tile.permanent_light = (bool) ((char_tmp >> 6) & 0x1);
+                tile.temporary_light = (bool) ((char_tmp >> 7) & 0x1);
             }
             total_count += count;
         }
 
-        game.treasure.current_id = rdShort();
-        if (game.treasure.current_id > LEVEL_MAX_OBJECTS) {
+        dungeonFindRooms();
+        playerRunFindCorridors();
+        dungeonFindFloorTiles();
+        dungeonOverviewForget();
+        playerTravelForgetMap();
+
+        session->game.treasure.current_id = rdShort();
+        if (session->game.treasure.current_id > LEVEL_MAX_OBJECTS) {
             goto error;
         }
-        for (int i = config::treasure::MIN_TREASURE_LIST_ID; i < game.treasure.current_id; i++) {
-            rdItem(game.treasure.list[i]);
+        for (int i = config::treasure::MIN_TREASURE_LIST_ID; i < session->game.treasure.current_id; i++) {
+            rdItem(session->game.treasure.list[i]);
         }
-        next_free_monster_id = rdShort();
-        if (next_free_monster_id > MON_TOTAL_ALLOCATIONS) {
+        session->next_free_monster_id = rdShort();
+        if (session->next_free_monster_id > MON_TOTAL_ALLOCATIONS) {
             goto error;
         }
-        for (int i = config::monsters::MON_MIN_INDEX_ID; i < next_free_monster_id; i++) {
-            rdMonster(monsters[i]);
+        for (int i = config::monsters::MON_MIN_INDEX_ID; i < session->next_free_monster_id; i++) {
+            rdMonster(session->monsters[i]);
+        }
+        if (sectioned && ftell(session->fileptr) != section_end) {
+            goto error;
         }
 
         generate = false; // We have restored a cave - no need to generate.
 
-        if (ferror(fileptr) != 0) {
+        if (ferror(session->fileptr) != 0) {
             goto error;
         }
 
-        if (dg.game_turn < 0) {
+        if (session->dg.game_turn < 0) {
         error:
             ok = false; // Assume bad data.
         } else {
             // don't overwrite the killed by string if character is dead
-            if (py.misc.current_hp >= 0) {
-                (void) strcpy(game.character_died_from, "(alive and well)");
+            if (session->py.misc.current_hp >= 0) {
+                (void) strcpy(session->game.character_died_from, "(alive and well)");
             }
-            game.character_generated = true;
+            session->game.character_generated = true;
         }
 
     closefiles:
 
         DEBUG(fclose(logfile));
 
-        if (fileptr != nullptr) {
-            if (fclose(fileptr) < 0) {
+        if (session->fileptr != nullptr) {
+            if (fclose(session->fileptr) < 0) {
                 ok = false;
             }
         }
@@ -869,32 +957,32 @@ bool loadGame(bool &generate) {
             printMessage("Error during reading of file.");
         } else {
             // let the user overwrite the old save file when save/quit
-            from_save_file = 1;
+            session->from_save_file = 1;
 
-            if (panic_save) {
+            if (session->panic_save) {
                 printMessage("This game is from a panic save.  Score will not be added to scoreboard.");
-            } else if ((!game.noscore) & 0x04) {
+            } else if ((!session->game.noscore) & 0x04) {
                 printMessage("This character is already on the scoreboard; it will not be scored again.");
-                game.noscore |= 0x4;
+                session->game.noscore |= 0x4;
             }
 
-            if (dg.game_turn >= 0) { // Only if a full restoration.
-                py.weapon_is_heavy = false;
-                py.pack.heaviness = 0;
+            if (session->dg.game_turn >= 0) { // Only if a full restoration.
+                session->py.weapon_is_heavy = false;
+                session->py.pack.heaviness = 0;
                 playerStrength();
 
                 // rotate store inventory, depending on how old the save file
                 // is foreach day old (rounded up), call storeMaintenance
                 // calculate age in seconds
-                start_time = getCurrentUnixTime();
+                session->start_time = getCurrentUnixTime();
 
                 uint32_t age;
 
                 // check for reasonable values of time here ...
-                if (start_time < time_saved) {
+                if (session->start_time < time_saved) {
                     age = 0;
                 } else {
-                    age = start_time - time_saved;
+                    age = session->start_time - time_saved;
                 }
 
                 age = (uint32_t)((age + 43200L) / 86400L); // age in days
@@ -902,12 +990,10 @@ bool loadGame(bool &generate) {
                     age = 10; // in case save file is very old
                 }
 
-                for (int i = 0; i < (int) age; i++) {
-                    storeMaintenance();
-                }
+                storeMaintenanceFastForward((int) age);
             }
 
-            if (game.noscore != 0) {
+            if (session->game.noscore != 0) {
                 printMessage("This save file cannot be used to get on the score board.");
             }
             if (validGameVersion(version_maj, version_min, patch_level) && !isCurrentGameVersion(version_maj, version_min, patch_level)) {
@@ -919,10 +1005,10 @@ bool loadGame(bool &generate) {
             }
 
             // if false: only restored options and monster memory.
-            return dg.game_turn >= 0;
+            return session->dg.game_turn >= 0;
         }
     }
-    dg.game_turn = -1;
+    session->dg.game_turn = -1;
     putStringClearToEOL("Please try again without that save file.", Coord_t{1, 0});
 
     // We have messages for the player to read, this will ask for a keypress
@@ -938,33 +1024,33 @@ static void wrBool(bool value) {
 }
 
 static void wrByte(uint8_t value) {
-    xor_byte ^= value;
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, "BYTE:  %02X = %d\n", (int) xor_byte, (int) value))
+    session->xor_byte ^= value;
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, "BYTE:  %02X = %d\n", (int) session->xor_byte, (int) value))
 }
 
 static void wrShort(uint16_t value) {
-    xor_byte ^= (value & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, "SHORT: %02X", (int) xor_byte))
-    xor_byte ^= ((value >> 8) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, " %02X = %d\n", (int) xor_byte, (int) value))
+    session->xor_byte ^= (value & 0xFF);
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, "SHORT: %02X", (int) session->xor_byte))
+    session->xor_byte ^= ((value >> 8) & 0xFF);
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, " %02X = %d\n", (int) session->xor_byte, (int) value))
 }
 
 static void wrLong(uint32_t value) {
-    xor_byte ^= (value & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, "LONG:  %02X", (int) xor_byte))
-    xor_byte ^= ((value >> 8) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, " %02X", (int) xor_byte))
-    xor_byte ^= ((value >> 16) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, " %02X", (int) xor_byte))
-    xor_byte ^= ((value >> 24) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, " %02X = %ld\n", (int) xor_byte, (int32_t) value))
+    session->xor_byte ^= (value & 0xFF);
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, "LONG:  %02X", (int) session->xor_byte))
+    session->xor_byte ^= ((value >> 8) & 0xFF);
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, " %02X", (int) session->xor_byte))
+    session->xor_byte ^= ((value >> 16) & 0xFF);
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, " %02X", (int) session->xor_byte))
+    session->xor_byte ^= ((value >> 24) & 0xFF);
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, " %02X = %ld\n", (int) session->xor_byte, (int32_t) value))
 }
 
 static void wrBytes(uint8_t *value, int count) {
@@ -973,9 +1059,9 @@ static void wrBytes(uint8_t *value, int count) {
     DEBUG(fprintf(logfile, "%d BYTES:", count))
     ptr = value;
     for (int i = 0; i < count; i++) {
-        xor_byte ^= *ptr++;
-        (void) putc((int) xor_byte, fileptr);
-        DEBUG(fprintf(logfile, "  %02X = %d", (int) xor_byte, (int) (ptr[-1])))
+        session->xor_byte ^= *ptr++;
+        (void) putc((int) session->xor_byte, session->fileptr);
+        DEBUG(fprintf(logfile, "  %02X = %d", (int) session->xor_byte, (int) (ptr[-1])))
     }
     DEBUG(fprintf(logfile, "\n"))
 }
@@ -984,13 +1070,13 @@ static void wrString(char *str) {
     DEBUG(char *s = str)
     DEBUG(fprintf(logfile, "STRING:"))
     while (*str != '\0') {
-        xor_byte ^= *str++;
-        (void) putc((int) xor_byte, fileptr);
-        DEBUG(fprintf(logfile, " %02X", (int) xor_byte))
+        session->xor_byte ^= *str++;
+        (void) putc((int) session->xor_byte, session->fileptr);
+        DEBUG(fprintf(logfile, " %02X", (int) session->xor_byte))
     }
-    xor_byte ^= *str;
-    (void) putc((int) xor_byte, fileptr);
-    DEBUG(fprintf(logfile, " %02X = \"%s\"\n", (int) xor_byte, s))
+    session->xor_byte ^= *str;
+    (void) putc((int) session->xor_byte, session->fileptr);
+    DEBUG(fprintf(logfile, " %02X = \"%s\"\n", (int) session->xor_byte, s))
 }
 
 static void wrShorts(uint16_t *value, int count) {
@@ -999,12 +1085,12 @@ static void wrShorts(uint16_t *value, int count) {
     uint16_t *sptr = value;
 
     for (int i = 0; i < count; i++) {
-        xor_byte ^= (*sptr & 0xFF);
-        (void) putc((int) xor_byte, fileptr);
-        DEBUG(fprintf(logfile, "  %02X", (int) xor_byte))
-        xor_byte ^= ((*sptr++ >> 8) & 0xFF);
-        (void) putc((int) xor_byte, fileptr);
-        DEBUG(fprintf(logfile, " %02X = %d", (int) xor_byte, (int) sptr[-1]))
+        session->xor_byte ^= (*sptr & 0xFF);
+        (void) putc((int) session->xor_byte, session->fileptr);
+        DEBUG(fprintf(logfile, "  %02X", (int) session->xor_byte))
+        session->xor_byte ^= ((*sptr++ >> 8) & 0xFF);
+        (void) putc((int) session->xor_byte, session->fileptr);
+        DEBUG(fprintf(logfile, " %02X = %d", (int) session->xor_byte, (int) sptr[-1]))
     }
     DEBUG(fprintf(logfile, "\n"))
 }
@@ -1046,9 +1132,34 @@ static void wrMonster(Monster_t const &monster) {
     wrByte(monster.confused_amount);
 }
 
-// get_byte reads a single byte from a file, without any xor_byte encryption
+// Starts a section with room for its length, and the xor_byte it is written with
+static long wrSectionStart() {
+    long start = ftell(session->fileptr);
+    for (int i = 0; i < 4; i++) {
+        (void) putc(0, session->fileptr);
+    }
+    (void) putc((int) session->xor_byte, session->fileptr);
+    return start;
+}
+
+// Goes back to put the length of the section at its start
+static bool wrSectionEnd(long start) {
+    long end = ftell(session->fileptr);
+    if (start < 0 || end < 0 || fseek(session->fileptr, start, SEEK_SET) != 0) {
+        return false;
+    }
+
+    auto length = (uint32_t)(end - start - 4);
+    for (int i = 0; i < 4; i++) {
+        (void) putc((int) ((length >> (8 * i)) & 0xFF), session->fileptr);
+    }
+
+    return fseek(session->fileptr, end, SEEK_SET) == 0;
+}
+
+// get_byte reads a single byte from a file, without any session->xor_byte encryption
 static uint8_t getByte() {
-    return (uint8_t)(getc(fileptr) & 0xFF);
+    return (uint8_t)(getc(session->fileptr) & 0xFF);
 }
 
 static bool rdBool() {
@@ -1057,8 +1168,8 @@ static bool rdBool() {
 
 static uint8_t rdByte() {
     auto c = getByte();
-    uint8_t decoded_byte = c ^ xor_byte;
-    xor_byte = c;
+    uint8_t decoded_byte = c ^ session->xor_byte;
+    session->xor_byte = c;
 
     DEBUG(fprintf(logfile, "BYTE:  %02X = %d\n", (int) c, decoded_byte))
 
@@ -1067,30 +1178,30 @@ static uint8_t rdByte() {
 
 static uint16_t rdShort() {
     auto c = getByte();
-    uint16_t decoded_int = c ^ xor_byte;
+    uint16_t decoded_int = c ^ session->xor_byte;
 
-    xor_byte = getByte();
-    decoded_int |= (uint16_t)(c ^ xor_byte) << 8;
+    session->xor_byte = getByte();
+    decoded_int |= (uint16_t)(c ^ session->xor_byte) << 8;
 
-    DEBUG(fprintf(logfile, "SHORT: %02X %02X = %d\n", (int) c, (int) xor_byte, decoded_int))
+    DEBUG(fprintf(logfile, "SHORT: %02X %02X = %d\n", (int) c, (int) session->xor_byte, decoded_int))
 
     return decoded_int;
 }
 
 static uint32_t rdLong() {
     auto c = getByte();
-    uint32_t decoded_long = c ^ xor_byte;
+    uint32_t decoded_long = c ^ session->xor_byte;
 
-    xor_byte = getByte();
-    decoded_long |= (uint32_t)(c ^ xor_byte) << 8;
-    DEBUG(fprintf(logfile, "LONG:  %02X %02X ", (int) c, (int) xor_byte))
+    session->xor_byte = getByte();
+    decoded_long |= (uint32_t)(c ^ session->xor_byte) << 8;
+    DEBUG(fprintf(logfile, "LONG:  %02X %02X ", (int) c, (int) session->xor_byte))
 
     c = getByte();
-    decoded_long |= (uint32_t)(c ^ xor_byte) << 16;
+    decoded_long |= (uint32_t)(c ^ session->xor_byte) << 16;
 
-    xor_byte = getByte();
-    decoded_long |= (uint32_t)(c ^ xor_byte) << 24;
-    DEBUG(fprintf(logfile, "%02X %02X = %ld\n", (int) c, (int) xor_byte, decoded_long))
+    session->xor_byte = getByte();
+    decoded_long |= (uint32_t)(c ^ session->xor_byte) << 24;
+    DEBUG(fprintf(logfile, "%02X %02X = %ld\n", (int) c, (int) session->xor_byte, decoded_long))
 
     return decoded_long;
 }
@@ -1100,8 +1211,8 @@ static void rdBytes(uint8_t *value, int count) {
     uint8_t *ptr = value;
     for (int i = 0; i < count; i++) {
         auto c = getByte();
-        *ptr++ = c ^ xor_byte;
-        xor_byte = c;
+        *ptr++ = c ^ session->xor_byte;
+        session->xor_byte = c;
         DEBUG(fprintf(logfile, "  %02X = %d", (int) c, (int) ptr[-1]))
     }
     DEBUG(fprintf(logfile, "\n"))
@@ -1112,8 +1223,8 @@ static void rdString(char *str) {
     DEBUG(fprintf(logfile, "STRING: "))
     do {
         auto c = getByte();
-        *str = c ^ xor_byte;
-        xor_byte = c;
+        *str = c ^ session->xor_byte;
+        session->xor_byte = c;
         DEBUG(fprintf(logfile, "%02X ", (int) c))
     } while (*str++ != '\0');
     DEBUG(fprintf(logfile, "= \"%s\"\n", s))
@@ -1125,11 +1236,11 @@ static void rdShorts(uint16_t *value, int count) {
 
     for (int i = 0; i < count; i++) {
         auto c = getByte();
-        uint16_t s = c ^ xor_byte;
-        xor_byte = getByte();
-        s |= (uint16_t)(c ^ xor_byte) << 8;
+        uint16_t s = c ^ session->xor_byte;
+        session->xor_byte = getByte();
+        s |= (uint16_t)(c ^ session->xor_byte) << 8;
         *sptr++ = s;
-        DEBUG(fprintf(logfile, "  %02X %02X = %d", (int) c, (int) xor_byte, (int) s))
+        DEBUG(fprintf(logfile, "  %02X %02X = %d", (int) c, (int) session->xor_byte, (int) s))
     }
     DEBUG(fprintf(logfile, "\n"))
 }
@@ -1171,11 +1282,71 @@ static void rdMonster(Monster_t &monster) {
     monster.confused_amount = rdByte();
 }
 
+// Reads the length and xor_byte a section starts with, giving where it ends
+static bool rdSectionStart(long &end) {
+    uint32_t length = 0;
+    for (int i = 0; i < 4; i++) {
+        length |= (uint32_t) getByte() << (8 * i);
+    }
+
+    long start = ftell(session->fileptr);
+    session->xor_byte = getByte();
+    end = start + (long) length;
+
+    return start >= 0 && length > 0 && feof(session->fileptr) == 0;
+}
+
+// Reads who a save file is for, without restoring the rest of it. Saves
+// from before there was a preview section can't be read this way.
+bool readSavePreview(std::string const &filename, SavePreview_t &preview) {
+    session->fileptr = fopen(filename.c_str(), "rb");
+    if (session->fileptr == nullptr) {
+        return false;
+    }
+
+    session->xor_byte = 0;
+    uint8_t version_maj = rdByte();
+    session->xor_byte = 0;
+    uint8_t version_min = rdByte();
+    session->xor_byte = 0;
+    uint8_t patch_level = rdByte();
+    session->xor_byte = getByte();
+
+    long section_end = 0;
+    bool ok = validGameVersion(version_maj, version_min, patch_level) && rdShort() == SAVE_SECTIONED && rdSectionStart(section_end);
+
+    if (ok) {
+        char name[PLAYER_NAME_SIZE] = {'\0'};
+        int length = 0;
+        uint8_t c;
+        while ((c = rdByte()) != '\0' && feof(session->fileptr) == 0) {
+            if (length < PLAYER_NAME_SIZE - 1) {
+                name[length++] = (char) c;
+            }
+        }
+        preview.name = name;
+        preview.race_id = rdByte();
+        preview.class_id = rdByte();
+        preview.level = rdShort();
+        preview.dungeon_depth = rdShort();
+        preview.game_turn = (int32_t) rdLong();
+        preview.dead = rdBool();
+        preview.total_winner = rdBool();
+
+        ok = ftell(session->fileptr) == section_end && preview.race_id < PLAYER_MAX_RACES && preview.class_id < PLAYER_MAX_CLASSES;
+    }
+
+    (void) fclose(session->fileptr);
+    session->fileptr = nullptr;
+
+    return ok;
+}
+
 // functions called from death.c to implement the score file
 
-// set the local fileptr to the score file fileptr
+// set the local session->fileptr to the score file session->fileptr
 void setFileptr(FILE *file) {
-    fileptr = file;
+    session->fileptr = file;
 }
 
 void saveHighScore(HighScore_t const &score) {
@@ -1183,7 +1354,7 @@ void saveHighScore(HighScore_t const &score) {
     DEBUG(fprintf(logfile, "Saving score:\n"))
 
     // Save the encryption byte for robustness.
-    wrByte(xor_byte);
+    wrByte(session->xor_byte);
 
     wrLong((uint32_t) score.points);
     wrLong((uint32_t) score.birth_date);
@@ -1206,7 +1377,7 @@ void readHighScore(HighScore_t &score) {
     DEBUG(fprintf(logfile, "Reading score:\n"))
 
     // Read the encryption byte.
-    xor_byte = getByte();
+    session->xor_byte = getByte();
 
     score.points = rdLong();
     score.birth_date = rdLong();
@@ -66,8 +66,11 @@
 #include "rng.h"
 #include "scores.h"
 #include "scrolls.h"
+#include "server.h"       // after rng.h
 #include "spells.h"
 #include "staves.h"
 #include "store.h"
 #include "treasure.h"
 #include "wizard.h"
+
+#include "session.h"      // after all the game types
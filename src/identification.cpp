@@ -8,10 +8,8 @@
 
 #include "headers.h"
 
-char magic_item_titles[MAX_TITLES][10];
 
 // Identified objects flags
-uint8_t objects_identified[OBJECT_IDENT_SIZE];
 
 static const char *objectDescription(char command) {
     // every printing ASCII character is listed here, in the
@@ -28,7 +26,7 @@ static const char *objectDescription(char command) {
         case '$':
             return "$ - Treasure.";
         case '%':
-            if (!config::options::highlight_seams) {
+            if (!session->options.highlight_seams) {
                 return "% - Not used.";
             }
             return "% - A magma or quartz vein.";
@@ -85,7 +83,7 @@ static const char *objectDescription(char command) {
         case '?':
             return "? - A scroll.";
         case '@':
-            return py.misc.name;
+            return session->py.misc.name;
         case 'A':
             return "A - Giant Ant Lion.";
         case 'B':
@@ -226,70 +224,58 @@ void identifyGameObject() {
     recallMonsterAttributes(itemId);
 }
 
+// Shuffles the descriptions from `first` on, with one swap for each
+static void magicShuffleDescriptions(const char **descriptions, int first, int count) {
+    for (int i = first; i < count; i++) {
+        int id = randomNumber(count - first) - 1 + first;
+        const char *description = descriptions[i];
+        descriptions[i] = descriptions[id];
+        descriptions[id] = description;
+    }
+}
+
 // Initialize all Potions, wands, staves, scrolls, etc.
 void magicInitializeItemNames() {
-    int id;
+    // Each game shuffles its own copy of the descriptions,
+    // starting from the order they are listed in.
+    (void) memcpy(session->colors, colors, sizeof(colors));
+    (void) memcpy(session->mushrooms, mushrooms, sizeof(mushrooms));
+    (void) memcpy(session->woods, woods, sizeof(woods));
+    (void) memcpy(session->metals, metals, sizeof(metals));
+    (void) memcpy(session->rocks, rocks, sizeof(rocks));
+    (void) memcpy(session->amulets, amulets, sizeof(amulets));
 
-    seedSet(game.magic_seed);
+    seedSet(session->game.magic_seed);
 
     // The first 3 entries for colors are fixed, (slime & apple juice, water)
-    for (int i = 3; i < MAX_COLORS; i++) {
-        id = randomNumber(MAX_COLORS - 3) + 2;
-        const char *color = colors[i];
-        colors[i] = colors[id];
-        colors[id] = color;
-    }
-
-    for (auto &w : woods) {
-        id = randomNumber(MAX_WOODS) - 1;
-        const char *wood = w;
-        w = woods[id];
-        woods[id] = wood;
-    }
-
-    for (auto &m : metals) {
-        id = randomNumber(MAX_METALS) - 1;
-        const char *metal = m;
-        m = metals[id];
-        metals[id] = metal;
-    }
+    magicShuffleDescriptions(session->colors, 3, MAX_COLORS);
+    magicShuffleDescriptions(session->woods, 0, MAX_WOODS);
+    magicShuffleDescriptions(session->metals, 0, MAX_METALS);
+    magicShuffleDescriptions(session->rocks, 0, MAX_ROCKS);
+    magicShuffleDescriptions(session->amulets, 0, MAX_AMULETS);
+    magicShuffleDescriptions(session->mushrooms, 0, MAX_MUSHROOMS);
 
-    for (auto &r : rocks) {
-        id = randomNumber(MAX_ROCKS) - 1;
-        const char *rock = r;
-        r = rocks[id];
-        rocks[id] = rock;
-    }
-
-    for (auto &a : amulets) {
-        id = randomNumber(MAX_AMULETS) - 1;
-        const char *amulet = a;
-        a = amulets[id];
-        amulets[id] = amulet;
-    }
-
-    for (auto &m : mushrooms) {
-        id = randomNumber(MAX_MUSHROOMS) - 1;
-        const char *mushroom = m;
-        m = mushrooms[id];
-        mushrooms[id] = mushroom;
-    }
-
-    int k;
     vtype_t title = {'\0'};
 
-    for (auto &item_title : magic_item_titles) {
-        title[0] = '\0';
-        k = randomNumber(2) + 1;
+    for (auto &item_title : session->magic_item_titles) {
+        // The title is built up in place, rather than with strcat()
+        // scanning it again for every syllable
+        size_t length = 0;
+        int words = randomNumber(2) + 1;
 
-        for (int i = 0; i < k; i++) {
+        for (int i = 0; i < words; i++) {
             for (int s = randomNumber(2); s > 0; s--) {
-                (void) strcat(title, syllables[randomNumber(MAX_SYLLABLES) - 1]);
+                const char *syllable = syllables[randomNumber(MAX_SYLLABLES) - 1];
+                size_t syllable_length = strlen(syllable);
+
+                (void) memcpy(title + length, syllable, syllable_length);
+                length += syllable_length;
             }
-            if (i < k - 1) {
-                (void) strcat(title, " ");
+            if (i < words - 1) {
+                title[length++] = ' ';
             }
         }
+        title[length] = '\0';
 
         if (title[8] == ' ') {
             title[8] = '\0';
@@ -330,15 +316,15 @@ int16_t objectPositionOffset(int category_id, int sub_category_id) {
 }
 
 static void clearObjectTriedFlag(int16_t id) {
-    objects_identified[id] &= ~config::identification::OD_TRIED;
+    session->objects_identified[id] &= ~config::identification::OD_TRIED;
 }
 
 static void setObjectTriedFlag(int16_t id) {
-    objects_identified[id] |= config::identification::OD_TRIED;
+    session->objects_identified[id] |= config::identification::OD_TRIED;
 }
 
 static bool isObjectKnown(int16_t id) {
-    return (objects_identified[id] & config::identification::OD_KNOWN1) != 0u;
+    return (session->objects_identified[id] & config::identification::OD_KNOWN1) != 0u;
 }
 
 // Remove "Secret" symbol for identity of object
@@ -352,7 +338,7 @@ void itemSetAsIdentified(int category_id, int sub_category_id) {
     id <<= 6;
     id += (uint8_t)(sub_category_id & (ITEM_SINGLE_STACK_MIN - 1));
 
-    objects_identified[id] |= config::identification::OD_KNOWN1;
+    session->objects_identified[id] |= config::identification::OD_KNOWN1;
 
     // clear the tried flag, since it is now known
     clearObjectTriedFlag(id);
@@ -455,8 +441,8 @@ void itemIdentify(Inventory_t &item, int &item_id) {
 
     int j;
 
-    for (int i = 0; i < py.pack.unique_items; i++) {
-        Inventory_t const &t_ptr = py.inventory[i];
+    for (int i = 0; i < session->py.pack.unique_items; i++) {
+        Inventory_t const &t_ptr = session->py.inventory[i];
 
         bool matching_cat = t_ptr.category_id == item.category_id;
         bool matching_sub_cat = t_ptr.sub_category_id == item.sub_category_id;
@@ -472,14 +458,14 @@ void itemIdentify(Inventory_t &item, int &item_id) {
 
             printMessage("You combine similar objects from the shop and dungeon.");
 
-            py.inventory[item_id].items_count += py.inventory[i].items_count;
-            py.pack.unique_items--;
+            session->py.inventory[item_id].items_count += session->py.inventory[i].items_count;
+            session->py.pack.unique_items--;
 
-            for (j = i; j < py.pack.unique_items; j++) {
-                py.inventory[j] = py.inventory[j + 1];
+            for (j = i; j < session->py.pack.unique_items; j++) {
+                session->py.inventory[j] = session->py.inventory[j + 1];
             }
 
-            inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, py.inventory[j]);
+            inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, session->py.inventory[j]);
         }
     }
 }
@@ -569,7 +555,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
         case TV_AMULET:
             if (modify) {
                 basenm = "& %s Amulet";
-                modstr = amulets[indexx];
+                modstr = session->amulets[indexx];
             } else {
                 basenm = "& Amulet";
                 append_name = true;
@@ -579,7 +565,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
         case TV_RING:
             if (modify) {
                 basenm = "& %s Ring";
-                modstr = rocks[indexx];
+                modstr = session->rocks[indexx];
             } else {
                 basenm = "& Ring";
                 append_name = true;
@@ -589,7 +575,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
         case TV_STAFF:
             if (modify) {
                 basenm = "& %s Staff";
-                modstr = woods[indexx];
+                modstr = session->woods[indexx];
             } else {
                 basenm = "& Staff";
                 append_name = true;
@@ -599,7 +585,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
         case TV_WAND:
             if (modify) {
                 basenm = "& %s Wand";
-                modstr = metals[indexx];
+                modstr = session->metals[indexx];
             } else {
                 basenm = "& Wand";
                 append_name = true;
@@ -610,7 +596,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
         case TV_SCROLL2:
             if (modify) {
                 basenm = "& Scroll~ titled \"%s\"";
-                modstr = magic_item_titles[indexx];
+                modstr = session->magic_item_titles[indexx];
             } else {
                 basenm = "& Scroll~";
                 append_name = true;
@@ -620,7 +606,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
         case TV_POTION2:
             if (modify) {
                 basenm = "& %s Potion~";
-                modstr = colors[indexx];
+                modstr = session->colors[indexx];
             } else {
                 basenm = "& Potion~";
                 append_name = true;
@@ -636,7 +622,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
                     basenm = "& Hairy %s Mold~";
                 }
                 if (indexx <= 20) {
-                    modstr = mushrooms[indexx];
+                    modstr = session->mushrooms[indexx];
                 }
             } else {
                 append_name = true;
@@ -826,7 +812,7 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
         indexx += (item.sub_category_id & (ITEM_SINGLE_STACK_MIN - 1));
 
         // don't print tried string for store bought items
-        if (((objects_identified[indexx] & config::identification::OD_TRIED) != 0) && !itemStoreBought(item.identification)) {
+        if (((session->objects_identified[indexx] & config::identification::OD_TRIED) != 0) && !itemStoreBought(item.identification)) {
             (void) strcat(tmp_str, "tried ");
         }
     }
@@ -860,11 +846,11 @@ void itemDescription(obj_desc_t description, Inventory_t const &item, bool add_p
 
 // Describe number of remaining charges. -RAK-
 void itemChargesRemainingDescription(int item_id) {
-    if (!spellItemIdentified(py.inventory[item_id])) {
+    if (!spellItemIdentified(session->py.inventory[item_id])) {
         return;
     }
 
-    int rem_num = py.inventory[item_id].misc_use;
+    int rem_num = session->py.inventory[item_id].misc_use;
 
     vtype_t out_val = {'\0'};
     (void) sprintf(out_val, "You have %d charges remaining.", rem_num);
@@ -873,7 +859,7 @@ void itemChargesRemainingDescription(int item_id) {
 
 // Describe amount of item remaining. -RAK-
 void itemTypeRemainingCountDescription(int item_id) {
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     item.items_count--;
 
@@ -890,7 +876,7 @@ void itemTypeRemainingCountDescription(int item_id) {
 
 // Add a comment to an object description. -CJS-
 void itemInscribe() {
-    if (py.pack.unique_items == 0 && py.equipment_count == 0) {
+    if (session->py.pack.unique_items == 0 && session->py.equipment_count == 0) {
         printMessage("You are not carrying anything to inscribe.");
         return;
     }
@@ -901,15 +887,15 @@ void itemInscribe() {
     }
 
     obj_desc_t msg = {'\0'};
-    itemDescription(msg, py.inventory[item_id], true);
+    itemDescription(msg, session->py.inventory[item_id], true);
 
     obj_desc_t inscription = {'\0'};
     (void) sprintf(inscription, "Inscribing %s", msg);
 
     printMessage(inscription);
 
-    if (py.inventory[item_id].inscription[0] != '\0') {
-        (void) sprintf(inscription, "Replace %s New inscription:", py.inventory[item_id].inscription);
+    if (session->py.inventory[item_id].inscription[0] != '\0') {
+        (void) sprintf(inscription, "Replace %s New inscription:", session->py.inventory[item_id].inscription);
     } else {
         (void) strcpy(inscription, "Inscription: ");
     }
@@ -922,7 +908,7 @@ void itemInscribe() {
     putStringClearToEOL(inscription, Coord_t{0, 0});
 
     if (getStringInput(inscription, Coord_t{0, (int) strlen(inscription)}, msg_len)) {
-        itemReplaceInscription(py.inventory[item_id], inscription);
+        itemReplaceInscription(session->py.inventory[item_id], inscription);
     }
 }
 
@@ -940,7 +926,7 @@ void objectBlockedByMonster(int monster_id) {
     vtype_t description = {'\0'};
     vtype_t msg = {'\0'};
 
-    Monster_t const &monster = monsters[monster_id];
+    Monster_t const &monster = session->monsters[monster_id];
     const char *name = creatures_list[monster.creature_id].name;
 
     if (monster.lit) {
@@ -75,16 +75,15 @@ constexpr uint8_t MAX_AMULETS = 11;    // Used with amulets
 constexpr uint8_t MAX_TITLES = 45;     // Used with scrolls
 constexpr uint8_t MAX_SYLLABLES = 153; // Used with scrolls
 
-extern uint8_t objects_identified[OBJECT_IDENT_SIZE];
 extern const char *special_item_names[SpecialNameIds::SN_ARRAY_SIZE];
 
 // Following are arrays for descriptive pieces
-extern const char *colors[MAX_COLORS];
-extern const char *mushrooms[MAX_MUSHROOMS];
-extern const char *woods[MAX_WOODS];
-extern const char *metals[MAX_METALS];
-extern const char *rocks[MAX_ROCKS];
-extern const char *amulets[MAX_AMULETS];
+extern const char *const colors[MAX_COLORS];
+extern const char *const mushrooms[MAX_MUSHROOMS];
+extern const char *const woods[MAX_WOODS];
+extern const char *const metals[MAX_METALS];
+extern const char *const rocks[MAX_ROCKS];
+extern const char *const amulets[MAX_AMULETS];
 extern const char *syllables[MAX_SYLLABLES];
 
 void identifyGameObject();
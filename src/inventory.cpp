@@ -11,7 +11,7 @@ uint32_t inventoryCollectAllItemFlags() {
     uint32_t flags = 0;
 
     for (int i = PlayerEquipment::Wield; i < PlayerEquipment::Light; i++) {
-        flags |= py.inventory[i].flags;
+        flags |= session->py.inventory[i].flags;
     }
 
     return flags;
@@ -19,23 +19,23 @@ uint32_t inventoryCollectAllItemFlags() {
 
 // Destroy an item in the inventory -RAK-
 void inventoryDestroyItem(int item_id) {
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     if (item.items_count > 1 && item.sub_category_id <= ITEM_SINGLE_STACK_MAX) {
         item.items_count--;
-        py.pack.weight -= item.weight;
+        session->py.pack.weight -= item.weight;
     } else {
-        py.pack.weight -= item.weight * item.items_count;
+        session->py.pack.weight -= item.weight * item.items_count;
 
-        for (int i = item_id; i < py.pack.unique_items - 1; i++) {
-            py.inventory[i] = py.inventory[i + 1];
+        for (int i = item_id; i < session->py.pack.unique_items - 1; i++) {
+            session->py.inventory[i] = session->py.inventory[i + 1];
         }
 
-        inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, py.inventory[py.pack.unique_items - 1]);
-        py.pack.unique_items--;
+        inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, session->py.inventory[session->py.pack.unique_items - 1]);
+        session->py.pack.unique_items--;
     }
 
-    py.flags.status |= config::player::status::PY_STR_WGT;
+    session->py.flags.status |= config::player::status::PY_STR_WGT;
 }
 
 // Copies the object in the second argument over the first argument.
@@ -50,52 +50,52 @@ void inventoryTakeOneItem(Inventory_t *to_item, Inventory_t *from_item) {
 
 // Drops an item from inventory to given location -RAK-
 void inventoryDropItem(int item_id, bool drop_all) {
-    if (dg.floor[py.pos.y][py.pos.x].treasure_id != 0) {
-        (void) dungeonDeleteObject(py.pos);
+    if (session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id != 0) {
+        (void) dungeonDeleteObject(session->py.pos);
     }
 
     int treasure_id = popt();
 
-    Inventory_t &item = py.inventory[item_id];
-    game.treasure.list[treasure_id] = item;
+    Inventory_t &item = session->py.inventory[item_id];
+    session->game.treasure.list[treasure_id] = item;
 
-    dg.floor[py.pos.y][py.pos.x].treasure_id = (uint8_t) treasure_id;
+    session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id = (uint8_t) treasure_id;
 
     if (item_id >= PlayerEquipment::Wield) {
         playerTakeOff(item_id, -1);
     } else {
         if (drop_all || item.items_count == 1) {
-            py.pack.weight -= item.weight * item.items_count;
-            py.pack.unique_items--;
+            session->py.pack.weight -= item.weight * item.items_count;
+            session->py.pack.unique_items--;
 
-            while (item_id < py.pack.unique_items) {
-                py.inventory[item_id] = py.inventory[item_id + 1];
+            while (item_id < session->py.pack.unique_items) {
+                session->py.inventory[item_id] = session->py.inventory[item_id + 1];
                 item_id++;
             }
 
-            inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, py.inventory[py.pack.unique_items]);
+            inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, session->py.inventory[session->py.pack.unique_items]);
         } else {
-            game.treasure.list[treasure_id].items_count = 1;
-            py.pack.weight -= item.weight;
+            session->game.treasure.list[treasure_id].items_count = 1;
+            session->py.pack.weight -= item.weight;
             item.items_count--;
         }
 
         obj_desc_t prt1 = {'\0'};
         obj_desc_t prt2 = {'\0'};
-        itemDescription(prt1, game.treasure.list[treasure_id], true);
+        itemDescription(prt1, session->game.treasure.list[treasure_id], true);
         (void) sprintf(prt2, "Dropped %s", prt1);
         printMessage(prt2);
     }
 
-    py.flags.status |= config::player::status::PY_STR_WGT;
+    session->py.flags.status |= config::player::status::PY_STR_WGT;
 }
 
 // Destroys a type of item on a given percent chance -RAK-
 static int inventoryDamageItem(bool (*item_type)(Inventory_t *), int chance_percentage) {
     int damage = 0;
 
-    for (int i = 0; i < py.pack.unique_items; i++) {
-        if ((*item_type)(&py.inventory[i]) && randomNumber(100) < chance_percentage) {
+    for (int i = 0; i < session->py.pack.unique_items; i++) {
+        if ((*item_type)(&session->py.inventory[i]) && randomNumber(100) < chance_percentage) {
             inventoryDestroyItem(i);
             damage++;
         }
@@ -105,7 +105,7 @@ static int inventoryDamageItem(bool (*item_type)(Inventory_t *), int chance_perc
 }
 
 bool inventoryDiminishLightAttack(bool noticed) {
-    Inventory_t &item = py.inventory[PlayerEquipment::Light];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Light];
 
     if (item.misc_use > 0) {
         item.misc_use -= (250 + randomNumber(250));
@@ -114,7 +114,7 @@ bool inventoryDiminishLightAttack(bool noticed) {
             item.misc_use = 1;
         }
 
-        if (py.flags.blind < 1) {
+        if (session->py.flags.blind < 1) {
             printMessage("Your light dims.");
         } else {
             noticed = false;
@@ -127,7 +127,7 @@ bool inventoryDiminishLightAttack(bool noticed) {
 }
 
 bool inventoryDiminishChargesAttack(uint8_t creature_level, int16_t &monster_hp, bool noticed) {
-    Inventory_t &item = py.inventory[randomNumber(py.pack.unique_items) - 1];
+    Inventory_t &item = session->py.inventory[randomNumber(session->py.pack.unique_items) - 1];
 
     bool has_charges = item.category_id == TV_STAFF || item.category_id == TV_WAND;
 
@@ -175,7 +175,7 @@ bool executeDisenchantAttack() {
     }
 
     bool success = false;
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     if (item.to_hit > 0) {
         item.to_hit -= randomNumber(2);
@@ -210,7 +210,7 @@ bool executeDisenchantAttack() {
 
 // this code must be identical to the inventoryCarryItem() code below
 bool inventoryCanCarryItemCount(Inventory_t const &item) {
-    if (py.pack.unique_items < PlayerEquipment::Wield) {
+    if (session->py.pack.unique_items < PlayerEquipment::Wield) {
         return true;
     }
 
@@ -218,20 +218,21 @@ bool inventoryCanCarryItemCount(Inventory_t const &item) {
         return false;
     }
 
-    for (int i = 0; i < py.pack.unique_items; i++) {
-        bool same_character = py.inventory[i].category_id == item.category_id;
-        bool same_category = py.inventory[i].sub_category_id == item.sub_category_id;
+    for (int i = 0; i < session->py.pack.unique_items; i++) {
+        bool same_character = session->py.inventory[i].category_id == item.category_id;
+        bool same_category = session->py.inventory[i].sub_category_id == item.sub_category_id;
 
         // make sure the number field doesn't overflow
         // NOTE: convert to bigger types before addition -MRC-
-        bool same_number = uint16_t(py.inventory[i].items_count) + uint16_t(item.items_count) < 256;
+        bool same_number = uint16_t(session->py.inventory[i].items_count) + uint16_t(item.items_count) < 256;
 
         // they always stack (sub_category_id < 192), or else they have same `misc_use`
-        bool same_group = item.sub_category_id < ITEM_GROUP_MIN || py.inventory[i].misc_use == item.misc_use;
+        bool same_group = item.sub_category_id < ITEM_GROUP_MIN || session->py.inventory[i].misc_use == item.misc_use;
 
         // only stack if both or neither are identified
         // TODO(cook): is it correct that they should be equal to each other, regardless of true/false value?
-        bool inventory_item_is_colorless = itemSetColorlessAsIdentified(py.inventory[i].category_id, py.inventory[i].sub_category_id, py.inventory[i].identification);
+        bool inventory_item_is_colorless = itemSetColorlessAsIdentified(session->py.inventory[i].category_id, session->py.inventory[i].sub_category_id,
+                                                                        session->py.inventory[i].identification);
         bool item_is_colorless = itemSetColorlessAsIdentified(item.category_id, item.sub_category_id, item.identification);
         bool identification = inventory_item_is_colorless == item_is_colorless;
 
@@ -246,7 +247,7 @@ bool inventoryCanCarryItemCount(Inventory_t const &item) {
 // return false if picking up an object would change the players speed
 bool inventoryCanCarryItem(Inventory_t const &item) {
     int limit = playerCarryingLoadLimit();
-    int new_weight = item.items_count * item.weight + py.pack.weight;
+    int new_weight = item.items_count * item.weight + session->py.pack.weight;
 
     if (limit < new_weight) {
         limit = new_weight / (limit + 1);
@@ -254,7 +255,7 @@ bool inventoryCanCarryItem(Inventory_t const &item) {
         limit = 0;
     }
 
-    return py.pack.heaviness == limit;
+    return session->py.pack.heaviness == limit;
 }
 
 // Add an item to players inventory.  Return the
@@ -268,7 +269,7 @@ int inventoryCarryItem(Inventory_t &new_item) {
 
     // Now, check to see if player can carry object
     for (slot_id = 0; slot_id < PLAYER_INVENTORY_SIZE; slot_id++) {
-        Inventory_t &item = py.inventory[slot_id];
+        Inventory_t &item = session->py.inventory[slot_id];
 
         bool is_same_category = new_item.category_id == item.category_id;
         bool is_same_sub_category = new_item.sub_category_id == item.sub_category_id;
@@ -288,17 +289,17 @@ int inventoryCarryItem(Inventory_t &new_item) {
         if ((is_same_category && new_item.sub_category_id < item.sub_category_id && is_always_known) || new_item.category_id > item.category_id) {
             // For items which are always `is_known`, i.e. never have a 'color',
             // insert them into the inventory in sorted order.
-            for (int i = py.pack.unique_items - 1; i >= slot_id; i--) {
-                py.inventory[i + 1] = py.inventory[i];
+            for (int i = session->py.pack.unique_items - 1; i >= slot_id; i--) {
+                session->py.inventory[i + 1] = session->py.inventory[i];
             }
-            py.inventory[slot_id] = new_item;
-            py.pack.unique_items++;
+            session->py.inventory[slot_id] = new_item;
+            session->py.pack.unique_items++;
             break;
         }
     }
 
-    py.pack.weight += new_item.items_count * new_item.weight;
-    py.flags.status |= config::player::status::PY_STR_WGT;
+    session->py.pack.weight += new_item.items_count * new_item.weight;
+    session->py.flags.status |= config::player::status::PY_STR_WGT;
 
     return slot_id;
 }
@@ -310,8 +311,8 @@ bool inventoryFindRange(int item_id_start, int item_id_end, int &j, int &k) {
 
     bool at_end_of_range = false;
 
-    for (int i = 0; i < py.pack.unique_items; i++) {
-        int item_id = (int) py.inventory[i].category_id;
+    for (int i = 0; i < session->py.pack.unique_items; i++) {
+        int item_id = (int) session->py.inventory[i].category_id;
 
         if (!at_end_of_range) {
             if (item_id == item_id_start || item_id == item_id_end) {
@@ -327,7 +328,7 @@ bool inventoryFindRange(int item_id_start, int item_id_end, int &j, int &k) {
     }
 
     if (at_end_of_range && k == -1) {
-        k = py.pack.unique_items - 1;
+        k = session->py.pack.unique_items - 1;
     }
 
     return at_end_of_range;
@@ -382,33 +383,33 @@ static bool damageMinusAC(uint32_t typ_dam) {
     int items_count = 0;
     uint8_t items[6];
 
-    if (py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING) {
         items[items_count] = PlayerEquipment::Body;
         items_count++;
     }
 
-    if (py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING) {
         items[items_count] = PlayerEquipment::Arm;
         items_count++;
     }
 
-    if (py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING) {
         items[items_count] = PlayerEquipment::Outer;
         items_count++;
     }
 
-    if (py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING) {
         items[items_count] = PlayerEquipment::Hands;
         items_count++;
     }
 
-    if (py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING) {
         items[items_count] = PlayerEquipment::Head;
         items_count++;
     }
 
     // also affect boots
-    if (py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING) {
         items[items_count] = PlayerEquipment::Feet;
         items_count++;
     }
@@ -424,20 +425,20 @@ static bool damageMinusAC(uint32_t typ_dam) {
     obj_desc_t description = {'\0'};
     obj_desc_t msg = {'\0'};
 
-    if ((py.inventory[item_id].flags & typ_dam) != 0u) {
+    if ((session->py.inventory[item_id].flags & typ_dam) != 0u) {
         minus = true;
 
-        itemDescription(description, py.inventory[item_id], false);
+        itemDescription(description, session->py.inventory[item_id], false);
         (void) sprintf(msg, "Your %s resists damage!", description);
         printMessage(msg);
-    } else if (py.inventory[item_id].ac + py.inventory[item_id].to_ac > 0) {
+    } else if (session->py.inventory[item_id].ac + session->py.inventory[item_id].to_ac > 0) {
         minus = true;
 
-        itemDescription(description, py.inventory[item_id], false);
+        itemDescription(description, session->py.inventory[item_id], false);
         (void) sprintf(msg, "Your %s is damaged!", description);
         printMessage(msg);
 
-        py.inventory[item_id].to_ac--;
+        session->py.inventory[item_id].to_ac--;
         playerRecalculateBonuses();
     }
 
@@ -575,24 +576,54 @@ void damageCorrodingGas(const char *creature_name) {
     }
 }
 
+// Hit points lost to fire, frost, lightning or acid once the player's
+// resistances have been taken off, as the functions below do it. Armour
+// which resists acid is left out, as finding it may damage the armour.
+int damageResisted(int spell_type, int damage) {
+    switch (spell_type) {
+        case MagicSpellFlags::Lightning:
+            if (session->py.flags.resistant_to_light) {
+                damage = damage / 3;
+            }
+            break;
+        case MagicSpellFlags::Acid:
+            if (session->py.flags.resistant_to_acid) {
+                damage = damage / 3;
+            }
+            break;
+        case MagicSpellFlags::Frost:
+            if (session->py.flags.resistant_to_cold) {
+                damage = damage / 3;
+            }
+            if (session->py.flags.cold_resistance > 0) {
+                damage = damage / 3;
+            }
+            break;
+        case MagicSpellFlags::Fire:
+            if (session->py.flags.resistant_to_fire) {
+                damage = damage / 3;
+            }
+            if (session->py.flags.heat_resistance > 0) {
+                damage = damage / 3;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return damage;
+}
+
 // Poison gas the idiot. -RAK-
 void damagePoisonedGas(int damage, const char *creature_name) {
     playerTakesHit(damage, creature_name);
 
-    py.flags.poisoned += 12 + randomNumber(damage);
+    session->py.flags.poisoned += 12 + randomNumber(damage);
 }
 
 // Burn the fool up. -RAK-
 void damageFire(int damage, const char *creature_name) {
-    if (py.flags.resistant_to_fire) {
-        damage = damage / 3;
-    }
-
-    if (py.flags.heat_resistance > 0) {
-        damage = damage / 3;
-    }
-
-    playerTakesHit(damage, creature_name);
+    playerTakesHit(damageResisted(MagicSpellFlags::Fire, damage), creature_name);
 
     if (inventoryDamageItem(setFlammableItems, 3) > 0) {
         printMessage("There is smoke coming from your pack!");
@@ -601,15 +632,7 @@ void damageFire(int damage, const char *creature_name) {
 
 // Freeze them to death. -RAK-
 void damageCold(int damage, const char *creature_name) {
-    if (py.flags.resistant_to_cold) {
-        damage = damage / 3;
-    }
-
-    if (py.flags.cold_resistance > 0) {
-        damage = damage / 3;
-    }
-
-    playerTakesHit(damage, creature_name);
+    playerTakesHit(damageResisted(MagicSpellFlags::Frost, damage), creature_name);
 
     if (inventoryDamageItem(setFrostDestroyableItems, 5) > 0) {
         printMessage("Something shatters inside your pack!");
@@ -618,11 +641,7 @@ void damageCold(int damage, const char *creature_name) {
 
 // Lightning bolt the sucker away. -RAK-
 void damageLightningBolt(int damage, const char *creature_name) {
-    if (py.flags.resistant_to_light) {
-        damage = damage / 3;
-    }
-
-    playerTakesHit(damage, creature_name);
+    playerTakesHit(damageResisted(MagicSpellFlags::Lightning, damage), creature_name);
 
     if (inventoryDamageItem(setLightningDestroyableItems, 3) > 0) {
         printMessage("There are sparks coming from your pack!");
@@ -637,7 +656,7 @@ void damageAcid(int damage, const char *creature_name) {
         flag = 1;
     }
 
-    if (py.flags.resistant_to_acid) {
+    if (session->py.flags.resistant_to_acid) {
         flag += 2;
     }
 
@@ -99,6 +99,7 @@ bool setLightningDestroyableItems(Inventory_t *item);
 bool setAcidDestroyableItems(Inventory_t *item);
 bool setFireDestroyableItems(Inventory_t *item);
 
+int damageResisted(int spell_type, int damage);
 void damageCorrodingGas(const char *creature_name);
 void damagePoisonedGas(int damage, const char *creature_name);
 void damageFire(int damage, const char *creature_name);
@@ -43,7 +43,7 @@ enum class MageSpellId {
 };
 
 static bool canReadSpells() {
-    if (py.flags.blind > 0) {
+    if (session->py.flags.blind > 0) {
         printMessage("You can't see to read your spell book!");
         return false;
     }
@@ -53,12 +53,12 @@ static bool canReadSpells() {
         return false;
     }
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are too confused.");
         return false;
     }
 
-    if (classes[py.misc.class_id].class_to_use_mage_spells != config::spells::SPELL_TYPE_MAGE) {
+    if (classes[session->py.misc.class_id].class_to_use_mage_spells != config::spells::SPELL_TYPE_MAGE) {
         printMessage("You can't cast spells!");
         return false;
     }
@@ -72,7 +72,7 @@ static void castSpell(int spell_id) {
     switch ((MageSpellId) spell_id) {
         case MageSpellId::MagicMissile:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBolt(py.pos, dir, diceRoll(Dice_t{2, 6}), MagicSpellFlags::MagicMissile, spell_names[0]);
+                spellFireBolt(session->py.pos, dir, diceRoll(Dice_t{2, 6}), MagicSpellFlags::MagicMissile, spell_names[0]);
             }
             break;
         case MageSpellId::DetectMonsters:
@@ -82,7 +82,7 @@ static void castSpell(int spell_id) {
             playerTeleport(10);
             break;
         case MageSpellId::LightArea:
-            (void) spellLightArea(py.pos);
+            (void) spellLightArea(session->py.pos);
             break;
         case MageSpellId::CureLightWounds:
             (void) spellChangePlayerHitPoints(diceRoll(Dice_t{4, 4}));
@@ -93,17 +93,17 @@ static void castSpell(int spell_id) {
             break;
         case MageSpellId::StinkingCloud:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBall(py.pos, dir, 12, MagicSpellFlags::PoisonGas, spell_names[6]);
+                spellFireBall(session->py.pos, dir, 12, MagicSpellFlags::PoisonGas, spell_names[6]);
             }
             break;
         case MageSpellId::Confusion:
             if (getDirectionWithMemory(CNIL, dir)) {
-                (void) spellConfuseMonster(py.pos, dir);
+                (void) spellConfuseMonster(session->py.pos, dir);
             }
             break;
         case MageSpellId::LightningBolt:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBolt(py.pos, dir, diceRoll(Dice_t{4, 8}), MagicSpellFlags::Lightning, spell_names[8]);
+                spellFireBolt(session->py.pos, dir, diceRoll(Dice_t{4, 8}), MagicSpellFlags::Lightning, spell_names[8]);
             }
             break;
         case MageSpellId::TrapDoorDestruction:
@@ -111,28 +111,28 @@ static void castSpell(int spell_id) {
             break;
         case MageSpellId::Sleep1:
             if (getDirectionWithMemory(CNIL, dir)) {
-                (void) spellSleepMonster(py.pos, dir);
+                (void) spellSleepMonster(session->py.pos, dir);
             }
             break;
         case MageSpellId::CurePoison:
             (void) playerCurePoison();
             break;
         case MageSpellId::TeleportSelf:
-            playerTeleport((py.misc.level * 5));
+            playerTeleport((session->py.misc.level * 5));
             break;
         case MageSpellId::RemoveCurse:
             for (int id = 22; id < PLAYER_INVENTORY_SIZE; id++) {
-                inventoryItemRemoveCurse(py.inventory[id]);
+                inventoryItemRemoveCurse(session->py.inventory[id]);
             }
             break;
         case MageSpellId::FrostBolt:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBolt(py.pos, dir, diceRoll(Dice_t{6, 8}), MagicSpellFlags::Frost, spell_names[14]);
+                spellFireBolt(session->py.pos, dir, diceRoll(Dice_t{6, 8}), MagicSpellFlags::Frost, spell_names[14]);
             }
             break;
         case MageSpellId::WallToMud:
             if (getDirectionWithMemory(CNIL, dir)) {
-                (void) spellWallToMud(py.pos, dir);
+                (void) spellWallToMud(session->py.pos, dir);
             }
             break;
         case MageSpellId::CreateFood:
@@ -142,11 +142,11 @@ static void castSpell(int spell_id) {
             (void) spellRechargeItem(20);
             break;
         case MageSpellId::Sleep2:
-            (void) monsterSleep(py.pos);
+            (void) monsterSleep(session->py.pos);
             break;
         case MageSpellId::PolymorphOther:
             if (getDirectionWithMemory(CNIL, dir)) {
-                (void) spellPolymorphMonster(py.pos, dir);
+                (void) spellPolymorphMonster(session->py.pos, dir);
             }
             break;
         case MageSpellId::IdentifyItem:
@@ -157,17 +157,17 @@ static void castSpell(int spell_id) {
             break;
         case MageSpellId::FireBolt:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBolt(py.pos, dir, diceRoll(Dice_t{9, 8}), MagicSpellFlags::Fire, spell_names[22]);
+                spellFireBolt(session->py.pos, dir, diceRoll(Dice_t{9, 8}), MagicSpellFlags::Fire, spell_names[22]);
             }
             break;
         case MageSpellId::SpeedMonster:
             if (getDirectionWithMemory(CNIL, dir)) {
-                (void) spellSpeedMonster(py.pos, dir, -1);
+                (void) spellSpeedMonster(session->py.pos, dir, -1);
             }
             break;
         case MageSpellId::FrostBall:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBall(py.pos, dir, 48, MagicSpellFlags::Frost, spell_names[24]);
+                spellFireBall(session->py.pos, dir, 48, MagicSpellFlags::Frost, spell_names[24]);
             }
             break;
         case MageSpellId::RechargeItem2:
@@ -175,19 +175,19 @@ static void castSpell(int spell_id) {
             break;
         case MageSpellId::TeleportOther:
             if (getDirectionWithMemory(CNIL, dir)) {
-                (void) spellTeleportAwayMonsterInDirection(py.pos, dir);
+                (void) spellTeleportAwayMonsterInDirection(session->py.pos, dir);
             }
             break;
         case MageSpellId::HasteSelf:
-            py.flags.fast += randomNumber(20) + py.misc.level;
+            session->py.flags.fast += randomNumber(20) + session->py.misc.level;
             break;
         case MageSpellId::FireBall:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBall(py.pos, dir, 72, MagicSpellFlags::Fire, spell_names[28]);
+                spellFireBall(session->py.pos, dir, 72, MagicSpellFlags::Fire, spell_names[28]);
             }
             break;
         case MageSpellId::WordOfDestruction:
-            spellDestroyArea(py.pos);
+            spellDestroyArea(session->py.pos);
             break;
         case MageSpellId::Genocide:
             (void) spellGenocide();
@@ -200,7 +200,7 @@ static void castSpell(int spell_id) {
 
 // Throw a magic spell -RAK-
 void getAndCastMagicSpell() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
     if (!canReadSpells()) {
         return;
@@ -227,40 +227,40 @@ void getAndCastMagicSpell() {
         return;
     }
 
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
-    Spell_t const &magic_spell = magic_spells[py.misc.class_id - 1][choice];
+    Spell_t const &magic_spell = magic_spells[session->py.misc.class_id - 1][choice];
 
     if (randomNumber(100) < chance) {
         printMessage("You failed to get the spell off!");
     } else {
         castSpell(choice + 1);
 
-        if (!game.player_free_turn && (py.flags.spells_worked & (1L << choice)) == 0) {
-            py.misc.exp += magic_spell.exp_gain_for_learning << 2;
-            py.flags.spells_worked |= (1L << choice);
+        if (!session->game.player_free_turn && (session->py.flags.spells_worked & (1L << choice)) == 0) {
+            session->py.misc.exp += magic_spell.exp_gain_for_learning << 2;
+            session->py.flags.spells_worked |= (1L << choice);
 
             displayCharacterExperience();
         }
     }
 
-    if (game.player_free_turn) {
+    if (session->game.player_free_turn) {
         return;
     }
 
-    if (magic_spell.mana_required > py.misc.current_mana) {
+    if (magic_spell.mana_required > session->py.misc.current_mana) {
         printMessage("You faint from the effort!");
 
-        py.flags.paralysis = (int16_t) randomNumber((5 * (magic_spell.mana_required - py.misc.current_mana)));
-        py.misc.current_mana = 0;
-        py.misc.current_mana_fraction = 0;
+        session->py.flags.paralysis = (int16_t) randomNumber((5 * (magic_spell.mana_required - session->py.misc.current_mana)));
+        session->py.misc.current_mana = 0;
+        session->py.misc.current_mana_fraction = 0;
 
         if (randomNumber(3) == 1) {
             printMessage("You have damaged your health!");
             (void) playerStatRandomDecrease(PlayerAttr::A_CON);
         }
     } else {
-        py.misc.current_mana -= magic_spell.mana_required;
+        session->py.misc.current_mana -= magic_spell.mana_required;
     }
 
     printCharacterCurrentMana();
@@ -268,12 +268,12 @@ void getAndCastMagicSpell() {
 
 // Returns spell chance of failure for class_to_use_mage_spells -RAK-
 int spellChanceOfSuccess(int spell_id) {
-    Spell_t const &spell = magic_spells[py.misc.class_id - 1][spell_id];
+    Spell_t const &spell = magic_spells[session->py.misc.class_id - 1][spell_id];
 
-    int chance = spell.failure_chance - 3 * (py.misc.level - spell.level_required);
+    int chance = spell.failure_chance - 3 * (session->py.misc.level - spell.level_required);
 
     int stat;
-    if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+    if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
         stat = PlayerAttr::A_INT;
     } else {
         stat = PlayerAttr::A_WIS;
@@ -281,8 +281,8 @@ int spellChanceOfSuccess(int spell_id) {
 
     chance -= 3 * (playerStatAdjustmentWisdomIntelligence(stat) - 1);
 
-    if (spell.mana_required > py.misc.current_mana) {
-        chance += 5 * (spell.mana_required - py.misc.current_mana);
+    if (spell.mana_required > session->py.misc.current_mana) {
+        chance += 5 * (spell.mana_required - session->py.misc.current_mana);
     }
 
     if (chance > 95) {
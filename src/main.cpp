@@ -9,10 +9,13 @@
 #include "version.h"
 
 static bool parseGameSeed(const char *argv, uint32_t &seed);
+static bool parseRandomEngine(const char *argv, RandomEngine &engine);
+static int runServer(const char *address, const char *save_directory, uint32_t seed, const char *record_directory, bool compress);
 
 static const char *usage_instructions = R"(
 Usage:
     umoria [OPTIONS] SAVEGAME
+    umoria -S ADDRESS [OPTIONS] [SAVEDIR]
 
 SAVEGAME is an optional save game filename (default: game.sav)
 
@@ -20,15 +23,36 @@ Options:
     -n           Force start of new game
     -d           Display high scores and exit
     -s NUMBER    Game Seed, as a decimal number (max: 2147483647)
-
+    -r ENGINE    Random number engine for a new game: parkmiller (default) or xoshiro
+    -a           Draw the screen with ANSI escape sequences instead of curses,
+                 and report the bytes written per frame on exit
+    -S ADDRESS   Host games for anyone connecting to ADDRESS, a Unix socket
+                 path or HOST:PORT, saving each character in SAVEDIR
+                 (default: the current directory). Linux only. Connect with
+                 e.g. `socat -,raw,echo=0 UNIX-CONNECT:ADDRESS`
+    -t PATH      Record the game as a ttyrec file at PATH, drawing with ANSI
+                 escape sequences. With -S, PATH is a directory each game is
+                 recorded in, as NAME.YYYY-MM-DD.HHMMSS.ttyrec
+    -z           Gzip the recordings
+
+    -T           Report how long the game took to show its first screen, on exit
     -v           Print version info and exit
     -h           Display this message
 )";
 
 // Initialize, restore, and get the ball rolling. -RAK-
 int main(int argc, char *argv[]) {
+    startupTimerStart();
+
     uint32_t seed = 0;
     bool new_game = false;
+    bool show_scores = false;
+    const char *server_address = nullptr;
+    const char *record_path = nullptr;
+    bool compress_recording = false;
+
+    // The one game played by this process
+    session = sessionCreate();
 
     // call this routine to grab a file pointer to the high score file
     // and prepare things to relinquish setuid privileges
@@ -42,23 +66,20 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    if (!terminalInitialize()) {
-        return 1;
-    }
+    // The help and screen text files are only read the once
+    initializeTextFiles();
 
     // check for user interface option
     for (--argc, ++argv; argc > 0 && argv[0][0] == '-'; --argc, ++argv) {
         switch (argv[0][1]) {
             case 'v':
-                terminalRestore();
                 printf("%d.%d.%d\n", CURRENT_VERSION_MAJOR, CURRENT_VERSION_MINOR, CURRENT_VERSION_PATCH);
                 return 0;
             case 'n':
                 new_game = true;
                 break;
             case 'd':
-                showScoresScreen();
-                exitProgram();
+                show_scores = true;
                 break;
             case 's':
                 // No NUMBER provided?
@@ -71,18 +92,72 @@ int main(int argc, char *argv[]) {
                 ++argv;
 
                 if (!parseGameSeed(argv[0], seed)) {
-                    terminalRestore();
                     printf("Game seed must be a decimal number between 1 and 2147483647\n");
                     return -1;
                 }
 
+                break;
+            case 'r': {
+                // No ENGINE provided?
+                if (argv[1] == nullptr) {
+                    break;
+                }
+
+                // Move onto the ENGINE value
+                --argc;
+                ++argv;
+
+                RandomEngine engine;
+                if (!parseRandomEngine(argv[0], engine)) {
+                    printf("Random number engine must be one of: parkmiller, xoshiro\n");
+                    return -1;
+                }
+                setRandomEngine(engine);
+
+                break;
+            }
+            case 'a':
+                setTerminalOutput(TerminalOutput::Ansi);
+                break;
+            case 'S':
+                // No ADDRESS provided?
+                if (argv[1] == nullptr) {
+                    break;
+                }
+
+                // Move onto the ADDRESS value
+                --argc;
+                ++argv;
+
+                server_address = argv[0];
+                break;
+            case 't':
+                // No PATH provided?
+                if (argv[1] == nullptr) {
+                    break;
+                }
+
+                // Move onto the PATH value
+                --argc;
+                ++argv;
+
+                record_path = argv[0];
+                setTerminalOutput(TerminalOutput::Ansi);
+                break;
+            case 'z':
+                if (!recordingCanCompress()) {
+                    printf("This build of umoria can't compress recordings, as it was built without zlib.\n");
+                    return -1;
+                }
+                compress_recording = true;
+                break;
+            case 'T':
+                (void) atexit(startupTimerReport);
                 break;
             case 'w':
-                game.to_be_wizard = true;
+                session->game.to_be_wizard = true;
                 break;
             default:
-                terminalRestore();
-
                 printf("Robert A. Koeneke's classic dungeon crawler.\n");
                 printf("Umoria %d.%d.%d is released under a GPL-3.0-or-later license.\n", CURRENT_VERSION_MAJOR,
                        CURRENT_VERSION_MINOR, CURRENT_VERSION_PATCH);
@@ -91,10 +166,32 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    // A server plays its games on the terminals of whoever connects
+    if (server_address != nullptr) {
+        return runServer(server_address, argv[0] != CNIL ? argv[0] : ".", seed, record_path, compress_recording);
+    }
+
+    // Recording from before the terminal is set up captures all of it
+    if (record_path != nullptr && !show_scores) {
+        recordingStart(record_path, compress_recording);
+    }
+
+    // The terminal is set up once the options have chosen how to draw on it
+    if (!terminalInitialize()) {
+        recordingStop();
+        recordingFinishAll();
+        return 1;
+    }
+
+    if (show_scores) {
+        showScoresScreen();
+        exitProgram();
+    }
+
     // Auto-restart of saved file
     if (argv[0] != CNIL) {
-        // (void) strcpy(config::files::save_game, argv[0]);
-        config::files::save_game = argv[0];
+        // (void) strcpy(session->save_game, argv[0]);
+        session->save_game = argv[0];
     }
 
     startMoria(seed, new_game);
@@ -116,3 +213,26 @@ static bool parseGameSeed(const char *argv, uint32_t &seed) {
 
     return true;
 }
+
+static bool parseRandomEngine(const char *argv, RandomEngine &engine) {
+    if (strcmp(argv, "parkmiller") == 0) {
+        engine = RandomEngine::ParkMiller;
+        return true;
+    }
+    if (strcmp(argv, "xoshiro") == 0) {
+        engine = RandomEngine::Xoshiro128;
+        return true;
+    }
+
+    return false;
+}
+
+static int runServer(const char *address, const char *save_directory, uint32_t seed, const char *record_directory, bool compress) {
+    ServerConfig_t config{address, save_directory, seed, getRandomEngine()};
+    if (record_directory != nullptr) {
+        config.record_directory = record_directory;
+        config.compress_recordings = compress;
+    }
+
+    return serverRun(config) ? 0 : 1;
+}
@@ -9,28 +9,27 @@
 
 // A horrible hack, needed because compactMonsters() is called from deep
 // within updateMonsters() via monsterPlaceNew() and monsterSummon().
-int hack_monptr = -1;
 
 static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, int monster_id, int attack_type, int damage, vtype_t death_description, bool noticed);
 
 static bool monsterIsVisible(Monster_t const &monster) {
     bool visible = false;
 
-    Tile_t const &tile = dg.floor[monster.pos.y][monster.pos.x];
-    Creature_t const &creature = creatures_list[monster.creature_id];
+    TileConstRef_t tile = session->dg.floor[monster.pos.y][monster.pos.x];
+    CreatureTraits_t const &creature = creature_traits.list[monster.creature_id];
 
-    if (tile.permanent_light || tile.temporary_light || ((py.running_tracker != 0) && monster.distance_from_player < 2 && py.carrying_light)) {
+    if (tile.permanent_light || tile.temporary_light || ((session->py.running_tracker != 0) && monster.distance_from_player < 2 && session->py.carrying_light)) {
         // Normal sight.
         if ((creature.movement & config::monsters::move::CM_INVISIBLE) == 0) {
             visible = true;
-        } else if (py.flags.see_invisible) {
+        } else if (session->py.flags.see_invisible) {
             visible = true;
-            creature_recall[monster.creature_id].movement |= config::monsters::move::CM_INVISIBLE;
+            session->creature_recall[monster.creature_id].movement |= config::monsters::move::CM_INVISIBLE;
         }
-    } else if (py.flags.see_infra > 0 && monster.distance_from_player <= py.flags.see_infra && ((creature.defenses & config::monsters::defense::CD_INFRA) != 0)) {
+    } else if (session->py.flags.see_infra > 0 && monster.distance_from_player <= session->py.flags.see_infra && ((creature.defenses & config::monsters::defense::CD_INFRA) != 0)) {
         // Infra vision.
         visible = true;
-        creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_INFRA;
+        session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_INFRA;
     }
 
     return visible;
@@ -39,14 +38,14 @@ static bool monsterIsVisible(Monster_t const &monster) {
 // Updates screen when monsters move about -RAK-
 void monsterUpdateVisibility(int monster_id) {
     bool visible = false;
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
 
-    if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((py.flags.status & config::player::status::PY_BLIND) == 0u) &&
+    if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((session->py.flags.status & config::player::status::PY_BLIND) == 0u) &&
         coordInsidePanel(Coord_t{monster.pos.y, monster.pos.x})) {
-        if (game.wizard_mode) {
+        if (session->game.wizard_mode) {
             // Wizard sight.
             visible = true;
-        } else if (los(py.pos, monster.pos)) {
+        } else if (los(session->py.pos, monster.pos)) {
             visible = monsterIsVisible(monster);
         }
     }
@@ -59,7 +58,7 @@ void monsterUpdateVisibility(int monster_id) {
             dungeonLiteSpot(Coord_t{monster.pos.y, monster.pos.x});
 
             // notify inventoryExecuteCommand()
-            screen_has_changed = true;
+            session->screen_has_changed = true;
         }
     } else if (monster.lit) {
         // Turn it off.
@@ -67,7 +66,7 @@ void monsterUpdateVisibility(int monster_id) {
         dungeonLiteSpot(Coord_t{monster.pos.y, monster.pos.x});
 
         // notify inventoryExecuteCommand()
-        screen_has_changed = true;
+        session->screen_has_changed = true;
     }
 }
 
@@ -76,7 +75,7 @@ void monsterUpdateVisibility(int monster_id) {
 // a slowed player is handled by moving monsters faster
 static int monsterMovementRate(int16_t speed) {
     if (speed > 0) {
-        if (py.flags.rest != 0) {
+        if (session->py.flags.rest != 0) {
             return 1;
         }
         return speed;
@@ -84,7 +83,7 @@ static int monsterMovementRate(int16_t speed) {
 
     // speed must be negative here
     int rate = 0;
-    if ((dg.game_turn % (2 - speed)) == 0) {
+    if ((session->dg.game_turn % (2 - speed)) == 0) {
         rate = 1;
     }
 
@@ -93,21 +92,21 @@ static int monsterMovementRate(int16_t speed) {
 
 // Makes sure a new creature gets lit up. -CJS-
 static bool monsterMakeVisible(Coord_t coord) {
-    int monster_id = dg.floor[coord.y][coord.x].creature_id;
+    int monster_id = session->dg.floor[coord.y][coord.x].creature_id;
     if (monster_id <= 1) {
         return false;
     }
 
     monsterUpdateVisibility(monster_id);
-    return monsters[monster_id].lit;
+    return session->monsters[monster_id].lit;
 }
 
 // Choose correct directions for monster movement -RAK-
 static void monsterGetMoveDirection(int monster_id, int *directions) {
     int ay, ax, movement;
 
-    int y = monsters[monster_id].pos.y - py.pos.y;
-    int x = monsters[monster_id].pos.x - py.pos.x;
+    int y = session->monsters[monster_id].pos.y - session->py.pos.y;
+    int x = session->monsters[monster_id].pos.x - session->py.pos.x;
 
     if (y < 0) {
         movement = 8;
@@ -355,9 +354,9 @@ static void monsterPrintAttackDescription(char *msg, int attack_id) {
 }
 
 static void monsterConfuseOnAttack(Creature_t const &creature, Monster_t &monster, int attack_type, vtype_t monster_name, bool visible) {
-    if (py.flags.confuse_monster && attack_type != 99) {
+    if (session->py.flags.confuse_monster && attack_type != 99) {
         printMessage("Your hands stop glowing.");
-        py.flags.confuse_monster = false;
+        session->py.flags.confuse_monster = false;
 
         vtype_t msg = {'\0'};
 
@@ -374,8 +373,8 @@ static void monsterConfuseOnAttack(Creature_t const &creature, Monster_t &monste
 
         printMessage(msg);
 
-        if (visible && !game.character_is_dead && randomNumber(4) == 1) {
-            creature_recall[monster.creature_id].defenses |= creature.defenses & config::monsters::defense::CD_NO_SLEEP;
+        if (visible && !session->game.character_is_dead && randomNumber(4) == 1) {
+            session->creature_recall[monster.creature_id].defenses |= creature.defenses & config::monsters::defense::CD_NO_SLEEP;
         }
     }
 }
@@ -383,11 +382,11 @@ static void monsterConfuseOnAttack(Creature_t const &creature, Monster_t &monste
 // Make an attack on the player (chuckle.) -RAK-
 static void monsterAttackPlayer(int monster_id) {
     // don't beat a dead body!
-    if (game.character_is_dead) {
+    if (session->game.character_is_dead) {
         return;
     }
 
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
 
     vtype_t name = {'\0'};
@@ -402,7 +401,7 @@ static void monsterAttackPlayer(int monster_id) {
 
     int attack_counter = 0;
     for (auto &damage_type_id : creature.damage) {
-        if (damage_type_id == 0 || game.character_is_dead) {
+        if (damage_type_id == 0 || session->game.character_is_dead) {
             break;
         }
 
@@ -410,9 +409,9 @@ static void monsterAttackPlayer(int monster_id) {
         uint8_t attack_desc = monster_attacks[damage_type_id].description_id;
         Dice_t dice = monster_attacks[damage_type_id].dice;
 
-        if (py.flags.protect_evil > 0 && ((creature.defenses & config::monsters::defense::CD_EVIL) != 0) && py.misc.level + 1 > creature.level) {
+        if (session->py.flags.protect_evil > 0 && ((creature.defenses & config::monsters::defense::CD_EVIL) != 0) && session->py.misc.level + 1 > creature.level) {
             if (monster.lit) {
-                creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_EVIL;
+                session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_EVIL;
             }
             attack_type = 99;
             attack_desc = 99;
@@ -448,13 +447,13 @@ static void monsterAttackPlayer(int monster_id) {
             // had previously noticed the attack (in which case all this does
             // is help player learn damage), note that in the second case do
             // not increase attacks if creature repelled (no damage done)
-            if ((notice || (visible && creature_recall[monster.creature_id].attacks[attack_counter] != 0 && attack_type != 99)) &&
-                creature_recall[monster.creature_id].attacks[attack_counter] < UCHAR_MAX) {
-                creature_recall[monster.creature_id].attacks[attack_counter]++;
+            if ((notice || (visible && session->creature_recall[monster.creature_id].attacks[attack_counter] != 0 && attack_type != 99)) &&
+                session->creature_recall[monster.creature_id].attacks[attack_counter] < UCHAR_MAX) {
+                session->creature_recall[monster.creature_id].attacks[attack_counter]++;
             }
 
-            if (game.character_is_dead && creature_recall[monster.creature_id].deaths < SHRT_MAX) {
-                creature_recall[monster.creature_id].deaths++;
+            if (session->game.character_is_dead && session->creature_recall[monster.creature_id].deaths < SHRT_MAX) {
+                session->creature_recall[monster.creature_id].deaths++;
             }
         } else {
             if ((attack_desc >= 1 && attack_desc <= 3) || attack_desc == 6) {
@@ -474,8 +473,8 @@ static void monsterAttackPlayer(int monster_id) {
     }
 }
 
-static void monsterOpenDoor(Tile_t &tile, int16_t monster_hp, uint32_t move_bits, bool &do_turn, bool &do_move, uint32_t &rcmove, Coord_t coord) {
-    Inventory_t &item = game.treasure.list[tile.treasure_id];
+static void monsterOpenDoor(TileRef_t tile, int16_t monster_hp, uint32_t move_bits, bool &do_turn, bool &do_move, uint32_t &rcmove, Coord_t coord) {
+    Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
     // Creature can open doors.
     if ((move_bits & config::monsters::move::CM_OPEN_DOOR) != 0u) {
@@ -517,6 +516,7 @@ static void monsterOpenDoor(Tile_t &tile, int16_t monster_hp, uint32_t move_bits
                 item.misc_use = (int16_t)(1 - randomNumber(2));
             }
             tile.feature_id = TILE_CORR_FLOOR;
+            dungeonFloorTileChanged(coord);
             dungeonLiteSpot(coord);
             rcmove |= config::monsters::move::CM_OPEN_DOOR;
             do_move = false;
@@ -532,6 +532,7 @@ static void monsterOpenDoor(Tile_t &tile, int16_t monster_hp, uint32_t move_bits
             // 50% chance of breaking door
             item.misc_use = (int16_t)(1 - randomNumber(2));
             tile.feature_id = TILE_CORR_FLOOR;
+            dungeonFloorTileChanged(coord);
             dungeonLiteSpot(coord);
             printMessage("You hear a door burst open!");
             playerDisturb(1, 0);
@@ -541,7 +542,7 @@ static void monsterOpenDoor(Tile_t &tile, int16_t monster_hp, uint32_t move_bits
 
 static void glyphOfWardingProtection(uint16_t creature_id, uint32_t move_bits, bool &do_move, bool &do_turn, Coord_t coord) {
     if (randomNumber(config::treasure::OBJECTS_RUNE_PROTECTION) < creatures_list[creature_id].level) {
-        if (coord.y == py.pos.y && coord.x == py.pos.x) {
+        if (coord.y == session->py.pos.y && coord.x == session->py.pos.x) {
             printMessage("The rune of protection is broken!");
         }
         (void) dungeonDeleteObject(coord);
@@ -573,8 +574,8 @@ static void monsterMovesOnPlayer(Monster_t const &monster, uint8_t creature_id,
 
         // Creature eats other creatures?
         if (((move_bits & config::monsters::move::CM_EATS_OTHER) != 0u) &&
-            creatures_list[monster.creature_id].kill_exp_value >= creatures_list[monsters[creature_id].creature_id].kill_exp_value) {
-            if (monsters[creature_id].lit) {
+            creatures_list[monster.creature_id].kill_exp_value >= creatures_list[session->monsters[creature_id].creature_id].kill_exp_value) {
+            if (session->monsters[creature_id].lit) {
                 rcmove |= config::monsters::move::CM_EATS_OTHER;
             }
 
@@ -596,9 +597,9 @@ static void monsterMovesOnPlayer(Monster_t const &monster, uint8_t creature_id,
 static void monsterAllowedToMove(Monster_t &monster, uint32_t move_bits, bool &do_turn, uint32_t &rcmove, Coord_t coord) {
     // Pick up or eat an object
     if ((move_bits & config::monsters::move::CM_PICKS_UP) != 0u) {
-        uint8_t treasure_id = dg.floor[coord.y][coord.x].treasure_id;
+        uint8_t treasure_id = session->dg.floor[coord.y][coord.x].treasure_id;
 
-        if (treasure_id != 0 && game.treasure.list[treasure_id].category_id <= TV_MAX_OBJECT) {
+        if (treasure_id != 0 && session->game.treasure.list[treasure_id].category_id <= TV_MAX_OBJECT) {
             rcmove |= config::monsters::move::CM_PICKS_UP;
             (void) dungeonDeleteObject(coord);
         }
@@ -614,7 +615,7 @@ static void monsterAllowedToMove(Monster_t &monster, uint32_t move_bits, bool &d
 
     monster.pos.y = coord.y;
     monster.pos.x = coord.x;
-    monster.distance_from_player = (uint8_t) coordDistanceBetween(py.pos, coord);
+    monster.distance_from_player = (uint8_t) coordDistanceBetween(session->py.pos, coord);
 
     do_turn = true;
 }
@@ -624,8 +625,8 @@ static void makeMove(int monster_id, int *directions, uint32_t &rcmove) {
     bool do_turn = false;
     bool do_move = false;
 
-    Monster_t &monster = monsters[monster_id];
-    uint32_t move_bits = creatures_list[monster.creature_id].movement;
+    Monster_t &monster = session->monsters[monster_id];
+    uint32_t move_bits = creature_traits.list[monster.creature_id].movement;
 
     // Up to 5 attempts at moving, give up.
     Coord_t coord = Coord_t{0, 0};
@@ -636,7 +637,7 @@ static void makeMove(int monster_id, int *directions, uint32_t &rcmove) {
 
         (void) playerMovePosition(directions[i], coord);
 
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (tile.feature_id == TILE_BOUNDARY_WALL) {
             continue;
@@ -655,7 +656,8 @@ static void makeMove(int monster_id, int *directions, uint32_t &rcmove) {
         }
 
         // Glyph of warding present?
-        if (do_move && tile.treasure_id != 0 && game.treasure.list[tile.treasure_id].category_id == TV_VIS_TRAP && game.treasure.list[tile.treasure_id].sub_category_id == 99) {
+        if (do_move && tile.treasure_id != 0 && session->game.treasure.list[tile.treasure_id].category_id == TV_VIS_TRAP &&
+            session->game.treasure.list[tile.treasure_id].sub_category_id == 99) {
             glyphOfWardingProtection(monster.creature_id, move_bits, do_move, do_turn, coord);
         }
 
@@ -681,13 +683,54 @@ static bool monsterCanCastSpells(Monster_t const &monster, uint32_t spells) {
     bool within_range = monster.distance_from_player <= config::monsters::MON_MAX_SPELL_CAST_DISTANCE;
 
     // Must have unobstructed Line-Of-Sight
-    bool unobstructed = los(py.pos, monster.pos);
+    bool unobstructed = los(session->py.pos, monster.pos);
 
     return within_range && unobstructed;
 }
 
+// Picks one of the creature's spells at random, numbered as in
+// monsterExecuteCastingOfSpell()
+int monsterChooseSpell(Creature_t const &creature) {
+    // Extract all possible spells into spell_choice
+    int spell_choice[30];
+    auto spell_flags = (uint32_t)(creature.spells & ~config::monsters::spells::CS_FREQ);
+
+    int id = 0;
+    while (spell_flags != 0) {
+        spell_choice[id] = getAndClearFirstBit(spell_flags);
+        id++;
+    }
+
+    // Choose a spell to cast
+    return spell_choice[randomNumber(id) - 1] + 1;
+}
+
+// Hit points lost by the player from a spell cast at them, as resolved by
+// monsterExecuteCastingOfSpell(), but without any of the other effects of
+// the spell (paralysis, blindness, summoning, drained mana, etc.)
+int monsterSpellHitPointDamage(int spell_id, int monster_hp) {
+    switch (spell_id) {
+        case 8: // Light Wound
+            return playerSavingThrow() ? 0 : diceRoll(Dice_t{3, 8});
+        case 9: // Serious Wound
+            return playerSavingThrow() ? 0 : diceRoll(Dice_t{8, 8});
+        case 20: // Breath Light
+            return spellBreathHitPointDamage(monster_hp / 4, MagicSpellFlags::Lightning);
+        case 21: // Breath Gas
+            return spellBreathHitPointDamage(monster_hp / 3, MagicSpellFlags::PoisonGas);
+        case 22: // Breath Acid
+            return spellBreathHitPointDamage(monster_hp / 3, MagicSpellFlags::Acid);
+        case 23: // Breath Frost
+            return spellBreathHitPointDamage(monster_hp / 3, MagicSpellFlags::Frost);
+        case 24: // Breath Fire
+            return spellBreathHitPointDamage(monster_hp / 3, MagicSpellFlags::Fire);
+        default:
+            return 0;
+    }
+}
+
 void monsterExecuteCastingOfSpell(Monster_t &monster, int monster_id, int spell_id, uint8_t level, vtype_t monster_name, vtype_t death_description) {
-    Coord_t coord = py.pos; //  only used for cases 14 and 15.
+    Coord_t coord = session->py.pos; //  only used for cases 14 and 15.
 
     // Cast the spell.
     switch (spell_id) {
@@ -715,80 +758,80 @@ void monsterExecuteCastingOfSpell(Monster_t &monster, int monster_id, int spell_
             }
             break;
         case 10: // Hold Person
-            if (py.flags.free_action) {
+            if (session->py.flags.free_action) {
                 printMessage("You are unaffected.");
             } else if (playerSavingThrow()) {
                 printMessage("You resist the effects of the spell.");
-            } else if (py.flags.paralysis > 0) {
-                py.flags.paralysis += 2;
+            } else if (session->py.flags.paralysis > 0) {
+                session->py.flags.paralysis += 2;
             } else {
-                py.flags.paralysis = (int16_t)(randomNumber(5) + 4);
+                session->py.flags.paralysis = (int16_t)(randomNumber(5) + 4);
             }
             break;
         case 11: // Cause Blindness
             if (playerSavingThrow()) {
                 printMessage("You resist the effects of the spell.");
-            } else if (py.flags.blind > 0) {
-                py.flags.blind += 6;
+            } else if (session->py.flags.blind > 0) {
+                session->py.flags.blind += 6;
             } else {
-                py.flags.blind += 12 + randomNumber(3);
+                session->py.flags.blind += 12 + randomNumber(3);
             }
             break;
         case 12: // Cause Confuse
             if (playerSavingThrow()) {
                 printMessage("You resist the effects of the spell.");
-            } else if (py.flags.confused > 0) {
-                py.flags.confused += 2;
+            } else if (session->py.flags.confused > 0) {
+                session->py.flags.confused += 2;
             } else {
-                py.flags.confused = (int16_t)(randomNumber(5) + 3);
+                session->py.flags.confused = (int16_t)(randomNumber(5) + 3);
             }
             break;
         case 13: // Cause Fear
             if (playerSavingThrow()) {
                 printMessage("You resist the effects of the spell.");
-            } else if (py.flags.afraid > 0) {
-                py.flags.afraid += 2;
+            } else if (session->py.flags.afraid > 0) {
+                session->py.flags.afraid += 2;
             } else {
-                py.flags.afraid = (int16_t)(randomNumber(5) + 3);
+                session->py.flags.afraid = (int16_t)(randomNumber(5) + 3);
             }
             break;
         case 14: // Summon Monster
             (void) strcat(monster_name, "magically summons a monster!");
             printMessage(monster_name);
-            coord.y = py.pos.y;
-            coord.x = py.pos.x;
+            coord.y = session->py.pos.y;
+            coord.x = session->py.pos.x;
 
             // in case compact_monster() is called,it needs monster_id
-            hack_monptr = monster_id;
+            session->hack_monptr = monster_id;
             (void) monsterSummon(coord, false);
-            hack_monptr = -1;
-            monsterUpdateVisibility((int) dg.floor[coord.y][coord.x].creature_id);
+            session->hack_monptr = -1;
+            monsterUpdateVisibility((int) session->dg.floor[coord.y][coord.x].creature_id);
             break;
         case 15: // Summon Undead
             (void) strcat(monster_name, "magically summons an undead!");
             printMessage(monster_name);
-            coord.y = py.pos.y;
-            coord.x = py.pos.x;
+            coord.y = session->py.pos.y;
+            coord.x = session->py.pos.x;
 
             // in case compact_monster() is called,it needs monster_id
-            hack_monptr = monster_id;
+            session->hack_monptr = monster_id;
             (void) monsterSummonUndead(coord);
-            hack_monptr = -1;
-            monsterUpdateVisibility((int) dg.floor[coord.y][coord.x].creature_id);
+            session->hack_monptr = -1;
+            monsterUpdateVisibility((int) session->dg.floor[coord.y][coord.x].creature_id);
             break;
         case 16: // Slow Person
-            if (py.flags.free_action) {
+            if (session->py.flags.free_action) {
                 printMessage("You are unaffected.");
             } else if (playerSavingThrow()) {
                 printMessage("You resist the effects of the spell.");
-            } else if (py.flags.slow > 0) {
-                py.flags.slow += 2;
+            } else if (session->py.flags.slow > 0) {
+                session->py.flags.slow += 2;
             } else {
-                py.flags.slow = (int16_t)(randomNumber(5) + 3);
+                session->py.flags.slow = (int16_t)(randomNumber(5) + 3);
             }
             break;
         case 17: // Drain Mana
-            if (py.misc.current_mana > 0) {
+            if (session->py.misc.current_mana > 0) {
                 playerDisturb(1, 0);
 
                 vtype_t msg = {'\0'};
@@ -801,12 +844,12 @@ void monsterExecuteCastingOfSpell(Monster_t &monster, int monster_id, int spell_
                 }
 
                 int num = (randomNumber((int) level) >> 1) + 1;
-                if (num > py.misc.current_mana) {
-                    num = py.misc.current_mana;
-                    py.misc.current_mana = 0;
-                    py.misc.current_mana_fraction = 0;
+                if (num > session->py.misc.current_mana) {
+                    num = session->py.misc.current_mana;
+                    session->py.misc.current_mana = 0;
+                    session->py.misc.current_mana_fraction = 0;
                 } else {
-                    py.misc.current_mana -= num;
+                    session->py.misc.current_mana -= num;
                 }
                 printCharacterCurrentMana();
                 monster.hp += 6 * (num);
@@ -815,27 +858,27 @@ void monsterExecuteCastingOfSpell(Monster_t &monster, int monster_id, int spell_
         case 20: // Breath Light
             (void) strcat(monster_name, "breathes lightning.");
             printMessage(monster_name);
-            spellBreath(py.pos, monster_id, (monster.hp / 4), MagicSpellFlags::Lightning, death_description);
+            spellBreath(session->py.pos, monster_id, (monster.hp / 4), MagicSpellFlags::Lightning, death_description);
             break;
         case 21: // Breath Gas
             (void) strcat(monster_name, "breathes gas.");
             printMessage(monster_name);
-            spellBreath(py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::PoisonGas, death_description);
+            spellBreath(session->py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::PoisonGas, death_description);
             break;
         case 22: // Breath Acid
             (void) strcat(monster_name, "breathes acid.");
             printMessage(monster_name);
-            spellBreath(py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::Acid, death_description);
+            spellBreath(session->py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::Acid, death_description);
             break;
         case 23: // Breath Frost
             (void) strcat(monster_name, "breathes frost.");
             printMessage(monster_name);
-            spellBreath(py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::Frost, death_description);
+            spellBreath(session->py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::Frost, death_description);
             break;
         case 24: // Breath Fire
             (void) strcat(monster_name, "breathes fire.");
             printMessage(monster_name);
-            spellBreath(py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::Fire, death_description);
+            spellBreath(session->py.pos, monster_id, (monster.hp / 3), MagicSpellFlags::Fire, death_description);
             break;
         default:
             (void) strcat(monster_name, "cast unknown spell.");
@@ -847,17 +890,18 @@ void monsterExecuteCastingOfSpell(Monster_t &monster, int monster_id, int spell_
 //   castSpellGetId = true if creature changes position
 //   return true (took_turn) if creature casts a spell
 static bool monsterCastSpell(int monster_id) {
-    if (game.character_is_dead) {
+    if (session->game.character_is_dead) {
         return false;
     }
 
-    Monster_t &monster = monsters[monster_id];
-    Creature_t const &creature = creatures_list[monster.creature_id];
+    Monster_t &monster = session->monsters[monster_id];
 
-    if (!monsterCanCastSpells(monster, creature.spells)) {
+    if (!monsterCanCastSpells(monster, creature_traits.list[monster.creature_id].spells)) {
         return false;
     }
 
+    Creature_t const &creature = creatures_list[monster.creature_id];
+
     // Creature is going to cast a spell
 
     // Check to see if monster should be lit.
@@ -874,19 +918,7 @@ static bool monsterCastSpell(int monster_id) {
     vtype_t death_description = {'\0'};
     playerDiedFromString(&death_description, creature.name, creature.movement);
 
-    // Extract all possible spells into spell_choice
-    int spell_choice[30];
-    auto spell_flags = (uint32_t)(creature.spells & ~config::monsters::spells::CS_FREQ);
-
-    int id = 0;
-    while (spell_flags != 0) {
-        spell_choice[id] = getAndClearFirstBit(spell_flags);
-        id++;
-    }
-
-    // Choose a spell to cast
-    int thrown_spell = spell_choice[randomNumber(id) - 1];
-    thrown_spell++;
+    int thrown_spell = monsterChooseSpell(creature);
 
     // all except spellTeleportAwayMonster() and drain mana spells always disturb
     if (thrown_spell > 6 && thrown_spell != 17) {
@@ -902,12 +934,12 @@ static bool monsterCastSpell(int monster_id) {
     monsterExecuteCastingOfSpell(monster, monster_id, thrown_spell, creature.level, name, death_description);
 
     if (monster.lit) {
-        creature_recall[monster.creature_id].spells |= 1L << (thrown_spell - 1);
-        if ((creature_recall[monster.creature_id].spells & config::monsters::spells::CS_FREQ) != config::monsters::spells::CS_FREQ) {
-            creature_recall[monster.creature_id].spells++;
+        session->creature_recall[monster.creature_id].spells |= 1L << (thrown_spell - 1);
+        if ((session->creature_recall[monster.creature_id].spells & config::monsters::spells::CS_FREQ) != config::monsters::spells::CS_FREQ) {
+            session->creature_recall[monster.creature_id].spells++;
         }
-        if (game.character_is_dead && creature_recall[monster.creature_id].deaths < SHRT_MAX) {
-            creature_recall[monster.creature_id].deaths++;
+        if (session->game.character_is_dead && session->creature_recall[monster.creature_id].deaths < SHRT_MAX) {
+            session->creature_recall[monster.creature_id].deaths++;
         }
     }
 
@@ -926,7 +958,7 @@ bool monsterMultiply(Coord_t coord, int creature_id, int monster_id) {
         // don't create a new creature on top of the old one, that
         // causes invincible/invisible creatures to appear.
         if (coordInBounds(position) && (position.y != coord.y || position.x != coord.x)) {
-            Tile_t const &tile = dg.floor[position.y][position.x];
+            TileConstRef_t tile = session->dg.floor[position.y][position.x];
 
             if (tile.feature_id <= MAX_OPEN_SPACE && tile.treasure_id == 0 && tile.creature_id != 1) {
                 // Creature there already?
@@ -935,7 +967,7 @@ bool monsterMultiply(Coord_t coord, int creature_id, int monster_id) {
                     bool cannibalistic = (creatures_list[creature_id].movement & config::monsters::move::CM_EATS_OTHER) != 0;
 
                     // Check the experience level -CJS-
-                    bool experienced = creatures_list[creature_id].kill_exp_value >= creatures_list[monsters[tile.creature_id].creature_id].kill_exp_value;
+                    bool experienced = creatures_list[creature_id].kill_exp_value >= creatures_list[session->monsters[tile.creature_id].creature_id].kill_exp_value;
 
                     if (cannibalistic && experienced) {
                         // It ate an already processed monster. Handle * normally.
@@ -949,30 +981,30 @@ bool monsterMultiply(Coord_t coord, int creature_id, int monster_id) {
                         }
 
                         // in case compact_monster() is called, it needs monster_id.
-                        hack_monptr = monster_id;
+                        session->hack_monptr = monster_id;
                         // Place_monster() may fail if monster list full.
                         bool result = monsterPlaceNew(position, creature_id, false);
-                        hack_monptr = -1;
+                        session->hack_monptr = -1;
                         if (!result) {
                             return false;
                         }
 
-                        monster_multiply_total++;
+                        session->monster_multiply_total++;
                         return monsterMakeVisible(position);
                     }
                 } else {
                     // All clear,  place a monster
 
                     // in case compact_monster() is called,it needs monster_id
-                    hack_monptr = monster_id;
+                    session->hack_monptr = monster_id;
                     // Place_monster() may fail if monster list full.
                     bool result = monsterPlaceNew(position, creature_id, false);
-                    hack_monptr = -1;
+                    session->hack_monptr = -1;
                     if (!result) {
                         return false;
                     }
 
-                    monster_multiply_total++;
+                    session->monster_multiply_total++;
                     return monsterMakeVisible(position);
                 }
             }
@@ -989,7 +1021,7 @@ static void monsterMultiplyCritter(Monster_t const &monster, int monster_id, uin
 
     for (coord.y = monster.pos.y - 1; coord.y <= monster.pos.y + 1; coord.y++) {
         for (coord.x = monster.pos.x - 1; coord.x <= monster.pos.x + 1; coord.x++) {
-            if (coordInBounds(coord) && (dg.floor[coord.y][coord.x].creature_id > 1)) {
+            if (coordInBounds(coord) && (session->dg.floor[coord.y][coord.x].creature_id > 1)) {
                 counter++;
             }
         }
@@ -1027,7 +1059,7 @@ static void monsterMoveOutOfWall(Monster_t const &monster, int monster_id, uint3
     // of i will fail the comparison.
     for (int y = monster.pos.y + 1; y >= (monster.pos.y - 1); y--) {
         for (int x = monster.pos.x - 1; x <= monster.pos.x + 1; x++) {
-            if (dir != 5 && dg.floor[y][x].feature_id <= MAX_OPEN_SPACE && dg.floor[y][x].creature_id != 1) {
+            if (dir != 5 && session->dg.floor[y][x].feature_id <= MAX_OPEN_SPACE && session->dg.floor[y][x].creature_id != 1) {
                 directions[id] = dir;
                 id++;
             }
@@ -1049,12 +1081,12 @@ static void monsterMoveOutOfWall(Monster_t const &monster, int monster_id, uint3
     }
 
     // if still in a wall, let it dig itself out, but also apply some more damage
-    if (dg.floor[monster.pos.y][monster.pos.x].feature_id >= MIN_CAVE_WALL) {
+    if (session->dg.floor[monster.pos.y][monster.pos.x].feature_id >= MIN_CAVE_WALL) {
         // in case the monster dies, may need to callfix1_delete_monster()
         // instead of delete_monsters()
-        hack_monptr = monster_id;
+        session->hack_monptr = monster_id;
         int i = monsterTakeHit(monster_id, diceRoll(Dice_t{8, 8}));
-        hack_monptr = -1;
+        session->hack_monptr = -1;
 
         if (i >= 0) {
             printMessage("You hear a scream muffled by rock!");
@@ -1067,7 +1099,7 @@ static void monsterMoveOutOfWall(Monster_t const &monster, int monster_id, uint3
 }
 
 // Undead only get confused from turn undead, so they should flee
-static void monsterMoveUndead(Creature_t const &creature, int monster_id, uint32_t &rcmove) {
+static void monsterMoveUndead(CreatureTraits_t const &creature, int monster_id, uint32_t &rcmove) {
     int directions[9];
     monsterGetMoveDirection(monster_id, directions);
 
@@ -1083,7 +1115,7 @@ static void monsterMoveUndead(Creature_t const &creature, int monster_id, uint32
     }
 }
 
-static void monsterMoveConfused(Creature_t const &creature, int monster_id, uint32_t &rcmove) {
+static void monsterMoveConfused(CreatureTraits_t const &creature, int monster_id, uint32_t &rcmove) {
     int directions[9];
 
     directions[0] = randomNumber(9);
@@ -1098,7 +1130,7 @@ static void monsterMoveConfused(Creature_t const &creature, int monster_id, uint
     }
 }
 
-static bool monsterDoMove(int monster_id, uint32_t &rcmove, Monster_t &monster, Creature_t const &creature) {
+static bool monsterDoMove(int monster_id, uint32_t &rcmove, Monster_t &monster, CreatureTraits_t const &creature) {
     // Creature is confused or undead turned?
     if (monster.confused_amount != 0u) {
         if ((creature.defenses & config::monsters::defense::CD_UNDEAD) != 0) {
@@ -1165,20 +1197,20 @@ static void monsterAttackWithoutMoving(int monster_id, uint32_t &rcmove, uint8_t
 
 // Move the critters about the dungeon -RAK-
 static void monsterMove(int monster_id, uint32_t &rcmove) {
-    Monster_t &monster = monsters[monster_id];
-    Creature_t const &creature = creatures_list[monster.creature_id];
+    Monster_t &monster = session->monsters[monster_id];
+    CreatureTraits_t const &creature = creature_traits.list[monster.creature_id];
 
     // Does the critter multiply?
     // rest could be negative, to be safe, only use mod with positive values.
-    auto abs_rest_period = (int) std::abs((std::intmax_t) py.flags.rest);
-    if (((creature.movement & config::monsters::move::CM_MULTIPLY) != 0u) && config::monsters::MON_MAX_MULTIPLY_PER_LEVEL >= monster_multiply_total &&
+    auto abs_rest_period = (int) std::abs((std::intmax_t) session->py.flags.rest);
+    if (((creature.movement & config::monsters::move::CM_MULTIPLY) != 0u) && config::monsters::MON_MAX_MULTIPLY_PER_LEVEL >= session->monster_multiply_total &&
         (abs_rest_period % config::monsters::MON_MULTIPLY_ADJUST) == 0) {
         monsterMultiplyCritter(monster, monster_id, rcmove);
     }
 
     // if in wall, must immediately escape to a clear area
     // then monster movement finished
-    if (((creature.movement & config::monsters::move::CM_PHASE) == 0u) && dg.floor[monster.pos.y][monster.pos.x].feature_id >= MIN_CAVE_WALL) {
+    if (((creature.movement & config::monsters::move::CM_PHASE) == 0u) && session->dg.floor[monster.pos.y][monster.pos.x].feature_id >= MIN_CAVE_WALL) {
         monsterMoveOutOfWall(monster, monster_id, rcmove);
         return;
     }
@@ -1220,14 +1252,14 @@ static void monsterMove(int monster_id, uint32_t &rcmove) {
     if (((creature.movement & config::monsters::move::CM_ONLY_MAGIC) != 0u) && monster.distance_from_player < 2) {
         // A little hack for Quylthulgs, so that one will eventually
         // notice that they have no physical attacks.
-        if (creature_recall[monster.creature_id].attacks[0] < UCHAR_MAX) {
-            creature_recall[monster.creature_id].attacks[0]++;
+        if (session->creature_recall[monster.creature_id].attacks[0] < UCHAR_MAX) {
+            session->creature_recall[monster.creature_id].attacks[0]++;
         }
 
         // Another little hack for Quylthulgs, so that one can
         // eventually learn their speed.
-        if (creature_recall[monster.creature_id].attacks[0] > 20) {
-            creature_recall[monster.creature_id].movement |= config::monsters::move::CM_ONLY_MAGIC;
+        if (session->creature_recall[monster.creature_id].attacks[0] > 20) {
+            session->creature_recall[monster.creature_id].movement |= config::monsters::move::CM_ONLY_MAGIC;
         }
     }
 }
@@ -1237,7 +1269,7 @@ static void memoryUpdateRecall(Monster_t const &monster, bool wake, bool ignore,
         return;
     }
 
-    Recall_t &memory = creature_recall[monster.creature_id];
+    Recall_t &memory = session->creature_recall[monster.creature_id];
 
     if (wake) {
         if (memory.wake < UCHAR_MAX) {
@@ -1253,6 +1285,8 @@ static void memoryUpdateRecall(Monster_t const &monster, bool wake, bool ignore,
 }
 
 static void monsterAttackingUpdate(Monster_t &monster, int monster_id, int moves) {
+    CreatureTraits_t const &creature = creature_traits.list[monster.creature_id];
+
     for (int i = moves; i > 0; i--) {
         bool wake = false;
         bool ignore = false;
@@ -1261,15 +1295,15 @@ static void monsterAttackingUpdate(Monster_t &monster, int monster_id, int moves
 
         // Monsters trapped in rock must be given a turn also,
         // so that they will die/dig out immediately.
-        if (monster.lit || monster.distance_from_player <= creatures_list[monster.creature_id].area_affect_radius ||
-            (((creatures_list[monster.creature_id].movement & config::monsters::move::CM_PHASE) == 0u) && dg.floor[monster.pos.y][monster.pos.x].feature_id >= MIN_CAVE_WALL)) {
+        if (monster.lit || monster.distance_from_player <= creature.area_affect_radius ||
+            (((creature.movement & config::monsters::move::CM_PHASE) == 0u) && session->dg.floor[monster.pos.y][monster.pos.x].feature_id >= MIN_CAVE_WALL)) {
             if (monster.sleep_count > 0) {
-                if (py.flags.aggravate) {
+                if (session->py.flags.aggravate) {
                     monster.sleep_count = 0;
-                } else if ((py.flags.rest == 0 && py.flags.paralysis < 1) || (randomNumber(50) == 1)) {
+                } else if ((session->py.flags.rest == 0 && session->py.flags.paralysis < 1) || (randomNumber(50) == 1)) {
                     int notice = randomNumber(1024);
 
-                    if (notice * notice * notice <= (1L << (29 - py.misc.stealth_factor))) {
+                    if (notice * notice * notice <= (1L << (29 - session->py.misc.stealth_factor))) {
                         monster.sleep_count -= (100 / monster.distance_from_player);
                         if (monster.sleep_count > 0) {
                             ignore = true;
@@ -1285,7 +1319,7 @@ static void monsterAttackingUpdate(Monster_t &monster, int monster_id, int moves
 
             if (monster.stunned_amount != 0) {
                 // NOTE: Balrog = 100*100 = 10000, it always recovers instantly
-                if (randomNumber(5000) < creatures_list[monster.creature_id].level * creatures_list[monster.creature_id].level) {
+                if (randomNumber(5000) < creature.level * creature.level) {
                     monster.stunned_amount = 0;
                 } else {
                     monster.stunned_amount--;
@@ -1312,8 +1346,8 @@ static void monsterAttackingUpdate(Monster_t &monster, int monster_id, int moves
 // Creatures movement and attacking are done from here -RAK-
 void updateMonsters(bool attack) {
     // Process the monsters
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID && !game.character_is_dead; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID && !session->game.character_is_dead; id--) {
+        Monster_t &monster = session->monsters[id];
 
         // Get rid of an eaten/breathed on monster.  Note: Be sure not to
         // process this monster. This is necessary because we can't delete
@@ -1323,7 +1357,7 @@ void updateMonsters(bool attack) {
             continue;
         }
 
-        monster.distance_from_player = (uint8_t) coordDistanceBetween(py.pos, Coord_t{monster.pos.y, monster.pos.x});
+        monster.distance_from_player = (uint8_t) coordDistanceBetween(session->py.pos, Coord_t{monster.pos.y, monster.pos.x});
 
         // Attack is argument passed to CREATURE
         if (attack) {
@@ -1351,7 +1385,7 @@ void updateMonsters(bool attack) {
 // Decreases monsters hit points and deletes monster if needed.
 // (Picking on my babies.) -RAK-
 int monsterTakeHit(int monster_id, int damage) {
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
 
     monster.sleep_count = 0;
@@ -1363,9 +1397,9 @@ int monsterTakeHit(int monster_id, int damage) {
 
     uint32_t treasure_flags = monsterDeath(Coord_t{monster.pos.y, monster.pos.x}, creature.movement);
 
-    Recall_t &memory = creature_recall[monster.creature_id];
+    Recall_t &memory = session->creature_recall[monster.creature_id];
 
-    if ((py.flags.blind < 1 && monster.lit) || ((creature.movement & config::monsters::move::CM_WIN) != 0u)) {
+    if ((session->py.flags.blind < 1 && monster.lit) || ((creature.movement & config::monsters::move::CM_WIN) != 0u)) {
         auto tmp = (uint32_t)((memory.movement & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT);
 
         if (tmp > ((treasure_flags & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT)) {
@@ -1387,7 +1421,7 @@ int monsterTakeHit(int monster_id, int damage) {
 
     // in case this is called from within updateMonsters(), this is a horrible
     // hack, the monsters/updateMonsters() code needs to be rewritten.
-    if (hack_monptr < monster_id) {
+    if (session->hack_monptr < monster_id) {
         dungeonDeleteMonster(monster_id);
     } else {
         dungeonRemoveMonsterFromLevel(monster_id);
@@ -1459,8 +1493,8 @@ uint32_t monsterDeath(Coord_t coord, uint32_t flags) {
     }
 
     // maybe the player died in mid-turn
-    if (((flags & config::monsters::move::CM_WIN) != 0u) && !game.character_is_dead) {
-        game.total_winner = true;
+    if (((flags & config::monsters::move::CM_WIN) != 0u) && !session->game.character_is_dead) {
+        session->game.total_winner = true;
 
         printCharacterWinner();
 
@@ -1509,20 +1543,20 @@ bool monsterSleep(Coord_t coord) {
 
     for (int y = coord.y - 1; y <= coord.y + 1 && y < MAX_HEIGHT; y++) {
         for (int x = coord.x - 1; x <= coord.x + 1 && x < MAX_WIDTH; x++) {
-            uint8_t monster_id = dg.floor[y][x].creature_id;
+            uint8_t monster_id = session->dg.floor[y][x].creature_id;
 
             if (monster_id <= 1) {
                 continue;
             }
 
-            Monster_t &monster = monsters[monster_id];
+            Monster_t &monster = session->monsters[monster_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             auto name = monsterNameDescription(creature.name, monster.lit);
 
             if (randomNumber(MON_MAX_LEVELS) < creature.level || ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0)) {
                 if (monster.lit && ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0)) {
-                    creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
+                    session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
                 }
 
                 printMonsterActionText(name, "is unaffected.");
@@ -1538,6 +1572,57 @@ bool monsterSleep(Coord_t coord) {
     return asleep;
 }
 
+// Hit points lost by the player from a creature attack which has hit,
+// as resolved by executeAttackOnPlayer(), but without any of the other
+// effects of the attack (drained stats, damaged items, stolen gold, etc.)
+int monsterAttackHitPointDamage(int attack_type, int damage) {
+    switch (attack_type) {
+        case 1: // Normal attack
+            // round half-way case down
+            return damage - ((session->py.misc.ac + session->py.misc.magical_ac) * damage) / 200;
+        case 5: // Fire attack
+            if (session->py.flags.resistant_to_fire) {
+                damage = damage / 3;
+            }
+            if (session->py.flags.heat_resistance > 0) {
+                damage = damage / 3;
+            }
+            return damage;
+        case 6: // Acid attack
+            if (session->py.flags.resistant_to_acid) {
+                damage = damage / 3;
+            }
+            return damage;
+        case 7: // Cold attack
+            if (session->py.flags.resistant_to_cold) {
+                damage = damage / 3;
+            }
+            if (session->py.flags.cold_resistance > 0) {
+                damage = damage / 3;
+            }
+            return damage;
+        case 8: // Lightning attack
+            if (session->py.flags.resistant_to_light) {
+                damage = damage / 3;
+            }
+            return damage;
+        case 2:  // Lose Strength
+        case 3:  // Confusion attack
+        case 4:  // Fear attack
+        case 9:  // Corrosion attack
+        case 10: // Blindness attack
+        case 11: // Paralysis attack
+        case 14: // Poison
+        case 15: // Lose dexterity
+        case 16: // Lose constitution
+        case 17: // Lose intelligence
+        case 18: // Lose wisdom
+            return damage;
+        default:
+            return 0;
+    }
+}
+
 static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, int monster_id, int attack_type, int damage, vtype_t death_description, bool noticed) {
     int item_pos_start;
     int item_pos_end;
@@ -1545,13 +1630,11 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
 
     switch (attack_type) {
         case 1: // Normal attack
-            // round half-way case down
-            damage -= ((py.misc.ac + py.misc.magical_ac) * damage) / 200;
-            playerTakesHit(damage, death_description);
+            playerTakesHit(monsterAttackHitPointDamage(attack_type, damage), death_description);
             break;
         case 2: // Lose Strength
             playerTakesHit(damage, death_description);
-            if (py.flags.sustain_str) {
+            if (session->py.flags.sustain_str) {
                 printMessage("You feel weaker for a moment, but it passes.");
             } else if (randomNumber(2) == 1) {
                 printMessage("You feel weaker.");
@@ -1563,13 +1646,13 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
         case 3: // Confusion attack
             playerTakesHit(damage, death_description);
             if (randomNumber(2) == 1) {
-                if (py.flags.confused < 1) {
+                if (session->py.flags.confused < 1) {
                     printMessage("You feel confused.");
-                    py.flags.confused += randomNumber((int) creature_level);
+                    session->py.flags.confused += randomNumber((int) creature_level);
                 } else {
                     noticed = false;
                 }
-                py.flags.confused += 3;
+                session->py.flags.confused += 3;
             } else {
                 noticed = false;
             }
@@ -1578,11 +1661,11 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             playerTakesHit(damage, death_description);
             if (playerSavingThrow()) {
                 printMessage("You resist the effects!");
-            } else if (py.flags.afraid < 1) {
+            } else if (session->py.flags.afraid < 1) {
                 printMessage("You are suddenly afraid!");
-                py.flags.afraid += 3 + randomNumber((int) creature_level);
+                session->py.flags.afraid += 3 + randomNumber((int) creature_level);
             } else {
-                py.flags.afraid += 3;
+                session->py.flags.afraid += 3;
                 noticed = false;
             }
             break;
@@ -1609,11 +1692,11 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             break;
         case 10: // Blindness attack
             playerTakesHit(damage, death_description);
-            if (py.flags.blind < 1) {
-                py.flags.blind += 10 + randomNumber((int) creature_level);
+            if (session->py.flags.blind < 1) {
+                session->py.flags.blind += 10 + randomNumber((int) creature_level);
                 printMessage("Your eyes begin to sting.");
             } else {
-                py.flags.blind += 5;
+                session->py.flags.blind += 5;
                 noticed = false;
             }
             break;
@@ -1621,11 +1704,11 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             playerTakesHit(damage, death_description);
             if (playerSavingThrow()) {
                 printMessage("You resist the effects!");
-            } else if (py.flags.paralysis < 1) {
-                if (py.flags.free_action) {
+            } else if (session->py.flags.paralysis < 1) {
+                if (session->py.flags.free_action) {
                     printMessage("You are unaffected.");
                 } else {
-                    py.flags.paralysis = (int16_t)(randomNumber((int) creature_level) + 3);
+                    session->py.flags.paralysis = (int16_t)(randomNumber((int) creature_level) + 3);
                     printMessage("You are paralyzed.");
                 }
             } else {
@@ -1633,14 +1716,14 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             }
             break;
         case 12: // Steal Money
-            if (py.flags.paralysis < 1 && randomNumber(124) < py.stats.used[PlayerAttr::A_DEX]) {
+            if (session->py.flags.paralysis < 1 && randomNumber(124) < session->py.stats.used[PlayerAttr::A_DEX]) {
                 printMessage("You quickly protect your money pouch!");
             } else {
-                gold = (py.misc.au / 10) + randomNumber(25);
-                if (gold > py.misc.au) {
-                    py.misc.au = 0;
+                gold = (session->py.misc.au / 10) + randomNumber(25);
+                if (gold > session->py.misc.au) {
+                    session->py.misc.au = 0;
                 } else {
-                    py.misc.au -= gold;
+                    session->py.misc.au -= gold;
                 }
                 printMessage("Your purse feels lighter.");
                 printCharacterGoldValue();
@@ -1651,10 +1734,10 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             }
             break;
         case 13: // Steal Object
-            if (py.flags.paralysis < 1 && randomNumber(124) < py.stats.used[PlayerAttr::A_DEX]) {
+            if (session->py.flags.paralysis < 1 && randomNumber(124) < session->py.stats.used[PlayerAttr::A_DEX]) {
                 printMessage("You grab hold of your backpack!");
             } else {
-                inventoryDestroyItem(randomNumber(py.pack.unique_items) - 1);
+                inventoryDestroyItem(randomNumber(session->py.pack.unique_items) - 1);
                 printMessage("Your backpack feels lighter.");
             }
             if (randomNumber(2) == 1) {
@@ -1665,11 +1748,11 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
         case 14: // Poison
             playerTakesHit(damage, death_description);
             printMessage("You feel very sick.");
-            py.flags.poisoned += randomNumber((int) creature_level) + 5;
+            session->py.flags.poisoned += randomNumber((int) creature_level) + 5;
             break;
         case 15: // Lose dexterity
             playerTakesHit(damage, death_description);
-            if (py.flags.sustain_dex) {
+            if (session->py.flags.sustain_dex) {
                 printMessage("You feel clumsy for a moment, but it passes.");
             } else {
                 printMessage("You feel more clumsy.");
@@ -1678,7 +1761,7 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             break;
         case 16: // Lose constitution
             playerTakesHit(damage, death_description);
-            if (py.flags.sustain_con) {
+            if (session->py.flags.sustain_con) {
                 printMessage("Your body resists the effects of the disease.");
             } else {
                 printMessage("Your health is damaged!");
@@ -1688,7 +1771,7 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
         case 17: // Lose intelligence
             playerTakesHit(damage, death_description);
             printMessage("You have trouble thinking clearly.");
-            if (py.flags.sustain_int) {
+            if (session->py.flags.sustain_int) {
                 printMessage("But your mind quickly clears.");
             } else {
                 (void) playerStatRandomDecrease(PlayerAttr::A_INT);
@@ -1696,7 +1779,7 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             break;
         case 18: // Lose wisdom
             playerTakesHit(damage, death_description);
-            if (py.flags.sustain_wis) {
+            if (session->py.flags.sustain_wis) {
                 printMessage("Your wisdom is sustained.");
             } else {
                 printMessage("Your wisdom is drained.");
@@ -1705,7 +1788,7 @@ static bool executeAttackOnPlayer(uint8_t creature_level, int16_t &monster_hp, i
             break;
         case 19: // Lose experience
             printMessage("You feel your life draining away!");
-            spellLoseEXP(damage + (py.misc.exp / 100) * config::monsters::MON_PLAYER_EXP_DRAINED_PER_HIT);
+            spellLoseEXP(damage + (session->py.misc.exp / 100) * config::monsters::MON_PLAYER_EXP_DRAINED_PER_HIT);
             break;
         case 20: // Aggravate monster
             (void) spellAggravateMonsters(20);
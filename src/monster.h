@@ -40,6 +40,18 @@ typedef struct {
     uint8_t level;              // Level of creature
 } Creature_t;
 
+// CreatureTraits_t holds the parts of a Creature_t which the monster AI
+// reads on every turn, packed together so they share a cache line.
+typedef struct {
+    uint32_t movement;          // Bit field
+    uint32_t spells;            // Creature spells
+    uint16_t defenses;          // Bit field
+    uint8_t speed;              // Movement speed+10
+    uint8_t level;              // Level of creature
+    uint8_t sleep_counter;      // Inactive counter / 10
+    uint8_t area_affect_radius; // Area affect radius
+} CreatureTraits_t;
+
 // MonsterAttack_t is a base data object.
 // Holds the data for a monster's attack and damage type
 typedef struct {
@@ -58,20 +70,38 @@ constexpr uint8_t MON_TOTAL_ALLOCATIONS = 125; // Max that can be allocated
 constexpr uint8_t MON_MAX_LEVELS = 40;         // Maximum level of creatures
 constexpr uint8_t MON_MAX_ATTACKS = 4;         // Max num attacks (used in mons memory) -CJS-
 
-extern int hack_monptr;
-extern Creature_t creatures_list[MON_MAX_CREATURES];
-extern Monster_t monsters[MON_TOTAL_ALLOCATIONS];
-extern int16_t monster_levels[MON_MAX_LEVELS + 1];
+// The creature traits, built from creatures_list at compile time
+typedef struct {
+    alignas(64) CreatureTraits_t list[MON_MAX_CREATURES];
+} CreatureTraitsTable_t;
+
+extern Creature_t const creatures_list[MON_MAX_CREATURES];
+extern CreatureTraitsTable_t const creature_traits;
+
+extern int16_t const (&monster_levels)[MON_MAX_LEVELS + 1];
+
+// Alias table for picking the level of a monster suitable for a given
+// dungeon depth, see monsterGetOneSuitableForLevel(). Column `c` is for
+// creature level `c + 1`, and every column holds `column_weight`.
+typedef struct {
+    int count;
+    int32_t column_weight;
+    int32_t threshold[MON_MAX_LEVELS];
+    uint8_t alias[MON_MAX_LEVELS];
+} MonsterLevelSampler_t;
+
+extern MonsterLevelSampler_t const (&monster_level_samplers)[MON_MAX_LEVELS + 1];
 extern MonsterAttack_t monster_attacks[MON_ATTACK_TYPES];
 extern Monster_t blank_monster;
-extern int16_t next_free_monster_id;
-extern int16_t monster_multiply_total;
 
 void monsterUpdateVisibility(int monster_id);
 bool monsterMultiply(Coord_t coord, int creature_id, int monster_id);
 void updateMonsters(bool attack);
 uint32_t monsterDeath(Coord_t coord, uint32_t flags);
 int monsterTakeHit(int monster_id, int damage);
+int monsterAttackHitPointDamage(int attack_type, int damage);
+int monsterChooseSpell(Creature_t const &creature);
+int monsterSpellHitPointDamage(int spell_id, int monster_hp);
 void printMonsterActionText(const std::string &name, const std::string &action);
 std::string monsterNameDescription(const std::string &real_name, bool is_lit);
 bool monsterSleep(Coord_t coord);
@@ -0,0 +1,181 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Times the per turn monster loop, updateMonsters(), with a full level of
+// awake monsters and with 1000 of them. Run it from the build directory:
+//
+//     $ ./monster_bench [TURNS]
+//
+// A level holds at most MON_TOTAL_ALLOCATIONS monsters, as the tiles keep
+// the monster ids in a byte, so 1000 monsters are spread over several
+// games, each in its own session, which take their turns one after the
+// other as the server plays them.
+
+#include "headers.h"
+
+#include <chrono>
+#include <vector>
+
+// Deep enough for plenty of spell casters and breathers
+constexpr int BENCH_DEPTH = 20;
+
+// The keys creating the character of a game: a human male warrior
+static const char bench_keys[] = "am\033aBench\r ";
+
+typedef struct {
+    Session_t *session;
+    TerminalLink_t link;
+    size_t next_key;
+    int monsters;
+} BenchGame_t;
+
+static void benchLinkWrite(void *context, const char *bytes, size_t length) {
+    (void) context;
+    (void) bytes;
+    (void) length;
+}
+
+// Plays the character creation keys, then escapes out of any prompt
+static int benchLinkGetKey(void *context) {
+    auto &game = *(BenchGame_t *) context;
+
+    if (game.next_key < sizeof(bench_keys) - 1) {
+        return bench_keys[game.next_key++];
+    }
+
+    return ESCAPE;
+}
+
+static bool benchLinkKeyWaiting(void *context, int microseconds) {
+    (void) context;
+    (void) microseconds;
+
+    return false;
+}
+
+static void benchLinkHangUp(void *context) {
+    (void) context;
+
+    (void) printf("The game asked to hang up.\n");
+    exit(1);
+}
+
+// Keeps the player alive through any number of monster attacks
+static void benchRevivePlayer() {
+    session->py.misc.max_hp = SHRT_MAX;
+    session->py.misc.current_hp = SHRT_MAX;
+    session->game.character_is_dead = false;
+}
+
+// Brings the level back up to the game's number of monsters, as monsters
+// are compacted away when breeders fill the level
+static void benchRefillMonsters(BenchGame_t const &game) {
+    int count = session->next_free_monster_id - config::monsters::MON_MIN_INDEX_ID;
+
+    if (count < game.monsters) {
+        monsterPlaceNewWithinDistance(game.monsters - count, 0, false);
+    }
+}
+
+// Starts a game on a new level, filled with its number of awake monsters
+static void benchStartGame(BenchGame_t &game, uint32_t seed) {
+    game.session = sessionCreate();
+    game.link = TerminalLink_t{&game, benchLinkWrite, benchLinkGetKey, benchLinkKeyWaiting, benchLinkHangUp};
+    game.next_key = 0;
+
+    session = game.session;
+    session->terminal_link = &game.link;
+
+    if (!terminalInitialize()) {
+        exit(1);
+    }
+
+    seedsInitialize(seed);
+    playerInitializeBaseExperienceLevels();
+    characterCreate();
+    magicInitializeItemNames();
+    benchRevivePlayer();
+
+    session->dg.current_level = BENCH_DEPTH;
+    generateCave();
+
+    // Wake the monsters the level was generated with
+    for (int id = config::monsters::MON_MIN_INDEX_ID; id < session->next_free_monster_id; id++) {
+        session->monsters[id].sleep_count = 0;
+    }
+
+    benchRefillMonsters(game);
+}
+
+static int benchMonstersCount(std::vector<BenchGame_t> const &games) {
+    int count = 0;
+
+    for (auto const &game : games) {
+        count += game.session->next_free_monster_id - config::monsters::MON_MIN_INDEX_ID;
+    }
+
+    return count;
+}
+
+// Times the given number of turns of monsters, spread over as few games as they fit
+static void benchMonsterTurns(int monsters, int turns) {
+    const int level_monsters = MON_TOTAL_ALLOCATIONS - config::monsters::MON_MIN_INDEX_ID;
+
+    int games_count = (monsters + level_monsters - 1) / level_monsters;
+
+    // A vector of the games, as each link points back at its own game
+    std::vector<BenchGame_t> games((size_t) games_count);
+
+    for (int i = 0; i < games_count; i++) {
+        games[(size_t) i].monsters = monsters / games_count + (i < monsters % games_count ? 1 : 0);
+        benchStartGame(games[(size_t) i], (uint32_t)(i + 1) * 7919);
+    }
+
+    int started_with = benchMonstersCount(games);
+    int64_t monster_turns = 0;
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+
+    for (int turn = 0; turn < turns; turn++) {
+        for (auto &game : games) {
+            session = game.session;
+            session->dg.game_turn++;
+
+            monster_turns += session->next_free_monster_id - config::monsters::MON_MIN_INDEX_ID;
+
+            auto start = std::chrono::steady_clock::now();
+            updateMonsters(true);
+            elapsed += std::chrono::steady_clock::now() - start;
+
+            benchRevivePlayer();
+            benchRefillMonsters(game);
+        }
+    }
+
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+    (void) printf("%4d monsters on %d level(s): %8.1f us per turn, %6.1f ns per monster turn\n", //
+                  started_with, games_count, (double) nanoseconds / turns / 1000.0, (double) nanoseconds / (double) monster_turns);
+
+    for (auto &game : games) {
+        sessionDestroy(game.session);
+    }
+    session = nullptr;
+}
+
+int main(int argc, char *argv[]) {
+    int turns = 1000;
+
+    if (argc > 1 && (!stringToNumber(argv[1], turns) || turns < 1)) {
+        (void) printf("Usage: monster_bench [TURNS]\n");
+        return 1;
+    }
+
+    setTerminalOutput(TerminalOutput::Ansi);
+
+    benchMonsterTurns(MON_TOTAL_ALLOCATIONS - config::monsters::MON_MIN_INDEX_ID, turns);
+    benchMonsterTurns(1000, turns);
+
+    return 0;
+}
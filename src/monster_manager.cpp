@@ -7,24 +7,19 @@
 
 #include "headers.h"
 
-Monster_t monsters[MON_TOTAL_ALLOCATIONS];
-int16_t monster_levels[MON_MAX_LEVELS + 1];
-
 // Values for a blank monster
 Monster_t blank_monster = {0, 0, 0, 0, Coord_t{0, 0}, 0, false, 0, 0};
 
-int16_t next_free_monster_id;   // ID for the next available monster ptr
-int16_t monster_multiply_total; // Total number of reproduction's of creatures
 
 // Returns a pointer to next free space -RAK-
 // Returns -1 if could not allocate a monster.
 static int popm() {
-    if (next_free_monster_id == MON_TOTAL_ALLOCATIONS) {
+    if (session->next_free_monster_id == MON_TOTAL_ALLOCATIONS) {
         if (!compactMonsters()) {
             return -1;
         }
     }
-    return next_free_monster_id++;
+    return session->next_free_monster_id++;
 }
 
 // Places a monster at given location -RAK-
@@ -36,7 +31,7 @@ bool monsterPlaceNew(Coord_t coord, int creature_id, bool sleeping) {
         return false;
     }
 
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
 
     monster.pos.y = coord.y;
     monster.pos.x = coord.x;
@@ -49,12 +44,12 @@ bool monsterPlaceNew(Coord_t coord, int creature_id, bool sleeping) {
     }
 
     // the creatures_list[] speed value is 10 greater, so that it can be a uint8_t
-    monster.speed = (int16_t)(creatures_list[creature_id].speed - 10 + py.flags.speed);
+    monster.speed = (int16_t)(creatures_list[creature_id].speed - 10 + session->py.flags.speed);
     monster.stunned_amount = 0;
-    monster.distance_from_player = (uint8_t) coordDistanceBetween(py.pos, coord);
+    monster.distance_from_player = (uint8_t) coordDistanceBetween(session->py.pos, coord);
     monster.lit = false;
 
-    dg.floor[coord.y][coord.x].creature_id = (uint8_t) monster_id;
+    session->dg.floor[coord.y][coord.x].creature_id = (uint8_t) monster_id;
 
     if (sleeping) {
         if (creatures_list[creature_id].sleep_counter == 0) {
@@ -71,20 +66,30 @@ bool monsterPlaceNew(Coord_t coord, int creature_id, bool sleeping) {
 
 // Places a monster at given location -RAK-
 void monsterPlaceWinning() {
-    if (game.total_winner) {
+    if (session->game.total_winner) {
         return;
     }
 
     Coord_t coord = Coord_t{0, 0};
+    FloorTileSearch_t search = dungeonSearchFloorTiles(FloorTiles::Any);
+
+    bool found = false;
+
+    while (dungeonNextFloorTile(search, coord)) {
+        if (session->dg.floor[coord.y][coord.x].feature_id < MIN_CLOSED_SPACE &&           //
+            session->dg.floor[coord.y][coord.x].creature_id == 0 &&                        //
+            session->dg.floor[coord.y][coord.x].treasure_id == 0 &&                        //
+            coordDistanceBetween(coord, session->py.pos) > config::monsters::MON_MAX_SIGHT //
+        ) {
+            found = true;
+            break;
+        }
+    }
 
-    do {
-        coord.y = randomNumber(dg.height - 2);
-        coord.x = randomNumber(dg.width - 2);
-    } while (dg.floor[coord.y][coord.x].feature_id >= MIN_CLOSED_SPACE ||           //
-             dg.floor[coord.y][coord.x].creature_id != 0 ||                         //
-             dg.floor[coord.y][coord.x].treasure_id != 0 ||                         //
-             coordDistanceBetween(coord, py.pos) <= config::monsters::MON_MAX_SIGHT //
-    );
+    // No room on this level, try again on the next one
+    if (!found) {
+        return;
+    }
 
     int creature_id = randomNumber(config::monsters::MON_ENDGAME_MONSTERS) - 1 + monster_levels[MON_MAX_LEVELS];
 
@@ -101,7 +106,7 @@ void monsterPlaceWinning() {
         abort();
     }
 
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
 
     monster.pos.y = coord.y;
     monster.pos.x = coord.x;
@@ -114,11 +119,11 @@ void monsterPlaceWinning() {
     }
 
     // the creatures_list speed value is 10 greater, so that it can be a uint8_t
-    monster.speed = (int16_t)(creatures_list[creature_id].speed - 10 + py.flags.speed);
+    monster.speed = (int16_t)(creatures_list[creature_id].speed - 10 + session->py.flags.speed);
     monster.stunned_amount = 0;
-    monster.distance_from_player = (uint8_t) coordDistanceBetween(py.pos, coord);
+    monster.distance_from_player = (uint8_t) coordDistanceBetween(session->py.pos, coord);
 
-    dg.floor[coord.y][coord.x].creature_id = (uint8_t) monster_id;
+    session->dg.floor[coord.y][coord.x].creature_id = (uint8_t) monster_id;
 
     monster.sleep_count = 0;
 }
@@ -147,13 +152,19 @@ static int monsterGetOneSuitableForLevel(int level) {
         // all monsters of level less than or equal to the dungeon level.
         // This distribution makes a level n monster occur approx 2/n% of the
         // time on level n, and 1/n*n% are 1st level.
-        int num = monster_levels[level] - monster_levels[0];
-        int i = randomNumber(num) - 1;
-        int j = randomNumber(num) - 1;
-        if (j > i) {
-            i = j;
+        //
+        // It was the level of the highest of two random monsters, now this
+        // is drawn directly from the precomputed alias table for this depth.
+        MonsterLevelSampler_t const &sampler = monster_level_samplers[level];
+
+        int32_t draw = randomNumber(sampler.count * sampler.column_weight) - 1;
+        int column = draw / sampler.column_weight;
+
+        if (draw % sampler.column_weight < sampler.threshold[column]) {
+            level = column + 1;
+        } else {
+            level = sampler.alias[column] + 1;
         }
-        level = creatures_list[i + monster_levels[0]].level;
     }
 
     return randomNumber(monster_levels[level] - monster_levels[level - 1]) - 1 + monster_levels[level - 1];
@@ -164,15 +175,26 @@ void monsterPlaceNewWithinDistance(int number, int distance_from_source, bool sl
     Coord_t position = Coord_t{0, 0};
 
     for (int i = 0; i < number; i++) {
-        do {
-            position.y = randomNumber(dg.height - 2);
-            position.x = randomNumber(dg.width - 2);
-        } while (dg.floor[position.y][position.x].feature_id >= MIN_CLOSED_SPACE || //
-                 dg.floor[position.y][position.x].creature_id != 0 ||               //
-                 coordDistanceBetween(position, py.pos) <= distance_from_source     //
-        );
+        FloorTileSearch_t search = dungeonSearchFloorTiles(FloorTiles::Any);
+
+        bool found = false;
+
+        while (dungeonNextFloorTile(search, position)) {
+            if (session->dg.floor[position.y][position.x].feature_id < MIN_CLOSED_SPACE && //
+                session->dg.floor[position.y][position.x].creature_id == 0 &&              //
+                coordDistanceBetween(position, session->py.pos) > distance_from_source     //
+            ) {
+                found = true;
+                break;
+            }
+        }
+
+        // The level is full, there is nowhere left to put a monster
+        if (!found) {
+            return;
+        }
 
-        int l = monsterGetOneSuitableForLevel(dg.current_level);
+        int l = monsterGetOneSuitableForLevel(session->dg.current_level);
 
         // Dragons are always created sleeping here,
         // so as to give the player a sporting chance.
@@ -196,7 +218,7 @@ static bool placeMonsterAdjacentTo(int monster_id, Coord_t &coord, bool slp) {
         position.x = coord.x - 2 + randomNumber(3);
 
         if (coordInBounds(position)) {
-            if (dg.floor[position.y][position.x].feature_id <= MAX_OPEN_SPACE && dg.floor[position.y][position.x].creature_id == 0) {
+            if (session->dg.floor[position.y][position.x].feature_id <= MAX_OPEN_SPACE && session->dg.floor[position.y][position.x].creature_id == 0) {
                 // Place_monster() should always return true here.
                 if (!monsterPlaceNew(position, monster_id, slp)) {
                     return false;
@@ -216,7 +238,7 @@ static bool placeMonsterAdjacentTo(int monster_id, Coord_t &coord, bool slp) {
 
 // Places creature adjacent to given location -RAK-
 bool monsterSummon(Coord_t &coord, bool sleeping) {
-    int monster_id = monsterGetOneSuitableForLevel(dg.current_level + config::monsters::MON_SUMMONED_LEVEL_ADJUST);
+    int monster_id = monsterGetOneSuitableForLevel(session->dg.current_level + config::monsters::MON_SUMMONED_LEVEL_ADJUST);
     return placeMonsterAdjacentTo(monster_id, coord, sleeping);
 }
 
@@ -254,11 +276,11 @@ bool compactMonsters() {
     bool delete_any = false;
 
     while (!delete_any) {
-        for (int i = next_free_monster_id - 1; i >= config::monsters::MON_MIN_INDEX_ID; i--) {
-            if (cur_dis < monsters[i].distance_from_player && randomNumber(3) == 1) {
-                if ((creatures_list[monsters[i].creature_id].movement & config::monsters::move::CM_WIN) != 0u) {
+        for (int i = session->next_free_monster_id - 1; i >= config::monsters::MON_MIN_INDEX_ID; i--) {
+            if (cur_dis < session->monsters[i].distance_from_player && randomNumber(3) == 1) {
+                if ((creatures_list[session->monsters[i].creature_id].movement & config::monsters::move::CM_WIN) != 0u) {
                     // Never compact away the Balrog!!
-                } else if (hack_monptr < i) {
+                } else if (session->hack_monptr < i) {
                     // In case this is called from within updateMonsters().
                     // This is a horrible hack, the monsters/updateMonsters() code needs to be rewritten.
                     dungeonDeleteMonster(i);
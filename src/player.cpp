@@ -8,34 +8,33 @@
 #include "headers.h"
 
 // Player record for most player related info
-Player_t py = Player_t{};
 
 static void playerResetFlags() {
-    py.flags.see_invisible = false;
-    py.flags.teleport = false;
-    py.flags.free_action = false;
-    py.flags.slow_digest = false;
-    py.flags.aggravate = false;
-    py.flags.sustain_str = false;
-    py.flags.sustain_int = false;
-    py.flags.sustain_wis = false;
-    py.flags.sustain_con = false;
-    py.flags.sustain_dex = false;
-    py.flags.sustain_chr = false;
-    py.flags.resistant_to_fire = false;
-    py.flags.resistant_to_acid = false;
-    py.flags.resistant_to_cold = false;
-    py.flags.regenerate_hp = false;
-    py.flags.resistant_to_light = false;
-    py.flags.free_fall = false;
+    session->py.flags.see_invisible = false;
+    session->py.flags.teleport = false;
+    session->py.flags.free_action = false;
+    session->py.flags.slow_digest = false;
+    session->py.flags.aggravate = false;
+    session->py.flags.sustain_str = false;
+    session->py.flags.sustain_int = false;
+    session->py.flags.sustain_wis = false;
+    session->py.flags.sustain_con = false;
+    session->py.flags.sustain_dex = false;
+    session->py.flags.sustain_chr = false;
+    session->py.flags.resistant_to_fire = false;
+    session->py.flags.resistant_to_acid = false;
+    session->py.flags.resistant_to_cold = false;
+    session->py.flags.regenerate_hp = false;
+    session->py.flags.resistant_to_light = false;
+    session->py.flags.free_fall = false;
 }
 
 bool playerIsMale() {
-    return py.misc.gender;
+    return session->py.misc.gender;
 }
 
 void playerSetGender(bool is_male) {
-    py.misc.gender = is_male;
+    session->py.misc.gender = is_male;
 }
 
 const char *playerGetGenderLabel() {
@@ -94,7 +93,7 @@ bool playerMovePosition(int dir, Coord_t &coord) {
 
     bool can_move = false;
 
-    if (new_coord.y >= 0 && new_coord.y < dg.height && new_coord.x >= 0 && new_coord.x < dg.width) {
+    if (new_coord.y >= 0 && new_coord.y < session->dg.height && new_coord.x >= 0 && new_coord.x < session->dg.width) {
         coord = new_coord;
         can_move = true;
     }
@@ -107,57 +106,50 @@ void playerTeleport(int new_distance) {
     Coord_t location = Coord_t{0, 0};
 
     do {
-        location.y = randomNumber(dg.height) - 1;
-        location.x = randomNumber(dg.width) - 1;
+        location.y = randomNumber(session->dg.height) - 1;
+        location.x = randomNumber(session->dg.width) - 1;
 
-        while (coordDistanceBetween(location, py.pos) > new_distance) {
-            location.y += (py.pos.y - location.y) / 2;
-            location.x += (py.pos.x - location.x) / 2;
+        while (coordDistanceBetween(location, session->py.pos) > new_distance) {
+            location.y += (session->py.pos.y - location.y) / 2;
+            location.x += (session->py.pos.x - location.x) / 2;
         }
-    } while (dg.floor[location.y][location.x].feature_id >= MIN_CLOSED_SPACE || dg.floor[location.y][location.x].creature_id >= 2);
+    } while (session->dg.floor[location.y][location.x].feature_id >= MIN_CLOSED_SPACE || session->dg.floor[location.y][location.x].creature_id >= 2);
 
-    dungeonMoveCreatureRecord(py.pos, location);
+    dungeonMoveCreatureRecord(session->py.pos, location);
 
-    Coord_t spot = Coord_t{0, 0};
-    for (spot.y = py.pos.y - 1; spot.y <= py.pos.y + 1; spot.y++) {
-        for (spot.x = py.pos.x - 1; spot.x <= py.pos.x + 1; spot.x++) {
-            dg.floor[spot.y][spot.x].temporary_light = false;
-            dungeonLiteSpot(spot);
-        }
-    }
-
-    dungeonLiteSpot(py.pos);
+    dungeonLampLightOff(session->py.pos);
+    dungeonLiteSpot(session->py.pos);
 
-    py.pos.y = location.y;
-    py.pos.x = location.x;
+    session->py.pos.y = location.y;
+    session->py.pos.x = location.x;
 
     dungeonResetView();
     updateMonsters(false);
 
-    game.teleport_player = false;
+    session->game.teleport_player = false;
 }
 
 // Returns true if player has no light -RAK-
 bool playerNoLight() {
-    return !dg.floor[py.pos.y][py.pos.x].temporary_light && !dg.floor[py.pos.y][py.pos.x].permanent_light;
+    return !session->dg.floor[session->py.pos.y][session->py.pos.x].temporary_light && !session->dg.floor[session->py.pos.y][session->py.pos.x].permanent_light;
 }
 
 // Something happens to disturb the player. -CJS-
 // The first arg indicates a major disturbance, which affects search.
 // The second arg indicates a light change.
 void playerDisturb(int major_disturbance, int light_disturbance) {
-    game.command_count = 0;
+    session->game.command_count = 0;
 
-    if ((major_disturbance != 0) && ((py.flags.status & config::player::status::PY_SEARCH) != 0u)) {
+    if ((major_disturbance != 0) && ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u)) {
         playerSearchOff();
     }
 
-    if (py.flags.rest != 0) {
+    if (session->py.flags.rest != 0) {
         playerRestOff();
     }
 
-    if ((light_disturbance != 0) || (py.running_tracker != 0)) {
-        py.running_tracker = 0;
+    if ((light_disturbance != 0) || (session->py.running_tracker != 0)) {
+        session->py.running_tracker = 0;
         dungeonResetView();
     }
 
@@ -168,32 +160,32 @@ void playerDisturb(int major_disturbance, int light_disturbance) {
 void playerSearchOn() {
     playerChangeSpeed(1);
 
-    py.flags.status |= config::player::status::PY_SEARCH;
+    session->py.flags.status |= config::player::status::PY_SEARCH;
 
     printCharacterMovementState();
     printCharacterSpeed();
 
-    py.flags.food_digested++;
+    session->py.flags.food_digested++;
 }
 
 void playerSearchOff() {
     dungeonResetView();
     playerChangeSpeed(-1);
 
-    py.flags.status &= ~config::player::status::PY_SEARCH;
+    session->py.flags.status &= ~config::player::status::PY_SEARCH;
 
     printCharacterMovementState();
     printCharacterSpeed();
-    py.flags.food_digested--;
+    session->py.flags.food_digested--;
 }
 
 // Resting allows a player to safely restore his hp -RAK-
 void playerRestOn() {
     int rest_num;
 
-    if (game.command_count > 0) {
-        rest_num = game.command_count;
-        game.command_count = 0;
+    if (session->game.command_count > 0) {
+        rest_num = session->game.command_count;
+        session->game.command_count = 0;
     } else {
         rest_num = 0;
         vtype_t rest_str = {'\0'};
@@ -212,14 +204,14 @@ void playerRestOn() {
     // check for reasonable value, must be positive number
     // in range of a short, or must be -MAX_SHORT
     if (rest_num == -SHRT_MAX || (rest_num > 0 && rest_num <= SHRT_MAX)) {
-        if ((py.flags.status & config::player::status::PY_SEARCH) != 0u) {
+        if ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u) {
             playerSearchOff();
         }
 
-        py.flags.rest = (int16_t) rest_num;
-        py.flags.status |= config::player::status::PY_REST;
+        session->py.flags.rest = (int16_t) rest_num;
+        session->py.flags.status |= config::player::status::PY_REST;
         printCharacterMovementState();
-        py.flags.food_digested--;
+        session->py.flags.food_digested--;
 
         putStringClearToEOL("Press any key to stop resting...", Coord_t{0, 0});
         putQIO();
@@ -233,19 +225,19 @@ void playerRestOn() {
     }
     messageLineClear();
 
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 }
 
 void playerRestOff() {
-    py.flags.rest = 0;
-    py.flags.status &= ~config::player::status::PY_REST;
+    session->py.flags.rest = 0;
+    session->py.flags.status &= ~config::player::status::PY_REST;
 
     printCharacterMovementState();
 
     // flush last message, or delete "press any key" message
     printMessage(CNIL);
 
-    py.flags.food_digested++;
+    session->py.flags.food_digested++;
 }
 
 // For "DIED_FROM" string
@@ -259,78 +251,79 @@ void playerDiedFromString(vtype_t *description, const char *monster_name, uint32
     }
 }
 
-bool playerTestAttackHits(int attack_id, uint8_t level) {
+// Rolls whether a creature attack hits the player, without disturbing the player.
+bool playerRollAttackHits(int attack_id, uint8_t level) {
     bool success = false;
 
     switch (attack_id) {
         case 1: // Normal attack
-            if (playerTestBeingHit(60, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(60, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 2: // Lose Strength
-            if (playerTestBeingHit(-3, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(-3, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 3: // Confusion attack
         case 4: // Fear attack
         case 5: // Fire attack
-            if (playerTestBeingHit(10, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(10, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 6: // Acid attack
-            if (playerTestBeingHit(0, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(0, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 7: // Cold attack
         case 8: // Lightning attack
-            if (playerTestBeingHit(10, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(10, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 9: // Corrosion attack
-            if (playerTestBeingHit(0, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(0, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 10: // Blindness attack
         case 11: // Paralysis attack
-            if (playerTestBeingHit(2, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(2, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 12: // Steal Money
-            if (playerTestBeingHit(5, (int) level, 0, (int) py.misc.level, CLASS_MISC_HIT) && py.misc.au > 0) {
+            if (playerRollToHit(5, (int) level, 0, (int) session->py.misc.level, CLASS_MISC_HIT) && session->py.misc.au > 0) {
                 success = true;
             }
             break;
         case 13: // Steal Object
-            if (playerTestBeingHit(2, (int) level, 0, (int) py.misc.level, CLASS_MISC_HIT) && py.pack.unique_items > 0) {
+            if (playerRollToHit(2, (int) level, 0, (int) session->py.misc.level, CLASS_MISC_HIT) && session->py.pack.unique_items > 0) {
                 success = true;
             }
             break;
         case 14: // Poison
-            if (playerTestBeingHit(5, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(5, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 15: // Lose dexterity
         case 16: // Lose constitution
-            if (playerTestBeingHit(0, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(0, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 17: // Lose intelligence
         case 18: // Lose wisdom
-            if (playerTestBeingHit(2, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(2, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 19: // Lose experience
-            if (playerTestBeingHit(5, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(5, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
@@ -338,19 +331,19 @@ bool playerTestAttackHits(int attack_id, uint8_t level) {
             success = true;
             break;
         case 21: // Disenchant
-            if (playerTestBeingHit(20, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(20, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 22: // Eat food
         case 23: // Eat light
-            if (playerTestBeingHit(5, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+            if (playerRollToHit(5, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
                 success = true;
             }
             break;
         case 24: // Eat charges
             // check to make sure an object exists
-            if (playerTestBeingHit(15, (int) level, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT) && py.pack.unique_items > 0) {
+            if (playerRollToHit(15, (int) level, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT) && session->py.pack.unique_items > 0) {
                 success = true;
             }
             break;
@@ -364,15 +357,24 @@ bool playerTestAttackHits(int attack_id, uint8_t level) {
     return success;
 }
 
+bool playerTestAttackHits(int attack_id, uint8_t level) {
+    // Every attack which has to roll to hit disturbs the player, hit or miss.
+    if (attack_id >= 1 && attack_id <= 24 && attack_id != 20) {
+        playerDisturb(1, 0);
+    }
+
+    return playerRollAttackHits(attack_id, level);
+}
+
 // Changes speed of monsters relative to player -RAK-
 // Note: When the player is sped up or slowed down, I simply change
 // the speed of all the monsters. This greatly simplified the logic.
 void playerChangeSpeed(int speed) {
-    py.flags.speed += speed;
-    py.flags.status |= config::player::status::PY_SPEED;
+    session->py.flags.speed += speed;
+    session->py.flags.status |= config::player::status::PY_SPEED;
 
-    for (int i = next_free_monster_id - 1; i >= config::monsters::MON_MIN_INDEX_ID; i--) {
-        monsters[i].speed += speed;
+    for (int i = session->next_free_monster_id - 1; i >= config::monsters::MON_MIN_INDEX_ID; i--) {
+        session->monsters[i].speed += speed;
     }
 }
 
@@ -396,12 +398,12 @@ void playerAdjustBonusesForItem(Inventory_t const &item, int factor) {
     }
 
     if ((item.flags & config::treasure::flags::TR_SEARCH) != 0u) {
-        py.misc.chance_in_search += amount;
-        py.misc.fos -= amount;
+        session->py.misc.chance_in_search += amount;
+        session->py.misc.fos -= amount;
     }
 
     if ((item.flags & config::treasure::flags::TR_STEALTH) != 0u) {
-        py.misc.stealth_factor += amount;
+        session->py.misc.stealth_factor += amount;
     }
 
     if ((item.flags & config::treasure::flags::TR_SPEED) != 0u) {
@@ -409,47 +411,47 @@ void playerAdjustBonusesForItem(Inventory_t const &item, int factor) {
     }
 
     if (((item.flags & config::treasure::flags::TR_BLIND) != 0u) && factor > 0) {
-        py.flags.blind += 1000;
+        session->py.flags.blind += 1000;
     }
 
     if (((item.flags & config::treasure::flags::TR_TIMID) != 0u) && factor > 0) {
-        py.flags.afraid += 50;
+        session->py.flags.afraid += 50;
     }
 
     if ((item.flags & config::treasure::flags::TR_INFRA) != 0u) {
-        py.flags.see_infra += amount;
+        session->py.flags.see_infra += amount;
     }
 }
 
 static void playerRecalculateBonusesFromInventory() {
     for (int i = PlayerEquipment::Wield; i < PlayerEquipment::Light; i++) {
-        Inventory_t const &item = py.inventory[i];
+        Inventory_t const &item = session->py.inventory[i];
 
         if (item.category_id != TV_NOTHING) {
-            py.misc.plusses_to_hit += item.to_hit;
+            session->py.misc.plusses_to_hit += item.to_hit;
 
             // Bows can't damage. -CJS-
             if (item.category_id != TV_BOW) {
-                py.misc.plusses_to_damage += item.to_damage;
+                session->py.misc.plusses_to_damage += item.to_damage;
             }
 
-            py.misc.magical_ac += item.to_ac;
-            py.misc.ac += item.ac;
+            session->py.misc.magical_ac += item.to_ac;
+            session->py.misc.ac += item.ac;
 
             if (spellItemIdentified(item)) {
-                py.misc.display_to_hit += item.to_hit;
+                session->py.misc.display_to_hit += item.to_hit;
 
                 // Bows can't damage. -CJS-
                 if (item.category_id != TV_BOW) {
-                    py.misc.display_to_damage += item.to_damage;
+                    session->py.misc.display_to_damage += item.to_damage;
                 }
 
-                py.misc.display_to_ac += item.to_ac;
-                py.misc.display_ac += item.ac;
+                session->py.misc.display_to_ac += item.to_ac;
+                session->py.misc.display_ac += item.ac;
             } else if (!inventoryItemIsCursed(item)) {
                 // Base AC values should always be visible,
                 // as long as the item is not cursed.
-                py.misc.display_ac += item.ac;
+                session->py.misc.display_ac += item.ac;
             }
         }
     }
@@ -457,28 +459,28 @@ static void playerRecalculateBonusesFromInventory() {
 
 static void playerRecalculateSustainStatsFromInventory() {
     for (int i = PlayerEquipment::Wield; i < PlayerEquipment::Light; i++) {
-        if ((py.inventory[i].flags & config::treasure::flags::TR_SUST_STAT) == 0u) {
+        if ((session->py.inventory[i].flags & config::treasure::flags::TR_SUST_STAT) == 0u) {
             continue;
         }
 
-        switch (py.inventory[i].misc_use) {
+        switch (session->py.inventory[i].misc_use) {
             case 1:
-                py.flags.sustain_str = true;
+                session->py.flags.sustain_str = true;
                 break;
             case 2:
-                py.flags.sustain_int = true;
+                session->py.flags.sustain_int = true;
                 break;
             case 3:
-                py.flags.sustain_wis = true;
+                session->py.flags.sustain_wis = true;
                 break;
             case 4:
-                py.flags.sustain_con = true;
+                session->py.flags.sustain_con = true;
                 break;
             case 5:
-                py.flags.sustain_dex = true;
+                session->py.flags.sustain_dex = true;
                 break;
             case 6:
-                py.flags.sustain_chr = true;
+                session->py.flags.sustain_chr = true;
                 break;
             default:
                 break;
@@ -489,112 +491,112 @@ static void playerRecalculateSustainStatsFromInventory() {
 // Recalculate the effect of all the stuff we use. -CJS-
 void playerRecalculateBonuses() {
     // Temporarily adjust food_digested
-    if (py.flags.slow_digest) {
-        py.flags.food_digested++;
+    if (session->py.flags.slow_digest) {
+        session->py.flags.food_digested++;
     }
-    if (py.flags.regenerate_hp) {
-        py.flags.food_digested -= 3;
+    if (session->py.flags.regenerate_hp) {
+        session->py.flags.food_digested -= 3;
     }
 
-    int saved_display_ac = py.misc.display_ac;
+    int saved_display_ac = session->py.misc.display_ac;
 
     playerResetFlags();
 
     // Real values
-    py.misc.plusses_to_hit = playerToHitAdjustment();
-    py.misc.plusses_to_damage = playerDamageAdjustment();
-    py.misc.magical_ac = playerArmorClassAdjustment();
-    py.misc.ac = 0;
+    session->py.misc.plusses_to_hit = playerToHitAdjustment();
+    session->py.misc.plusses_to_damage = playerDamageAdjustment();
+    session->py.misc.magical_ac = playerArmorClassAdjustment();
+    session->py.misc.ac = 0;
 
     // Display values
-    py.misc.display_to_hit = py.misc.plusses_to_hit;
-    py.misc.display_to_damage = py.misc.plusses_to_damage;
-    py.misc.display_ac = 0;
-    py.misc.display_to_ac = py.misc.magical_ac;
+    session->py.misc.display_to_hit = session->py.misc.plusses_to_hit;
+    session->py.misc.display_to_damage = session->py.misc.plusses_to_damage;
+    session->py.misc.display_ac = 0;
+    session->py.misc.display_to_ac = session->py.misc.magical_ac;
 
     playerRecalculateBonusesFromInventory();
 
-    py.misc.display_ac += py.misc.display_to_ac;
+    session->py.misc.display_ac += session->py.misc.display_to_ac;
 
-    if (py.weapon_is_heavy) {
-        py.misc.display_to_hit += (py.stats.used[PlayerAttr::A_STR] * 15 - py.inventory[PlayerEquipment::Wield].weight);
+    if (session->py.weapon_is_heavy) {
+        session->py.misc.display_to_hit += (session->py.stats.used[PlayerAttr::A_STR] * 15 - session->py.inventory[PlayerEquipment::Wield].weight);
     }
 
     // Add in temporary spell increases
-    if (py.flags.invulnerability > 0) {
-        py.misc.ac += 100;
-        py.misc.display_ac += 100;
+    if (session->py.flags.invulnerability > 0) {
+        session->py.misc.ac += 100;
+        session->py.misc.display_ac += 100;
     }
 
-    if (py.flags.blessed > 0) {
-        py.misc.ac += 2;
-        py.misc.display_ac += 2;
+    if (session->py.flags.blessed > 0) {
+        session->py.misc.ac += 2;
+        session->py.misc.display_ac += 2;
     }
 
-    if (py.flags.detect_invisible > 0) {
-        py.flags.see_invisible = true;
+    if (session->py.flags.detect_invisible > 0) {
+        session->py.flags.see_invisible = true;
     }
 
     // can't print AC here because might be in a store
-    if (saved_display_ac != py.misc.display_ac) {
-        py.flags.status |= config::player::status::PY_ARMOR;
+    if (saved_display_ac != session->py.misc.display_ac) {
+        session->py.flags.status |= config::player::status::PY_ARMOR;
     }
 
     uint32_t item_flags = inventoryCollectAllItemFlags();
 
     if ((item_flags & config::treasure::flags::TR_SLOW_DIGEST) != 0u) {
-        py.flags.slow_digest = true;
+        session->py.flags.slow_digest = true;
     }
     if ((item_flags & config::treasure::flags::TR_AGGRAVATE) != 0u) {
-        py.flags.aggravate = true;
+        session->py.flags.aggravate = true;
     }
     if ((item_flags & config::treasure::flags::TR_TELEPORT) != 0u) {
-        py.flags.teleport = true;
+        session->py.flags.teleport = true;
     }
     if ((item_flags & config::treasure::flags::TR_REGEN) != 0u) {
-        py.flags.regenerate_hp = true;
+        session->py.flags.regenerate_hp = true;
     }
     if ((item_flags & config::treasure::flags::TR_RES_FIRE) != 0u) {
-        py.flags.resistant_to_fire = true;
+        session->py.flags.resistant_to_fire = true;
     }
     if ((item_flags & config::treasure::flags::TR_RES_ACID) != 0u) {
-        py.flags.resistant_to_acid = true;
+        session->py.flags.resistant_to_acid = true;
     }
     if ((item_flags & config::treasure::flags::TR_RES_COLD) != 0u) {
-        py.flags.resistant_to_cold = true;
+        session->py.flags.resistant_to_cold = true;
     }
     if ((item_flags & config::treasure::flags::TR_FREE_ACT) != 0u) {
-        py.flags.free_action = true;
+        session->py.flags.free_action = true;
     }
     if ((item_flags & config::treasure::flags::TR_SEE_INVIS) != 0u) {
-        py.flags.see_invisible = true;
+        session->py.flags.see_invisible = true;
     }
     if ((item_flags & config::treasure::flags::TR_RES_LIGHT) != 0u) {
-        py.flags.resistant_to_light = true;
+        session->py.flags.resistant_to_light = true;
     }
     if ((item_flags & config::treasure::flags::TR_FFALL) != 0u) {
-        py.flags.free_fall = true;
+        session->py.flags.free_fall = true;
     }
 
     playerRecalculateSustainStatsFromInventory();
 
     // Reset food_digested values
-    if (py.flags.slow_digest) {
-        py.flags.food_digested--;
+    if (session->py.flags.slow_digest) {
+        session->py.flags.food_digested--;
     }
-    if (py.flags.regenerate_hp) {
-        py.flags.food_digested += 3;
+    if (session->py.flags.regenerate_hp) {
+        session->py.flags.food_digested += 3;
     }
 }
 
 // Remove item from equipment list -RAK-
 void playerTakeOff(int item_id, int pack_position_id) {
-    py.flags.status |= config::player::status::PY_STR_WGT;
+    session->py.flags.status |= config::player::status::PY_STR_WGT;
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
-    py.pack.weight -= item.weight * item.items_count;
-    py.equipment_count--;
+    session->py.pack.weight -= item.weight * item.items_count;
+    session->py.equipment_count--;
 
     const char *p = nullptr;
     if (item_id == PlayerEquipment::Wield || item_id == PlayerEquipment::Auxiliary) {
@@ -628,8 +630,13 @@ void playerTakeOff(int item_id, int pack_position_id) {
 bool playerTestBeingHit(int base_to_hit, int level, int plus_to_hit, int armor_class, int attack_type_id) {
     playerDisturb(1, 0);
 
+    return playerRollToHit(base_to_hit, level, plus_to_hit, armor_class, attack_type_id);
+}
+
+// The to-hit roll of playerTestBeingHit(), free of any side effects.
+bool playerRollToHit(int base_to_hit, int level, int plus_to_hit, int armor_class, int attack_type_id) {
     // `plus_to_hit` could be less than 0 if player wielding weapon too heavy for them
-    int hit_chance = base_to_hit + plus_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + (level * class_level_adj[py.misc.class_id][attack_type_id]);
+    int hit_chance = base_to_hit + plus_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + (level * class_level_adj[session->py.misc.class_id][attack_type_id]);
 
     // always miss 1 out of 20, always hit 1 out of 20
     int die = randomNumber(20);
@@ -640,38 +647,38 @@ bool playerTestBeingHit(int base_to_hit, int level, int plus_to_hit, int armor_c
 
 // Decreases players hit points and sets game.character_is_dead flag if necessary -RAK-
 void playerTakesHit(int damage, const char *creature_name_label) {
-    if (py.flags.invulnerability > 0) {
+    if (session->py.flags.invulnerability > 0) {
         damage = 0;
     }
-    py.misc.current_hp -= damage;
+    session->py.misc.current_hp -= damage;
 
-    if (py.misc.current_hp >= 0) {
+    if (session->py.misc.current_hp >= 0) {
         printCharacterCurrentHitPoints();
         return;
     }
 
-    if (!game.character_is_dead) {
-        game.character_is_dead = true;
+    if (!session->game.character_is_dead) {
+        session->game.character_is_dead = true;
 
-        (void) strcpy(game.character_died_from, creature_name_label);
+        (void) strcpy(session->game.character_died_from, creature_name_label);
 
-        game.total_winner = false;
+        session->game.total_winner = false;
     }
 
-    dg.generate_new_level = true;
+    session->dg.generate_new_level = true;
 }
 
 // Searches for hidden things. -RAK-
 void playerSearch(Coord_t coord, int chance) {
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         chance = chance / 10;
     }
 
-    if (py.flags.blind > 0 || playerNoLight()) {
+    if (session->py.flags.blind > 0 || playerNoLight()) {
         chance = chance / 10;
     }
 
-    if (py.flags.image > 0) {
+    if (session->py.flags.image > 0) {
         chance = chance / 10;
     }
 
@@ -683,13 +690,13 @@ void playerSearch(Coord_t coord, int chance) {
                 continue;
             }
 
-            if (dg.floor[spot.y][spot.x].treasure_id == 0) {
+            if (session->dg.floor[spot.y][spot.x].treasure_id == 0) {
                 continue;
             }
 
             // Search for hidden objects
 
-            Inventory_t &item = game.treasure.list[dg.floor[spot.y][spot.x].treasure_id];
+            Inventory_t &item = session->game.treasure.list[session->dg.floor[spot.y][spot.x].treasure_id];
 
             if (item.category_id == TV_INVIS_TRAP) {
                 // Trap on floor?
@@ -729,7 +736,7 @@ void playerSearch(Coord_t coord, int chance) {
 
 // Computes current weight limit -RAK-
 int playerCarryingLoadLimit() {
-    int weight_cap = py.stats.used[PlayerAttr::A_STR] * config::player::PLAYER_WEIGHT_CAP + py.misc.weight;
+    int weight_cap = session->py.stats.used[PlayerAttr::A_STR] * config::player::PLAYER_WEIGHT_CAP + session->py.misc.weight;
 
     if (weight_cap > 3000) {
         weight_cap = 3000;
@@ -740,16 +747,16 @@ int playerCarryingLoadLimit() {
 
 // Are we strong enough for the current pack and weapon? -CJS-
 void playerStrength() {
-    Inventory_t const &item = py.inventory[PlayerEquipment::Wield];
+    Inventory_t const &item = session->py.inventory[PlayerEquipment::Wield];
 
-    if (item.category_id != TV_NOTHING && py.stats.used[PlayerAttr::A_STR] * 15 < item.weight) {
-        if (!py.weapon_is_heavy) {
+    if (item.category_id != TV_NOTHING && session->py.stats.used[PlayerAttr::A_STR] * 15 < item.weight) {
+        if (!session->py.weapon_is_heavy) {
             printMessage("You have trouble wielding such a heavy weapon.");
-            py.weapon_is_heavy = true;
+            session->py.weapon_is_heavy = true;
             playerRecalculateBonuses();
         }
-    } else if (py.weapon_is_heavy) {
-        py.weapon_is_heavy = false;
+    } else if (session->py.weapon_is_heavy) {
+        session->py.weapon_is_heavy = false;
         if (item.category_id != TV_NOTHING) {
             printMessage("You are strong enough to wield your weapon.");
         }
@@ -758,50 +765,50 @@ void playerStrength() {
 
     int limit = playerCarryingLoadLimit();
 
-    if (limit < py.pack.weight) {
-        limit = py.pack.weight / (limit + 1);
+    if (limit < session->py.pack.weight) {
+        limit = session->py.pack.weight / (limit + 1);
     } else {
         limit = 0;
     }
 
-    if (py.pack.heaviness != limit) {
-        if (py.pack.heaviness < limit) {
+    if (session->py.pack.heaviness != limit) {
+        if (session->py.pack.heaviness < limit) {
             printMessage("Your pack is so heavy that it slows you down.");
         } else {
             printMessage("You move more easily under the weight of your pack.");
         }
-        playerChangeSpeed(limit - py.pack.heaviness);
-        py.pack.heaviness = (int16_t) limit;
+        playerChangeSpeed(limit - session->py.pack.heaviness);
+        session->py.pack.heaviness = (int16_t) limit;
     }
 
-    py.flags.status &= ~config::player::status::PY_STR_WGT;
+    session->py.flags.status &= ~config::player::status::PY_STR_WGT;
 }
 
 bool playerLeftHandRingEmpty() {
-    return py.inventory[PlayerEquipment::Left].category_id == TV_NOTHING;
+    return session->py.inventory[PlayerEquipment::Left].category_id == TV_NOTHING;
 }
 
 bool playerRightHandRingEmpty() {
-    return py.inventory[PlayerEquipment::Right].category_id == TV_NOTHING;
+    return session->py.inventory[PlayerEquipment::Right].category_id == TV_NOTHING;
 }
 
 bool playerIsWieldingItem() {
-    if (py.inventory[PlayerEquipment::Wield].category_id == TV_NOTHING && py.inventory[PlayerEquipment::Auxiliary].category_id == TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Wield].category_id == TV_NOTHING && session->py.inventory[PlayerEquipment::Auxiliary].category_id == TV_NOTHING) {
         return false;
     }
     return true;
 }
 
 bool playerWornItemIsCursed(PlayerEquipment id) {
-    return inventoryItemIsCursed(py.inventory[id]);
+    return inventoryItemIsCursed(session->py.inventory[id]);
 }
 
 void playerWornItemRemoveCurse(PlayerEquipment id) {
-    inventoryItemRemoveCurse(py.inventory[id]);
+    inventoryItemRemoveCurse(session->py.inventory[id]);
 }
 
 static bool playerCanRead() {
-    if (py.flags.blind > 0) {
+    if (session->py.flags.blind > 0) {
         printMessage("You can't see to read your spell book!");
         return false;
     }
@@ -816,7 +823,7 @@ static bool playerCanRead() {
 
 static int lastKnownSpell() {
     for (int last_known = 0; last_known < 32; last_known++) {
-        if (py.flags.spells_learned_order[last_known] == 99) {
+        if (session->py.flags.spells_learned_order[last_known] == 99) {
             return last_known;
         }
     }
@@ -828,9 +835,9 @@ static int lastKnownSpell() {
 static uint32_t playerDetermineLearnableSpells() {
     uint32_t spell_flag = 0;
 
-    for (int i = 0; i < py.pack.unique_items; i++) {
-        if (py.inventory[i].category_id == TV_MAGIC_BOOK) {
-            spell_flag |= py.inventory[i].flags;
+    for (int i = 0; i < session->py.pack.unique_items; i++) {
+        if (session->py.inventory[i].category_id == TV_MAGIC_BOOK) {
+            spell_flag |= session->py.inventory[i].flags;
         }
     }
 
@@ -839,22 +846,22 @@ static uint32_t playerDetermineLearnableSpells() {
 
 // gain spells when player wants to -JW-
 void playerGainSpells() {
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are too confused.");
         return;
     }
 
-    int new_spells = py.flags.new_spells_to_learn;
+    int new_spells = session->py.flags.new_spells_to_learn;
     int diff_spells = 0;
 
     // TODO(cook) move access to `magic_spells[]` directly to the for loop it's used in, below?
-    Spell_t *spells = &magic_spells[py.misc.class_id - 1][0];
+    Spell_t *spells = &magic_spells[session->py.misc.class_id - 1][0];
 
     int stat, offset;
 
     // Priests don't need light because they get spells from their god, so only
     // fail when can't see if player has SPELL_TYPE_MAGE spells. This check is done below.
-    if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+    if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
         // People with SPELL_TYPE_MAGE spells can't learn spell_bank if they can't read their books.
         if (!playerCanRead()) {
             return;
@@ -873,7 +880,7 @@ void playerGainSpells() {
         (void) sprintf(tmp_str, "You can't learn any new %ss!", (stat == PlayerAttr::A_INT ? "spell" : "prayer"));
         printMessage(tmp_str);
 
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
         return;
     }
 
@@ -888,7 +895,7 @@ void playerGainSpells() {
     }
 
     // clear bits for spells already learned
-    spell_flag &= ~py.flags.spells_learnt;
+    spell_flag &= ~session->py.flags.spells_learnt;
 
     int spell_id = 0;
     int spell_bank[31];
@@ -897,7 +904,7 @@ void playerGainSpells() {
     for (int i = 0; spell_flag != 0u; mask <<= 1, i++) {
         if ((spell_flag & mask) != 0u) {
             spell_flag &= ~mask;
-            if (spells[i].level_required <= py.misc.level) {
+            if (spells[i].level_required <= session->py.misc.level) {
                 spell_bank[spell_id] = i;
                 spell_id++;
             }
@@ -927,8 +934,8 @@ void playerGainSpells() {
             if (c >= 0 && c < spell_id && c < 22) {
                 new_spells--;
 
-                py.flags.spells_learnt |= 1L << spell_bank[c];
-                py.flags.spells_learned_order[last_known] = (uint8_t) spell_bank[c];
+                session->py.flags.spells_learnt |= 1L << spell_bank[c];
+                session->py.flags.spells_learned_order[last_known] = (uint8_t) spell_bank[c];
                 last_known++;
 
                 for (; c <= spell_id - 1; c++) {
@@ -949,8 +956,8 @@ void playerGainSpells() {
         // pick a prayer at random
         while (new_spells != 0) {
             int id = randomNumber(spell_id) - 1;
-            py.flags.spells_learnt |= 1L << spell_bank[id];
-            py.flags.spells_learned_order[last_known] = (uint8_t) spell_bank[id];
+            session->py.flags.spells_learnt |= 1L << spell_bank[id];
+            session->py.flags.spells_learned_order[last_known] = (uint8_t) spell_bank[id];
             last_known++;
 
             vtype_t tmp_str = {'\0'};
@@ -966,20 +973,20 @@ void playerGainSpells() {
         }
     }
 
-    py.flags.new_spells_to_learn = (uint8_t)(new_spells + diff_spells);
+    session->py.flags.new_spells_to_learn = (uint8_t)(new_spells + diff_spells);
 
-    if (py.flags.new_spells_to_learn == 0) {
-        py.flags.status |= config::player::status::PY_STUDY;
+    if (session->py.flags.new_spells_to_learn == 0) {
+        session->py.flags.status |= config::player::status::PY_STUDY;
     }
 
     // set the mana for first level characters when they learn their first spell.
-    if (py.misc.mana == 0) {
+    if (session->py.misc.mana == 0) {
         playerGainMana(stat);
     }
 }
 
 static int newMana(int stat) {
-    int levels = py.misc.level - classes[py.misc.class_id].min_level_for_spell_casting + 1;
+    int levels = session->py.misc.level - classes[session->py.misc.class_id].min_level_for_spell_casting + 1;
 
     switch (playerStatAdjustmentWisdomIntelligence(stat)) {
         case 1:
@@ -1002,7 +1009,7 @@ static int newMana(int stat) {
 
 // Gain some mana if you know at least one spell -RAK-
 void playerGainMana(int stat) {
-    if (py.flags.spells_learnt != 0) {
+    if (session->py.flags.spells_learnt != 0) {
         int new_mana = newMana(stat);
 
         // increment mana by one, so that first level chars have 2 mana
@@ -1011,64 +1018,95 @@ void playerGainMana(int stat) {
         }
 
         // mana can be zero when creating character
-        if (py.misc.mana != new_mana) {
-            if (py.misc.mana != 0) {
+        if (session->py.misc.mana != new_mana) {
+            if (session->py.misc.mana != 0) {
                 // change current mana proportionately to change of max mana,
                 // divide first to avoid overflow, little loss of accuracy
-                int32_t value = (((int32_t) py.misc.current_mana << 16) + py.misc.current_mana_fraction) / py.misc.mana * new_mana;
-                py.misc.current_mana = (int16_t)(value >> 16);
-                py.misc.current_mana_fraction = (uint16_t)(value & 0xFFFF);
+                int32_t value = (((int32_t) session->py.misc.current_mana << 16) + session->py.misc.current_mana_fraction) / session->py.misc.mana * new_mana;
+                session->py.misc.current_mana = (int16_t)(value >> 16);
+                session->py.misc.current_mana_fraction = (uint16_t)(value & 0xFFFF);
             } else {
-                py.misc.current_mana = (int16_t) new_mana;
-                py.misc.current_mana_fraction = 0;
+                session->py.misc.current_mana = (int16_t) new_mana;
+                session->py.misc.current_mana_fraction = 0;
             }
 
-            py.misc.mana = (int16_t) new_mana;
+            session->py.misc.mana = (int16_t) new_mana;
 
             // can't print mana here, may be in store or inventory mode
-            py.flags.status |= config::player::status::PY_MANA;
+            session->py.flags.status |= config::player::status::PY_MANA;
         }
-    } else if (py.misc.mana != 0) {
-        py.misc.mana = 0;
-        py.misc.current_mana = 0;
+    } else if (session->py.misc.mana != 0) {
+        session->py.misc.mana = 0;
+        session->py.misc.current_mana = 0;
 
         // can't print mana here, may be in store or inventory mode
-        py.flags.status |= config::player::status::PY_MANA;
+        session->py.flags.status |= config::player::status::PY_MANA;
     }
 }
 
-// Critical hits, Nasty way to die. -RAK-
-int playerWeaponCriticalBlow(int weapon_weight, int plus_to_hit, int damage, int attack_type_id) {
-    int critical = damage;
-
+// Critical hit severity, from 0 (no critical) to 4 (*GREAT* hit) -RAK-
+int playerWeaponCriticalSeverity(int weapon_weight, int plus_to_hit, int attack_type_id) {
     // Weight of weapon, plusses to hit, and character level all
     // contribute to the chance of a critical
-    if (randomNumber(5000) <= weapon_weight + 5 * plus_to_hit + (class_level_adj[py.misc.class_id][attack_type_id] * py.misc.level)) {
-        weapon_weight += randomNumber(650);
+    if (randomNumber(5000) > weapon_weight + 5 * plus_to_hit + (class_level_adj[session->py.misc.class_id][attack_type_id] * session->py.misc.level)) {
+        return 0;
+    }
+
+    weapon_weight += randomNumber(650);
+
+    if (weapon_weight < 400) {
+        return 1;
+    }
+    if (weapon_weight < 700) {
+        return 2;
+    }
+    if (weapon_weight < 900) {
+        return 3;
+    }
+    return 4;
+}
 
-        if (weapon_weight < 400) {
-            critical = 2 * damage + 5;
+// Damage after applying a critical hit of the given severity
+int playerWeaponCriticalDamage(int damage, int severity) {
+    if (severity == 0) {
+        return damage;
+    }
+
+    return (severity + 1) * damage + 5 * severity;
+}
+
+void playerPrintCriticalBlowMessage(int severity) {
+    switch (severity) {
+        case 1:
             printMessage("It was a good hit! (x2 damage)");
-        } else if (weapon_weight < 700) {
-            critical = 3 * damage + 10;
+            break;
+        case 2:
             printMessage("It was an excellent hit! (x3 damage)");
-        } else if (weapon_weight < 900) {
-            critical = 4 * damage + 15;
+            break;
+        case 3:
             printMessage("It was a superb hit! (x4 damage)");
-        } else {
-            critical = 5 * damage + 20;
+            break;
+        case 4:
             printMessage("It was a *GREAT* hit! (x5 damage)");
-        }
+            break;
+        default:
+            break;
     }
+}
+
+// Critical hits, Nasty way to die. -RAK-
+int playerWeaponCriticalBlow(int weapon_weight, int plus_to_hit, int damage, int attack_type_id) {
+    int severity = playerWeaponCriticalSeverity(weapon_weight, plus_to_hit, attack_type_id);
+    playerPrintCriticalBlowMessage(severity);
 
-    return critical;
+    return playerWeaponCriticalDamage(damage, severity);
 }
 
 // Saving throws for player character. -RAK-
 bool playerSavingThrow() {
-    int class_level_adjustment = class_level_adj[py.misc.class_id][PlayerClassLevelAdj::SAVE] * py.misc.level / 3;
+    int class_level_adjustment = class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::SAVE] * session->py.misc.level / 3;
 
-    int saving = py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_WIS) + class_level_adjustment;
+    int saving = session->py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_WIS) + class_level_adjustment;
 
     return randomNumber(100) <= saving;
 }
@@ -1076,24 +1114,24 @@ bool playerSavingThrow() {
 void playerGainKillExperience(Creature_t const &creature) {
     int32_t exp = creature.kill_exp_value * creature.level;
 
-    int32_t quotient = exp / py.misc.level;
-    int32_t remainder = exp % py.misc.level;
+    int32_t quotient = exp / session->py.misc.level;
+    int32_t remainder = exp % session->py.misc.level;
 
     remainder *= 0x10000L;
-    remainder /= py.misc.level;
-    remainder += py.misc.exp_fraction;
+    remainder /= session->py.misc.level;
+    remainder += session->py.misc.exp_fraction;
 
     if (remainder >= 0x10000L) {
         quotient++;
-        py.misc.exp_fraction = (uint16_t)(remainder - 0x10000L);
+        session->py.misc.exp_fraction = (uint16_t)(remainder - 0x10000L);
     } else {
-        py.misc.exp_fraction = (uint16_t) remainder;
+        session->py.misc.exp_fraction = (uint16_t) remainder;
     }
 
-    py.misc.exp += quotient;
+    session->py.misc.exp += quotient;
 }
 
-static void playerCalculateToHitBlows(int weapon_id, int weapon_weight, int &blows, int &total_to_hit) {
+void playerCalculateToHitBlows(int weapon_id, int weapon_weight, int &blows, int &total_to_hit) {
     if (weapon_id != TV_NOTHING) {
         // Proper weapon
         blows = playerAttackBlows(weapon_weight, total_to_hit);
@@ -1108,31 +1146,57 @@ static void playerCalculateToHitBlows(int weapon_id, int weapon_weight, int &blo
         blows = 1;
     }
 
-    total_to_hit += py.misc.plusses_to_hit;
+    total_to_hit += session->py.misc.plusses_to_hit;
 }
 
 static int playerCalculateBaseToHit(bool creature_lit, int tot_tohit) {
     if (creature_lit) {
-        return py.misc.bth;
+        return session->py.misc.bth;
     }
 
     // creature not lit, make it more difficult to hit
     int bth;
 
-    bth = py.misc.bth / 2;
+    bth = session->py.misc.bth / 2;
     bth -= tot_tohit * (BTH_PER_PLUS_TO_HIT_ADJUST - 1);
-    bth -= py.misc.level * class_level_adj[py.misc.class_id][PlayerClassLevelAdj::BTH] / 2;
+    bth -= session->py.misc.level * class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::BTH] / 2;
 
     return bth;
 }
 
+// Damage of a single melee blow which has hit the creature. The critical
+// hit severity and any slay/brand defense used are returned to the caller,
+// so this has no message or monster recall side effects.
+int playerMeleeBlowDamage(Inventory_t const &item, int total_to_hit, Creature_t const &creature, int &critical_severity, uint16_t &slay_defense) {
+    int damage;
+
+    if (item.category_id != TV_NOTHING) {
+        damage = diceRoll(item.damage);
+        damage = itemMagicAbilityDamageAgainst(item, damage, creature, slay_defense);
+        critical_severity = playerWeaponCriticalSeverity((int) item.weight, total_to_hit, PlayerClassLevelAdj::BTH);
+    } else {
+        // Bare hands!?
+        damage = diceRoll(Dice_t{1, 1});
+        critical_severity = playerWeaponCriticalSeverity(1, 0, PlayerClassLevelAdj::BTH);
+    }
+
+    damage = playerWeaponCriticalDamage(damage, critical_severity);
+
+    damage += session->py.misc.plusses_to_damage;
+    if (damage < 0) {
+        damage = 0;
+    }
+
+    return damage;
+}
+
 // Player attacks a (poor, defenseless) creature -RAK-
 static void playerAttackMonster(Coord_t coord) {
-    int creature_id = dg.floor[coord.y][coord.x].creature_id;
+    int creature_id = session->dg.floor[coord.y][coord.x].creature_id;
 
-    Monster_t &monster = monsters[creature_id];
+    Monster_t &monster = session->monsters[creature_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
-    Inventory_t &item = py.inventory[PlayerEquipment::Wield];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Wield];
 
     monster.sleep_count = 0;
 
@@ -1150,12 +1214,16 @@ static void playerAttackMonster(Coord_t coord) {
     int base_to_hit = playerCalculateBaseToHit(monster.lit, total_to_hit);
 
     int damage;
+    int critical_severity;
     vtype_t msg = {'\0'};
 
+    // Each blow would disturb the player in exactly the same way, so only do it once.
+    playerDisturb(1, 0);
+
     // Loop for number of blows, trying to hit the critter.
     // Note: blows will always be greater than 0 at the start of the loop -MRC-
     for (int i = blows; i > 0; i--) {
-        if (!playerTestBeingHit(base_to_hit, (int) py.misc.level, total_to_hit, (int) creature.ac, PlayerClassLevelAdj::BTH)) {
+        if (!playerRollToHit(base_to_hit, (int) session->py.misc.level, total_to_hit, (int) creature.ac, PlayerClassLevelAdj::BTH)) {
             (void) sprintf(msg, "You miss %s.", name);
             printMessage(msg);
             continue;
@@ -1164,23 +1232,13 @@ static void playerAttackMonster(Coord_t coord) {
         (void) sprintf(msg, "You hit %s.", name);
         printMessage(msg);
 
-        if (item.category_id != TV_NOTHING) {
-            damage = diceRoll(item.damage);
-            damage = itemMagicAbilityDamage(item, damage, monster.creature_id);
-            damage = playerWeaponCriticalBlow((int) item.weight, total_to_hit, damage, PlayerClassLevelAdj::BTH);
-        } else {
-            // Bare hands!?
-            damage = diceRoll(Dice_t{1, 1});
-            damage = playerWeaponCriticalBlow(1, 0, damage, PlayerClassLevelAdj::BTH);
-        }
-
-        damage += py.misc.plusses_to_damage;
-        if (damage < 0) {
-            damage = 0;
-        }
+        uint16_t slay_defense = 0;
+        damage = playerMeleeBlowDamage(item, total_to_hit, creature, critical_severity, slay_defense);
+        session->creature_recall[monster.creature_id].defenses |= slay_defense;
+        playerPrintCriticalBlowMessage(critical_severity);
 
-        if (py.flags.confuse_monster) {
-            py.flags.confuse_monster = false;
+        if (session->py.flags.confuse_monster) {
+            session->py.flags.confuse_monster = false;
 
             printMessage("Your hands stop glowing.");
 
@@ -1197,7 +1255,7 @@ static void playerAttackMonster(Coord_t coord) {
             printMessage(msg);
 
             if (monster.lit && randomNumber(4) == 1) {
-                creature_recall[monster.creature_id].defenses |= creature.defenses & config::monsters::defense::CD_NO_SLEEP;
+                session->creature_recall[monster.creature_id].defenses |= creature.defenses & config::monsters::defense::CD_NO_SLEEP;
             }
         }
 
@@ -1213,11 +1271,11 @@ static void playerAttackMonster(Coord_t coord) {
         // Use missiles up
         if (item.category_id >= TV_SLING_AMMO && item.category_id <= TV_SPIKE) {
             item.items_count--;
-            py.pack.weight -= item.weight;
-            py.flags.status |= config::player::status::PY_STR_WGT;
+            session->py.pack.weight -= item.weight;
+            session->py.flags.status |= config::player::status::PY_STR_WGT;
 
             if (item.items_count == 0) {
-                py.equipment_count--;
+                session->py.equipment_count--;
                 playerAdjustBonusesForItem(item, -1);
                 inventoryItemCopyTo(config::dungeon::objects::OBJ_NOTHING, item);
                 playerRecalculateBonuses();
@@ -1227,28 +1285,28 @@ static void playerAttackMonster(Coord_t coord) {
 }
 
 static int16_t playerLockPickingSkill() {
-    int16_t skill = py.misc.disarm;
+    int16_t skill = session->py.misc.disarm;
 
     skill += 2;
     skill *= playerDisarmAdjustment();
     skill += playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT);
-    skill += class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DISARM] * py.misc.level / 3;
+    skill += class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DISARM] * session->py.misc.level / 3;
 
     return skill;
 }
 
 static void openClosedDoor(Coord_t coord) {
-    Tile_t &tile = dg.floor[coord.y][coord.x];
-    Inventory_t &item = game.treasure.list[tile.treasure_id];
+    TileRef_t tile = session->dg.floor[coord.y][coord.x];
+    Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
     if (item.misc_use > 0) {
         // It's locked.
 
-        if (py.flags.confused > 0) {
+        if (session->py.flags.confused > 0) {
             printMessage("You are too confused to pick the lock.");
         } else if (playerLockPickingSkill() - item.misc_use > randomNumber(100)) {
             printMessage("You have picked the lock.");
-            py.misc.exp++;
+            session->py.misc.exp++;
             displayCharacterExperience();
             item.misc_use = 0;
         } else {
@@ -1261,26 +1319,27 @@ static void openClosedDoor(Coord_t coord) {
     }
 
     if (item.misc_use == 0) {
-        inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, game.treasure.list[tile.treasure_id]);
+        inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, session->game.treasure.list[tile.treasure_id]);
         tile.feature_id = TILE_CORR_FLOOR;
+        dungeonFloorTileChanged(coord);
         dungeonLiteSpot(coord);
-        game.command_count = 0;
+        session->game.command_count = 0;
     }
 }
 
 static void openClosedChest(Coord_t coord) {
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
-    Inventory_t &item = game.treasure.list[tile.treasure_id];
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+    Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
     bool success = false;
 
     if ((item.flags & config::treasure::chests::CH_LOCKED) != 0u) {
-        if (py.flags.confused > 0) {
+        if (session->py.flags.confused > 0) {
             printMessage("You are too confused to pick the lock.");
         } else if (playerLockPickingSkill() - item.depth_first_found > randomNumber(100)) {
             printMessage("You have picked the lock.");
 
-            py.misc.exp += item.depth_first_found;
+            session->py.misc.exp += item.depth_first_found;
             displayCharacterExperience();
 
             success = true;
@@ -1310,11 +1369,11 @@ static void openClosedChest(Coord_t coord) {
         // Chest treasure is allocated as if a creature had been killed.
         // clear the cursed chest/monster win flag, so that people
         // can not win by opening a cursed chest
-        inventoryItemRemoveCurse(game.treasure.list[tile.treasure_id]);
+        inventoryItemRemoveCurse(session->game.treasure.list[tile.treasure_id]);
 
-        (void) monsterDeath(coord, game.treasure.list[tile.treasure_id].flags);
+        (void) monsterDeath(coord, session->game.treasure.list[tile.treasure_id].flags);
 
-        game.treasure.list[tile.treasure_id].flags = 0;
+        session->game.treasure.list[tile.treasure_id].flags = 0;
     }
 }
 
@@ -1325,13 +1384,13 @@ void playerOpenClosedObject() {
         return;
     }
 
-    Coord_t coord = py.pos;
+    Coord_t coord = session->py.pos;
     (void) playerMovePosition(dir, coord);
 
     bool no_object = false;
 
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
-    Inventory_t const &item = game.treasure.list[tile.treasure_id];
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+    Inventory_t const &item = session->game.treasure.list[tile.treasure_id];
 
     if (tile.creature_id > 1 && tile.treasure_id != 0 && (item.category_id == TV_CLOSED_DOOR || item.category_id == TV_CHEST)) {
         objectBlockedByMonster(tile.creature_id);
@@ -1348,7 +1407,7 @@ void playerOpenClosedObject() {
     }
 
     if (no_object) {
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
         printMessage("I do not see anything you can open there.");
     }
 }
@@ -1361,11 +1420,11 @@ void playerCloseDoor() {
         return;
     }
 
-    Coord_t coord = py.pos;
+    Coord_t coord = session->py.pos;
     (void) playerMovePosition(dir, coord);
 
-    Tile_t &tile = dg.floor[coord.y][coord.x];
-    Inventory_t &item = game.treasure.list[tile.treasure_id];
+    TileRef_t tile = session->dg.floor[coord.y][coord.x];
+    Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
     bool no_object = false;
 
@@ -1375,6 +1434,7 @@ void playerCloseDoor() {
                 if (item.misc_use == 0) {
                     inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, item);
                     tile.feature_id = TILE_BLOCKED_FLOOR;
+                    dungeonFloorTileChanged(coord);
                     dungeonLiteSpot(coord);
                 } else {
                     printMessage("The door appears to be broken.");
@@ -1390,7 +1450,7 @@ void playerCloseDoor() {
     }
 
     if (no_object) {
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
         printMessage("I do not see anything you can close there.");
     }
 }
@@ -1402,7 +1462,7 @@ bool playerTunnelWall(Coord_t coord, int digging_ability, int digging_chance) {
         return false;
     }
 
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
     if (tile.perma_lit_room) {
         // Should become a room space, check to see whether
@@ -1411,9 +1471,9 @@ bool playerTunnelWall(Coord_t coord, int digging_ability, int digging_chance) {
 
         for (int y = coord.y - 1; y <= coord.y + 1 && y < MAX_HEIGHT; y++) {
             for (int x = coord.x - 1; x <= coord.x + 1 && x < MAX_WIDTH; x++) {
-                if (dg.floor[y][x].feature_id <= MAX_CAVE_ROOM) {
-                    tile.feature_id = dg.floor[y][x].feature_id;
-                    tile.permanent_light = dg.floor[y][x].permanent_light;
+                if (session->dg.floor[y][x].feature_id <= MAX_CAVE_ROOM) {
+                    tile.feature_id = session->dg.floor[y][x].feature_id;
+                    tile.permanent_light = session->dg.floor[y][x].permanent_light;
                     found = true;
                     break;
                 }
@@ -1430,6 +1490,7 @@ bool playerTunnelWall(Coord_t coord, int digging_ability, int digging_chance) {
         tile.permanent_light = false;
     }
 
+    dungeonFloorTileChanged(coord);
     tile.field_mark = false;
 
     if (coordInsidePanel(coord) && (tile.temporary_light || tile.permanent_light) && tile.treasure_id != 0) {
@@ -1444,7 +1505,7 @@ bool playerTunnelWall(Coord_t coord, int digging_ability, int digging_chance) {
 // let the player attack the creature
 void playerAttackPosition(Coord_t coord) {
     // Is a Coward?
-    if (py.flags.afraid > 0) {
+    if (session->py.flags.afraid > 0) {
         printMessage("You are too afraid!");
         return;
     }
@@ -1457,10 +1518,10 @@ static void eliminateKnownSpellsGreaterThanLevel(Spell_t *msp_ptr, const char *p
     uint32_t mask = 0x80000000L;
 
     for (int i = 31; mask != 0u; mask >>= 1, i--) {
-        if ((mask & py.flags.spells_learnt) != 0u) {
-            if (msp_ptr[i].level_required > py.misc.level) {
-                py.flags.spells_learnt &= ~mask;
-                py.flags.spells_forgotten |= mask;
+        if ((mask & session->py.flags.spells_learnt) != 0u) {
+            if (msp_ptr[i].level_required > session->py.misc.level) {
+                session->py.flags.spells_learnt &= ~mask;
+                session->py.flags.spells_forgotten |= mask;
 
                 vtype_t msg = {'\0'};
                 (void) sprintf(msg, "You have forgotten the %s of %s.", p, spell_names[i + offset]);
@@ -1473,7 +1534,7 @@ static void eliminateKnownSpellsGreaterThanLevel(Spell_t *msp_ptr, const char *p
 }
 
 static int numberOfSpellsAllowed(int stat) {
-    int levels = py.misc.level - classes[py.misc.class_id].min_level_for_spell_casting + 1;
+    int levels = session->py.misc.level - classes[session->py.misc.class_id].min_level_for_spell_casting + 1;
 
     int allowed;
 
@@ -1505,7 +1566,7 @@ static int numberOfSpellsKnown() {
     int known = 0;
 
     for (uint32_t mask = 0x1; mask != 0u; mask <<= 1) {
-        if ((mask & py.flags.spells_learnt) != 0u) {
+        if ((mask & session->py.flags.spells_learnt) != 0u) {
             known++;
         }
     }
@@ -1518,9 +1579,9 @@ static int numberOfSpellsKnown() {
 static int rememberForgottenSpells(Spell_t *msp_ptr, int allowed_spells, int new_spells, const char *p, int offset) {
     uint32_t mask;
 
-    for (int n = 0; ((py.flags.spells_forgotten != 0u) && (new_spells != 0) && (n < allowed_spells) && (n < 32)); n++) {
+    for (int n = 0; ((session->py.flags.spells_forgotten != 0u) && (new_spells != 0) && (n < allowed_spells) && (n < 32)); n++) {
         // order ID is (i+1)th spell learned
-        int order_id = py.flags.spells_learned_order[n];
+        int order_id = session->py.flags.spells_learned_order[n];
 
         // shifting by amounts greater than number of bits in long gives
         // an undefined result, so don't shift for unknown spells
@@ -1530,11 +1591,11 @@ static int rememberForgottenSpells(Spell_t *msp_ptr, int allowed_spells, int new
             mask = (uint32_t)(1L << order_id);
         }
 
-        if ((mask & py.flags.spells_forgotten) != 0u) {
-            if (msp_ptr[order_id].level_required <= py.misc.level) {
+        if ((mask & session->py.flags.spells_forgotten) != 0u) {
+            if (msp_ptr[order_id].level_required <= session->py.misc.level) {
                 new_spells--;
-                py.flags.spells_forgotten &= ~mask;
-                py.flags.spells_learnt |= mask;
+                session->py.flags.spells_forgotten &= ~mask;
+                session->py.flags.spells_learnt |= mask;
 
                 vtype_t msg = {'\0'};
                 (void) sprintf(msg, "You have remembered the %s of %s.", p, spell_names[order_id + offset]);
@@ -1551,7 +1612,7 @@ static int rememberForgottenSpells(Spell_t *msp_ptr, int allowed_spells, int new
 // determine which spells player can learn must check all spells here,
 // in gain_spell() we actually check if the books are present
 static int learnableSpells(Spell_t *msp_ptr, int new_spells) {
-    auto spell_flag = (uint32_t)(0x7FFFFFFFL & ~py.flags.spells_learnt);
+    auto spell_flag = (uint32_t)(0x7FFFFFFFL & ~session->py.flags.spells_learnt);
 
     int id = 0;
     uint32_t mask = 0x1;
@@ -1559,7 +1620,7 @@ static int learnableSpells(Spell_t *msp_ptr, int new_spells) {
     for (int i = 0; spell_flag != 0u; mask <<= 1, i++) {
         if ((spell_flag & mask) != 0u) {
             spell_flag &= ~mask;
-            if (msp_ptr[i].level_required <= py.misc.level) {
+            if (msp_ptr[i].level_required <= session->py.misc.level) {
                 id++;
             }
         }
@@ -1578,9 +1639,9 @@ static int learnableSpells(Spell_t *msp_ptr, int new_spells) {
 static void forgetSpells(int new_spells, const char *p, int offset) {
     uint32_t mask;
 
-    for (int i = 31; (new_spells != 0) && (py.flags.spells_learnt != 0u); i--) {
+    for (int i = 31; (new_spells != 0) && (session->py.flags.spells_learnt != 0u); i--) {
         // orderID is the (i+1)th spell learned
-        int order_id = py.flags.spells_learned_order[i];
+        int order_id = session->py.flags.spells_learned_order[i];
 
         // shifting by amounts greater than number of bits in long gives
         // an undefined result, so don't shift for unknown spells
@@ -1590,9 +1651,9 @@ static void forgetSpells(int new_spells, const char *p, int offset) {
             mask = (uint32_t)(1L << order_id);
         }
 
-        if ((mask & py.flags.spells_learnt) != 0u) {
-            py.flags.spells_learnt &= ~mask;
-            py.flags.spells_forgotten |= mask;
+        if ((mask & session->py.flags.spells_learnt) != 0u) {
+            session->py.flags.spells_learnt &= ~mask;
+            session->py.flags.spells_forgotten |= mask;
             new_spells++;
 
             vtype_t msg = {'\0'};
@@ -1605,7 +1666,7 @@ static void forgetSpells(int new_spells, const char *p, int offset) {
 // calculate number of spells player should have, and
 // learn forget spells until that number is met -JEW-
 void playerCalculateAllowedSpellsCount(int stat) {
-    Spell_t &spell = magic_spells[py.misc.class_id - 1][0];
+    Spell_t &spell = magic_spells[session->py.misc.class_id - 1][0];
 
     const char *magic_type_str = nullptr;
     int offset;
@@ -1638,25 +1699,25 @@ void playerCalculateAllowedSpellsCount(int stat) {
         new_spells = 0;
     }
 
-    if (new_spells != py.flags.new_spells_to_learn) {
-        if (new_spells > 0 && py.flags.new_spells_to_learn == 0) {
+    if (new_spells != session->py.flags.new_spells_to_learn) {
+        if (new_spells > 0 && session->py.flags.new_spells_to_learn == 0) {
             vtype_t msg = {'\0'};
             (void) sprintf(msg, "You can learn some new %ss now.", magic_type_str);
             printMessage(msg);
         }
 
-        py.flags.new_spells_to_learn = (uint8_t) new_spells;
-        py.flags.status |= config::player::status::PY_STUDY;
+        session->py.flags.new_spells_to_learn = (uint8_t) new_spells;
+        session->py.flags.status |= config::player::status::PY_STUDY;
     }
 }
 
 char *playerRankTitle() {
     const char *p = nullptr;
 
-    if (py.misc.level < 1) {
+    if (session->py.misc.level < 1) {
         p = "Babe in arms";
-    } else if (py.misc.level <= PLAYER_MAX_LEVEL) {
-        p = class_rank_titles[py.misc.class_id][py.misc.level - 1];
+    } else if (session->py.misc.level <= PLAYER_MAX_LEVEL) {
+        p = class_rank_titles[session->py.misc.class_id][session->py.misc.level - 1];
     } else if (playerIsMale()) {
         p = "**KING**";
     } else {
@@ -176,8 +176,6 @@ typedef struct Player_t {
     bool carrying_light = false;  // `true` when player is carrying light
 } Player_t;
 
-extern Player_t py;
-
 extern ClassRankTitle_t class_rank_titles[PLAYER_MAX_CLASSES][PLAYER_MAX_LEVEL];
 extern Race_t character_races[PLAYER_MAX_RACES];
 extern Background_t character_backgrounds[PLAYER_MAX_BACKGROUNDS];
@@ -200,6 +198,7 @@ void playerSearchOff();
 void playerRestOn();
 void playerRestOff();
 void playerDiedFromString(vtype_t *description, const char *monster_name, uint32_t move);
+bool playerRollAttackHits(int attack_id, uint8_t level);
 bool playerTestAttackHits(int attack_id, uint8_t level);
 
 void playerChangeSpeed(int speed);
@@ -207,6 +206,7 @@ void playerAdjustBonusesForItem(Inventory_t const &item, int factor);
 void playerRecalculateBonuses();
 void playerTakeOff(int item_id, int pack_position_id);
 bool playerTestBeingHit(int base_to_hit, int level, int plus_to_hit, int armor_class, int attack_type_id);
+bool playerRollToHit(int base_to_hit, int level, int plus_to_hit, int armor_class, int attack_type_id);
 void playerTakesHit(int damage, const char *creature_name);
 
 void playerSearch(Coord_t coord, int chance);
@@ -222,6 +222,9 @@ void playerWornItemRemoveCurse(PlayerEquipment id);
 
 void playerGainSpells();
 void playerGainMana(int stat);
+int playerWeaponCriticalSeverity(int weapon_weight, int plus_to_hit, int attack_type_id);
+int playerWeaponCriticalDamage(int damage, int severity);
+void playerPrintCriticalBlowMessage(int severity);
 int playerWeaponCriticalBlow(int weapon_weight, int plus_to_hit, int damage, int attack_type_id);
 bool playerSavingThrow();
 
@@ -229,6 +232,8 @@ void playerGainKillExperience(Creature_t const &creature);
 void playerOpenClosedObject();
 void playerCloseDoor();
 bool playerTunnelWall(Coord_t coord, int digging_ability, int digging_chance);
+void playerCalculateToHitBlows(int weapon_id, int weapon_weight, int &blows, int &total_to_hit);
+int playerMeleeBlowDamage(Inventory_t const &item, int total_to_hit, Creature_t const &creature, int &critical_severity, uint16_t &slay_defense);
 void playerAttackPosition(Coord_t coord);
 void playerCalculateAllowedSpellsCount(int stat);
 
@@ -249,6 +254,7 @@ bool playerRemoveFear();
 bool playerProtectEvil();
 void playerBless(int adjustment);
 void playerDetectInvisible(int adjustment);
+int itemMagicAbilityDamageAgainst(Inventory_t const &item, int total_damage, Creature_t const &creature, uint16_t &slay_defense);
 int itemMagicAbilityDamage(Inventory_t const &item, int total_damage, int monster_id);
 
 // player_move.cpp
@@ -258,7 +264,17 @@ void playerMove(int direction, bool do_pickup);
 void playerFindInitialize(int direction);
 void playerRunAndFind();
 void playerEndRunning();
-void playerAreaAffect(int direction, Coord_t coord);
+void playerRunFindCorridors();
+void playerRunTileChanged(Coord_t const &coord);
+
+// player_travel.cpp
+void playerTravelForgetMap();
+void playerTravelSeeTile(Coord_t const &coord);
+void playerTravelTileChanged(Coord_t const &coord);
+bool playerTravelling();
+void playerTravelCancel();
+bool playerTravelInitialize(char symbol);
+void playerTravelStep();
 
 // player_stats.cpp
 void playerInitializeBaseExperienceLevels();
@@ -10,7 +10,7 @@
 
 static void playerBashAttack(Coord_t coord);
 static void playerBashPosition(Coord_t coord);
-static void playerBashClosedDoor(Coord_t coord, int dir, Tile_t &tile, Inventory_t &item);
+static void playerBashClosedDoor(Coord_t coord, int dir, TileRef_t tile, Inventory_t &item);
 static void playerBashClosedChest(Inventory_t &item);
 
 // Bash open a door or chest -RAK-
@@ -38,15 +38,15 @@ void playerBash() {
         return;
     }
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are confused.");
         dir = getRandomDirection();
     }
 
-    Coord_t coord = py.pos;
+    Coord_t coord = session->py.pos;
     (void) playerMovePosition(dir, coord);
 
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
     if (tile.creature_id > 1) {
         playerBashPosition(coord);
@@ -54,7 +54,7 @@ void playerBash() {
     }
 
     if (tile.treasure_id != 0) {
-        Inventory_t &item = game.treasure.list[tile.treasure_id];
+        Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
         if (item.category_id == TV_CLOSED_DOOR) {
             playerBashClosedDoor(coord, dir, tile, item);
@@ -80,9 +80,9 @@ void playerBash() {
 // Make a bash attack on someone. -CJS-
 // Used to be part of bash above.
 static void playerBashAttack(Coord_t coord) {
-    int monster_id = dg.floor[coord.y][coord.x].creature_id;
+    int monster_id = session->dg.floor[coord.y][coord.x].creature_id;
 
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
 
     monster.sleep_count = 0;
@@ -95,24 +95,24 @@ static void playerBashAttack(Coord_t coord) {
         (void) sprintf(name, "the %s", creature.name);
     }
 
-    int base_to_hit = py.stats.used[PlayerAttr::A_STR];
-    base_to_hit += py.inventory[PlayerEquipment::Arm].weight / 2;
-    base_to_hit += py.misc.weight / 10;
+    int base_to_hit = session->py.stats.used[PlayerAttr::A_STR];
+    base_to_hit += session->py.inventory[PlayerEquipment::Arm].weight / 2;
+    base_to_hit += session->py.misc.weight / 10;
 
     if (!monster.lit) {
         base_to_hit /= 2;
-        base_to_hit -= py.stats.used[PlayerAttr::A_DEX] * (BTH_PER_PLUS_TO_HIT_ADJUST - 1);
-        base_to_hit -= py.misc.level * class_level_adj[py.misc.class_id][PlayerClassLevelAdj::BTH] / 2;
+        base_to_hit -= session->py.stats.used[PlayerAttr::A_DEX] * (BTH_PER_PLUS_TO_HIT_ADJUST - 1);
+        base_to_hit -= session->py.misc.level * class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::BTH] / 2;
     }
 
-    if (playerTestBeingHit(base_to_hit, (int) py.misc.level, (int) py.stats.used[PlayerAttr::A_DEX], (int) creature.ac, PlayerClassLevelAdj::BTH)) {
+    if (playerTestBeingHit(base_to_hit, (int) session->py.misc.level, (int) session->py.stats.used[PlayerAttr::A_DEX], (int) creature.ac, PlayerClassLevelAdj::BTH)) {
         vtype_t msg = {'\0'};
         (void) sprintf(msg, "You hit %s.", name);
         printMessage(msg);
 
-        int damage = diceRoll(py.inventory[PlayerEquipment::Arm].damage);
-        damage = playerWeaponCriticalBlow(py.inventory[PlayerEquipment::Arm].weight / 4 + py.stats.used[PlayerAttr::A_STR], 0, damage, PlayerClassLevelAdj::BTH);
-        damage += py.misc.weight / 60;
+        int damage = diceRoll(session->py.inventory[PlayerEquipment::Arm].damage);
+        damage = playerWeaponCriticalBlow(session->py.inventory[PlayerEquipment::Arm].weight / 4 + session->py.stats.used[PlayerAttr::A_STR], 0, damage, PlayerClassLevelAdj::BTH);
+        damage += session->py.misc.weight / 60;
         damage += 3;
 
         if (damage < 0) {
@@ -154,15 +154,15 @@ static void playerBashAttack(Coord_t coord) {
         printMessage(msg);
     }
 
-    if (randomNumber(150) > py.stats.used[PlayerAttr::A_DEX]) {
+    if (randomNumber(150) > session->py.stats.used[PlayerAttr::A_DEX]) {
         printMessage("You are off balance.");
-        py.flags.paralysis = (int16_t)(1 + randomNumber(2));
+        session->py.flags.paralysis = (int16_t)(1 + randomNumber(2));
     }
 }
 
 static void playerBashPosition(Coord_t coord) {
     // Is a Coward?
-    if (py.flags.afraid > 0) {
+    if (session->py.flags.afraid > 0) {
         printMessage("You are afraid!");
         return;
     }
@@ -170,24 +170,25 @@ static void playerBashPosition(Coord_t coord) {
     playerBashAttack(coord);
 }
 
-static void playerBashClosedDoor(Coord_t coord, int dir, Tile_t &tile, Inventory_t &item) {
+static void playerBashClosedDoor(Coord_t coord, int dir, TileRef_t tile, Inventory_t &item) {
     printMessageNoCommandInterrupt("You smash into the door!");
 
-    int chance = py.stats.used[PlayerAttr::A_STR] + py.misc.weight / 2;
+    int chance = session->py.stats.used[PlayerAttr::A_STR] + session->py.misc.weight / 2;
 
     // Use (roughly) similar method as for monsters.
     auto abs_misc_use = (int) std::abs((std::intmax_t) item.misc_use);
     if (randomNumber(chance * (20 + abs_misc_use)) < 10 * (chance - abs_misc_use)) {
         printMessage("The door crashes open!");
 
-        inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, game.treasure.list[tile.treasure_id]);
+        inventoryItemCopyTo(config::dungeon::objects::OBJ_OPEN_DOOR, session->game.treasure.list[tile.treasure_id]);
 
         // 50% chance of breaking door
         item.misc_use = (int16_t)(1 - randomNumber(2));
 
         tile.feature_id = TILE_CORR_FLOOR;
+        dungeonFloorTileChanged(coord);
 
-        if (py.flags.confused == 0) {
+        if (session->py.flags.confused == 0) {
             playerMove(dir, false);
         } else {
             dungeonLiteSpot(coord);
@@ -196,13 +197,13 @@ static void playerBashClosedDoor(Coord_t coord, int dir, Tile_t &tile, Inventory
         return;
     }
 
-    if (randomNumber(150) > py.stats.used[PlayerAttr::A_DEX]) {
+    if (randomNumber(150) > session->py.stats.used[PlayerAttr::A_DEX]) {
         printMessage("You are off-balance.");
-        py.flags.paralysis = (int16_t)(1 + randomNumber(2));
+        session->py.flags.paralysis = (int16_t)(1 + randomNumber(2));
         return;
     }
 
-    if (game.command_count == 0) {
+    if (session->game.command_count == 0) {
         printMessage("The door holds firm.");
     }
 }
@@ -36,9 +36,9 @@ enum class FoodMagicTypes {
 
 // Eat some food. -RAK-
 void playerEat() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("But you are not carrying anything.");
         return;
     }
@@ -54,37 +54,37 @@ void playerEat() {
         return;
     }
 
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
     bool identified = false;
 
-    Inventory_t *item = &py.inventory[item_id];
+    Inventory_t *item = &session->py.inventory[item_id];
     uint32_t item_flags = item->flags;
 
     while (item_flags != 0) {
         switch ((FoodMagicTypes)(getAndClearFirstBit(item_flags) + 1)) {
             case FoodMagicTypes::Poison:
-                py.flags.poisoned += randomNumber(10) + item->depth_first_found;
+                session->py.flags.poisoned += randomNumber(10) + item->depth_first_found;
                 identified = true;
                 break;
             case FoodMagicTypes::Blindness:
-                py.flags.blind += randomNumber(250) + 10 * item->depth_first_found + 100;
+                session->py.flags.blind += randomNumber(250) + 10 * item->depth_first_found + 100;
                 drawCavePanel();
                 printMessage("A veil of darkness surrounds you.");
                 identified = true;
                 break;
             case FoodMagicTypes::Paranoia:
-                py.flags.afraid += randomNumber(10) + item->depth_first_found;
+                session->py.flags.afraid += randomNumber(10) + item->depth_first_found;
                 printMessage("You feel terrified!");
                 identified = true;
                 break;
             case FoodMagicTypes::Confusion:
-                py.flags.confused += randomNumber(10) + item->depth_first_found;
+                session->py.flags.confused += randomNumber(10) + item->depth_first_found;
                 printMessage("You feel drugged.");
                 identified = true;
                 break;
             case FoodMagicTypes::Hallucination:
-                py.flags.image += randomNumber(200) + 25 * item->depth_first_found + 200;
+                session->py.flags.image += randomNumber(200) + 25 * item->depth_first_found + 200;
                 printMessage("You feel drugged.");
                 identified = true;
                 break;
@@ -95,8 +95,8 @@ void playerEat() {
                 identified = playerCureBlindness();
                 break;
             case FoodMagicTypes::CureParanoia:
-                if (py.flags.afraid > 1) {
-                    py.flags.afraid = 1;
+                if (session->py.flags.afraid > 1) {
+                    session->py.flags.afraid = 1;
                     identified = true;
                 }
                 break;
@@ -211,12 +211,12 @@ void playerEat() {
         if (!itemSetColorlessAsIdentified(item->category_id, item->sub_category_id, item->identification)) {
             // use identified it, gain experience
             // round half-way case up
-            py.misc.exp += (item->depth_first_found + (py.misc.level >> 1)) / py.misc.level;
+            session->py.misc.exp += (item->depth_first_found + (session->py.misc.level >> 1)) / session->py.misc.level;
 
             displayCharacterExperience();
 
-            itemIdentify(py.inventory[item_id], item_id);
-            item = &py.inventory[item_id];
+            itemIdentify(session->py.inventory[item_id], item_id);
+            item = &session->py.inventory[item_id];
         }
     } else if (!itemSetColorlessAsIdentified(item->category_id, item->sub_category_id, item->identification)) {
         itemSetAsTried(*item);
@@ -224,7 +224,7 @@ void playerEat() {
 
     playerIngestFood(item->misc_use);
 
-    py.flags.status &= ~(config::player::status::PY_WEAK | config::player::status::PY_HUNGRY);
+    session->py.flags.status &= ~(config::player::status::PY_WEAK | config::player::status::PY_HUNGRY);
 
     printCharacterHungerStatus();
 
@@ -234,31 +234,31 @@ void playerEat() {
 
 // Add to the players food time -RAK-
 void playerIngestFood(int amount) {
-    if (py.flags.food < 0) {
-        py.flags.food = 0;
+    if (session->py.flags.food < 0) {
+        session->py.flags.food = 0;
     }
 
-    py.flags.food += amount;
+    session->py.flags.food += amount;
 
-    if (py.flags.food > config::player::PLAYER_FOOD_MAX) {
+    if (session->py.flags.food > config::player::PLAYER_FOOD_MAX) {
         printMessage("You are bloated from overeating.");
 
         // Calculate how much of amount is responsible for the bloating. Give the
         // player food credit for 1/50, and also slow them for that many turns.
-        int extra = py.flags.food - config::player::PLAYER_FOOD_MAX;
+        int extra = session->py.flags.food - config::player::PLAYER_FOOD_MAX;
         if (extra > amount) {
             extra = amount;
         }
         int penalty = extra / 50;
 
-        py.flags.slow += penalty;
+        session->py.flags.slow += penalty;
 
         if (extra == amount) {
-            py.flags.food = (int16_t)(py.flags.food - amount + penalty);
+            session->py.flags.food = (int16_t)(session->py.flags.food - amount + penalty);
         } else {
-            py.flags.food = (int16_t)(config::player::PLAYER_FOOD_MAX + penalty);
+            session->py.flags.food = (int16_t)(config::player::PLAYER_FOOD_MAX + penalty);
         }
-    } else if (py.flags.food > config::player::PLAYER_FOOD_FULL) {
+    } else if (session->py.flags.food > config::player::PLAYER_FOOD_FULL) {
         printMessage("You are full.");
     }
 }
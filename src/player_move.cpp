@@ -10,7 +10,7 @@
 static void trapOpenPit(Inventory_t const &item, int dam) {
     printMessage("You fell into a pit!");
 
-    if (py.flags.free_fall) {
+    if (session->py.flags.free_fall) {
         printMessage("You gently float down.");
         return;
     }
@@ -21,7 +21,7 @@ static void trapOpenPit(Inventory_t const &item, int dam) {
 }
 
 static void trapArrow(Inventory_t const &item, int dam) {
-    if (playerTestBeingHit(125, 0, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+    if (playerTestBeingHit(125, 0, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
         obj_desc_t description = {'\0'};
         itemDescription(description, item, true);
         playerTakesHit(dam, description);
@@ -36,7 +36,7 @@ static void trapArrow(Inventory_t const &item, int dam) {
 static void trapCoveredPit(Inventory_t const &item, int dam, Coord_t coord) {
     printMessage("You fell into a covered pit.");
 
-    if (py.flags.free_fall) {
+    if (session->py.flags.free_fall) {
         printMessage("You gently float down.");
     } else {
         obj_desc_t description = {'\0'};
@@ -48,12 +48,12 @@ static void trapCoveredPit(Inventory_t const &item, int dam, Coord_t coord) {
 }
 
 static void trapDoor(Inventory_t const &item, int dam) {
-    dg.generate_new_level = true;
-    dg.current_level++;
+    session->dg.generate_new_level = true;
+    session->dg.current_level++;
 
     printMessage("You fell through a trap door!");
 
-    if (py.flags.free_fall) {
+    if (session->py.flags.free_fall) {
         printMessage("You gently float down.");
     } else {
         obj_desc_t description = {'\0'};
@@ -66,18 +66,18 @@ static void trapDoor(Inventory_t const &item, int dam) {
 }
 
 static void trapSleepingGas() {
-    if (py.flags.paralysis != 0) {
+    if (session->py.flags.paralysis != 0) {
         return;
     }
 
     printMessage("A strange white mist surrounds you!");
 
-    if (py.flags.free_action) {
+    if (session->py.flags.free_action) {
         printMessage("You are unaffected.");
         return;
     }
 
-    py.flags.paralysis += randomNumber(10) + 4;
+    session->py.flags.paralysis += randomNumber(10) + 4;
     printMessage("You fall asleep.");
 }
 
@@ -90,8 +90,8 @@ static void trapHiddenObject(Coord_t coord) {
 }
 
 static void trapStrengthDart(Inventory_t const &item, int dam) {
-    if (playerTestBeingHit(125, 0, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
-        if (!py.flags.sustain_str) {
+    if (playerTestBeingHit(125, 0, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
+        if (!session->py.flags.sustain_str) {
             (void) playerStatRandomDecrease(PlayerAttr::A_STR);
 
             obj_desc_t description = {'\0'};
@@ -108,7 +108,7 @@ static void trapStrengthDart(Inventory_t const &item, int dam) {
 }
 
 static void trapTeleport(Coord_t coord) {
-    game.teleport_player = true;
+    session->game.teleport_player = true;
 
     printMessage("You hit a teleport trap!");
 
@@ -167,27 +167,27 @@ static void trapPoisonGas(int dam) {
 static void trapBlindGas() {
     printMessage("A black gas surrounds you!");
 
-    py.flags.blind += randomNumber(50) + 50;
+    session->py.flags.blind += randomNumber(50) + 50;
 }
 
 static void trapConfuseGas() {
     printMessage("A gas of scintillating colors surrounds you!");
 
-    py.flags.confused += randomNumber(15) + 15;
+    session->py.flags.confused += randomNumber(15) + 15;
 }
 
 static void trapSlowDart(Inventory_t const &item, int dam) {
-    if (playerTestBeingHit(125, 0, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
+    if (playerTestBeingHit(125, 0, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
         obj_desc_t description = {'\0'};
         itemDescription(description, item, true);
         playerTakesHit(dam, description);
 
         printMessage("A small dart hits you!");
 
-        if (py.flags.free_action) {
+        if (session->py.flags.free_action) {
             printMessage("You are unaffected.");
         } else {
-            py.flags.slow += randomNumber(20) + 10;
+            session->py.flags.slow += randomNumber(20) + 10;
         }
     } else {
         printMessage("A small dart barely misses you.");
@@ -195,8 +195,8 @@ static void trapSlowDart(Inventory_t const &item, int dam) {
 }
 
 static void trapConstitutionDart(Inventory_t const &item, int dam) {
-    if (playerTestBeingHit(125, 0, 0, py.misc.ac + py.misc.magical_ac, CLASS_MISC_HIT)) {
-        if (!py.flags.sustain_con) {
+    if (playerTestBeingHit(125, 0, 0, session->py.misc.ac + session->py.misc.magical_ac, CLASS_MISC_HIT)) {
+        if (!session->py.flags.sustain_con) {
             (void) playerStatRandomDecrease(PlayerAttr::A_CON);
 
             obj_desc_t description = {'\0'};
@@ -246,7 +246,7 @@ static void playerStepsOnTrap(Coord_t coord) {
     playerEndRunning();
     trapChangeVisibility(coord);
 
-    Inventory_t const &item = game.treasure.list[dg.floor[coord.y][coord.x].treasure_id];
+    Inventory_t const &item = session->game.treasure.list[session->dg.floor[coord.y][coord.x].treasure_id];
 
     int damage = diceRoll(item.damage);
 
@@ -345,7 +345,7 @@ static bool playerRandomMovement(int dir) {
     // 75% random movement
     bool player_random_move = randomNumber(4) > 1;
 
-    bool player_is_confused = py.flags.confused > 0;
+    bool player_is_confused = session->py.flags.confused > 0;
 
     return player_is_confused && player_random_move;
 }
@@ -354,9 +354,9 @@ static bool playerRandomMovement(int dir) {
 // on the TVAL of the object. Traps are set off, money and most objects
 // are picked up. Some objects, such as open doors, just sit there.
 static void carry(Coord_t coord, bool pickup) {
-    Inventory_t &item = game.treasure.list[dg.floor[coord.y][coord.x].treasure_id];
+    Inventory_t &item = session->game.treasure.list[session->dg.floor[coord.y][coord.x].treasure_id];
 
-    int tile_flags = game.treasure.list[dg.floor[coord.y][coord.x].treasure_id].category_id;
+    int tile_flags = session->game.treasure.list[session->dg.floor[coord.y][coord.x].treasure_id].category_id;
 
     if (tile_flags > TV_MAX_PICK_UP) {
         if (tile_flags == TV_INVIS_TRAP || tile_flags == TV_VIS_TRAP || tile_flags == TV_STORE_DOOR) {
@@ -373,7 +373,7 @@ static void carry(Coord_t coord, bool pickup) {
 
     // There's GOLD in them thar hills!
     if (tile_flags == TV_GOLD) {
-        py.misc.au += item.cost;
+        session->py.misc.au += item.cost;
 
         itemDescription(description, item, true);
         (void) sprintf(msg, "You have found %d gold pieces worth of %s", item.cost, description);
@@ -389,7 +389,7 @@ static void carry(Coord_t coord, bool pickup) {
     // Too many objects?
     if (inventoryCanCarryItemCount(item)) {
         // Okay,  pick it up
-        if (pickup && config::options::prompt_to_pickup) {
+        if (pickup && session->options.prompt_to_pickup) {
             itemDescription(description, item, true);
 
             // change the period to a question mark
@@ -410,7 +410,7 @@ static void carry(Coord_t coord, bool pickup) {
         if (pickup) {
             int locn = inventoryCarryItem(item);
 
-            itemDescription(description, py.inventory[locn], true);
+            itemDescription(description, session->py.inventory[locn], true);
             (void) sprintf(msg, "You have %s (%c)", description, locn + 'a');
             printMessage(msg);
             (void) dungeonDeleteObject(coord);
@@ -429,15 +429,15 @@ void playerMove(int direction, bool do_pickup) {
         playerEndRunning();
     }
 
-    Coord_t coord = py.pos;
+    Coord_t coord = session->py.pos;
 
     // Legal move?
     if (!playerMovePosition(direction, coord)) {
         return;
     }
 
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
-    Monster_t const &monster = monsters[tile.creature_id];
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+    Monster_t const &monster = session->monsters[tile.creature_id];
 
     // if there is no creature, or an unlit creature in the walls then...
     // disallow attacks against unlit creatures in walls because moving into
@@ -448,42 +448,37 @@ void playerMove(int direction, bool do_pickup) {
         // Open floor spot
         if (tile.feature_id <= MAX_OPEN_SPACE) {
             // Make final assignments of char coords
-            Coord_t old_coord = py.pos;
+            Coord_t old_coord = session->py.pos;
 
-            py.pos.y = coord.y;
-            py.pos.x = coord.x;
+            session->py.pos.y = coord.y;
+            session->py.pos.x = coord.x;
 
             // Move character record (-1)
-            dungeonMoveCreatureRecord(old_coord, py.pos);
+            dungeonMoveCreatureRecord(old_coord, session->py.pos);
 
             // Check for new panel
-            if (coordOutsidePanel(py.pos, false)) {
+            if (coordOutsidePanel(session->py.pos, false)) {
                 drawDungeonPanel();
             }
 
-            // Check to see if they should stop
-            if (py.running_tracker != 0) {
-                playerAreaAffect(direction, py.pos);
-            }
-
             // Check to see if they've noticed something
             // fos may be negative if have good rings of searching
-            if (py.misc.fos <= 1 || randomNumber(py.misc.fos) == 1 || ((py.flags.status & config::player::status::PY_SEARCH) != 0u)) {
-                playerSearch(py.pos, py.misc.chance_in_search);
+            if (session->py.misc.fos <= 1 || randomNumber(session->py.misc.fos) == 1 || ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u)) {
+                playerSearch(session->py.pos, session->py.misc.chance_in_search);
             }
 
             if (tile.feature_id == TILE_LIGHT_FLOOR) {
                 // A room of light should be lit.
 
-                if (!tile.permanent_light && (py.flags.blind == 0)) {
-                    dungeonLightRoom(py.pos);
+                if (!tile.permanent_light && (session->py.flags.blind == 0)) {
+                    dungeonLightRoom(session->py.pos);
                 }
-            } else if (tile.perma_lit_room && py.flags.blind < 1) {
+            } else if (tile.perma_lit_room && session->py.flags.blind < 1) {
                 // In doorway of light-room?
 
-                for (int row = (py.pos.y - 1); row <= (py.pos.y + 1); row++) {
-                    for (int col = (py.pos.x - 1); col <= (py.pos.x + 1); col++) {
-                        if (dg.floor[row][col].feature_id == TILE_LIGHT_FLOOR && !dg.floor[row][col].permanent_light) {
+                for (int row = (session->py.pos.y - 1); row <= (session->py.pos.y + 1); row++) {
+                    for (int col = (session->py.pos.x - 1); col <= (session->py.pos.x + 1); col++) {
+                        if (session->dg.floor[row][col].feature_id == TILE_LIGHT_FLOOR && !session->dg.floor[row][col].permanent_light) {
                             dungeonLightRoom(Coord_t{row, col});
                         }
                     }
@@ -491,27 +486,27 @@ void playerMove(int direction, bool do_pickup) {
             }
 
             // Move the light source
-            dungeonMoveCharacterLight(old_coord, py.pos);
+            dungeonMoveCharacterLight(old_coord, session->py.pos);
 
             // An object is beneath them.
             if (tile.treasure_id != 0) {
-                carry(py.pos, do_pickup);
+                carry(session->py.pos, do_pickup);
 
                 // if stepped on falling rock trap, and space contains
                 // rubble, then step back into a clear area
-                if (game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
-                    dungeonMoveCreatureRecord(py.pos, old_coord);
-                    dungeonMoveCharacterLight(py.pos, old_coord);
+                if (session->game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
+                    dungeonMoveCreatureRecord(session->py.pos, old_coord);
+                    dungeonMoveCharacterLight(session->py.pos, old_coord);
 
-                    py.pos.y = old_coord.y;
-                    py.pos.x = old_coord.x;
+                    session->py.pos.y = old_coord.y;
+                    session->py.pos.x = old_coord.x;
 
                     // check to see if we have stepped back onto another trap, if so, set it off
-                    uint8_t id = dg.floor[py.pos.y][py.pos.x].treasure_id;
+                    uint8_t id = session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id;
                     if (id != 0) {
-                        int val = game.treasure.list[id].category_id;
+                        int val = session->game.treasure.list[id].category_id;
                         if (val == TV_INVIS_TRAP || val == TV_VIS_TRAP || val == TV_STORE_DOOR) {
-                            playerStepsOnTrap(py.pos);
+                            playerStepsOnTrap(session->py.pos);
                         }
                     }
                 }
@@ -519,28 +514,28 @@ void playerMove(int direction, bool do_pickup) {
         } else {
             // Can't move onto floor space
 
-            if ((py.running_tracker == 0) && tile.treasure_id != 0) {
-                if (game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
+            if ((session->py.running_tracker == 0) && tile.treasure_id != 0) {
+                if (session->game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
                     printMessage("There is rubble blocking your way.");
-                } else if (game.treasure.list[tile.treasure_id].category_id == TV_CLOSED_DOOR) {
+                } else if (session->game.treasure.list[tile.treasure_id].category_id == TV_CLOSED_DOOR) {
                     printMessage("There is a closed door blocking your way.");
                 }
             } else {
                 playerEndRunning();
             }
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
         }
     } else {
         // Attacking a creature!
 
-        int old_find_flag = py.running_tracker;
+        int old_find_flag = session->py.running_tracker;
 
         playerEndRunning();
 
         // if player can see monster, and was in find mode, then nothing
         if (monster.lit && (old_find_flag != 0)) {
             // did not do anything this turn
-            game.player_free_turn = true;
+            session->game.player_free_turn = true;
         } else {
             playerAttackPosition(coord);
         }
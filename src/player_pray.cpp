@@ -8,7 +8,7 @@
 #include "headers.h"
 
 static bool playerCanPray(int &item_pos_begin, int &item_pos_end) {
-    if (py.flags.blind > 0) {
+    if (session->py.flags.blind > 0) {
         printMessage("You can't see to read your prayer!");
         return false;
     }
@@ -18,17 +18,17 @@ static bool playerCanPray(int &item_pos_begin, int &item_pos_end) {
         return false;
     }
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are too confused.");
         return false;
     }
 
-    if (classes[py.misc.class_id].class_to_use_mage_spells != config::spells::SPELL_TYPE_PRIEST) {
+    if (classes[session->py.misc.class_id].class_to_use_mage_spells != config::spells::SPELL_TYPE_PRIEST) {
         printMessage("Pray hard enough and your prayers may be answered.");
         return false;
     }
 
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("But you are not carrying anything!");
         return false;
     }
@@ -94,7 +94,7 @@ static void playerRecitePrayer(int prayer_type) {
             (void) playerRemoveFear();
             break;
         case PriestSpellTypes::CallLight:
-            (void) spellLightArea(py.pos);
+            (void) spellLightArea(session->py.pos);
             break;
         case PriestSpellTypes::FindTraps:
             (void) spellDetectTrapsWithinVicinity();
@@ -107,11 +107,11 @@ static void playerRecitePrayer(int prayer_type) {
             break;
         case PriestSpellTypes::BlindCreature:
             if (getDirectionWithMemory(CNIL, dir)) {
-                (void) spellConfuseMonster(py.pos, dir);
+                (void) spellConfuseMonster(session->py.pos, dir);
             }
             break;
         case PriestSpellTypes::Portal:
-            playerTeleport((py.misc.level * 3));
+            playerTeleport((session->py.misc.level * 3));
             break;
         case PriestSpellTypes::CureMediumWounds:
             (void) spellChangePlayerHitPoints(diceRoll(Dice_t{4, 4}));
@@ -120,13 +120,13 @@ static void playerRecitePrayer(int prayer_type) {
             playerBless(randomNumber(24) + 24);
             break;
         case PriestSpellTypes::Sanctuary:
-            (void) monsterSleep(py.pos);
+            (void) monsterSleep(session->py.pos);
             break;
         case PriestSpellTypes::CreateFood:
             spellCreateFood();
             break;
         case PriestSpellTypes::RemoveCurse:
-            for (auto &entry : py.inventory) {
+            for (auto &entry : session->py.inventory) {
                 // only clear flag for items that are wielded or worn
                 if (entry.category_id >= TV_MIN_WEAR && entry.category_id <= TV_MAX_WEAR) {
                     inventoryItemRemoveCurse(entry);
@@ -134,15 +134,15 @@ static void playerRecitePrayer(int prayer_type) {
             }
             break;
         case PriestSpellTypes::ResistHeadCold:
-            py.flags.heat_resistance += randomNumber(10) + 10;
-            py.flags.cold_resistance += randomNumber(10) + 10;
+            session->py.flags.heat_resistance += randomNumber(10) + 10;
+            session->py.flags.cold_resistance += randomNumber(10) + 10;
             break;
         case PriestSpellTypes::NeutralizePoison:
             (void) playerCurePoison();
             break;
         case PriestSpellTypes::OrbOfDraining:
             if (getDirectionWithMemory(CNIL, dir)) {
-                spellFireBall(py.pos, dir, (diceRoll(Dice_t{3, 6}) + py.misc.level), MagicSpellFlags::HolyOrb, "Black Sphere");
+                spellFireBall(session->py.pos, dir, (diceRoll(Dice_t{3, 6}) + session->py.misc.level), MagicSpellFlags::HolyOrb, "Black Sphere");
             }
             break;
         case PriestSpellTypes::CureSeriousWounds:
@@ -170,13 +170,13 @@ static void playerRecitePrayer(int prayer_type) {
             playerBless(randomNumber(48) + 48);
             break;
         case PriestSpellTypes::DispelUndead:
-            (void) spellDispelCreature(config::monsters::defense::CD_UNDEAD, (3 * py.misc.level));
+            (void) spellDispelCreature(config::monsters::defense::CD_UNDEAD, (3 * session->py.misc.level));
             break;
         case PriestSpellTypes::Heal:
             (void) spellChangePlayerHitPoints(200);
             break;
         case PriestSpellTypes::DispelEvil:
-            (void) spellDispelCreature(config::monsters::defense::CD_EVIL, (3 * py.misc.level));
+            (void) spellDispelCreature(config::monsters::defense::CD_EVIL, (3 * session->py.misc.level));
             break;
         case PriestSpellTypes::GlyphOfWarding:
             spellWardingGlyph();
@@ -190,13 +190,13 @@ static void playerRecitePrayer(int prayer_type) {
                 (void) playerStatRestore(i);
             }
 
-            (void) spellDispelCreature(config::monsters::defense::CD_EVIL, (4 * py.misc.level));
+            (void) spellDispelCreature(config::monsters::defense::CD_EVIL, (4 * session->py.misc.level));
             (void) spellTurnUndead();
 
-            if (py.flags.invulnerability < 3) {
-                py.flags.invulnerability = 3;
+            if (session->py.flags.invulnerability < 3) {
+                session->py.flags.invulnerability = 3;
             } else {
-                py.flags.invulnerability++;
+                session->py.flags.invulnerability++;
             }
             break;
         default:
@@ -207,7 +207,7 @@ static void playerRecitePrayer(int prayer_type) {
 
 // Pray like HELL. -RAK-
 void pray() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
     int item_pos_begin, item_pos_end;
     if (!playerCanPray(item_pos_begin, item_pos_end)) {
@@ -229,43 +229,43 @@ void pray() {
         return;
     }
 
-    Spell_t const &spell = magic_spells[py.misc.class_id - 1][choice];
+    Spell_t const &spell = magic_spells[session->py.misc.class_id - 1][choice];
 
     // NOTE: at least one function called by `playerRecitePrayer()` sets `player_free_turn = true`,
     // e.g. `spellCreateFood()`, so this check is required. -MRC-
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
     if (randomNumber(100) < chance) {
         printMessage("You lost your concentration!");
     } else {
         playerRecitePrayer(choice);
 
-        if (!game.player_free_turn) {
-            if ((py.flags.spells_worked & (1L << choice)) == 0) {
-                py.misc.exp += spell.exp_gain_for_learning << 2;
+        if (!session->game.player_free_turn) {
+            if ((session->py.flags.spells_worked & (1L << choice)) == 0) {
+                session->py.misc.exp += spell.exp_gain_for_learning << 2;
                 displayCharacterExperience();
-                py.flags.spells_worked |= (1L << choice);
+                session->py.flags.spells_worked |= (1L << choice);
             }
         }
     }
 
-    if (game.player_free_turn) {
+    if (session->game.player_free_turn) {
         return;
     }
 
-    if (spell.mana_required > py.misc.current_mana) {
+    if (spell.mana_required > session->py.misc.current_mana) {
         printMessage("You faint from fatigue!");
 
-        py.flags.paralysis = (int16_t) randomNumber((5 * (spell.mana_required - py.misc.current_mana)));
-        py.misc.current_mana = 0;
-        py.misc.current_mana_fraction = 0;
+        session->py.flags.paralysis = (int16_t) randomNumber((5 * (spell.mana_required - session->py.misc.current_mana)));
+        session->py.misc.current_mana = 0;
+        session->py.misc.current_mana_fraction = 0;
 
         if (randomNumber(3) == 1) {
             printMessage("You have damaged your health!");
             (void) playerStatRandomDecrease(PlayerAttr::A_CON);
         }
     } else {
-        py.misc.current_mana -= spell.mana_required;
+        session->py.misc.current_mana -= spell.mana_required;
     }
 
     printCharacterCurrentMana();
@@ -152,12 +152,12 @@ static bool playerDrinkPotion(uint32_t flags, uint8_t item_type) {
                 }
                 break;
             case PotionSpellTypes::GainExperience:
-                if (py.misc.exp < config::player::PLAYER_MAX_EXP) {
-                    auto exp = (uint32_t)((py.misc.exp / 2) + 10);
+                if (session->py.misc.exp < config::player::PLAYER_MAX_EXP) {
+                    auto exp = (uint32_t)((session->py.misc.exp / 2) + 10);
                     if (exp > 100000L) {
                         exp = 100000L;
                     }
-                    py.misc.exp += exp;
+                    session->py.misc.exp += exp;
 
                     printMessage("You feel more experienced.");
                     displayCharacterExperience();
@@ -165,45 +165,45 @@ static bool playerDrinkPotion(uint32_t flags, uint8_t item_type) {
                 }
                 break;
             case PotionSpellTypes::Sleep:
-                if (!py.flags.free_action) {
+                if (!session->py.flags.free_action) {
                     // paralysis must == 0, otherwise could not drink potion
                     printMessage("You fall asleep.");
-                    py.flags.paralysis += randomNumber(4) + 4;
+                    session->py.flags.paralysis += randomNumber(4) + 4;
                     identified = true;
                 }
                 break;
             case PotionSpellTypes::Blindness:
-                if (py.flags.blind == 0) {
+                if (session->py.flags.blind == 0) {
                     printMessage("You are covered by a veil of darkness.");
                     identified = true;
                 }
-                py.flags.blind += randomNumber(100) + 100;
+                session->py.flags.blind += randomNumber(100) + 100;
                 break;
             case PotionSpellTypes::Confusion:
-                if (py.flags.confused == 0) {
+                if (session->py.flags.confused == 0) {
                     printMessage("Hey!  This is good stuff!  * Hick! *");
                     identified = true;
                 }
-                py.flags.confused += randomNumber(20) + 12;
+                session->py.flags.confused += randomNumber(20) + 12;
                 break;
             case PotionSpellTypes::Poison:
-                if (py.flags.poisoned == 0) {
+                if (session->py.flags.poisoned == 0) {
                     printMessage("You feel very sick.");
                     identified = true;
                 }
-                py.flags.poisoned += randomNumber(15) + 10;
+                session->py.flags.poisoned += randomNumber(15) + 10;
                 break;
             case PotionSpellTypes::HasteSelf:
-                if (py.flags.fast == 0) {
+                if (session->py.flags.fast == 0) {
                     identified = true;
                 }
-                py.flags.fast += randomNumber(25) + 15;
+                session->py.flags.fast += randomNumber(25) + 15;
                 break;
             case PotionSpellTypes::Slowness:
-                if (py.flags.slow == 0) {
+                if (session->py.flags.slow == 0) {
                     identified = true;
                 }
-                py.flags.slow += randomNumber(25) + 15;
+                session->py.flags.slow += randomNumber(25) + 15;
                 break;
             case PotionSpellTypes::Dexterity:
                 if (playerStatRandomIncrease(PlayerAttr::A_DEX)) {
@@ -234,17 +234,17 @@ static bool playerDrinkPotion(uint32_t flags, uint8_t item_type) {
                 break;
                 // case 33: break; // this is no longer useful, now that there is a 'G'ain magic spells command
             case PotionSpellTypes::LoseExperience:
-                if (py.misc.exp > 0) {
+                if (session->py.misc.exp > 0) {
                     printMessage("You feel your memories fade.");
 
                     // Lose between 1/5 and 2/5 of your experience
-                    int32_t exp = py.misc.exp / 5;
+                    int32_t exp = session->py.misc.exp / 5;
 
-                    if (py.misc.exp > SHRT_MAX) {
-                        auto scale = (int32_t)(INT_MAX / py.misc.exp);
-                        exp += (randomNumber((int) scale) * py.misc.exp) / (scale * 5);
+                    if (session->py.misc.exp > SHRT_MAX) {
+                        auto scale = (int32_t)(INT_MAX / session->py.misc.exp);
+                        exp += (randomNumber((int) scale) * session->py.misc.exp) / (scale * 5);
                     } else {
-                        exp += randomNumber((int) py.misc.exp) / 5;
+                        exp += randomNumber((int) session->py.misc.exp) / 5;
                     }
                     spellLoseEXP(exp);
                     identified = true;
@@ -252,31 +252,31 @@ static bool playerDrinkPotion(uint32_t flags, uint8_t item_type) {
                 break;
             case PotionSpellTypes::SaltWater:
                 (void) playerCurePoison();
-                if (py.flags.food > 150) {
-                    py.flags.food = 150;
+                if (session->py.flags.food > 150) {
+                    session->py.flags.food = 150;
                 }
-                py.flags.paralysis = 4;
+                session->py.flags.paralysis = 4;
 
                 printMessage("The potion makes you vomit!");
                 identified = true;
                 break;
             case PotionSpellTypes::Invulnerability:
-                if (py.flags.invulnerability == 0) {
+                if (session->py.flags.invulnerability == 0) {
                     identified = true;
                 }
-                py.flags.invulnerability += randomNumber(10) + 10;
+                session->py.flags.invulnerability += randomNumber(10) + 10;
                 break;
             case PotionSpellTypes::Heroism:
-                if (py.flags.heroism == 0) {
+                if (session->py.flags.heroism == 0) {
                     identified = true;
                 }
-                py.flags.heroism += randomNumber(25) + 25;
+                session->py.flags.heroism += randomNumber(25) + 25;
                 break;
             case PotionSpellTypes::SuperHeroism:
-                if (py.flags.super_heroism == 0) {
+                if (session->py.flags.super_heroism == 0) {
                     identified = true;
                 }
-                py.flags.super_heroism += randomNumber(25) + 25;
+                session->py.flags.super_heroism += randomNumber(25) + 25;
                 break;
             case PotionSpellTypes::Boldness:
                 identified = playerRemoveFear();
@@ -285,19 +285,19 @@ static bool playerDrinkPotion(uint32_t flags, uint8_t item_type) {
                 identified = spellRestorePlayerLevels();
                 break;
             case PotionSpellTypes::ResistHeat:
-                if (py.flags.heat_resistance == 0) {
+                if (session->py.flags.heat_resistance == 0) {
                     identified = true;
                 }
-                py.flags.heat_resistance += randomNumber(10) + 10;
+                session->py.flags.heat_resistance += randomNumber(10) + 10;
                 break;
             case PotionSpellTypes::ResistCold:
-                if (py.flags.cold_resistance == 0) {
+                if (session->py.flags.cold_resistance == 0) {
                     identified = true;
                 }
-                py.flags.cold_resistance += randomNumber(10) + 10;
+                session->py.flags.cold_resistance += randomNumber(10) + 10;
                 break;
             case PotionSpellTypes::DetectInvisible:
-                if (py.flags.detect_invisible == 0) {
+                if (session->py.flags.detect_invisible == 0) {
                     identified = true;
                 }
                 playerDetectInvisible(randomNumber(12) + 12);
@@ -309,19 +309,19 @@ static bool playerDrinkPotion(uint32_t flags, uint8_t item_type) {
                 identified = playerCurePoison();
                 break;
             case PotionSpellTypes::RestoreMana:
-                if (py.misc.current_mana < py.misc.mana) {
-                    py.misc.current_mana = py.misc.mana;
+                if (session->py.misc.current_mana < session->py.misc.mana) {
+                    session->py.misc.current_mana = session->py.misc.mana;
                     printMessage("Your feel your head clear.");
                     printCharacterCurrentMana();
                     identified = true;
                 }
                 break;
             case PotionSpellTypes::InfraVision:
-                if (py.flags.timed_infra == 0) {
+                if (session->py.flags.timed_infra == 0) {
                     printMessage("Your eyes begin to tingle.");
                     identified = true;
                 }
-                py.flags.timed_infra += 100 + randomNumber(100);
+                session->py.flags.timed_infra += 100 + randomNumber(100);
                 break;
             default:
                 // All cases are handled, so this should never be reached!
@@ -335,9 +335,9 @@ static bool playerDrinkPotion(uint32_t flags, uint8_t item_type) {
 
 // Potions for the quaffing -RAK-
 void quaff() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("But you are not carrying anything.");
         return;
     }
@@ -353,10 +353,10 @@ void quaff() {
         return;
     }
 
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
     bool identified;
-    Inventory_t *item = &py.inventory[item_id];
+    Inventory_t *item = &session->py.inventory[item_id];
 
     if (item->flags == 0) {
         printMessage("You feel less thirsty.");
@@ -368,11 +368,11 @@ void quaff() {
     if (identified) {
         if (!itemSetColorlessAsIdentified(item->category_id, item->sub_category_id, item->identification)) {
             // round half-way case up
-            py.misc.exp += (item->depth_first_found + (py.misc.level >> 1)) / py.misc.level;
+            session->py.misc.exp += (item->depth_first_found + (session->py.misc.level >> 1)) / session->py.misc.level;
             displayCharacterExperience();
 
-            itemIdentify(py.inventory[item_id], item_id);
-            item = &py.inventory[item_id];
+            itemIdentify(session->py.inventory[item_id], item_id);
+            item = &session->py.inventory[item_id];
         }
     } else if (!itemSetColorlessAsIdentified(item->category_id, item->sub_category_id, item->identification)) {
         itemSetAsTried(*item);
@@ -63,12 +63,22 @@
 //      #############
 //      #
 //
-// After any move, the function playerAreaAffect is called to determine the new
-// surroundings, and the direction of subsequent moves. It takes a location (at
-// which the runner has just arrived) and the previous direction (from which the
-// runner is considered to have come). Moving one square in some direction places
-// you adjacent to three or five new squares (for straight and diagonal moves) to
-// which you were not previously adjacent.
+// Where a run goes is worked out once, when it starts, and the player then
+// follows that path one step per game turn, so the monsters still get their
+// turns in between. The run stops early if the player is disturbed, or the
+// way ahead is no longer open.
+//
+// An enclosed run follows the corridor graph. Every open tile with exactly
+// two ways on, and no other open tile next to it except around a corner, is
+// a link. Links chain together into stretches of corridor, and the run
+// follows the chain to its end: onto a dead end, or up to the last link
+// before a junction or a room, where the choice can be seen. A run cuts the
+// corners of the corridor when run_cut_corners is set, and otherwise goes
+// the long way round.
+//
+// An open area run goes straight on. Moving one square in some direction
+// places you adjacent to three or five new squares (for straight and
+// diagonal moves) to which you were not previously adjacent.
 //
 //     ...!   ...        EG Moving from 1 to 2.
 //     .12!   .1.!      . means previously adjacent
@@ -82,38 +92,14 @@
 // find_break) You STOP if any of the newly adjacent squares do NOT seem to be
 // open and you are in an open area, and that side was previously entirely open.
 //
-// Corners: If you are not in the open (i.e. you are in a corridor) and there is
-// only one way to go in the new squares, then turn in that direction. If there
-// are more than two new ways to go, STOP. If there are two ways to go, and those
-// ways are separated by a square which does not seem to be open, then STOP.
-//
-// Otherwise, we have a potential corner. There are two new open squares, which
-// are also adjacent. One of the new squares is diagonally located, the other is
-// straight on (as in the diagram). We consider two more squares further out
-// (marked below as ?).
-//
-//        .X
-//       @.?
-//        #?
-//
-// If they are both seen to be closed, then it is seen that no benefit is gained
-// from moving straight. It is a known corner. To cut the corner, go diagonally,
-// otherwise go straight, but pretend you stepped diagonally into that next
-// location for a full view next time. Conversely, if one of the ? squares is not
-// seen to be closed, then there is a potential choice. We check to see whether
-// it is a potential corner or an intersection/room entrance. If the square two
-// spaces straight ahead, and the space marked with 'X' are both blank, then it
-// is a potential corner and enter if run_examine_corners is set, otherwise must stop
-// because it is not a corner.
+// In a corridor you also STOP next to a wall you can't see, as without a light
+// it might as well be an opening.
 
 // The cycle lists the directions in anticlockwise order, for over two complete
 // cycles. The chome array maps a direction on to its position in the cycle. -CJS-
 
 static int cycle[] = {1, 2, 3, 6, 9, 8, 7, 4, 1, 2, 3, 6, 9, 8, 7, 4, 1};
 static int chome[] = {-1, 8, 9, 10, 7, -1, 11, 6, 5, 4};
-static bool find_openarea, find_breakright, find_breakleft;
-static int find_prevdir;
-static int find_direction; // Keep a record of which way we are going.
 
 // Do we see a wall? Used in running. -CJS-
 static bool playerCanSeeDungeonWall(int dir, Coord_t coord) {
@@ -127,12 +113,6 @@ static bool playerCanSeeDungeonWall(int dir, Coord_t coord) {
     return c == '#' || c == '%';
 }
 
-// Do we see anything? Used in running. -CJS-
-static bool playerSeeNothing(int dir, Coord_t coord) {
-    // check to see if movement there possible
-    return playerMovePosition(dir, coord) && caveGetTileSymbol(coord) == ' ';
-}
-
 static void findRunningBreak(int dir, Coord_t coord) {
     bool deep_left = false;
     bool deep_right = false;
@@ -141,31 +121,31 @@ static void findRunningBreak(int dir, Coord_t coord) {
 
     int cycle_index = chome[dir];
 
-    if (playerCanSeeDungeonWall(cycle[cycle_index + 1], py.pos)) {
-        find_breakleft = true;
+    if (playerCanSeeDungeonWall(cycle[cycle_index + 1], session->py.pos)) {
+        session->find_breakleft = true;
         short_left = true;
     } else if (playerCanSeeDungeonWall(cycle[cycle_index + 1], coord)) {
-        find_breakleft = true;
+        session->find_breakleft = true;
         deep_left = true;
     }
 
-    if (playerCanSeeDungeonWall(cycle[cycle_index - 1], py.pos)) {
-        find_breakright = true;
+    if (playerCanSeeDungeonWall(cycle[cycle_index - 1], session->py.pos)) {
+        session->find_breakright = true;
         short_right = true;
     } else if (playerCanSeeDungeonWall(cycle[cycle_index - 1], coord)) {
-        find_breakright = true;
+        session->find_breakright = true;
         deep_right = true;
     }
 
-    if (find_breakleft && find_breakright) {
-        find_openarea = false;
+    if (session->find_breakleft && session->find_breakright) {
+        session->find_openarea = false;
 
         // a hack to allow angled corridor entry
         if ((dir & 1) != 0) {
             if (deep_left && !deep_right) {
-                find_prevdir = cycle[cycle_index - 1];
+                session->find_prevdir = cycle[cycle_index - 1];
             } else if (deep_right && !deep_left) {
-                find_prevdir = cycle[cycle_index + 1];
+                session->find_prevdir = cycle[cycle_index + 1];
             }
         } else if (playerCanSeeDungeonWall(cycle[cycle_index], coord)) {
             // else if there is a wall two spaces ahead and seem to be in a
@@ -173,239 +153,363 @@ static void findRunningBreak(int dir, Coord_t coord) {
             // be moving straight into a corridor here
 
             if (short_left && !short_right) {
-                find_prevdir = cycle[cycle_index - 2];
+                session->find_prevdir = cycle[cycle_index - 2];
             } else if (short_right && !short_left) {
-                find_prevdir = cycle[cycle_index + 2];
+                session->find_prevdir = cycle[cycle_index + 2];
             }
         }
     } else {
-        find_openarea = true;
+        session->find_openarea = true;
     }
 }
 
-void playerFindInitialize(int direction) {
-    Coord_t coord = py.pos;
+// Bits of run_corridors[][]: which of the orthogonal neighbours of an open
+// tile are open too, and whether the tile is a link of the corridor graph.
+constexpr uint8_t RUN_LINK = 1u << 7u;
 
-    if (!playerMovePosition(direction, coord)) {
-        py.running_tracker = 0;
-    } else {
-        py.running_tracker = 1;
+// The orthogonal directions, by their bit in run_corridors[][]
+static constexpr int run_exits[4] = {8, 4, 6, 2};
 
-        find_direction = direction;
-        find_prevdir = direction;
+static bool runTileOpen(int y, int x) {
+    return session->dg.floor[y][x].feature_id <= MAX_OPEN_SPACE;
+}
 
-        find_breakright = false;
-        find_breakleft = false;
+// Works out the corridor graph bits of a tile from the tiles around it
+static uint8_t runCorridorBits(int y, int x) {
+    // The outer rows and columns of the map are walls
+    if (y < 1 || x < 1 || y >= session->dg.height - 1 || x >= session->dg.width - 1 || !runTileOpen(y, x)) {
+        return 0;
+    }
 
-        if (py.flags.blind < 1) {
-            findRunningBreak(direction, coord);
+    uint8_t bits = 0;
+    int exits = 0;
+
+    for (int i = 0; i < 4; i++) {
+        Coord_t spot = Coord_t{y, x};
+        (void) playerMovePosition(run_exits[i], spot);
+
+        if (runTileOpen(spot.y, spot.x)) {
+            bits |= (uint8_t)(1u << (unsigned) i);
+            exits++;
         }
     }
 
-    // We must erase the player symbol '@' here, because sub3_move_light()
-    // does not erase the previous location of the player when in find mode
-    // and when `run_print_self` is false.  The player symbol is not draw at all
-    // in this case while moving, so the only problem is on the first turn
-    // of find mode, when the initial position of the character must be erased.
-    // Hence we must do the erasure here.
-    if (!py.temporary_light_only && !config::options::run_print_self) {
-        panelPutTile(caveGetTileSymbol(py.pos), py.pos);
+    if (exits != 2) {
+        return bits;
     }
 
-    playerMove(direction, true);
+    // An open diagonal is only a corner of the corridor when it is
+    // next to one of the ways on, otherwise it is a way on of its own.
+    for (int dy = -1; dy <= 1; dy += 2) {
+        for (int dx = -1; dx <= 1; dx += 2) {
+            if (runTileOpen(y + dy, x + dx) && !runTileOpen(y + dy, x) && !runTileOpen(y, x + dx)) {
+                return bits;
+            }
+        }
+    }
+
+    return (uint8_t)(bits | RUN_LINK);
+}
 
-    if (py.running_tracker == 0) {
-        game.command_count = 0;
+// Builds the corridor graph of the level, when it is generated or loaded
+void playerRunFindCorridors() {
+    for (int y = 0; y < MAX_HEIGHT; y++) {
+        for (int x = 0; x < MAX_WIDTH; x++) {
+            session->run_corridors[y][x] = runCorridorBits(y, x);
+        }
     }
 }
 
-void playerRunAndFind() {
-    uint8_t tracker = py.running_tracker;
+// Updates the corridor graph after the feature of a tile has changed,
+// as it may change whether the tiles around it are links.
+void playerRunTileChanged(Coord_t const &coord) {
+    for (int y = coord.y - 1; y <= coord.y + 1; y++) {
+        for (int x = coord.x - 1; x <= coord.x + 1; x++) {
+            if (y >= 0 && x >= 0 && y < MAX_HEIGHT && x < MAX_WIDTH) {
+                session->run_corridors[y][x] = runCorridorBits(y, x);
+            }
+        }
+    }
+}
 
-    py.running_tracker++;
+// The direction of a step between two adjacent tiles
+static int runStepDirection(Coord_t const &from, Coord_t const &to) {
+    return (1 - (to.y - from.y)) * 3 + (to.x - from.x) + 2;
+}
 
-    // prevent infinite loops in find mode, will stop after moving 100 times
-    if (tracker > 100) {
-        printMessage("You stop running to catch your breath.");
-        playerEndRunning();
-        return;
-    }
+static bool runTilesAdjacent(Coord_t const &a, Coord_t const &b) {
+    return std::abs(a.y - b.y) <= 1 && std::abs(a.x - b.x) <= 1;
+}
 
-    playerMove(find_direction, true);
+// Can the player see a tile when next to it?
+static bool runTileSeen(TileConstRef_t tile) {
+    return session->py.carrying_light || tile.temporary_light || tile.permanent_light || tile.field_mark;
 }
 
-// Switch off the run flag - and get the light correct. -CJS-
-void playerEndRunning() {
-    if (py.running_tracker == 0) {
-        return;
-    }
+// Is there something on a tile which should stop a run?
+static bool runTileInteresting(TileConstRef_t tile) {
+    if (tile.treasure_id != 0) {
+        int tile_id = session->game.treasure.list[tile.treasure_id].category_id;
 
-    py.running_tracker = 0;
+        if (tile_id != TV_INVIS_TRAP && tile_id != TV_SECRET_DOOR && (tile_id != TV_OPEN_DOOR || !session->options.run_ignore_doors)) {
+            return true;
+        }
+    }
 
-    dungeonMoveCharacterLight(py.pos, py.pos);
+    // The monster should be visible since monsterUpdateVisibility() checks
+    // for the special case of being in find mode
+    return tile.creature_id > 1 && session->monsters[tile.creature_id].lit;
 }
 
-static bool areaAffectStopLookingAtSquares(int i, int dir, int new_dir, Coord_t coord, int &check_dir, int &dir_a, int &dir_b) {
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
-
-    // Default: Square unseen. Treat as open.
-    bool invisible = true;
+// Looks at the squares newly next to the runner after a step, to see
+// whether the run should stop there. -CJS-
+static bool runStopsAt(Coord_t const &coord, int direction) {
+    int max = (direction & 1) + 1;
 
-    if (py.carrying_light || tile.temporary_light || tile.permanent_light || tile.field_mark) {
-        if (tile.treasure_id != 0) {
-            int tile_id = game.treasure.list[tile.treasure_id].category_id;
+    for (int i = -max; i <= max; i++) {
+        Coord_t spot = coord;
 
-            if (tile_id != TV_INVIS_TRAP && tile_id != TV_SECRET_DOOR && (tile_id != TV_OPEN_DOOR || !config::options::run_ignore_doors)) {
-                playerEndRunning();
-                return true;
-            }
+        if (!playerMovePosition(cycle[chome[direction] + i], spot)) {
+            continue;
         }
 
-        // Also Creatures
-        // The monster should be visible since monsterUpdateVisibility() checks
-        // for the special case of being in find mode
-        if (tile.creature_id > 1 && monsters[tile.creature_id].lit) {
-            playerEndRunning();
+        TileConstRef_t tile = session->dg.floor[spot.y][spot.x];
+
+        bool seen = runTileSeen(tile);
+
+        if (seen && runTileInteresting(tile)) {
             return true;
         }
 
-        invisible = false;
-    }
+        // Default: square unseen, treat as open
+        bool open = tile.feature_id <= MAX_OPEN_SPACE || !seen;
 
-    if (tile.feature_id <= MAX_OPEN_SPACE || invisible) {
-        if (find_openarea) {
-            // Have we found a break?
-            if (i < 0) {
-                if (find_breakright) {
-                    playerEndRunning();
-                    return true;
-                }
-            } else if (i > 0) {
-                if (find_breakleft) {
-                    playerEndRunning();
-                    return true;
-                }
+        if (!session->find_openarea) {
+            // A wall which can't be seen might be an opening
+            if (!seen) {
+                return true;
             }
-        } else if (dir_a == 0) {
-            // The first new direction.
-            dir_a = new_dir;
-        } else if (dir_b != 0) {
-            // Three new directions. STOP.
-            playerEndRunning();
-            return true;
-        } else if (dir_a != cycle[chome[dir] + i - 1]) {
-            // If not adjacent to prev, STOP
-            playerEndRunning();
-            return true;
-        } else {
-            // Two adjacent choices. Make dir_b the diagonal, and
-            // remember the other diagonal adjacent to the first option.
-            if ((new_dir & 1) == 1) {
-                check_dir = cycle[chome[dir] + i - 2];
-                dir_b = new_dir;
-            } else {
-                check_dir = cycle[chome[dir] + i + 1];
-                dir_b = dir_a;
-                dir_a = new_dir;
+        } else if (open) {
+            // Have we found a break?
+            if ((i < 0 && session->find_breakright) || (i > 0 && session->find_breakleft)) {
+                return true;
             }
-        }
-    } else if (find_openarea) {
-        // We see an obstacle. In open area, STOP if on a side previously open.
-        if (i < 0) {
-            if (find_breakleft) {
-                playerEndRunning();
+        } else if (i < 0) {
+            // We see an obstacle. In open area, STOP if on a side previously open.
+            if (session->find_breakleft) {
                 return true;
             }
-            find_breakright = true;
+            session->find_breakright = true;
         } else if (i > 0) {
-            if (find_breakright) {
-                playerEndRunning();
+            if (session->find_breakright) {
                 return true;
             }
-            find_breakleft = true;
+            session->find_breakleft = true;
         }
     }
 
     return false;
 }
 
-// Determine the next direction for a run, or if we should stop. -CJS-
-void playerAreaAffect(int direction, Coord_t coord) {
-    if (py.flags.blind >= 1) {
-        return;
-    }
+static void runPathAdd(Coord_t const &coord) {
+    session->run_path[session->run_path_count++] = coord;
+}
+
+// The way on from a link, coming from the given tile. When it was entered
+// diagonally, the way on is the exit not next to where it came from.
+static bool runLinkNext(Coord_t const &link, Coord_t const &from, Coord_t &next) {
+    bool diagonal = from.y != link.y && from.x != link.x;
+    bool found = false;
 
-    int check_dir = 0;
-    int dir_a = 0;
-    int dir_b = 0;
+    for (int i = 0; i < 4; i++) {
+        if ((session->run_corridors[link.y][link.x] & (1u << (unsigned) i)) == 0) {
+            continue;
+        }
 
-    direction = find_prevdir;
+        Coord_t exit = link;
+        (void) playerMovePosition(run_exits[i], exit);
 
-    int max = (direction & 1) + 1;
+        if (diagonal ? runTilesAdjacent(exit, from) : exit.y == from.y && exit.x == from.x) {
+            continue;
+        }
 
-    Coord_t spot = Coord_t{0, 0};
+        if (found) {
+            return false;
+        }
 
-    // Look at every newly adjacent square.
-    for (int i = -max; i <= max; i++) {
-        int new_dir = cycle[chome[direction] + i];
+        next = exit;
+        found = true;
+    }
+
+    return found;
+}
+
+// Plans an enclosed run along a stretch of corridor, starting with the
+// step from `from` onto `coord`.
+static void runPlanCorridor(Coord_t from, Coord_t coord) {
+    while (true) {
+        runPathAdd(coord);
 
-        spot.y = coord.y;
-        spot.x = coord.x;
+        if (runStopsAt(coord, runStepDirection(from, coord))) {
+            return;
+        }
+
+        uint8_t bits = session->run_corridors[coord.y][coord.x];
+
+        if ((bits & RUN_LINK) == 0) {
+            // Stop on a dead end, or before a junction or a room, where the
+            // choice of ways on is in sight. Any first step is still taken.
+            if ((bits & (bits - 1)) != 0 && session->run_path_count > 1) {
+                session->run_path_count--;
+            }
+            return;
+        }
 
-        // Objects player can see (Including doors?) cause a stop.
-        if (playerMovePosition(new_dir, spot)) {
-            areaAffectStopLookingAtSquares(i, direction, new_dir, spot, check_dir, dir_a, dir_b);
+        Coord_t next = Coord_t{0, 0};
+        if (!runLinkNext(coord, from, next) || (next.y == session->run_path[0].y && next.x == session->run_path[0].x)) {
+            return;
         }
+
+        from = coord;
+        coord = next;
     }
+}
 
-    if (find_openarea) {
-        return;
+// Drops the corners of a planned corridor run, stepping diagonally across them
+static void runPlanCutCorners(Coord_t const &start) {
+    int count = 0;
+
+    for (int i = 0; i < session->run_path_count; i++) {
+        Coord_t const &before = count == 0 ? start : session->run_path[count - 1];
+
+        if (count > 0 && i + 1 < session->run_path_count && runTilesAdjacent(before, session->run_path[i + 1])) {
+            continue;
+        }
+
+        session->run_path[count++] = session->run_path[i];
     }
 
-    // choose a direction.
+    session->run_path_count = count;
+}
+
+// Plans a run going straight on, starting with the step onto `coord`. A
+// blind player can't see anything to stop for, and runs into a wall.
+static void runPlanStraight(Coord_t coord) {
+    int direction = session->find_direction;
+
+    while (session->run_path_count < MAX_HEIGHT * MAX_WIDTH) {
+        runPathAdd(coord);
 
-    if (dir_b == 0 || (config::options::run_examine_corners && !config::options::run_cut_corners)) {
-        // There is only one option, or if two, then we always examine
-        // potential corners and never cur known corners, so you step
-        // into the straight option.
-        if (dir_a != 0) {
-            find_direction = dir_a;
+        if (session->py.flags.blind < 1 && runStopsAt(coord, session->find_prevdir)) {
+            return;
         }
 
-        if (dir_b == 0) {
-            find_prevdir = dir_a;
-        } else {
-            find_prevdir = dir_b;
+        if (!playerMovePosition(direction, coord) || !runTileOpen(coord.y, coord.x)) {
+            return;
         }
+    }
+}
 
+// Works out where a run goes, before its first step
+static void runPlan(Coord_t const &start, Coord_t const &coord) {
+    session->run_path_count = 0;
+    session->run_path_next = 0;
+
+    if (session->py.flags.blind >= 1 || session->find_openarea || !runTileOpen(coord.y, coord.x)) {
+        runPlanStraight(coord);
         return;
     }
 
-    // Two options!
-
-    Coord_t location = Coord_t{coord.y, coord.x};
-    (void) playerMovePosition(dir_a, location);
-
-    if (!playerCanSeeDungeonWall(dir_a, location) || !playerCanSeeDungeonWall(check_dir, location)) {
-        // Don't see that it is closed off.  This could be a
-        // potential corner or an intersection.
-        if (config::options::run_examine_corners && playerSeeNothing(dir_a, location) && playerSeeNothing(dir_b, location)) {
-            // Can not see anything ahead and in the direction we are
-            // turning, assume that it is a potential corner.
-            find_direction = dir_a;
-            find_prevdir = dir_b;
-        } else {
-            // STOP: we are next to an intersection or a room
-            playerEndRunning();
-        }
-    } else if (config::options::run_cut_corners) {
-        // This corner is seen to be enclosed; we cut the corner.
-        find_direction = dir_b;
-        find_prevdir = dir_b;
+    runPlanCorridor(start, coord);
+
+    if (session->options.run_cut_corners) {
+        runPlanCutCorners(start);
+    }
+}
+
+void playerFindInitialize(int direction) {
+    Coord_t coord = session->py.pos;
+
+    playerTravelCancel();
+
+    if (!playerMovePosition(direction, coord)) {
+        session->py.running_tracker = 0;
     } else {
-        // This corner is seen to be enclosed, and we deliberately
-        // go the long way.
-        find_direction = dir_a;
-        find_prevdir = dir_b;
+        session->py.running_tracker = 1;
+
+        session->find_direction = direction;
+        session->find_prevdir = direction;
+
+        session->find_openarea = true;
+        session->find_breakright = false;
+        session->find_breakleft = false;
+
+        if (session->py.flags.blind < 1) {
+            findRunningBreak(direction, coord);
+        }
+
+        runPlan(session->py.pos, coord);
     }
+
+    // We must erase the player symbol '@' here, because sub3_move_light()
+    // does not erase the previous location of the player when in find mode
+    // and when `run_print_self` is false.  The player symbol is not draw at all
+    // in this case while moving, so the only problem is on the first turn
+    // of find mode, when the initial position of the character must be erased.
+    // Hence we must do the erasure here.
+    if (!session->py.temporary_light_only && !session->options.run_print_self) {
+        panelPutTile(caveGetTileSymbol(session->py.pos), session->py.pos);
+    }
+
+    if (session->py.running_tracker == 0) {
+        playerMove(direction, true);
+        session->game.command_count = 0;
+        return;
+    }
+
+    playerRunAndFind();
+
+    if (session->py.running_tracker == 0) {
+        session->game.command_count = 0;
+    }
+}
+
+// Takes the next step of the run, or the travel
+void playerRunAndFind() {
+    // Travelling has its own way of choosing where to go next
+    if (playerTravelling()) {
+        playerTravelStep();
+        return;
+    }
+
+    if (session->run_path_next >= session->run_path_count) {
+        playerEndRunning();
+        return;
+    }
+
+    Coord_t next = session->run_path[session->run_path_next++];
+
+    if (!runTilesAdjacent(session->py.pos, next) || (next.y == session->py.pos.y && next.x == session->py.pos.x)) {
+        playerEndRunning();
+        return;
+    }
+
+    playerMove(runStepDirection(session->py.pos, next), true);
+
+    // Stop at the end of the path, or when the step didn't go as planned,
+    // e.g. a door was closed in the way
+    if (session->run_path_next == session->run_path_count || session->py.pos.y != next.y || session->py.pos.x != next.x) {
+        playerEndRunning();
+    }
+}
+
+// Switch off the run flag - and get the light correct. -CJS-
+void playerEndRunning() {
+    if (session->py.running_tracker == 0) {
+        return;
+    }
+
+    session->py.running_tracker = 0;
+
+    dungeonMoveCharacterLight(session->py.pos, session->py.pos);
 }
@@ -16,38 +16,38 @@ void playerInitializeBaseExperienceLevels() {
     };
 
     for (auto i = 0; i < PLAYER_MAX_LEVEL; i++) {
-        py.base_exp_levels[i] = levels[i];
+        session->py.base_exp_levels[i] = levels[i];
     }
 }
 
 // Calculate the players hit points
 void playerCalculateHitPoints() {
-    int hp = py.base_hp_levels[py.misc.level - 1] + (playerStatAdjustmentConstitution() * py.misc.level);
+    int hp = session->py.base_hp_levels[session->py.misc.level - 1] + (playerStatAdjustmentConstitution() * session->py.misc.level);
 
     // Always give at least one point per level + 1
-    if (hp < (py.misc.level + 1)) {
-        hp = py.misc.level + 1;
+    if (hp < (session->py.misc.level + 1)) {
+        hp = session->py.misc.level + 1;
     }
 
-    if ((py.flags.status & config::player::status::PY_HERO) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_HERO) != 0u) {
         hp += 10;
     }
 
-    if ((py.flags.status & config::player::status::PY_SHERO) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_SHERO) != 0u) {
         hp += 20;
     }
 
     // MHP can equal zero while character is being created
-    if (hp != py.misc.max_hp && py.misc.max_hp != 0) {
+    if (hp != session->py.misc.max_hp && session->py.misc.max_hp != 0) {
         // Change current hit points proportionately to change of MHP,
         // divide first to avoid overflow, little loss of accuracy
-        int32_t value = (((int32_t) py.misc.current_hp << 16) + py.misc.current_hp_fraction) / py.misc.max_hp * hp;
-        py.misc.current_hp = (int16_t)(value >> 16);
-        py.misc.current_hp_fraction = (uint16_t)(value & 0xFFFF);
-        py.misc.max_hp = (int16_t) hp;
+        int32_t value = (((int32_t) session->py.misc.current_hp << 16) + session->py.misc.current_hp_fraction) / session->py.misc.max_hp * hp;
+        session->py.misc.current_hp = (int16_t)(value >> 16);
+        session->py.misc.current_hp_fraction = (uint16_t)(value & 0xFFFF);
+        session->py.misc.max_hp = (int16_t) hp;
 
         // can't print hit points here, may be in store or inventory mode
-        py.flags.status |= config::player::status::PY_HP;
+        session->py.flags.status |= config::player::status::PY_HP;
     }
 }
 
@@ -99,14 +99,14 @@ static int playerAttackBlowsStrength(int strength, int weight) {
 int playerAttackBlows(int weight, int &weight_to_hit) {
     weight_to_hit = 0;
 
-    int player_strength = py.stats.used[PlayerAttr::A_STR];
+    int player_strength = session->py.stats.used[PlayerAttr::A_STR];
 
     if (player_strength * 15 < weight) {
         weight_to_hit = player_strength * 15 - weight;
         return 1;
     }
 
-    int dexterity = playerAttackBlowsDexterity(py.stats.used[PlayerAttr::A_DEX]);
+    int dexterity = playerAttackBlowsDexterity(session->py.stats.used[PlayerAttr::A_DEX]);
     int strength = playerAttackBlowsStrength(player_strength, weight);
 
     return (int) blows_table[strength][dexterity];
@@ -114,7 +114,7 @@ int playerAttackBlows(int weight, int &weight_to_hit) {
 
 // Adjustment for wisdom/intelligence -JWT-
 int playerStatAdjustmentWisdomIntelligence(int stat) {
-    int value = py.stats.used[stat];
+    int value = session->py.stats.used[stat];
 
     int adjustment;
 
@@ -142,7 +142,7 @@ int playerStatAdjustmentWisdomIntelligence(int stat) {
 // Adjustment for charisma -RAK-
 // Percent decrease or increase in price of goods
 int playerStatAdjustmentCharisma() {
-    int charisma = py.stats.used[PlayerAttr::A_CHR];
+    int charisma = session->py.stats.used[PlayerAttr::A_CHR];
 
     if (charisma > 117) {
         return 90;
@@ -204,7 +204,7 @@ int playerStatAdjustmentCharisma() {
 
 // Returns a character's adjustment to hit points -JWT-
 int playerStatAdjustmentConstitution() {
-    int con = py.stats.used[PlayerAttr::A_CON];
+    int con = session->py.stats.used[PlayerAttr::A_CON];
 
     if (con < 7) {
         return (con - 7);
@@ -230,7 +230,7 @@ int playerStatAdjustmentConstitution() {
 }
 
 static uint8_t playerModifyStat(int stat, int16_t amount) {
-    uint8_t new_stat = py.stats.current[stat];
+    uint8_t new_stat = session->py.stats.current[stat];
 
     int loop = (amount < 0 ? -amount : amount);
 
@@ -259,17 +259,17 @@ static uint8_t playerModifyStat(int stat, int16_t amount) {
 
 // Set the value of the stat which is actually used. -CJS-
 void playerSetAndUseStat(int stat) {
-    py.stats.used[stat] = playerModifyStat(stat, py.stats.modified[stat]);
+    session->py.stats.used[stat] = playerModifyStat(stat, session->py.stats.modified[stat]);
 
     if (stat == PlayerAttr::A_STR) {
-        py.flags.status |= config::player::status::PY_STR_WGT;
+        session->py.flags.status |= config::player::status::PY_STR_WGT;
         playerRecalculateBonuses();
     } else if (stat == PlayerAttr::A_DEX) {
         playerRecalculateBonuses();
-    } else if (stat == PlayerAttr::A_INT && classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+    } else if (stat == PlayerAttr::A_INT && classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
         playerCalculateAllowedSpellsCount(PlayerAttr::A_INT);
         playerGainMana(PlayerAttr::A_INT);
-    } else if (stat == PlayerAttr::A_WIS && classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
+    } else if (stat == PlayerAttr::A_WIS && classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
         playerCalculateAllowedSpellsCount(PlayerAttr::A_WIS);
         playerGainMana(PlayerAttr::A_WIS);
     } else if (stat == PlayerAttr::A_CON) {
@@ -279,7 +279,7 @@ void playerSetAndUseStat(int stat) {
 
 // Increases a stat by one randomized level -RAK-
 bool playerStatRandomIncrease(int stat) {
-    int new_stat = py.stats.current[stat];
+    int new_stat = session->py.stats.current[stat];
 
     if (new_stat >= 118) {
         return false;
@@ -294,10 +294,10 @@ bool playerStatRandomIncrease(int stat) {
         new_stat++;
     }
 
-    py.stats.current[stat] = (uint8_t) new_stat;
+    session->py.stats.current[stat] = (uint8_t) new_stat;
 
-    if (new_stat > py.stats.max[stat]) {
-        py.stats.max[stat] = (uint8_t) new_stat;
+    if (new_stat > session->py.stats.max[stat]) {
+        session->py.stats.max[stat] = (uint8_t) new_stat;
     }
 
     playerSetAndUseStat(stat);
@@ -308,7 +308,7 @@ bool playerStatRandomIncrease(int stat) {
 
 // Decreases a stat by one randomized level -RAK-
 bool playerStatRandomDecrease(int stat) {
-    int new_stat = py.stats.current[stat];
+    int new_stat = session->py.stats.current[stat];
 
     if (new_stat <= 3) {
         return false;
@@ -325,7 +325,7 @@ bool playerStatRandomDecrease(int stat) {
         new_stat--;
     }
 
-    py.stats.current[stat] = (uint8_t) new_stat;
+    session->py.stats.current[stat] = (uint8_t) new_stat;
 
     playerSetAndUseStat(stat);
     displayCharacterStats(stat);
@@ -335,13 +335,13 @@ bool playerStatRandomDecrease(int stat) {
 
 // Restore a stat.  Return true only if this actually makes a difference.
 bool playerStatRestore(int stat) {
-    int new_stat = py.stats.max[stat] - py.stats.current[stat];
+    int new_stat = session->py.stats.max[stat] - session->py.stats.current[stat];
 
     if (new_stat == 0) {
         return false;
     }
 
-    py.stats.current[stat] += new_stat;
+    session->py.stats.current[stat] += new_stat;
 
     playerSetAndUseStat(stat);
     displayCharacterStats(stat);
@@ -352,21 +352,21 @@ bool playerStatRestore(int stat) {
 // Boost a stat artificially (by wearing something). If the display
 // argument is true, then increase is shown on the screen.
 void playerStatBoost(int stat, int amount) {
-    py.stats.modified[stat] += amount;
+    session->py.stats.modified[stat] += amount;
 
     playerSetAndUseStat(stat);
 
     // can not call displayCharacterStats() here:
     //   might be in a store,
     //   might be in inventoryExecuteCommand()
-    py.flags.status |= (config::player::status::PY_STR << stat);
+    session->py.flags.status |= (config::player::status::PY_STR << stat);
 }
 
 // Returns a character's adjustment to hit. -JWT-
 int16_t playerToHitAdjustment() {
     int16_t total;
 
-    int dexterity = py.stats.used[PlayerAttr::A_DEX];
+    int dexterity = session->py.stats.used[PlayerAttr::A_DEX];
     if (dexterity < 4) {
         total = -3;
     } else if (dexterity < 6) {
@@ -387,7 +387,7 @@ int16_t playerToHitAdjustment() {
         total = 5;
     }
 
-    int strength = py.stats.used[PlayerAttr::A_STR];
+    int strength = session->py.stats.used[PlayerAttr::A_STR];
     if (strength < 4) {
         total -= 3;
     } else if (strength < 5) {
@@ -411,7 +411,7 @@ int16_t playerToHitAdjustment() {
 
 // Returns a character's adjustment to armor class -JWT-
 int16_t playerArmorClassAdjustment() {
-    int stat = py.stats.used[PlayerAttr::A_DEX];
+    int stat = session->py.stats.used[PlayerAttr::A_DEX];
 
     int16_t adjustment;
 
@@ -442,7 +442,7 @@ int16_t playerArmorClassAdjustment() {
 
 // Returns a character's adjustment to disarm -RAK-
 int16_t playerDisarmAdjustment() {
-    auto stat = py.stats.used[PlayerAttr::A_DEX];
+    auto stat = session->py.stats.used[PlayerAttr::A_DEX];
 
     int16_t adjustment = 0;
 
@@ -477,7 +477,7 @@ int16_t playerDisarmAdjustment() {
 
 // Returns a character's adjustment to damage -JWT-
 int16_t playerDamageAdjustment() {
-    int stat = py.stats.used[PlayerAttr::A_STR];
+    int stat = session->py.stats.used[PlayerAttr::A_STR];
 
     int16_t adjustment;
 
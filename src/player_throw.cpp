@@ -8,15 +8,15 @@
 #include "headers.h"
 
 static void inventoryThrow(int item_id, Inventory_t *treasure) {
-    Inventory_t *item = &py.inventory[item_id];
+    Inventory_t *item = &session->py.inventory[item_id];
 
     *treasure = *item;
 
     if (item->items_count > 1) {
         treasure->items_count = 1;
         item->items_count--;
-        py.pack.weight -= item->weight;
-        py.flags.status |= config::player::status::PY_STR_WGT;
+        session->py.pack.weight -= item->weight;
+        session->py.flags.status |= config::player::status::PY_STR_WGT;
     } else {
         inventoryDestroyItem(item_id);
     }
@@ -31,15 +31,15 @@ static void weaponMissileFacts(Inventory_t &item, int &base_to_hit, int &plus_to
 
     // Throwing objects
     damage = diceRoll(item.damage) + item.to_damage;
-    base_to_hit = py.misc.bth_with_bows * 75 / 100;
-    plus_to_hit = py.misc.plusses_to_hit + item.to_hit;
+    base_to_hit = session->py.misc.bth_with_bows * 75 / 100;
+    plus_to_hit = session->py.misc.plusses_to_hit + item.to_hit;
 
     // Add this back later if the correct throwing device. -CJS-
-    if (py.inventory[PlayerEquipment::Wield].category_id != TV_NOTHING) {
-        plus_to_hit -= py.inventory[PlayerEquipment::Wield].to_hit;
+    if (session->py.inventory[PlayerEquipment::Wield].category_id != TV_NOTHING) {
+        plus_to_hit -= session->py.inventory[PlayerEquipment::Wield].to_hit;
     }
 
-    distance = ((py.stats.used[PlayerAttr::A_STR] + 20) * 10) / weight;
+    distance = ((session->py.stats.used[PlayerAttr::A_STR] + 20) * 10) / weight;
     if (distance > 10) {
         distance = 10;
     }
@@ -48,61 +48,61 @@ static void weaponMissileFacts(Inventory_t &item, int &base_to_hit, int &plus_to
     // missile/weapon combo, this makes them much more useful
 
     // Using Bows, slings, or crossbows?
-    if (py.inventory[PlayerEquipment::Wield].category_id != TV_BOW) {
+    if (session->py.inventory[PlayerEquipment::Wield].category_id != TV_BOW) {
         return;
     }
 
-    switch (py.inventory[PlayerEquipment::Wield].misc_use) {
+    switch (session->py.inventory[PlayerEquipment::Wield].misc_use) {
         case 1:
             if (item.category_id == TV_SLING_AMMO) { // Sling and ammo
-                base_to_hit = py.misc.bth_with_bows;
-                plus_to_hit += 2 * py.inventory[PlayerEquipment::Wield].to_hit;
-                damage += py.inventory[PlayerEquipment::Wield].to_damage;
+                base_to_hit = session->py.misc.bth_with_bows;
+                plus_to_hit += 2 * session->py.inventory[PlayerEquipment::Wield].to_hit;
+                damage += session->py.inventory[PlayerEquipment::Wield].to_damage;
                 damage = damage * 2;
                 distance = 20;
             }
             break;
         case 2:
             if (item.category_id == TV_ARROW) { // Short Bow and Arrow
-                base_to_hit = py.misc.bth_with_bows;
-                plus_to_hit += 2 * py.inventory[PlayerEquipment::Wield].to_hit;
-                damage += py.inventory[PlayerEquipment::Wield].to_damage;
+                base_to_hit = session->py.misc.bth_with_bows;
+                plus_to_hit += 2 * session->py.inventory[PlayerEquipment::Wield].to_hit;
+                damage += session->py.inventory[PlayerEquipment::Wield].to_damage;
                 damage = damage * 2;
                 distance = 25;
             }
             break;
         case 3:
             if (item.category_id == TV_ARROW) { // Long Bow and Arrow
-                base_to_hit = py.misc.bth_with_bows;
-                plus_to_hit += 2 * py.inventory[PlayerEquipment::Wield].to_hit;
-                damage += py.inventory[PlayerEquipment::Wield].to_damage;
+                base_to_hit = session->py.misc.bth_with_bows;
+                plus_to_hit += 2 * session->py.inventory[PlayerEquipment::Wield].to_hit;
+                damage += session->py.inventory[PlayerEquipment::Wield].to_damage;
                 damage = damage * 3;
                 distance = 30;
             }
             break;
         case 4:
             if (item.category_id == TV_ARROW) { // Composite Bow and Arrow
-                base_to_hit = py.misc.bth_with_bows;
-                plus_to_hit += 2 * py.inventory[PlayerEquipment::Wield].to_hit;
-                damage += py.inventory[PlayerEquipment::Wield].to_damage;
+                base_to_hit = session->py.misc.bth_with_bows;
+                plus_to_hit += 2 * session->py.inventory[PlayerEquipment::Wield].to_hit;
+                damage += session->py.inventory[PlayerEquipment::Wield].to_damage;
                 damage = damage * 4;
                 distance = 35;
             }
             break;
         case 5:
             if (item.category_id == TV_BOLT) { // Light Crossbow and Bolt
-                base_to_hit = py.misc.bth_with_bows;
-                plus_to_hit += 2 * py.inventory[PlayerEquipment::Wield].to_hit;
-                damage += py.inventory[PlayerEquipment::Wield].to_damage;
+                base_to_hit = session->py.misc.bth_with_bows;
+                plus_to_hit += 2 * session->py.inventory[PlayerEquipment::Wield].to_hit;
+                damage += session->py.inventory[PlayerEquipment::Wield].to_damage;
                 damage = damage * 3;
                 distance = 25;
             }
             break;
         case 6:
             if (item.category_id == TV_BOLT) { // Heavy Crossbow and Bolt
-                base_to_hit = py.misc.bth_with_bows;
-                plus_to_hit += 2 * py.inventory[PlayerEquipment::Wield].to_hit;
-                damage += py.inventory[PlayerEquipment::Wield].to_damage;
+                base_to_hit = session->py.misc.bth_with_bows;
+                plus_to_hit += 2 * session->py.inventory[PlayerEquipment::Wield].to_hit;
+                damage += session->py.inventory[PlayerEquipment::Wield].to_damage;
                 damage = damage * 4;
                 distance = 35;
             }
@@ -121,7 +121,7 @@ static void inventoryDropOrThrowItem(Coord_t coord, Inventory_t *item) {
     if (randomNumber(10) > 1) {
         for (int k = 0; !flag && k <= 9;) {
             if (coordInBounds(position)) {
-                if (dg.floor[position.y][position.x].feature_id <= MAX_OPEN_SPACE && dg.floor[position.y][position.x].treasure_id == 0) {
+                if (session->dg.floor[position.y][position.x].feature_id <= MAX_OPEN_SPACE && session->dg.floor[position.y][position.x].treasure_id == 0) {
                     flag = true;
                 }
             }
@@ -136,8 +136,8 @@ static void inventoryDropOrThrowItem(Coord_t coord, Inventory_t *item) {
 
     if (flag) {
         int cur_pos = popt();
-        dg.floor[position.y][position.x].treasure_id = (uint8_t) cur_pos;
-        game.treasure.list[cur_pos] = *item;
+        session->dg.floor[position.y][position.x].treasure_id = (uint8_t) cur_pos;
+        session->game.treasure.list[cur_pos] = *item;
         dungeonLiteSpot(position);
     } else {
         obj_desc_t description = {'\0'};
@@ -154,14 +154,14 @@ static void inventoryDropOrThrowItem(Coord_t coord, Inventory_t *item) {
 // Note: Extra damage and chance of hitting when missiles are used
 // with correct weapon. i.e. wield bow and throw arrow.
 void playerThrowItem() {
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("But you are not carrying anything.");
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
         return;
     }
 
     int item_id;
-    if (!inventoryGetInputForItemId(item_id, "Fire/Throw which one?", 0, py.pack.unique_items - 1, CNIL, CNIL)) {
+    if (!inventoryGetInputForItemId(item_id, "Fire/Throw which one?", 0, session->py.pack.unique_items - 1, CNIL, CNIL)) {
         return;
     }
 
@@ -172,7 +172,7 @@ void playerThrowItem() {
 
     itemTypeRemainingCountDescription(item_id);
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are confused.");
         dir = getRandomDirection();
     }
@@ -187,8 +187,8 @@ void playerThrowItem() {
     bool visible;
     int current_distance = 0;
 
-    Coord_t coord = py.pos;
-    Coord_t old_coord = py.pos;
+    Coord_t coord = session->py.pos;
+    Coord_t old_coord = session->py.pos;
 
     bool flag = false;
 
@@ -201,13 +201,13 @@ void playerThrowItem() {
             flag = true;
         }
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (tile.feature_id <= MAX_OPEN_SPACE && !flag) {
             if (tile.creature_id > 1) {
                 flag = true;
 
-                Monster_t const &m_ptr = monsters[tile.creature_id];
+                Monster_t const &m_ptr = session->monsters[tile.creature_id];
 
                 tbth -= current_distance;
 
@@ -215,11 +215,11 @@ void playerThrowItem() {
                 // off most bonuses, and reduce bth_with_bows depending on distance.
                 if (!m_ptr.lit) {
                     tbth /= current_distance + 2;
-                    tbth -= py.misc.level * class_level_adj[py.misc.class_id][PlayerClassLevelAdj::BTHB] / 2;
+                    tbth -= session->py.misc.level * class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::BTHB] / 2;
                     tbth -= tpth * (BTH_PER_PLUS_TO_HIT_ADJUST - 1);
                 }
 
-                if (playerTestBeingHit(tbth, (int) py.misc.level, tpth, (int) creatures_list[m_ptr.creature_id].ac, PlayerClassLevelAdj::BTHB)) {
+                if (playerTestBeingHit(tbth, (int) session->py.misc.level, tpth, (int) creatures_list[m_ptr.creature_id].ac, PlayerClassLevelAdj::BTHB)) {
                     int damage = m_ptr.creature_id;
 
                     obj_desc_t description = {'\0'};
@@ -260,7 +260,7 @@ void playerThrowItem() {
             } else {
                 // do not test tile.field_mark here
 
-                if (coordInsidePanel(coord) && py.flags.blind < 1 && (tile.temporary_light || tile.permanent_light)) {
+                if (coordInsidePanel(coord) && session->py.flags.blind < 1 && (tile.temporary_light || tile.permanent_light)) {
                     panelPutTile(tile_char, coord);
                     putQIO(); // show object moving
                 }
@@ -8,21 +8,21 @@
 #include "headers.h"
 
 static int playerTrapDisarmAbility() {
-    int ability = py.misc.disarm;
+    int ability = session->py.misc.disarm;
     ability += 2;
     ability *= playerDisarmAdjustment();
     ability += playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT);
-    ability += class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DISARM] * py.misc.level / 3;
+    ability += class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DISARM] * session->py.misc.level / 3;
 
-    if (py.flags.blind > 0 || playerNoLight()) {
+    if (session->py.flags.blind > 0 || playerNoLight()) {
         ability = ability / 10;
     }
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         ability = ability / 10;
     }
 
-    if (py.flags.image > 0) {
+    if (session->py.flags.image > 0) {
         ability = ability / 10;
     }
 
@@ -30,17 +30,17 @@ static int playerTrapDisarmAbility() {
 }
 
 static void playerDisarmFloorTrap(Coord_t coord, int total, int level, int dir, int16_t misc_use) {
-    int confused = py.flags.confused;
+    int confused = session->py.flags.confused;
 
     if (total + 100 - level > randomNumber(100)) {
         printMessage("You have disarmed the trap.");
-        py.misc.exp += misc_use;
+        session->py.misc.exp += misc_use;
         (void) dungeonDeleteObject(coord);
 
         // make sure we move onto the trap even if confused
-        py.flags.confused = 0;
+        session->py.flags.confused = 0;
         playerMove(dir, false);
-        py.flags.confused = (int16_t) confused;
+        session->py.flags.confused = (int16_t) confused;
 
         displayCharacterExperience();
         return;
@@ -55,14 +55,14 @@ static void playerDisarmFloorTrap(Coord_t coord, int total, int level, int dir,
     printMessage("You set the trap off!");
 
     // make sure we move onto the trap even if confused
-    py.flags.confused = 0;
+    session->py.flags.confused = 0;
     playerMove(dir, false);
-    py.flags.confused += confused;
+    session->py.flags.confused += confused;
 }
 
 static void playerDisarmChestTrap(Coord_t coord, int total, Inventory_t &item) {
     if (!spellItemIdentified(item)) {
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
         printMessage("I don't see a trap.");
 
         return;
@@ -83,7 +83,7 @@ static void playerDisarmChestTrap(Coord_t coord, int total, Inventory_t &item) {
             printMessage("You have disarmed the chest.");
 
             spellItemIdentifyAndRemoveRandomInscription(item);
-            py.misc.exp += level;
+            session->py.misc.exp += level;
 
             displayCharacterExperience();
         } else if ((total > 5) && (randomNumber(total) > 5)) {
@@ -97,7 +97,7 @@ static void playerDisarmChestTrap(Coord_t coord, int total, Inventory_t &item) {
     }
 
     printMessage("The chest was not trapped.");
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 }
 
 // Disarms a trap -RAK-
@@ -107,20 +107,20 @@ void playerDisarmTrap() {
         return;
     }
 
-    Coord_t coord = py.pos;
+    Coord_t coord = session->py.pos;
     (void) playerMovePosition(dir, coord);
 
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
     bool no_disarm = false;
 
     if (tile.creature_id > 1 && tile.treasure_id != 0 &&
-        (game.treasure.list[tile.treasure_id].category_id == TV_VIS_TRAP || game.treasure.list[tile.treasure_id].category_id == TV_CHEST)) {
+        (session->game.treasure.list[tile.treasure_id].category_id == TV_VIS_TRAP || session->game.treasure.list[tile.treasure_id].category_id == TV_CHEST)) {
         objectBlockedByMonster(tile.creature_id);
     } else if (tile.treasure_id != 0) {
         int disarm_ability = playerTrapDisarmAbility();
 
-        Inventory_t &item = game.treasure.list[tile.treasure_id];
+        Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
         if (item.category_id == TV_VIS_TRAP) {
             playerDisarmFloorTrap(coord, disarm_ability, item.depth_first_found, dir, item.misc_use);
@@ -135,14 +135,14 @@ void playerDisarmTrap() {
 
     if (no_disarm) {
         printMessage("I do not see anything to disarm there.");
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
     }
 }
 
 static void chestLooseStrength() {
     printMessage("A small needle has pricked you!");
 
-    if (py.flags.sustain_str) {
+    if (session->py.flags.sustain_str) {
         printMessage("You are unaffected.");
         return;
     }
@@ -159,19 +159,19 @@ static void chestPoison() {
 
     playerTakesHit(diceRoll(Dice_t{1, 6}), "a poison needle");
 
-    py.flags.poisoned += 10 + randomNumber(20);
+    session->py.flags.poisoned += 10 + randomNumber(20);
 }
 
 static void chestParalysed() {
     printMessage("A puff of yellow gas surrounds you!");
 
-    if (py.flags.free_action) {
+    if (session->py.flags.free_action) {
         printMessage("You are unaffected.");
         return;
     }
 
     printMessage("You choke and pass out.");
-    py.flags.paralysis = (int16_t)(10 + randomNumber(20));
+    session->py.flags.paralysis = (int16_t)(10 + randomNumber(20));
 }
 
 static void chestSummonMonster(Coord_t coord) {
@@ -195,7 +195,7 @@ static void chestExplode(Coord_t coord) {
 // Chests have traps too. -RAK-
 // Note: Chest traps are based on the FLAGS value
 void chestTrap(Coord_t coord) {
-    uint32_t flags = game.treasure.list[dg.floor[coord.y][coord.x].treasure_id].flags;
+    uint32_t flags = session->game.treasure.list[session->dg.floor[coord.y][coord.x].treasure_id].flags;
 
     if ((flags & config::treasure::chests::CH_LOSE_STR) != 0u) {
         chestLooseStrength();
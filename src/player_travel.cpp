@@ -0,0 +1,512 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Travelling over the known map, and exploring the unknown parts of it
+
+#include "headers.h"
+
+// Travel is done in find mode, so the run is stopped by the same things that
+// stop running: monsters coming into view, being attacked, a key press, etc.
+// Instead of following corridors, each step goes to the neighbouring tile
+// nearest to the goal, as read from a map of walking distances. The map is
+// built over the tiles the player knows about when the journey starts, and
+// as more is seen on the way only the distances around the tiles that
+// changed are worked out again.
+
+constexpr char TRAVEL_EXPLORE = '_';
+constexpr uint16_t TRAVEL_UNREACHABLE = UINT16_MAX;
+
+// The state of the journey is kept in the session. These are only
+// used while a distance map is being built or updated.
+static thread_local int travel_queue[MAX_HEIGHT * MAX_WIDTH];
+static thread_local bool travel_queued[MAX_HEIGHT][MAX_WIDTH];
+static thread_local int travel_lost[MAX_HEIGHT * MAX_WIDTH];
+
+// Steps are tried in this order, so straight moves win ties
+static int travel_directions[] = {2, 4, 6, 8, 1, 3, 7, 9};
+
+static void travelForgetChanges() {
+    for (int i = 0; i < session->travel_changes_count; i++) {
+        int at = session->travel_changes[i];
+        session->travel_changed[at / MAX_WIDTH][at % MAX_WIDTH] = false;
+    }
+
+    session->travel_changes_count = 0;
+}
+
+// Forget everything about the previous level
+void playerTravelForgetMap() {
+    memset((char *) &session->travel_seen[0][0], 0, sizeof(session->travel_seen));
+    travelForgetChanges();
+
+    session->travel_map_valid = false;
+    session->travel_active = false;
+}
+
+// The tile may look different to the player now: something was seen,
+// lit, picked up, opened, tunnelled, etc. Looked at on the next step.
+void playerTravelTileChanged(Coord_t const &coord) {
+    if (!session->travel_map_valid || session->travel_changed[coord.y][coord.x]) {
+        return;
+    }
+
+    session->travel_changed[coord.y][coord.x] = true;
+    session->travel_changes[session->travel_changes_count++] = coord.y * MAX_WIDTH + coord.x;
+}
+
+// The player's lamp has reached a tile
+void playerTravelSeeTile(Coord_t const &coord) {
+    if (!session->travel_seen[coord.y][coord.x]) {
+        session->travel_seen[coord.y][coord.x] = true;
+        playerTravelTileChanged(coord);
+    }
+}
+
+bool playerTravelling() {
+    return session->travel_active && session->py.running_tracker != 0;
+}
+
+// A new run is not a travel
+void playerTravelCancel() {
+    session->travel_active = false;
+}
+
+static bool travelTileKnown(Coord_t const &coord) {
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+
+    return tile.permanent_light || tile.temporary_light || tile.field_mark || session->travel_seen[coord.y][coord.x];
+}
+
+// The object the player sees on a tile, as drawn by caveGetTileSymbol()
+static Inventory_t const *travelTileObject(TileConstRef_t tile) {
+    if (tile.treasure_id == 0 || !(tile.permanent_light || tile.temporary_light || tile.field_mark)) {
+        return nullptr;
+    }
+
+    Inventory_t const &item = session->game.treasure.list[tile.treasure_id];
+
+    if (item.category_id == TV_INVIS_TRAP) {
+        return nullptr;
+    }
+
+    return &item;
+}
+
+// Would the player walk over this tile on the way to somewhere else?
+static bool travelTileWalkable(Coord_t const &coord) {
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+
+    if (tile.feature_id > MAX_OPEN_SPACE || !travelTileKnown(coord)) {
+        return false;
+    }
+
+    // Don't wander into known traps or shops
+    Inventory_t const *item = travelTileObject(tile);
+    if (item != nullptr && (item->category_id == TV_VIS_TRAP || item->category_id == TV_STORE_DOOR)) {
+        return false;
+    }
+
+    return true;
+}
+
+// Doors are not walked through, the player has to open them first
+static bool travelTileIsClosedDoor(Coord_t const &coord) {
+    if (!travelTileKnown(coord)) {
+        return false;
+    }
+
+    Inventory_t const *item = travelTileObject(session->dg.floor[coord.y][coord.x]);
+
+    return item != nullptr && item->category_id == TV_CLOSED_DOOR;
+}
+
+static bool travelTileIsGoal(Coord_t const &coord, char symbol) {
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+
+    if (symbol != TRAVEL_EXPLORE) {
+        if (tile.feature_id > MAX_OPEN_SPACE || !travelTileKnown(coord)) {
+            return false;
+        }
+
+        Inventory_t const *item = travelTileObject(tile);
+        return item != nullptr && item->sprite == symbol;
+    }
+
+    // A closed door may lead on to somewhere new, but is only headed
+    // for once there is nowhere else left to explore.
+    bool door = session->travel_map_doors && travelTileIsClosedDoor(coord);
+    if (!travelTileWalkable(coord) && !door) {
+        return false;
+    }
+
+    // A tile at the edge of the known map
+    for (int y = coord.y - 1; y <= coord.y + 1; y++) {
+        for (int x = coord.x - 1; x <= coord.x + 1; x++) {
+            if (coordInBounds(Coord_t{y, x}) && !travelTileKnown(Coord_t{y, x})) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Breadth first search outwards from every goal tile, over the tiles
+// the player could walk on. All eight moves cost one turn.
+static void travelBuildMap(char symbol, bool doors) {
+    int head = 0;
+    int tail = 0;
+
+    travelForgetChanges();
+    session->travel_map_doors = doors;
+
+    for (int y = 0; y < MAX_HEIGHT; y++) {
+        for (int x = 0; x < MAX_WIDTH; x++) {
+            session->travel_distance[y][x] = TRAVEL_UNREACHABLE;
+
+            if (y < session->dg.height && x < session->dg.width && travelTileIsGoal(Coord_t{y, x}, symbol)) {
+                session->travel_distance[y][x] = 0;
+                travel_queue[tail++] = y * MAX_WIDTH + x;
+            }
+        }
+    }
+
+    while (head < tail) {
+        Coord_t from = Coord_t{travel_queue[head] / MAX_WIDTH, travel_queue[head] % MAX_WIDTH};
+        head++;
+
+        uint16_t distance = session->travel_distance[from.y][from.x] + 1;
+
+        for (auto dir : travel_directions) {
+            Coord_t coord = from;
+
+            if (!playerMovePosition(dir, coord)) {
+                continue;
+            }
+
+            if (session->travel_distance[coord.y][coord.x] != TRAVEL_UNREACHABLE || !travelTileWalkable(coord)) {
+                continue;
+            }
+
+            session->travel_distance[coord.y][coord.x] = distance;
+            travel_queue[tail++] = coord.y * MAX_WIDTH + coord.x;
+        }
+    }
+
+    session->travel_map_symbol = symbol;
+    session->travel_map_valid = true;
+}
+
+// A tile keeps its distance as long as it is still a goal, or can still be
+// walked on from a tile one step nearer. Tiles which have already lost
+// their distance don't count.
+static bool travelDistanceHolds(Coord_t const &coord, char symbol) {
+    uint16_t distance = session->travel_distance[coord.y][coord.x];
+
+    if (distance == 0) {
+        return travelTileIsGoal(coord, symbol);
+    }
+
+    if (!travelTileWalkable(coord)) {
+        return false;
+    }
+
+    for (auto dir : travel_directions) {
+        Coord_t from = coord;
+
+        if (playerMovePosition(dir, from) && !travel_queued[from.y][from.x] && session->travel_distance[from.y][from.x] == distance - 1) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void travelLoseDistance(Coord_t const &coord, char symbol, int &lost) {
+    if (session->travel_distance[coord.y][coord.x] == TRAVEL_UNREACHABLE || travel_queued[coord.y][coord.x] || travelDistanceHolds(coord, symbol)) {
+        return;
+    }
+
+    travel_queued[coord.y][coord.x] = true;
+    travel_lost[lost++] = coord.y * MAX_WIDTH + coord.x;
+}
+
+// Give a tile the distance it should have from its neighbours, and queue
+// it to pass a shorter distance on.
+static void travelSeedDistance(Coord_t const &coord, char symbol, int &tail, int &queued) {
+    uint16_t distance = TRAVEL_UNREACHABLE;
+
+    if (travelTileIsGoal(coord, symbol)) {
+        distance = 0;
+    } else if (travelTileWalkable(coord)) {
+        for (auto dir : travel_directions) {
+            Coord_t from = coord;
+
+            if (playerMovePosition(dir, from) && session->travel_distance[from.y][from.x] < distance - 1) {
+                distance = (uint16_t)(session->travel_distance[from.y][from.x] + 1);
+            }
+        }
+    }
+
+    if (distance >= session->travel_distance[coord.y][coord.x]) {
+        return;
+    }
+
+    session->travel_distance[coord.y][coord.x] = distance;
+
+    if (!travel_queued[coord.y][coord.x]) {
+        travel_queued[coord.y][coord.x] = true;
+        travel_queue[tail] = coord.y * MAX_WIDTH + coord.x;
+        tail = (tail + 1) % (MAX_HEIGHT * MAX_WIDTH);
+        queued++;
+    }
+}
+
+// Bring the map up to date with the tiles that changed, rather than
+// building it again. Seeing a tile changes whether it and its neighbours
+// are goals or can be walked on. First the distances that no longer hold
+// are taken away, along with those that only held because of them. Then
+// these tiles and the changed ones get their distances from what is left
+// around them, and any shorter distances are passed on as when building.
+static void travelApplyChanges(char symbol) {
+    int lost = 0;
+
+    for (int i = 0; i < session->travel_changes_count; i++) {
+        Coord_t changed = Coord_t{session->travel_changes[i] / MAX_WIDTH, session->travel_changes[i] % MAX_WIDTH};
+
+        for (int y = changed.y - 1; y <= changed.y + 1; y++) {
+            for (int x = changed.x - 1; x <= changed.x + 1; x++) {
+                if (coordInBounds(Coord_t{y, x})) {
+                    travelLoseDistance(Coord_t{y, x}, symbol, lost);
+                }
+            }
+        }
+    }
+
+    // Tiles are added to the list as it is gone through
+    for (int i = 0; i < lost; i++) {
+        Coord_t from = Coord_t{travel_lost[i] / MAX_WIDTH, travel_lost[i] % MAX_WIDTH};
+        uint16_t distance = session->travel_distance[from.y][from.x] + 1;
+
+        for (auto dir : travel_directions) {
+            Coord_t coord = from;
+
+            if (playerMovePosition(dir, coord) && session->travel_distance[coord.y][coord.x] == distance) {
+                travelLoseDistance(coord, symbol, lost);
+            }
+        }
+    }
+
+    for (int i = 0; i < lost; i++) {
+        Coord_t coord = Coord_t{travel_lost[i] / MAX_WIDTH, travel_lost[i] % MAX_WIDTH};
+
+        session->travel_distance[coord.y][coord.x] = TRAVEL_UNREACHABLE;
+        travel_queued[coord.y][coord.x] = false;
+    }
+
+    // A tile is queued at most once at a time, so the queue can't overflow
+    // when it wraps around. A tile can be queued again once it has been
+    // taken off, when a shorter way to it has been found.
+    int head = 0;
+    int tail = 0;
+    int queued = 0;
+
+    for (int i = 0; i < lost; i++) {
+        travelSeedDistance(Coord_t{travel_lost[i] / MAX_WIDTH, travel_lost[i] % MAX_WIDTH}, symbol, tail, queued);
+    }
+
+    for (int i = 0; i < session->travel_changes_count; i++) {
+        Coord_t changed = Coord_t{session->travel_changes[i] / MAX_WIDTH, session->travel_changes[i] % MAX_WIDTH};
+        session->travel_changed[changed.y][changed.x] = false;
+
+        for (int y = changed.y - 1; y <= changed.y + 1; y++) {
+            for (int x = changed.x - 1; x <= changed.x + 1; x++) {
+                if (coordInBounds(Coord_t{y, x})) {
+                    travelSeedDistance(Coord_t{y, x}, symbol, tail, queued);
+                }
+            }
+        }
+    }
+    session->travel_changes_count = 0;
+
+    while (queued > 0) {
+        Coord_t from = Coord_t{travel_queue[head] / MAX_WIDTH, travel_queue[head] % MAX_WIDTH};
+        head = (head + 1) % (MAX_HEIGHT * MAX_WIDTH);
+        queued--;
+        travel_queued[from.y][from.x] = false;
+
+        uint16_t distance = session->travel_distance[from.y][from.x] + 1;
+
+        for (auto dir : travel_directions) {
+            Coord_t coord = from;
+
+            if (!playerMovePosition(dir, coord)) {
+                continue;
+            }
+
+            if (session->travel_distance[coord.y][coord.x] <= distance || !travelTileWalkable(coord)) {
+                continue;
+            }
+
+            session->travel_distance[coord.y][coord.x] = distance;
+
+            if (!travel_queued[coord.y][coord.x]) {
+                travel_queued[coord.y][coord.x] = true;
+                travel_queue[tail] = coord.y * MAX_WIDTH + coord.x;
+                tail = (tail + 1) % (MAX_HEIGHT * MAX_WIDTH);
+                queued++;
+            }
+        }
+    }
+}
+
+// The direction of the next step from a tile, or 0 when there is nowhere closer to go
+static int travelNextDirection(Coord_t const &from) {
+    uint16_t best_distance = session->travel_distance[from.y][from.x];
+    int best_dir = 0;
+
+    for (auto dir : travel_directions) {
+        Coord_t coord = from;
+
+        if (!playerMovePosition(dir, coord)) {
+            continue;
+        }
+
+        if (session->travel_distance[coord.y][coord.x] < best_distance) {
+            best_distance = session->travel_distance[coord.y][coord.x];
+            best_dir = dir;
+        }
+    }
+
+    return best_dir;
+}
+
+// Build the map when heading somewhere else, otherwise bring it up to
+// date with what the player has seen since.
+static void travelUpdateMap(char symbol) {
+    if (!session->travel_map_valid || session->travel_map_symbol != symbol) {
+        travelBuildMap(symbol, false);
+    } else {
+        travelApplyChanges(symbol);
+    }
+
+    if (symbol == TRAVEL_EXPLORE && !session->travel_map_doors && session->travel_distance[session->py.pos.y][session->py.pos.x] == TRAVEL_UNREACHABLE) {
+        travelBuildMap(symbol, true);
+    }
+}
+
+// Stop in front of a closed door, which is as far as exploring can go
+static bool travelDoorAhead(int direction) {
+    Coord_t coord = session->py.pos;
+
+    if (direction == 0 || !playerMovePosition(direction, coord) || !travelTileIsClosedDoor(coord)) {
+        return false;
+    }
+
+    printMessage("There is a closed door in the way.");
+    return true;
+}
+
+// The lamp shows the tiles around the player, which may not have
+// been remembered yet when the game was just restored.
+static void travelSeeAroundPlayer() {
+    for (int y = session->py.pos.y - 1; y <= session->py.pos.y + 1; y++) {
+        for (int x = session->py.pos.x - 1; x <= session->py.pos.x + 1; x++) {
+            if (coordInBounds(Coord_t{y, x})) {
+                playerTravelSeeTile(Coord_t{y, x});
+            }
+        }
+    }
+}
+
+// Start travelling to the nearest tile showing the symbol, or towards the
+// nearest unexplored part of the level. Returns false if there is no way
+// to get there, in which case no turn has been used.
+bool playerTravelInitialize(char symbol) {
+    if (session->py.carrying_light) {
+        travelSeeAroundPlayer();
+    }
+
+    // Objects may have been picked up since the last journey
+    session->travel_map_valid = false;
+    travelUpdateMap(symbol);
+
+    uint16_t distance = session->travel_distance[session->py.pos.y][session->py.pos.x];
+
+    if (distance == 0) {
+        if (symbol == TRAVEL_EXPLORE) {
+            // Only without a lamp can the player stand at the edge of the map
+            printMessage("You can't see any further without a light.");
+        } else {
+            printMessage("You are already there.");
+        }
+        return false;
+    }
+
+    if (distance == TRAVEL_UNREACHABLE) {
+        if (symbol == TRAVEL_EXPLORE) {
+            printMessage("There is nothing left to explore here.");
+        } else {
+            printMessage("You don't know of a way there.");
+        }
+        return false;
+    }
+
+    if (travelDoorAhead(travelNextDirection(session->py.pos))) {
+        return false;
+    }
+
+    session->py.running_tracker = 1;
+    session->travel_active = true;
+    session->travel_symbol = symbol;
+
+    // See playerFindInitialize() for why the player symbol is erased here.
+    if (!session->py.temporary_light_only && !session->options.run_print_self) {
+        panelPutTile(caveGetTileSymbol(session->py.pos), session->py.pos);
+    }
+
+    playerTravelStep();
+
+    return true;
+}
+
+// Take one more step of the journey
+void playerTravelStep() {
+    if (session->py.flags.blind > 0) {
+        printMessage("You can't see where you are going.");
+        playerEndRunning();
+        return;
+    }
+
+    // Exploring moves on to the next unknown place, as reaching one
+    // has shown the player more of the level.
+    travelUpdateMap(session->travel_symbol);
+
+    int direction = travelNextDirection(session->py.pos);
+
+    if (direction == 0) {
+        uint16_t distance = session->travel_distance[session->py.pos.y][session->py.pos.x];
+
+        if (session->travel_symbol == TRAVEL_EXPLORE && distance == TRAVEL_UNREACHABLE) {
+            printMessage("There is nothing left to explore here.");
+        } else if (session->travel_symbol == TRAVEL_EXPLORE && distance == 0) {
+            printMessage("You can't see any further without a light.");
+        }
+        playerEndRunning();
+        return;
+    }
+
+    if (travelDoorAhead(direction)) {
+        playerEndRunning();
+        return;
+    }
+
+    playerMove(direction, true);
+
+    // Arrived?
+    if (session->travel_symbol != TRAVEL_EXPLORE && session->travel_distance[session->py.pos.y][session->py.pos.x] == 0) {
+        playerEndRunning();
+    }
+}
@@ -12,8 +12,8 @@
 // somewhere where it has no effect.
 static bool playerCanTunnel(int treasure_id, int tile_id) {
     if (tile_id < MIN_CAVE_WALL &&
-        (treasure_id == 0 || (game.treasure.list[treasure_id].category_id != TV_RUBBLE && game.treasure.list[treasure_id].category_id != TV_SECRET_DOOR))) {
-        game.player_free_turn = true;
+        (treasure_id == 0 || (session->game.treasure.list[treasure_id].category_id != TV_RUBBLE && session->game.treasure.list[treasure_id].category_id != TV_SECRET_DOOR))) {
+        session->game.player_free_turn = true;
 
         if (treasure_id == 0) {
             printMessage("Tunnel through what?  Empty air?!?");
@@ -29,7 +29,7 @@ static bool playerCanTunnel(int treasure_id, int tile_id) {
 
 // Compute the digging ability of player; based on strength, and type of tool used
 static int playerDiggingAbility(Inventory_t const &weapon) {
-    int digging_ability = py.stats.used[PlayerAttr::A_STR];
+    int digging_ability = session->py.stats.used[PlayerAttr::A_STR];
 
     if ((weapon.flags & config::treasure::flags::TR_TUNNEL) != 0u) {
         digging_ability += 25 + weapon.misc_use * 50;
@@ -42,8 +42,8 @@ static int playerDiggingAbility(Inventory_t const &weapon) {
 
     // If this weapon is too heavy for the player to wield properly,
     // then also make it harder to dig with it.
-    if (py.weapon_is_heavy) {
-        digging_ability += (py.stats.used[PlayerAttr::A_STR] * 15) - weapon.weight;
+    if (session->py.weapon_is_heavy) {
+        digging_ability += (session->py.stats.used[PlayerAttr::A_STR] * 15) - weapon.weight;
 
         if (digging_ability < 0) {
             digging_ability = 0;
@@ -129,15 +129,15 @@ static bool dungeonDigAtLocation(Coord_t coord, uint8_t wall_type, int digging_a
 // Must take into account: secret doors, special tools
 void playerTunnel(int direction) {
     // Confused?                    75% random movement
-    if (py.flags.confused > 0 && randomNumber(4) > 1) {
+    if (session->py.flags.confused > 0 && randomNumber(4) > 1) {
         direction = randomNumber(9);
     }
 
-    Coord_t coord = py.pos;
+    Coord_t coord = session->py.pos;
     (void) playerMovePosition(direction, coord);
 
-    Tile_t const &tile = dg.floor[coord.y][coord.x];
-    Inventory_t &item = py.inventory[PlayerEquipment::Wield];
+    TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Wield];
 
     if (!playerCanTunnel(tile.treasure_id, tile.feature_id)) {
         return;
@@ -155,12 +155,12 @@ void playerTunnel(int direction) {
         if (!dungeonDigAtLocation(coord, tile.feature_id, digging_ability)) {
             // Is there an object in the way?  (Rubble and secret doors)
             if (tile.treasure_id != 0) {
-                if (game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
+                if (session->game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
                     dungeonDigRubble(coord, digging_ability);
-                } else if (game.treasure.list[tile.treasure_id].category_id == TV_SECRET_DOOR) {
+                } else if (session->game.treasure.list[tile.treasure_id].category_id == TV_SECRET_DOOR) {
                     // Found secret door!
                     printMessageNoCommandInterrupt("You tunnel into the granite wall.");
-                    playerSearch(py.pos, py.misc.chance_in_search);
+                    playerSearch(session->py.pos, session->py.misc.chance_in_search);
                 } else {
                     abort();
                 }
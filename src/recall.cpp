@@ -7,12 +7,6 @@
 
 #include "headers.h"
 
-// Monster memories
-Recall_t creature_recall[MON_MAX_CREATURES];
-
-static vtype_t roff_buffer = {'\0'};        // Line buffer.
-static char *roff_buffer_pointer = nullptr; // Pointer into line buffer.
-static int roff_print_line;                 // Place to print line now being loaded.
 
 #define plural(c, ss, sp) ((c) == 1 ? (ss) : (sp))
 
@@ -24,29 +18,29 @@ static int roff_print_line;                 // Place to print line now being loa
 // Print out strings, filling up lines as we go.
 static void memoryPrint(const char *p) {
     while (*p != 0) {
-        *roff_buffer_pointer = *p;
+        *session->roff_buffer_pointer = *p;
 
-        if (*p == '\n' || roff_buffer_pointer >= roff_buffer + sizeof(roff_buffer) - 1) {
-            char *q = roff_buffer_pointer;
+        if (*p == '\n' || session->roff_buffer_pointer >= session->roff_buffer + sizeof(session->roff_buffer) - 1) {
+            char *q = session->roff_buffer_pointer;
             if (*p != '\n') {
                 while (*q != ' ') {
                     q--;
                 }
             }
             *q = 0;
-            putStringClearToEOL(roff_buffer, Coord_t{roff_print_line, 0});
-            roff_print_line++;
+            putStringClearToEOL(session->roff_buffer, Coord_t{session->roff_print_line, 0});
+            session->roff_print_line++;
 
-            char *r = roff_buffer;
+            char *r = session->roff_buffer;
 
-            while (q < roff_buffer_pointer) {
+            while (q < session->roff_buffer_pointer) {
                 q++;
                 *r = *q;
                 r++;
             }
-            roff_buffer_pointer = r;
+            session->roff_buffer_pointer = r;
         } else {
-            roff_buffer_pointer++;
+            session->roff_buffer_pointer++;
         }
         p++;
     }
@@ -54,7 +48,7 @@ static void memoryPrint(const char *p) {
 
 // Do we know anything about this monster?
 static bool memoryMonsterKnown(Recall_t const &memory) {
-    if (game.wizard_mode) {
+    if (session->game.wizard_mode) {
         return true;
     }
 
@@ -234,11 +228,11 @@ static void memoryKillPoints(uint16_t creature_defense, uint16_t monster_exp, ui
 
     // calculate the integer exp part, can be larger than 64K when first
     // level character looks at Balrog info, so must store in long
-    int32_t quotient = (int32_t) monster_exp * level / py.misc.level;
+    int32_t quotient = (int32_t) monster_exp * level / session->py.misc.level;
 
     // calculate the fractional exp part scaled by 100,
     // must use long arithmetic to avoid overflow
-    int remainder = (uint32_t)((((int32_t) monster_exp * level % py.misc.level) * (int32_t) 1000 / py.misc.level + 5) / 10);
+    int remainder = (uint32_t)((((int32_t) monster_exp * level % session->py.misc.level) * (int32_t) 1000 / session->py.misc.level + 5) / 10);
 
     char plural;
     if (quotient == 1 && remainder == 0) {
@@ -253,10 +247,10 @@ static void memoryKillPoints(uint16_t creature_defense, uint16_t monster_exp, ui
 
     const char *p, *q;
 
-    if (py.misc.level / 10 == 1) {
+    if (session->py.misc.level / 10 == 1) {
         p = "th";
     } else {
-        int ord = py.misc.level % 10;
+        int ord = session->py.misc.level % 10;
         if (ord == 1) {
             p = "st";
         } else if (ord == 2) {
@@ -268,13 +262,13 @@ static void memoryKillPoints(uint16_t creature_defense, uint16_t monster_exp, ui
         }
     }
 
-    if (py.misc.level == 8 || py.misc.level == 11 || py.misc.level == 18) {
+    if (session->py.misc.level == 8 || session->py.misc.level == 11 || session->py.misc.level == 18) {
         q = "n";
     } else {
         q = "";
     }
 
-    (void) sprintf(desc, " for a%s %d%s level character.", q, py.misc.level, p);
+    (void) sprintf(desc, " for a%s %d%s level character.", q, session->py.misc.level, p);
     memoryPrint(desc);
 }
 
@@ -586,18 +580,18 @@ static void memoryAttackNumberAndDamage(Recall_t const &memory, Creature_t const
 
 // Print out what we have discovered about this monster.
 int memoryRecall(int monster_id) {
-    Recall_t &memory = creature_recall[monster_id];
+    Recall_t &memory = session->creature_recall[monster_id];
     Creature_t const &creature = creatures_list[monster_id];
 
     Recall_t saved_memory{};
 
-    if (game.wizard_mode) {
+    if (session->game.wizard_mode) {
         saved_memory = memory;
         memoryWizardModeInit(memory, creature);
     }
 
-    roff_print_line = 0;
-    roff_buffer_pointer = roff_buffer;
+    session->roff_print_line = 0;
+    session->roff_buffer_pointer = session->roff_buffer;
 
     auto spells = (uint32_t)(memory.spells & creature.spells & ~config::monsters::spells::CS_FREQ);
 
@@ -663,9 +657,9 @@ int memoryRecall(int monster_id) {
     }
 
     memoryPrint("\n");
-    putStringClearToEOL("--pause--", Coord_t{roff_print_line, 0});
+    putStringClearToEOL("--pause--", Coord_t{session->roff_print_line, 0});
 
-    if (game.wizard_mode) {
+    if (session->game.wizard_mode) {
         memory = saved_memory;
     }
 
@@ -677,7 +671,7 @@ void recallMonsterAttributes(char command) {
     int n = 0;
 
     for (int i = MON_MAX_CREATURES - 1; i >= 0; i--) {
-        if (creatures_list[i].sprite == command && memoryMonsterKnown(creature_recall[i])) {
+        if (creatures_list[i].sprite == command && memoryMonsterKnown(session->creature_recall[i])) {
             if (n == 0) {
                 int confirmed = getInputConfirmationWithAbort(40, "You recall those details?");
                 if (confirmed != 1) {
@@ -7,7 +7,7 @@
 
 #include "headers.h"
 
-// Define this to compile as a standalone test
+// Defined when building the rng_test target, see CMakeLists.txt
 // #define TEST_RNG
 
 // This alg uses a prime modulus multiplicative congruential generator
@@ -56,41 +56,244 @@
 //
 //  Has a full period of 2^31 - 1.
 //  Returns integers in the range 1 to 2^31-1.
+//
+// Schrage's method (above) is what this generator was originally coded
+// with; parkMillerNext() now computes the same values with a 64 bit
+// multiply instead.
 
 constexpr int32_t RNG_M = INT_MAX; // m = 2^31 - 1
 constexpr int32_t RNG_A = 16807L;
-constexpr int32_t RNG_Q = RNG_M / RNG_A; // m div a 127773L
-constexpr int32_t RNG_R = RNG_M % RNG_A; // m mod a 2836L
 
-// 32 bit seed
-static uint32_t rnd_seed;
+// Number of Park-Miller steps skipped by rndJump(), giving 2^7 streams
+// of 2^24 numbers each, before they start to overlap.
+constexpr int RNG_PARK_MILLER_JUMP_BITS = 24;
+
+// Alternatively, the xoshiro128** generator by David Blackman and
+// Sebastiano Vigna can be used. It has a period of 2^128 - 1, needs no
+// division, and rndJump() advances it by 2^64 steps, so streams split
+// with it will never overlap in practice.
+//
+// See: http://prng.di.unimi.it/xoshiro128starstar.c
+
+// Park-Miller step, z * a mod m. Because m is a Mersenne prime, the
+// 64 bit product can be folded back into range without Schrage's
+// division, and still gives exactly the same sequence.
+static uint32_t parkMillerNext(uint32_t z) {
+    uint64_t product = (uint64_t) RNG_A * z;
+
+    auto folded = (uint32_t)((product & (uint32_t) RNG_M) + (product >> 31));
+    if (folded >= (uint32_t) RNG_M) {
+        folded -= (uint32_t) RNG_M;
+    }
+
+    return folded;
+}
+
+// a^(2^RNG_PARK_MILLER_JUMP_BITS) mod m
+static constexpr uint64_t parkMillerJumpMultiplier() {
+    uint64_t multiplier = RNG_A;
+    for (int i = 0; i < RNG_PARK_MILLER_JUMP_BITS; i++) {
+        multiplier = (multiplier * multiplier) % RNG_M;
+    }
+    return multiplier;
+}
+
+static uint32_t rotateLeft(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static uint32_t xoshiroNext(RandomState_t &state) {
+    uint32_t *s = state.s;
+
+    uint32_t result = rotateLeft(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+
+    s[3] = rotateLeft(s[3], 11);
 
-uint32_t getRandomSeed() {
-    return rnd_seed;
+    return result;
+}
+
+// Keeps to the rnd() contract of returning a value from 1 to RNG_M - 1
+static int32_t xoshiroNextInRange(RandomState_t &state) {
+    uint32_t value;
+
+    do {
+        value = xoshiroNext(state) >> 1;
+    } while (value == 0 || value == (uint32_t) RNG_M);
+
+    return (int32_t) value;
+}
+
+// Expands a 32 bit seed into a full xoshiro state (SplitMix32)
+static void xoshiroSeed(RandomState_t &state, uint32_t seed) {
+    for (auto &word : state.s) {
+        seed += 0x9e3779b9;
+
+        uint32_t z = seed;
+        z = (z ^ (z >> 16)) * 0x85ebca6b;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35;
+        word = z ^ (z >> 16);
+    }
+
+    // the all zero state is the one state xoshiro can never leave
+    if ((state.s[0] | state.s[1] | state.s[2] | state.s[3]) == 0) {
+        state.s[0] = 1;
+    }
+}
+
+RandomEngine getRandomEngine() {
+    return session->rnd_engine;
+}
+
+// Switching engine reseeds the new one from the current state.
+void setRandomEngine(RandomEngine engine) {
+    if (engine == session->rnd_engine) {
+        return;
+    }
+
+    uint32_t seed = session->rnd_state.s[0];
+    session->rnd_engine = engine;
+    setRandomSeed(seed);
+}
+
+RandomState_t getRandomState() {
+    return session->rnd_state;
+}
+
+void setRandomState(RandomState_t const &state) {
+    session->rnd_state = state;
 }
 
 void setRandomSeed(uint32_t seed) {
+    if (session->rnd_engine == RandomEngine::Xoshiro128) {
+        xoshiroSeed(session->rnd_state, seed);
+        return;
+    }
+
     // set seed to value between 1 and m-1
-    rnd_seed = (uint32_t)((seed % (RNG_M - 1)) + 1);
+    session->rnd_state = RandomState_t{{(uint32_t)((seed % (RNG_M - 1)) + 1), 0, 0, 0}};
 }
 
 // returns a pseudo-random number from set 1, 2, ..., RNG_M - 1
 int32_t rnd() {
-    auto high = (int32_t)(rnd_seed / RNG_Q);
-    auto low = (int32_t)(rnd_seed % RNG_Q);
-    auto test = (int32_t)(RNG_A * low - RNG_R * high);
+    if (session->rnd_engine == RandomEngine::Xoshiro128) {
+        return xoshiroNextInRange(session->rnd_state);
+    }
+
+    session->rnd_state.s[0] = parkMillerNext(session->rnd_state.s[0]);
+
+    return (int32_t) session->rnd_state.s[0];
+}
+
+// Fills `values` with `count` numbers, exactly as calling rnd() `count` times would.
+void rndFill(int32_t *values, int count) {
+    if (session->rnd_engine == RandomEngine::Xoshiro128) {
+        for (int i = 0; i < count; i++) {
+            values[i] = xoshiroNextInRange(session->rnd_state);
+        }
+        return;
+    }
+
+    uint32_t z = session->rnd_state.s[0];
+    for (int i = 0; i < count; i++) {
+        z = parkMillerNext(z);
+        values[i] = (int32_t) z;
+    }
+    session->rnd_state.s[0] = z;
+}
+
+// Advances the generator far ahead in its sequence. Seeding once and
+// then calling this between handing out states splits the sequence
+// into independent, non-overlapping streams.
+void rndJump() {
+    if (session->rnd_engine == RandomEngine::ParkMiller) {
+        session->rnd_state.s[0] = (uint32_t)((session->rnd_state.s[0] * parkMillerJumpMultiplier()) % RNG_M);
+        return;
+    }
+
+    constexpr uint32_t jump[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+
+    RandomState_t jumped = {{0, 0, 0, 0}};
 
-    if (test > 0) {
-        rnd_seed = (uint32_t) test;
-    } else {
-        rnd_seed = (uint32_t)(test + RNG_M);
+    for (auto bits : jump) {
+        for (int b = 0; b < 32; b++) {
+            if ((bits & (1u << b)) != 0) {
+                for (int i = 0; i < 4; i++) {
+                    jumped.s[i] ^= session->rnd_state.s[i];
+                }
+            }
+            (void) xoshiroNext(session->rnd_state);
+        }
     }
-    return rnd_seed;
+
+    session->rnd_state = jumped;
 }
 
 #ifdef TEST_RNG
 
-main() {
+#include <vector>
+
+// The binary search randomNumberNormalDistribution() did before it had
+// normal_table_lookup[], kept as it was to check the lookup against.
+static int testNormalTableSearch(int tmp) {
+    int low = 0;
+    int iindex = NORMAL_TABLE_SIZE >> 1;
+    int high = NORMAL_TABLE_SIZE;
+
+    while (true) {
+        if (normal_table[iindex] == tmp || high == low + 1) {
+            break;
+        }
+
+        if (normal_table[iindex] > tmp) {
+            high = iindex;
+            iindex = low + ((iindex - low) >> 1);
+        } else {
+            low = iindex;
+            iindex = iindex + ((high - iindex) >> 1);
+        }
+    }
+
+    // might end up one below target, check that here
+    if (normal_table[iindex] < tmp) {
+        iindex = iindex + 1;
+    }
+
+    return iindex;
+}
+
+// randomNumberNormalDistribution() as it was before the lookup table
+static int testNormalDistribution(int mean, int standard) {
+    int tmp = randomNumber(SHRT_MAX);
+
+    if (tmp == SHRT_MAX) {
+        int offset = 4 * standard + randomNumber(standard);
+        if (randomNumber(2) == 1) {
+            offset = -offset;
+        }
+        return mean + offset;
+    }
+
+    int offset = ((standard * testNormalTableSearch(tmp)) + (NORMAL_TABLE_SD >> 1)) / NORMAL_TABLE_SD;
+    if (randomNumber(2) == 1) {
+        offset = -offset;
+    }
+
+    return mean + offset;
+}
+
+int main() {
+    session = sessionCreate();
+
+    int failures = 0;
+
     setRandomSeed(0L);
 
     for (int32_t i = 1; i < 10000; i++) {
@@ -99,11 +302,76 @@ main() {
 
     int32_t random = rnd();
 
-    printf("z[10001] = %ld, should be 1043618065\n", random);
+    printf("z[10001] = %d, should be 1043618065\n", (int) random);
+
+    if (random != 1043618065L) {
+        failures++;
+    }
+
+    // the batched fill must give the same sequence as rnd()
+    setRandomSeed(0L);
+
+    std::vector<int32_t> values(10000);
+    rndFill(values.data(), 10000);
+
+    printf("rndFill z[10001] = %d, should be 1043618065\n", (int) values[9999]);
+
+    if (values[9999] != 1043618065L) {
+        failures++;
+    }
+
+    // the lookup must give the index the search did, for every value of
+    // randomNumber(SHRT_MAX) but the off scale SHRT_MAX itself
+    int mismatches = 0;
+    for (int tmp = 1; tmp < SHRT_MAX; tmp++) {
+        if (normal_table_lookup[tmp] != testNormalTableSearch(tmp)) {
+            mismatches++;
+        }
+    }
+
+    printf("normal_table_lookup differs from the search for %d of %d values\n", mismatches, SHRT_MAX - 1);
 
-    if (random == 1043618065L) {
+    if (mismatches != 0) {
+        failures++;
+    }
+
+    // and the same stream must give the same draws, for both engines
+    for (auto engine : {RandomEngine::ParkMiller, RandomEngine::Xoshiro128}) {
+        constexpr int draws = 1000000;
+
+        setRandomEngine(engine);
+
+        setRandomSeed(12345);
+        std::vector<int> expected(draws);
+        for (int i = 0; i < draws; i++) {
+            expected[i] = testNormalDistribution(i % 200, 1 + i % 50);
+        }
+        RandomState_t expected_state = getRandomState();
+
+        setRandomSeed(12345);
+        mismatches = 0;
+        for (int i = 0; i < draws; i++) {
+            if (randomNumberNormalDistribution(i % 200, 1 + i % 50) != expected[i]) {
+                mismatches++;
+            }
+        }
+        RandomState_t state = getRandomState();
+
+        bool same_state = memcmp(&state, &expected_state, sizeof(state)) == 0;
+
+        printf("randomNumberNormalDistribution() differs for %d of %d draws from engine %d, %s\n", mismatches, draws, (int) engine,
+               same_state ? "ending in the same state" : "ending in a different state");
+
+        if (mismatches != 0 || !same_state) {
+            failures++;
+        }
+    }
+
+    if (failures == 0) {
         printf("success!!!\n");
     }
+
+    return failures == 0 ? 0 : 1;
 }
 
 #endif
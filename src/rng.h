@@ -5,7 +5,24 @@
 
 #pragma once
 
+// Engines which can be used to generate the numbers behind rnd().
+// Park-Miller is the original Moria generator and remains the default.
+enum class RandomEngine : uint8_t {
+    ParkMiller = 0,
+    Xoshiro128 = 1,
+};
+
+// Complete state of the random number generator, large enough for any engine.
+typedef struct {
+    uint32_t s[4];
+} RandomState_t;
+
 // rng.cpp
-uint32_t getRandomSeed();
+RandomEngine getRandomEngine();
+void setRandomEngine(RandomEngine engine);
+RandomState_t getRandomState();
+void setRandomState(RandomState_t const &state);
 void setRandomSeed(uint32_t seed);
 int32_t rnd();
+void rndFill(int32_t *values, int count);
+void rndJump();
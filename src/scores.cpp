@@ -8,9 +8,17 @@
 #include "headers.h"
 #include "version.h"
 
+#include <mutex>
+#include <vector>
+
 // High score file pointer
 FILE *highscore_fp;
 
+// Games played at the same time by a server take turns with the score file.
+// Nothing waits for a key while holding this, as that would let another game
+// on the same thread try to take it.
+static std::mutex highscore_mutex;
+
 static uint8_t highScoreGenderLabel() {
     if (playerIsMale()) {
         return 'M';
@@ -22,30 +30,30 @@ static uint8_t highScoreGenderLabel() {
 void recordNewHighScore() {
     clearScreen();
 
-    if (game.noscore != 0) {
+    if (session->game.noscore != 0) {
         return;
     }
 
-    if (panic_save) {
+    if (session->panic_save) {
         printMessage("Sorry, scores for games restored from panic save files are not saved.");
         return;
     }
 
     HighScore_t new_entry{};
     new_entry.points = playerCalculateTotalPoints();
-    new_entry.birth_date = py.misc.date_of_birth;
+    new_entry.birth_date = session->py.misc.date_of_birth;
     new_entry.uid = 0; // NOTE: do we not want to use `getuid()`? -MRC-
-    new_entry.mhp = py.misc.max_hp;
-    new_entry.chp = py.misc.current_hp;
-    new_entry.dungeon_depth = (uint8_t) dg.current_level;
-    new_entry.level = (uint8_t) py.misc.level;
-    new_entry.deepest_dungeon_depth = (uint8_t) py.misc.max_dungeon_depth;
+    new_entry.mhp = session->py.misc.max_hp;
+    new_entry.chp = session->py.misc.current_hp;
+    new_entry.dungeon_depth = (uint8_t) session->dg.current_level;
+    new_entry.level = (uint8_t) session->py.misc.level;
+    new_entry.deepest_dungeon_depth = (uint8_t) session->py.misc.max_dungeon_depth;
     new_entry.gender = highScoreGenderLabel();
-    new_entry.race = py.misc.race_id;
-    new_entry.character_class = py.misc.class_id;
-    (void) strcpy(new_entry.name, py.misc.name);
+    new_entry.race = session->py.misc.race_id;
+    new_entry.character_class = session->py.misc.class_id;
+    (void) strcpy(new_entry.name, session->py.misc.name);
 
-    char *tmp = game.character_died_from;
+    char *tmp = session->game.character_died_from;
     if ('a' == *tmp) {
         if ('n' == *(++tmp)) {
             tmp++;
@@ -56,7 +64,10 @@ void recordNewHighScore() {
     }
     (void) strcpy(new_entry.died_from, tmp);
 
+    std::unique_lock<std::mutex> lock(highscore_mutex);
+
     if ((highscore_fp = fopen(config::files::scores.c_str(), "rb+")) == nullptr) {
+        lock.unlock();
         printMessage(("Error opening score file '" + config::files::scores + "'.").c_str());
         printMessage(CNIL);
         return;
@@ -170,11 +181,14 @@ void recordNewHighScore() {
     (void) fclose(highscore_fp);
 }
 
-void showScoresScreen() {
+// Reads all the scores, so they can be looked through without holding the
+// score file. Returns false, with a message for the player, on failure.
+static bool readAllHighScores(std::vector<HighScore_t> &scores, std::string &error) {
+    std::lock_guard<std::mutex> lock(highscore_mutex);
+
     if ((highscore_fp = fopen(config::files::scores.c_str(), "rb")) == nullptr) {
-        printMessage(("Error opening score file '" + config::files::scores + "'.").c_str());
-        printMessage(CNIL);
-        return;
+        error = "Error opening score file '" + config::files::scores + "'.";
+        return false;
     }
 
     (void) fseek(highscore_fp, (off_t) 0, SEEK_SET);
@@ -186,10 +200,9 @@ void showScoresScreen() {
 
     // If score data present, check if a valid game version
     if (feof(highscore_fp) == 0 && !validGameVersion(version_maj, version_min, patch_level)) {
-        printMessage("Sorry. This score file is from a different version of umoria.");
-        printMessage(CNIL);
+        error = "Sorry. This score file is from a different version of umoria.";
         (void) fclose(highscore_fp);
-        return;
+        return false;
     }
 
     // set the static fileptr in save.c to the high score file pointer
@@ -198,19 +211,39 @@ void showScoresScreen() {
     HighScore_t score{};
     readHighScore(score);
 
+    while (feof(highscore_fp) == 0) {
+        scores.push_back(score);
+        readHighScore(score);
+    }
+
+    (void) fclose(highscore_fp);
+
+    return true;
+}
+
+void showScoresScreen() {
+    std::vector<HighScore_t> scores;
+    std::string error;
+
+    if (!readAllHighScores(scores, error)) {
+        printMessage(error.c_str());
+        printMessage(CNIL);
+        return;
+    }
+
     char msg[100];
 
-    int i = 0;
-    int rank = 1;
+    size_t rank = 0;
 
-    while (feof(highscore_fp) == 0) {
-        i = 1;
+    while (rank < scores.size()) {
+        int i = 1;
         clearScreen();
         // Put twenty scores on each page, on lines 2 through 21.
-        while ((feof(highscore_fp) == 0) && i < 21) {
+        while (rank < scores.size() && i < 21) {
+            HighScore_t const &score = scores[rank];
             (void) sprintf(msg,                                               //
                            "%-4d%8d %-19.19s %c %-10.10s %-7.7s%3d %-22.22s", //
-                           rank,                                              //
+                           (int) rank + 1,                                    //
                            score.points,                                      //
                            score.name,                                        //
                            score.gender,                                      //
@@ -222,7 +255,6 @@ void showScoresScreen() {
             i++;
             putStringClearToEOL(msg, Coord_t{i, 0});
             rank++;
-            readHighScore(score);
         }
         putStringClearToEOL("Rank  Points Name              Sex Race       Class  Lvl Killed By", Coord_t{0, 0});
         eraseLine(Coord_t{1, 0});
@@ -231,24 +263,22 @@ void showScoresScreen() {
             break;
         }
     }
-
-    (void) fclose(highscore_fp);
 }
 
 // Calculates the total number of points earned -JWT-
 int32_t playerCalculateTotalPoints() {
-    int32_t total = py.misc.max_exp + (100 * py.misc.max_dungeon_depth);
-    total += py.misc.au / 100;
+    int32_t total = session->py.misc.max_exp + (100 * session->py.misc.max_dungeon_depth);
+    total += session->py.misc.au / 100;
 
-    for (auto &item : py.inventory) {
+    for (auto &item : session->py.inventory) {
         total += storeItemValue(item);
     }
 
-    total += dg.current_level * 50;
+    total += session->dg.current_level * 50;
 
     // Don't ever let the score decrease from one save to the next.
-    if (py.max_score > total) {
-        return py.max_score;
+    if (session->py.max_score > total) {
+        return session->py.max_score;
     }
 
     return total;
@@ -8,7 +8,7 @@
 // Note: naming of all the scroll functions needs verifying -MRC-
 
 static bool playerCanReadScroll(int &item_pos_start, int &item_pos_end) {
-    if (py.flags.blind > 0) {
+    if (session->py.flags.blind > 0) {
         printMessage("You can't see to read the scroll.");
         return false;
     }
@@ -18,12 +18,12 @@ static bool playerCanReadScroll(int &item_pos_start, int &item_pos_end) {
         return false;
     }
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are too confused to read a scroll.");
         return false;
     }
 
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("You are not carrying anything!");
         return false;
     }
@@ -40,28 +40,28 @@ static int inventoryItemIdOfCursedEquipment() {
     int item_count = 0;
     int items[6];
 
-    if (py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING) {
         items[item_count] = PlayerEquipment::Body;
         item_count++;
     }
-    if (py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING) {
         items[item_count] = PlayerEquipment::Arm;
         item_count++;
     }
-    if (py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING) {
         items[item_count] = PlayerEquipment::Outer;
         item_count++;
     }
-    if (py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING) {
         items[item_count] = PlayerEquipment::Hands;
         item_count++;
     }
-    if (py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING) {
         items[item_count] = PlayerEquipment::Head;
         item_count++;
     }
     // also enchant boots
-    if (py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING) {
         items[item_count] = PlayerEquipment::Feet;
         item_count++;
     }
@@ -90,7 +90,7 @@ static int inventoryItemIdOfCursedEquipment() {
 }
 
 static bool scrollEnchantWeaponToHit() {
-    Inventory_t &item = py.inventory[PlayerEquipment::Wield];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Wield];
 
     if (item.category_id == TV_NOTHING) {
         return false;
@@ -114,7 +114,7 @@ static bool scrollEnchantWeaponToHit() {
 }
 
 static bool scrollEnchantWeaponToDamage() {
-    Inventory_t &item = py.inventory[PlayerEquipment::Wield];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Wield];
 
     if (item.category_id == TV_NOTHING) {
         return false;
@@ -154,7 +154,7 @@ static bool scrollEnchantItemToAC() {
         return false;
     }
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     obj_desc_t msg = {'\0'};
     obj_desc_t desc = {'\0'};
@@ -182,10 +182,10 @@ static int scrollIdentifyItem(int item_id, bool &is_used_up) {
     // to move to a different place.  Check for that here.  It can
     // move arbitrarily far if an identify scroll was used on
     // another identify scroll, but it always moves down.
-    Inventory_t *item = &py.inventory[item_id];
+    Inventory_t *item = &session->py.inventory[item_id];
     while (item_id > 0 && (item->category_id != TV_SCROLL1 || item->flags != 0x00000008)) {
         item_id--;
-        item = &py.inventory[item_id];
+        item = &session->py.inventory[item_id];
     }
 
     return item_id;
@@ -204,8 +204,8 @@ static bool scrollSummonMonster() {
     Coord_t coord = Coord_t{0, 0};
 
     for (int i = 0; i < randomNumber(3); i++) {
-        coord.y = py.pos.y;
-        coord.x = py.pos.x;
+        coord.y = session->py.pos.y;
+        coord.x = session->py.pos.x;
         identified |= monsterSummon(coord, false);
     }
 
@@ -213,24 +213,24 @@ static bool scrollSummonMonster() {
 }
 
 static void scrollTeleportLevel() {
-    dg.current_level += (-3) + 2 * randomNumber(2);
-    if (dg.current_level < 1) {
-        dg.current_level = 1;
+    session->dg.current_level += (-3) + 2 * randomNumber(2);
+    if (session->dg.current_level < 1) {
+        session->dg.current_level = 1;
     }
-    dg.generate_new_level = true;
+    session->dg.generate_new_level = true;
 }
 
 static bool scrollConfuseMonster() {
-    if (!py.flags.confuse_monster) {
+    if (!session->py.flags.confuse_monster) {
         printMessage("Your hands begin to glow.");
-        py.flags.confuse_monster = true;
+        session->py.flags.confuse_monster = true;
         return true;
     }
     return false;
 }
 
 static bool scrollEnchantWeapon() {
-    Inventory_t &item = py.inventory[PlayerEquipment::Wield];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Wield];
 
     if (item.category_id == TV_NOTHING) {
         return false;
@@ -278,7 +278,7 @@ static bool scrollEnchantWeapon() {
 }
 
 static bool scrollCurseWeapon() {
-    Inventory_t &item = py.inventory[PlayerEquipment::Wield];
+    Inventory_t &item = session->py.inventory[PlayerEquipment::Wield];
 
     if (item.category_id == TV_NOTHING) {
         return false;
@@ -314,7 +314,7 @@ static bool scrollEnchantArmor() {
         return false;
     }
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     obj_desc_t msg = {'\0'};
     obj_desc_t desc = {'\0'};
@@ -344,29 +344,29 @@ static bool scrollEnchantArmor() {
 static bool scrollCurseArmor() {
     int item_id;
 
-    if (py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING && randomNumber(4) == 1) {
+    if (session->py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING && randomNumber(4) == 1) {
         item_id = PlayerEquipment::Body;
-    } else if (py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING && randomNumber(3) == 1) {
+    } else if (session->py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING && randomNumber(3) == 1) {
         item_id = PlayerEquipment::Arm;
-    } else if (py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING && randomNumber(3) == 1) {
+    } else if (session->py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING && randomNumber(3) == 1) {
         item_id = PlayerEquipment::Outer;
-    } else if (py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING && randomNumber(3) == 1) {
+    } else if (session->py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING && randomNumber(3) == 1) {
         item_id = PlayerEquipment::Head;
-    } else if (py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING && randomNumber(3) == 1) {
+    } else if (session->py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING && randomNumber(3) == 1) {
         item_id = PlayerEquipment::Hands;
-    } else if (py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING && randomNumber(3) == 1) {
+    } else if (session->py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING && randomNumber(3) == 1) {
         item_id = PlayerEquipment::Feet;
-    } else if (py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING) {
+    } else if (session->py.inventory[PlayerEquipment::Body].category_id != TV_NOTHING) {
         item_id = PlayerEquipment::Body;
-    } else if (py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING) {
+    } else if (session->py.inventory[PlayerEquipment::Arm].category_id != TV_NOTHING) {
         item_id = PlayerEquipment::Arm;
-    } else if (py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING) {
+    } else if (session->py.inventory[PlayerEquipment::Outer].category_id != TV_NOTHING) {
         item_id = PlayerEquipment::Outer;
-    } else if (py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING) {
+    } else if (session->py.inventory[PlayerEquipment::Head].category_id != TV_NOTHING) {
         item_id = PlayerEquipment::Head;
-    } else if (py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING) {
+    } else if (session->py.inventory[PlayerEquipment::Hands].category_id != TV_NOTHING) {
         item_id = PlayerEquipment::Hands;
-    } else if (py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING) {
+    } else if (session->py.inventory[PlayerEquipment::Feet].category_id != TV_NOTHING) {
         item_id = PlayerEquipment::Feet;
     } else {
         item_id = 0;
@@ -376,7 +376,7 @@ static bool scrollCurseArmor() {
         return false;
     }
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     obj_desc_t msg = {'\0'};
     obj_desc_t desc = {'\0'};
@@ -402,8 +402,8 @@ static bool scrollSummonUndead() {
     Coord_t coord = Coord_t{0, 0};
 
     for (int i = 0; i < randomNumber(3); i++) {
-        coord.y = py.pos.y;
-        coord.x = py.pos.x;
+        coord.y = session->py.pos.y;
+        coord.x = session->py.pos.x;
         identified |= monsterSummonUndead(coord);
     }
 
@@ -411,15 +411,15 @@ static bool scrollSummonUndead() {
 }
 
 static void scrollWordOfRecall() {
-    if (py.flags.word_of_recall == 0) {
-        py.flags.word_of_recall = (int16_t)(25 + randomNumber(30));
+    if (session->py.flags.word_of_recall == 0) {
+        session->py.flags.word_of_recall = (int16_t)(25 + randomNumber(30));
     }
     printMessage("The air about you becomes charged.");
 }
 
 // Scrolls for the reading -RAK-
 void scrollRead() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
     int item_pos_start, item_pos_end;
     if (!playerCanReadScroll(item_pos_start, item_pos_end)) {
@@ -432,12 +432,12 @@ void scrollRead() {
     }
 
     // From here on, no free turn for the player
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
     bool used_up = true;
     bool identified = false;
 
-    Inventory_t *item = &py.inventory[item_id];
+    Inventory_t *item = &session->py.inventory[item_id];
     uint32_t item_flags = item->flags;
 
     while (item_flags != 0) {
@@ -465,7 +465,7 @@ void scrollRead() {
                 identified = scrollRemoveCurse();
                 break;
             case 6:
-                identified = spellLightArea(py.pos);
+                identified = spellLightArea(session->py.pos);
                 break;
             case 7:
                 identified = scrollSummonMonster();
@@ -490,7 +490,7 @@ void scrollRead() {
                 identified = true;
                 break;
             case 13:
-                identified = monsterSleep(py.pos);
+                identified = monsterSleep(session->py.pos);
                 break;
             case 14:
                 spellWardingGlyph();
@@ -541,7 +541,7 @@ void scrollRead() {
                 identified = true;
                 break;
             case 27:
-                identified = spellDarkenArea(py.pos);
+                identified = spellDarkenArea(session->py.pos);
                 break;
             case 28:
                 identified = playerProtectEvil();
@@ -585,7 +585,7 @@ void scrollRead() {
                 identified = true;
                 break;
             case 42:
-                spellDestroyArea(py.pos);
+                spellDestroyArea(session->py.pos);
                 identified = true;
                 break;
             default:
@@ -594,15 +594,15 @@ void scrollRead() {
         }
     }
 
-    item = &py.inventory[item_id];
+    item = &session->py.inventory[item_id];
 
     if (identified) {
         if (!itemSetColorlessAsIdentified(item->category_id, item->sub_category_id, item->identification)) {
             // round half-way case up
-            py.misc.exp += (item->depth_first_found + (py.misc.level >> 1)) / py.misc.level;
+            session->py.misc.exp += (item->depth_first_found + (session->py.misc.level >> 1)) / session->py.misc.level;
             displayCharacterExperience();
 
-            itemIdentify(py.inventory[item_id], item_id);
+            itemIdentify(session->py.inventory[item_id], item_id);
         }
     } else if (!itemSetColorlessAsIdentified(item->category_id, item->sub_category_id, item->identification)) {
         itemSetAsTried(*item);
@@ -0,0 +1,1019 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// A server hosting many games in one process, played over socket connections
+
+#include "headers.h"
+
+ServerConfig_t::~ServerConfig_t() = default;
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <mutex>
+#include <random>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <netdb.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <ucontext.h>
+
+// The main thread accepts connections and hands each to one of a few worker
+// threads. A worker waits on all of its connections with epoll, and plays
+// each game as a fiber on its own stack: the game code runs as it always
+// has, and when it wants a key which has not arrived yet, its fiber is put
+// aside and the worker gets on with the other games. Keys arriving for a
+// game resume it where it left off, inside its playDungeon() turn.
+//
+// A game stays on the worker it started on, as the compiler may keep the
+// address of the `session` thread local across a switch between fibers.
+//
+// Anyone can watch a game being played. What the game sends its player is
+// kept once, in the game's watch_output, and each watcher is sent what it
+// has not had yet from there. Watchers are moved to the worker of the game
+// they watch, and start with a keyframe of the player's screen.
+
+constexpr int SERVER_MAX_WORKERS = 4;
+constexpr int SERVER_EVENTS = 64;
+
+// Fiber stacks are only backed by memory as the game uses them
+constexpr size_t SERVER_STACK_SIZE = 1024 * 1024;
+constexpr size_t SERVER_STACK_GUARD = 4096;
+
+// A game whose player has stopped reading is disconnected
+// once this much of its output is waiting to be sent.
+constexpr size_t SERVER_OUTPUT_LIMIT = 1024 * 1024;
+
+// Character file names are kept to what can not be a path
+constexpr int SERVER_NAME_SIZE = 16;
+
+typedef struct Worker_t Worker_t;
+typedef struct Connection_t Connection_t;
+
+typedef struct Connection_t {
+    int fd = -1;
+    Worker_t *worker = nullptr;
+
+    Session_t *game_session = nullptr;
+    TerminalLink_t link = TerminalLink_t{};
+
+    ucontext_t fiber = ucontext_t{};
+    void *stack = nullptr;
+
+    std::string input{};   // Keys received, not yet read
+    size_t input_read = 0; // How much of the input has been read
+    std::string output{};  // Frames waiting for the socket to take them
+    bool want_output_event = false;
+
+    bool closed = false;   // The player has gone
+    bool finished = false; // The game has ended
+
+    // A game waiting for a key, until `wake_at` when that is set
+    bool waiting = false;
+    int64_t wake_at = 0;
+
+    std::string name{}; // The character file being played
+
+    // A game's watchers, and its output which they have not all been sent.
+    // Positions count all the output ever kept here for watchers.
+    std::vector<Connection_t *> watchers{};
+    std::string watch_output{};
+    uint64_t watch_output_start = 0;
+
+    // A watcher, and how much of the game's output it has been sent
+    bool watcher = false;
+    Connection_t *watching = nullptr;
+    uint64_t watch_position = 0;
+
+    // The game asked to watch, by a connection which is not playing
+    std::string watch_name{};
+} Connection_t;
+
+// A connection handed to a worker: a new one, or a watcher of one of its games
+typedef struct {
+    int fd = -1;
+    std::string watch_name{};
+} PendingConnection_t;
+
+typedef struct Worker_t {
+    int epoll_fd = -1;
+    int wake_fd = -1;
+    std::thread thread{};
+
+    // Connections accepted by the main thread, for the worker to take on
+    std::mutex pending_mutex{};
+    std::vector<PendingConnection_t> pending{};
+    bool stopping = false;
+
+    ucontext_t scheduler = ucontext_t{};
+    std::vector<Connection_t *> connections{};
+} Worker_t;
+
+static ServerConfig_t server_config;
+
+// The characters being played, and the workers playing them. No two
+// games play from one save file, and watchers find their game here.
+static std::mutex server_games_mutex;
+static std::map<std::string, Worker_t *> server_games;
+
+static int64_t serverNow() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (int64_t) std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+static bool serverInputWaiting(Connection_t const &conn) {
+    return conn.input_read < conn.input.size() || conn.closed;
+}
+
+// Puts the game aside until its worker resumes it
+static void serverYield(Connection_t &conn) {
+    (void) swapcontext(&conn.fiber, &conn.worker->scheduler);
+}
+
+static void serverWatchOutput(Connection_t &conn, bool want) {
+    if (conn.want_output_event == want || conn.closed) {
+        return;
+    }
+    conn.want_output_event = want;
+
+    struct epoll_event event {};
+    event.events = EPOLLIN | EPOLLRDHUP | (want ? EPOLLOUT : 0u);
+    event.data.ptr = &conn;
+    (void) epoll_ctl(conn.worker->epoll_fd, EPOLL_CTL_MOD, conn.fd, &event);
+}
+
+// The player has gone: the game is told by the end of its input,
+// and saves itself as it does when the terminal hangs up.
+static void serverDisconnect(Connection_t &conn) {
+    if (conn.closed) {
+        return;
+    }
+    conn.closed = true;
+    conn.output.clear();
+
+    (void) epoll_ctl(conn.worker->epoll_fd, EPOLL_CTL_DEL, conn.fd, nullptr);
+    (void) shutdown(conn.fd, SHUT_RDWR);
+}
+
+// Sends as much as the socket will take, returning how much that was
+static size_t serverSend(Connection_t &conn, const char *bytes, size_t length) {
+    size_t sent = 0;
+
+    while (sent < length) {
+        ssize_t count = send(conn.fd, bytes + sent, length - sent, MSG_NOSIGNAL);
+
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                serverDisconnect(conn);
+            }
+            break;
+        }
+
+        sent += (size_t) count;
+    }
+
+    return sent;
+}
+
+// Sends a connection's own output, then for a watcher the game's output
+static void serverSendOutput(Connection_t &conn) {
+    conn.output.erase(0, serverSend(conn, conn.output.data(), conn.output.size()));
+
+    size_t behind = 0;
+
+    if (conn.watching != nullptr && conn.output.empty()) {
+        Connection_t const &game = *conn.watching;
+        auto offset = (size_t)(conn.watch_position - game.watch_output_start);
+
+        conn.watch_position += serverSend(conn, game.watch_output.data() + offset, game.watch_output.size() - offset);
+        behind = (size_t)(game.watch_output_start + game.watch_output.size() - conn.watch_position);
+    }
+
+    if (conn.output.size() > SERVER_OUTPUT_LIMIT || behind > SERVER_OUTPUT_LIMIT) {
+        serverDisconnect(conn);
+        return;
+    }
+
+    serverWatchOutput(conn, !conn.output.empty() || behind > 0);
+}
+
+// Drops the game's output once every watcher has been sent it
+static void serverTrimWatchOutput(Connection_t &game) {
+    uint64_t end = game.watch_output_start + game.watch_output.size();
+
+    for (auto const *watcher : game.watchers) {
+        if (!watcher->closed && watcher->watch_position < end) {
+            end = watcher->watch_position;
+        }
+    }
+
+    game.watch_output.erase(0, (size_t)(end - game.watch_output_start));
+    game.watch_output_start = end;
+}
+
+static void serverReceiveInput(Connection_t &conn) {
+    // Keys already read are dropped before more are added
+    if (conn.input_read == conn.input.size()) {
+        conn.input.clear();
+        conn.input_read = 0;
+    }
+
+    char buffer[4096];
+
+    while (true) {
+        ssize_t count = recv(conn.fd, buffer, sizeof(buffer), 0);
+
+        if (count > 0) {
+            conn.input.append(buffer, (size_t) count);
+            continue;
+        }
+
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+
+        serverDisconnect(conn);
+        return;
+    }
+}
+
+//
+// The terminal link of a game, called from its fiber
+//
+
+static void serverLinkWrite(void *context, const char *bytes, size_t length) {
+    auto &conn = *(Connection_t *) context;
+
+    if (!conn.closed) {
+        conn.output.append(bytes, length);
+        serverSendOutput(conn);
+    }
+
+    if (conn.watchers.empty()) {
+        return;
+    }
+
+    conn.watch_output.append(bytes, length);
+    for (auto *watcher : conn.watchers) {
+        if (!watcher->closed) {
+            serverSendOutput(*watcher);
+        }
+    }
+    serverTrimWatchOutput(conn);
+}
+
+static int serverLinkGetKey(void *context) {
+    auto &conn = *(Connection_t *) context;
+
+    while (!serverInputWaiting(conn)) {
+        conn.waiting = true;
+        conn.wake_at = 0;
+        serverYield(conn);
+    }
+
+    if (conn.input_read < conn.input.size()) {
+        return (unsigned char) conn.input[conn.input_read++];
+    }
+
+    return EOF;
+}
+
+// Even when not waiting at all, the other games get a turn first,
+// so one player running or resting does not hold up the rest.
+static bool serverLinkKeyWaiting(void *context, int microseconds) {
+    auto &conn = *(Connection_t *) context;
+
+    if (!serverInputWaiting(conn)) {
+        conn.waiting = true;
+        conn.wake_at = serverNow() + microseconds;
+        serverYield(conn);
+    }
+
+    return serverInputWaiting(conn);
+}
+
+static void serverLinkHangUp(void *context) {
+    auto &conn = *(Connection_t *) context;
+
+    conn.finished = true;
+    serverYield(conn);
+
+    // A finished game is never resumed
+    abort();
+}
+
+//
+// The games
+//
+
+static bool serverValidName(const char *name) {
+    if (*name == '\0') {
+        return false;
+    }
+
+    for (; *name != '\0'; name++) {
+        if (isalnum((unsigned char) *name) == 0 && *name != '-' && *name != '_') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void serverShowGames(int row) {
+    std::string games;
+    {
+        std::lock_guard<std::mutex> lock(server_games_mutex);
+        for (auto const &game : server_games) {
+            games += games.empty() ? "Being played: " : ", ";
+            games += game.first;
+        }
+    }
+
+    if (games.empty()) {
+        games = "Nobody is playing at the moment.";
+    } else if (games.size() > 79) {
+        games.resize(76);
+        games += "...";
+    }
+
+    putStringClearToEOL(games, Coord_t{row, 0});
+}
+
+// Lists the characters saved on the server, from the preview of each save
+static void serverShowCharacters(int row) {
+    constexpr int rows = 8;
+
+    std::vector<std::string> names;
+    DIR *dir = opendir(server_config.save_directory.c_str());
+    if (dir != nullptr) {
+        for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.size() > 4 && name.compare(name.size() - 4, 4, ".sav") == 0) {
+                names.push_back(name.substr(0, name.size() - 4));
+            }
+        }
+        (void) closedir(dir);
+    }
+    std::sort(names.begin(), names.end());
+
+    putStringClearToEOL(names.empty() ? "No characters are saved yet." : "Saved characters:", Coord_t{row, 0});
+
+    for (int i = 0; i < rows; i++) {
+        std::string line;
+
+        if (i == rows - 1 && (int) names.size() > rows) {
+            line = "  ...and " + std::to_string(names.size() - (rows - 1)) + " more.";
+        } else if (i < (int) names.size()) {
+            line = "  " + names[i];
+            line.resize(SERVER_NAME_SIZE + 2, ' ');
+
+            SavePreview_t preview;
+            if (!readSavePreview(server_config.save_directory + "/" + names[i] + ".sav", preview)) {
+                line += "(saved by an older version)";
+            } else {
+                line += preview.name + ", level " + std::to_string(preview.level) + " ";
+                line += character_races[preview.race_id].name;
+                line += " ";
+                line += classes[preview.class_id].title;
+                if (preview.total_winner) {
+                    line += ", retired";
+                } else if (preview.dead) {
+                    line += ", dead";
+                } else if (preview.dungeon_depth == 0) {
+                    line += ", in town";
+                } else {
+                    line += ", " + std::to_string(preview.dungeon_depth * 50) + " ft";
+                }
+                line += ", turn " + std::to_string(preview.game_turn);
+            }
+            if (line.size() > 79) {
+                line.resize(79);
+            }
+        }
+
+        putStringClearToEOL(line, Coord_t{row + 1 + i, 0});
+    }
+}
+
+static bool serverAskName(const char *prompt, char *name) {
+    putStringClearToEOL(prompt, Coord_t{10, 0});
+    eraseLine(Coord_t{12, 0});
+
+    if (!getStringInput(name, Coord_t{10, (int) strlen(prompt)}, SERVER_NAME_SIZE - 1)) {
+        return false;
+    }
+
+    if (!serverValidName(name)) {
+        putStringClearToEOL("That name can not be used.", Coord_t{12, 0});
+        return false;
+    }
+
+    return true;
+}
+
+// Asks which character to play, which is saved to a file of that name, or
+// which game to watch. Returns false when not playing, with the game to
+// watch set when that is what was asked for.
+static bool serverChooseGame(Connection_t &conn) {
+    clearScreen();
+    putString("Welcome to Umoria.", Coord_t{1, 0});
+    putString("Your character is saved under the name you play as. Playing as a", Coord_t{3, 0});
+    putString("new name starts a new character. Letters, digits, - and _ only.", Coord_t{4, 0});
+
+    while (true) {
+        serverShowGames(6);
+        serverShowCharacters(14);
+        putStringClearToEOL("[p] Play, [w] Watch a game (q stops watching), or ESC to leave.", Coord_t{8, 0});
+        eraseLine(Coord_t{10, 0});
+
+        char name[SERVER_NAME_SIZE] = {'\0'};
+
+        switch (getKeyInput()) {
+            case 'p':
+                if (!serverAskName("Play as: ", name)) {
+                    break;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(server_games_mutex);
+                    if (!server_games.emplace(name, conn.worker).second) {
+                        putStringClearToEOL("That character is being played already.", Coord_t{12, 0});
+                        break;
+                    }
+                }
+
+                conn.name = name;
+                session->save_game = server_config.save_directory + "/" + conn.name + ".sav";
+                return true;
+            case 'w':
+                if (!serverAskName("Watch: ", name)) {
+                    break;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(server_games_mutex);
+                    if (server_games.count(name) == 0) {
+                        putStringClearToEOL("Nobody is playing that character.", Coord_t{12, 0});
+                        break;
+                    }
+                }
+
+                conn.watch_name = name;
+                return false;
+            case ESCAPE:
+                return false;
+            default:
+                break;
+        }
+    }
+}
+
+// Each game is recorded to its own file, named for the character and when
+// the game started: NAME.YYYY-MM-DD.HHMMSS.ttyrec
+static std::string serverRecordingPath(std::string const &name) {
+    time_t now = time(nullptr);
+    struct tm local {};
+    (void) localtime_r(&now, &local);
+
+    char started[32];
+    (void) strftime(started, sizeof(started), "%Y-%m-%d.%H%M%S", &local);
+
+    std::string path = server_config.record_directory + "/" + name + "." + started + ".ttyrec";
+    if (server_config.compress_recordings) {
+        path += ".gz";
+    }
+    return path;
+}
+
+// Where a game's fiber starts. The game ends in exitProgram(), which
+// hangs up the link and so never returns here.
+static void serverPlay() {
+    auto &conn = *(Connection_t *) session->terminal_link->context;
+
+    setRandomEngine(server_config.engine);
+
+    uint32_t seed = server_config.seed;
+    if (seed == 0) {
+        std::random_device device;
+        seed = device() % INT32_MAX + 1;
+    }
+
+    if (terminalInitialize() && serverChooseGame(conn)) {
+        if (!server_config.record_directory.empty()) {
+            recordingStart(serverRecordingPath(conn.name), server_config.compress_recordings);
+        }
+        startMoria((int) seed, false);
+    }
+
+    exitProgram();
+}
+
+// Runs a game until it waits for a key, or ends
+static void serverResume(Connection_t &conn) {
+    conn.waiting = false;
+
+    session = conn.game_session;
+    (void) swapcontext(&conn.worker->scheduler, &conn.fiber);
+    session = nullptr;
+}
+
+static void serverWakeWorker(Worker_t &worker) {
+    uint64_t one = 1;
+    (void) write(worker.wake_fd, &one, sizeof(one));
+}
+
+// Hands a connection over to the worker playing the game it is to watch
+static bool serverHandOver(int fd, std::string const &name) {
+    std::lock_guard<std::mutex> lock(server_games_mutex);
+
+    auto game = server_games.find(name);
+    if (game == server_games.end()) {
+        return false;
+    }
+
+    Worker_t &worker = *game->second;
+    {
+        std::lock_guard<std::mutex> pending_lock(worker.pending_mutex);
+        worker.pending.push_back(PendingConnection_t{fd, name});
+    }
+    serverWakeWorker(worker);
+
+    return true;
+}
+
+// Lets a game's watchers know it is over
+static void serverEndWatching(Connection_t &game) {
+    static const char goodbye[] = "\033[?1049l\r\nThe game has ended.\r\n";
+
+    for (auto *watcher : game.watchers) {
+        watcher->watching = nullptr;
+        if (!watcher->closed) {
+            watcher->output += goodbye;
+            serverSendOutput(*watcher);
+            serverDisconnect(*watcher);
+        }
+    }
+    game.watchers.clear();
+}
+
+// Ends a game, or a watcher, and closes its connection unless it has
+// been handed over to watch a game.
+static void serverEndConnection(Worker_t &worker, Connection_t *conn) {
+    if (conn->watching != nullptr) {
+        auto &watchers = conn->watching->watchers;
+        watchers.erase(std::remove(watchers.begin(), watchers.end(), conn), watchers.end());
+        serverTrimWatchOutput(*conn->watching);
+    }
+    serverEndWatching(*conn);
+
+    if (!conn->closed && !conn->watch_name.empty()) {
+        (void) epoll_ctl(worker.epoll_fd, EPOLL_CTL_DEL, conn->fd, nullptr);
+        if (!serverHandOver(conn->fd, conn->watch_name)) {
+            (void) close(conn->fd);
+        }
+    } else {
+        serverDisconnect(*conn);
+        (void) close(conn->fd);
+    }
+
+    if (!conn->name.empty()) {
+        std::lock_guard<std::mutex> lock(server_games_mutex);
+        (void) server_games.erase(conn->name);
+    }
+
+    if (conn->game_session != nullptr) {
+        sessionDestroy(conn->game_session);
+        (void) munmap(conn->stack, SERVER_STACK_SIZE);
+    }
+
+    worker.connections.erase(std::remove(worker.connections.begin(), worker.connections.end(), conn), worker.connections.end());
+
+    delete conn;
+}
+
+// A watcher joins its game with a keyframe of the player's screen, and
+// from then on is sent whatever the player is.
+static void serverStartWatching(Worker_t &worker, int fd, std::string const &name) {
+    auto *conn = new Connection_t();
+    conn->fd = fd;
+    conn->worker = &worker;
+    conn->watcher = true;
+
+    struct epoll_event event {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.ptr = conn;
+    (void) epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, fd, &event);
+
+    worker.connections.push_back(conn);
+
+    Connection_t *game = nullptr;
+    for (auto *other : worker.connections) {
+        if (!other->watcher && !other->finished && other->name == name) {
+            game = other;
+        }
+    }
+
+    if (game == nullptr) {
+        conn->output = "\033[?1049l\r\nThe game has ended.\r\n";
+        serverSendOutput(*conn);
+        serverDisconnect(*conn);
+        return;
+    }
+
+    conn->watching = game;
+    conn->watch_position = game->watch_output_start + game->watch_output.size();
+    game->watchers.push_back(conn);
+
+    ansiKeyframe(game->game_session->ansi, conn->output);
+    serverSendOutput(*conn);
+}
+
+// Anything but q, or ESC, from a watcher is ignored
+static void serverWatcherInput(Connection_t &conn) {
+    if (conn.input.find_first_of("qQ\033", conn.input_read) != std::string::npos) {
+        serverDisconnect(conn);
+    }
+    conn.input_read = conn.input.size();
+}
+
+static bool serverStartGame(Worker_t &worker, int fd) {
+    auto *stack = mmap(nullptr, SERVER_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+        return false;
+    }
+
+    // Running off the end of the stack stops at the guard
+    (void) mprotect(stack, SERVER_STACK_GUARD, PROT_NONE);
+
+    auto *conn = new Connection_t();
+    conn->fd = fd;
+    conn->worker = &worker;
+    conn->stack = stack;
+    conn->game_session = sessionCreate();
+    conn->link = TerminalLink_t{conn, serverLinkWrite, serverLinkGetKey, serverLinkKeyWaiting, serverLinkHangUp};
+    conn->game_session->terminal_link = &conn->link;
+
+    (void) getcontext(&conn->fiber);
+    conn->fiber.uc_stack.ss_sp = stack;
+    conn->fiber.uc_stack.ss_size = SERVER_STACK_SIZE;
+    conn->fiber.uc_link = nullptr;
+    makecontext(&conn->fiber, serverPlay, 0);
+
+    struct epoll_event event {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.ptr = conn;
+    (void) epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, fd, &event);
+
+    worker.connections.push_back(conn);
+
+    serverResume(*conn);
+    if (conn->finished) {
+        serverEndConnection(worker, conn);
+    }
+
+    return true;
+}
+
+// How long epoll may wait before a game waiting for a key has to give up
+static int serverNextTimeout(Worker_t const &worker) {
+    int64_t next = -1;
+
+    for (auto const *conn : worker.connections) {
+        if (!conn->waiting || conn->wake_at == 0) {
+            continue;
+        }
+        if (next < 0 || conn->wake_at < next) {
+            next = conn->wake_at;
+        }
+    }
+
+    if (next < 0) {
+        return -1;
+    }
+
+    int64_t now = serverNow();
+    if (next <= now) {
+        return 0;
+    }
+
+    // Rounded up, so the wait is never cut short
+    return (int) ((next - now + 999) / 1000);
+}
+
+// Takes on the connections the main thread has handed over.
+// Returns false once the server is stopping.
+static bool serverTakePending(Worker_t &worker) {
+    uint64_t count;
+    (void) read(worker.wake_fd, &count, sizeof(count));
+
+    std::vector<PendingConnection_t> pending;
+    bool stopping;
+    {
+        std::lock_guard<std::mutex> lock(worker.pending_mutex);
+        pending.swap(worker.pending);
+        stopping = worker.stopping;
+    }
+
+    for (auto const &handed : pending) {
+        if (stopping) {
+            (void) close(handed.fd);
+        } else if (!handed.watch_name.empty()) {
+            serverStartWatching(worker, handed.fd, handed.watch_name);
+        } else if (!serverStartGame(worker, handed.fd)) {
+            (void) close(handed.fd);
+        }
+    }
+
+    return !stopping;
+}
+
+static void serverWorker(Worker_t *worker_ptr) {
+    Worker_t &worker = *worker_ptr;
+    bool stopping = false;
+
+    struct epoll_event events[SERVER_EVENTS];
+
+    while (!stopping || !worker.connections.empty()) {
+        int count = epoll_wait(worker.epoll_fd, events, SERVER_EVENTS, serverNextTimeout(worker));
+
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.ptr == nullptr) {
+                if (!serverTakePending(worker)) {
+                    // Every game is hung up on, so saves itself and ends
+                    stopping = true;
+                    for (auto *conn : worker.connections) {
+                        serverDisconnect(*conn);
+                    }
+                }
+                continue;
+            }
+
+            auto &conn = *(Connection_t *) events[i].data.ptr;
+
+            if ((events[i].events & EPOLLOUT) != 0u) {
+                serverSendOutput(conn);
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0u) {
+                serverReceiveInput(conn);
+                if (conn.watcher) {
+                    serverWatcherInput(conn);
+                }
+            }
+            if (conn.watching != nullptr) {
+                serverTrimWatchOutput(*conn.watching);
+            }
+        }
+
+        // Resume each game with a key to read, or which has waited long enough
+        int64_t now = serverNow();
+
+        std::vector<Connection_t *> ready;
+        for (auto *conn : worker.connections) {
+            if (conn->waiting && (serverInputWaiting(*conn) || (conn->wake_at != 0 && conn->wake_at <= now))) {
+                ready.push_back(conn);
+            }
+        }
+
+        for (auto *conn : ready) {
+            serverResume(*conn);
+        }
+
+        for (auto *conn : ready) {
+            if (conn->finished) {
+                serverEndConnection(worker, conn);
+            }
+        }
+
+        // Watchers which have gone, or whose game has
+        ready.clear();
+        for (auto *conn : worker.connections) {
+            if (conn->watcher && conn->closed) {
+                ready.push_back(conn);
+            }
+        }
+        for (auto *conn : ready) {
+            serverEndConnection(worker, conn);
+        }
+    }
+}
+
+static bool serverStartWorker(Worker_t &worker) {
+    worker.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    worker.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (worker.epoll_fd < 0 || worker.wake_fd < 0) {
+        return false;
+    }
+
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    if (epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, worker.wake_fd, &event) < 0) {
+        return false;
+    }
+
+    worker.thread = std::thread(serverWorker, &worker);
+
+    return true;
+}
+
+//
+// Listening for connections
+//
+
+static bool serverIsUnixAddress(std::string const &address) {
+    return address.find('/') != std::string::npos || address.find(':') == std::string::npos;
+}
+
+static int serverListenUnix(std::string const &path) {
+    struct sockaddr_un addr {};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path '" << path << "' is too long.\n";
+        return -1;
+    }
+    addr.sun_family = AF_UNIX;
+    (void) strcpy(addr.sun_path, path.c_str());
+
+    // A socket left behind by an earlier server is replaced
+    struct stat st {};
+    if (stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        (void) unlink(path.c_str());
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        (void) close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static int serverListenTcp(std::string const &address) {
+    size_t colon = address.rfind(':');
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+
+    struct addrinfo hints {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+
+    struct addrinfo *found = nullptr;
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &found) != 0) {
+        return -1;
+    }
+
+    int fd = -1;
+    for (struct addrinfo *ai = found; ai != nullptr && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        int on = 1;
+        (void) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) < 0 || listen(fd, SOMAXCONN) < 0) {
+            (void) close(fd);
+            fd = -1;
+        }
+    }
+
+    freeaddrinfo(found);
+
+    return fd;
+}
+
+// Accepts connections until interrupted, handing them to the workers in turn
+static void serverAcceptConnections(int listen_fd, int signal_fd, std::vector<Worker_t *> const &workers) {
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd;
+    (void) epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.fd = signal_fd;
+    (void) epoll_ctl(epoll_fd, EPOLL_CTL_ADD, signal_fd, &event);
+
+    size_t next_worker = 0;
+
+    while (true) {
+        int count = epoll_wait(epoll_fd, &event, 1, -1);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0 || event.data.fd == signal_fd) {
+            break;
+        }
+
+        int fd;
+        while ((fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+            Worker_t &worker = *workers[next_worker];
+            next_worker = (next_worker + 1) % workers.size();
+
+            {
+                std::lock_guard<std::mutex> lock(worker.pending_mutex);
+                worker.pending.push_back(PendingConnection_t{fd, ""});
+            }
+            serverWakeWorker(worker);
+        }
+    }
+
+    (void) close(epoll_fd);
+}
+
+bool serverRun(ServerConfig_t const &config) {
+    server_config = config;
+
+    setTerminalOutput(TerminalOutput::Ansi);
+
+    bool unix_socket = serverIsUnixAddress(config.address);
+    int listen_fd = unix_socket ? serverListenUnix(config.address) : serverListenTcp(config.address);
+    if (listen_fd < 0) {
+        std::cerr << "Can't listen on '" << config.address << "'.\n";
+        return false;
+    }
+
+    // Interrupting the server hangs up on every game, which saves them
+    sigset_t signals;
+    (void) sigemptyset(&signals);
+    (void) sigaddset(&signals, SIGINT);
+    (void) sigaddset(&signals, SIGTERM);
+    (void) sigaddset(&signals, SIGHUP);
+    (void) pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    int signal_fd = signalfd(-1, &signals, SFD_CLOEXEC);
+
+    auto worker_count = (int) std::thread::hardware_concurrency();
+    worker_count = std::max(1, std::min(worker_count, SERVER_MAX_WORKERS));
+
+    std::vector<Worker_t *> workers;
+    for (int i = 0; i < worker_count; i++) {
+        auto *worker = new Worker_t();
+        if (!serverStartWorker(*worker)) {
+            std::cerr << "Can't start the server workers.\n";
+            delete worker;
+            break;
+        }
+        workers.push_back(worker);
+    }
+
+    if (!workers.empty() && signal_fd >= 0) {
+        std::cerr << "Serving games on '" << config.address << "' with " << workers.size() << " workers.\n";
+        serverAcceptConnections(listen_fd, signal_fd, workers);
+    }
+
+    (void) close(listen_fd);
+    if (unix_socket) {
+        (void) unlink(config.address.c_str());
+    }
+
+    for (auto *worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->pending_mutex);
+            worker->stopping = true;
+        }
+        serverWakeWorker(*worker);
+    }
+
+    for (auto *worker : workers) {
+        worker->thread.join();
+        (void) close(worker->epoll_fd);
+        (void) close(worker->wake_fd);
+        delete worker;
+    }
+
+    recordingFinishAll();
+
+    return !workers.empty() && signal_fd >= 0;
+}
+
+#else
+
+bool serverRun(ServerConfig_t const &config) {
+    (void) config;
+    std::cerr << "The server is only available on Linux.\n";
+    return false;
+}
+
+#endif
@@ -0,0 +1,22 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Where a server listens: a Unix socket path, or HOST:PORT for TCP
+// (an empty HOST listens on every interface).
+typedef struct ServerConfig_t {
+    ~ServerConfig_t();
+
+    std::string address{};
+    std::string save_directory{};                   // Each character is saved here as NAME.sav
+    uint32_t seed = 0;                              // Every new game starts from this, when set
+    RandomEngine engine = RandomEngine::ParkMiller; // The random number engine for new games
+    std::string record_directory{};                 // Each game is recorded here, when set
+    bool compress_recordings = false;               // Gzip the recordings
+} ServerConfig_t;
+
+// server.cpp
+bool serverRun(ServerConfig_t const &config);
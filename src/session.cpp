@@ -0,0 +1,30 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// The state of one game being played
+
+#include "headers.h"
+
+#ifdef _MSC_VER
+__declspec(thread) Session_t *session = nullptr;
+#else
+__thread Session_t *session = nullptr;
+#endif
+
+Session_t::Session_t() = default;
+
+// A new session, all set for a game to be started or restored in.
+// Sessions are large, mostly from the dungeon floor, so live on the heap.
+Session_t *sessionCreate() {
+    return new Session_t();
+}
+
+void sessionDestroy(Session_t *game_session) {
+    if (session == game_session) {
+        session = nullptr;
+    }
+
+    delete game_session;
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Game options as set on startup and with `=` set options command -CJS-
+typedef struct {
+    bool display_counts = true;          // Display rest/repeat counts
+    bool find_bound = false;             // Print yourself on a run (slower)
+    bool run_cut_corners = true;         // Cut corners while running
+    bool run_examine_corners = true;     // Check corners while running
+    bool run_ignore_doors = false;       // Run through open doors
+    bool run_print_self = false;         // Stop running when the map shifts
+    bool highlight_seams = false;        // Highlight magma and quartz veins
+    bool prompt_to_pickup = false;       // Prompt to pick something up
+    bool use_roguelike_keys = false;     // Use classic Roguelike keys
+    bool show_inventory_weights = false; // Display weights in inventory
+    bool error_beep_sound = true;        // Beep for invalid characters
+} Options_t;
+
+// A session is one game being played: the character, the dungeon, its
+// monsters and stores, and all the other state which used to be globals.
+// Every subsystem reaches it through the `session` pointer, which is
+// local to each thread, so several games can be played in one process by
+// pointing it at the right session before running any game code.
+//
+// Tables which are built once from the game data and never change after
+// that, like the object and monster samplers, are shared by all sessions.
+typedef struct Session_t {
+    // Setting up all the members is too much to do inline, see session.cpp
+    Session_t();
+
+    // There is only ever one of each game
+    Session_t(const Session_t &) = delete;
+    Session_t &operator=(const Session_t &) = delete;
+
+    Dungeon_t dg = Dungeon_t{0, 0, {}, -1, 0, true, {}};
+    Player_t py = Player_t{};
+    Game_t game = Game_t{};
+    Options_t options = Options_t{};
+
+    // Live monsters are kept packed from MON_MIN_INDEX_ID up to, but not
+    // including, next_free_monster_id, so the per turn loop in updateMonsters()
+    // reads them sequentially. Deleting a monster moves the last one into its
+    // slot, see dungeonDeleteMonsterRecord(), which is why ids are not stable.
+    Monster_t monsters[MON_TOTAL_ALLOCATIONS]{};
+    int16_t next_free_monster_id = 0;   // ID for the next available monster ptr
+    int16_t monster_multiply_total = 0; // Total number of reproduction's of creatures
+    int hack_monptr = -1;
+
+    Recall_t creature_recall[MON_MAX_CREATURES]{}; // Monster memories. -CJS-
+    Store_t stores[MAX_STORES]{};
+    int16_t store_last_increment = 0;
+
+    uint8_t objects_identified[OBJECT_IDENT_SIZE]{};
+    char magic_item_titles[MAX_TITLES][10]{};
+
+    // The descriptions of unknown items, as shuffled for this game
+    const char *colors[MAX_COLORS]{};
+    const char *mushrooms[MAX_MUSHROOMS]{};
+    const char *woods[MAX_WOODS]{};
+    const char *metals[MAX_METALS]{};
+    const char *rocks[MAX_ROCKS]{};
+    const char *amulets[MAX_AMULETS]{};
+    int16_t missiles_counter = 0;
+
+    // The state of the random number generator, see rng.cpp
+    RandomEngine rnd_engine = RandomEngine::ParkMiller;
+    RandomState_t rnd_state = {{1, 0, 0, 0}};
+
+    // The terminal the game is played on, see ui_io.cpp. Without a link
+    // that is the one the process was started on.
+    TerminalLink_t *terminal_link = nullptr;
+    bool terminal_on = false;
+    AnsiTerminal_t ansi{};
+    Recording_t *recording = nullptr;
+
+    // Messages and the screen
+    bool screen_has_changed = false;
+    bool message_ready_to_print = false;      // Set with first message
+    vtype_t messages[MESSAGE_HISTORY_SIZE]{}; // Saved message history -CJS-
+    int16_t last_message_id = 0;              // Index of last message held in saved messages array
+    int eof_flag = 0;                         // Is used to signal EOF/HANGUP condition
+    bool panic_save = false;                  // True if playing from a panic save
+
+    // Monster recall text being put together, see recall.cpp
+    vtype_t roff_buffer{};               // Line buffer.
+    char *roff_buffer_pointer = nullptr; // Pointer into line buffer.
+    int roff_print_line = 0;             // Place to print line now being loaded.
+
+    // The save file being played from, see game_save.cpp
+    std::string save_game = "game.sav";
+    int from_save_file = 0;  // can overwrite old save file when save
+    uint32_t start_time = 0; // time that play started
+    FILE *fileptr = nullptr; // the save file being read or written
+    uint8_t xor_byte = 0;
+
+    // Running, see player_run.cpp
+    bool find_openarea = false;
+    bool find_breakright = false;
+    bool find_breakleft = false;
+    int find_prevdir = 0;
+    int find_direction = 0; // Keep a record of which way we are going.
+
+    // The corridor graph of the level, and the tiles the current run goes
+    // through, worked out when it starts
+    uint8_t run_corridors[MAX_HEIGHT][MAX_WIDTH]{};
+    Coord_t run_path[MAX_HEIGHT * MAX_WIDTH]{};
+    int run_path_count = 0;
+    int run_path_next = 0;
+
+    // Travelling, see player_travel.cpp. Dark floor tiles are forgotten as
+    // soon as the lamp moves on, so the tiles the player's lamp has ever
+    // reached are remembered here.
+    bool travel_seen[MAX_HEIGHT][MAX_WIDTH]{};
+
+    // The distance map of the current journey, and what it was built for
+    uint16_t travel_distance[MAX_HEIGHT][MAX_WIDTH]{};
+    char travel_map_symbol = '\0';
+    bool travel_map_doors = false;
+    bool travel_map_valid = false;
+
+    // The tiles that may look different since the map was last updated
+    bool travel_changed[MAX_HEIGHT][MAX_WIDTH]{};
+    int travel_changes[MAX_HEIGHT * MAX_WIDTH]{};
+    int travel_changes_count = 0;
+
+    // Is the current run a travel, and where to?
+    bool travel_active = false;
+    char travel_symbol = '\0';
+
+    // All floor tiles of the level: room floors first, then corridor
+    // floors, followed by any other floor tiles. See dungeon.cpp.
+    Coord_t floor_tiles[MAX_HEIGHT * MAX_WIDTH]{};
+    int floor_rooms_end = 0;
+    int floor_corridors_end = 0;
+    int floor_tiles_end = 0;
+
+    // Where each tile is in floor_tiles, plus one, or 0 when not listed
+    int16_t floor_tile_ids[MAX_HEIGHT][MAX_WIDTH]{};
+
+    // The room each tile is in, and the span of each room's tiles
+    uint8_t room_ids[MAX_HEIGHT][MAX_WIDTH]{};
+    Room_t rooms[MAX_ROOMS + 1]{};
+    int rooms_count = 0;
+
+    // The overview map is kept a block at a time. A block is only looked at
+    // again after one of its tiles has been drawn, so opening the map mostly
+    // copies out what is already here.
+    Overview_t overview{};
+    bool overview_stale[OVERVIEW_HEIGHT][OVERVIEW_WIDTH]{};
+    bool overview_all_stale = true;
+    int overview_view = -1;
+} Session_t;
+
+// The session of the game being played on this thread. This is a plain
+// thread local, rather than a C++ thread_local, so that reaching it from
+// another file costs no more than reading a global.
+#ifdef _MSC_VER
+extern __declspec(thread) Session_t *session;
+#else
+extern __thread Session_t *session;
+#endif
+
+// session.cpp
+Session_t *sessionCreate();
+void sessionDestroy(Session_t *game_session);
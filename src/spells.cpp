@@ -17,7 +17,8 @@ static bool spellGetId(int *spell_ids, int number_of_choices, int &spell_id, int
     bool spell_found = false;
     bool redraw = false;
 
-    int offset = (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE ? config::spells::NAME_OFFSET_SPELLS : config::spells::NAME_OFFSET_PRAYERS);
+    int offset =
+        (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE ? config::spells::NAME_OFFSET_SPELLS : config::spells::NAME_OFFSET_PRAYERS);
 
     char spellChoice;
 
@@ -36,7 +37,7 @@ static bool spellGetId(int *spell_ids, int number_of_choices, int &spell_id, int
             if (test_spell_id == number_of_choices) {
                 spell_id = -2;
             } else {
-                Spell_t const &spell = magic_spells[py.misc.class_id - 1][spell_id];
+                Spell_t const &spell = magic_spells[session->py.misc.class_id - 1][spell_id];
 
                 vtype_t tmp_str = {'\0'};
                 (void) sprintf(tmp_str, "Cast %s (%d mana, %d%% fail)?", spell_names[spell_id + offset], spell.mana_required, spellChanceOfSuccess(spell_id));
@@ -103,14 +104,14 @@ static bool spellGetId(int *spell_ids, int number_of_choices, int &spell_id, int
 // TODO: split into two functions; getting spell ID and casting an actual spell
 int castSpellGetId(const char *prompt, int item_id, int &spell_id, int &spell_chance) {
     // NOTE: `flags` gets set again, since getAndClearFirstBit modified it
-    uint32_t flags = py.inventory[item_id].flags;
+    uint32_t flags = session->py.inventory[item_id].flags;
     int first_spell = getAndClearFirstBit(flags);
 
     // Get flags again since getAndClearFirstBit modified variable.
-    flags = py.inventory[item_id].flags & py.flags.spells_learnt;
+    flags = session->py.inventory[item_id].flags & session->py.flags.spells_learnt;
 
     // TODO(cook) move access to `magic_spells[]` directly to the for loop it's used in, below?
-    Spell_t *spells = magic_spells[py.misc.class_id - 1];
+    Spell_t *spells = magic_spells[session->py.misc.class_id - 1];
 
     int spell_count = 0;
     int spell_list[31];
@@ -118,7 +119,7 @@ int castSpellGetId(const char *prompt, int item_id, int &spell_id, int &spell_ch
     while (flags != 0u) {
         int pos = getAndClearFirstBit(flags);
 
-        if (spells[pos].level_required <= py.misc.level) {
+        if (spells[pos].level_required <= session->py.misc.level) {
             spell_list[spell_count] = pos;
             spell_count++;
         }
@@ -133,8 +134,8 @@ int castSpellGetId(const char *prompt, int item_id, int &spell_id, int &spell_ch
         result = 1;
     }
 
-    if ((result != 0) && magic_spells[py.misc.class_id - 1][spell_id].mana_required > py.misc.current_mana) {
-        if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+    if ((result != 0) && magic_spells[session->py.misc.class_id - 1][spell_id].mana_required > session->py.misc.current_mana) {
+        if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
             result = (int) getInputConfirmation("You summon your limited strength to cast this one! Confirm?");
         } else {
             result = (int) getInputConfirmation("The gods may think you presumptuous for this! Confirm?");
@@ -155,11 +156,11 @@ bool spellDetectTreasureWithinVicinity() {
 
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
-        for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+    for (coord.y = session->dg.panel.top; coord.y <= session->dg.panel.bottom; coord.y++) {
+        for (coord.x = session->dg.panel.left; coord.x <= session->dg.panel.right; coord.x++) {
+            TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
-            if (tile.treasure_id != 0 && game.treasure.list[tile.treasure_id].category_id == TV_GOLD && !caveTileVisible(coord)) {
+            if (tile.treasure_id != 0 && session->game.treasure.list[tile.treasure_id].category_id == TV_GOLD && !caveTileVisible(coord)) {
                 tile.field_mark = true;
                 dungeonLiteSpot(coord);
                 detected = true;
@@ -176,11 +177,11 @@ bool spellDetectObjectsWithinVicinity() {
 
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
-        for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+    for (coord.y = session->dg.panel.top; coord.y <= session->dg.panel.bottom; coord.y++) {
+        for (coord.x = session->dg.panel.left; coord.x <= session->dg.panel.right; coord.x++) {
+            TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
-            if (tile.treasure_id != 0 && game.treasure.list[tile.treasure_id].category_id < TV_MAX_OBJECT && !caveTileVisible(coord)) {
+            if (tile.treasure_id != 0 && session->game.treasure.list[tile.treasure_id].category_id < TV_MAX_OBJECT && !caveTileVisible(coord)) {
                 tile.field_mark = true;
                 dungeonLiteSpot(coord);
                 detected = true;
@@ -197,20 +198,20 @@ bool spellDetectTrapsWithinVicinity() {
 
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
-        for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+    for (coord.y = session->dg.panel.top; coord.y <= session->dg.panel.bottom; coord.y++) {
+        for (coord.x = session->dg.panel.left; coord.x <= session->dg.panel.right; coord.x++) {
+            TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
             if (tile.treasure_id == 0) {
                 continue;
             }
 
-            if (game.treasure.list[tile.treasure_id].category_id == TV_INVIS_TRAP) {
+            if (session->game.treasure.list[tile.treasure_id].category_id == TV_INVIS_TRAP) {
                 tile.field_mark = true;
                 trapChangeVisibility(coord);
                 detected = true;
-            } else if (game.treasure.list[tile.treasure_id].category_id == TV_CHEST) {
-                Inventory_t &item = game.treasure.list[tile.treasure_id];
+            } else if (session->game.treasure.list[tile.treasure_id].category_id == TV_CHEST) {
+                Inventory_t &item = session->game.treasure.list[tile.treasure_id];
                 spellItemIdentifyAndRemoveRandomInscription(item);
             }
         }
@@ -225,21 +226,22 @@ bool spellDetectSecretDoorssWithinVicinity() {
 
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
-        for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+    for (coord.y = session->dg.panel.top; coord.y <= session->dg.panel.bottom; coord.y++) {
+        for (coord.x = session->dg.panel.left; coord.x <= session->dg.panel.right; coord.x++) {
+            TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
             if (tile.treasure_id == 0) {
                 continue;
             }
 
-            if (game.treasure.list[tile.treasure_id].category_id == TV_SECRET_DOOR) {
+            if (session->game.treasure.list[tile.treasure_id].category_id == TV_SECRET_DOOR) {
                 // Secret doors
 
                 tile.field_mark = true;
                 trapChangeVisibility(coord);
                 detected = true;
-            } else if ((game.treasure.list[tile.treasure_id].category_id == TV_UP_STAIR || game.treasure.list[tile.treasure_id].category_id == TV_DOWN_STAIR) && !tile.field_mark) {
+            } else if ((session->game.treasure.list[tile.treasure_id].category_id == TV_UP_STAIR || session->game.treasure.list[tile.treasure_id].category_id == TV_DOWN_STAIR) &&
+                       !tile.field_mark) {
                 // Staircases
 
                 tile.field_mark = true;
@@ -256,8 +258,8 @@ bool spellDetectSecretDoorssWithinVicinity() {
 bool spellDetectInvisibleCreaturesWithinVicinity() {
     bool detected = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t &monster = session->monsters[id];
 
         if (coordInsidePanel(Coord_t{monster.pos.y, monster.pos.x}) && ((creatures_list[monster.creature_id].movement & config::monsters::move::CM_INVISIBLE) != 0u)) {
             monster.lit = true;
@@ -284,14 +286,14 @@ bool spellDetectInvisibleCreaturesWithinVicinity() {
 //     1.  If corridor  light immediate area
 //     2.  If room      light entire room plus immediate area.
 bool spellLightArea(Coord_t coord) {
-    if (py.flags.blind < 1) {
+    if (session->py.flags.blind < 1) {
         printMessage("You are surrounded by a white light.");
     }
 
     // NOTE: this is not changed anywhere. A bug or correct? -MRC-
     bool lit = true;
 
-    if (dg.floor[coord.y][coord.x].perma_lit_room && dg.current_level > 0) {
+    if (session->dg.floor[coord.y][coord.x].perma_lit_room && session->dg.current_level > 0) {
         dungeonLightRoom(coord);
     }
 
@@ -300,7 +302,7 @@ bool spellLightArea(Coord_t coord) {
     Coord_t spot = Coord_t{0, 0};
     for (spot.y = coord.y - 1; spot.y <= coord.y + 1; spot.y++) {
         for (spot.x = coord.x - 1; spot.x <= coord.x + 1; spot.x++) {
-            dg.floor[spot.y][spot.x].permanent_light = true;
+            session->dg.floor[spot.y][spot.x].permanent_light = true;
             dungeonLiteSpot(spot);
         }
     }
@@ -314,21 +316,17 @@ bool spellDarkenArea(Coord_t coord) {
 
     Coord_t spot = Coord_t{0, 0};
 
-    if (dg.floor[coord.y][coord.x].perma_lit_room && dg.current_level > 0) {
-        int half_height = (SCREEN_HEIGHT / 2);
-        int half_width = (SCREEN_WIDTH / 2);
-        int start_row = (coord.y / half_height) * half_height + 1;
-        int start_col = (coord.x / half_width) * half_width + 1;
-        int end_row = start_row + half_height - 1;
-        int end_col = start_col + half_width - 1;
+    if (session->dg.floor[coord.y][coord.x].perma_lit_room && session->dg.current_level > 0) {
+        Room_t room = dungeonRoomAt(coord);
 
-        for (spot.y = start_row; spot.y <= end_row; spot.y++) {
-            for (spot.x = start_col; spot.x <= end_col; spot.x++) {
-                Tile_t &tile = dg.floor[spot.y][spot.x];
+        for (spot.y = room.top_left.y; spot.y <= room.bottom_right.y; spot.y++) {
+            for (spot.x = room.top_left.x; spot.x <= room.bottom_right.x; spot.x++) {
+                TileRef_t tile = session->dg.floor[spot.y][spot.x];
 
                 if (tile.perma_lit_room && tile.feature_id <= MAX_CAVE_FLOOR) {
                     tile.permanent_light = false;
                     tile.feature_id = TILE_DARK_FLOOR;
+                    dungeonFloorTileChanged(spot);
 
                     dungeonLiteSpot(spot);
 
@@ -341,7 +339,7 @@ bool spellDarkenArea(Coord_t coord) {
     } else {
         for (spot.y = coord.y - 1; spot.y <= coord.y + 1; spot.y++) {
             for (spot.x = coord.x - 1; spot.x <= coord.x + 1; spot.x++) {
-                Tile_t &tile = dg.floor[spot.y][spot.x];
+                TileRef_t tile = session->dg.floor[spot.y][spot.x];
 
                 if (tile.feature_id == TILE_CORR_FLOOR && tile.permanent_light) {
                     // permanent_light could have been set by star-lite wand, etc
@@ -352,7 +350,7 @@ bool spellDarkenArea(Coord_t coord) {
         }
     }
 
-    if (darkened && py.flags.blind < 1) {
+    if (darkened && session->py.flags.blind < 1) {
         printMessage("Darkness surrounds you.");
     }
 
@@ -364,12 +362,13 @@ static void dungeonLightAreaAroundFloorTile(Coord_t coord) {
 
     for (spot.y = coord.y - 1; spot.y <= coord.y + 1; spot.y++) {
         for (spot.x = coord.x - 1; spot.x <= coord.x + 1; spot.x++) {
-            Tile_t &tile = dg.floor[spot.y][spot.x];
+            TileRef_t tile = session->dg.floor[spot.y][spot.x];
+            dungeonOverviewTouch(spot);
 
             if (tile.feature_id >= MIN_CAVE_WALL) {
                 tile.permanent_light = true;
-            } else if (tile.treasure_id != 0 && game.treasure.list[tile.treasure_id].category_id >= TV_MIN_VISIBLE &&
-                       game.treasure.list[tile.treasure_id].category_id <= TV_MAX_VISIBLE) {
+            } else if (tile.treasure_id != 0 && session->game.treasure.list[tile.treasure_id].category_id >= TV_MIN_VISIBLE &&
+                       session->game.treasure.list[tile.treasure_id].category_id <= TV_MAX_VISIBLE) {
                 tile.field_mark = true;
             }
         }
@@ -378,16 +377,16 @@ static void dungeonLightAreaAroundFloorTile(Coord_t coord) {
 
 // Map the current area plus some -RAK-
 void spellMapCurrentArea() {
-    int row_min = dg.panel.top - randomNumber(10);
-    int row_max = dg.panel.bottom + randomNumber(10);
-    int col_min = dg.panel.left - randomNumber(20);
-    int col_max = dg.panel.right + randomNumber(20);
+    int row_min = session->dg.panel.top - randomNumber(10);
+    int row_max = session->dg.panel.bottom + randomNumber(10);
+    int col_min = session->dg.panel.left - randomNumber(20);
+    int col_max = session->dg.panel.right + randomNumber(20);
 
     Coord_t coord = Coord_t{0, 0};
 
     for (coord.y = row_min; coord.y <= row_max; coord.y++) {
         for (coord.x = col_min; coord.x <= col_max; coord.x++) {
-            if (coordInBounds(coord) && dg.floor[coord.y][coord.x].feature_id <= MAX_CAVE_FLOOR) {
+            if (coordInBounds(coord) && session->dg.floor[coord.y][coord.x].feature_id <= MAX_CAVE_FLOOR) {
                 dungeonLightAreaAroundFloorTile(coord);
             }
         }
@@ -403,9 +402,9 @@ bool spellIdentifyItem() {
         return false;
     }
 
-    itemIdentify(py.inventory[item_id], item_id);
+    itemIdentify(session->py.inventory[item_id], item_id);
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
     spellItemIdentifyAndRemoveRandomInscription(item);
 
     obj_desc_t description = {'\0'};
@@ -427,8 +426,8 @@ bool spellIdentifyItem() {
 bool spellAggravateMonsters(int affect_distance) {
     bool aggravated = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t &monster = session->monsters[id];
         monster.sleep_count = 0;
 
         if (monster.distance_from_player <= affect_distance && monster.speed < 2) {
@@ -448,17 +447,17 @@ bool spellAggravateMonsters(int affect_distance) {
 bool spellSurroundPlayerWithTraps() {
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = py.pos.y - 1; coord.y <= py.pos.y + 1; coord.y++) {
-        for (coord.x = py.pos.x - 1; coord.x <= py.pos.x + 1; coord.x++) {
+    for (coord.y = session->py.pos.y - 1; coord.y <= session->py.pos.y + 1; coord.y++) {
+        for (coord.x = session->py.pos.x - 1; coord.x <= session->py.pos.x + 1; coord.x++) {
             // Don't put a trap under the player, since this can lead to
             // strange situations, e.g. falling through a trap door while
             // trying to rest, setting off a falling rock trap and ending
             // up under the rock.
-            if (coord.y == py.pos.y && coord.x == py.pos.x) {
+            if (coord.y == session->py.pos.y && coord.x == session->py.pos.x) {
                 continue;
             }
 
-            Tile_t const &tile = dg.floor[coord.y][coord.x];
+            TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
             if (tile.feature_id <= MAX_CAVE_FLOOR) {
                 if (tile.treasure_id != 0) {
@@ -468,7 +467,7 @@ bool spellSurroundPlayerWithTraps() {
                 dungeonSetTrap(coord, randomNumber(config::dungeon::objects::MAX_TRAPS) - 1);
 
                 // don't let player gain exp from the newly created traps
-                game.treasure.list[tile.treasure_id].misc_use = 0;
+                session->game.treasure.list[tile.treasure_id].misc_use = 0;
 
                 // open pits are immediately visible, so call dungeonLiteSpot
                 dungeonLiteSpot(coord);
@@ -486,14 +485,14 @@ bool spellSurroundPlayerWithDoors() {
 
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = py.pos.y - 1; coord.y <= py.pos.y + 1; coord.y++) {
-        for (coord.x = py.pos.x - 1; coord.x <= py.pos.x + 1; coord.x++) {
+    for (coord.y = session->py.pos.y - 1; coord.y <= session->py.pos.y + 1; coord.y++) {
+        for (coord.x = session->py.pos.x - 1; coord.x <= session->py.pos.x + 1; coord.x++) {
             // Don't put a door under the player!
-            if (coord.y == py.pos.y && coord.x == py.pos.x) {
+            if (coord.y == session->py.pos.y && coord.x == session->py.pos.x) {
                 continue;
             }
 
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+            TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
             if (tile.feature_id <= MAX_CAVE_FLOOR) {
                 if (tile.treasure_id != 0) {
@@ -503,8 +502,9 @@ bool spellSurroundPlayerWithDoors() {
                 int free_id = popt();
                 tile.feature_id = TILE_BLOCKED_FLOOR;
                 tile.treasure_id = (uint8_t) free_id;
+                dungeonFloorTileChanged(coord);
 
-                inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, game.treasure.list[free_id]);
+                inventoryItemCopyTo(config::dungeon::objects::OBJ_CLOSED_DOOR, session->game.treasure.list[free_id]);
                 dungeonLiteSpot(coord);
 
                 created = true;
@@ -521,15 +521,15 @@ bool spellDestroyAdjacentDoorsTraps() {
 
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = py.pos.y - 1; coord.y <= py.pos.y + 1; coord.y++) {
-        for (coord.x = py.pos.x - 1; coord.x <= py.pos.x + 1; coord.x++) {
-            Tile_t const &tile = dg.floor[coord.y][coord.x];
+    for (coord.y = session->py.pos.y - 1; coord.y <= session->py.pos.y + 1; coord.y++) {
+        for (coord.x = session->py.pos.x - 1; coord.x <= session->py.pos.x + 1; coord.x++) {
+            TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
             if (tile.treasure_id == 0) {
                 continue;
             }
 
-            Inventory_t &item = game.treasure.list[tile.treasure_id];
+            Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
             if ((item.category_id >= TV_INVIS_TRAP && item.category_id <= TV_CLOSED_DOOR && item.category_id != TV_RUBBLE) || item.category_id == TV_SECRET_DOOR) {
                 if (dungeonDeleteObject(coord)) {
@@ -555,8 +555,8 @@ bool spellDestroyAdjacentDoorsTraps() {
 bool spellDetectMonsters() {
     bool detected = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t &monster = session->monsters[id];
 
         if (coordInsidePanel(Coord_t{monster.pos.y, monster.pos.x}) && (creatures_list[monster.creature_id].movement & config::monsters::move::CM_INVISIBLE) == 0) {
             monster.lit = true;
@@ -580,7 +580,7 @@ bool spellDetectMonsters() {
 
 // Update monster when light line spell touches it.
 static void spellLightLineTouchesMonster(int monster_id) {
-    Monster_t const &monster = monsters[monster_id];
+    Monster_t const &monster = session->monsters[monster_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
 
     // light up and draw monster
@@ -590,7 +590,7 @@ static void spellLightLineTouchesMonster(int monster_id) {
 
     if ((creature.defenses & config::monsters::defense::CD_LIGHT) != 0) {
         if (monster.lit) {
-            creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_LIGHT;
+            session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_LIGHT;
         }
 
         if (monsterTakeHit(monster_id, diceRoll(Dice_t{2, 8})) >= 0) {
@@ -610,7 +610,7 @@ void spellLightLine(Coord_t coord, int direction) {
     Coord_t tmp_coord = Coord_t{0, 0};
 
     while (!finished) {
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             (void) playerMovePosition(direction, coord);
@@ -629,6 +629,8 @@ void spellLightLine(Coord_t coord, int direction) {
             if (tile.feature_id == TILE_LIGHT_FLOOR) {
                 if (coordInsidePanel(tmp_coord)) {
                     dungeonLightRoom(tmp_coord);
+                } else {
+                    dungeonOverviewTouch(tmp_coord);
                 }
             } else {
                 dungeonLiteSpot(tmp_coord);
@@ -650,7 +652,7 @@ void spellLightLine(Coord_t coord, int direction) {
 
 // Light line in all directions -RAK-
 void spellStarlite(Coord_t coord) {
-    if (py.flags.blind < 1) {
+    if (session->py.flags.blind < 1) {
         printMessage("The end of the staff bursts into a blue shimmering light.");
     }
 
@@ -666,15 +668,15 @@ bool spellDisarmAllInDirection(Coord_t coord, int direction) {
     int distance = 0;
     bool disarmed = false;
 
-    Tile_t *tile = nullptr;
+    bool open_space;
 
     do {
-        tile = &dg.floor[coord.y][coord.x];
+        TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
         // note, must continue up to and including the first non open space,
         // because secret doors have feature_id greater than MAX_OPEN_SPACE
-        if (tile->treasure_id != 0) {
-            Inventory_t &item = game.treasure.list[tile->treasure_id];
+        if (tile.treasure_id != 0) {
+            Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
             if (item.category_id == TV_INVIS_TRAP || item.category_id == TV_VIS_TRAP) {
                 if (dungeonDeleteObject(coord)) {
@@ -684,7 +686,7 @@ bool spellDisarmAllInDirection(Coord_t coord, int direction) {
                 // Locked or jammed doors become merely closed.
                 item.misc_use = 0;
             } else if (item.category_id == TV_SECRET_DOOR) {
-                tile->field_mark = true;
+                tile.field_mark = true;
                 trapChangeVisibility(coord);
                 disarmed = true;
             } else if (item.category_id == TV_CHEST && item.flags != 0) {
@@ -698,11 +700,13 @@ bool spellDisarmAllInDirection(Coord_t coord, int direction) {
             }
         }
 
+        open_space = tile.feature_id <= MAX_OPEN_SPACE;
+
         // move must be at end because want to light up current spot
         (void) playerMovePosition(direction, coord);
 
         distance++;
-    } while (distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE && tile->feature_id <= MAX_OPEN_SPACE);
+    } while (distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE && open_space);
 
     return disarmed;
 }
@@ -750,6 +754,214 @@ static void spellGetAreaAffectFlags(int spell_type, uint32_t &weapon_type, int &
     }
 }
 
+// Balls and breaths affect every tile within their radius of the center
+// which can be seen from it. The tiles of each radius, and the tiles los()
+// would test to see them from the center, are worked out at compile time.
+constexpr int AREA_MAX_RADIUS = 3;
+constexpr int AREA_MAX_TILES = (2 * AREA_MAX_RADIUS + 1) * (2 * AREA_MAX_RADIUS + 1);
+constexpr int AREA_MAX_PATH = 2 * AREA_MAX_RADIUS;
+
+typedef struct {
+    Coord_t offset;
+    int distance;
+    int path_length;
+    Coord_t path[AREA_MAX_PATH]; // must all be open for the center to see this tile
+} AreaDiskTile_t;
+
+typedef struct {
+    int count;
+    AreaDiskTile_t tiles[AREA_MAX_TILES];
+} AreaDisk_t;
+
+typedef struct {
+    AreaDisk_t radius[AREA_MAX_RADIUS + 1];
+} AreaDisks_t;
+
+// Same as coordDistanceBetween()
+static constexpr int areaDistance(int dy, int dx) {
+    dy = dy < 0 ? -dy : dy;
+    dx = dx < 0 ? -dx : dx;
+    return (((dy + dx) << 1) - (dy > dx ? dx : dy)) >> 1;
+}
+
+static constexpr void areaPathAdd(AreaDiskTile_t &tile, int y, int x) {
+    tile.path[tile.path_length].y = y;
+    tile.path[tile.path_length].x = x;
+    tile.path_length++;
+}
+
+// Collects the tiles tested by los() from the center to the tile's offset.
+// Both follow the same steps, see los() for how this works.
+static constexpr void areaLineOfSightPath(AreaDiskTile_t &tile) {
+    int delta_y = tile.offset.y;
+    int delta_x = tile.offset.x;
+
+    if (delta_x < 2 && delta_x > -2 && delta_y < 2 && delta_y > -2) {
+        return;
+    }
+
+    if (delta_x == 0) {
+        int sign = delta_y < 0 ? -1 : 1;
+        for (int yy = sign; yy != delta_y; yy += sign) {
+            areaPathAdd(tile, yy, 0);
+        }
+        return;
+    }
+
+    if (delta_y == 0) {
+        int sign = delta_x < 0 ? -1 : 1;
+        for (int xx = sign; xx != delta_x; xx += sign) {
+            areaPathAdd(tile, 0, xx);
+        }
+        return;
+    }
+
+    int scale_half = delta_x * delta_y < 0 ? -(delta_x * delta_y) : delta_x * delta_y;
+    int scale = scale_half << 1;
+    int x_sign = delta_x < 0 ? -1 : 1;
+    int y_sign = delta_y < 0 ? -1 : 1;
+
+    if (delta_x * x_sign >= delta_y * y_sign) {
+        int dy = delta_y * delta_y;
+        int slope = dy << 1;
+        int xx = x_sign;
+        int yy = 0;
+
+        if (dy == scale_half) {
+            yy = y_sign;
+            dy -= scale;
+        }
+
+        while (delta_x - xx != 0) {
+            areaPathAdd(tile, yy, xx);
+
+            dy += slope;
+
+            if (dy < scale_half) {
+                xx += x_sign;
+            } else if (dy > scale_half) {
+                yy += y_sign;
+                areaPathAdd(tile, yy, xx);
+                xx += x_sign;
+                dy -= scale;
+            } else {
+                xx += x_sign;
+                yy += y_sign;
+                dy -= scale;
+            }
+        }
+        return;
+    }
+
+    int dx = delta_x * delta_x;
+    int slope = dx << 1;
+    int yy = y_sign;
+    int xx = 0;
+
+    if (dx == scale_half) {
+        xx = x_sign;
+        dx -= scale;
+    }
+
+    while (delta_y - yy != 0) {
+        areaPathAdd(tile, yy, xx);
+
+        dx += slope;
+
+        if (dx < scale_half) {
+            yy += y_sign;
+        } else if (dx > scale_half) {
+            xx += x_sign;
+            areaPathAdd(tile, yy, xx);
+            yy += y_sign;
+            dx -= scale;
+        } else {
+            xx += x_sign;
+            yy += y_sign;
+            dx -= scale;
+        }
+    }
+}
+
+static constexpr AreaDisks_t areaDisks() {
+    AreaDisks_t disks{};
+
+    for (int r = 0; r <= AREA_MAX_RADIUS; r++) {
+        AreaDisk_t &disk = disks.radius[r];
+
+        // Row by row, the order the tiles were always affected in
+        for (int y = -r; y <= r; y++) {
+            for (int x = -r; x <= r; x++) {
+                if (areaDistance(y, x) > r) {
+                    continue;
+                }
+
+                AreaDiskTile_t &tile = disk.tiles[disk.count];
+                tile.offset.y = y;
+                tile.offset.x = x;
+                tile.distance = areaDistance(y, x);
+                areaLineOfSightPath(tile);
+
+                disk.count++;
+            }
+        }
+    }
+
+    return disks;
+}
+
+static constexpr AreaDisks_t area_disks = areaDisks();
+
+// A tile hit by a ball or breath, and its distance from the center
+typedef struct {
+    Coord_t coord;
+    int distance;
+} AreaTile_t;
+
+// Finds the tiles within `radius` of the center that are in line of sight of
+// it. All are found before the effect is applied, so a door burnt down by
+// the blast does not let it through to the tiles behind.
+static int spellAreaOfEffect(Coord_t const &center, int radius, AreaTile_t *tiles) {
+    AreaDisk_t const &disk = area_disks.radius[radius];
+
+    int count = 0;
+
+    for (int i = 0; i < disk.count; i++) {
+        AreaDiskTile_t const &disk_tile = disk.tiles[i];
+        Coord_t coord = Coord_t{center.y + disk_tile.offset.y, center.x + disk_tile.offset.x};
+
+        if (!coordInBounds(coord)) {
+            continue;
+        }
+
+        bool visible = true;
+        for (int p = 0; visible && p < disk_tile.path_length; p++) {
+            visible = session->dg.floor[center.y + disk_tile.path[p].y][center.x + disk_tile.path[p].x].feature_id < MIN_CLOSED_SPACE;
+        }
+
+        if (visible) {
+            tiles[count].coord = coord;
+            tiles[count].distance = disk_tile.distance;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// Redraw the tiles of an area effect once it is over
+static void spellAreaOfEffectRedraw(Coord_t const &center, int radius) {
+    AreaDisk_t const &disk = area_disks.radius[radius];
+
+    for (int i = 0; i < disk.count; i++) {
+        Coord_t coord = Coord_t{center.y + disk.tiles[i].offset.y, center.x + disk.tiles[i].offset.x};
+
+        if (coordInBounds(coord) && coordInsidePanel(coord)) {
+            dungeonLiteSpot(coord);
+        }
+    }
+}
+
 static void printBoltStrikesMonsterMessage(Creature_t const &creature, const std::string &bolt_name, bool is_lit) {
     std::string monster_name;
     if (is_lit) {
@@ -762,8 +974,8 @@ static void printBoltStrikesMonsterMessage(Creature_t const &creature, const std
 }
 
 // Light up, draw, and check for monster damage when Fire Bolt touches it.
-static void spellFireBoltTouchesMonster(Tile_t &tile, int damage, int harm_type, uint32_t weapon_id, const std::string &bolt_name) {
-    Monster_t const &monster = monsters[tile.creature_id];
+static void spellFireBoltTouchesMonster(TileRef_t tile, int damage, int harm_type, uint32_t weapon_id, const std::string &bolt_name) {
+    Monster_t const &monster = session->monsters[tile.creature_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
 
     // light up monster and draw monster, temporarily set
@@ -781,12 +993,12 @@ static void spellFireBoltTouchesMonster(Tile_t &tile, int damage, int harm_type,
     if ((harm_type & creature.defenses) != 0) {
         damage = damage * 2;
         if (monster.lit) {
-            creature_recall[monster.creature_id].defenses |= harm_type;
+            session->creature_recall[monster.creature_id].defenses |= harm_type;
         }
     } else if ((weapon_id & creature.spells) != 0u) {
         damage = damage / 4;
         if (monster.lit) {
-            creature_recall[monster.creature_id].spells |= weapon_id;
+            session->creature_recall[monster.creature_id].spells |= weapon_id;
         }
     }
 
@@ -819,7 +1031,7 @@ void spellFireBolt(Coord_t coord, int direction, int damage_hp, int spell_type,
 
         distance++;
 
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
         dungeonLiteSpot(old_coord);
 
@@ -831,7 +1043,7 @@ void spellFireBolt(Coord_t coord, int direction, int damage_hp, int spell_type,
         if (tile.creature_id > 1) {
             finished = true;
             spellFireBoltTouchesMonster(tile, damage_hp, harm_type, weapon_type, spell_name);
-        } else if (coordInsidePanel(coord) && py.flags.blind < 1) {
+        } else if (coordInsidePanel(coord) && session->py.flags.blind < 1) {
             panelPutTile('*', coord);
 
             // show the bolt
@@ -871,12 +1083,12 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
             continue;
         }
 
-        Tile_t *tile = &dg.floor[coord.y][coord.x];
+        TileConstRef_t target = session->dg.floor[coord.y][coord.x];
 
-        if (tile->feature_id >= MIN_CLOSED_SPACE || tile->creature_id > 1) {
+        if (target.feature_id >= MIN_CLOSED_SPACE || target.creature_id > 1) {
             finished = true;
 
-            if (tile->feature_id >= MIN_CLOSED_SPACE) {
+            if (target.feature_id >= MIN_CLOSED_SPACE) {
                 coord.y = old_coord.y;
                 coord.x = old_coord.x;
             }
@@ -884,53 +1096,50 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
             // The ball hits and explodes.
 
             // The explosion.
-            for (int row = coord.y - max_distance; row <= coord.y + max_distance; row++) {
-                for (int col = coord.x - max_distance; col <= coord.x + max_distance; col++) {
-                    spot.y = row;
-                    spot.x = col;
+            AreaTile_t area[AREA_MAX_TILES];
+            int area_count = spellAreaOfEffect(coord, max_distance, area);
 
-                    if (coordInBounds(spot) && coordDistanceBetween(coord, spot) <= max_distance && los(coord, spot)) {
-                        tile = &dg.floor[spot.y][spot.x];
+            for (int i = 0; i < area_count; i++) {
+                spot = area[i].coord;
+                TileRef_t tile = session->dg.floor[spot.y][spot.x];
 
-                        if (tile->treasure_id != 0 && (*destroy)(&game.treasure.list[tile->treasure_id])) {
-                            (void) dungeonDeleteObject(spot);
-                        }
+                if (tile.treasure_id != 0 && (*destroy)(&session->game.treasure.list[tile.treasure_id])) {
+                    (void) dungeonDeleteObject(spot);
+                }
 
-                        if (tile->feature_id <= MAX_OPEN_SPACE) {
-                            if (tile->creature_id > 1) {
-                                Monster_t const &monster = monsters[tile->creature_id];
-                                Creature_t const &creature = creatures_list[monster.creature_id];
-
-                                // lite up creature if visible, temp set permanent_light so that monsterUpdateVisibility works
-                                bool saved_lit_status = tile->permanent_light;
-                                tile->permanent_light = true;
-                                monsterUpdateVisibility((int) tile->creature_id);
-
-                                total_hits++;
-                                int damage = damage_hp;
-
-                                if ((harm_type & creature.defenses) != 0) {
-                                    damage = damage * 2;
-                                    if (monster.lit) {
-                                        creature_recall[monster.creature_id].defenses |= harm_type;
-                                    }
-                                } else if ((weapon_type & creature.spells) != 0u) {
-                                    damage = damage / 4;
-                                    if (monster.lit) {
-                                        creature_recall[monster.creature_id].spells |= weapon_type;
-                                    }
-                                }
-
-                                damage = (damage / (coordDistanceBetween(spot, coord) + 1));
-
-                                if (monsterTakeHit((int) tile->creature_id, damage) >= 0) {
-                                    total_kills++;
-                                }
-                                tile->permanent_light = saved_lit_status;
-                            } else if (coordInsidePanel(spot) && py.flags.blind < 1) {
-                                panelPutTile('*', spot);
+                if (tile.feature_id <= MAX_OPEN_SPACE) {
+                    if (tile.creature_id > 1) {
+                        Monster_t const &monster = session->monsters[tile.creature_id];
+                        Creature_t const &creature = creatures_list[monster.creature_id];
+
+                        // lite up creature if visible, temp set permanent_light so that monsterUpdateVisibility works
+                        bool saved_lit_status = tile.permanent_light;
+                        tile.permanent_light = true;
+                        monsterUpdateVisibility((int) tile.creature_id);
+
+                        total_hits++;
+                        int damage = damage_hp;
+
+                        if ((harm_type & creature.defenses) != 0) {
+                            damage = damage * 2;
+                            if (monster.lit) {
+                                session->creature_recall[monster.creature_id].defenses |= harm_type;
+                            }
+                        } else if ((weapon_type & creature.spells) != 0u) {
+                            damage = damage / 4;
+                            if (monster.lit) {
+                                session->creature_recall[monster.creature_id].spells |= weapon_type;
                             }
                         }
+
+                        damage = (damage / (area[i].distance + 1));
+
+                        if (monsterTakeHit((int) tile.creature_id, damage) >= 0) {
+                            total_kills++;
+                        }
+                        tile.permanent_light = saved_lit_status;
+                    } else if (coordInsidePanel(spot) && session->py.flags.blind < 1) {
+                        panelPutTile('*', spot);
                     }
                 }
             }
@@ -938,16 +1147,7 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
             // show ball of whatever
             putQIO();
 
-            for (int row = (coord.y - 2); row <= (coord.y + 2); row++) {
-                for (int col = (coord.x - 2); col <= (coord.x + 2); col++) {
-                    spot.y = row;
-                    spot.x = col;
-
-                    if (coordInBounds(spot) && coordInsidePanel(spot) && coordDistanceBetween(coord, spot) <= max_distance) {
-                        dungeonLiteSpot(spot);
-                    }
-                }
-            }
+            spellAreaOfEffectRedraw(coord, max_distance);
             // End explosion.
 
             if (total_hits == 1) {
@@ -966,7 +1166,7 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
                 displayCharacterExperience();
             }
             // End ball hitting.
-        } else if (coordInsidePanel(coord) && py.flags.blind < 1) {
+        } else if (coordInsidePanel(coord) && session->py.flags.blind < 1) {
             panelPutTile('*', coord);
 
             // show bolt
@@ -975,6 +1175,25 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
     }
 }
 
+// What is left of a breath's damage at some distance from where it is aimed
+int spellBreathDamageAt(int damage_hp, int distance) {
+    int damage = (damage_hp / (distance + 1));
+
+    // let's do at least one point of damage
+    // prevents randomNumber(0) problem with damagePoisonedGas, also
+    if (damage == 0) {
+        damage = 1;
+    }
+
+    return damage;
+}
+
+// Hit points lost by the player to a breath aimed at them, as resolved by
+// spellBreath(), but without damaging the pack or armour, or poisoning.
+int spellBreathHitPointDamage(int damage_hp, int spell_type) {
+    return damageResisted(spell_type, spellBreathDamageAt(damage_hp, 0));
+}
+
 // Breath weapon works like a spellFireBall(), but affects the player.
 // Note the area affect. -RAK-
 void spellBreath(Coord_t coord, int monster_id, int damage_hp, int spell_type, const std::string &spell_name) {
@@ -985,96 +1204,89 @@ void spellBreath(Coord_t coord, int monster_id, int damage_hp, int spell_type, c
     uint32_t weapon_type;
     spellGetAreaAffectFlags(spell_type, weapon_type, harm_type, &destroy);
 
-    Coord_t location = Coord_t{0, 0};
+    AreaTile_t area[AREA_MAX_TILES];
+    int area_count = spellAreaOfEffect(coord, max_distance, area);
 
-    for (location.y = coord.y - 2; location.y <= coord.y + 2; location.y++) {
-        for (location.x = coord.x - 2; location.x <= coord.x + 2; location.x++) {
-            if (coordInBounds(location) && coordDistanceBetween(coord, location) <= max_distance && los(coord, location)) {
-                Tile_t const &tile = dg.floor[location.y][location.x];
+    for (int i = 0; i < area_count; i++) {
+        Coord_t const &location = area[i].coord;
+        TileConstRef_t tile = session->dg.floor[location.y][location.x];
 
-                if (tile.treasure_id != 0 && (*destroy)(&game.treasure.list[tile.treasure_id])) {
-                    (void) dungeonDeleteObject(location);
-                }
-
-                if (tile.feature_id <= MAX_OPEN_SPACE) {
-                    // must test status bit, not py.flags.blind here, flag could have
-                    // been set by a previous monster, but the breath should still
-                    // be visible until the blindness takes effect
-                    if (coordInsidePanel(location) && ((py.flags.status & config::player::status::PY_BLIND) == 0u)) {
-                        panelPutTile('*', location);
-                    }
+        if (tile.treasure_id != 0 && (*destroy)(&session->game.treasure.list[tile.treasure_id])) {
+            (void) dungeonDeleteObject(location);
+        }
 
-                    if (tile.creature_id > 1) {
-                        Monster_t &monster = monsters[tile.creature_id];
-                        Creature_t const &creature = creatures_list[monster.creature_id];
+        if (tile.feature_id <= MAX_OPEN_SPACE) {
+            // must test status bit, not py.flags.blind here, flag could have
+            // been set by a previous monster, but the breath should still
+            // be visible until the blindness takes effect
+            if (coordInsidePanel(location) && ((session->py.flags.status & config::player::status::PY_BLIND) == 0u)) {
+                panelPutTile('*', location);
+            }
 
-                        int damage = damage_hp;
+            if (tile.creature_id > 1) {
+                Monster_t &monster = session->monsters[tile.creature_id];
+                Creature_t const &creature = creatures_list[monster.creature_id];
 
-                        if ((harm_type & creature.defenses) != 0) {
-                            damage = damage * 2;
-                        } else if ((weapon_type & creature.spells) != 0u) {
-                            damage = (damage / 4);
-                        }
+                int damage = damage_hp;
 
-                        damage = (damage / (coordDistanceBetween(location, coord) + 1));
+                if ((harm_type & creature.defenses) != 0) {
+                    damage = damage * 2;
+                } else if ((weapon_type & creature.spells) != 0u) {
+                    damage = (damage / 4);
+                }
 
-                        // can not call monsterTakeHit here, since player does not
-                        // get experience for kill
-                        monster.hp = (int16_t)(monster.hp - damage);
-                        monster.sleep_count = 0;
+                damage = (damage / (area[i].distance + 1));
 
-                        if (monster.hp < 0) {
-                            uint32_t treasure_id = monsterDeath(Coord_t{monster.pos.y, monster.pos.x}, creature.movement);
+                // can not call monsterTakeHit here, since player does not
+                // get experience for kill
+                monster.hp = (int16_t)(monster.hp - damage);
+                monster.sleep_count = 0;
 
-                            if (monster.lit) {
-                                auto tmp = (uint32_t)((creature_recall[monster.creature_id].movement & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT);
-                                if (tmp > ((treasure_id & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT)) {
-                                    treasure_id = (uint32_t)((treasure_id & ~config::monsters::move::CM_TREASURE) | (tmp << config::monsters::move::CM_TR_SHIFT));
-                                }
-                                creature_recall[monster.creature_id].movement =
-                                    (uint32_t)(treasure_id | (creature_recall[monster.creature_id].movement & ~config::monsters::move::CM_TREASURE));
-                            }
+                if (monster.hp < 0) {
+                    uint32_t treasure_id = monsterDeath(Coord_t{monster.pos.y, monster.pos.x}, creature.movement);
 
-                            // It ate an already processed monster. Handle normally.
-                            if (monster_id < tile.creature_id) {
-                                dungeonDeleteMonster((int) tile.creature_id);
-                            } else {
-                                // If it eats this monster, an already processed monster
-                                // will take its place, causing all kinds of havoc.
-                                // Delay the kill a bit.
-                                dungeonRemoveMonsterFromLevel((int) tile.creature_id);
-                            }
-                        }
-                    } else if (tile.creature_id == 1) {
-                        int damage = (damage_hp / (coordDistanceBetween(location, coord) + 1));
-
-                        // let's do at least one point of damage
-                        // prevents randomNumber(0) problem with damagePoisonedGas, also
-                        if (damage == 0) {
-                            damage = 1;
+                    if (monster.lit) {
+                        auto tmp =
+                            (uint32_t)((session->creature_recall[monster.creature_id].movement & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT);
+                        if (tmp > ((treasure_id & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT)) {
+                            treasure_id = (uint32_t)((treasure_id & ~config::monsters::move::CM_TREASURE) | (tmp << config::monsters::move::CM_TR_SHIFT));
                         }
+                        session->creature_recall[monster.creature_id].movement =
+                            (uint32_t)(treasure_id | (session->creature_recall[monster.creature_id].movement & ~config::monsters::move::CM_TREASURE));
+                    }
 
-                        switch (spell_type) {
-                            case MagicSpellFlags::Lightning:
-                                damageLightningBolt(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::PoisonGas:
-                                damagePoisonedGas(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::Acid:
-                                damageAcid(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::Frost:
-                                damageCold(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::Fire:
-                                damageFire(damage, spell_name.c_str());
-                                break;
-                            default:
-                                break;
-                        }
+                    // It ate an already processed monster. Handle normally.
+                    if (monster_id < tile.creature_id) {
+                        dungeonDeleteMonster((int) tile.creature_id);
+                    } else {
+                        // If it eats this monster, an already processed monster
+                        // will take its place, causing all kinds of havoc.
+                        // Delay the kill a bit.
+                        dungeonRemoveMonsterFromLevel((int) tile.creature_id);
                     }
                 }
+            } else if (tile.creature_id == 1) {
+                int damage = spellBreathDamageAt(damage_hp, area[i].distance);
+
+                switch (spell_type) {
+                    case MagicSpellFlags::Lightning:
+                        damageLightningBolt(damage, spell_name.c_str());
+                        break;
+                    case MagicSpellFlags::PoisonGas:
+                        damagePoisonedGas(damage, spell_name.c_str());
+                        break;
+                    case MagicSpellFlags::Acid:
+                        damageAcid(damage, spell_name.c_str());
+                        break;
+                    case MagicSpellFlags::Frost:
+                        damageCold(damage, spell_name.c_str());
+                        break;
+                    case MagicSpellFlags::Fire:
+                        damageFire(damage, spell_name.c_str());
+                        break;
+                    default:
+                        break;
+                }
             }
         }
     }
@@ -1082,14 +1294,7 @@ void spellBreath(Coord_t coord, int monster_id, int damage_hp, int spell_type, c
     // show the ball of gas
     putQIO();
 
-    Coord_t spot = Coord_t{0, 0};
-    for (spot.y = (coord.y - 2); spot.y <= (coord.y + 2); spot.y++) {
-        for (spot.x = (coord.x - 2); spot.x <= (coord.x + 2); spot.x++) {
-            if (coordInBounds(spot) && coordInsidePanel(spot) && coordDistanceBetween(coord, spot) <= max_distance) {
-                dungeonLiteSpot(spot);
-            }
-        }
-    }
+    spellAreaOfEffectRedraw(coord, max_distance);
 }
 
 // Recharge a wand, staff, or rod.  Sometimes the item breaks. -RAK-
@@ -1105,7 +1310,7 @@ bool spellRechargeItem(int number_of_charges) {
         return false;
     }
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     // recharge  I = recharge(20) = 1/6  failure for empty 10th level wand
     // recharge II = recharge(60) = 1/10 failure for empty 10th level wand
@@ -1149,7 +1354,7 @@ bool spellChangeMonsterHitPoints(Coord_t coord, int direction, int damage_hp) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1159,7 +1364,7 @@ bool spellChangeMonsterHitPoints(Coord_t coord, int direction, int damage_hp) {
         if (tile.creature_id > 1) {
             finished = true;
 
-            Monster_t const &monster = monsters[tile.creature_id];
+            Monster_t const &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             auto name = monsterNameDescription(creature.name, monster.lit);
@@ -1188,7 +1393,7 @@ bool spellDrainLifeFromMonster(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1198,7 +1403,7 @@ bool spellDrainLifeFromMonster(Coord_t coord, int direction) {
         if (tile.creature_id > 1) {
             finished = true;
 
-            Monster_t const &monster = monsters[tile.creature_id];
+            Monster_t const &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             if ((creature.defenses & config::monsters::defense::CD_UNDEAD) == 0) {
@@ -1213,7 +1418,7 @@ bool spellDrainLifeFromMonster(Coord_t coord, int direction) {
 
                 drained = true;
             } else {
-                creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_UNDEAD;
+                session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_UNDEAD;
             }
         }
     }
@@ -1232,7 +1437,7 @@ bool spellSpeedMonster(Coord_t coord, int direction, int speed) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1242,7 +1447,7 @@ bool spellSpeedMonster(Coord_t coord, int direction, int speed) {
         if (tile.creature_id > 1) {
             finished = true;
 
-            Monster_t &monster = monsters[tile.creature_id];
+            Monster_t &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             auto name = monsterNameDescription(creature.name, monster.lit);
@@ -1282,7 +1487,7 @@ bool spellConfuseMonster(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1292,14 +1497,14 @@ bool spellConfuseMonster(Coord_t coord, int direction) {
         if (tile.creature_id > 1) {
             finished = true;
 
-            Monster_t &monster = monsters[tile.creature_id];
+            Monster_t &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             auto name = monsterNameDescription(creature.name, monster.lit);
 
             if (randomNumber(MON_MAX_LEVELS) < creature.level || ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0)) {
                 if (monster.lit && ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0)) {
-                    creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
+                    session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
                 }
 
                 // Monsters which resisted the attack should wake up.
@@ -1337,7 +1542,7 @@ bool spellSleepMonster(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1347,14 +1552,14 @@ bool spellSleepMonster(Coord_t coord, int direction) {
         if (tile.creature_id > 1) {
             finished = true;
 
-            Monster_t &monster = monsters[tile.creature_id];
+            Monster_t &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             auto name = monsterNameDescription(creature.name, monster.lit);
 
             if (randomNumber(MON_MAX_LEVELS) < creature.level || ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0)) {
                 if (monster.lit && ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0)) {
-                    creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
+                    session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
                 }
 
                 printMonsterActionText(name, "is unaffected.");
@@ -1381,7 +1586,7 @@ bool spellWallToMud(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         // note, this ray can move through walls as it turns them to mud
         if (distance == config::treasure::OBJECT_BOLTS_MAX_RANGE) {
@@ -1404,14 +1609,14 @@ bool spellWallToMud(Coord_t coord, int direction) {
                 turned = true;
 
                 obj_desc_t description = {'\0'};
-                itemDescription(description, game.treasure.list[tile.treasure_id], false);
+                itemDescription(description, session->game.treasure.list[tile.treasure_id], false);
 
                 obj_desc_t out_val = {'\0'};
                 (void) sprintf(out_val, "The %s turns into mud.", description);
                 printMessage(out_val);
             }
 
-            if (game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
+            if (session->game.treasure.list[tile.treasure_id].category_id == TV_RUBBLE) {
                 (void) dungeonDeleteObject(coord);
                 if (randomNumber(10) == 1) {
                     dungeonPlaceRandomObjectAt(coord, false);
@@ -1426,7 +1631,7 @@ bool spellWallToMud(Coord_t coord, int direction) {
         }
 
         if (tile.creature_id > 1) {
-            Monster_t const &monster = monsters[tile.creature_id];
+            Monster_t const &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             if ((creature.defenses & config::monsters::defense::CD_STONE) != 0) {
@@ -1435,11 +1640,11 @@ bool spellWallToMud(Coord_t coord, int direction) {
                 // Should get these messages even if the monster is not visible.
                 int creature_id = monsterTakeHit((int) tile.creature_id, 100);
                 if (creature_id >= 0) {
-                    creature_recall[creature_id].defenses |= config::monsters::defense::CD_STONE;
+                    session->creature_recall[creature_id].defenses |= config::monsters::defense::CD_STONE;
                     printMonsterActionText(name, "dissolves!");
                     displayCharacterExperience(); // print msg before calling prt_exp
                 } else {
-                    creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_STONE;
+                    session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_STONE;
                     printMonsterActionText(name, "grunts in pain!");
                 }
                 finished = true;
@@ -1455,17 +1660,17 @@ bool spellDestroyDoorsTrapsInDirection(Coord_t coord, int direction) {
     bool destroyed = false;
     int distance = 0;
 
-    Tile_t *tile = nullptr;
+    bool open_space;
 
     do {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        tile = &dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         // must move into first closed spot, as it might be a secret door
-        if (tile->treasure_id != 0) {
-            Inventory_t &item = game.treasure.list[tile->treasure_id];
+        if (tile.treasure_id != 0) {
+            Inventory_t &item = session->game.treasure.list[tile.treasure_id];
 
             if (item.category_id == TV_INVIS_TRAP || item.category_id == TV_CLOSED_DOOR || item.category_id == TV_VIS_TRAP || item.category_id == TV_OPEN_DOOR ||
                 item.category_id == TV_SECRET_DOOR) {
@@ -1483,7 +1688,9 @@ bool spellDestroyDoorsTrapsInDirection(Coord_t coord, int direction) {
                 spellItemIdentifyAndRemoveRandomInscription(item);
             }
         }
-    } while ((distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE) || tile->feature_id <= MAX_OPEN_SPACE);
+
+        open_space = tile.feature_id <= MAX_OPEN_SPACE;
+    } while ((distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE) || open_space);
 
     return destroyed;
 }
@@ -1499,7 +1706,7 @@ bool spellPolymorphMonster(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1507,7 +1714,7 @@ bool spellPolymorphMonster(Coord_t coord, int direction) {
         }
 
         if (tile.creature_id > 1) {
-            Monster_t const &monster = monsters[tile.creature_id];
+            Monster_t const &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             if (randomNumber(MON_MAX_LEVELS) > creature.level) {
@@ -1542,7 +1749,7 @@ bool spellBuildWall(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1556,7 +1763,7 @@ bool spellBuildWall(Coord_t coord, int direction) {
         if (tile.creature_id > 1) {
             finished = true;
 
-            Monster_t &monster = monsters[tile.creature_id];
+            Monster_t &monster = session->monsters[tile.creature_id];
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             if ((creature.movement & config::monsters::move::CM_PHASE) == 0u) {
@@ -1586,6 +1793,7 @@ bool spellBuildWall(Coord_t coord, int direction) {
 
         tile.feature_id = TILE_MAGMA_WALL;
         tile.field_mark = false;
+        dungeonFloorTileChanged(coord);
 
         // Permanently light this wall if it is lit by player's lamp.
         tile.permanent_light = (tile.temporary_light || tile.permanent_light);
@@ -1606,15 +1814,15 @@ bool spellCloneMonster(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
         } else if (tile.creature_id > 1) {
-            monsters[tile.creature_id].sleep_count = 0;
+            session->monsters[tile.creature_id].sleep_count = 0;
 
             // monptr of 0 is safe here, since can't reach here from creatures
-            return monsterMultiply(coord, (int) monsters[tile.creature_id].creature_id, 0);
+            return monsterMultiply(coord, (int) session->monsters[tile.creature_id].creature_id, 0);
         }
     }
 
@@ -1626,7 +1834,7 @@ void spellTeleportAwayMonster(int monster_id, int distance_from_player) {
     int counter = 0;
 
     Coord_t coord = Coord_t{0, 0};
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
 
     do {
         do {
@@ -1639,7 +1847,7 @@ void spellTeleportAwayMonster(int monster_id, int distance_from_player) {
             counter = 0;
             distance_from_player += 5;
         }
-    } while ((dg.floor[coord.y][coord.x].feature_id >= MIN_CLOSED_SPACE) || (dg.floor[coord.y][coord.x].creature_id != 0));
+    } while ((session->dg.floor[coord.y][coord.x].feature_id >= MIN_CLOSED_SPACE) || (session->dg.floor[coord.y][coord.x].creature_id != 0));
 
     dungeonMoveCreatureRecord(Coord_t{monster.pos.y, monster.pos.x}, coord);
     dungeonLiteSpot(Coord_t{monster.pos.y, monster.pos.x});
@@ -1650,7 +1858,7 @@ void spellTeleportAwayMonster(int monster_id, int distance_from_player) {
     // this is necessary, because the creature is
     // not currently visible in its new position.
     monster.lit = false;
-    monster.distance_from_player = (uint8_t) coordDistanceBetween(py.pos, coord);
+    monster.distance_from_player = (uint8_t) coordDistanceBetween(session->py.pos, coord);
 
     monsterUpdateVisibility(monster_id);
 }
@@ -1670,22 +1878,16 @@ void spellTeleportPlayerTo(Coord_t coord) {
             counter = 0;
             distance++;
         }
-    } while (!coordInBounds(rnd_coord) || (dg.floor[rnd_coord.y][rnd_coord.x].feature_id >= MIN_CLOSED_SPACE) || (dg.floor[rnd_coord.y][rnd_coord.x].creature_id >= 2));
-
-    dungeonMoveCreatureRecord(py.pos, rnd_coord);
+    } while (!coordInBounds(rnd_coord) || (session->dg.floor[rnd_coord.y][rnd_coord.x].feature_id >= MIN_CLOSED_SPACE) ||
+             (session->dg.floor[rnd_coord.y][rnd_coord.x].creature_id >= 2));
 
-    Coord_t spot = Coord_t{0, 0};
-    for (spot.y = py.pos.y - 1; spot.y <= py.pos.y + 1; spot.y++) {
-        for (spot.x = py.pos.x - 1; spot.x <= py.pos.x + 1; spot.x++) {
-            dg.floor[spot.y][spot.x].temporary_light = false;
-            dungeonLiteSpot(spot);
-        }
-    }
+    dungeonMoveCreatureRecord(session->py.pos, rnd_coord);
 
-    dungeonLiteSpot(py.pos);
+    dungeonLampLightOff(session->py.pos);
+    dungeonLiteSpot(session->py.pos);
 
-    py.pos.y = rnd_coord.y;
-    py.pos.x = rnd_coord.x;
+    session->py.pos.y = rnd_coord.y;
+    session->py.pos.x = rnd_coord.x;
 
     dungeonResetView();
 
@@ -1703,7 +1905,7 @@ bool spellTeleportAwayMonsterInDirection(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t const &tile = dg.floor[coord.y][coord.x];
+        TileConstRef_t tile = session->dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1712,7 +1914,7 @@ bool spellTeleportAwayMonsterInDirection(Coord_t coord, int direction) {
 
         if (tile.creature_id > 1) {
             // wake it up
-            monsters[tile.creature_id].sleep_count = 0;
+            session->monsters[tile.creature_id].sleep_count = 0;
 
             spellTeleportAwayMonster((int) tile.creature_id, config::monsters::MON_MAX_SIGHT);
 
@@ -1728,8 +1930,8 @@ bool spellTeleportAwayMonsterInDirection(Coord_t coord, int direction) {
 bool spellMassGenocide() {
     bool killed = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t const &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t const &monster = session->monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
         if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && (creature.movement & config::monsters::move::CM_WIN) == 0) {
@@ -1752,8 +1954,8 @@ bool spellGenocide() {
 
     bool killed = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t const &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t const &monster = session->monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
         if (creature_char == creatures_list[monster.creature_id].sprite) {
@@ -1777,13 +1979,13 @@ bool spellGenocide() {
 bool spellSpeedAllMonsters(int speed) {
     bool speedy = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t &monster = session->monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
         auto name = monsterNameDescription(creature.name, monster.lit);
 
-        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !los(py.pos, monster.pos)) {
+        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !los(session->py.pos, monster.pos)) {
             continue; // do nothing
         }
 
@@ -1816,20 +2018,20 @@ bool spellSpeedAllMonsters(int speed) {
 bool spellSleepAllMonsters() {
     bool asleep = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t &monster = session->monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
         auto name = monsterNameDescription(creature.name, monster.lit);
 
-        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !los(py.pos, monster.pos)) {
+        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !los(session->py.pos, monster.pos)) {
             continue; // do nothing
         }
 
         if (randomNumber(MON_MAX_LEVELS) < creature.level || ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0)) {
             if (monster.lit) {
                 if ((creature.defenses & config::monsters::defense::CD_NO_SLEEP) != 0) {
-                    creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
+                    session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_NO_SLEEP;
                 }
                 printMonsterActionText(name, "is unaffected.");
             }
@@ -1851,8 +2053,8 @@ bool spellMassPolymorph() {
     bool morphed = false;
     Coord_t coord = Coord_t{0, 0};
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t const &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t const &monster = session->monsters[id];
 
         if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT) {
             Creature_t const &creature = creatures_list[monster.creature_id];
@@ -1875,8 +2077,8 @@ bool spellMassPolymorph() {
 bool spellDetectEvil() {
     bool detected = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t &monster = session->monsters[id];
 
         if (coordInsidePanel(Coord_t{monster.pos.y, monster.pos.x}) && ((creatures_list[monster.creature_id].defenses & config::monsters::defense::CD_EVIL) != 0)) {
             monster.lit = true;
@@ -1901,14 +2103,14 @@ bool spellDetectEvil() {
 
 // Change players hit points in some manner -RAK-
 bool spellChangePlayerHitPoints(int adjustment) {
-    if (py.misc.current_hp >= py.misc.max_hp) {
+    if (session->py.misc.current_hp >= session->py.misc.max_hp) {
         return false;
     }
 
-    py.misc.current_hp += adjustment;
-    if (py.misc.current_hp > py.misc.max_hp) {
-        py.misc.current_hp = py.misc.max_hp;
-        py.misc.current_hp_fraction = 0;
+    session->py.misc.current_hp += adjustment;
+    if (session->py.misc.current_hp > session->py.misc.max_hp) {
+        session->py.misc.current_hp = session->py.misc.max_hp;
+        session->py.misc.current_hp_fraction = 0;
     }
     printCharacterCurrentHitPoints();
 
@@ -1932,7 +2134,7 @@ bool spellChangePlayerHitPoints(int adjustment) {
 }
 
 static void earthquakeHitsMonster(int monster_id) {
-    Monster_t &monster = monsters[monster_id];
+    Monster_t &monster = session->monsters[monster_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
 
     if ((creature.movement & config::monsters::move::CM_PHASE) == 0u) {
@@ -1965,10 +2167,10 @@ static void earthquakeHitsMonster(int monster_id) {
 void spellEarthquake() {
     Coord_t coord = Coord_t{0, 0};
 
-    for (coord.y = py.pos.y - 8; coord.y <= py.pos.y + 8; coord.y++) {
-        for (coord.x = py.pos.x - 8; coord.x <= py.pos.x + 8; coord.x++) {
-            if ((coord.y != py.pos.y || coord.x != py.pos.x) && coordInBounds(coord) && randomNumber(8) == 1) {
-                Tile_t &tile = dg.floor[coord.y][coord.x];
+    for (coord.y = session->py.pos.y - 8; coord.y <= session->py.pos.y + 8; coord.y++) {
+        for (coord.x = session->py.pos.x - 8; coord.x <= session->py.pos.x + 8; coord.x++) {
+            if ((coord.y != session->py.pos.y || coord.x != session->py.pos.x) && coordInBounds(coord) && randomNumber(8) == 1) {
+                TileRef_t tile = session->dg.floor[coord.y][coord.x];
 
                 if (tile.treasure_id != 0) {
                     (void) dungeonDeleteObject(coord);
@@ -1995,6 +2197,7 @@ void spellEarthquake() {
 
                     tile.field_mark = false;
                 }
+                dungeonFloorTileChanged(coord);
                 dungeonLiteSpot(coord);
             }
         }
@@ -2005,20 +2208,20 @@ void spellEarthquake() {
 void spellCreateFood() {
     // Note: must take reference to this location as dungeonPlaceRandomObjectAt()
     // below, changes the tile values.
-    Tile_t const &tile = dg.floor[py.pos.y][py.pos.x];
+    TileConstRef_t tile = session->dg.floor[session->py.pos.y][session->py.pos.x];
 
     // take no action here, don't want to destroy object under player
     if (tile.treasure_id != 0) {
         // set player_free_turn so that scroll/spell points won't be used
-        game.player_free_turn = true;
+        session->game.player_free_turn = true;
 
         printMessage("There is already an object under you.");
 
         return;
     }
 
-    dungeonPlaceRandomObjectAt(py.pos, false);
-    inventoryItemCopyTo(config::dungeon::objects::OBJ_MUSH, game.treasure.list[tile.treasure_id]);
+    dungeonPlaceRandomObjectAt(session->py.pos, false);
+    inventoryItemCopyTo(config::dungeon::objects::OBJ_MUSH, session->game.treasure.list[tile.treasure_id]);
 }
 
 // Attempts to destroy a type of creature.  Success depends on
@@ -2026,14 +2229,14 @@ void spellCreateFood() {
 bool spellDispelCreature(int creature_defense, int damage) {
     bool dispelled = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t const &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t const &monster = session->monsters[id];
 
         if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((creature_defense & creatures_list[monster.creature_id].defenses) != 0) &&
-            los(py.pos, monster.pos)) {
+            los(session->py.pos, monster.pos)) {
             Creature_t const &creature = creatures_list[monster.creature_id];
 
-            creature_recall[monster.creature_id].defenses |= creature_defense;
+            session->creature_recall[monster.creature_id].defenses |= creature_defense;
 
             dispelled = true;
 
@@ -2061,23 +2264,24 @@ bool spellDispelCreature(int creature_defense, int damage) {
 bool spellTurnUndead() {
     bool turned = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    for (int id = session->next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        Monster_t &monster = session->monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
-        if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((creature.defenses & config::monsters::defense::CD_UNDEAD) != 0) && los(py.pos, monster.pos)) {
+        if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((creature.defenses & config::monsters::defense::CD_UNDEAD) != 0) &&
+            los(session->py.pos, monster.pos)) {
             auto name = monsterNameDescription(creature.name, monster.lit);
 
-            if (py.misc.level + 1 > creature.level || randomNumber(5) == 1) {
+            if (session->py.misc.level + 1 > creature.level || randomNumber(5) == 1) {
                 if (monster.lit) {
-                    creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_UNDEAD;
+                    session->creature_recall[monster.creature_id].defenses |= config::monsters::defense::CD_UNDEAD;
 
                     turned = true;
 
                     printMonsterActionText(name, "runs frantically!");
                 }
 
-                monster.confused_amount = (uint8_t) py.misc.level;
+                monster.confused_amount = (uint8_t) session->py.misc.level;
             } else if (monster.lit) {
                 printMonsterActionText(name, "is unaffected.");
             }
@@ -2089,16 +2293,16 @@ bool spellTurnUndead() {
 
 // Leave a glyph of warding. Creatures will not pass over! -RAK-
 void spellWardingGlyph() {
-    if (dg.floor[py.pos.y][py.pos.x].treasure_id == 0) {
+    if (session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id == 0) {
         int free_id = popt();
-        dg.floor[py.pos.y][py.pos.x].treasure_id = (uint8_t) free_id;
-        inventoryItemCopyTo(config::dungeon::objects::OBJ_SCARE_MON, game.treasure.list[free_id]);
+        session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id = (uint8_t) free_id;
+        inventoryItemCopyTo(config::dungeon::objects::OBJ_SCARE_MON, session->game.treasure.list[free_id]);
     }
 }
 
 // Lose a strength point. -RAK-
 void spellLoseSTR() {
-    if (!py.flags.sustain_str) {
+    if (!session->py.flags.sustain_str) {
         (void) playerStatRandomDecrease(PlayerAttr::A_STR);
         printMessage("You feel very sick.");
     } else {
@@ -2108,7 +2312,7 @@ void spellLoseSTR() {
 
 // Lose an intelligence point. -RAK-
 void spellLoseINT() {
-    if (!py.flags.sustain_int) {
+    if (!session->py.flags.sustain_int) {
         (void) playerStatRandomDecrease(PlayerAttr::A_INT);
         printMessage("You become very dizzy.");
     } else {
@@ -2118,7 +2322,7 @@ void spellLoseINT() {
 
 // Lose a wisdom point. -RAK-
 void spellLoseWIS() {
-    if (!py.flags.sustain_wis) {
+    if (!session->py.flags.sustain_wis) {
         (void) playerStatRandomDecrease(PlayerAttr::A_WIS);
         printMessage("You feel very naive.");
     } else {
@@ -2128,7 +2332,7 @@ void spellLoseWIS() {
 
 // Lose a dexterity point. -RAK-
 void spellLoseDEX() {
-    if (!py.flags.sustain_dex) {
+    if (!session->py.flags.sustain_dex) {
         (void) playerStatRandomDecrease(PlayerAttr::A_DEX);
         printMessage("You feel very sore.");
     } else {
@@ -2138,7 +2342,7 @@ void spellLoseDEX() {
 
 // Lose a constitution point. -RAK-
 void spellLoseCON() {
-    if (!py.flags.sustain_con) {
+    if (!session->py.flags.sustain_con) {
         (void) playerStatRandomDecrease(PlayerAttr::A_CON);
         printMessage("You feel very sick.");
     } else {
@@ -2148,7 +2352,7 @@ void spellLoseCON() {
 
 // Lose a charisma point. -RAK-
 void spellLoseCHR() {
-    if (!py.flags.sustain_chr) {
+    if (!session->py.flags.sustain_chr) {
         (void) playerStatRandomDecrease(PlayerAttr::A_CHR);
         printMessage("Your skin starts to itch.");
     } else {
@@ -2158,27 +2362,27 @@ void spellLoseCHR() {
 
 // Lose experience -RAK-
 void spellLoseEXP(int32_t adjustment) {
-    if (adjustment > py.misc.exp) {
-        py.misc.exp = 0;
+    if (adjustment > session->py.misc.exp) {
+        session->py.misc.exp = 0;
     } else {
-        py.misc.exp -= adjustment;
+        session->py.misc.exp -= adjustment;
     }
     displayCharacterExperience();
 
     int exp = 0;
-    while ((signed) (py.base_exp_levels[exp] * py.misc.experience_factor / 100) <= py.misc.exp) {
+    while ((signed) (session->py.base_exp_levels[exp] * session->py.misc.experience_factor / 100) <= session->py.misc.exp) {
         exp++;
     }
 
     // increment exp once more, because level 1 exp is stored in player_base_exp_levels[0]
     exp++;
 
-    if (py.misc.level != exp) {
-        py.misc.level = (uint16_t) exp;
+    if (session->py.misc.level != exp) {
+        session->py.misc.level = (uint16_t) exp;
 
         playerCalculateHitPoints();
 
-        Class_t const &character_class = classes[py.misc.class_id];
+        Class_t const &character_class = classes[session->py.misc.class_id];
 
         if (character_class.class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
             playerCalculateAllowedSpellsCount(PlayerAttr::A_INT);
@@ -2194,10 +2398,10 @@ void spellLoseEXP(int32_t adjustment) {
 
 // Slow Poison -RAK-
 bool spellSlowPoison() {
-    if (py.flags.poisoned > 0) {
-        py.flags.poisoned = (int16_t)(py.flags.poisoned / 2);
-        if (py.flags.poisoned < 1) {
-            py.flags.poisoned = 1;
+    if (session->py.flags.poisoned > 0) {
+        session->py.flags.poisoned = (int16_t)(session->py.flags.poisoned / 2);
+        if (session->py.flags.poisoned < 1) {
+            session->py.flags.poisoned = 1;
         }
         printMessage("The effect of the poison has been reduced.");
         return true;
@@ -2207,7 +2411,8 @@ bool spellSlowPoison() {
 }
 
 static void replaceSpot(Coord_t coord, int typ) {
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    TileRef_t tile = session->dg.floor[coord.y][coord.x];
+    dungeonOverviewTouch(coord);
 
     switch (typ) {
         case 1:
@@ -2237,6 +2442,7 @@ static void replaceSpot(Coord_t coord, int typ) {
     tile.permanent_light = false;
     tile.field_mark = false;
     tile.perma_lit_room = false; // this is no longer part of a room
+    dungeonFloorTileChanged(coord);
 
     if (tile.treasure_id != 0) {
         (void) dungeonDeleteObject(coord);
@@ -2252,12 +2458,12 @@ static void replaceSpot(Coord_t coord, int typ) {
 //   Winning creatures that are deleted will be considered as teleporting to another level.
 //   This will NOT win the game.
 void spellDestroyArea(Coord_t coord) {
-    if (dg.current_level > 0) {
+    if (session->dg.current_level > 0) {
         Coord_t spot = Coord_t{0, 0};
 
         for (spot.y = coord.y - 15; spot.y <= coord.y + 15; spot.y++) {
             for (spot.x = coord.x - 15; spot.x <= coord.x + 15; spot.x++) {
-                if (coordInBounds(spot) && dg.floor[spot.y][spot.x].feature_id != TILE_BOUNDARY_WALL) {
+                if (coordInBounds(spot) && session->dg.floor[spot.y][spot.x].feature_id != TILE_BOUNDARY_WALL) {
                     int distance = coordDistanceBetween(spot, coord);
 
                     // clear player's spot, but don't put wall there
@@ -2274,7 +2480,7 @@ void spellDestroyArea(Coord_t coord) {
     }
 
     printMessage("There is a searing blast of light!");
-    py.flags.blind += 10 + randomNumber(10);
+    session->py.flags.blind += 10 + randomNumber(10);
 }
 
 // Enchants a plus onto an item. -RAK-
@@ -2322,12 +2528,12 @@ bool spellRemoveCurseFromAllWornItems() {
 
 // Restores any drained experience -RAK-
 bool spellRestorePlayerLevels() {
-    if (py.misc.max_exp > py.misc.exp) {
+    if (session->py.misc.max_exp > session->py.misc.exp) {
         printMessage("You feel your life energies returning.");
 
         // this while loop is not redundant, ptr_exp may reduce the exp level
-        while (py.misc.exp < py.misc.max_exp) {
-            py.misc.exp = py.misc.max_exp;
+        while (session->py.misc.exp < session->py.misc.max_exp) {
+            session->py.misc.exp = session->py.misc.max_exp;
             displayCharacterExperience();
         }
 
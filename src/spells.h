@@ -50,6 +50,8 @@ void spellStarlite(Coord_t coord);
 bool spellDisarmAllInDirection(Coord_t coord, int direction);
 void spellFireBolt(Coord_t coord, int direction, int damage_hp, int spell_type, const std::string &spell_name);
 void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type, const std::string &spell_name);
+int spellBreathDamageAt(int damage_hp, int distance);
+int spellBreathHitPointDamage(int damage_hp, int spell_type);
 void spellBreath(Coord_t coord, int monster_id, int damage_hp, int spell_type, const std::string &spell_name);
 bool spellRechargeItem(int number_of_charges);
 bool spellChangeMonsterHitPoints(Coord_t coord, int direction, int damage_hp);
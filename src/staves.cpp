@@ -36,7 +36,7 @@ enum class StaffSpellTypes {
 };
 
 static bool staffPlayerIsCarrying(int &item_pos_start, int &item_pos_end) {
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("But you are not carrying anything.");
         return false;
     }
@@ -50,12 +50,12 @@ static bool staffPlayerIsCarrying(int &item_pos_start, int &item_pos_end) {
 }
 
 static bool staffPlayerCanUse(Inventory_t &item) {
-    int chance = py.misc.saving_throw;
+    int chance = session->py.misc.saving_throw;
     chance += playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT);
     chance -= item.depth_first_found - 5;
-    chance += class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DEVICE] * py.misc.level / 3;
+    chance += class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DEVICE] * session->py.misc.level / 3;
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         chance = chance / 2;
     }
 
@@ -93,7 +93,7 @@ static bool staffDischarge(Inventory_t &item) {
     while (flags != 0) {
         switch ((StaffSpellTypes)(getAndClearFirstBit(flags) + 1)) {
             case StaffSpellTypes::StaffLight:
-                identified = spellLightArea(py.pos);
+                identified = spellLightArea(session->py.pos);
                 break;
             case StaffSpellTypes::DetectDoorsStairs:
                 identified = spellDetectSecretDoorssWithinVicinity();
@@ -119,17 +119,17 @@ static bool staffDischarge(Inventory_t &item) {
                 identified = false;
 
                 for (int i = 0; i < randomNumber(4); i++) {
-                    Coord_t coord = py.pos;
+                    Coord_t coord = session->py.pos;
                     identified |= monsterSummon(coord, false);
                 }
                 break;
             case StaffSpellTypes::Destruction:
                 identified = true;
-                spellDestroyArea(py.pos);
+                spellDestroyArea(session->py.pos);
                 break;
             case StaffSpellTypes::Starlight:
                 identified = true;
-                spellStarlite(py.pos);
+                spellStarlite(session->py.pos);
                 break;
             case StaffSpellTypes::HasteMonsters:
                 identified = spellSpeedAllMonsters(1);
@@ -147,23 +147,23 @@ static bool staffDischarge(Inventory_t &item) {
                 identified = spellDetectInvisibleCreaturesWithinVicinity();
                 break;
             case StaffSpellTypes::Speed:
-                if (py.flags.fast == 0) {
+                if (session->py.flags.fast == 0) {
                     identified = true;
                 }
-                py.flags.fast += randomNumber(30) + 15;
+                session->py.flags.fast += randomNumber(30) + 15;
                 break;
             case StaffSpellTypes::Slowness:
-                if (py.flags.slow == 0) {
+                if (session->py.flags.slow == 0) {
                     identified = true;
                 }
-                py.flags.slow += randomNumber(30) + 15;
+                session->py.flags.slow += randomNumber(30) + 15;
                 break;
             case StaffSpellTypes::MassPolymorph:
                 identified = spellMassPolymorph();
                 break;
             case StaffSpellTypes::RemoveCurse:
                 if (spellRemoveCurseFromAllWornItems()) {
-                    if (py.flags.blind < 1) {
+                    if (session->py.flags.blind < 1) {
                         printMessage("The staff glows blue for a moment..");
                     }
                     identified = true;
@@ -181,7 +181,7 @@ static bool staffDischarge(Inventory_t &item) {
                 identified = spellDispelCreature(config::monsters::defense::CD_EVIL, 60);
                 break;
             case StaffSpellTypes::Darkness:
-                identified = spellDarkenArea(py.pos);
+                identified = spellDarkenArea(session->py.pos);
                 break;
             case StaffSpellTypes::StoreBoughtFlag:
                 // store bought flag
@@ -198,7 +198,7 @@ static bool staffDischarge(Inventory_t &item) {
 
 // Use a staff. -RAK-
 void staffUse() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
     int item_pos_start, item_pos_end;
     if (!staffPlayerIsCarrying(item_pos_start, item_pos_end)) {
@@ -211,9 +211,9 @@ void staffUse() {
     }
 
     // From here on player uses up a turn
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
     if (!staffPlayerCanUse(item)) {
         return;
@@ -224,11 +224,11 @@ void staffUse() {
     if (identified) {
         if (!itemSetColorlessAsIdentified(item.category_id, item.sub_category_id, item.identification)) {
             // round half-way case up
-            py.misc.exp += (item.depth_first_found + (py.misc.level >> 1)) / py.misc.level;
+            session->py.misc.exp += (item.depth_first_found + (session->py.misc.level >> 1)) / session->py.misc.level;
 
             displayCharacterExperience();
 
-            itemIdentify(py.inventory[item_id], item_id);
+            itemIdentify(session->py.inventory[item_id], item_id);
         }
     } else if (!itemSetColorlessAsIdentified(item.category_id, item.sub_category_id, item.identification)) {
         itemSetAsTried(item);
@@ -274,14 +274,14 @@ static bool wandDischarge(Inventory_t &item, int direction) {
     Coord_t coord = Coord_t{0, 0};
 
     while (flags != 0) {
-        coord.y = py.pos.y;
-        coord.x = py.pos.x;
+        coord.y = session->py.pos.y;
+        coord.x = session->py.pos.x;
 
         // Wand types
         switch ((WandSpellTypes)(getAndClearFirstBit(flags) + 1)) {
             case WandSpellTypes::WandLight:
                 printMessage("A line of blue shimmering light appears.");
-                spellLightLine(py.pos, direction);
+                spellLightLine(session->py.pos, direction);
                 identified = true;
                 break;
             case WandSpellTypes::LightningBolt:
@@ -374,9 +374,9 @@ static bool wandDischarge(Inventory_t &item, int direction) {
 
 // Wands for the aiming.
 void wandAim() {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("But you are not carrying anything.");
         return;
     }
@@ -392,24 +392,24 @@ void wandAim() {
         return;
     }
 
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
     int direction;
     if (!getDirectionWithMemory(CNIL, direction)) {
         return;
     }
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         printMessage("You are confused.");
         direction = getRandomDirection();
     }
 
-    Inventory_t &item = py.inventory[item_id];
+    Inventory_t &item = session->py.inventory[item_id];
 
-    int player_class_lev_adj = class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DEVICE] * py.misc.level / 3;
-    int chance = py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) - (int) item.depth_first_found + player_class_lev_adj;
+    int player_class_lev_adj = class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DEVICE] * session->py.misc.level / 3;
+    int chance = session->py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) - (int) item.depth_first_found + player_class_lev_adj;
 
-    if (py.flags.confused > 0) {
+    if (session->py.flags.confused > 0) {
         chance = chance / 2;
     }
 
@@ -439,10 +439,10 @@ void wandAim() {
     if (identified) {
         if (!itemSetColorlessAsIdentified(item.category_id, item.sub_category_id, item.identification)) {
             // round half-way case up
-            py.misc.exp += (item.depth_first_found + (py.misc.level >> 1)) / py.misc.level;
+            session->py.misc.exp += (item.depth_first_found + (session->py.misc.level >> 1)) / session->py.misc.level;
             displayCharacterExperience();
 
-            itemIdentify(py.inventory[item_id], item_id);
+            itemIdentify(session->py.inventory[item_id], item_id);
         }
     } else if (!itemSetColorlessAsIdentified(item.category_id, item.sub_category_id, item.identification)) {
         itemSetAsTried(item);
@@ -8,7 +8,6 @@
 #include "headers.h"
 
 // Save the store's last increment value.
-static int16_t store_last_increment;
 
 static bool storeNoNeedToBargain(Store_t const &store, int32_t min_price);
 static void storeUpdateBargainingSkills(Store_t &store, int32_t price, int32_t min_price);
@@ -18,7 +17,7 @@ void storeInitializeOwners() {
     int count = MAX_OWNERS / MAX_STORES;
 
     for (int store_id = 0; store_id < MAX_STORES; store_id++) {
-        Store_t &store = stores[store_id];
+        Store_t &store = session->stores[store_id];
 
         store.owner_id = (uint8_t)(MAX_STORES * (randomNumber(count) - 1) + store_id);
         store.insults_counter = 0;
@@ -166,7 +165,7 @@ static void displayStoreInventory(Store_t &store, int item_pos_start) {
 
 // Re-displays only a single cost -RAK-
 static void displaySingleCost(int store_id, int item_id) {
-    int cost = stores[store_id].inventory[item_id].cost;
+    int cost = session->stores[store_id].inventory[item_id].cost;
 
     vtype_t msg = {'\0'};
     if (cost < 0) {
@@ -182,7 +181,7 @@ static void displaySingleCost(int store_id, int item_id) {
 // Displays players gold -RAK-
 static void displayPlayerRemainingGold() {
     vtype_t msg = {'\0'};
-    (void) sprintf(msg, "Gold Remaining : %d", py.misc.au);
+    (void) sprintf(msg, "Gold Remaining : %d", session->py.misc.au);
     putStringClearToEOL(msg, Coord_t{18, 17});
 }
 
@@ -223,7 +222,7 @@ static bool storeGetItemId(int &item_id, const char *prompt, int item_pos_start,
 
 // Increase the insult counter and get angry if too many -RAK-
 static bool storeIncreaseInsults(int store_id) {
-    Store_t &store = stores[store_id];
+    Store_t &store = session->stores[store_id];
 
     store.insults_counter++;
 
@@ -235,15 +234,15 @@ static bool storeIncreaseInsults(int store_id) {
     printSpeechGetOutOfMyStore();
     store.insults_counter = 0;
     store.bad_purchases++;
-    store.turns_left_before_closing = dg.game_turn + 2500 + randomNumber(2500);
+    store.turns_left_before_closing = session->dg.game_turn + 2500 + randomNumber(2500);
 
     return true;
 }
 
 // Decrease insults -RAK-
 static void storeDecreaseInsults(int store_id) {
-    if (stores[store_id].insults_counter != 0) {
-        stores[store_id].insults_counter--;
+    if (session->stores[store_id].insults_counter != 0) {
+        session->stores[store_id].insults_counter--;
     }
 }
 
@@ -267,7 +266,7 @@ static bool storeGetHaggle(const char *prompt, int32_t &new_offer, int offer_cou
     bool valid_offer = true;
 
     if (offer_count == 0) {
-        store_last_increment = 0;
+        session->store_last_increment = 0;
     }
 
     bool increment = false;
@@ -284,10 +283,10 @@ static bool storeGetHaggle(const char *prompt, int32_t &new_offer, int offer_cou
     while (valid_offer && adjustment == 0) {
         putStringClearToEOL(prompt, Coord_t{0, 0});
 
-        if ((offer_count != 0) && store_last_increment != 0) {
-            auto abs_store_last_increment = (int) std::abs((std::intmax_t) store_last_increment);
+        if ((offer_count != 0) && session->store_last_increment != 0) {
+            auto abs_store_last_increment = (int) std::abs((std::intmax_t) session->store_last_increment);
 
-            (void) sprintf(last_offer_str, "[%c%d] ", (store_last_increment < 0) ? '-' : '+', abs_store_last_increment);
+            (void) sprintf(last_offer_str, "[%c%d] ", (session->store_last_increment < 0) ? '-' : '+', abs_store_last_increment);
             putStringClearToEOL(last_offer_str, Coord_t{0, start_len});
 
             prompt_len = start_len + (int) strlen(last_offer_str);
@@ -314,10 +313,10 @@ static bool storeGetHaggle(const char *prompt, int32_t &new_offer, int offer_cou
             if (adjustment == 0) {
                 increment = false;
             } else {
-                store_last_increment = (int16_t) adjustment;
+                session->store_last_increment = (int16_t) adjustment;
             }
         } else if ((offer_count != 0) && *msg == '\0') {
-            adjustment = store_last_increment;
+            adjustment = session->store_last_increment;
             increment = true;
         } else {
             stringToNumber(msg, adjustment);
@@ -401,7 +400,7 @@ static BidState storePurchaseHaggle(int store_id, int32_t &price, Inventory_t co
 
     int32_t new_price = 0;
 
-    Store_t const &store = stores[store_id];
+    Store_t const &store = session->stores[store_id];
     Owner_t const &owner = store_owners[store.owner_id];
 
     int32_t max_sell, min_sell;
@@ -425,14 +424,14 @@ static BidState storePurchaseHaggle(int store_id, int32_t &price, Inventory_t co
     int offers_count = 0; // this prevents incremental haggling on first try
 
     // go right to final price if player has bargained well
-    if (storeNoNeedToBargain(stores[store_id], final_asking_price)) {
+    if (storeNoNeedToBargain(session->stores[store_id], final_asking_price)) {
         printMessage("After a long bargaining session, you agree upon the price.");
         current_asking_price = min_sell;
         comment = "Final offer";
         accepted_without_haggle = true;
 
         // Set up automatic increment, so that a return will accept the final price.
-        store_last_increment = (int16_t) min_sell;
+        session->store_last_increment = (int16_t) min_sell;
         offers_count = 1;
     }
 
@@ -472,8 +471,8 @@ static BidState storePurchaseHaggle(int store_id, int32_t &price, Inventory_t co
                     // If the automatic increment is large enough to overflow,
                     // then the player must have made a mistake.  Clear it
                     // because it is useless.
-                    if (last_offer + store_last_increment > current_asking_price) {
-                        store_last_increment = 0;
+                    if (last_offer + session->store_last_increment > current_asking_price) {
+                        session->store_last_increment = 0;
                     }
                 } else if (new_offer == current_asking_price) {
                     rejected = true;
@@ -512,7 +511,7 @@ static BidState storePurchaseHaggle(int store_id, int32_t &price, Inventory_t co
 
                 // Set the automatic haggle increment so that RET will give
                 // a new_offer equal to the final_asking_price price.
-                store_last_increment = (int16_t)(final_asking_price - new_offer);
+                session->store_last_increment = (int16_t)(final_asking_price - new_offer);
                 final_flag++;
 
                 if (final_flag > 3) {
@@ -541,8 +540,8 @@ static BidState storePurchaseHaggle(int store_id, int32_t &price, Inventory_t co
 
                 // If the current increment would take you over the store's
                 // price, then decrease it to an exact match.
-                if (current_asking_price - last_offer < store_last_increment) {
-                    store_last_increment = (int16_t)(current_asking_price - last_offer);
+                if (current_asking_price - last_offer < session->store_last_increment) {
+                    session->store_last_increment = (int16_t)(current_asking_price - last_offer);
                 }
             }
         }
@@ -550,7 +549,7 @@ static BidState storePurchaseHaggle(int store_id, int32_t &price, Inventory_t co
 
     // update bargaining info
     if (status == BidState::Received && !accepted_without_haggle) {
-        storeUpdateBargainingSkills(stores[store_id], new_price, final_asking_price);
+        storeUpdateBargainingSkills(session->stores[store_id], new_price, final_asking_price);
     }
 
     price = new_price; // update callers price before returning
@@ -560,7 +559,7 @@ static BidState storePurchaseHaggle(int store_id, int32_t &price, Inventory_t co
 
 static void storeSellCustomerAdjustment(Owner_t const &owner, int32_t &cost, int32_t &min_buy, int32_t &max_buy, int32_t &max_sell) {
     cost = cost * (200 - playerStatAdjustmentCharisma()) / 100;
-    cost = cost * (200 - race_gold_adjustments[owner.race][py.misc.race_id]) / 100;
+    cost = cost * (200 - race_gold_adjustments[owner.race][session->py.misc.race_id]) / 100;
     if (cost < 1) {
         cost = 1;
     }
@@ -587,7 +586,7 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
 
     int32_t new_price = 0;
 
-    Store_t const &store = stores[store_id];
+    Store_t const &store = session->stores[store_id];
     int32_t cost = storeItemValue(item);
 
     bool rejected = false;
@@ -630,7 +629,7 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
             comment = "Final Offer";
 
             // Disable the automatic haggle increment on RET.
-            store_last_increment = 0;
+            session->store_last_increment = 0;
             current_asking_price = max_gold;
             final_asking_price = max_gold;
             printMessage("I am sorry, but I have not the money to afford such a fine item.");
@@ -646,7 +645,7 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
             comment = "Offer";
 
             // go right to final price if player has bargained well
-            if (storeNoNeedToBargain(stores[store_id], final_asking_price)) {
+            if (storeNoNeedToBargain(session->stores[store_id], final_asking_price)) {
                 printMessage("After a long bargaining session, you agree upon the price.");
                 current_asking_price = final_asking_price;
                 comment = "Final offer";
@@ -654,7 +653,7 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
 
                 // Set up automatic increment, so that a return
                 // will accept the final price.
-                store_last_increment = (int16_t) final_asking_price;
+                session->store_last_increment = (int16_t) final_asking_price;
                 offer_count = 1;
             }
         }
@@ -693,8 +692,8 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
                         // If the automatic increment is large enough to
                         // overflow, then the player must have made a mistake.
                         // Clear it because it is useless.
-                        if (last_offer + store_last_increment < current_asking_price) {
-                            store_last_increment = 0;
+                        if (last_offer + session->store_last_increment < current_asking_price) {
+                            session->store_last_increment = 0;
                         }
                     } else if (new_offer == current_asking_price) {
                         rejected = true;
@@ -733,7 +732,7 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
 
                     // Set the automatic haggle increment so that RET will give
                     // a new_offer equal to the final_asking_price price.
-                    store_last_increment = (int16_t)(final_asking_price - new_offer);
+                    session->store_last_increment = (int16_t)(final_asking_price - new_offer);
                     final_flag++;
 
                     if (final_flag > 3) {
@@ -762,8 +761,8 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
 
                     // If the current decrement would take you under the store's
                     // price, then increase it to an exact match.
-                    if (current_asking_price - last_offer > store_last_increment) {
-                        store_last_increment = (int16_t)(current_asking_price - last_offer);
+                    if (current_asking_price - last_offer > session->store_last_increment) {
+                        session->store_last_increment = (int16_t)(current_asking_price - last_offer);
                     }
                 }
             }
@@ -772,7 +771,7 @@ static BidState storeSellHaggle(int store_id, int32_t &price, Inventory_t const
 
     // update bargaining info
     if (status == BidState::Received && !accepted_without_haggle) {
-        storeUpdateBargainingSkills(stores[store_id], new_price, final_asking_price);
+        storeUpdateBargainingSkills(session->stores[store_id], new_price, final_asking_price);
     }
 
     price = new_price; // update callers price before returning
@@ -798,7 +797,7 @@ static int storeItemsToDisplay(int store_counter, int current_top_item_id) {
 static bool storePurchaseAnItem(int store_id, int &current_top_item_id) {
     bool kick_customer = false; // don't kick them out of the store!
 
-    Store_t &store = stores[store_id];
+    Store_t &store = session->stores[store_id];
 
     if (store.unique_items_counter < 1) {
         printMessage("I am currently out of stock.");
@@ -835,10 +834,10 @@ static bool storePurchaseAnItem(int store_id, int &current_top_item_id) {
     if (status == BidState::Insulted) {
         kick_customer = true;
     } else if (status == BidState::Received) {
-        if (py.misc.au >= price) {
+        if (session->py.misc.au >= price) {
             printSpeechFinishedHaggling();
             storeDecreaseInsults(store_id);
-            py.misc.au -= price;
+            session->py.misc.au -= price;
 
             int new_item_id = inventoryCarryItem(sell_item);
             int saved_store_counter = store.unique_items_counter;
@@ -846,7 +845,7 @@ static bool storePurchaseAnItem(int store_id, int &current_top_item_id) {
             storeDestroyItem(store_id, item_id, true);
 
             obj_desc_t description = {'\0'};
-            itemDescription(description, py.inventory[new_item_id], true);
+            itemDescription(description, session->py.inventory[new_item_id], true);
 
             obj_desc_t msg = {'\0'};
             (void) sprintf(msg, "You have %s (%c)", description, new_item_id + 'a');
@@ -856,7 +855,7 @@ static bool storePurchaseAnItem(int store_id, int &current_top_item_id) {
 
             if (current_top_item_id >= store.unique_items_counter) {
                 current_top_item_id = 0;
-                displayStoreInventory(stores[store_id], current_top_item_id);
+                displayStoreInventory(session->stores[store_id], current_top_item_id);
             } else {
                 InventoryRecord_t &store_item = store.inventory[item_id];
 
@@ -866,7 +865,7 @@ static bool storePurchaseAnItem(int store_id, int &current_top_item_id) {
                         displaySingleCost(store_id, item_id);
                     }
                 } else {
-                    displayStoreInventory(stores[store_id], item_id);
+                    displayStoreInventory(session->stores[store_id], item_id);
                 }
             }
             displayPlayerRemainingGold();
@@ -985,13 +984,13 @@ bool (*store_buy[MAX_STORES])(uint8_t) = {
 static bool storeSellAnItem(int store_id, int &current_top_item_id) {
     bool kick_customer = false; // don't kick them out of the store!
 
-    int first_item = py.pack.unique_items;
+    int first_item = session->py.pack.unique_items;
     int last_item = -1;
 
     char mask[PlayerEquipment::Wield];
 
-    for (int counter = 0; counter < py.pack.unique_items; counter++) {
-        bool flag = (*store_buy[store_id])(py.inventory[counter].category_id);
+    for (int counter = 0; counter < session->py.pack.unique_items; counter++) {
+        bool flag = (*store_buy[store_id])(session->py.inventory[counter].category_id);
 
         if (flag) {
             mask[counter] = 1;
@@ -1018,7 +1017,7 @@ static bool storeSellAnItem(int store_id, int &current_top_item_id) {
     }
 
     Inventory_t sold_item{};
-    inventoryTakeOneItem(&sold_item, &py.inventory[item_id]);
+    inventoryTakeOneItem(&sold_item, &session->py.inventory[item_id]);
 
     obj_desc_t description = {'\0'};
     itemDescription(description, sold_item, true);
@@ -1027,7 +1026,7 @@ static bool storeSellAnItem(int store_id, int &current_top_item_id) {
     (void) sprintf(msg, "Selling %s (%c)", description, item_id + 'a');
     printMessage(msg);
 
-    if (!storeCheckPlayerItemsCount(stores[store_id], sold_item)) {
+    if (!storeCheckPlayerItemsCount(session->stores[store_id], sold_item)) {
         printMessage("I have not the room in my store to keep it.");
         return false;
     }
@@ -1047,13 +1046,13 @@ static bool storeSellAnItem(int store_id, int &current_top_item_id) {
 
         printSpeechFinishedHaggling();
         storeDecreaseInsults(store_id);
-        py.misc.au += price;
+        session->py.misc.au += price;
 
         // identify object in inventory to set objects_identified array
-        itemIdentify(py.inventory[item_id], item_id);
+        itemIdentify(session->py.inventory[item_id], item_id);
 
         // retake sold_item so that it will be identified
-        inventoryTakeOneItem(&sold_item, &py.inventory[item_id]);
+        inventoryTakeOneItem(&sold_item, &session->py.inventory[item_id]);
 
         // call spellItemIdentifyAndRemoveRandomInscription for store item, so charges/pluses are known
         spellItemIdentifyAndRemoveRandomInscription(sold_item);
@@ -1071,16 +1070,16 @@ static bool storeSellAnItem(int store_id, int &current_top_item_id) {
         if (item_pos_id >= 0) {
             if (item_pos_id < 12) {
                 if (current_top_item_id < 12) {
-                    displayStoreInventory(stores[store_id], item_pos_id);
+                    displayStoreInventory(session->stores[store_id], item_pos_id);
                 } else {
                     current_top_item_id = 0;
-                    displayStoreInventory(stores[store_id], current_top_item_id);
+                    displayStoreInventory(session->stores[store_id], current_top_item_id);
                 }
             } else if (current_top_item_id > 11) {
-                displayStoreInventory(stores[store_id], item_pos_id);
+                displayStoreInventory(session->stores[store_id], item_pos_id);
             } else {
                 current_top_item_id = 12;
-                displayStoreInventory(stores[store_id], current_top_item_id);
+                displayStoreInventory(session->stores[store_id], current_top_item_id);
             }
         }
         displayPlayerRemainingGold();
@@ -1095,22 +1094,22 @@ static bool storeSellAnItem(int store_id, int &current_top_item_id) {
 
 // Entering a store -RAK-
 void storeEnter(int store_id) {
-    Store_t const &store = stores[store_id];
+    Store_t const &store = session->stores[store_id];
 
-    if (store.turns_left_before_closing >= dg.game_turn) {
+    if (store.turns_left_before_closing >= session->dg.game_turn) {
         printMessage("The doors are locked.");
         return;
     }
 
     int current_top_item_id = 0;
-    displayStore(stores[store_id], store_owners[store.owner_id].name, current_top_item_id);
+    displayStore(session->stores[store_id], store_owners[store.owner_id].name, current_top_item_id);
 
     bool exit_store = false;
     while (!exit_store) {
         moveCursor(Coord_t{20, 9});
 
         // clear the msg flag just like we do in dungeon.c
-        message_ready_to_print = false;
+        session->message_ready_to_print = false;
 
         char command;
         if (getCommand("", command)) {
@@ -1121,13 +1120,13 @@ void storeEnter(int store_id) {
                     if (current_top_item_id == 0) {
                         if (store.unique_items_counter > 12) {
                             current_top_item_id = 12;
-                            displayStoreInventory(stores[store_id], current_top_item_id);
+                            displayStoreInventory(session->stores[store_id], current_top_item_id);
                         } else {
                             printMessage("Entire inventory is shown.");
                         }
                     } else {
                         current_top_item_id = 0;
-                        displayStoreInventory(stores[store_id], current_top_item_id);
+                        displayStoreInventory(session->stores[store_id], current_top_item_id);
                     }
                     break;
                 case 'E':
@@ -1140,19 +1139,19 @@ void storeEnter(int store_id) {
                 case 'w': // Wear
                 case 'X':
                 case 'x': // Switch weapon
-                    saved_chr = py.stats.used[PlayerAttr::A_CHR];
+                    saved_chr = session->py.stats.used[PlayerAttr::A_CHR];
 
                     do {
                         inventoryExecuteCommand(command);
-                        command = game.doing_inventory_command;
+                        command = session->game.doing_inventory_command;
                     } while (command != 0);
 
                     // redisplay store prices if charisma changes
-                    if (saved_chr != py.stats.used[PlayerAttr::A_CHR]) {
-                        displayStoreInventory(stores[store_id], current_top_item_id);
+                    if (saved_chr != session->py.stats.used[PlayerAttr::A_CHR]) {
+                        displayStoreInventory(session->stores[store_id], current_top_item_id);
                     }
 
-                    game.player_free_turn = false; // No free moves here. -CJS-
+                    session->game.player_free_turn = false; // No free moves here. -CJS-
                     break;
                 case 'p':
                     exit_store = storePurchaseAnItem(store_id, current_top_item_id);
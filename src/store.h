@@ -42,7 +42,6 @@ typedef struct {
 extern uint8_t race_gold_adjustments[PLAYER_MAX_RACES][PLAYER_MAX_RACES];
 
 extern Owner_t store_owners[MAX_OWNERS];
-extern Store_t stores[MAX_STORES];
 extern uint16_t store_choices[MAX_STORES][STORE_MAX_ITEM_TYPES];
 extern bool (*store_buy[MAX_STORES])(uint8_t);
 extern const char *speech_sale_accepted[14];
@@ -61,6 +60,7 @@ void storeEnter(int store_id);
 
 // store_inventory
 void storeMaintenance();
+void storeMaintenanceFastForward(int cycles);
 int32_t storeItemValue(Inventory_t const &item);
 int32_t storeItemSellPrice(Store_t const &store, int32_t &min_price, int32_t &max_price, Inventory_t const &item);
 bool storeCheckPlayerItemsCount(Store_t const &store, Inventory_t const &item);
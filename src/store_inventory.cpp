@@ -7,7 +7,6 @@
 
 #include "headers.h"
 
-Store_t stores[MAX_STORES];
 
 static void storeItemInsert(int store_id, int pos, int32_t i_cost, Inventory_t *item);
 static void storeItemCreate(int store_id, int16_t max_cost);
@@ -23,7 +22,7 @@ static int32_t getPickShovelBuyPrice(Inventory_t const &item);
 // Initialize and up-keep the store's inventory. -RAK-
 void storeMaintenance() {
     for (int store_id = 0; store_id < MAX_STORES; store_id++) {
-        Store_t &store = stores[store_id];
+        Store_t &store = session->stores[store_id];
 
         store.insults_counter = 0;
         if (store.unique_items_counter >= config::stores::STORE_MIN_AUTO_SELL_ITEMS) {
@@ -55,6 +54,14 @@ void storeMaintenance() {
     }
 }
 
+// Apply a number of store maintenance cycles in one go, e.g. for the
+// days that have passed since a saved game was last played.
+void storeMaintenanceFastForward(int cycles) {
+    for (int i = 0; i < cycles; i++) {
+        storeMaintenance();
+    }
+}
+
 // Returns the value for any given object -RAK-
 int32_t storeItemValue(Inventory_t const &item) {
     int32_t value;
@@ -203,7 +210,7 @@ int32_t storeItemSellPrice(Store_t const &store, int32_t &min_price, int32_t &ma
 
     Owner_t const &owner = store_owners[store.owner_id];
 
-    price = price * race_gold_adjustments[owner.race][py.misc.race_id] / 100;
+    price = price * race_gold_adjustments[owner.race][session->py.misc.race_id] / 100;
     if (price < 1) {
         price = 1;
     }
@@ -246,7 +253,7 @@ bool storeCheckPlayerItemsCount(Store_t const &store, Inventory_t const &item) {
 
 // Insert INVEN_MAX at given location
 static void storeItemInsert(int store_id, int pos, int32_t i_cost, Inventory_t *item) {
-    Store_t &store = stores[store_id];
+    Store_t &store = session->stores[store_id];
 
     for (int i = store.unique_items_counter - 1; i >= pos; i--) {
         store.inventory[i + 1] = store.inventory[i];
@@ -261,7 +268,7 @@ static void storeItemInsert(int store_id, int pos, int32_t i_cost, Inventory_t *
 void storeCarryItem(int store_id, int &index_id, Inventory_t &item) {
     index_id = -1;
 
-    Store_t &store = stores[store_id];
+    Store_t &store = session->stores[store_id];
 
     int32_t item_cost, dummy;
     if (storeItemSellPrice(store, dummy, item_cost, item) < 1) {
@@ -314,7 +321,7 @@ void storeCarryItem(int store_id, int &index_id, Inventory_t &item) {
 // Destroy an item in the stores inventory.  Note that if
 // `only_one_of` is false, an entire slot is destroyed -RAK-
 void storeDestroyItem(int store_id, int item_id, bool only_one_of) {
-    Store_t &store = stores[store_id];
+    Store_t &store = session->stores[store_id];
     Inventory_t &store_item = store.inventory[item_id].item;
 
     uint8_t number;
@@ -345,17 +352,18 @@ void storeDestroyItem(int store_id, int item_id, bool only_one_of) {
 }
 
 // Creates an item and inserts it into store's inven -RAK-
+// The item is built in a scratch buffer of its own, rather than borrowing
+// a slot on the dungeon level treasure heap, so store upkeep never has to
+// compact or rescan the level.
 static void storeItemCreate(int store_id, int16_t max_cost) {
-    int free_id = popt();
+    Inventory_t item{};
 
     for (int tries = 0; tries <= 3; tries++) {
         int id = store_choices[store_id][randomNumber(STORE_MAX_ITEM_TYPES) - 1];
-        inventoryItemCopyTo(id, game.treasure.list[free_id]);
-        magicTreasureMagicalAbility(free_id, config::treasure::LEVEL_TOWN_OBJECTS);
+        inventoryItemCopyTo(id, item);
+        magicTreasureMagicalAbility(item, config::treasure::LEVEL_TOWN_OBJECTS);
 
-        Inventory_t &item = game.treasure.list[free_id];
-
-        if (storeCheckPlayerItemsCount(stores[store_id], item)) {
+        if (storeCheckPlayerItemsCount(session->stores[store_id], item)) {
             // Item must be good: cost > 0.
             if (item.cost > 0 && item.cost < max_cost) {
                 // equivalent to calling spellIdentifyItem(),
@@ -369,6 +377,4 @@ static void storeItemCreate(int store_id, int16_t max_cost) {
             }
         }
     }
-
-    pusht((uint8_t) free_id);
 }
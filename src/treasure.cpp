@@ -820,7 +820,6 @@ static void cursedProjectileAdjustment(Inventory_t &item, int level) {
 
 // Counter for missiles
 // Note: converted to uint16_t when saving the game.
-int16_t missiles_counter = 0;
 
 static void magicalProjectile(Inventory_t &item, int special, int level, int chance, int cursed) {
     if (item.category_id == TV_SLING_AMMO || item.category_id == TV_BOLT || item.category_id == TV_ARROW) {
@@ -840,18 +839,23 @@ static void magicalProjectile(Inventory_t &item, int special, int level, int cha
         item.items_count += randomNumber(6);
     }
 
-    if (missiles_counter == SHRT_MAX) {
-        missiles_counter = -SHRT_MAX - 1;
+    if (session->missiles_counter == SHRT_MAX) {
+        session->missiles_counter = -SHRT_MAX - 1;
     } else {
-        missiles_counter++;
+        session->missiles_counter++;
     }
 
-    item.misc_use = missiles_counter;
+    item.misc_use = session->missiles_counter;
 }
 
 // Chance of treasure having magic abilities -RAK-
 // Chance increases with each dungeon level
 void magicTreasureMagicalAbility(int item_id, int level) {
+    magicTreasureMagicalAbility(session->game.treasure.list[item_id], level);
+}
+
+// As above, but for an item which is not on the treasure heap
+void magicTreasureMagicalAbility(Inventory_t &item, int level) {
     int chance = config::treasure::OBJECT_BASE_MAGIC + level;
     if (chance > config::treasure::OBJECT_MAX_BASE_MAGIC) {
         chance = config::treasure::OBJECT_MAX_BASE_MAGIC;
@@ -862,8 +866,6 @@ void magicTreasureMagicalAbility(int item_id, int level) {
 
     int magic_amount;
 
-    Inventory_t &item = game.treasure.list[item_id];
-
     // some objects appear multiple times in the game_objects with different
     // levels, this is to make the object occur more often, however, for
     // consistency, must set the level of these duplicates to be the same
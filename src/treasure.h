@@ -69,6 +69,6 @@ constexpr uint8_t TV_SECRET_DOOR = 109;
 constexpr uint8_t TV_STORE_DOOR = 110;
 constexpr uint8_t TV_MAX_VISIBLE = 110;
 
-extern int16_t missiles_counter;
 
 void magicTreasureMagicalAbility(int item_id, int level);
+void magicTreasureMagicalAbility(Inventory_t &item, int level);
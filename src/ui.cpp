@@ -12,54 +12,50 @@ static const char *stat_names[] = {
 static char blank_string[] = "                        ";
 
 // Track screen changes for inventory commands
-bool screen_has_changed = false;
 
-bool message_ready_to_print;            // Set with first message
-vtype_t messages[MESSAGE_HISTORY_SIZE]; // Saved message history -CJS-
-int16_t last_message_id = 0;            // Index of last message held in saved messages array
 
 // Calculates current boundaries -RAK-
 static void panelBounds() {
-    dg.panel.top = dg.panel.row * (SCREEN_HEIGHT / 2);
-    dg.panel.bottom = dg.panel.top + SCREEN_HEIGHT - 1;
-    dg.panel.row_prt = dg.panel.top - 1;
-    dg.panel.left = dg.panel.col * (SCREEN_WIDTH / 2);
-    dg.panel.right = dg.panel.left + SCREEN_WIDTH - 1;
-    dg.panel.col_prt = dg.panel.left - 13;
+    session->dg.panel.top = session->dg.panel.row * (SCREEN_HEIGHT / 2);
+    session->dg.panel.bottom = session->dg.panel.top + SCREEN_HEIGHT - 1;
+    session->dg.panel.row_prt = session->dg.panel.top - 1;
+    session->dg.panel.left = session->dg.panel.col * (SCREEN_WIDTH / 2);
+    session->dg.panel.right = session->dg.panel.left + SCREEN_WIDTH - 1;
+    session->dg.panel.col_prt = session->dg.panel.left - 13;
 }
 
 // Given an row (y) and col (x), this routine detects -RAK-
 // when a move off the screen has occurred and figures new borders.
 // `force` forces the panel bounds to be recalculated, useful for 'W'here.
 bool coordOutsidePanel(Coord_t coord, bool force) {
-    Coord_t panel = Coord_t{dg.panel.row, dg.panel.col};
+    Coord_t panel = Coord_t{session->dg.panel.row, session->dg.panel.col};
 
-    if (force || coord.y < dg.panel.top + 2 || coord.y > dg.panel.bottom - 2) {
+    if (force || coord.y < session->dg.panel.top + 2 || coord.y > session->dg.panel.bottom - 2) {
         panel.y = (coord.y - SCREEN_HEIGHT / 4) / (SCREEN_HEIGHT / 2);
 
-        if (panel.y > dg.panel.max_rows) {
-            panel.y = dg.panel.max_rows;
+        if (panel.y > session->dg.panel.max_rows) {
+            panel.y = session->dg.panel.max_rows;
         } else if (panel.y < 0) {
             panel.y = 0;
         }
     }
 
-    if (force || coord.x < dg.panel.left + 3 || coord.x > dg.panel.right - 3) {
+    if (force || coord.x < session->dg.panel.left + 3 || coord.x > session->dg.panel.right - 3) {
         panel.x = ((coord.x - SCREEN_WIDTH / 4) / (SCREEN_WIDTH / 2));
-        if (panel.x > dg.panel.max_cols) {
-            panel.x = dg.panel.max_cols;
+        if (panel.x > session->dg.panel.max_cols) {
+            panel.x = session->dg.panel.max_cols;
         } else if (panel.x < 0) {
             panel.x = 0;
         }
     }
 
-    if (panel.y != dg.panel.row || panel.x != dg.panel.col) {
-        dg.panel.row = panel.y;
-        dg.panel.col = panel.x;
+    if (panel.y != session->dg.panel.row || panel.x != session->dg.panel.col) {
+        session->dg.panel.row = panel.y;
+        session->dg.panel.col = panel.x;
         panelBounds();
 
         // stop movement if any
-        if (config::options::find_bound) {
+        if (session->options.find_bound) {
             playerEndRunning();
         }
 
@@ -72,8 +68,8 @@ bool coordOutsidePanel(Coord_t coord, bool force) {
 
 // Is the given coordinate within the screen panel boundaries -RAK-
 bool coordInsidePanel(Coord_t coord) {
-    bool valid_y = coord.y >= dg.panel.top && coord.y <= dg.panel.bottom;
-    bool valid_x = coord.x >= dg.panel.left && coord.x <= dg.panel.right;
+    bool valid_y = coord.y >= session->dg.panel.top && coord.y <= session->dg.panel.bottom;
+    bool valid_x = coord.x >= session->dg.panel.left && coord.x <= session->dg.panel.right;
 
     return valid_y && valid_x;
 }
@@ -85,12 +81,15 @@ void drawDungeonPanel() {
     Coord_t coord = Coord_t{0, 0};
 
     // Top to bottom
-    for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
+    for (coord.y = session->dg.panel.top; coord.y <= session->dg.panel.bottom; coord.y++) {
         eraseLine(Coord_t{line, 13});
         line++;
 
         // Left to right
-        for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
+        for (coord.x = session->dg.panel.left; coord.x <= session->dg.panel.right; coord.x++) {
+            // Blank tiles are not drawn, but may have been something before
+            dungeonOverviewTouch(coord);
+
             char ch = caveGetTileSymbol(coord);
             if (ch != ' ') {
                 panelPutTile(ch, coord);
@@ -109,29 +108,29 @@ void drawCavePanel() {
 
 // We need to reset the view of things. -CJS-
 void dungeonResetView() {
-    Tile_t const &tile = dg.floor[py.pos.y][py.pos.x];
+    TileConstRef_t tile = session->dg.floor[session->py.pos.y][session->py.pos.x];
 
     // Check for new panel
-    if (coordOutsidePanel(py.pos, false)) {
+    if (coordOutsidePanel(session->py.pos, false)) {
         drawDungeonPanel();
     }
 
     // Move the light source
-    dungeonMoveCharacterLight(py.pos, py.pos);
+    dungeonMoveCharacterLight(session->py.pos, session->py.pos);
 
     // A room of light should be lit.
     if (tile.feature_id == TILE_LIGHT_FLOOR) {
-        if (py.flags.blind < 1 && !tile.permanent_light) {
-            dungeonLightRoom(py.pos);
+        if (session->py.flags.blind < 1 && !tile.permanent_light) {
+            dungeonLightRoom(session->py.pos);
         }
         return;
     }
 
     // In doorway of light-room?
-    if (tile.perma_lit_room && py.flags.blind < 1) {
-        for (int i = py.pos.y - 1; i <= py.pos.y + 1; i++) {
-            for (int j = py.pos.x - 1; j <= py.pos.x + 1; j++) {
-                if (dg.floor[i][j].feature_id == TILE_LIGHT_FLOOR && !dg.floor[i][j].permanent_light) {
+    if (tile.perma_lit_room && session->py.flags.blind < 1) {
+        for (int i = session->py.pos.y - 1; i <= session->py.pos.y + 1; i++) {
+            for (int j = session->py.pos.x - 1; j <= session->py.pos.x + 1; j++) {
+                if (session->dg.floor[i][j].feature_id == TILE_LIGHT_FLOOR && !session->dg.floor[i][j].permanent_light) {
                     dungeonLightRoom(Coord_t{i, j});
                 }
             }
@@ -155,7 +154,7 @@ void statsAsString(uint8_t stat, char *stat_string) {
 // Print character stat in given row, column -RAK-
 void displayCharacterStats(int stat) {
     char text[7];
-    statsAsString(py.stats.used[stat], text);
+    statsAsString(session->py.stats.used[stat], text);
     putString(stat_names[stat], Coord_t{6 + stat, STAT_COLUMN});
     putString(text, Coord_t{6 + stat, STAT_COLUMN + 6});
 }
@@ -211,39 +210,39 @@ void printCharacterTitle() {
 
 // Prints level -RAK-
 void printCharacterLevel() {
-    printNumber((int) py.misc.level, Coord_t{13, STAT_COLUMN + 6});
+    printNumber((int) session->py.misc.level, Coord_t{13, STAT_COLUMN + 6});
 }
 
 // Prints players current mana points. -RAK-
 void printCharacterCurrentMana() {
-    printNumber(py.misc.current_mana, Coord_t{15, STAT_COLUMN + 6});
+    printNumber(session->py.misc.current_mana, Coord_t{15, STAT_COLUMN + 6});
 }
 
 // Prints Max hit points -RAK-
 void printCharacterMaxHitPoints() {
-    printNumber(py.misc.max_hp, Coord_t{16, STAT_COLUMN + 6});
+    printNumber(session->py.misc.max_hp, Coord_t{16, STAT_COLUMN + 6});
 }
 
 // Prints players current hit points -RAK-
 void printCharacterCurrentHitPoints() {
-    printNumber(py.misc.current_hp, Coord_t{17, STAT_COLUMN + 6});
+    printNumber(session->py.misc.current_hp, Coord_t{17, STAT_COLUMN + 6});
 }
 
 // prints current AC -RAK-
 void printCharacterCurrentArmorClass() {
-    printNumber(py.misc.display_ac, Coord_t{19, STAT_COLUMN + 6});
+    printNumber(session->py.misc.display_ac, Coord_t{19, STAT_COLUMN + 6});
 }
 
 // Prints current gold -RAK-
 void printCharacterGoldValue() {
-    printLongNumber(py.misc.au, Coord_t{20, STAT_COLUMN + 6});
+    printLongNumber(session->py.misc.au, Coord_t{20, STAT_COLUMN + 6});
 }
 
 // Prints depth in stat area -RAK-
 void printCharacterCurrentDepth() {
     vtype_t depths = {'\0'};
 
-    int depth = dg.current_level * 50;
+    int depth = session->dg.current_level * 50;
 
     if (depth == 0) {
         (void) strcpy(depths, "Town level");
@@ -256,9 +255,9 @@ void printCharacterCurrentDepth() {
 
 // Prints status of hunger -RAK-
 void printCharacterHungerStatus() {
-    if ((py.flags.status & config::player::status::PY_WEAK) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_WEAK) != 0u) {
         putString("Weak  ", Coord_t{23, 0});
-    } else if ((py.flags.status & config::player::status::PY_HUNGRY) != 0u) {
+    } else if ((session->py.flags.status & config::player::status::PY_HUNGRY) != 0u) {
         putString("Hungry", Coord_t{23, 0});
     } else {
         putString(&blank_string[BLANK_LENGTH - 6], Coord_t{23, 0});
@@ -267,7 +266,7 @@ void printCharacterHungerStatus() {
 
 // Prints Blind status -RAK-
 void printCharacterBlindStatus() {
-    if ((py.flags.status & config::player::status::PY_BLIND) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_BLIND) != 0u) {
         putString("Blind", Coord_t{23, 7});
     } else {
         putString(&blank_string[BLANK_LENGTH - 5], Coord_t{23, 7});
@@ -276,7 +275,7 @@ void printCharacterBlindStatus() {
 
 // Prints Confusion status -RAK-
 void printCharacterConfusedState() {
-    if ((py.flags.status & config::player::status::PY_CONFUSED) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_CONFUSED) != 0u) {
         putString("Confused", Coord_t{23, 13});
     } else {
         putString(&blank_string[BLANK_LENGTH - 8], Coord_t{23, 13});
@@ -285,7 +284,7 @@ void printCharacterConfusedState() {
 
 // Prints Fear status -RAK-
 void printCharacterFearState() {
-    if ((py.flags.status & config::player::status::PY_FEAR) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_FEAR) != 0u) {
         putString("Afraid", Coord_t{23, 22});
     } else {
         putString(&blank_string[BLANK_LENGTH - 6], Coord_t{23, 22});
@@ -294,7 +293,7 @@ void printCharacterFearState() {
 
 // Prints Poisoned status -RAK-
 void printCharacterPoisonedState() {
-    if ((py.flags.status & config::player::status::PY_POISONED) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_POISONED) != 0u) {
         putString("Poisoned", Coord_t{23, 29});
     } else {
         putString(&blank_string[BLANK_LENGTH - 8], Coord_t{23, 29});
@@ -303,20 +302,20 @@ void printCharacterPoisonedState() {
 
 // Prints Searching, Resting, Paralysis, or 'count' status -RAK-
 void printCharacterMovementState() {
-    py.flags.status &= ~config::player::status::PY_REPEAT;
+    session->py.flags.status &= ~config::player::status::PY_REPEAT;
 
-    if (py.flags.paralysis > 1) {
+    if (session->py.flags.paralysis > 1) {
         putString("Paralysed", Coord_t{23, 38});
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_REST) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_REST) != 0u) {
         char rest_string[16];
 
-        if (py.flags.rest < 0) {
+        if (session->py.flags.rest < 0) {
             (void) strcpy(rest_string, "Rest *");
-        } else if (config::options::display_counts) {
-            (void) sprintf(rest_string, "Rest %-5d", py.flags.rest);
+        } else if (session->options.display_counts) {
+            (void) sprintf(rest_string, "Rest %-5d", session->py.flags.rest);
         } else {
             (void) strcpy(rest_string, "Rest");
         }
@@ -326,27 +325,27 @@ void printCharacterMovementState() {
         return;
     }
 
-    if (game.command_count > 0) {
+    if (session->game.command_count > 0) {
         char repeat_string[16];
 
-        if (config::options::display_counts) {
-            (void) sprintf(repeat_string, "Repeat %-3d", game.command_count);
+        if (session->options.display_counts) {
+            (void) sprintf(repeat_string, "Repeat %-3d", session->game.command_count);
         } else {
             (void) strcpy(repeat_string, "Repeat");
         }
 
-        py.flags.status |= config::player::status::PY_REPEAT;
+        session->py.flags.status |= config::player::status::PY_REPEAT;
 
         putString(repeat_string, Coord_t{23, 38});
 
-        if ((py.flags.status & config::player::status::PY_SEARCH) != 0u) {
+        if ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u) {
             putString("Search", Coord_t{23, 38});
         }
 
         return;
     }
 
-    if ((py.flags.status & config::player::status::PY_SEARCH) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u) {
         putString("Searching", Coord_t{23, 38});
         return;
     }
@@ -357,10 +356,10 @@ void printCharacterMovementState() {
 
 // Prints the speed of a character. -CJS-
 void printCharacterSpeed() {
-    int speed = py.flags.speed;
+    int speed = session->py.flags.speed;
 
     // Search mode.
-    if ((py.flags.status & config::player::status::PY_SEARCH) != 0u) {
+    if ((session->py.flags.status & config::player::status::PY_SEARCH) != 0u) {
         speed--;
     }
 
@@ -378,9 +377,9 @@ void printCharacterSpeed() {
 }
 
 void printCharacterStudyInstruction() {
-    py.flags.status &= ~config::player::status::PY_STUDY;
+    session->py.flags.status &= ~config::player::status::PY_STUDY;
 
-    if (py.flags.new_spells_to_learn == 0) {
+    if (session->py.flags.new_spells_to_learn == 0) {
         putString(&blank_string[BLANK_LENGTH - 5], Coord_t{23, 59});
     } else {
         putString("Study", Coord_t{23, 59});
@@ -389,41 +388,41 @@ void printCharacterStudyInstruction() {
 
 // Prints winner status on display -RAK-
 void printCharacterWinner() {
-    if ((game.noscore & 0x2) != 0) {
-        if (game.wizard_mode) {
+    if ((session->game.noscore & 0x2) != 0) {
+        if (session->game.wizard_mode) {
             putString("Is wizard  ", Coord_t{22, 0});
         } else {
             putString("Was wizard ", Coord_t{22, 0});
         }
-    } else if ((game.noscore & 0x1) != 0) {
+    } else if ((session->game.noscore & 0x1) != 0) {
         putString("Resurrected", Coord_t{22, 0});
-    } else if ((game.noscore & 0x4) != 0) {
+    } else if ((session->game.noscore & 0x4) != 0) {
         putString("Duplicate", Coord_t{22, 0});
-    } else if (game.total_winner) {
+    } else if (session->game.total_winner) {
         putString("*Winner*   ", Coord_t{22, 0});
     }
 }
 
 // Prints character-screen info -RAK-
 void printCharacterStatsBlock() {
-    printCharacterInfoInField(character_races[py.misc.race_id].name, Coord_t{2, STAT_COLUMN});
-    printCharacterInfoInField(classes[py.misc.class_id].title, Coord_t{3, STAT_COLUMN});
+    printCharacterInfoInField(character_races[session->py.misc.race_id].name, Coord_t{2, STAT_COLUMN});
+    printCharacterInfoInField(classes[session->py.misc.class_id].title, Coord_t{3, STAT_COLUMN});
     printCharacterInfoInField(playerRankTitle(), Coord_t{4, STAT_COLUMN});
 
     for (int i = 0; i < 6; i++) {
         displayCharacterStats(i);
     }
 
-    printHeaderNumber("LEV ", (int) py.misc.level, Coord_t{13, STAT_COLUMN});
-    printHeaderLongNumber("EXP ", py.misc.exp, Coord_t{14, STAT_COLUMN});
-    printHeaderNumber("MANA", py.misc.current_mana, Coord_t{15, STAT_COLUMN});
-    printHeaderNumber("MHP ", py.misc.max_hp, Coord_t{16, STAT_COLUMN});
-    printHeaderNumber("CHP ", py.misc.current_hp, Coord_t{17, STAT_COLUMN});
-    printHeaderNumber("AC  ", py.misc.display_ac, Coord_t{19, STAT_COLUMN});
-    printHeaderLongNumber("GOLD", py.misc.au, Coord_t{20, STAT_COLUMN});
+    printHeaderNumber("LEV ", (int) session->py.misc.level, Coord_t{13, STAT_COLUMN});
+    printHeaderLongNumber("EXP ", session->py.misc.exp, Coord_t{14, STAT_COLUMN});
+    printHeaderNumber("MANA", session->py.misc.current_mana, Coord_t{15, STAT_COLUMN});
+    printHeaderNumber("MHP ", session->py.misc.max_hp, Coord_t{16, STAT_COLUMN});
+    printHeaderNumber("CHP ", session->py.misc.current_hp, Coord_t{17, STAT_COLUMN});
+    printHeaderNumber("AC  ", session->py.misc.display_ac, Coord_t{19, STAT_COLUMN});
+    printHeaderLongNumber("GOLD", session->py.misc.au, Coord_t{20, STAT_COLUMN});
     printCharacterWinner();
 
-    uint32_t status = py.flags.status;
+    uint32_t status = session->py.flags.status;
 
     if (((config::player::status::PY_HUNGRY | config::player::status::PY_WEAK) & status) != 0u) {
         printCharacterHungerStatus();
@@ -450,7 +449,7 @@ void printCharacterStatsBlock() {
     }
 
     // if speed non zero, print it, modify speed if Searching
-    int16_t speed = py.flags.speed - (int16_t)((status & config::player::status::PY_SEARCH) >> 8);
+    int16_t speed = session->py.flags.speed - (int16_t)((status & config::player::status::PY_SEARCH) >> 8);
     if (speed != 0) {
         printCharacterSpeed();
     }
@@ -468,14 +467,14 @@ void printCharacterInformation() {
     putString("Sex         :", Coord_t{4, 1});
     putString("Class       :", Coord_t{5, 1});
 
-    if (!game.character_generated) {
+    if (!session->game.character_generated) {
         return;
     }
 
-    putString(py.misc.name, Coord_t{2, 15});
-    putString(character_races[py.misc.race_id].name, Coord_t{3, 15});
+    putString(session->py.misc.name, Coord_t{2, 15});
+    putString(character_races[session->py.misc.race_id].name, Coord_t{3, 15});
     putString((playerGetGenderLabel()), Coord_t{4, 15});
-    putString(classes[py.misc.class_id].title, Coord_t{5, 15});
+    putString(classes[session->py.misc.class_id].title, Coord_t{5, 15});
 }
 
 // Prints the following information on the screen. -JWT-
@@ -483,20 +482,20 @@ void printCharacterStats() {
     for (int i = 0; i < 6; i++) {
         vtype_t buf = {'\0'};
 
-        statsAsString(py.stats.used[i], buf);
+        statsAsString(session->py.stats.used[i], buf);
         putString(stat_names[i], Coord_t{2 + i, 61});
         putString(buf, Coord_t{2 + i, 66});
 
-        if (py.stats.max[i] > py.stats.current[i]) {
-            statsAsString(py.stats.max[i], buf);
+        if (session->py.stats.max[i] > session->py.stats.current[i]) {
+            statsAsString(session->py.stats.max[i], buf);
             putString(buf, Coord_t{2 + i, 73});
         }
     }
 
-    printHeaderNumber("+ To Hit    ", py.misc.display_to_hit, Coord_t{9, 1});
-    printHeaderNumber("+ To Damage ", py.misc.display_to_damage, Coord_t{10, 1});
-    printHeaderNumber("+ To AC     ", py.misc.display_to_ac, Coord_t{11, 1});
-    printHeaderNumber("  Total AC  ", py.misc.display_ac, Coord_t{12, 1});
+    printHeaderNumber("+ To Hit    ", session->py.misc.display_to_hit, Coord_t{9, 1});
+    printHeaderNumber("+ To Damage ", session->py.misc.display_to_damage, Coord_t{10, 1});
+    printHeaderNumber("+ To AC     ", session->py.misc.display_to_ac, Coord_t{11, 1});
+    printHeaderNumber("  Total AC  ", session->py.misc.display_ac, Coord_t{12, 1});
 }
 
 // Returns a rating of x depending on y -JWT-
@@ -528,57 +527,61 @@ const char *statRating(Coord_t coord) {
 
 // Prints age, height, weight, and SC -JWT-
 void printCharacterVitalStatistics() {
-    printHeaderNumber("Age          ", (int) py.misc.age, Coord_t{2, 38});
-    printHeaderNumber("Height       ", (int) py.misc.height, Coord_t{3, 38});
-    printHeaderNumber("Weight       ", (int) py.misc.weight, Coord_t{4, 38});
-    printHeaderNumber("Social Class ", (int) py.misc.social_class, Coord_t{5, 38});
+    printHeaderNumber("Age          ", (int) session->py.misc.age, Coord_t{2, 38});
+    printHeaderNumber("Height       ", (int) session->py.misc.height, Coord_t{3, 38});
+    printHeaderNumber("Weight       ", (int) session->py.misc.weight, Coord_t{4, 38});
+    printHeaderNumber("Social Class ", (int) session->py.misc.social_class, Coord_t{5, 38});
 }
 
 // Prints the following information on the screen. -JWT-
 void printCharacterLevelExperience() {
-    printHeaderLongNumber7Spaces("Level      ", (int32_t) py.misc.level, Coord_t{9, 28});
-    printHeaderLongNumber7Spaces("Experience ", py.misc.exp, Coord_t{10, 28});
-    printHeaderLongNumber7Spaces("Max Exp    ", py.misc.max_exp, Coord_t{11, 28});
+    printHeaderLongNumber7Spaces("Level      ", (int32_t) session->py.misc.level, Coord_t{9, 28});
+    printHeaderLongNumber7Spaces("Experience ", session->py.misc.exp, Coord_t{10, 28});
+    printHeaderLongNumber7Spaces("Max Exp    ", session->py.misc.max_exp, Coord_t{11, 28});
 
-    if (py.misc.level >= PLAYER_MAX_LEVEL) {
+    if (session->py.misc.level >= PLAYER_MAX_LEVEL) {
         putStringClearToEOL("Exp to Adv.: *******", Coord_t{12, 28});
     } else {
-        printHeaderLongNumber7Spaces("Exp to Adv.", (int32_t)(py.base_exp_levels[py.misc.level - 1] * py.misc.experience_factor / 100), Coord_t{12, 28});
+        printHeaderLongNumber7Spaces("Exp to Adv.", (int32_t)(session->py.base_exp_levels[session->py.misc.level - 1] * session->py.misc.experience_factor / 100), Coord_t{12, 28});
     }
 
-    printHeaderLongNumber7Spaces("Gold       ", py.misc.au, Coord_t{13, 28});
-    printHeaderNumber("Max Hit Points ", py.misc.max_hp, Coord_t{9, 52});
-    printHeaderNumber("Cur Hit Points ", py.misc.current_hp, Coord_t{10, 52});
-    printHeaderNumber("Max Mana       ", py.misc.mana, Coord_t{11, 52});
-    printHeaderNumber("Cur Mana       ", py.misc.current_mana, Coord_t{12, 52});
+    printHeaderLongNumber7Spaces("Gold       ", session->py.misc.au, Coord_t{13, 28});
+    printHeaderNumber("Max Hit Points ", session->py.misc.max_hp, Coord_t{9, 52});
+    printHeaderNumber("Cur Hit Points ", session->py.misc.current_hp, Coord_t{10, 52});
+    printHeaderNumber("Max Mana       ", session->py.misc.mana, Coord_t{11, 52});
+    printHeaderNumber("Cur Mana       ", session->py.misc.current_mana, Coord_t{12, 52});
 }
 
 // Prints ratings on certain abilities -RAK-
 void printCharacterAbilities() {
     clearToBottom(14);
 
-    int xbth = py.misc.bth + py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::BTH] * py.misc.level);
-    int xbthb = py.misc.bth_with_bows + py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST + (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::BTHB] * py.misc.level);
+    int xbth = session->py.misc.bth + session->py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST +
+        (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::BTH] * session->py.misc.level);
+    int xbthb = session->py.misc.bth_with_bows + session->py.misc.plusses_to_hit * BTH_PER_PLUS_TO_HIT_ADJUST +
+        (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::BTHB] * session->py.misc.level);
 
     // this results in a range from 0 to 29
-    int xfos = 40 - py.misc.fos;
+    int xfos = 40 - session->py.misc.fos;
     if (xfos < 0) {
         xfos = 0;
     }
 
-    int xsrh = py.misc.chance_in_search;
+    int xsrh = session->py.misc.chance_in_search;
 
     // this results in a range from 0 to 9
-    int xstl = py.misc.stealth_factor + 1;
-    int xdis = py.misc.disarm + 2 * playerDisarmAdjustment() + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) +
-               (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DISARM] * py.misc.level / 3);
+    int xstl = session->py.misc.stealth_factor + 1;
+    int xdis = session->py.misc.disarm + 2 * playerDisarmAdjustment() + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) +
+               (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DISARM] * session->py.misc.level / 3);
     int xsave =
-        py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_WIS) + (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::SAVE] * py.misc.level / 3);
+        session->py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_WIS) +
+            (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::SAVE] * session->py.misc.level / 3);
     int xdev =
-        py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) + (class_level_adj[py.misc.class_id][PlayerClassLevelAdj::DEVICE] * py.misc.level / 3);
+        session->py.misc.saving_throw + playerStatAdjustmentWisdomIntelligence(PlayerAttr::A_INT) +
+            (class_level_adj[session->py.misc.class_id][PlayerClassLevelAdj::DEVICE] * session->py.misc.level / 3);
 
     vtype_t xinfra = {'\0'};
-    (void) sprintf(xinfra, "%d feet", py.flags.see_infra * 10);
+    (void) sprintf(xinfra, "%d feet", session->py.flags.see_infra * 10);
 
     putString("(Miscellaneous Abilities)", Coord_t{15, 25});
     putString("Fighting    :", Coord_t{16, 1});
@@ -618,9 +621,9 @@ void getCharacterName() {
 
     putString(&blank_string[BLANK_LENGTH - 23], Coord_t{2, 15});
 
-    if (!getStringInput(py.misc.name, Coord_t{2, 15}, 23) || py.misc.name[0] == 0) {
-        getDefaultPlayerName(py.misc.name);
-        putString(py.misc.name, Coord_t{2, 15});
+    if (!getStringInput(session->py.misc.name, Coord_t{2, 15}, 23) || session->py.misc.name[0] == 0) {
+        getDefaultPlayerName(session->py.misc.name);
+        putString(session->py.misc.name, Coord_t{2, 15});
     }
 
     clearToBottom(20);
@@ -633,8 +636,15 @@ void changeCharacterName() {
 
     printCharacter();
 
+    // Someone playing over a connection has no say in the server's files
+    bool can_file = session->terminal_link == nullptr;
+
     while (!flag) {
-        putStringClearToEOL("<f>ile character description. <c>hange character name.", Coord_t{21, 2});
+        if (can_file) {
+            putStringClearToEOL("<f>ile character description. <c>hange character name.", Coord_t{21, 2});
+        } else {
+            putStringClearToEOL("<c>hange character name.", Coord_t{21, 2});
+        }
 
         switch (getKeyInput()) {
             case 'c':
@@ -642,6 +652,10 @@ void changeCharacterName() {
                 flag = true;
                 break;
             case 'f':
+                if (!can_file) {
+                    terminalBellSound();
+                    break;
+                }
                 putStringClearToEOL("File name:", Coord_t{0, 0});
 
                 if (getStringInput(temp, Coord_t{0, 10}, 60) && (temp[0] != 0)) {
@@ -675,7 +689,7 @@ void displaySpellsList(const int *spell_ids, int number_of_choices, bool comment
     }
 
     int consecutive_offset;
-    if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+    if (classes[session->py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
         consecutive_offset = config::spells::NAME_OFFSET_SPELLS;
     } else {
         consecutive_offset = config::spells::NAME_OFFSET_PRAYERS;
@@ -692,16 +706,16 @@ void displaySpellsList(const int *spell_ids, int number_of_choices, bool comment
 
     for (int i = 0; i < number_of_choices; i++) {
         int spell_id = spell_ids[i];
-        Spell_t const &spell = magic_spells[py.misc.class_id - 1][spell_id];
+        Spell_t const &spell = magic_spells[session->py.misc.class_id - 1][spell_id];
 
         const char *p = nullptr;
         if (!comment) {
             p = "";
-        } else if ((py.flags.spells_forgotten & (1L << spell_id)) != 0) {
+        } else if ((session->py.flags.spells_forgotten & (1L << spell_id)) != 0) {
             p = " forgotten";
-        } else if ((py.flags.spells_learnt & (1L << spell_id)) == 0) {
+        } else if ((session->py.flags.spells_learnt & (1L << spell_id)) == 0) {
             p = " unknown";
-        } else if ((py.flags.spells_worked & (1L << spell_id)) == 0) {
+        } else if ((session->py.flags.spells_worked & (1L << spell_id)) == 0) {
             p = " untried";
         } else {
             p = "";
@@ -725,26 +739,26 @@ void displaySpellsList(const int *spell_ids, int number_of_choices, bool comment
 
 // Increases hit points and level -RAK-
 static void playerGainLevel() {
-    py.misc.level++;
+    session->py.misc.level++;
 
     vtype_t msg = {'\0'};
-    (void) sprintf(msg, "Welcome to level %d.", (int) py.misc.level);
+    (void) sprintf(msg, "Welcome to level %d.", (int) session->py.misc.level);
     printMessage(msg);
 
     playerCalculateHitPoints();
 
-    int32_t new_exp = py.base_exp_levels[py.misc.level - 1] * py.misc.experience_factor / 100;
+    int32_t new_exp = session->py.base_exp_levels[session->py.misc.level - 1] * session->py.misc.experience_factor / 100;
 
-    if (py.misc.exp > new_exp) {
+    if (session->py.misc.exp > new_exp) {
         // lose some of the 'extra' exp when gaining several levels at once
-        int32_t dif_exp = py.misc.exp - new_exp;
-        py.misc.exp = new_exp + (dif_exp / 2);
+        int32_t dif_exp = session->py.misc.exp - new_exp;
+        session->py.misc.exp = new_exp + (dif_exp / 2);
     }
 
     printCharacterLevel();
     printCharacterTitle();
 
-    Class_t const &player_class = classes[py.misc.class_id];
+    Class_t const &player_class = classes[session->py.misc.class_id];
 
     if (player_class.class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
         playerCalculateAllowedSpellsCount(PlayerAttr::A_INT);
@@ -757,17 +771,18 @@ static void playerGainLevel() {
 
 // Prints experience -RAK-
 void displayCharacterExperience() {
-    if (py.misc.exp > config::player::PLAYER_MAX_EXP) {
-        py.misc.exp = config::player::PLAYER_MAX_EXP;
+    if (session->py.misc.exp > config::player::PLAYER_MAX_EXP) {
+        session->py.misc.exp = config::player::PLAYER_MAX_EXP;
     }
 
-    while ((py.misc.level < PLAYER_MAX_LEVEL) && (signed) (py.base_exp_levels[py.misc.level - 1] * py.misc.experience_factor / 100) <= py.misc.exp) {
+    while ((session->py.misc.level < PLAYER_MAX_LEVEL) &&
+           (signed) (session->py.base_exp_levels[session->py.misc.level - 1] * session->py.misc.experience_factor / 100) <= session->py.misc.exp) {
         playerGainLevel();
     }
 
-    if (py.misc.exp > py.misc.max_exp) {
-        py.misc.max_exp = py.misc.exp;
+    if (session->py.misc.exp > session->py.misc.max_exp) {
+        session->py.misc.max_exp = session->py.misc.exp;
     }
 
-    printLongNumber(py.misc.exp, Coord_t{14, STAT_COLUMN + 6});
+    printLongNumber(session->py.misc.exp, Coord_t{14, STAT_COLUMN + 6});
 }
@@ -42,15 +42,71 @@ constexpr char DELETE = 0x7f;
 #undef ESCAPE
 constexpr char ESCAPE = '\033'; // ESCAPE character -CJS-
 
-extern bool screen_has_changed;
-extern bool message_ready_to_print;
-extern vtype_t messages[MESSAGE_HISTORY_SIZE];
-extern int16_t last_message_id;
+// How the screen is drawn: through curses, or by writing ANSI escape
+// sequences straight to the terminal (not available on Windows).
+enum class TerminalOutput : uint8_t {
+    Curses = 0,
+    Ansi = 1,
+};
+
+// Bytes written to the terminal by the ANSI output
+typedef struct {
+    uint32_t frames;
+    uint64_t bytes;
+    uint32_t largest_frame;
+} AnsiFrameStats_t;
+
+constexpr int ANSI_ROWS = 24;
+constexpr int ANSI_COLUMNS = 80;
+
+typedef struct {
+    char cells[ANSI_ROWS][ANSI_COLUMNS];
+    Coord_t cursor;
+} AnsiScreen_t;
+
+// The ANSI output of one session, see ui_ansi.cpp
+typedef struct {
+    // What the game has drawn, what the terminal shows, and terminalSaveScreen()
+    AnsiScreen_t screen;
+    AnsiScreen_t terminal;
+    AnsiScreen_t saved;
+
+    // The terminal cursor is lost after writing in the last column,
+    // as terminals differ on whether it wraps to the next line.
+    bool cursor_known;
+
+    // Can the terminal repeat the last character written (REP)?
+    bool repeat_ok;
+
+    std::string output;
+    AnsiFrameStats_t stats;
+} AnsiTerminal_t;
+
+// A terminal at the other end of a connection, rather than the one the
+// process was started on. Only the ANSI output can draw on it.
+typedef struct {
+    void *context;
+
+    // Sends the bytes of a frame
+    void (*write)(void *context, const char *bytes, size_t length);
+
+    // Waits for a key, returning EOF once the connection has gone
+    int (*get_key)(void *context);
+
+    // Is there a key (or the end of input) to get within the time?
+    bool (*key_waiting)(void *context, int microseconds);
+
+    // Ends the game played on the connection, and does not return
+    void (*hang_up)(void *context);
+} TerminalLink_t;
+
+// A ttyrec file the terminal output is being recorded to, see ui_record.cpp
+typedef struct Recording_t Recording_t;
+
 
-extern int eof_flag;
-extern bool panic_save;
 
 // UI - IO
+void setTerminalOutput(TerminalOutput output);
 bool terminalInitialize();
 void terminalRestore();
 void terminalSaveScreen();
@@ -83,6 +139,32 @@ bool checkForNonBlockingKeyPress(int microseconds);
 void getDefaultPlayerName(char *buffer);
 bool checkFilePermissions();
 
+// ui_ansi.cpp
+bool ansiTerminalInitialize();
+void ansiTerminalRestore();
+AnsiFrameStats_t ansiFrameStats();
+bool ansiMove(Coord_t const &coord);
+Coord_t ansiCursor();
+bool ansiAddChar(char ch);
+bool ansiAddString(const char *str);
+void ansiClearToEOL();
+void ansiClearToBottom();
+void ansiClear();
+void ansiSaveScreen();
+void ansiRestoreScreen();
+void ansiRefresh();
+void ansiKeyframe(AnsiTerminal_t const &ansi, std::string &out);
+void ansiBell();
+void ansiRedraw();
+int ansiGetKey();
+
+// ui_record.cpp
+bool recordingCanCompress();
+void recordingStart(std::string const &path, bool compress);
+void recordingWrite(const char *bytes, size_t length);
+void recordingStop();
+void recordingFinishAll();
+
 #ifndef _WIN32
 // call functions which expand tilde before calling open/fopen
 #define open topen
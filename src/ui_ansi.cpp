@@ -0,0 +1,573 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Terminal output written as ANSI escape sequences, without curses
+
+#include "headers.h"
+
+#ifndef _WIN32
+#include <sys/ioctl.h>
+#include <termios.h>
+#endif
+
+// The game draws on a screen model, which is only sent to the terminal when
+// putQIO() is called. Each frame writes just the cells which differ from what
+// the terminal is already showing, moving the cursor the cheapest way there.
+// Runs of one character are sent as a repeat count where the terminal
+// understands that, and runs of blanks are erased rather than written out.
+
+// A cell the terminal may be showing anything in, after a ^R redraw
+constexpr char ANSI_UNKNOWN_CELL = '\0';
+
+// The ANSI output of each session is kept in the session, while the
+// terminal modes belong to the terminal the process was started on.
+#ifndef _WIN32
+static struct termios ansi_original_modes;
+#endif
+
+static void ansiBlankScreen(AnsiScreen_t &screen) {
+    memset((char *) &screen.cells[0][0], ' ', sizeof(screen.cells));
+    screen.cursor = Coord_t{0, 0};
+}
+
+// Raw input without echo, as set up for curses by moriaTerminalInitialize()
+static bool ansiSetTerminalModes() {
+    if (session->terminal_link != nullptr) {
+        return true;
+    }
+
+#ifdef _WIN32
+    return false;
+#else
+    struct termios modes = ansi_original_modes;
+
+    modes.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
+    modes.c_oflag &= ~OPOST;
+    modes.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    modes.c_cflag &= ~(CSIZE | PARENB);
+    modes.c_cflag |= CS8;
+    modes.c_cc[VMIN] = 1;
+    modes.c_cc[VTIME] = 0;
+
+    return tcsetattr(0, TCSANOW, &modes) == 0;
+#endif
+}
+
+static void ansiWrite(const char *bytes, size_t length) {
+    recordingWrite(bytes, length);
+
+    TerminalLink_t const *link = session->terminal_link;
+    if (link != nullptr) {
+        link->write(link->context, bytes, length);
+        return;
+    }
+
+    while (length > 0) {
+        ssize_t written = write(1, bytes, length);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        bytes += written;
+        length -= (size_t) written;
+    }
+}
+
+static void ansiSendOutput() {
+    ansiWrite(session->ansi.output.data(), session->ansi.output.size());
+    session->ansi.output.clear();
+}
+
+// Appends an escape sequence with a count, leaving out a count of one
+static void ansiSequence(std::string &out, int count, char command) {
+    out += "\033[";
+    if (count != 1) {
+        out += std::to_string(count);
+    }
+    out += command;
+}
+
+// The sequence taking the cursor straight to a screen position
+static void ansiCursorAbsolute(std::string &out, Coord_t const &to) {
+    out += "\033[";
+    if (to.y != 0 || to.x != 0) {
+        out += std::to_string(to.y + 1);
+    }
+    if (to.x != 0) {
+        out += ';';
+        out += std::to_string(to.x + 1);
+    }
+    out += 'H';
+}
+
+// The sequence moving the cursor from where the terminal has it. With
+// output processing off a line feed moves down without returning the
+// carriage, and the cursor never moves down from the bottom line.
+static void ansiCursorRelative(std::string &out, Coord_t const &from, Coord_t const &to) {
+    int dy = to.y - from.y;
+    int dx = to.x - from.x;
+
+    if (dy > 0) {
+        if (dy <= 3) {
+            out.append((size_t) dy, '\n');
+        } else {
+            ansiSequence(out, dy, 'B');
+        }
+    } else if (dy < 0) {
+        ansiSequence(out, -dy, 'A');
+    }
+
+    if (dx == 0) {
+        return;
+    }
+
+    if (to.x == 0) {
+        out += '\r';
+    } else if (dx < 0 && dx >= -3) {
+        out.append((size_t) -dx, '\b');
+    } else if (dx < 0 && to.x < -dx) {
+        out += '\r';
+        ansiSequence(out, to.x, 'C');
+    } else if (dx < 0) {
+        ansiSequence(out, -dx, 'D');
+    } else {
+        ansiSequence(out, dx, 'C');
+    }
+}
+
+// Moves the terminal cursor with the shortest sequence. Moving forwards on
+// the same line can also be done by writing out the cells in between again.
+static void ansiMoveTerminalCursor(Coord_t const &to) {
+    Coord_t &from = session->ansi.terminal.cursor;
+
+    if (session->ansi.cursor_known && from.y == to.y && from.x == to.x) {
+        return;
+    }
+
+    std::string absolute;
+    ansiCursorAbsolute(absolute, to);
+
+    std::string const *best = &absolute;
+
+    std::string relative;
+    std::string rewrite;
+    std::string line_or_column;
+
+    if (session->ansi.cursor_known) {
+        if (from.y == to.y) {
+            ansiSequence(line_or_column, to.x + 1, 'G');
+        } else if (from.x == to.x) {
+            ansiSequence(line_or_column, to.y + 1, 'd');
+        }
+        if (!line_or_column.empty() && line_or_column.size() < best->size()) {
+            best = &line_or_column;
+        }
+
+        ansiCursorRelative(relative, from, to);
+        if (relative.size() < best->size()) {
+            best = &relative;
+        }
+
+        if (from.y == to.y && from.x < to.x && (size_t)(to.x - from.x) < best->size()) {
+            rewrite.assign(&session->ansi.terminal.cells[to.y][from.x], (size_t)(to.x - from.x));
+            if (rewrite.find(ANSI_UNKNOWN_CELL) == std::string::npos) {
+                best = &rewrite;
+            }
+        }
+    }
+
+    session->ansi.output += *best;
+
+    from = to;
+    session->ansi.cursor_known = true;
+}
+
+static bool ansiCellChanged(int y, int x) {
+    return session->ansi.screen.cells[y][x] != session->ansi.terminal.cells[y][x];
+}
+
+// Writes the changed cell, along with the rest of a run of the same
+// character when repeating it is shorter. Returns the next column.
+static int ansiWriteCells(int y, int x) {
+    ansiMoveTerminalCursor(Coord_t{y, x});
+
+    char ch = session->ansi.screen.cells[y][x];
+    int count = 1;
+
+    if (session->ansi.repeat_ok) {
+        // Cells already showing the character are only worth repeating
+        // over when there are changed ones after them.
+        int run = 1;
+        while (x + run < ANSI_COLUMNS && session->ansi.screen.cells[y][x + run] == ch) {
+            run++;
+            if (ansiCellChanged(y, x + run - 1)) {
+                count = run;
+            }
+        }
+    }
+
+    session->ansi.output += ch;
+
+    if (count > 1) {
+        std::string repeat;
+        ansiSequence(repeat, count - 1, 'b');
+
+        if (repeat.size() < (size_t)(count - 1)) {
+            session->ansi.output += repeat;
+        } else {
+            session->ansi.output.append((size_t)(count - 1), ch);
+        }
+    }
+
+    memset(&session->ansi.terminal.cells[y][x], ch, (size_t) count);
+
+    session->ansi.terminal.cursor.x += count;
+    if (session->ansi.terminal.cursor.x >= ANSI_COLUMNS) {
+        session->ansi.cursor_known = false;
+    }
+
+    return x + count;
+}
+
+// Erases a run of changed blanks in one go when that is shorter than
+// writing the spaces, which leaves the cursor where it was.
+static bool ansiEraseRun(int y, int x, int count, bool to_end_of_line) {
+    std::string erase;
+    if (to_end_of_line) {
+        erase = "\033[K";
+    } else {
+        ansiSequence(erase, count, 'X');
+
+        // The cursor then has to be moved past the erased cells
+        std::string skip;
+        ansiSequence(skip, count, 'C');
+        if (erase.size() + skip.size() >= (size_t) count) {
+            return false;
+        }
+    }
+
+    if (erase.size() >= (size_t) count) {
+        return false;
+    }
+
+    ansiMoveTerminalCursor(Coord_t{y, x});
+    session->ansi.output += erase;
+    memset(&session->ansi.terminal.cells[y][x], ' ', (size_t) count);
+
+    return true;
+}
+
+static void ansiUpdateLine(int y) {
+    char const *cells = session->ansi.screen.cells[y];
+
+    // Everything after the last character on the line is blank
+    int end = ANSI_COLUMNS;
+    while (end > 0 && cells[end - 1] == ' ') {
+        end--;
+    }
+
+    int x = 0;
+
+    while (x < ANSI_COLUMNS) {
+        if (!ansiCellChanged(y, x)) {
+            x++;
+            continue;
+        }
+
+        if (cells[x] != ' ') {
+            x = ansiWriteCells(y, x);
+            continue;
+        }
+
+        // A run of blanks, up to the next cell which must be written
+        int run = x;
+        int last_changed = x;
+        while (run < ANSI_COLUMNS && cells[run] == ' ') {
+            if (ansiCellChanged(y, run)) {
+                last_changed = run;
+            }
+            run++;
+        }
+
+        if (ansiEraseRun(y, x, last_changed - x + 1, x >= end)) {
+            x = last_changed + 1;
+            continue;
+        }
+
+        x = ansiWriteCells(y, x);
+    }
+}
+
+// Use the alternate screen, as curses does, and start from a blank one
+static void ansiStartScreen() {
+    session->ansi.output += "\033[?1049h\033[H\033[2J";
+    session->ansi.cursor_known = true;
+    ansiSendOutput();
+}
+
+// Is clearing the terminal and drawing everything again shorter
+// than changing what is on it now?
+static bool ansiClearIsCheaper() {
+    int changed = 0;
+    int filled = 0;
+
+    for (int y = 0; y < ANSI_ROWS; y++) {
+        for (int x = 0; x < ANSI_COLUMNS; x++) {
+            if (ansiCellChanged(y, x)) {
+                changed++;
+            }
+            if (session->ansi.screen.cells[y][x] != ' ') {
+                filled++;
+            }
+        }
+    }
+
+    return filled + 8 < changed;
+}
+
+bool ansiTerminalInitialize() {
+    session->ansi.output.reserve(ANSI_ROWS * ANSI_COLUMNS * 4);
+
+    ansiBlankScreen(session->ansi.screen);
+    ansiBlankScreen(session->ansi.terminal);
+    ansiBlankScreen(session->ansi.saved);
+
+    // What is at the other end of a link is not known,
+    // so it is not trusted to repeat characters.
+    if (session->terminal_link != nullptr) {
+        session->ansi.repeat_ok = false;
+        ansiStartScreen();
+        return true;
+    }
+
+#ifdef _WIN32
+    (void) printf("ANSI terminal output is not available on Windows.\n");
+    return false;
+#else
+    if (tcgetattr(0, &ansi_original_modes) != 0) {
+        (void) printf("ANSI terminal output needs a terminal to play on.\n");
+        return false;
+    }
+
+    // Check we have enough screen, when the terminal can tell us.
+    struct winsize size {};
+    if (ioctl(1, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && (size.ws_row < ANSI_ROWS || size.ws_col < ANSI_COLUMNS)) {
+        (void) printf("Screen too small for moria.\n");
+        return false;
+    }
+
+    if (!ansiSetTerminalModes()) {
+        (void) printf("Can't set up the terminal for ANSI output.\n");
+        return false;
+    }
+
+    // There is no terminfo to ask, so only trust the terminals known to repeat
+    const char *term = getenv("TERM");
+    session->ansi.repeat_ok = term != nullptr && (strncmp(term, "xterm", 5) == 0 || strncmp(term, "tmux", 4) == 0);
+
+    ansiStartScreen();
+
+    return true;
+#endif
+}
+
+void ansiTerminalRestore() {
+    ansiRefresh();
+
+    ansiMoveTerminalCursor(Coord_t{ANSI_ROWS - 1, 0});
+    session->ansi.output += "\033[?1049l";
+    ansiSendOutput();
+
+    if (session->terminal_link != nullptr) {
+        return;
+    }
+
+#ifndef _WIN32
+    (void) tcsetattr(0, TCSANOW, &ansi_original_modes);
+#endif
+
+    if (session->ansi.stats.frames > 0) {
+        std::cerr << "ANSI output: " << session->ansi.stats.frames << " frames, " << session->ansi.stats.bytes << " bytes, "
+                  << session->ansi.stats.bytes / session->ansi.stats.frames << " bytes/frame on average, " << session->ansi.stats.largest_frame
+                  << " bytes in the largest frame\n";
+    }
+}
+
+AnsiFrameStats_t ansiFrameStats() {
+    return session->ansi.stats;
+}
+
+bool ansiMove(Coord_t const &coord) {
+    if (coord.y < 0 || coord.y >= ANSI_ROWS || coord.x < 0 || coord.x >= ANSI_COLUMNS) {
+        return false;
+    }
+
+    session->ansi.screen.cursor = coord;
+
+    return true;
+}
+
+Coord_t ansiCursor() {
+    return session->ansi.screen.cursor;
+}
+
+// Writes a character at the cursor, which moves on to the next line
+// at the right edge of the screen, and stays put in the last cell.
+bool ansiAddChar(char ch) {
+    Coord_t &cursor = session->ansi.screen.cursor;
+
+    // Control characters have no place on the screen
+    if (ch < ' ' || ch == DELETE) {
+        ch = ' ';
+    }
+
+    session->ansi.screen.cells[cursor.y][cursor.x] = ch;
+
+    if (cursor.x < ANSI_COLUMNS - 1) {
+        cursor.x++;
+    } else if (cursor.y < ANSI_ROWS - 1) {
+        cursor.x = 0;
+        cursor.y++;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+bool ansiAddString(const char *str) {
+    for (; *str != '\0'; str++) {
+        if (!ansiAddChar(*str)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ansiClearToEOL() {
+    Coord_t const &cursor = session->ansi.screen.cursor;
+
+    memset(&session->ansi.screen.cells[cursor.y][cursor.x], ' ', (size_t)(ANSI_COLUMNS - cursor.x));
+}
+
+void ansiClearToBottom() {
+    ansiClearToEOL();
+
+    for (int y = session->ansi.screen.cursor.y + 1; y < ANSI_ROWS; y++) {
+        memset(session->ansi.screen.cells[y], ' ', ANSI_COLUMNS);
+    }
+}
+
+void ansiClear() {
+    ansiBlankScreen(session->ansi.screen);
+}
+
+void ansiSaveScreen() {
+    memcpy(session->ansi.saved.cells, session->ansi.screen.cells, sizeof(session->ansi.screen.cells));
+}
+
+void ansiRestoreScreen() {
+    memcpy(session->ansi.screen.cells, session->ansi.saved.cells, sizeof(session->ansi.screen.cells));
+}
+
+// Sends the changes since the last frame to the terminal
+void ansiRefresh() {
+    if (ansiClearIsCheaper()) {
+        session->ansi.output += "\033[H\033[2J";
+        ansiBlankScreen(session->ansi.terminal);
+        session->ansi.cursor_known = true;
+    }
+
+    for (int y = 0; y < ANSI_ROWS; y++) {
+        ansiUpdateLine(y);
+    }
+
+    ansiMoveTerminalCursor(session->ansi.screen.cursor);
+
+    if (session->ansi.output.empty()) {
+        return;
+    }
+
+    auto bytes = (uint32_t) session->ansi.output.size();
+
+    session->ansi.stats.frames++;
+    session->ansi.stats.bytes += bytes;
+    if (bytes > session->ansi.stats.largest_frame) {
+        session->ansi.stats.largest_frame = bytes;
+    }
+
+    ansiSendOutput();
+}
+
+// The whole screen as the terminal shows it, for another terminal to start
+// following the frames sent from here on, see server.cpp.
+void ansiKeyframe(AnsiTerminal_t const &ansi, std::string &out) {
+    out += "\033[?1049h\033[H\033[2J";
+
+    for (int y = 0; y < ANSI_ROWS; y++) {
+        char const *cells = ansi.terminal.cells[y];
+
+        int end = ANSI_COLUMNS;
+        while (end > 0 && (cells[end - 1] == ' ' || cells[end - 1] == ANSI_UNKNOWN_CELL)) {
+            end--;
+        }
+        if (end == 0) {
+            continue;
+        }
+
+        ansiCursorAbsolute(out, Coord_t{y, 0});
+        for (int x = 0; x < end; x++) {
+            out += cells[x] == ANSI_UNKNOWN_CELL ? ' ' : cells[x];
+        }
+    }
+
+    ansiCursorAbsolute(out, ansi.terminal.cursor);
+}
+
+// Rings the bell, after whatever has been drawn
+void ansiBell() {
+    ansiRefresh();
+
+    session->ansi.output += '\007';
+    ansiSendOutput();
+}
+
+// Draws the whole screen again, for when the terminal has been messed up
+void ansiRedraw() {
+    memset((char *) &session->ansi.terminal.cells[0][0], ANSI_UNKNOWN_CELL, sizeof(session->ansi.terminal.cells));
+    session->ansi.cursor_known = false;
+
+    (void) ansiSetTerminalModes();
+
+    ansiRefresh();
+}
+
+// Reads a key, returning EOF when the input has gone
+int ansiGetKey() {
+    TerminalLink_t const *link = session->terminal_link;
+    if (link != nullptr) {
+        return link->get_key(link->context);
+    }
+
+    while (true) {
+        unsigned char ch;
+        ssize_t count = read(0, &ch, 1);
+
+        if (count == 1) {
+            return ch;
+        }
+
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+
+        return EOF;
+    }
+}
@@ -6,7 +6,7 @@
 #include "headers.h"
 
 static void inventoryItemWeightText(char *text, int itemId) {
-    int totalWeight = py.inventory[itemId].weight * py.inventory[itemId].items_count;
+    int totalWeight = session->py.inventory[itemId].weight * session->py.inventory[itemId].items_count;
     int quotient = totalWeight / 10;
     int remainder = totalWeight % 10;
 
@@ -38,7 +38,7 @@ int displayInventoryItems(int itemIdStart, int itemIdEnd, bool weighted, int col
         }
 
         obj_desc_t description = {'\0'};
-        itemDescription(description, py.inventory[i], true);
+        itemDescription(description, session->py.inventory[i], true);
 
         // Truncate if too long.
         description[lim] = 0;
@@ -124,7 +124,7 @@ const char *playerItemWearingDescription(int body_location) {
 static const char *equipmentPositionDescription(PlayerEquipment id, uint16_t weight) {
     switch (id) {
         case PlayerEquipment::Wield:
-            if (py.stats.used[PlayerAttr::A_STR] * 15 < weight) {
+            if (session->py.stats.used[PlayerAttr::A_STR] * 15 < weight) {
                 return "Just lifting";
             }
             return "Wielding";
@@ -172,15 +172,15 @@ int displayEquipment(bool showWeights, int column) {
     // Range of equipment
     int line = 0;
     for (int i = PlayerEquipment::Wield; i < PLAYER_INVENTORY_SIZE; i++) {
-        if (py.inventory[i].category_id == TV_NOTHING) {
+        if (session->py.inventory[i].category_id == TV_NOTHING) {
             continue;
         }
 
         // Get position
-        const char *equippedDescription = equipmentPositionDescription((PlayerEquipment)i, py.inventory[i].weight);
+        const char *equippedDescription = equipmentPositionDescription((PlayerEquipment)i, session->py.inventory[i].weight);
 
         obj_desc_t description = {'\0'};
-        itemDescription(description, py.inventory[i], true);
+        itemDescription(description, session->py.inventory[i], true);
 
         // Truncate if necessary
         description[lim] = 0;
@@ -208,7 +208,7 @@ int displayEquipment(bool showWeights, int column) {
     // Range of equipment
     line = 0;
     for (int i = PlayerEquipment::Wield; i < PLAYER_INVENTORY_SIZE; i++) {
-        if (py.inventory[i].category_id == TV_NOTHING) {
+        if (session->py.inventory[i].category_id == TV_NOTHING) {
             continue;
         }
 
@@ -279,44 +279,46 @@ static int showEquipmentHelpMenu(int leftColumn) {
 // minimize the work done to restore the screen afterwards. -CJS-
 
 static void uiCommandSwitchScreen(Screen nextScreen) {
-    if (nextScreen == game.screen.current_screen_id) {
+    if (nextScreen == session->game.screen.current_screen_id) {
         return;
     }
-    game.screen.current_screen_id = nextScreen;
+    session->game.screen.current_screen_id = nextScreen;
 
     int currentLinePos = 0;
     switch (nextScreen) {
         case Screen::Blank:
             break;
         case Screen::Help:
-            currentLinePos = showEquipmentHelpMenu(game.screen.screen_left_pos);
+            currentLinePos = showEquipmentHelpMenu(session->game.screen.screen_left_pos);
             break;
         case Screen::Inventory:
-            game.screen.screen_left_pos = displayInventoryItems(0, py.pack.unique_items - 1, config::options::show_inventory_weights, game.screen.screen_left_pos, CNIL);
-            currentLinePos = py.pack.unique_items;
+            session->game.screen.screen_left_pos = displayInventoryItems(0, session->py.pack.unique_items - 1, session->options.show_inventory_weights,
+                                                                         session->game.screen.screen_left_pos, CNIL);
+            currentLinePos = session->py.pack.unique_items;
             break;
         case Screen::Wear:
-            game.screen.screen_left_pos = displayInventoryItems(game.screen.wear_low_id, game.screen.wear_high_id, config::options::show_inventory_weights, game.screen.screen_left_pos, CNIL);
-            currentLinePos = game.screen.wear_high_id - game.screen.wear_low_id + 1;
+            session->game.screen.screen_left_pos = displayInventoryItems(session->game.screen.wear_low_id, session->game.screen.wear_high_id,
+                                                                         session->options.show_inventory_weights, session->game.screen.screen_left_pos, CNIL);
+            currentLinePos = session->game.screen.wear_high_id - session->game.screen.wear_low_id + 1;
             break;
         case Screen::Equipment:
-            game.screen.screen_left_pos = displayEquipment(config::options::show_inventory_weights, game.screen.screen_left_pos);
-            currentLinePos = py.equipment_count;
+            session->game.screen.screen_left_pos = displayEquipment(session->options.show_inventory_weights, session->game.screen.screen_left_pos);
+            currentLinePos = session->py.equipment_count;
             break;
         case Screen::Wrong:
         default:
             break;
     }
 
-    if (currentLinePos >= game.screen.screen_bottom_pos) {
-        game.screen.screen_bottom_pos = currentLinePos + 1;
-        eraseLine(Coord_t{game.screen.screen_bottom_pos, game.screen.screen_left_pos});
+    if (currentLinePos >= session->game.screen.screen_bottom_pos) {
+        session->game.screen.screen_bottom_pos = currentLinePos + 1;
+        eraseLine(Coord_t{session->game.screen.screen_bottom_pos, session->game.screen.screen_left_pos});
         return;
     }
     currentLinePos++;
 
-    while (currentLinePos <= game.screen.screen_bottom_pos) {
-        eraseLine(Coord_t{currentLinePos, game.screen.screen_left_pos});
+    while (currentLinePos <= session->game.screen.screen_bottom_pos) {
+        eraseLine(Coord_t{currentLinePos, session->game.screen.screen_left_pos});
         currentLinePos++;
     }
 }
@@ -324,7 +326,7 @@ static void uiCommandSwitchScreen(Screen nextScreen) {
 // Used to verify if this really is the item we wish to wear or read. -CJS-
 static bool verifyAction(const char *prompt, int item) {
     obj_desc_t description = {'\0'};
-    itemDescription(description, py.inventory[item], true);
+    itemDescription(description, session->py.inventory[item], true);
 
     // change the period to a question mark
     description[strlen(description) - 1] = '?';
@@ -336,10 +338,10 @@ static bool verifyAction(const char *prompt, int item) {
 }
 
 static void requestAndShowInventoryScreen(bool recoverScreen) {
-    if (game.doing_inventory_command == 0) {
-        game.screen.screen_left_pos = 50;
-        game.screen.screen_bottom_pos = 0;
-        game.screen.current_screen_id = Screen::Blank; // this forces exit of inventoryExecuteCommand() if selecting is not set true
+    if (session->game.doing_inventory_command == 0) {
+        session->game.screen.screen_left_pos = 50;
+        session->game.screen.screen_bottom_pos = 0;
+        session->game.screen.current_screen_id = Screen::Blank; // this forces exit of inventoryExecuteCommand() if selecting is not set true
         return;
     }
 
@@ -348,33 +350,33 @@ static void requestAndShowInventoryScreen(bool recoverScreen) {
     // If the screen has been flushed, we need to redraw. If the command
     // is a simple ' ' to recover the screen, just quit. Otherwise, check
     // and see what the user wants.
-    if (screen_has_changed) {
+    if (session->screen_has_changed) {
         if (recoverScreen || !getInputConfirmation("Continuing with inventory command?")) {
-            game.doing_inventory_command = 0;
+            session->game.doing_inventory_command = 0;
             return;
         }
-        game.screen.screen_left_pos = 50;
-        game.screen.screen_bottom_pos = 0;
+        session->game.screen.screen_left_pos = 50;
+        session->game.screen.screen_bottom_pos = 0;
     }
 
-    Screen currentScreen = game.screen.current_screen_id;
-    game.screen.current_screen_id = Screen::Wrong;
+    Screen currentScreen = session->game.screen.current_screen_id;
+    session->game.screen.current_screen_id = Screen::Wrong;
     uiCommandSwitchScreen(currentScreen);
 }
 
 static bool uiCommandInventoryTakeOffItem(bool selecting) {
-    if (py.equipment_count == 0) {
+    if (session->py.equipment_count == 0) {
         printMessage("You are not using any equipment.");
         // don't print message restarting inven command after taking off something, it is confusing
         return selecting;
     }
 
-    if (py.pack.unique_items >= PlayerEquipment::Wield && (game.doing_inventory_command == 0)) {
+    if (session->py.pack.unique_items >= PlayerEquipment::Wield && (session->game.doing_inventory_command == 0)) {
         printMessage("You will have to drop something first.");
         return selecting;
     }
 
-    if (game.screen.current_screen_id != Screen::Blank) {
+    if (session->game.screen.current_screen_id != Screen::Blank) {
         uiCommandSwitchScreen(Screen::Equipment);
     }
 
@@ -382,22 +384,22 @@ static bool uiCommandInventoryTakeOffItem(bool selecting) {
 }
 
 static bool uiCommandInventoryDropItem(char &command, bool selecting) {
-    if (py.pack.unique_items == 0 && py.equipment_count == 0) {
+    if (session->py.pack.unique_items == 0 && session->py.equipment_count == 0) {
         printMessage("But you're not carrying anything.");
         return selecting;
     }
 
-    if (dg.floor[py.pos.y][py.pos.x].treasure_id != 0) {
+    if (session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id != 0) {
         printMessage("There's no room to drop anything here.");
         return selecting;
     }
 
-    if ((game.screen.current_screen_id == Screen::Equipment && py.equipment_count > 0) || py.pack.unique_items == 0) {
-        if (game.screen.current_screen_id != Screen::Blank) {
+    if ((session->game.screen.current_screen_id == Screen::Equipment && session->py.equipment_count > 0) || session->py.pack.unique_items == 0) {
+        if (session->game.screen.current_screen_id != Screen::Blank) {
             uiCommandSwitchScreen(Screen::Equipment);
         }
         command = 'r'; // Remove - or take off and drop.
-    } else if (game.screen.current_screen_id != Screen::Blank) {
+    } else if (session->game.screen.current_screen_id != Screen::Blank) {
         uiCommandSwitchScreen(Screen::Inventory);
     }
 
@@ -406,24 +408,24 @@ static bool uiCommandInventoryDropItem(char &command, bool selecting) {
 
 static bool uiCommandInventoryWearWieldItem(bool selecting) {
     // Note: simple loop to get the global game.screen.wear_low_id value
-    game.screen.wear_low_id = 0;
-    while (game.screen.wear_low_id < py.pack.unique_items && py.inventory[game.screen.wear_low_id].category_id > TV_MAX_WEAR) {
-        game.screen.wear_low_id++;
+    session->game.screen.wear_low_id = 0;
+    while (session->game.screen.wear_low_id < session->py.pack.unique_items && session->py.inventory[session->game.screen.wear_low_id].category_id > TV_MAX_WEAR) {
+        session->game.screen.wear_low_id++;
     }
 
     // Note: simple loop to get the global wear_high value
-    game.screen.wear_high_id = game.screen.wear_low_id;
-    while (game.screen.wear_high_id < py.pack.unique_items && py.inventory[game.screen.wear_high_id].category_id >= TV_MIN_WEAR) {
-        game.screen.wear_high_id++;
+    session->game.screen.wear_high_id = session->game.screen.wear_low_id;
+    while (session->game.screen.wear_high_id < session->py.pack.unique_items && session->py.inventory[session->game.screen.wear_high_id].category_id >= TV_MIN_WEAR) {
+        session->game.screen.wear_high_id++;
     }
-    game.screen.wear_high_id--;
+    session->game.screen.wear_high_id--;
 
-    if (game.screen.wear_low_id > game.screen.wear_high_id) {
+    if (session->game.screen.wear_low_id > session->game.screen.wear_high_id) {
         printMessage("You have nothing to wear or wield.");
         return selecting;
     }
 
-    if (game.screen.current_screen_id != Screen::Blank && game.screen.current_screen_id != Screen::Inventory) {
+    if (session->game.screen.current_screen_id != Screen::Blank && session->game.screen.current_screen_id != Screen::Inventory) {
         uiCommandSwitchScreen(Screen::Wear);
     }
 
@@ -438,7 +440,7 @@ static void uiCommandInventoryUnwieldItem() {
 
     if (playerWornItemIsCursed(PlayerEquipment::Wield)) {
         obj_desc_t description = {'\0'};
-        itemDescription(description, py.inventory[PlayerEquipment::Wield], false);
+        itemDescription(description, session->py.inventory[PlayerEquipment::Wield], false);
 
         obj_desc_t msg = {'\0'};
         (void) sprintf(msg, "The %s you are wielding appears to be cursed.", description);
@@ -448,26 +450,26 @@ static void uiCommandInventoryUnwieldItem() {
         return;
     }
 
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
     // swap auxiliary and wield items
-    Inventory_t savedItem = py.inventory[PlayerEquipment::Auxiliary];
-    py.inventory[PlayerEquipment::Auxiliary] = py.inventory[PlayerEquipment::Wield];
-    py.inventory[PlayerEquipment::Wield] = savedItem;
+    Inventory_t savedItem = session->py.inventory[PlayerEquipment::Auxiliary];
+    session->py.inventory[PlayerEquipment::Auxiliary] = session->py.inventory[PlayerEquipment::Wield];
+    session->py.inventory[PlayerEquipment::Wield] = savedItem;
 
-    if (game.screen.current_screen_id == Screen::Equipment) {
-        game.screen.screen_left_pos = displayEquipment(config::options::show_inventory_weights, game.screen.screen_left_pos);
+    if (session->game.screen.current_screen_id == Screen::Equipment) {
+        session->game.screen.screen_left_pos = displayEquipment(session->options.show_inventory_weights, session->game.screen.screen_left_pos);
     }
 
-    playerAdjustBonusesForItem(py.inventory[PlayerEquipment::Auxiliary], -1); // Subtract bonuses
-    playerAdjustBonusesForItem(py.inventory[PlayerEquipment::Wield], 1);      // Add bonuses
+    playerAdjustBonusesForItem(session->py.inventory[PlayerEquipment::Auxiliary], -1); // Subtract bonuses
+    playerAdjustBonusesForItem(session->py.inventory[PlayerEquipment::Wield], 1);      // Add bonuses
 
-    if (py.inventory[PlayerEquipment::Wield].category_id != TV_NOTHING) {
+    if (session->py.inventory[PlayerEquipment::Wield].category_id != TV_NOTHING) {
         obj_desc_t label = {'\0'};
         (void) strcpy(label, "Primary weapon   : ");
 
         obj_desc_t description = {'\0'};
-        itemDescription(description, py.inventory[PlayerEquipment::Wield], true);
+        itemDescription(description, session->py.inventory[PlayerEquipment::Wield], true);
 
         printMessage(strcat(label, description));
     } else {
@@ -475,7 +477,7 @@ static void uiCommandInventoryUnwieldItem() {
     }
 
     // this is a new weapon, so clear the heavy flag
-    py.weapon_is_heavy = false;
+    session->py.weapon_is_heavy = false;
     playerStrength();
 }
 
@@ -486,7 +488,7 @@ static int inventoryGetItemMatchingInscription(char which, char command, int fro
     if (which >= '0' && which <= '9' && command != 'r' && command != 't') {
         // Note: simple loop to get id
         int m = from;
-        while (m <= to && m < PLAYER_INVENTORY_SIZE && ((py.inventory[m].inscription[0] != which) || (py.inventory[m].inscription[1] != '\0'))) {
+        while (m <= to && m < PLAYER_INVENTORY_SIZE && ((session->py.inventory[m].inscription[0] != which) || (session->py.inventory[m].inscription[1] != '\0'))) {
             m++;
         }
 
@@ -509,7 +511,7 @@ static void buildCommandHeading(char *str, int from, int to, const char *swap, c
     to += 'a';
 
     const char *list = "";
-    if (game.screen.current_screen_id == Screen::Blank) {
+    if (session->game.screen.current_screen_id == Screen::Blank) {
         list = ", * to list";
     }
 
@@ -524,7 +526,7 @@ static void buildCommandHeading(char *str, int from, int to, const char *swap, c
 static void changeScreenForCommand(char command) {
     if (command == 't' || command == 'r') {
         uiCommandSwitchScreen(Screen::Equipment);
-    } else if (command == 'w' && game.screen.current_screen_id != Screen::Inventory) {
+    } else if (command == 'w' && session->game.screen.current_screen_id != Screen::Inventory) {
         uiCommandSwitchScreen(Screen::Wear);
     } else {
         uiCommandSwitchScreen(Screen::Inventory);
@@ -532,9 +534,9 @@ static void changeScreenForCommand(char command) {
 }
 
 static void flipInventoryEquipmentScreens() {
-    if (game.screen.current_screen_id == Screen::Equipment) {
+    if (session->game.screen.current_screen_id == Screen::Equipment) {
         uiCommandSwitchScreen(Screen::Inventory);
-    } else if (game.screen.current_screen_id == Screen::Inventory) {
+    } else if (session->game.screen.current_screen_id == Screen::Inventory) {
         uiCommandSwitchScreen(Screen::Equipment);
     }
 }
@@ -628,7 +630,7 @@ static int inventoryGetSlotToWearEquipment(int categoryId) {
 
 static void inventoryItemIsCursedMessage(int itemId) {
     obj_desc_t description = {'\0'};
-    itemDescription(description, py.inventory[itemId], false);
+    itemDescription(description, session->py.inventory[itemId], false);
 
     obj_desc_t msg = {'\0'};
     (void) sprintf(msg, "The %s you are ", description);
@@ -649,18 +651,18 @@ static bool executeRemoveItemCommand(bool selecting, int itemId, char &command,
 
     do {
         itemId++;
-        if (py.inventory[itemId].category_id != TV_NOTHING) {
+        if (session->py.inventory[itemId].category_id != TV_NOTHING) {
             itemIdToTakeOff--;
         }
     } while (itemIdToTakeOff >= 0);
 
     if ((isupper((int) *which) != 0) && !verifyAction((char *) prompt, itemId)) {
         itemId = -1;
-    } else if (inventoryItemIsCursed(py.inventory[itemId])) {
+    } else if (inventoryItemIsCursed(session->py.inventory[itemId])) {
         itemId = -1;
         printMessage("Hmmm, it seems to be cursed.");
-    } else if (command == 't' && !inventoryCanCarryItemCount(py.inventory[itemId])) {
-        if (dg.floor[py.pos.y][py.pos.x].treasure_id != 0) {
+    } else if (command == 't' && !inventoryCanCarryItemCount(session->py.inventory[itemId])) {
+        if (session->dg.floor[session->py.pos.y][session->py.pos.x].treasure_id != 0) {
             itemId = -1;
             printMessage("You can't carry it.");
         } else if (getInputConfirmation("You can't carry it.  Drop it?")) {
@@ -675,15 +677,15 @@ static bool executeRemoveItemCommand(bool selecting, int itemId, char &command,
             inventoryDropItem(itemId, true);
             // As a safety measure, set the player's inven
             // weight to 0, when the last object is dropped.
-            if (py.pack.unique_items == 0 && py.equipment_count == 0) {
-                py.pack.weight = 0;
+            if (session->py.pack.unique_items == 0 && session->py.equipment_count == 0) {
+                session->py.pack.weight = 0;
             }
         } else {
-            playerTakeOff(itemId, inventoryCarryItem(py.inventory[itemId]));
+            playerTakeOff(itemId, inventoryCarryItem(session->py.inventory[itemId]));
         }
 
         playerStrength();
-        game.player_free_turn = false;
+        session->game.player_free_turn = false;
 
         if (command == 'r') {
             selecting = false;
@@ -700,17 +702,18 @@ static void executeWearItemCommand(int itemId, const char *which, const char *pr
     if ((isupper((int) *which) != 0) && !verifyAction((char *) prompt, itemId)) {
         itemId = -1;
     } else {
-        slot = inventoryGetSlotToWearEquipment(py.inventory[itemId].category_id);
+        slot = inventoryGetSlotToWearEquipment(session->py.inventory[itemId].category_id);
         if (slot == -1) {
             itemId = -1;
         }
     }
 
-    if (itemId >= 0 && py.inventory[slot].category_id != TV_NOTHING) {
-        if (inventoryItemIsCursed(py.inventory[slot])) {
+    if (itemId >= 0 && session->py.inventory[slot].category_id != TV_NOTHING) {
+        if (inventoryItemIsCursed(session->py.inventory[slot])) {
             inventoryItemIsCursedMessage(slot);
             itemId = -1;
-        } else if (py.inventory[itemId].sub_category_id == ITEM_GROUP_MIN && py.inventory[itemId].items_count > 1 && !inventoryCanCarryItemCount(py.inventory[slot])) {
+        } else if (session->py.inventory[itemId].sub_category_id == ITEM_GROUP_MIN && session->py.inventory[itemId].items_count > 1 &&
+                   !inventoryCanCarryItemCount(session->py.inventory[slot])) {
             // this can happen if try to wield a torch,
             // and have more than one in inventory
             printMessage("You will have to drop something first.");
@@ -723,38 +726,38 @@ static void executeWearItemCommand(int itemId, const char *which, const char *pr
     }
 
     // OK. Wear it.
-    game.player_free_turn = false;
+    session->game.player_free_turn = false;
 
     //
     // 1. remove new item from inventory
     //
-    Inventory_t savedItem = py.inventory[itemId];
+    Inventory_t savedItem = session->py.inventory[itemId];
     Inventory_t *item = &savedItem;
 
-    game.screen.wear_high_id--;
+    session->game.screen.wear_high_id--;
 
     // Fix for torches
     if (item->items_count > 1 && item->sub_category_id <= ITEM_SINGLE_STACK_MAX) {
         item->items_count = 1;
-        game.screen.wear_high_id++;
+        session->game.screen.wear_high_id++;
     }
 
-    py.pack.weight += item->weight * item->items_count;
+    session->py.pack.weight += item->weight * item->items_count;
     inventoryDestroyItem(itemId); // Subtracts weight
 
     //
     // 2. add old item to inv and remove from equipment list, if necessary.
     //
-    item = &py.inventory[slot];
+    item = &session->py.inventory[slot];
     if (item->category_id != TV_NOTHING) {
-        int uniqItems = py.pack.unique_items;
+        int uniqItems = session->py.pack.unique_items;
 
         int id = inventoryCarryItem(*item);
 
         // If item removed did not stack with anything
         // in inventory, then increment wear_high.
-        if (py.pack.unique_items != uniqItems) {
-            game.screen.wear_high_id++;
+        if (session->py.pack.unique_items != uniqItems) {
+            session->game.screen.wear_high_id++;
         }
 
         playerTakeOff(slot, id);
@@ -764,7 +767,7 @@ static void executeWearItemCommand(int itemId, const char *which, const char *pr
     // 3. wear new item
     //
     *item = savedItem;
-    py.equipment_count++;
+    session->py.equipment_count++;
 
     playerAdjustBonusesForItem(*item, 1);
 
@@ -785,7 +788,7 @@ static void executeWearItemCommand(int itemId, const char *which, const char *pr
     itemId = 0;
 
     while (itemIdToTakeOff != slot) {
-        if (py.inventory[itemIdToTakeOff++].category_id != TV_NOTHING) {
+        if (session->py.inventory[itemIdToTakeOff++].category_id != TV_NOTHING) {
             itemId++;
         }
     }
@@ -796,7 +799,7 @@ static void executeWearItemCommand(int itemId, const char *which, const char *pr
 
     // this is a new weapon, so clear heavy flag
     if (slot == PlayerEquipment::Wield) {
-        py.weapon_is_heavy = false;
+        session->py.weapon_is_heavy = false;
     }
     playerStrength();
 
@@ -812,9 +815,9 @@ static void executeWearItemCommand(int itemId, const char *which, const char *pr
 static void executeDropItemCommand(int itemId, const char *which, const char *prompt) {
     int confirmed = -1;
 
-    if (py.inventory[itemId].items_count > 1) {
+    if (session->py.inventory[itemId].items_count > 1) {
         obj_desc_t description = {'\0'};
-        itemDescription(description, py.inventory[itemId], true);
+        itemDescription(description, session->py.inventory[itemId], true);
         description[strlen(description) - 1] = '?'; // replace period with question
 
         obj_desc_t msg = {'\0'};
@@ -831,7 +834,7 @@ static void executeDropItemCommand(int itemId, const char *which, const char *pr
     }
 
     if (itemId >= 0) {
-        game.player_free_turn = false;
+        session->game.player_free_turn = false;
 
         inventoryDropItem(itemId, confirmed == 1);
         playerStrength();
@@ -839,8 +842,8 @@ static void executeDropItemCommand(int itemId, const char *which, const char *pr
 
     // As a safety measure, set the player's inven weight
     // to 0, when the last object is dropped.
-    if (py.pack.unique_items == 0 && py.equipment_count == 0) {
-        py.pack.weight = 0;
+    if (session->py.pack.unique_items == 0 && session->py.equipment_count == 0) {
+        session->py.pack.weight = 0;
     }
 }
 
@@ -849,24 +852,24 @@ static bool selectItemCommands(char *command, char *which, bool selecting) {
     const char *prompt = nullptr;
     const char *swap = nullptr;
 
-    while (selecting && game.player_free_turn) {
+    while (selecting && session->game.player_free_turn) {
         swap = "";
 
         if (*command == 'w') {
-            fromLine = game.screen.wear_low_id;
-            toLine = game.screen.wear_high_id;
+            fromLine = session->game.screen.wear_low_id;
+            toLine = session->game.screen.wear_high_id;
             prompt = "Wear/Wield";
         } else {
             fromLine = 0;
             if (*command == 'd') {
-                toLine = py.pack.unique_items - 1;
+                toLine = session->py.pack.unique_items - 1;
                 prompt = "Drop";
 
-                if (py.equipment_count > 0) {
+                if (session->py.equipment_count > 0) {
                     swap = ", / for Equip";
                 }
             } else {
-                toLine = py.equipment_count - 1;
+                toLine = session->py.equipment_count - 1;
 
                 if (*command == 't') {
                     prompt = "Take off";
@@ -874,7 +877,7 @@ static bool selectItemCommands(char *command, char *which, bool selecting) {
                     // command == 'r'
 
                     prompt = "Throw off";
-                    if (py.pack.unique_items > 0) {
+                    if (session->py.pack.unique_items > 0) {
                         swap = ", / for Inven";
                     }
                 }
@@ -937,7 +940,7 @@ static bool selectItemCommands(char *command, char *which, bool selecting) {
             selecting = false;
         }
 
-        if (!game.player_free_turn && game.screen.current_screen_id == Screen::Blank) {
+        if (!session->game.player_free_turn && session->game.screen.current_screen_id == Screen::Blank) {
             selecting = false;
         }
     }
@@ -947,29 +950,31 @@ static bool selectItemCommands(char *command, char *which, bool selecting) {
 
 // Put an appropriate header message (on message line).
 static void inventoryDisplayAppropriateHeader() {
-    if (game.screen.current_screen_id == Screen::Inventory) {
+    if (session->game.screen.current_screen_id == Screen::Inventory) {
         obj_desc_t msg = {'\0'};
-        int weightQuotient = py.pack.weight / 10;
-        int weightRemainder = py.pack.weight % 10;
+        int weightQuotient = session->py.pack.weight / 10;
+        int weightRemainder = session->py.pack.weight % 10;
 
-        if (!config::options::show_inventory_weights || py.pack.unique_items == 0) {
-            (void) sprintf(msg, "You are carrying %d.%d pounds. In your pack there is %s", weightQuotient, weightRemainder, (py.pack.unique_items == 0 ? "nothing." : "-"));
+        if (!session->options.show_inventory_weights || session->py.pack.unique_items == 0) {
+            (void) sprintf(msg, "You are carrying %d.%d pounds. In your pack there is %s", weightQuotient, weightRemainder,
+                           (session->py.pack.unique_items == 0 ? "nothing." : "-"));
         } else {
             int capacityQuotient = playerCarryingLoadLimit() / 10;
             int capacityRemainder = playerCarryingLoadLimit() % 10;
 
-            (void) sprintf(msg, "You are carrying %d.%d pounds. Your capacity is %d.%d pounds. In your pack is -", weightQuotient, weightRemainder, capacityQuotient, capacityRemainder);
+            (void) sprintf(msg, "You are carrying %d.%d pounds. Your capacity is %d.%d pounds. In your pack is -", weightQuotient, weightRemainder, capacityQuotient,
+                           capacityRemainder);
         }
 
         putStringClearToEOL(msg, Coord_t{0, 0}  );
-    } else if (game.screen.current_screen_id == Screen::Wear) {
-        if (game.screen.wear_high_id < game.screen.wear_low_id) {
+    } else if (session->game.screen.current_screen_id == Screen::Wear) {
+        if (session->game.screen.wear_high_id < session->game.screen.wear_low_id) {
             putStringClearToEOL("You have nothing you could wield.", Coord_t{0, 0});
         } else {
             putStringClearToEOL("You could wield -", Coord_t{0, 0});
         }
-    } else if (game.screen.current_screen_id == Screen::Equipment) {
-        if (py.equipment_count == 0) {
+    } else if (session->game.screen.current_screen_id == Screen::Equipment) {
+        if (session->py.equipment_count == 0) {
             putStringClearToEOL("You are not using anything.", Coord_t{0, 0});
         } else {
             putStringClearToEOL("You are using -", Coord_t{0, 0});
@@ -978,11 +983,11 @@ static void inventoryDisplayAppropriateHeader() {
         putStringClearToEOL("Allowed commands:", Coord_t{0, 0});
     }
 
-    eraseLine(Coord_t{game.screen.screen_bottom_pos, game.screen.screen_left_pos});
+    eraseLine(Coord_t{session->game.screen.screen_bottom_pos, session->game.screen.screen_left_pos});
 }
 
 static void uiCommandDisplayInventory() {
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         printMessage("You are not carrying anything.");
     } else {
         uiCommandSwitchScreen(Screen::Inventory);
@@ -990,7 +995,7 @@ static void uiCommandDisplayInventory() {
 }
 
 static void uiCommandDisplayEquipment() {
-    if (py.equipment_count == 0) {
+    if (session->py.equipment_count == 0) {
         printMessage("You are not using any equipment.");
     } else {
         uiCommandSwitchScreen(Screen::Equipment);
@@ -999,7 +1004,7 @@ static void uiCommandDisplayEquipment() {
 
 // This does all the work.
 void inventoryExecuteCommand(char command) {
-    game.player_free_turn = true;
+    session->game.player_free_turn = true;
 
     terminalSaveScreen();
 
@@ -1049,42 +1054,42 @@ void inventoryExecuteCommand(char command) {
 
         // Clear the game.doing_inventory_command flag here, instead of at beginning, so that
         // can use it to control when messages above appear.
-        game.doing_inventory_command = 0;
+        session->game.doing_inventory_command = 0;
 
         // Keep looking for objects to drop/wear/take off/throw off
         char which = 'z';
 
         selecting = selectItemCommands(&command, &which, selecting);
 
-        if (which == ESCAPE || game.screen.current_screen_id == Screen::Blank) {
+        if (which == ESCAPE || session->game.screen.current_screen_id == Screen::Blank) {
             command = ESCAPE;
-        } else if (!game.player_free_turn) {
+        } else if (!session->game.player_free_turn) {
             // Save state for recovery if they want to call us again next turn.
             // Otherwise, set a dummy command to recover screen.
             if (selecting) {
-                game.doing_inventory_command = command;
+                session->game.doing_inventory_command = command;
             } else {
-                game.doing_inventory_command = ' ';
+                session->game.doing_inventory_command = ' ';
             }
 
             // flush last message before clearing screen_has_changed and exiting
             printMessage(CNIL);
 
             // This lets us know if the world changes
-            screen_has_changed = false;
+            session->screen_has_changed = false;
 
             command = ESCAPE;
         } else {
             inventoryDisplayAppropriateHeader();
 
-            putString("e/i/t/w/x/d/?/ESC:", Coord_t{game.screen.screen_bottom_pos, 60});
+            putString("e/i/t/w/x/d/?/ESC:", Coord_t{session->game.screen.screen_bottom_pos, 60});
             command = getKeyInput();
 
-            eraseLine(Coord_t{game.screen.screen_bottom_pos, game.screen.screen_left_pos});
+            eraseLine(Coord_t{session->game.screen.screen_bottom_pos, session->game.screen.screen_left_pos});
         }
     } while (command != ESCAPE);
 
-    if (game.screen.current_screen_id != Screen::Blank) {
+    if (session->game.screen.current_screen_id != Screen::Blank) {
         terminalRestoreScreen();
     }
 
@@ -1103,7 +1108,7 @@ static bool inventorySwitchPackMenu(vtype_t &prompt, PackMenu &menu, bool menuAc
     if (menu == PackMenu::Inventory) {
         bool changed = false;
 
-        if (py.equipment_count == 0) {
+        if (session->py.equipment_count == 0) {
             putStringClearToEOL("But you're not using anything -more-", Coord_t{0, 0});
             (void) getKeyInput();
         } else {
@@ -1111,21 +1116,21 @@ static bool inventorySwitchPackMenu(vtype_t &prompt, PackMenu &menu, bool menuAc
             changed = true;
 
             if (menuActive) {
-                itemIdEnd = py.equipment_count;
+                itemIdEnd = session->py.equipment_count;
 
-                while (itemIdEnd < py.pack.unique_items) {
+                while (itemIdEnd < session->py.pack.unique_items) {
                     itemIdEnd++;
                     eraseLine(Coord_t{itemIdEnd, 0});
                 }
             }
-            itemIdEnd = py.equipment_count - 1;
+            itemIdEnd = session->py.equipment_count - 1;
         }
 
         putStringClearToEOL(prompt, Coord_t{0, 0});
         return changed;
     }
 
-    if (py.pack.unique_items == 0) {
+    if (session->py.pack.unique_items == 0) {
         putStringClearToEOL("But you're not carrying anything -more-", Coord_t{0, 0});
         (void) getKeyInput();
         return false;
@@ -1133,14 +1138,14 @@ static bool inventorySwitchPackMenu(vtype_t &prompt, PackMenu &menu, bool menuAc
 
     menu = PackMenu::Inventory;
     if (menuActive) {
-        itemIdEnd = py.pack.unique_items;
+        itemIdEnd = session->py.pack.unique_items;
 
-        while (itemIdEnd < py.equipment_count) {
+        while (itemIdEnd < session->py.equipment_count) {
             itemIdEnd++;
             eraseLine(Coord_t{itemIdEnd, 0});
         }
     }
-    itemIdEnd = py.pack.unique_items - 1;
+    itemIdEnd = session->py.pack.unique_items - 1;
     return true;
 }
 
@@ -1152,15 +1157,15 @@ bool inventoryGetInputForItemId(int &commandKeyId, const char *prompt, int itemI
     if (itemIdEnd > PlayerEquipment::Wield) {
         packFull = true;
 
-        if (py.pack.unique_items == 0) {
+        if (session->py.pack.unique_items == 0) {
             menu = PackMenu::Equipment;
-            itemIdEnd = py.equipment_count - 1;
+            itemIdEnd = session->py.equipment_count - 1;
         } else {
-            itemIdEnd = py.pack.unique_items - 1;
+            itemIdEnd = session->py.pack.unique_items - 1;
         }
     }
 
-    if (py.pack.unique_items < 1 && (!packFull || py.equipment_count < 1)) {
+    if (session->py.pack.unique_items < 1 && (!packFull || session->py.equipment_count < 1)) {
         putStringClearToEOL("You are not carrying anything.", Coord_t{0, 0});
         return false;
     }
@@ -1213,7 +1218,7 @@ bool inventoryGetInputForItemId(int &commandKeyId, const char *prompt, int itemI
                 case ESCAPE:
                     menu = PackMenu::CloseMenu;
                     done = true;
-                    game.player_free_turn = true;
+                    session->game.player_free_turn = true;
                     break;
                 case '/':
                     done = inventorySwitchPackMenu(description, menu, menuActive, itemIdEnd);
@@ -1232,7 +1237,8 @@ bool inventoryGetInputForItemId(int &commandKeyId, const char *prompt, int itemI
                         int m;
 
                         // Note: loop to find the inventory item
-                        for (m = itemIdStart; m < PlayerEquipment::Wield && (py.inventory[m].inscription[0] != which || py.inventory[m].inscription[1] != '\0'); m++)
+                        for (m = itemIdStart; m < PlayerEquipment::Wield && (session->py.inventory[m].inscription[0] != which ||
+                                                                             session->py.inventory[m].inscription[1] != '\0'); m++)
                             ;
 
                         if (m < PlayerEquipment::Wield) {
@@ -1254,7 +1260,7 @@ bool inventoryGetInputForItemId(int &commandKeyId, const char *prompt, int itemI
                             do {
                                 // Note: a simple loop to find first inventory item
                                 itemIdStart++;
-                                while (py.inventory[itemIdStart].category_id == TV_NOTHING) {
+                                while (session->py.inventory[itemIdStart].category_id == TV_NOTHING) {
                                     itemIdStart++;
                                 }
 
@@ -1268,7 +1274,7 @@ bool inventoryGetInputForItemId(int &commandKeyId, const char *prompt, int itemI
                             menu = PackMenu::CloseMenu;
                             done = true;
 
-                            game.player_free_turn = true;
+                            session->game.player_free_turn = true;
 
                             break;
                         }
@@ -3,19 +3,17 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
-// Terminal I/O code, uses the curses package
+// Terminal I/O code, uses the curses package or the ANSI output of ui_ansi.cpp
 
 #include <cstdlib>
 #include "headers.h"
 #include "curses.h"
 
-static bool curses_on = false;
+static TerminalOutput terminal_output = TerminalOutput::Curses;
 
 // Spare window for saving the screen. -CJS-
 static WINDOW *save_screen;
 
-int eof_flag = 0;        // Is used to signal EOF/HANGUP condition
-bool panic_save = false; // True if playing from a panic save
 
 // Set up the terminal into a suitable state -MRC-
 static void moriaTerminalInitialize() {
@@ -30,11 +28,87 @@ static void moriaTerminalInitialize() {
     set_escdelay(50); // <curses.h> default delay on macOS is 1 second, let's do something about that!
 #endif
 
-    curses_on = true;
+    session->terminal_on = true;
+}
+
+static bool usingAnsiOutput() {
+    return terminal_output == TerminalOutput::Ansi;
+}
+
+// The screen primitives, done by whichever output is in use
+
+static bool screenMove(Coord_t const &coord) {
+    if (usingAnsiOutput()) {
+        return ansiMove(coord);
+    }
+    return move(coord.y, coord.x) != ERR;
+}
+
+static bool screenAddChar(char ch) {
+    if (usingAnsiOutput()) {
+        return ansiAddChar(ch);
+    }
+    return addch(ch) != ERR;
+}
+
+static bool screenAddString(const char *str) {
+    if (usingAnsiOutput()) {
+        return ansiAddString(str);
+    }
+    return addstr(str) != ERR;
+}
+
+static void screenClearToEOL() {
+    if (usingAnsiOutput()) {
+        ansiClearToEOL();
+    } else {
+        (void) clrtoeol();
+    }
+}
+
+static void screenClearToBottom() {
+    if (usingAnsiOutput()) {
+        ansiClearToBottom();
+    } else {
+        (void) clrtobot();
+    }
+}
+
+static void screenClear() {
+    if (usingAnsiOutput()) {
+        ansiClear();
+    } else {
+        (void) clear();
+    }
+}
+
+static void screenRefresh() {
+    if (usingAnsiOutput()) {
+        ansiRefresh();
+    } else {
+        (void) refresh();
+    }
+}
+
+static int screenGetKey() {
+    if (usingAnsiOutput()) {
+        return ansiGetKey();
+    }
+    return getch();
+}
+
+// Choose the output before the terminal is initialized
+void setTerminalOutput(TerminalOutput output) {
+    terminal_output = output;
 }
 
 // initializes the terminal / curses routines
 bool terminalInitialize() {
+    if (usingAnsiOutput()) {
+        session->terminal_on = ansiTerminalInitialize();
+        return session->terminal_on;
+    }
+
     initscr();
 
     // Check we have enough screen. -CJS-
@@ -59,7 +133,14 @@ bool terminalInitialize() {
 
 // Put the terminal in the original mode. -CJS-
 void terminalRestore() {
-    if (!curses_on) {
+    if (!session->terminal_on) {
+        return;
+    }
+
+    if (usingAnsiOutput()) {
+        ansiTerminalRestore();
+        recordingStop();
+        session->terminal_on = false;
         return;
     }
 
@@ -76,14 +157,22 @@ void terminalRestore() {
     endwin();
     (void) fflush(stdout);
 
-    curses_on = false;
+    session->terminal_on = false;
 }
 
 void terminalSaveScreen() {
+    if (usingAnsiOutput()) {
+        ansiSaveScreen();
+        return;
+    }
     overwrite(stdscr, save_screen);
 }
 
 void terminalRestoreScreen() {
+    if (usingAnsiOutput()) {
+        ansiRestoreScreen();
+        return;
+    }
     overwrite(save_screen, stdscr);
     touchwin(stdscr);
 }
@@ -92,24 +181,29 @@ ssize_t terminalBellSound() {
     putQIO();
 
     // The player can turn off beeps if they find them annoying.
-    if (config::options::error_beep_sound) {
-        return write(1, "\007", 1);
+    if (!session->options.error_beep_sound) {
+        return 0;
+    }
+
+    if (usingAnsiOutput()) {
+        ansiBell();
+        return 1;
     }
 
-    return 0;
+    return write(1, "\007", 1);
 }
 
 // Dump the IO buffer to terminal -RAK-
 void putQIO() {
     // Let inventoryExecuteCommand() know something has changed.
-    screen_has_changed = true;
+    session->screen_has_changed = true;
 
-    (void) refresh();
+    screenRefresh();
 }
 
 // Flush the buffer -RAK-
 void flushInputBuffer() {
-    if (eof_flag != 0) {
+    if (session->eof_flag != 0) {
         return;
     }
 
@@ -119,24 +213,24 @@ void flushInputBuffer() {
 
 // Clears screen
 void clearScreen() {
-    if (message_ready_to_print) {
+    if (session->message_ready_to_print) {
         printMessage(CNIL);
     }
-    (void) clear();
+    screenClear();
 }
 
 void clearToBottom(int row) {
-    (void) move(row, 0);
-    clrtobot();
+    (void) screenMove(Coord_t{row, 0});
+    screenClearToBottom();
 }
 
 // move cursor to a given y, x position
 void moveCursor(Coord_t coord) {
-    (void) move(coord.y, coord.x);
+    (void) screenMove(coord);
 }
 
 void addChar(char ch, Coord_t coord) {
-    if (mvaddch(coord.y, coord.x, ch) == ERR) {
+    if (!screenMove(coord) || !screenAddChar(ch)) {
         abort();
     }
 }
@@ -152,39 +246,39 @@ void putString(const char *out_str, Coord_t coord) {
     (void) strncpy(str, out_str, (size_t)(79 - coord.x));
     str[79 - coord.x] = '\0';
 
-    if (mvaddstr(coord.y, coord.x, str) == ERR) {
+    if (!screenMove(coord) || !screenAddString(str)) {
         abort();
     }
 }
 
 // Outputs a line to a given y, x position -RAK-
 void putStringClearToEOL(const std::string &str, Coord_t coord) {
-    if (coord.y == MSG_LINE && message_ready_to_print) {
+    if (coord.y == MSG_LINE && session->message_ready_to_print) {
         printMessage(CNIL);
     }
 
-    (void) move(coord.y, coord.x);
-    clrtoeol();
+    (void) screenMove(coord);
+    screenClearToEOL();
     putString(str.c_str(), coord);
 }
 
 // Clears given line of text -RAK-
 void eraseLine(Coord_t coord) {
-    if (coord.y == MSG_LINE && message_ready_to_print) {
+    if (coord.y == MSG_LINE && session->message_ready_to_print) {
         printMessage(CNIL);
     }
 
-    (void) move(coord.y, coord.x);
-    clrtoeol();
+    (void) screenMove(coord);
+    screenClearToEOL();
 }
 
 // Moves the cursor to a given interpolated y, x position -RAK-
 void panelMoveCursor(Coord_t coord) {
     // Real coords convert to screen positions
-    coord.y -= dg.panel.row_prt;
-    coord.x -= dg.panel.col_prt;
+    coord.y -= session->dg.panel.row_prt;
+    coord.x -= session->dg.panel.col_prt;
 
-    if (move(coord.y, coord.x) == ERR) {
+    if (!screenMove(coord)) {
         abort();
     }
 }
@@ -192,16 +286,22 @@ void panelMoveCursor(Coord_t coord) {
 // Outputs a char to a given interpolated y, x position -RAK-
 // sign bit of a character used to indicate standout mode. -CJS
 void panelPutTile(char ch, Coord_t coord) {
+    dungeonOverviewTouch(coord);
+
     // Real coords convert to screen positions
-    coord.y -= dg.panel.row_prt;
-    coord.x -= dg.panel.col_prt;
+    coord.y -= session->dg.panel.row_prt;
+    coord.x -= session->dg.panel.col_prt;
 
-    if (mvaddch(coord.y, coord.x, ch) == ERR) {
+    if (!screenMove(coord) || !screenAddChar(ch)) {
         abort();
     }
 }
 
 static Coord_t currentCursorPosition() {
+    if (usingAnsiOutput()) {
+        return ansiCursor();
+    }
+
     int y, x;
     getyx(stdscr, y, x);
     return Coord_t{y, x};
@@ -214,16 +314,16 @@ void messageLinePrintMessage(std::string message) {
     Coord_t coord = currentCursorPosition();
 
     // move to beginning of message line, and clear it
-    move(0, 0);
-    clrtoeol();
+    (void) screenMove(Coord_t{0, 0});
+    screenClearToEOL();
 
     // truncate message if it's too long!
     message.resize(79);
 
-    addstr(message.c_str());
+    (void) screenAddString(message.c_str());
 
     // restore cursor to old position
-    move(coord.y, coord.x);
+    (void) screenMove(coord);
 }
 
 // deleteMessageLine will delete all text from the message line (0,0).
@@ -233,11 +333,11 @@ void messageLineClear() {
     Coord_t coord = currentCursorPosition();
 
     // move to beginning of message line, and clear it
-    move(0, 0);
-    clrtoeol();
+    (void) screenMove(Coord_t{0, 0});
+    screenClearToEOL();
 
     // restore cursor to old position
-    move(coord.y, coord.x);
+    (void) screenMove(coord);
 }
 
 // Outputs message to top line of screen
@@ -247,8 +347,8 @@ void printMessage(const char *msg) {
     int old_len = 0;
     bool combine_messages = false;
 
-    if (message_ready_to_print) {
-        old_len = (int) strlen(messages[last_message_id]) + 1;
+    if (session->message_ready_to_print) {
+        old_len = (int) strlen(session->messages[session->last_message_id]) + 1;
 
         // If the new message and the old message are short enough,
         // we want display them together on the same line.  So we
@@ -278,49 +378,49 @@ void printMessage(const char *msg) {
     }
 
     if (!combine_messages) {
-        (void) move(MSG_LINE, 0);
-        clrtoeol();
+        (void) screenMove(Coord_t{MSG_LINE, 0});
+        screenClearToEOL();
     }
 
     // Make the null string a special case. -CJS-
 
     if (msg == nullptr) {
-        message_ready_to_print = false;
+        session->message_ready_to_print = false;
         return;
     }
 
-    game.command_count = 0;
-    message_ready_to_print = true;
+    session->game.command_count = 0;
+    session->message_ready_to_print = true;
 
     // If the new message and the old message are short enough,
     // display them on the same line.
 
     if (combine_messages) {
         putString(msg, Coord_t{MSG_LINE, old_len + 2});
-        strcat(messages[last_message_id], "  ");
-        strcat(messages[last_message_id], msg);
+        strcat(session->messages[session->last_message_id], "  ");
+        strcat(session->messages[session->last_message_id], msg);
     } else {
         messageLinePrintMessage(msg);
-        last_message_id++;
+        session->last_message_id++;
 
-        if (last_message_id >= MESSAGE_HISTORY_SIZE) {
-            last_message_id = 0;
+        if (session->last_message_id >= MESSAGE_HISTORY_SIZE) {
+            session->last_message_id = 0;
         }
 
-        (void) strncpy(messages[last_message_id], msg, MORIA_MESSAGE_SIZE);
-        messages[last_message_id][MORIA_MESSAGE_SIZE - 1] = '\0';
+        (void) strncpy(session->messages[session->last_message_id], msg, MORIA_MESSAGE_SIZE);
+        session->messages[session->last_message_id][MORIA_MESSAGE_SIZE - 1] = '\0';
     }
 }
 
 // Print a message so as not to interrupt a counted command. -CJS-
 void printMessageNoCommandInterrupt(const std::string &msg) {
     // Save command count value
-    int i = game.command_count;
+    int i = session->game.command_count;
 
     printMessage(msg.c_str());
 
     // Restore count value
-    game.command_count = i;
+    session->game.command_count = i;
 }
 
 // Returns a single character input from the terminal. -CJS-
@@ -330,34 +430,34 @@ void printMessageNoCommandInterrupt(const std::string &msg) {
 // any input prompt. getKeyInput() never returns ^R.
 char getKeyInput() {
     putQIO();               // Dump IO buffer
-    game.command_count = 0; // Just to be safe -CJS-
+    session->game.command_count = 0; // Just to be safe -CJS-
 
     while (true) {
-        int ch = getch();
+        int ch = screenGetKey();
 
         // some machines may not sign extend.
         if (ch == EOF) {
             // avoid infinite loops while trying to call getKeyInput() for a -more- prompt.
-            message_ready_to_print = false;
+            session->message_ready_to_print = false;
 
-            eof_flag++;
+            session->eof_flag++;
 
-            (void) refresh();
+            screenRefresh();
 
-            if (!game.character_generated || game.character_saved) {
+            if (!session->game.character_generated || session->game.character_saved) {
                 endGame();
             }
 
             playerDisturb(1, 0);
 
-            if (eof_flag > 100) {
+            if (session->eof_flag > 100) {
                 // just in case, to make sure that the process eventually dies
-                panic_save = true;
+                session->panic_save = true;
 
-                (void) strcpy(game.character_died_from, "(end of input: panic saved)");
+                (void) strcpy(session->game.character_died_from, "(end of input: panic saved)");
                 if (!saveGame()) {
-                    (void) strcpy(game.character_died_from, "panic: unexpected eof");
-                    game.character_is_dead = true;
+                    (void) strcpy(session->game.character_died_from, "panic: unexpected eof");
+                    session->game.character_is_dead = true;
                 }
                 endGame();
             }
@@ -368,8 +468,12 @@ char getKeyInput() {
             return (char) ch;
         }
 
-        (void) wrefresh(curscr);
-        moriaTerminalInitialize();
+        if (usingAnsiOutput()) {
+            ansiRedraw();
+        } else {
+            (void) wrefresh(curscr);
+            moriaTerminalInitialize();
+        }
     }
 }
 
@@ -398,13 +502,13 @@ bool getMenuItemId(const std::string &prompt, char &command) {
 // Gets a string terminated by <RETURN>
 // Function returns false if <ESCAPE> is input
 bool getStringInput(char *in_str, Coord_t coord, int slen) {
-    (void) move(coord.y, coord.x);
+    (void) screenMove(coord);
 
     for (int i = slen; i > 0; i--) {
-        (void) addch(' ');
+        (void) screenAddChar(' ');
     }
 
-    (void) move(coord.y, coord.x);
+    (void) screenMove(coord);
 
     int start_col = coord.x;
     int end_col = coord.x + slen - 1;
@@ -441,7 +545,8 @@ bool getStringInput(char *in_str, Coord_t coord, int slen) {
                 if ((isprint(key) == 0) || coord.x > end_col) {
                     terminalBellSound();
                 } else {
-                    mvaddch(coord.y, coord.x, (char) key);
+                    (void) screenMove(coord);
+                    (void) screenAddChar((char) key);
                     *p++ = (char) key;
                     coord.x++;
                 }
@@ -473,16 +578,11 @@ bool getInputConfirmation(const std::string &prompt) {
 int getInputConfirmationWithAbort(int column, const std::string &prompt) {
     putStringClearToEOL(prompt, Coord_t{0, column});
 
-    int y, x;
-    getyx(stdscr, y, x);
-
-    if (x > 73) {
-        (void) move(0, 73);
-    } else if (y != 0) {
-        // use `y` to prevent compiler warning.
+    if (currentCursorPosition().x > 73) {
+        (void) screenMove(Coord_t{0, 73});
     }
 
-    (void) addstr(" [y/n]");
+    (void) screenAddString(" [y/n]");
 
     char key = ' ';
     while (key == ' ') {
@@ -521,6 +621,18 @@ void waitForContinueKey(int line_number) {
 // a certain point, sleep for a second. There would need to be a way of resetting
 // the count, with a call made for commands like run or rest.
 bool checkForNonBlockingKeyPress(int microseconds) {
+    TerminalLink_t const *link = session->terminal_link;
+    if (link != nullptr) {
+        if (!link->key_waiting(link->context, microseconds)) {
+            return false;
+        }
+        if (screenGetKey() == EOF) {
+            session->eof_flag++;
+            return false;
+        }
+        return true;
+    }
+
 #ifdef _WIN32
     (void) microseconds;
 
@@ -541,10 +653,10 @@ bool checkForNonBlockingKeyPress(int microseconds) {
 
     smask = 1; // i.e. (1 << 0)
     if (select(1, (fd_set *) &smask, (fd_set *) nullptr, (fd_set *) nullptr, &tbuf) == 1) {
-        ch = getch();
+        ch = screenGetKey();
         // check for EOF errors here, select sometimes works even when EOF
         if (ch == -1) {
-            eof_flag++;
+            session->eof_flag++;
             return false;
         }
         return true;
@@ -0,0 +1,263 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Recording the terminal output of a game as a ttyrec file
+
+#include "headers.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+// A ttyrec file is a series of frames, each being the time it was sent and
+// the bytes sent to the terminal then. The bytes are captured as the ANSI
+// output writes them, so a recording is exactly what the player saw.
+//
+// The game only ever adds frames to its recording's pending buffer. A
+// single writer thread, shared by every recording in the process, takes
+// the buffers and does the compressing and writing, so a slow disk never
+// holds up a game. Should the writer fall that far behind, frames are
+// dropped rather than kept waiting without end.
+
+constexpr size_t RECORDING_PENDING_LIMIT = 16 * 1024 * 1024;
+
+typedef struct Recording_t {
+    std::string path{};
+    bool compress = false;
+
+    // Shared with the writer, under recorder_mutex
+    std::string pending{};
+    bool stopped = false;
+    uint64_t dropped = 0;
+
+    // Only used by the writer
+    FILE *file = nullptr;
+#ifdef HAVE_ZLIB
+    gzFile gz_file = nullptr;
+#endif
+    bool failed = false;
+} Recording_t;
+
+static std::mutex recorder_mutex;
+static std::condition_variable recorder_wake;
+static std::vector<Recording_t *> recorder_recordings;
+static std::thread recorder_thread;
+static bool recorder_exiting = false;
+
+static void recorderOpen(Recording_t &recording) {
+#ifdef HAVE_ZLIB
+    if (recording.compress) {
+        recording.gz_file = gzopen(recording.path.c_str(), "wb");
+        recording.failed = recording.gz_file == nullptr;
+        return;
+    }
+#endif
+
+    recording.file = fopen(recording.path.c_str(), "wb");
+    recording.failed = recording.file == nullptr;
+}
+
+static void recorderWrite(Recording_t &recording, std::string const &frames) {
+    if (recording.failed || frames.empty()) {
+        return;
+    }
+
+#ifdef HAVE_ZLIB
+    if (recording.gz_file != nullptr) {
+        recording.failed = gzwrite(recording.gz_file, frames.data(), (unsigned) frames.size()) != (int) frames.size();
+        return;
+    }
+#endif
+
+    recording.failed = fwrite(frames.data(), 1, frames.size(), recording.file) != frames.size();
+    (void) fflush(recording.file);
+}
+
+static void recorderClose(Recording_t &recording) {
+#ifdef HAVE_ZLIB
+    if (recording.gz_file != nullptr) {
+        (void) gzclose(recording.gz_file);
+    }
+#endif
+    if (recording.file != nullptr) {
+        (void) fclose(recording.file);
+    }
+
+    if (recording.failed) {
+        std::cerr << "Could not write the recording '" << recording.path << "'.\n";
+    } else if (recording.dropped > 0) {
+        std::cerr << "The recording '" << recording.path << "' is missing " << recording.dropped << " bytes, as the disk could not keep up.\n";
+    }
+}
+
+static void recorderRun() {
+    std::vector<Recording_t *> writing;
+    std::vector<std::string> frames;
+    std::vector<bool> stopping;
+
+    std::unique_lock<std::mutex> lock(recorder_mutex);
+
+    while (!recorder_exiting || !recorder_recordings.empty()) {
+        writing.clear();
+        frames.clear();
+        stopping.clear();
+
+        for (auto *recording : recorder_recordings) {
+            if (recording->pending.empty() && !recording->stopped) {
+                continue;
+            }
+            writing.push_back(recording);
+            frames.emplace_back();
+            frames.back().swap(recording->pending);
+            stopping.push_back(recording->stopped);
+        }
+
+        if (writing.empty()) {
+            recorder_wake.wait(lock);
+            continue;
+        }
+
+        // Stopped recordings are finished with once their last frames are written
+        recorder_recordings.erase(std::remove_if(recorder_recordings.begin(), recorder_recordings.end(), [](Recording_t const *recording) { return recording->stopped; }),
+                                  recorder_recordings.end());
+
+        lock.unlock();
+
+        for (size_t i = 0; i < writing.size(); i++) {
+            Recording_t &recording = *writing[i];
+
+            if (recording.file == nullptr && !recording.failed
+#ifdef HAVE_ZLIB
+                && recording.gz_file == nullptr
+#endif
+            ) {
+                recorderOpen(recording);
+            }
+
+            recorderWrite(recording, frames[i]);
+
+            if (stopping[i]) {
+                recorderClose(recording);
+                delete &recording;
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+static void recorderPutInt(std::string &out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out += (char) (value & 0xFF);
+        value >>= 8;
+    }
+}
+
+// Can recordings be compressed?
+bool recordingCanCompress() {
+#ifdef HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Starts recording what the game shows to a ttyrec file at `path`. When the
+// game is already showing something, the recording starts from a keyframe.
+void recordingStart(std::string const &path, bool compress) {
+    auto *recording = new Recording_t();
+    recording->path = path;
+    recording->compress = compress;
+
+    {
+        std::lock_guard<std::mutex> lock(recorder_mutex);
+        if (!recorder_thread.joinable()) {
+            recorder_thread = std::thread(recorderRun);
+        }
+        recorder_recordings.push_back(recording);
+    }
+
+    session->recording = recording;
+
+    if (session->terminal_on) {
+        std::string keyframe;
+        ansiKeyframe(session->ansi, keyframe);
+        recordingWrite(keyframe.data(), keyframe.size());
+    }
+}
+
+// Adds a frame of the bytes being sent to the terminal
+void recordingWrite(const char *bytes, size_t length) {
+    Recording_t *recording = session->recording;
+    if (recording == nullptr || length == 0) {
+        return;
+    }
+
+    uint32_t seconds = 0;
+    uint32_t microseconds = 0;
+#ifdef _WIN32
+    seconds = (uint32_t) time(nullptr);
+#else
+    struct timeval now {};
+    (void) gettimeofday(&now, nullptr);
+    seconds = (uint32_t) now.tv_sec;
+    microseconds = (uint32_t) now.tv_usec;
+#endif
+
+    std::lock_guard<std::mutex> lock(recorder_mutex);
+
+    if (recording->pending.size() + length > RECORDING_PENDING_LIMIT) {
+        recording->dropped += length;
+        return;
+    }
+
+    bool was_empty = recording->pending.empty();
+
+    recorderPutInt(recording->pending, seconds);
+    recorderPutInt(recording->pending, microseconds);
+    recorderPutInt(recording->pending, (uint32_t) length);
+    recording->pending.append(bytes, length);
+
+    if (was_empty) {
+        recorder_wake.notify_one();
+    }
+}
+
+// Stops the game's recording, which the writer finishes in its own time
+void recordingStop() {
+    Recording_t *recording = session->recording;
+    if (recording == nullptr) {
+        return;
+    }
+    session->recording = nullptr;
+
+    std::lock_guard<std::mutex> lock(recorder_mutex);
+    recording->stopped = true;
+    recorder_wake.notify_one();
+}
+
+// Waits for every stopped recording to be written, before the process exits
+void recordingFinishAll() {
+    {
+        std::lock_guard<std::mutex> lock(recorder_mutex);
+        if (!recorder_thread.joinable()) {
+            return;
+        }
+        recorder_exiting = true;
+        recorder_wake.notify_one();
+    }
+
+    recorder_thread.join();
+}
@@ -7,20 +7,30 @@
 
 #include "headers.h"
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 // lets anyone enter wizard mode after a disclaimer... -JEW-
 bool enterWizardMode() {
+    // Wizard mode can write files, and can't be given to those playing over a connection
+    if (session->terminal_link != nullptr) {
+        printMessage("Wizard mode is not available here.");
+        return false;
+    }
+
     bool answer = false;
 
-    if (game.noscore == 0) {
+    if (session->game.noscore == 0) {
         printMessage("Wizard mode is for debugging and experimenting.");
         answer = getInputConfirmation("The game will not be scored if you enter wizard mode. Are you sure?");
     }
 
-    if ((game.noscore != 0) || answer) {
-        game.noscore |= 0x2;
-        game.wizard_mode = true;
+    if ((session->game.noscore != 0) || answer) {
+        session->game.noscore |= 0x2;
+        session->game.wizard_mode = true;
         return true;
     }
 
@@ -40,11 +50,11 @@ void wizardCureAll() {
     (void) playerStatRestore(PlayerAttr::A_DEX);
     (void) playerStatRestore(PlayerAttr::A_CHR);
 
-    if (py.flags.slow > 1) {
-        py.flags.slow = 1;
+    if (session->py.flags.slow > 1) {
+        session->py.flags.slow = 1;
     }
-    if (py.flags.image > 1) {
-        py.flags.image = 1;
+    if (session->py.flags.image > 1) {
+        session->py.flags.image = 1;
     }
 }
 
@@ -52,13 +62,13 @@ void wizardCureAll() {
 void wizardDropRandomItems() {
     int i;
 
-    if (game.command_count > 0) {
-        i = game.command_count;
-        game.command_count = 0;
+    if (session->game.command_count > 0) {
+        i = session->game.command_count;
+        session->game.command_count = 0;
     } else {
         i = 1;
     }
-    dungeonPlaceRandomObjectNear(py.pos, i);
+    dungeonPlaceRandomObjectNear(session->py.pos, i);
 
     drawDungeonPanel();
 }
@@ -67,13 +77,13 @@ void wizardDropRandomItems() {
 void wizardJumpLevel() {
     int i;
 
-    if (game.command_count > 0) {
-        if (game.command_count > 99) {
+    if (session->game.command_count > 0) {
+        if (session->game.command_count > 99) {
             i = 0;
         } else {
-            i = game.command_count;
+            i = session->game.command_count;
         }
-        game.command_count = 0;
+        session->game.command_count = 0;
     } else {
         i = -1;
         vtype_t input = {0};
@@ -86,11 +96,11 @@ void wizardJumpLevel() {
     }
 
     if (i >= 0) {
-        dg.current_level = (int16_t) i;
-        if (dg.current_level > 99) {
-            dg.current_level = 99;
+        session->dg.current_level = (int16_t) i;
+        if (session->dg.current_level > 99) {
+            session->dg.current_level = 99;
         }
-        dg.generate_new_level = true;
+        session->dg.generate_new_level = true;
     } else {
         messageLineClear();
     }
@@ -98,20 +108,20 @@ void wizardJumpLevel() {
 
 // Increase Experience
 void wizardGainExperience() {
-    if (game.command_count > 0) {
-        py.misc.exp = game.command_count;
-        game.command_count = 0;
-    } else if (py.misc.exp == 0) {
-        py.misc.exp = 1;
+    if (session->game.command_count > 0) {
+        session->py.misc.exp = session->game.command_count;
+        session->game.command_count = 0;
+    } else if (session->py.misc.exp == 0) {
+        session->py.misc.exp = 1;
     } else {
-        py.misc.exp = py.misc.exp * 2;
+        session->py.misc.exp = session->py.misc.exp * 2;
     }
     displayCharacterExperience();
 }
 
 // Summon a random monster
 void wizardSummonMonster() {
-    Coord_t coord = Coord_t{py.pos.y, py.pos.x};
+    Coord_t coord = Coord_t{session->py.pos.y, session->py.pos.x};
 
     (void) monsterSummon(coord, true);
 
@@ -122,16 +132,16 @@ void wizardSummonMonster() {
 void wizardLightUpDungeon() {
     bool flag;
 
-    flag = !dg.floor[py.pos.y][py.pos.x].permanent_light;
+    flag = !session->dg.floor[session->py.pos.y][session->py.pos.x].permanent_light;
 
-    for (int y = 0; y < dg.height; y++) {
-        for (int x = 0; x < dg.width; x++) {
-            if (dg.floor[y][x].feature_id <= MAX_CAVE_FLOOR) {
+    for (int y = 0; y < session->dg.height; y++) {
+        for (int x = 0; x < session->dg.width; x++) {
+            if (session->dg.floor[y][x].feature_id <= MAX_CAVE_FLOOR) {
                 for (int yy = y - 1; yy <= y + 1; yy++) {
                     for (int xx = x - 1; xx <= x + 1; xx++) {
-                        dg.floor[yy][xx].permanent_light = flag;
+                        session->dg.floor[yy][xx].permanent_light = flag;
                         if (!flag) {
-                            dg.floor[yy][xx].field_mark = false;
+                            session->dg.floor[yy][xx].field_mark = false;
                         }
                     }
                 }
@@ -139,6 +149,8 @@ void wizardLightUpDungeon() {
         }
     }
 
+    // The whole map has changed, not only what is on the panel
+    dungeonOverviewForget();
     drawDungeonPanel();
 }
 
@@ -151,7 +163,7 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > 2 && number < 119) {
-            py.stats.max[PlayerAttr::A_STR] = (uint8_t) number;
+            session->py.stats.max[PlayerAttr::A_STR] = (uint8_t) number;
             (void) playerStatRestore(PlayerAttr::A_STR);
         }
     } else {
@@ -162,7 +174,7 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > 2 && number < 119) {
-            py.stats.max[PlayerAttr::A_INT] = (uint8_t) number;
+            session->py.stats.max[PlayerAttr::A_INT] = (uint8_t) number;
             (void) playerStatRestore(PlayerAttr::A_INT);
         }
     } else {
@@ -173,7 +185,7 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > 2 && number < 119) {
-            py.stats.max[PlayerAttr::A_WIS] = (uint8_t) number;
+            session->py.stats.max[PlayerAttr::A_WIS] = (uint8_t) number;
             (void) playerStatRestore(PlayerAttr::A_WIS);
         }
     } else {
@@ -184,7 +196,7 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > 2 && number < 119) {
-            py.stats.max[PlayerAttr::A_DEX] = (uint8_t) number;
+            session->py.stats.max[PlayerAttr::A_DEX] = (uint8_t) number;
             (void) playerStatRestore(PlayerAttr::A_DEX);
         }
     } else {
@@ -195,7 +207,7 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > 2 && number < 119) {
-            py.stats.max[PlayerAttr::A_CON] = (uint8_t) number;
+            session->py.stats.max[PlayerAttr::A_CON] = (uint8_t) number;
             (void) playerStatRestore(PlayerAttr::A_CON);
         }
     } else {
@@ -206,7 +218,7 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > 2 && number < 119) {
-            py.stats.max[PlayerAttr::A_CHR] = (uint8_t) number;
+            session->py.stats.max[PlayerAttr::A_CHR] = (uint8_t) number;
             (void) playerStatRestore(PlayerAttr::A_CHR);
         }
     } else {
@@ -217,9 +229,9 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 5)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > 0 && number <= SHRT_MAX) {
-            py.misc.max_hp = (int16_t) number;
-            py.misc.current_hp = (int16_t) number;
-            py.misc.current_hp_fraction = 0;
+            session->py.misc.max_hp = (int16_t) number;
+            session->py.misc.current_hp = (int16_t) number;
+            session->py.misc.current_hp_fraction = 0;
             printCharacterMaxHitPoints();
             printCharacterCurrentHitPoints();
         }
@@ -231,109 +243,109 @@ void wizardCharacterAdjustment() {
     if (getStringInput(input, Coord_t{0, 25}, 5)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > -1 && number <= SHRT_MAX) {
-            py.misc.mana = (int16_t) number;
-            py.misc.current_mana = (int16_t) number;
-            py.misc.current_mana_fraction = 0;
+            session->py.misc.mana = (int16_t) number;
+            session->py.misc.current_mana = (int16_t) number;
+            session->py.misc.current_mana_fraction = 0;
             printCharacterCurrentMana();
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  Gold = ", py.misc.au);
+    (void) sprintf(input, "Current=%d  Gold = ", session->py.misc.au);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 7)) {
         int new_gold;
         bool valid_number = stringToNumber(input, new_gold);
         if (valid_number && new_gold > -1) {
-            py.misc.au = new_gold;
+            session->py.misc.au = new_gold;
             printCharacterGoldValue();
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  (0-200) Searching = ", py.misc.chance_in_search);
+    (void) sprintf(input, "Current=%d  (0-200) Searching = ", session->py.misc.chance_in_search);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 3)) {
         int new_gold;
         bool valid_number = stringToNumber(input, new_gold);
         if (valid_number && number > -1 && number < 201) {
-            py.misc.chance_in_search = (int16_t) number;
+            session->py.misc.chance_in_search = (int16_t) number;
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  (-1-18) Stealth = ", py.misc.stealth_factor);
+    (void) sprintf(input, "Current=%d  (-1-18) Stealth = ", session->py.misc.stealth_factor);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > -2 && number < 19) {
-            py.misc.stealth_factor = (int16_t) number;
+            session->py.misc.stealth_factor = (int16_t) number;
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  (0-200) Disarming = ", py.misc.disarm);
+    (void) sprintf(input, "Current=%d  (0-200) Disarming = ", session->py.misc.disarm);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > -1 && number < 201) {
-            py.misc.disarm = (int16_t) number;
+            session->py.misc.disarm = (int16_t) number;
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  (0-100) Save = ", py.misc.saving_throw);
+    (void) sprintf(input, "Current=%d  (0-100) Save = ", session->py.misc.saving_throw);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > -1 && number < 201) {
-            py.misc.saving_throw = (int16_t) number;
+            session->py.misc.saving_throw = (int16_t) number;
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  (0-200) Base to hit = ", py.misc.bth);
+    (void) sprintf(input, "Current=%d  (0-200) Base to hit = ", session->py.misc.bth);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > -1 && number < 201) {
-            py.misc.bth = (int16_t) number;
+            session->py.misc.bth = (int16_t) number;
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  (0-200) Bows/Throwing = ", py.misc.bth_with_bows);
+    (void) sprintf(input, "Current=%d  (0-200) Bows/Throwing = ", session->py.misc.bth_with_bows);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > -1 && number < 201) {
-            py.misc.bth_with_bows = (int16_t) number;
+            session->py.misc.bth_with_bows = (int16_t) number;
         }
     } else {
         return;
     }
 
-    (void) sprintf(input, "Current=%d  Weight = ", py.misc.weight);
+    (void) sprintf(input, "Current=%d  Weight = ", session->py.misc.weight);
     number = (int) strlen(input);
     putStringClearToEOL(input, Coord_t{0, 0});
     if (getStringInput(input, Coord_t{0, number}, 3)) {
         bool valid_number = stringToNumber(input, number);
         if (valid_number && number > -1) {
-            py.misc.weight = (uint16_t) number;
+            session->py.misc.weight = (uint16_t) number;
         }
     } else {
         return;
@@ -388,23 +400,23 @@ void wizardGenerateObject() {
     Coord_t coord = Coord_t{0, 0};
 
     for (int i = 0; i < 10; i++) {
-        coord.y = py.pos.y - 3 + randomNumber(5);
-        coord.x = py.pos.x - 4 + randomNumber(7);
+        coord.y = session->py.pos.y - 3 + randomNumber(5);
+        coord.x = session->py.pos.x - 4 + randomNumber(7);
 
-        if (coordInBounds(coord) && dg.floor[coord.y][coord.x].feature_id <= MAX_CAVE_FLOOR && dg.floor[coord.y][coord.x].treasure_id == 0) {
+        if (coordInBounds(coord) && session->dg.floor[coord.y][coord.x].feature_id <= MAX_CAVE_FLOOR && session->dg.floor[coord.y][coord.x].treasure_id == 0) {
             // delete any object at location, before call popt()
-            if (dg.floor[coord.y][coord.x].treasure_id != 0) {
+            if (session->dg.floor[coord.y][coord.x].treasure_id != 0) {
                 (void) dungeonDeleteObject(coord);
             }
 
             // place the object
             int free_treasure_id = popt();
-            dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
-            inventoryItemCopyTo(id, game.treasure.list[free_treasure_id]);
-            magicTreasureMagicalAbility(free_treasure_id, dg.current_level);
+            session->dg.floor[coord.y][coord.x].treasure_id = (uint8_t) free_treasure_id;
+            inventoryItemCopyTo(id, session->game.treasure.list[free_treasure_id]);
+            magicTreasureMagicalAbility(free_treasure_id, session->dg.current_level);
 
             // auto identify the item
-            itemIdentify(game.treasure.list[free_treasure_id], free_treasure_id);
+            itemIdentify(session->game.treasure.list[free_treasure_id], free_treasure_id);
 
             i = 9;
         }
@@ -553,15 +565,15 @@ void wizardCreateObjects() {
 
     if (getInputConfirmation("Allocate?")) {
         // delete object first if any, before call popt()
-        Tile_t &tile = dg.floor[py.pos.y][py.pos.x];
+        TileRef_t tile = session->dg.floor[session->py.pos.y][session->py.pos.x];
 
         if (tile.treasure_id != 0) {
-            (void) dungeonDeleteObject(py.pos);
+            (void) dungeonDeleteObject(session->py.pos);
         }
 
         number = popt();
 
-        game.treasure.list[number] = forge;
+        session->game.treasure.list[number] = forge;
         tile.treasure_id = (uint8_t) number;
 
         printMessage("Allocated.");
@@ -569,3 +581,235 @@ void wizardCreateObjects() {
         printMessage("Aborted.");
     }
 }
+
+// Number of monster moves per player turn, the same as the game loop
+// gives them in monsterMovementRate(), but for a player who isn't resting.
+static int combatMonsterMovesPerTurn(int16_t speed, int turn) {
+    if (speed > 0) {
+        return speed;
+    }
+
+    return (turn % (2 - speed)) == 0 ? 1 : 0;
+}
+
+// Fights the character against a single creature, both starting at full
+// health and in melee range. Returns the number of turns taken to kill the
+// creature, 0 if the character died, or -1 if the fight ended in a draw.
+static int combatSimulateFight(Creature_t const &creature, int blows, int total_to_hit, int base_to_hit) {
+    constexpr int max_turns = 1000;
+
+    Inventory_t const &weapon = session->py.inventory[PlayerEquipment::Wield];
+
+    int player_hp = session->py.misc.max_hp;
+    int monster_hp;
+    if ((creature.defenses & config::monsters::defense::CD_MAX_HP) != 0) {
+        monster_hp = maxDiceRoll(creature.hit_die);
+    } else {
+        monster_hp = diceRoll(creature.hit_die);
+    }
+
+    auto speed = (int16_t)(creature.speed - 10 + session->py.flags.speed);
+    auto spell_frequency = (int) (creature.spells & config::monsters::spells::CS_FREQ);
+
+    for (int turn = 1; turn <= max_turns; turn++) {
+        for (int i = blows; i > 0; i--) {
+            if (!playerRollToHit(base_to_hit, (int) session->py.misc.level, total_to_hit, (int) creature.ac, PlayerClassLevelAdj::BTH)) {
+                continue;
+            }
+
+            int critical_severity;
+            uint16_t slay_defense = 0;
+            monster_hp -= playerMeleeBlowDamage(weapon, total_to_hit, creature, critical_severity, slay_defense);
+
+            if (monster_hp < 0) {
+                return turn;
+            }
+        }
+
+        for (int move = combatMonsterMovesPerTurn(speed, turn); move > 0; move--) {
+            // A spell is cast instead of attacking, see monsterCastSpell()
+            if (spell_frequency != 0 && randomNumber(spell_frequency) == 1) {
+                player_hp -= monsterSpellHitPointDamage(monsterChooseSpell(creature), monster_hp);
+
+                if (player_hp < 0) {
+                    return 0;
+                }
+                continue;
+            }
+
+            for (auto damage_type_id : creature.damage) {
+                if (damage_type_id == 0) {
+                    break;
+                }
+
+                MonsterAttack_t const &attack = monster_attacks[damage_type_id];
+
+                if (!playerRollAttackHits(attack.type_id, creature.level)) {
+                    continue;
+                }
+
+                player_hp -= monsterAttackHitPointDamage(attack.type_id, diceRoll(attack.dice));
+
+                if (player_hp < 0) {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    return -1;
+}
+
+// The results of all the fights against one creature
+typedef struct {
+    int wins = 0;
+    int losses = 0;
+    int64_t turns_to_kill = 0;
+} CombatResult_t;
+
+// Shared by the simulation threads, which take the creatures one at a time.
+// Each creature has its own stream of random numbers, so the results don't
+// depend on which thread fights it, or on how many threads there are.
+typedef struct {
+    Player_t py = Player_t{};
+    int fights = 0;
+    int blows = 0;
+    int total_to_hit = 0;
+    int base_to_hit = 0;
+    RandomState_t streams[MON_MAX_CREATURES]{};
+    CombatResult_t results[MON_MAX_CREATURES]{};
+    std::atomic<int> next_creature{0};
+} CombatSimulation_t;
+
+// Each thread plays in a session of its own, with a copy of the character
+static void combatSimulationThread(CombatSimulation_t *simulation) {
+    session = sessionCreate();
+    session->py = simulation->py;
+    session->rnd_engine = RandomEngine::Xoshiro128;
+
+    for (int creature_id = simulation->next_creature++; creature_id < MON_MAX_CREATURES; creature_id = simulation->next_creature++) {
+        Creature_t const &creature = creatures_list[creature_id];
+        CombatResult_t &result = simulation->results[creature_id];
+
+        setRandomState(simulation->streams[creature_id]);
+
+        for (int i = 0; i < simulation->fights; i++) {
+            int turns = combatSimulateFight(creature, simulation->blows, simulation->total_to_hit, simulation->base_to_hit);
+
+            if (turns > 0) {
+                result.wins++;
+                result.turns_to_kill += turns;
+            } else if (turns == 0) {
+                result.losses++;
+            }
+        }
+    }
+
+    sessionDestroy(session);
+}
+
+// Splits a stream of random numbers for every creature off the game's own,
+// which is left as it was. xoshiro128** is used whatever the game's engine,
+// as its streams are far enough apart for any number of fights.
+static void combatSplitRandomStreams(RandomState_t (&streams)[MON_MAX_CREATURES]) {
+    RandomEngine engine = getRandomEngine();
+    RandomState_t state = getRandomState();
+
+    session->rnd_engine = RandomEngine::Xoshiro128;
+    setRandomSeed(getCurrentUnixTime());
+
+    for (auto &stream : streams) {
+        stream = getRandomState();
+        rndJump();
+    }
+
+    session->rnd_engine = engine;
+    setRandomState(state);
+}
+
+// Monte Carlo simulation of the current character against every creature,
+// with the results written to a file. The fights run on all the cores.
+// The melee exchange and the damage done by creature spells and breaths
+// are simulated. The side effects of attacks and spells (stat drain,
+// stealing, paralysis, summoning, etc.) are not.
+void wizardCombatSimulation() {
+    vtype_t input = {'\0'};
+
+    putStringClearToEOL("Fights per creature?: ", Coord_t{0, 0});
+    if (!getStringInput(input, Coord_t{0, 22}, 10)) {
+        return;
+    }
+
+    int fights;
+    if (!stringToNumber(input, fights) || fights < 1) {
+        putStringClearToEOL("Parameters no good.", Coord_t{0, 0});
+        return;
+    }
+
+    putStringClearToEOL("File name: ", Coord_t{0, 0});
+
+    vtype_t filename = {'\0'};
+    if (!getStringInput(filename, Coord_t{0, 11}, 64)) {
+        return;
+    }
+    if (strlen(filename) == 0) {
+        return;
+    }
+
+    FILE *file_ptr = fopen(filename, "w");
+    if (file_ptr == nullptr) {
+        putStringClearToEOL("File could not be opened.", Coord_t{0, 0});
+        return;
+    }
+
+    putStringClearToEOL("Simulating combat...", Coord_t{0, 0});
+    putQIO();
+
+    // Large, so kept off the stack
+    auto *simulation = new CombatSimulation_t();
+
+    Inventory_t const &weapon = session->py.inventory[PlayerEquipment::Wield];
+
+    simulation->py = session->py;
+    simulation->fights = fights;
+    playerCalculateToHitBlows(weapon.category_id, weapon.weight, simulation->blows, simulation->total_to_hit);
+
+    // Assume the creature is always visible to the character.
+    simulation->base_to_hit = session->py.misc.bth;
+
+    combatSplitRandomStreams(simulation->streams);
+
+    auto thread_count = (int) std::thread::hardware_concurrency();
+    thread_count = std::max(1, std::min(thread_count, (int) MON_MAX_CREATURES));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; i++) {
+        threads.emplace_back(combatSimulationThread, simulation);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    (void) fprintf(file_ptr, "*** Combat Simulation:\n");
+    (void) fprintf(file_ptr, "*** Level %d %s, %d HP, %d AC, %d blows\n", (int) session->py.misc.level, classes[session->py.misc.class_id].title, session->py.misc.max_hp,
+                   session->py.misc.ac + session->py.misc.magical_ac, simulation->blows);
+    (void) fprintf(file_ptr, "*** %d fights per creature, on %d threads\n", fights, thread_count);
+    (void) fprintf(file_ptr, "\n");
+    (void) fprintf(file_ptr, "%-32s %5s %7s %7s %7s %14s\n", "Creature", "Level", "Win%", "Loss%", "Draw%", "Turns to kill");
+
+    for (int creature_id = 0; creature_id < MON_MAX_CREATURES; creature_id++) {
+        Creature_t const &creature = creatures_list[creature_id];
+        CombatResult_t const &result = simulation->results[creature_id];
+
+        double average_turns = result.wins > 0 ? (double) result.turns_to_kill / result.wins : 0.0;
+
+        (void) fprintf(file_ptr, "%-32s %5d %7.2f %7.2f %7.2f %14.2f\n", creature.name, (int) creature.level, 100.0 * result.wins / fights, 100.0 * result.losses / fights,
+                       100.0 * (fights - result.wins - result.losses) / fights, average_turns);
+    }
+
+    delete simulation;
+
+    (void) fclose(file_ptr);
+
+    putStringClearToEOL("Completed.", Coord_t{0, 0});
+}
@@ -15,3 +15,4 @@ void wizardLightUpDungeon();
 void wizardCharacterAdjustment();
 void wizardGenerateObject();
 void wizardCreateObjects();
+void wizardCombatSimulation();